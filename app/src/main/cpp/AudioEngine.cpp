@@ -30,6 +30,20 @@ namespace {
         return extensions;
     }
 
+    // The factory leases the library through DecoderPluginLoader; the registry
+    // keeps its name so upcoming tracks can have their plugin pre-warmed.
+    void registerPluginDecoder(
+            const std::string& name,
+            const std::vector<std::string>& extensions,
+            const char* libraryName,
+            int priority,
+            DecoderStaticInfo staticInfo) {
+        staticInfo.pluginLibrary = libraryName;
+        DecoderRegistry::getInstance().registerDecoder(name, extensions, [libraryName]() {
+            return DecoderPluginLoader::getInstance().createDecoder(libraryName);
+        }, priority, std::move(staticInfo));
+    }
+
     struct DecoderRegistration {
         DecoderRegistration() {
             DecoderStaticInfo ffmpegStaticInfo;
@@ -53,9 +67,8 @@ namespace {
             ffmpegStaticInfo.optionApplyPolicy = [](const char*) {
                 return AudioDecoder::OPTION_APPLY_LIVE;
             };
-            DecoderRegistry::getInstance().registerDecoder("FFmpeg", getStaticFfmpegExtensions(), []() {
-                return DecoderPluginLoader::getInstance().createDecoder("libsiliconplayer_ffmpeg_decoder.so");
-            }, 0, std::move(ffmpegStaticInfo));
+            registerPluginDecoder("FFmpeg", getStaticFfmpegExtensions(),
+                    "libsiliconplayer_ffmpeg_decoder.so", 0, std::move(ffmpegStaticInfo));
 
             DecoderStaticInfo openMptStaticInfo;
             openMptStaticInfo.hasPlaybackCapabilities = true;
@@ -77,9 +90,8 @@ namespace {
             openMptStaticInfo.optionApplyPolicy = [](const char*) {
                 return AudioDecoder::OPTION_APPLY_LIVE;
             };
-            DecoderRegistry::getInstance().registerDecoder("LibOpenMPT", getStaticOpenMptExtensions(), []() {
-                return DecoderPluginLoader::getInstance().createDecoder("libsiliconplayer_openmpt_decoder.so");
-            }, 10, std::move(openMptStaticInfo));
+            registerPluginDecoder("LibOpenMPT", getStaticOpenMptExtensions(),
+                    "libsiliconplayer_openmpt_decoder.so", 10, std::move(openMptStaticInfo));
 
             DecoderStaticInfo vgmStaticInfo;
             vgmStaticInfo.hasPlaybackCapabilities = true;
@@ -110,9 +122,8 @@ namespace {
                         ? AudioDecoder::OPTION_APPLY_REQUIRES_PLAYBACK_RESTART
                         : AudioDecoder::OPTION_APPLY_LIVE;
             };
-            DecoderRegistry::getInstance().registerDecoder("VGMPlay", {"vgm", "vgz", "vgm.gz"}, []() {
-                return DecoderPluginLoader::getInstance().createDecoder("libsiliconplayer_vgm_decoder.so");
-            }, 5, std::move(vgmStaticInfo));
+            registerPluginDecoder("VGMPlay", {"vgm", "vgz", "vgm.gz"},
+                    "libsiliconplayer_vgm_decoder.so", 5, std::move(vgmStaticInfo));
 
             DecoderStaticInfo gmeStaticInfo;
             gmeStaticInfo.hasPlaybackCapabilities = true;
@@ -138,18 +149,17 @@ namespace {
                 }
                 return AudioDecoder::OPTION_APPLY_LIVE;
             };
-            DecoderRegistry::getInstance().registerDecoder("Game Music Emu", {
+            registerPluginDecoder("Game Music Emu", {
                     "ay", "gbs", "gym", "hes", "kss", "nsf", "nsfe", "sap", "spc", "vgm", "vgz"
-            }, []() {
-                return DecoderPluginLoader::getInstance().createDecoder("libsiliconplayer_gme_decoder.so");
-            }, 6, std::move(gmeStaticInfo));
+            }, "libsiliconplayer_gme_decoder.so", 6, std::move(gmeStaticInfo));
 
             DecoderStaticInfo crsidStaticInfo;
             crsidStaticInfo.hasPlaybackCapabilities = true;
             crsidStaticInfo.playbackCapabilities =
                     AudioDecoder::PLAYBACK_CAP_SEEK |
                     AudioDecoder::PLAYBACK_CAP_CUSTOM_SAMPLE_RATE |
-                    AudioDecoder::PLAYBACK_CAP_LIVE_REPEAT_MODE;
+                    AudioDecoder::PLAYBACK_CAP_LIVE_REPEAT_MODE |
+                    AudioDecoder::PLAYBACK_CAP_STATE_SNAPSHOT;
             crsidStaticInfo.hasRepeatModeCapabilities = true;
             crsidStaticInfo.repeatModeCapabilities =
                     AudioDecoder::REPEAT_CAP_TRACK |
@@ -171,9 +181,8 @@ namespace {
                 }
                 return AudioDecoder::OPTION_APPLY_LIVE;
             };
-            DecoderRegistry::getInstance().registerDecoder("cRSID", {"sid", "psid", "rsid"}, []() {
-                return DecoderPluginLoader::getInstance().createDecoder("libsiliconplayer_crsid_decoder.so");
-            }, 4, std::move(crsidStaticInfo));
+            registerPluginDecoder("cRSID", {"sid", "psid", "rsid"},
+                    "libsiliconplayer_crsid_decoder.so", 4, std::move(crsidStaticInfo));
 
             DecoderStaticInfo sidplayfpStaticInfo;
             sidplayfpStaticInfo.hasPlaybackCapabilities = true;
@@ -204,11 +213,9 @@ namespace {
                 }
                 return AudioDecoder::OPTION_APPLY_LIVE;
             };
-            DecoderRegistry::getInstance().registerDecoder("LibSIDPlayFP", {
+            registerPluginDecoder("LibSIDPlayFP", {
                     "sid", "psid", "rsid", "mus", "str", "prg", "p00", "c64", "dat"
-            }, []() {
-                return DecoderPluginLoader::getInstance().createDecoder("libsiliconplayer_libsidplayfp_decoder.so");
-            }, 7, std::move(sidplayfpStaticInfo));
+            }, "libsiliconplayer_libsidplayfp_decoder.so", 7, std::move(sidplayfpStaticInfo));
 
             DecoderStaticInfo lazyUsf2StaticInfo;
             lazyUsf2StaticInfo.hasPlaybackCapabilities = true;
@@ -231,9 +238,10 @@ namespace {
                 }
                 return AudioDecoder::OPTION_APPLY_LIVE;
             };
-            DecoderRegistry::getInstance().registerDecoder("LazyUSF2", {"usf", "miniusf"}, []() {
-                return DecoderPluginLoader::getInstance().createDecoder("libsiliconplayer_lazyusf2_decoder.so");
-            }, 8, std::move(lazyUsf2StaticInfo));
+            // Each instance carries a full N64 RDRAM image.
+            lazyUsf2StaticInfo.maxConcurrentProbes = 2;
+            registerPluginDecoder("LazyUSF2", {"usf", "miniusf"},
+                    "libsiliconplayer_lazyusf2_decoder.so", 8, std::move(lazyUsf2StaticInfo));
 
             DecoderStaticInfo vio2sfStaticInfo;
             vio2sfStaticInfo.hasPlaybackCapabilities = true;
@@ -252,9 +260,10 @@ namespace {
             vio2sfStaticInfo.optionApplyPolicy = [](const char*) {
                 return AudioDecoder::OPTION_APPLY_LIVE;
             };
-            DecoderRegistry::getInstance().registerDecoder("Vio2SF", {"2sf", "mini2sf"}, []() {
-                return DecoderPluginLoader::getInstance().createDecoder("libsiliconplayer_vio2sf_decoder.so");
-            }, 9, std::move(vio2sfStaticInfo));
+            // Each instance carries a full NDS memory map.
+            vio2sfStaticInfo.maxConcurrentProbes = 2;
+            registerPluginDecoder("Vio2SF", {"2sf", "mini2sf"},
+                    "libsiliconplayer_vio2sf_decoder.so", 9, std::move(vio2sfStaticInfo));
 
             DecoderStaticInfo sc68StaticInfo;
             sc68StaticInfo.hasPlaybackCapabilities = true;
@@ -285,9 +294,8 @@ namespace {
                 }
                 return AudioDecoder::OPTION_APPLY_LIVE;
             };
-            DecoderRegistry::getInstance().registerDecoder("SC68", {"sc68", "sndh"}, []() {
-                return DecoderPluginLoader::getInstance().createDecoder("libsiliconplayer_sc68_decoder.so");
-            }, 11, std::move(sc68StaticInfo));
+            registerPluginDecoder("SC68", {"sc68", "sndh"},
+                    "libsiliconplayer_sc68_decoder.so", 11, std::move(sc68StaticInfo));
 
             DecoderStaticInfo adplugStaticInfo;
             adplugStaticInfo.hasPlaybackCapabilities = true;
@@ -309,7 +317,7 @@ namespace {
                 }
                 return AudioDecoder::OPTION_APPLY_LIVE;
             };
-            DecoderRegistry::getInstance().registerDecoder("AdPlug", {
+            registerPluginDecoder("AdPlug", {
                     "hsc", "sng", "imf", "wlf", "adlib", "a2m", "a2t", "xms",
                     "bam", "cmf", "adl", "d00", "dfm", "hsp", "ksm", "mad",
                     "mus", "mdy", "ims", "mdi", "mid", "sci", "laa", "mkj",
@@ -317,9 +325,7 @@ namespace {
                     "raw", "sat", "sa2", "xad", "lds", "plx", "m", "rol",
                     "xsm", "dro", "pis", "msc", "rix", "mkf", "jbm", "got",
                     "vgm", "vgz", "sop", "hsq", "sqx", "sdb", "agd", "ha2"
-            }, []() {
-                return DecoderPluginLoader::getInstance().createDecoder("libsiliconplayer_adplug_decoder.so");
-            }, 12, std::move(adplugStaticInfo));
+            }, "libsiliconplayer_adplug_decoder.so", 12, std::move(adplugStaticInfo));
 
             DecoderStaticInfo uadeStaticInfo;
             uadeStaticInfo.hasPlaybackCapabilities = true;
@@ -347,9 +353,10 @@ namespace {
                 }
                 return AudioDecoder::OPTION_APPLY_LIVE;
             };
-            DecoderRegistry::getInstance().registerDecoder("UADE", getUadeSupportedExtensions(), []() {
-                return DecoderPluginLoader::getInstance().createDecoder("libsiliconplayer_uade_decoder.so");
-            }, 14, std::move(uadeStaticInfo));
+            // Every instance spawns its own uadecore process.
+            uadeStaticInfo.maxConcurrentProbes = 2;
+            registerPluginDecoder("UADE", getUadeSupportedExtensions(),
+                    "libsiliconplayer_uade_decoder.so", 14, std::move(uadeStaticInfo));
 
             DecoderStaticInfo hivelyStaticInfo;
             hivelyStaticInfo.hasPlaybackCapabilities = true;
@@ -368,9 +375,8 @@ namespace {
             hivelyStaticInfo.optionApplyPolicy = [](const char*) {
                 return AudioDecoder::OPTION_APPLY_LIVE;
             };
-            DecoderRegistry::getInstance().registerDecoder("HivelyTracker", {"ahx", "hvl"}, []() {
-                return DecoderPluginLoader::getInstance().createDecoder("libsiliconplayer_hivelytracker_decoder.so");
-            }, 13, std::move(hivelyStaticInfo));
+            registerPluginDecoder("HivelyTracker", {"ahx", "hvl"},
+                    "libsiliconplayer_hivelytracker_decoder.so", 13, std::move(hivelyStaticInfo));
 
             DecoderStaticInfo klystrackStaticInfo;
             klystrackStaticInfo.hasPlaybackCapabilities = true;
@@ -389,9 +395,8 @@ namespace {
             klystrackStaticInfo.optionApplyPolicy = [](const char*) {
                 return AudioDecoder::OPTION_APPLY_LIVE;
             };
-            DecoderRegistry::getInstance().registerDecoder("Klystrack-plus", {"kt"}, []() {
-                return DecoderPluginLoader::getInstance().createDecoder("libsiliconplayer_klystrack_decoder.so");
-            }, 15, std::move(klystrackStaticInfo));
+            registerPluginDecoder("Klystrack-plus", {"kt"},
+                    "libsiliconplayer_klystrack_decoder.so", 15, std::move(klystrackStaticInfo));
 
             DecoderStaticInfo furnaceStaticInfo;
             furnaceStaticInfo.hasPlaybackCapabilities = true;
@@ -423,9 +428,10 @@ namespace {
                 }
                 return AudioDecoder::OPTION_APPLY_LIVE;
             };
-            DecoderRegistry::getInstance().registerDecoder("Furnace", {"fur", "dmf"}, []() {
-                return DecoderPluginLoader::getInstance().createDecoder("libsiliconplayer_furnace_decoder.so");
-            }, 16, std::move(furnaceStaticInfo));
+            // Loaded songs keep the whole engine and sample banks resident.
+            furnaceStaticInfo.maxConcurrentProbes = 2;
+            registerPluginDecoder("Furnace", {"fur", "dmf"},
+                    "libsiliconplayer_furnace_decoder.so", 16, std::move(furnaceStaticInfo));
         }
     };
 
@@ -435,6 +441,7 @@ namespace {
 AudioEngine::AudioEngine() {
     updateRenderQueueTuning();
     seekWorkerThread = std::thread([this]() { seekWorkerLoop(); });
+    preloadWorkerThread = std::thread([this]() { preloadWorkerLoop(); });
     renderWorkerThread = std::thread([this]() { renderWorkerLoop(); });
     createStream();
 }
@@ -450,6 +457,16 @@ AudioEngine::~AudioEngine() {
     if (seekWorkerThread.joinable()) {
         seekWorkerThread.join();
     }
+    {
+        std::lock_guard<std::mutex> lock(preloadMutex);
+        preloadWorkerStop = true;
+        preloadRequestPending = false;
+        preloadGeneration++;
+    }
+    preloadCv.notify_all();
+    if (preloadWorkerThread.joinable()) {
+        preloadWorkerThread.join();
+    }
     {
         std::lock_guard<std::mutex> lock(renderQueueMutex);
         renderWorkerStop = true;
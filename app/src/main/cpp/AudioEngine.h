@@ -14,6 +14,13 @@
 #include <unordered_map>
 #include <array>
 #include <chrono>
+#include "DecoderKeyframeIndex.h"
+#include "OutputDspChain.h"
+#include "PolyphaseResampler.h"
+#include "RenderProfiler.h"
+#include "RenderQueueController.h"
+#include "RenderQueueRing.h"
+#include "SpectrumAnalyzer.h"
 #include "decoders/AudioDecoder.h"
 #include "effects/openmpt_dsp/OpenMptDspEffects.h"
 
@@ -32,6 +39,22 @@ public:
     bool isEnginePlaying() const;
     void restart();
     void setUrl(const char* url);
+    // Gapless playback: opens and primes the next track in the background and
+    // switches to it at natural end (repeat mode off) without draining the queue.
+    void setNextUrl(const char* url);
+    void clearNextUrl();
+    bool consumeGaplessTransitionEvent();
+    // [state, createMs, openMs, primeMs, primedMs] of the latest preload.
+    std::vector<double> getNextTrackPreloadStats();
+    // Per-stage render pipeline timings; layout in RenderProfiler::snapshot().
+    std::vector<int64_t> getRenderProfileSnapshot() const;
+    void resetRenderProfile();
+    // Current render queue chunk/target, the measurements behind them and
+    // the last adaptation decisions.
+    std::string getRenderQueueTuningSummary() const;
+    // Latency bounds of 0 derive from the buffer preset; disabling pins the
+    // queue to the preset values.
+    void setRenderQueueAdaptation(bool enabled, int minLatencyMs, int maxLatencyMs);
     double getDurationSeconds();
     double getPositionSeconds();
     void seekToSeconds(double seconds);
@@ -221,6 +244,13 @@ public:
     int64_t getUadeSongBytes();
     int64_t getUadeSubsongBytes();
 
+    // Track info dialog snapshot: everything the dialog shows in one call.
+    // Layout: [version, staticPairCount, key, value, ...]. The static pairs
+    // (tags and per-core module info) are only included when the snapshot
+    // version differs from knownVersion; the live pairs (bitrate, backend,
+    // rates, row/order/position) follow and are always present.
+    std::vector<std::string> getTrackInfoSnapshot(uint64_t knownVersion);
+
     // Bitrate information
     int64_t getTrackBitrate();
     bool isTrackVBR();
@@ -295,6 +325,11 @@ private:
     std::vector<float> audioTrackFloatBuffer;
     std::vector<int16_t> audioTrackPcmBuffer;
     int audioTrackBufferFrames = 4096;
+    // Frames per write: half the track's actual buffer, at least the preset.
+    int audioTrackWriteFrames = 4096;
+    int audioTrackTrackFrames = 0;
+    // ENCODING_PCM_FLOAT track fed straight from audioTrackFloatBuffer.
+    bool audioTrackFloatOutput = false;
     std::atomic<bool> audioTrackStopRequested { false };
     int aaudioBufferFrames = 0;
     int streamSampleRate = 48000;
@@ -307,7 +342,7 @@ private:
     int outputBackendPreference = 0; // 0 auto, 1 aaudio, 2 opensl, 3 audiotrack
     int outputPerformanceMode = 2; // 0 auto, 1 low-latency, 2 none, 3 power-saving
     int outputBufferPreset = 3; // 0 very small, 1 small, 2 medium, 3 large, 4 very large
-    int outputResamplerPreference = 1; // 1 built-in, 2 sox
+    int outputResamplerPreference = 1; // 1 built-in, 2 sox, 3 polyphase sinc
     bool outputAllowFallback = true;
     std::atomic<bool> isPlaying { false };
     std::atomic<bool> looping { false };
@@ -331,6 +366,8 @@ private:
     int outputSoxrOutputRate = 0;
     int outputSoxrChannels = 0;
     bool outputSoxrUnavailable = false;
+    PolyphaseResampler outputSincResampler;
+    bool outputSincFlushed = false;
     bool resamplerPathLoggedForCurrentTrack = false;
     bool resamplerNoOpLoggedForCurrentTrack = false;
     double pendingBackwardTimelineTargetSeconds = -1.0;
@@ -363,12 +400,11 @@ private:
     std::atomic<bool> dspBitCrushEnabled { false };
     std::atomic<int> dspBitCrushBits { 16 };
     siliconplayer::effects::OpenMptDspEffects openMptDspEffects;
-    float outputLimiterGain = 1.0f;
-    std::vector<float> lookaheadClipperDelayLine;
-    size_t lookaheadClipperWriteIndex = 0;
-    int lookaheadClipperSampleRate = 0;
-    int lookaheadClipperChannels = 0;
-    int lookaheadClipperLastMode = 1;
+    // Bumped by every setter above; the render worker recompiles
+    // outputDspChain when it no longer matches outputDspChainGeneration.
+    std::atomic<uint32_t> outputDspSettingsGeneration { 1 };
+    uint32_t outputDspChainGeneration = 0;
+    OutputDspChain outputDspChain;
     std::atomic<bool> endFadeApplyToAllTracks { false };
     std::atomic<int> endFadeDurationMs { 10000 };
     std::atomic<int> endFadeCurve { 0 }; // 0 linear, 1 ease-in, 2 ease-out
@@ -379,18 +415,25 @@ private:
     std::array<float, 16384> visualizationScopeHistoryRight {};
     int visualizationScopeWriteIndex = 0;
     mutable std::array<int, 2> visualizationScopePrevTriggerIndex { -1, -1 };
-    std::array<float, 256> visualizationBars {};
-    std::array<float, 256> visualizationBarsPrev {};
     std::array<float, 2> visualizationVuLevels {};
     std::array<float, 2> visualizationVuLevelsPrev {};
     std::atomic<int> visualizationChannelCount { 2 };
-    std::array<float, 4096> visualizationMonoHistory {};
+    // Sized like the scope history so the analysis window can trail the
+    // write position by a full render chunk.
+    std::array<float, 16384> visualizationMonoHistory {};
     int visualizationMonoWriteIndex = 0;
-    int visualizationFramesSinceAnalysis = 0;
     int visualizationLastCallbackFrames = 0;
     int64_t visualizationLastCallbackNs = 0;
     mutable std::atomic<int64_t> visualizationLastRequestNs { 0 };
     mutable std::atomic<uint32_t> visualizationRequestedFeatures { 0 };
+    // Bars are analyzed on the polling thread, once per request that sees a
+    // new window; the last result is reused while the window stands still.
+    mutable std::mutex visualizationSpectrumMutex;
+    mutable SpectrumAnalyzer visualizationSpectrum;
+    mutable std::array<float, SpectrumAnalyzer::kBands> visualizationBars {};
+    mutable int visualizationBarsWindowEnd = -1;
+    mutable int visualizationBarsWriteIndex = -1;
+    mutable int visualizationBarsSampleRate = 0;
 
     static constexpr uint32_t kVisualizationFeatureWaveform = 1u << 0;
     static constexpr uint32_t kVisualizationFeatureBars = 1u << 1;
@@ -407,14 +450,17 @@ private:
     bool ensureOutputSoxrContextLocked(int channels, int inputRate, int outputRate);
     void freeOutputSoxrContextLocked();
     int readFromDecoderLocked(float* buffer, int numFrames, int channels, bool& reachedEnd);
+    int readDecoderTimedLocked(float* buffer, int numFrames);
     void renderResampledLocked(float* outputData, int32_t numFrames, int channels, int streamRate, bool& reachedEnd);
     void renderSoxrResampledLocked(float* outputData, int32_t numFrames, int channels, int streamRate, int renderRate, bool& reachedEnd);
+    void renderSincResampledLocked(float* outputData, int32_t numFrames, int channels, bool& reachedEnd);
     void recoverStreamIfNeeded();
     void clearRenderQueue();
     void appendRenderQueue(const float* data, int numFrames, int channels);
     int popRenderQueue(float* outputData, int numFrames, int channels);
     int renderQueueFrames() const;
-    void ensureRenderQueueCapacityLocked(size_t minSampleCapacity);
+    void ensureRenderQueueCapacity(size_t minSampleCapacity);
+    void recordRenderQueueCallbackTime(int64_t elapsedNs);
     void renderWorkerLoop();
     void updateRenderQueueTuning();
     bool requestStreamStart();
@@ -427,8 +473,12 @@ private:
     void closeAaudioStream();
     void closeOpenSlStream();
     void closeAudioTrackStream();
-    bool renderOutputCallbackFrames(float* outputData, int32_t numFrames, int callbackRate);
+    // Fills outputData from the render queue and applies the pause/resume
+    // fade and the final clamp. With pcm16Output the clamped result is
+    // written there as int16 instead (outputData is then scratch).
+    bool renderOutputCallbackFrames(float* outputData, int32_t numFrames, int callbackRate, int16_t* pcm16Output = nullptr);
     bool enqueueOpenSlBuffer(bool allowUnderrun = true);
+    bool renderAudioTrackFrames(int frames, int rate, bool& shouldStop);
     void audioTrackRenderLoop();
 
     void createStream();
@@ -439,15 +489,10 @@ private:
     float computeEndFadeGainLocked(double playbackPositionSeconds) const;
     void beginPauseResumeFadeLocked(bool fadeIn, int streamRate, int durationMs, float attenuationDb);
     float nextPauseResumeFadeGainLocked();
-    void applyGain(float* buffer, int numFrames, int channels, float extraGain = 1.0f);
-    void applyMasterChannelRouting(float* buffer, int numFrames, int channels);
-    void applyMonoDownmix(float* buffer, int numFrames, int channels);
-    void applyOpenMptDspEffects(float* buffer, int numFrames, int channels, int sampleRate);
-    void applyOutputLimiter(float* buffer, int numFrames, int channels);
-    void applyLookaheadClipper(float* buffer, int numFrames, int channels, int sampleRate);
+    void markOutputDspSettingsChanged();
+    void applyOutputDspChainLocked(float* buffer, int numFrames, int channels, int sampleRate, float extraGain);
     void resetLookaheadClipperStateLocked();
     void updateVisualizationDataFromOutputCallback(const float* buffer, int numFrames, int channels, uint32_t requestedFeatures);
-    void updateVisualizationDataLocked(const float* buffer, int numFrames, int channels);
     void markVisualizationRequested(uint32_t features) const;
     bool shouldUpdateVisualization(uint32_t* outFeatures) const;
 
@@ -479,15 +524,90 @@ private:
     std::atomic<bool> seekAbortRequested { false };
     std::atomic<bool> stopStreamAfterSeek { false };
     std::vector<float> asyncSeekDiscardBuffer;
+    // Snapshot keyframes for render-forward seeks; guarded by decoderMutex.
+    DecoderKeyframeIndex decoderKeyframeIndex;
+    // Rendered frames left before the render worker next looks at the index.
+    int64_t decoderKeyframeFramesUntilCheck = 0;
+    // Track info dialog fields, published by the render worker while the
+    // dialog polls so getTrackInfoSnapshot() never waits on decoderMutex.
+    // Readers copy the pointer under trackInfoPublishMutex; the contents are
+    // immutable once published.
+    struct PublishedTrackInfo {
+        uint64_t staticVersion = 0;
+        uint64_t liveVersion = 0;
+        int64_t publishedNs = 0;
+        std::shared_ptr<const std::vector<std::string>> staticFields;
+        std::vector<std::string> liveFields;
+    };
+    static constexpr int64_t kTrackInfoPublishIntervalNs = 250000000;
+    // The worker only publishes while polls keep arriving.
+    static constexpr int64_t kTrackInfoRequestWindowNs = 2000000000;
+    // Older than this and the reader assumes the worker is idle.
+    static constexpr int64_t kTrackInfoStaleNs = 1000000000;
+    mutable std::mutex trackInfoPublishMutex;
+    std::shared_ptr<const PublishedTrackInfo> trackInfoPublished;
+    std::atomic<int64_t> trackInfoLastRequestNs { 0 };
+    // Static half bookkeeping; guarded by decoderMutex.
+    bool trackInfoSnapshotValid = false;
+    int trackInfoSnapshotSubtune = -1;
+    uint64_t trackInfoSnapshotVersion = 0;
+    uint64_t trackInfoLiveVersion = 0;
+    int64_t trackInfoLastPublishNs = 0;
+    void publishTrackInfoLocked(int64_t nowNs);
+    void maybePublishTrackInfoLocked(int64_t nowNs);
+    void invalidateTrackInfoSnapshotLocked();
+    bool bindDecoderKeyframeIndexLocked();
+    void captureDecoderKeyframeLocked(int renderedFrames, int sampleRate);
     double runAsyncSeekLocked(double targetSeconds);
     void seekWorkerLoop();
+
+    static constexpr int kNextTrackPreloadIdle = 0;
+    static constexpr int kNextTrackPreloadLoading = 1;
+    static constexpr int kNextTrackPreloadReady = 2;
+    static constexpr int kNextTrackPreloadFailed = 3;
+    static constexpr int kNextTrackPreloadSkipped = 4;
+    struct PreparedNextTrack {
+        std::unique_ptr<AudioDecoder> decoder;
+        std::string url;
+        int sampleRate = 0;
+        int primedChannels = 0;
+        std::vector<float> primedSamples;
+    };
+    std::thread preloadWorkerThread;
+    std::mutex preloadMutex; // lock order: decoderMutex before preloadMutex
+    std::condition_variable preloadCv;
+    bool preloadWorkerStop = false;
+    bool preloadRequestPending = false;
+    std::string preloadRequestUrl;
+    uint64_t preloadGeneration = 0;
+    PreparedNextTrack preparedNextTrack;
+    // Decoders replaced by a gapless transition, destroyed on the preload
+    // worker so their teardown stays off the render worker.
+    std::vector<std::unique_ptr<AudioDecoder>> retiredDecoders;
+    std::atomic<int> nextTrackPreloadState { kNextTrackPreloadIdle };
+    std::atomic<double> nextTrackCreateMs { 0.0 };
+    std::atomic<double> nextTrackOpenMs { 0.0 };
+    std::atomic<double> nextTrackPrimeMs { 0.0 };
+    std::atomic<double> nextTrackPrimedMs { 0.0 };
+    std::atomic<bool> gaplessTransitionPending { false };
+    // Samples pre-rendered by the preload worker for the active decoder,
+    // served ahead of decoder->read(); guarded by decoderMutex.
+    std::vector<float> activePrimedSamples;
+    size_t activePrimedOffset = 0;
+    int activePrimedChannels = 0;
+    void preloadWorkerLoop();
+    bool takePreparedNextTrack(const char* url, PreparedNextTrack& out);
+    void requeueNextTrackPreloadForCore(const std::string& coreName);
+    bool promotePreparedNextTrackLocked(bool requireMatchingFormat);
+    int readPrimedFramesLocked(float* buffer, int numFrames, int channels);
+    void discardActivePrimedFramesLocked();
+
     std::thread renderWorkerThread;
+    // Guards renderWorkerStop and the worker's condition variable only; the
+    // queued samples live in the lock-free renderQueueRing.
     mutable std::mutex renderQueueMutex;
     std::condition_variable renderWorkerCv;
-    std::vector<float> renderQueueRing;
-    size_t renderQueueReadIndex = 0;
-    size_t renderQueueWriteIndex = 0;
-    size_t renderQueueSampleCount = 0;
+    RenderQueueRing renderQueueRing;
     std::atomic<int> renderWorkerChunkFrames { 256 };
     std::atomic<int> renderWorkerTargetFrames { 16384 };
     std::atomic<bool> backgroundPlaybackMode { false };
@@ -495,6 +615,23 @@ private:
     std::atomic<uint64_t> renderQueueUnderrunCount { 0 };
     std::atomic<uint64_t> renderQueueUnderrunFrames { 0 };
     std::atomic<uint64_t> renderQueueCallbackCount { 0 };
+    // Time the output callback spends in render queue operations (pop, fill
+    // level checks, worker wake-up), to spot callback-side stalls on loaded devices.
+    std::atomic<uint64_t> renderQueueCallbackQueueNs { 0 };
+    std::atomic<int64_t> renderQueueCallbackQueueMaxNs { 0 };
+    RenderProfiler renderProfiler;
+    // Decoder read time/frames of the chunk being rendered (under decoderMutex).
+    int64_t renderChunkDecodeNs = 0;
+    int renderChunkDecodedFrames = 0;
+    int64_t lastOutputCallbackNs = 0; // output callback only
+    RenderQueueController renderQueueController;
+    std::atomic<bool> renderQueueAdaptive { true };
+    std::atomic<int> renderQueueMinLatencyMs { 0 };
+    std::atomic<int> renderQueueMaxLatencyMs { 0 };
+    // Underruns during steady playback only; the controller ignores the
+    // ones at track end and terminal stop.
+    std::atomic<uint64_t> renderQueueTuningUnderrunCount { 0 };
+    const char* renderQueueTunedDecoderName = nullptr; // render worker only
 #ifndef NDEBUG
     std::atomic<int64_t> renderQueueLastUnderrunLogNs { 0 };
 #endif
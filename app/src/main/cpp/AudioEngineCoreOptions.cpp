@@ -26,6 +26,7 @@ void AudioEngine::setCoreOutputSampleRate(const std::string& coreName, int sampl
             resetResamplerStateLocked();
         }
     }
+    requeueNextTrackPreloadForCore(coreName);
 }
 
 void AudioEngine::setCoreOption(
@@ -38,7 +39,12 @@ void AudioEngine::setCoreOption(
     coreOptions[coreName][optionName] = optionValue;
     if (decoder && coreName == decoder->getName()) {
         decoder->setOption(optionName.c_str(), optionValue.c_str());
+        // Option changes can alter emulation; earlier snapshots no longer match.
+        decoderKeyframeIndex.invalidate();
+        invalidateTrackInfoSnapshotLocked();
     }
+    // A prepared next track was opened with the old options.
+    requeueNextTrackPreloadForCore(coreName);
 }
 
 int AudioEngine::getCoreOptionApplyPolicy(
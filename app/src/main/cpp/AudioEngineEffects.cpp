@@ -11,239 +11,97 @@
 
 namespace {
     constexpr int kVisualizationWaveformSize = 256;
-    constexpr int kVisualizationFftSize = 2048;
-    constexpr int kVisualizationSpectrumBins = 256;
-    constexpr float kVisualizationMinDisplayHz = 35.0f;
-
-    int computeVisualizationMinBin(int sampleRateHz) {
-        const int fftHalf = kVisualizationFftSize / 2;
-        const float sampleRate = static_cast<float>(std::max(sampleRateHz, 1));
-        const float rawBin = (kVisualizationMinDisplayHz / sampleRate) * static_cast<float>(kVisualizationFftSize);
-        return std::clamp(static_cast<int>(std::ceil(rawBin)), 1, fftHalf - 2);
-    }
-
-    float computeVisualizationTiltCompensation(float freqNorm) {
-        const float clamped = std::clamp(freqNorm, 0.0f, 1.0f);
-        const float shaped = std::pow(clamped, 0.85f);
-        // Attenuate low-end dominance while preserving high-band detail.
-        return 0.24f + (1.76f * shaped);
-    }
-
-    void fftInPlace(std::array<float, kVisualizationFftSize>& real,
-                    std::array<float, kVisualizationFftSize>& imag) {
-        static bool bitReverseInitialized = false;
-        static std::array<int, kVisualizationFftSize> bitReverse {};
-        if (!bitReverseInitialized) {
-            constexpr int kBitCount = 11; // log2(2048)
-            for (int i = 0; i < kVisualizationFftSize; ++i) {
-                int x = i;
-                int reversed = 0;
-                for (int bit = 0; bit < kBitCount; ++bit) {
-                    reversed = (reversed << 1) | (x & 1);
-                    x >>= 1;
-                }
-                bitReverse[i] = reversed;
-            }
-            bitReverseInitialized = true;
-        }
-
-        for (int i = 0; i < kVisualizationFftSize; ++i) {
-            const int j = bitReverse[i];
-            if (j > i) {
-                std::swap(real[i], real[j]);
-                std::swap(imag[i], imag[j]);
-            }
-        }
-
-        for (int len = 2; len <= kVisualizationFftSize; len <<= 1) {
-            const int halfLen = len >> 1;
-            const float theta = -2.0f * static_cast<float>(M_PI) / static_cast<float>(len);
-            const float phaseStepReal = std::cos(theta);
-            const float phaseStepImag = std::sin(theta);
-            for (int i = 0; i < kVisualizationFftSize; i += len) {
-                float twiddleReal = 1.0f;
-                float twiddleImag = 0.0f;
-                for (int j = 0; j < halfLen; ++j) {
-                    const int even = i + j;
-                    const int odd = even + halfLen;
-                    const float oddReal = real[odd];
-                    const float oddImag = imag[odd];
-                    const float tReal = (twiddleReal * oddReal) - (twiddleImag * oddImag);
-                    const float tImag = (twiddleReal * oddImag) + (twiddleImag * oddReal);
-                    const float evenReal = real[even];
-                    const float evenImag = imag[even];
-
-                    real[odd] = evenReal - tReal;
-                    imag[odd] = evenImag - tImag;
-                    real[even] = evenReal + tReal;
-                    imag[even] = evenImag + tImag;
-
-                    const float nextTwiddleReal =
-                            (twiddleReal * phaseStepReal) - (twiddleImag * phaseStepImag);
-                    const float nextTwiddleImag =
-                            (twiddleReal * phaseStepImag) + (twiddleImag * phaseStepReal);
-                    twiddleReal = nextTwiddleReal;
-                    twiddleImag = nextTwiddleImag;
-                }
-            }
-        }
-    }
-
-    std::array<float, kVisualizationSpectrumBins> buildVisualizationBarsFromMonoHistory(
-            const std::array<float, 4096>& monoHistory,
-            int monoWriteIndex,
-            int sampleRateHz
-    ) {
-        std::array<float, kVisualizationSpectrumBins> bars {};
-        std::array<float, kVisualizationFftSize> fftReal {};
-        std::array<float, kVisualizationFftSize> fftImag {};
-        constexpr int kMonoHistorySize = 4096;
-        const int safeWriteIndex =
-                ((monoWriteIndex % kMonoHistorySize) + kMonoHistorySize) % kMonoHistorySize;
-        for (int n = 0; n < kVisualizationFftSize; ++n) {
-            const int historyIndex =
-                    (safeWriteIndex - kVisualizationFftSize + n + kMonoHistorySize) % kMonoHistorySize;
-            fftReal[n] = monoHistory[historyIndex];
-        }
-
-        // Remove DC and apply Hann window before FFT.
-        double mean = 0.0;
-        for (float sample : fftReal) {
-            mean += sample;
-        }
-        mean /= static_cast<double>(kVisualizationFftSize);
-        const float invSizeMinusOne = 1.0f / static_cast<float>(kVisualizationFftSize - 1);
-        for (int n = 0; n < kVisualizationFftSize; ++n) {
-            const float centered = fftReal[n] - static_cast<float>(mean);
-            const float phase = static_cast<float>(n) * invSizeMinusOne;
-            const float hann = 0.5f - (0.5f * std::cos(2.0f * static_cast<float>(M_PI) * phase));
-            fftReal[n] = centered * hann;
-            fftImag[n] = 0.0f;
-        }
-
-        fftInPlace(fftReal, fftImag);
-
-        const int fftHalf = kVisualizationFftSize / 2;
-        const float sampleRate = static_cast<float>(std::max(sampleRateHz, 1));
-        const int minBin = computeVisualizationMinBin(sampleRateHz);
-        const int maxBin = fftHalf - 1;
-        const float minFrequencyHz =
-                (static_cast<float>(minBin) * sampleRate) / static_cast<float>(kVisualizationFftSize);
-        const float maxFrequencyHz =
-                (static_cast<float>(maxBin) * sampleRate) / static_cast<float>(kVisualizationFftSize);
-        const float frequencyRatio = std::max(maxFrequencyHz / std::max(minFrequencyHz, 1.0f), 1.001f);
-        for (int band = 0; band < kVisualizationSpectrumBins; ++band) {
-            const float t0 = static_cast<float>(band) / static_cast<float>(kVisualizationSpectrumBins);
-            const float t1 = static_cast<float>(band + 1) / static_cast<float>(kVisualizationSpectrumBins);
-            const float startFrequencyHz = minFrequencyHz * std::pow(frequencyRatio, t0);
-            const float endFrequencyHz = minFrequencyHz * std::pow(frequencyRatio, t1);
-            const int startBin = static_cast<int>(std::floor(
-                    (startFrequencyHz / sampleRate) * static_cast<float>(kVisualizationFftSize)));
-            const int endBin = static_cast<int>(std::ceil(
-                    (endFrequencyHz / sampleRate) * static_cast<float>(kVisualizationFftSize))) - 1;
-            const int clampedStart = std::clamp(startBin, minBin, maxBin);
-            const int clampedEnd = std::clamp(std::max(endBin, clampedStart), clampedStart, maxBin);
-
-            double powerSum = 0.0;
-            int count = 0;
-            for (int bin = clampedStart; bin <= clampedEnd; ++bin) {
-                const double re = fftReal[bin];
-                const double im = fftImag[bin];
-                powerSum += (re * re) + (im * im);
-                count += 1;
-            }
-            if (count <= 0) {
-                bars[band] = 0.0f;
-                continue;
-            }
-
-            const double avgPower = powerSum / static_cast<double>(count);
-            const double magnitude = std::sqrt(avgPower) / static_cast<double>(kVisualizationFftSize);
-            const float freqNorm = t0;
-            const float tiltCompensation = computeVisualizationTiltCompensation(freqNorm);
-            const double weighted = magnitude * static_cast<double>(68.0f * tiltCompensation);
-            // Soft knee prevents early saturation while preserving detail.
-            bars[band] = static_cast<float>(std::clamp(weighted / (1.0 + weighted), 0.0, 1.0));
-        }
-        return bars;
-    }
 }
 
 // Gain control implementation
 void AudioEngine::setMasterGain(float gainDb) {
     masterGainDb.store(gainDb);
+    markOutputDspSettingsChanged();
 }
 
 void AudioEngine::setPluginGain(float gainDb) {
     pluginGainDb.store(gainDb);
+    markOutputDspSettingsChanged();
 }
 
 void AudioEngine::setSongGain(float gainDb) {
     songGainDb.store(gainDb);
+    markOutputDspSettingsChanged();
 }
 
 void AudioEngine::setForceMono(bool enabled) {
     forceMono.store(enabled);
+    markOutputDspSettingsChanged();
 }
 
 void AudioEngine::setOutputLimiterEnabled(bool enabled) {
     outputLimiterEnabled.store(enabled);
+    markOutputDspSettingsChanged();
 }
 
 void AudioEngine::setLookaheadClipperMode(int mode) {
     const int normalized = (mode >= 0 && mode <= 2) ? mode : 1;
-    const int previous = lookaheadClipperMode.exchange(normalized);
-    if (previous != normalized) {
-        std::lock_guard<std::mutex> lock(decoderMutex);
-        resetLookaheadClipperStateLocked();
-        lookaheadClipperLastMode = normalized;
+    if (lookaheadClipperMode.exchange(normalized) != normalized) {
+        // The chain drops its delay line when it picks up the new mode.
+        markOutputDspSettingsChanged();
     }
 }
 
 void AudioEngine::setDspBassEnabled(bool enabled) {
     dspBassEnabled.store(enabled);
+    markOutputDspSettingsChanged();
 }
 
 void AudioEngine::setDspBassDepth(int depth) {
     dspBassDepth.store(std::clamp(depth, 0, 4));
+    markOutputDspSettingsChanged();
 }
 
 void AudioEngine::setDspBassRange(int range) {
     dspBassRange.store(std::clamp(range, 0, 4));
+    markOutputDspSettingsChanged();
 }
 
 void AudioEngine::setDspSurroundEnabled(bool enabled) {
     dspSurroundEnabled.store(enabled);
+    markOutputDspSettingsChanged();
 }
 
 void AudioEngine::setDspSurroundDepth(int depth) {
     dspSurroundDepth.store(std::clamp(depth, 1, 16));
+    markOutputDspSettingsChanged();
 }
 
 void AudioEngine::setDspSurroundDelayMs(int delayMs) {
     const int clamped = std::clamp(delayMs, 5, 45);
     const int step = ((clamped - 5) + 2) / 5;
     dspSurroundDelayMs.store(5 + (step * 5));
+    markOutputDspSettingsChanged();
 }
 
 void AudioEngine::setDspReverbEnabled(bool enabled) {
     dspReverbEnabled.store(enabled);
+    markOutputDspSettingsChanged();
 }
 
 void AudioEngine::setDspReverbDepth(int depth) {
     dspReverbDepth.store(std::clamp(depth, 1, 16));
+    markOutputDspSettingsChanged();
 }
 
 void AudioEngine::setDspReverbPreset(int preset) {
     dspReverbPreset.store(std::clamp(preset, 0, 28));
+    markOutputDspSettingsChanged();
 }
 
 void AudioEngine::setDspBitCrushEnabled(bool enabled) {
     dspBitCrushEnabled.store(enabled);
+    markOutputDspSettingsChanged();
 }
 
 void AudioEngine::setDspBitCrushBits(int bits) {
     dspBitCrushBits.store(std::clamp(bits, 1, 24));
+    markOutputDspSettingsChanged();
 }
 
 void AudioEngine::setMasterChannelMute(int channelIndex, bool enabled) {
@@ -252,6 +110,7 @@ void AudioEngine::setMasterChannelMute(int channelIndex, bool enabled) {
     } else if (channelIndex == 1) {
         masterMuteRight.store(enabled);
     }
+    markOutputDspSettingsChanged();
 }
 
 void AudioEngine::setMasterChannelSolo(int channelIndex, bool enabled) {
@@ -260,6 +119,7 @@ void AudioEngine::setMasterChannelSolo(int channelIndex, bool enabled) {
     } else if (channelIndex == 1) {
         masterSoloRight.store(enabled);
     }
+    markOutputDspSettingsChanged();
 }
 
 void AudioEngine::setEndFadeApplyToAllTracks(bool enabled) {
@@ -461,216 +321,59 @@ float AudioEngine::computeEndFadeGainLocked(double playbackPositionSeconds) cons
     return std::clamp(gain, 0.0f, 1.0f);
 }
 
-// Apply two-stage gain pipeline: Master → (Plugin or Song)
-void AudioEngine::applyGain(float* buffer, int numFrames, int channels, float extraGain) {
-    const float masterDb = masterGainDb.load();
-    const float pluginDb = pluginGainDb.load();
-    const float songDb = songGainDb.load();
-
-    // Calculate total gain
-    const float masterGain = dbToGain(masterDb);
-    // Song volume overrides plugin volume when not at neutral (0dB)
-    const float secondaryGain = (songDb != 0.0f) ? dbToGain(songDb) : dbToGain(pluginDb);
-    const float baseGain = masterGain * secondaryGain * std::clamp(extraGain, 0.0f, 1.0f);
-
-    if (baseGain == 1.0f) {
-        return;
-    }
-    for (int frame = 0; frame < numFrames; ++frame) {
-        const int baseIndex = frame * channels;
-        for (int channel = 0; channel < channels; ++channel) {
-            buffer[baseIndex + channel] *= baseGain;
-        }
-    }
+void AudioEngine::markOutputDspSettingsChanged() {
+    outputDspSettingsGeneration.fetch_add(1, std::memory_order_release);
 }
 
-void AudioEngine::applyMasterChannelRouting(float* buffer, int numFrames, int channels) {
-    if (!buffer || numFrames <= 0 || channels < 2) {
-        return;
-    }
-
-    const bool muteLeft = masterMuteLeft.load();
-    const bool muteRight = masterMuteRight.load();
-    const bool soloLeft = masterSoloLeft.load();
-    const bool soloRight = masterSoloRight.load();
-    const bool anySolo = soloLeft || soloRight;
-
-    const bool leftEnabled = anySolo ? soloLeft : !muteLeft;
-    const bool rightEnabled = anySolo ? soloRight : !muteRight;
-
-    if (leftEnabled && rightEnabled) {
-        return;
-    }
-
-    for (int i = 0; i < numFrames; ++i) {
-        const int base = i * channels;
-        if (!leftEnabled) {
-            buffer[base] = 0.0f;
-        }
-        if (!rightEnabled) {
-            buffer[base + 1] = 0.0f;
-        }
-    }
-}
-
-// Downmix stereo to mono
-void AudioEngine::applyMonoDownmix(float* buffer, int numFrames, int channels) {
-    if (!forceMono.load() || channels != 2) {
-        return;
-    }
-
-    // Average left and right channels
-    for (int i = 0; i < numFrames; i++) {
-        const float mono = (buffer[i * 2] + buffer[i * 2 + 1]) * 0.5f;
-        buffer[i * 2] = mono;
-        buffer[i * 2 + 1] = mono;
-    }
-}
-
-void AudioEngine::applyOpenMptDspEffects(float* buffer, int numFrames, int channels, int sampleRate) {
-    siliconplayer::effects::OpenMptDspParams params;
-    params.bassEnabled = dspBassEnabled.load(std::memory_order_relaxed);
-    params.bassDepth = dspBassDepth.load(std::memory_order_relaxed);
-    params.bassRange = dspBassRange.load(std::memory_order_relaxed);
-    params.surroundEnabled = dspSurroundEnabled.load(std::memory_order_relaxed);
-    params.surroundDepth = dspSurroundDepth.load(std::memory_order_relaxed);
-    params.surroundDelayMs = dspSurroundDelayMs.load(std::memory_order_relaxed);
-    params.reverbEnabled = dspReverbEnabled.load(std::memory_order_relaxed);
-    params.reverbDepth = dspReverbDepth.load(std::memory_order_relaxed);
-    params.reverbPreset = dspReverbPreset.load(std::memory_order_relaxed);
-    params.bitCrushEnabled = dspBitCrushEnabled.load(std::memory_order_relaxed);
-    params.bitCrushBits = dspBitCrushBits.load(std::memory_order_relaxed);
-
-    const bool anyDspEnabled =
-            params.bassEnabled || params.surroundEnabled || params.reverbEnabled || params.bitCrushEnabled;
-    if (!anyDspEnabled || !buffer || numFrames <= 0 || channels <= 0) {
-        return;
-    }
-
-    constexpr float kDspBusPreGain = 0.5623413f; // -5.0 dB
-    constexpr float kDspBusMakeupGain = 1.5848932f; // +4.0 dB (net: -1.0 dB)
-    const int totalSamples = numFrames * channels;
-
-    constexpr float kSoftClipThreshold = 0.90f;
-    constexpr float kneeWidth = 1.0f - kSoftClipThreshold;
-
-    for (int i = 0; i < totalSamples; ++i) {
-        float sample = buffer[i] * kDspBusPreGain;
-        const float absSample = std::abs(sample);
-        if (absSample > kSoftClipThreshold) {
-            const float sign = sample < 0.0f ? -1.0f : 1.0f;
-            const float over = (absSample - kSoftClipThreshold) / kneeWidth;
-            sample = sign * (kSoftClipThreshold + (kneeWidth * (1.0f - std::exp(-over))));
-        }
-        buffer[i] = std::clamp(sample, -1.0f, 1.0f);
-    }
-
-    openMptDspEffects.process(buffer, numFrames, channels, sampleRate, params);
-    for (int i = 0; i < totalSamples; ++i) {
-        buffer[i] *= kDspBusMakeupGain;
-    }
-}
-
-void AudioEngine::applyOutputLimiter(float* buffer, int numFrames, int channels) {
-    if (!buffer || numFrames <= 0 || channels <= 0) {
-        return;
-    }
-
-    const bool limiterEnabledNow = outputLimiterEnabled.load(std::memory_order_relaxed);
-    if (!limiterEnabledNow) {
-        outputLimiterGain = 1.0f;
-        return;
-    }
-
-    const int totalSamples = numFrames * channels;
-    float limiterGain = 1.0f;
-    float peak = 0.0f;
-    for (int i = 0; i < totalSamples; ++i) {
-        peak = std::max(peak, std::abs(buffer[i]));
-    }
-    const float targetGain = (peak > 1.0f) ? (1.0f / peak) : 1.0f;
-    const float attack = 0.45f;
-    const float release = 0.04f;
-    const float coeff = (targetGain < outputLimiterGain) ? attack : release;
-    outputLimiterGain += (targetGain - outputLimiterGain) * coeff;
-    outputLimiterGain = std::clamp(outputLimiterGain, 0.1f, 1.0f);
-    limiterGain = outputLimiterGain;
-
-    constexpr float kSoftClipStart = 0.92f;
-    constexpr float kSoftClipDrive = 1.45f;
-    const float tanhNorm = std::tanh(kSoftClipDrive);
-    for (int i = 0; i < totalSamples; ++i) {
-        float sample = buffer[i] * limiterGain;
-        const float absSample = std::abs(sample);
-        if (absSample > kSoftClipStart) {
-            sample = std::tanh(sample * kSoftClipDrive) / tanhNorm;
-        }
-        buffer[i] = std::clamp(sample, -1.0f, 1.0f);
-    }
+// Output chain: Master -> (Song or Plugin) gain, L/R routing, OpenMPT DSP,
+// mono downmix, limiter, lookahead clipper. The settings are compiled into
+// outputDspChain once per change instead of being re-read per chunk.
+void AudioEngine::applyOutputDspChainLocked(
+        float* buffer,
+        int numFrames,
+        int channels,
+        int sampleRate,
+        float extraGain
+) {
+    const uint32_t generation = outputDspSettingsGeneration.load(std::memory_order_acquire);
+    if (generation != outputDspChainGeneration) {
+        OutputDspSettings settings;
+        // Song volume overrides plugin volume when not at neutral (0dB)
+        const float songDb = songGainDb.load(std::memory_order_relaxed);
+        const float secondaryDb = (songDb != 0.0f) ? songDb : pluginGainDb.load(std::memory_order_relaxed);
+        settings.gain = dbToGain(masterGainDb.load(std::memory_order_relaxed)) * dbToGain(secondaryDb);
+
+        const bool soloLeft = masterSoloLeft.load(std::memory_order_relaxed);
+        const bool soloRight = masterSoloRight.load(std::memory_order_relaxed);
+        const bool anySolo = soloLeft || soloRight;
+        settings.leftEnabled = anySolo ? soloLeft : !masterMuteLeft.load(std::memory_order_relaxed);
+        settings.rightEnabled = anySolo ? soloRight : !masterMuteRight.load(std::memory_order_relaxed);
+
+        settings.forceMono = forceMono.load(std::memory_order_relaxed);
+        settings.limiterEnabled = outputLimiterEnabled.load(std::memory_order_relaxed);
+        settings.lookaheadClipperMode = lookaheadClipperMode.load(std::memory_order_relaxed);
+
+        auto& params = settings.openMpt;
+        params.bassEnabled = dspBassEnabled.load(std::memory_order_relaxed);
+        params.bassDepth = dspBassDepth.load(std::memory_order_relaxed);
+        params.bassRange = dspBassRange.load(std::memory_order_relaxed);
+        params.surroundEnabled = dspSurroundEnabled.load(std::memory_order_relaxed);
+        params.surroundDepth = dspSurroundDepth.load(std::memory_order_relaxed);
+        params.surroundDelayMs = dspSurroundDelayMs.load(std::memory_order_relaxed);
+        params.reverbEnabled = dspReverbEnabled.load(std::memory_order_relaxed);
+        params.reverbDepth = dspReverbDepth.load(std::memory_order_relaxed);
+        params.reverbPreset = dspReverbPreset.load(std::memory_order_relaxed);
+        params.bitCrushEnabled = dspBitCrushEnabled.load(std::memory_order_relaxed);
+        params.bitCrushBits = dspBitCrushBits.load(std::memory_order_relaxed);
+
+        outputDspChain.configure(settings);
+        outputDspChainGeneration = generation;
+    }
+    outputDspChain.process(buffer, numFrames, channels, sampleRate, extraGain, openMptDspEffects);
 }
 
 void AudioEngine::resetLookaheadClipperStateLocked() {
-    std::fill(lookaheadClipperDelayLine.begin(), lookaheadClipperDelayLine.end(), 0.0f);
-    lookaheadClipperWriteIndex = 0;
-    lookaheadClipperSampleRate = 0;
-    lookaheadClipperChannels = 0;
-}
-
-void AudioEngine::applyLookaheadClipper(float* buffer, int numFrames, int channels, int sampleRate) {
-    if (!buffer || numFrames <= 0 || channels <= 0) {
-        return;
-    }
-
-    const int mode = lookaheadClipperMode.load(std::memory_order_relaxed);
-    if (mode <= 0) {
-        resetLookaheadClipperStateLocked();
-        lookaheadClipperLastMode = mode;
-        return;
-    }
-
-    const int safeRate = std::max(sampleRate, 8000);
-    const int safeChannels = std::clamp(channels, 1, 2);
-    const int lookaheadFrames = std::clamp((safeRate * 5) / 1000, 32, 512);
-    const size_t delaySamples = static_cast<size_t>(lookaheadFrames) * static_cast<size_t>(safeChannels);
-    if (delaySamples == 0u) {
-        return;
-    }
-
-    if (lookaheadClipperDelayLine.size() != delaySamples ||
-        lookaheadClipperSampleRate != safeRate ||
-        lookaheadClipperChannels != safeChannels ||
-        lookaheadClipperLastMode != mode) {
-        lookaheadClipperDelayLine.assign(delaySamples, 0.0f);
-        lookaheadClipperWriteIndex = 0;
-        lookaheadClipperSampleRate = safeRate;
-        lookaheadClipperChannels = safeChannels;
-        lookaheadClipperLastMode = mode;
-    }
-
-    constexpr float kSoftClipThreshold = 0.86f;
-    const float kneeWidth = 1.0f - kSoftClipThreshold;
-
-    const int totalSamples = numFrames * safeChannels;
-    for (int i = 0; i < totalSamples; ++i) {
-        const float incoming = buffer[i];
-        float delayed = lookaheadClipperDelayLine[lookaheadClipperWriteIndex];
-        lookaheadClipperDelayLine[lookaheadClipperWriteIndex] = incoming;
-        lookaheadClipperWriteIndex = (lookaheadClipperWriteIndex + 1u) % delaySamples;
-
-        if (mode == 2) {
-            buffer[i] = std::clamp(delayed, -1.0f, 1.0f);
-            continue;
-        }
-
-        float sample = delayed;
-        const float absSample = std::abs(sample);
-        if (absSample > kSoftClipThreshold) {
-            const float sign = sample < 0.0f ? -1.0f : 1.0f;
-            const float over = (absSample - kSoftClipThreshold) / kneeWidth;
-            sample = sign * (kSoftClipThreshold + (kneeWidth * (1.0f - std::exp(-over))));
-        }
-        buffer[i] = std::clamp(sample, -1.0f, 1.0f);
-    }
+    outputDspChain.resetLookahead();
 }
 
 void AudioEngine::updateVisualizationDataFromOutputCallback(
@@ -725,10 +428,6 @@ void AudioEngine::updateVisualizationDataFromOutputCallback(
         vu[1] = static_cast<float>(std::clamp(std::sqrt(sumSqR * invFrames), 0.0, 1.0));
     }
 
-    bool shouldAnalyzeSpectrum = false;
-    std::array<float, 4096> monoHistorySnapshot {};
-    int monoWriteIndexSnapshot = 0;
-    int sampleRateSnapshot = 48000;
     const int64_t callbackNowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
             std::chrono::steady_clock::now().time_since_epoch()
     ).count();
@@ -770,144 +469,7 @@ void AudioEngine::updateVisualizationDataFromOutputCallback(
         }
         visualizationLastCallbackFrames = numFrames;
         visualizationLastCallbackNs = callbackNowNs;
-
-        if (needsBars) {
-            sampleRateSnapshot = std::max(streamSampleRate, 8000);
-            const int analysisHopFrames = std::clamp(sampleRateSnapshot / 60, 128, 4096);
-            visualizationFramesSinceAnalysis += numFrames;
-            if (visualizationFramesSinceAnalysis >= analysisHopFrames) {
-                visualizationFramesSinceAnalysis %= analysisHopFrames;
-                monoHistorySnapshot = visualizationMonoHistory;
-                monoWriteIndexSnapshot = visualizationMonoWriteIndex;
-                shouldAnalyzeSpectrum = true;
-            }
-        }
     }
-    if (!shouldAnalyzeSpectrum) {
-        return;
-    }
-
-    const auto bars = buildVisualizationBarsFromMonoHistory(
-            monoHistorySnapshot,
-            monoWriteIndexSnapshot,
-            sampleRateSnapshot
-    );
-    std::lock_guard<std::mutex> visLock(visualizationMutex);
-    visualizationBarsPrev = visualizationBars;
-    visualizationBars = bars;
-}
-
-void AudioEngine::updateVisualizationDataLocked(const float* buffer, int numFrames, int channels) {
-    if (!buffer || numFrames <= 0 || channels <= 0) {
-        return;
-    }
-
-    std::array<float, 256> waveL {};
-    std::array<float, 256> waveR {};
-    std::array<float, 256> bars {};
-    std::array<float, 2> vu {};
-
-    for (int n = 0; n < kVisualizationWaveformSize; ++n) {
-        const int srcFrame = (n * numFrames) / kVisualizationWaveformSize;
-        const int frameIndex = std::min(srcFrame, numFrames - 1);
-        const int base = frameIndex * channels;
-        const float left = buffer[base];
-        const float right = channels > 1 ? buffer[base + 1] : left;
-        waveL[n] = std::clamp(left, -1.0f, 1.0f);
-        waveR[n] = std::clamp(right, -1.0f, 1.0f);
-    }
-
-    double sumSqL = 0.0;
-    double sumSqR = 0.0;
-    for (int frame = 0; frame < numFrames; ++frame) {
-        const int base = frame * channels;
-        const float left = buffer[base];
-        const float right = channels > 1 ? buffer[base + 1] : left;
-        const float mono = 0.5f * (left + right);
-        visualizationMonoHistory[visualizationMonoWriteIndex] = mono;
-        visualizationMonoWriteIndex = (visualizationMonoWriteIndex + 1) % static_cast<int>(visualizationMonoHistory.size());
-        sumSqL += static_cast<double>(left) * left;
-        sumSqR += static_cast<double>(right) * right;
-    }
-    const double invFrames = 1.0 / static_cast<double>(numFrames);
-    vu[0] = static_cast<float>(std::clamp(std::sqrt(sumSqL * invFrames), 0.0, 1.0));
-    vu[1] = static_cast<float>(std::clamp(std::sqrt(sumSqR * invFrames), 0.0, 1.0));
-
-    std::array<float, kVisualizationFftSize> fftReal {};
-    std::array<float, kVisualizationFftSize> fftImag {};
-    const int historySize = static_cast<int>(visualizationMonoHistory.size());
-    for (int n = 0; n < kVisualizationFftSize; ++n) {
-        const int historyIndex =
-                (visualizationMonoWriteIndex - kVisualizationFftSize + n + historySize) % historySize;
-        fftReal[n] = visualizationMonoHistory[historyIndex];
-    }
-
-    // Remove DC and apply Hann window before FFT.
-    double mean = 0.0;
-    for (float sample : fftReal) {
-        mean += sample;
-    }
-    mean /= static_cast<double>(kVisualizationFftSize);
-    const float invSizeMinusOne = 1.0f / static_cast<float>(kVisualizationFftSize - 1);
-    for (int n = 0; n < kVisualizationFftSize; ++n) {
-        const float centered = fftReal[n] - static_cast<float>(mean);
-        const float phase = static_cast<float>(n) * invSizeMinusOne;
-        const float hann = 0.5f - (0.5f * std::cos(2.0f * static_cast<float>(M_PI) * phase));
-        fftReal[n] = centered * hann;
-        fftImag[n] = 0.0f;
-    }
-
-    fftInPlace(fftReal, fftImag);
-
-    const int fftHalf = kVisualizationFftSize / 2;
-    const float sampleRate = static_cast<float>(std::max(streamSampleRate, 1));
-    const int minBin = computeVisualizationMinBin(streamSampleRate);
-    const int maxBin = fftHalf - 1;
-    const float minFrequencyHz =
-            (static_cast<float>(minBin) * sampleRate) / static_cast<float>(kVisualizationFftSize);
-    const float maxFrequencyHz =
-            (static_cast<float>(maxBin) * sampleRate) / static_cast<float>(kVisualizationFftSize);
-    const float frequencyRatio = std::max(maxFrequencyHz / std::max(minFrequencyHz, 1.0f), 1.001f);
-    for (int band = 0; band < kVisualizationSpectrumBins; ++band) {
-        const float t0 = static_cast<float>(band) / static_cast<float>(kVisualizationSpectrumBins);
-        const float t1 = static_cast<float>(band + 1) / static_cast<float>(kVisualizationSpectrumBins);
-        const float startFrequencyHz = minFrequencyHz * std::pow(frequencyRatio, t0);
-        const float endFrequencyHz = minFrequencyHz * std::pow(frequencyRatio, t1);
-        const int startBin = static_cast<int>(std::floor(
-                (startFrequencyHz / sampleRate) * static_cast<float>(kVisualizationFftSize)));
-        const int endBin = static_cast<int>(std::ceil(
-                (endFrequencyHz / sampleRate) * static_cast<float>(kVisualizationFftSize))) - 1;
-        const int clampedStart = std::clamp(startBin, minBin, maxBin);
-        const int clampedEnd = std::clamp(std::max(endBin, clampedStart), clampedStart, maxBin);
-
-        double powerSum = 0.0;
-        int count = 0;
-        for (int bin = clampedStart; bin <= clampedEnd; ++bin) {
-            const double re = fftReal[bin];
-            const double im = fftImag[bin];
-            powerSum += (re * re) + (im * im);
-            count += 1;
-        }
-        if (count <= 0) {
-            bars[band] = 0.0f;
-            continue;
-        }
-
-        const double avgPower = powerSum / static_cast<double>(count);
-        const double magnitude = std::sqrt(avgPower) / static_cast<double>(kVisualizationFftSize);
-        const float freqNorm = t0;
-        const float tiltCompensation = computeVisualizationTiltCompensation(freqNorm);
-        const double weighted = magnitude * static_cast<double>(68.0f * tiltCompensation);
-        // Soft knee prevents early saturation while preserving detail.
-        bars[band] = static_cast<float>(std::clamp(weighted / (1.0 + weighted), 0.0, 1.0));
-    }
-
-    std::lock_guard<std::mutex> visLock(visualizationMutex);
-    visualizationWaveformLeft = waveL;
-    visualizationWaveformRight = waveR;
-    visualizationBars = bars;
-    visualizationVuLevels = vu;
-    visualizationChannelCount.store(std::clamp(channels, 1, 2));
 }
 
 void AudioEngine::markVisualizationRequested(uint32_t features) const {
@@ -1088,30 +650,51 @@ std::vector<float> AudioEngine::getVisualizationWaveformScope(
 
 std::vector<float> AudioEngine::getVisualizationBars() const {
     markVisualizationRequested(kVisualizationFeatureBars);
-    std::lock_guard<std::mutex> lock(visualizationMutex);
-    const int callbackFrames = std::max(visualizationLastCallbackFrames, 1);
-    const int sampleRate = std::max(streamSampleRate, 8000);
-    const int64_t callbackNs = visualizationLastCallbackNs;
-    const int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
-            std::chrono::steady_clock::now().time_since_epoch()
-    ).count();
-    const int64_t elapsedNs = std::max<int64_t>(0, nowNs - callbackNs);
-    const double callbackDurationNs =
-            (static_cast<double>(callbackFrames) * 1.0e9) / static_cast<double>(sampleRate);
-    const float alpha = static_cast<float>(
-            std::clamp(
-                    callbackDurationNs > 0.0 ? (static_cast<double>(elapsedNs) / callbackDurationNs) : 1.0,
-                    0.0,
-                    1.0
-            )
-    );
-    std::vector<float> out(visualizationBars.size(), 0.0f);
-    for (size_t i = 0; i < visualizationBars.size(); ++i) {
-        const float prev = visualizationBarsPrev[i];
-        const float curr = visualizationBars[i];
-        out[i] = std::clamp(prev + ((curr - prev) * alpha), 0.0f, 1.0f);
-    }
-    return out;
+    std::array<float, SpectrumAnalyzer::kFftSize> window {};
+    int windowEnd = 0;
+    int writeIndex = 0;
+    int sampleRate = 0;
+    {
+        std::lock_guard<std::mutex> lock(visualizationMutex);
+        constexpr int historySize = static_cast<int>(std::tuple_size_v<decltype(visualizationMonoHistory)>);
+        sampleRate = std::max(streamSampleRate, 8000);
+        writeIndex = visualizationMonoWriteIndex;
+        const int callbackFrames = std::clamp(
+                visualizationLastCallbackFrames,
+                1,
+                historySize - SpectrumAnalyzer::kFftSize
+        );
+        const int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()
+        ).count();
+        const int64_t elapsedNs = std::max<int64_t>(0, nowNs - visualizationLastCallbackNs);
+        const int elapsedFrames = static_cast<int>(std::clamp<int64_t>(
+                (elapsedNs * sampleRate) / 1'000'000'000,
+                0,
+                callbackFrames
+        ));
+        // Same one-chunk latency as the waveform scope: the window end walks
+        // through the last rendered chunk with wall time, so large render
+        // chunks still give a new window on every poll.
+        windowEnd = (writeIndex - callbackFrames + elapsedFrames + historySize) % historySize;
+        std::lock_guard<std::mutex> spectrumLock(visualizationSpectrumMutex);
+        if (windowEnd == visualizationBarsWindowEnd &&
+            writeIndex == visualizationBarsWriteIndex &&
+            sampleRate == visualizationBarsSampleRate) {
+            return { visualizationBars.begin(), visualizationBars.end() };
+        }
+        const int start = (windowEnd - SpectrumAnalyzer::kFftSize + historySize) % historySize;
+        const int firstPart = std::min(SpectrumAnalyzer::kFftSize, historySize - start);
+        std::copy_n(visualizationMonoHistory.begin() + start, firstPart, window.begin());
+        std::copy_n(visualizationMonoHistory.begin(), SpectrumAnalyzer::kFftSize - firstPart, window.begin() + firstPart);
+    }
+
+    std::lock_guard<std::mutex> spectrumLock(visualizationSpectrumMutex);
+    visualizationSpectrum.analyze(window.data(), sampleRate, visualizationBars);
+    visualizationBarsWindowEnd = windowEnd;
+    visualizationBarsWriteIndex = writeIndex;
+    visualizationBarsSampleRate = sampleRate;
+    return { visualizationBars.begin(), visualizationBars.end() };
 }
 
 std::vector<float> AudioEngine::getVisualizationVuLevels() const {
@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 
 bool AudioEngine::consumeNaturalEndEvent() {
     return naturalEndPending.exchange(false);
@@ -149,6 +150,7 @@ bool AudioEngine::selectSubtune(int index) {
     if (!decoder) {
         return false;
     }
+    discardActivePrimedFramesLocked();
     return decoder->selectSubtune(index);
 }
 
@@ -1121,3 +1123,279 @@ int64_t AudioEngine::getUadeSubsongBytes() {
     if (!decoder) return 0;
     return decoder->getCoreInt64Info("subsongBytes", 0);
 }
+
+namespace {
+enum class TrackInfoFieldKind { String, Int, Int64, Float };
+
+struct TrackInfoField {
+    const char* key;
+    TrackInfoFieldKind kind;
+    int fallback;
+    bool live;
+};
+
+struct TrackInfoFieldSet {
+    const char* decoderName;
+    const TrackInfoField* fields;
+    size_t count;
+};
+
+constexpr auto S = TrackInfoFieldKind::String;
+constexpr auto I = TrackInfoFieldKind::Int;
+constexpr auto L = TrackInfoFieldKind::Int64;
+constexpr auto F = TrackInfoFieldKind::Float;
+
+// Mirrors the per-core getters above; defaults match theirs.
+constexpr TrackInfoField kOpenMptFields[] = {
+    { "moduleTypeLong", S, 0, false }, { "tracker", S, 0, false }, { "songMessage", S, 0, false },
+    { "orderCount", I, 0, false }, { "patternCount", I, 0, false }, { "instrumentCount", I, 0, false },
+    { "sampleCount", I, 0, false }, { "instrumentNames", S, 0, false }, { "sampleNames", S, 0, false },
+};
+constexpr TrackInfoField kVgmPlayFields[] = {
+    { "gameName", S, 0, false }, { "systemName", S, 0, false }, { "releaseDate", S, 0, false },
+    { "encodedBy", S, 0, false }, { "notes", S, 0, false }, { "fileVersion", S, 0, false },
+    { "deviceCount", I, 0, false }, { "usedChipList", S, 0, false }, { "hasLoopPoint", I, 0, false },
+};
+constexpr TrackInfoField kFfmpegFields[] = {
+    { "codecName", S, 0, false }, { "containerName", S, 0, false }, { "sampleFormatName", S, 0, false },
+    { "channelLayoutName", S, 0, false }, { "encoderName", S, 0, false },
+    { "readAheadHits", L, -1, true }, { "readAheadMisses", L, -1, true }, { "readAheadStalls", L, -1, true },
+    { "readAheadStallNs", L, -1, true }, { "readAheadFetchedBytes", L, -1, true },
+};
+constexpr TrackInfoField kGmeFields[] = {
+    { "systemName", S, 0, false }, { "gameName", S, 0, false }, { "copyright", S, 0, false },
+    { "comment", S, 0, false }, { "dumper", S, 0, false }, { "trackCount", I, 0, false },
+    { "voiceCount", I, 0, false }, { "hasLoopPoint", I, 0, false }, { "loopStartMs", I, -1, false },
+    { "loopLengthMs", I, -1, false },
+};
+constexpr TrackInfoField kLazyUsf2Fields[] = {
+    { "gameName", S, 0, false }, { "copyright", S, 0, false }, { "year", S, 0, false },
+    { "usfBy", S, 0, false }, { "lengthTag", S, 0, false }, { "fadeTag", S, 0, false },
+    { "enableCompare", I, 0, false }, { "enableFifoFull", I, 0, false },
+};
+constexpr TrackInfoField kVio2sfFields[] = {
+    { "gameName", S, 0, false }, { "copyright", S, 0, false }, { "year", S, 0, false },
+    { "comment", S, 0, false }, { "lengthTag", S, 0, false }, { "fadeTag", S, 0, false },
+};
+constexpr TrackInfoField kSidFields[] = {
+    { "sidFormatName", S, 0, false }, { "sidClockName", S, 0, false }, { "sidSpeedName", S, 0, false },
+    { "sidCompatibilityName", S, 0, false }, { "sidBackendName", S, 0, false }, { "sidChipCount", I, 0, false },
+    { "sidModelSummary", S, 0, false }, { "sidCurrentModelSummary", S, 0, true },
+    { "sidBaseAddressSummary", S, 0, false }, { "sidCommentSummary", S, 0, false },
+};
+constexpr TrackInfoField kSc68Fields[] = {
+    { "formatName", S, 0, false }, { "hardwareName", S, 0, false }, { "platformName", S, 0, false },
+    { "replayName", S, 0, false }, { "replayRateHz", I, 0, false }, { "trackCount", I, 0, false },
+    { "albumName", S, 0, false }, { "year", S, 0, false }, { "ripper", S, 0, false },
+    { "converter", S, 0, false }, { "timer", S, 0, false }, { "canAsid", I, 0, false },
+    { "usesYm", I, 0, false }, { "usesSte", I, 0, false }, { "usesAmiga", I, 0, false },
+};
+constexpr TrackInfoField kAdplugFields[] = {
+    { "description", S, 0, false }, { "patternCount", I, 0, false }, { "currentPattern", I, 0, true },
+    { "orderCount", I, 0, false }, { "currentOrder", I, 0, true }, { "currentRow", I, 0, true },
+    { "currentSpeed", I, 0, true }, { "instrumentCount", I, 0, false }, { "instrumentNames", S, 0, false },
+};
+constexpr TrackInfoField kHivelyFields[] = {
+    { "formatName", S, 0, false }, { "formatVersion", I, 0, false }, { "positionCount", I, 0, false },
+    { "restartPosition", I, -1, false }, { "trackLengthRows", I, 0, false }, { "trackCount", I, 0, false },
+    { "instrumentCount", I, 0, false }, { "speedMultiplier", I, 0, false }, { "currentPosition", I, -1, true },
+    { "currentRow", I, -1, true }, { "currentTempo", I, 0, true }, { "mixGainPercent", I, 0, false },
+    { "instrumentNames", S, 0, false },
+};
+constexpr TrackInfoField kKlystrackFields[] = {
+    { "formatName", S, 0, false }, { "trackCount", I, 0, false }, { "instrumentCount", I, 0, false },
+    { "songLengthRows", I, 0, false }, { "currentRow", I, -1, true }, { "instrumentNames", S, 0, false },
+};
+constexpr TrackInfoField kFurnaceFields[] = {
+    { "formatName", S, 0, false }, { "songVersion", I, 0, false }, { "systemName", S, 0, false },
+    { "systemNames", S, 0, false }, { "systemCount", I, 0, false }, { "songChannelCount", I, 0, false },
+    { "instrumentCount", I, 0, false }, { "wavetableCount", I, 0, false }, { "sampleCount", I, 0, false },
+    { "orderCount", I, 0, false }, { "rowsPerPattern", I, 0, false }, { "currentOrder", I, -1, true },
+    { "currentRow", I, -1, true }, { "currentTick", I, -1, true }, { "currentSpeed", I, 0, true },
+    { "grooveLength", I, 0, true }, { "currentHz", F, 0, true },
+};
+constexpr TrackInfoField kUadeFields[] = {
+    { "formatName", S, 0, false }, { "moduleName", S, 0, false }, { "playerName", S, 0, false },
+    { "moduleFileName", S, 0, false }, { "playerFileName", S, 0, false }, { "moduleMd5", S, 0, false },
+    { "detectionExtension", S, 0, false }, { "detectedFormatName", S, 0, false },
+    { "detectedFormatVersion", S, 0, false }, { "detectionByContent", I, 0, false },
+    { "detectionIsCustom", I, 0, false }, { "subsongMin", I, 0, false }, { "subsongMax", I, 0, false },
+    { "subsongDefault", I, 0, false }, { "currentSubsong", I, 0, true }, { "moduleBytes", L, 0, false },
+    { "songBytes", L, 0, false }, { "subsongBytes", L, 0, false },
+};
+
+template <size_t N>
+constexpr TrackInfoFieldSet fieldSet(const char* decoderName, const TrackInfoField (&fields)[N]) {
+    return { decoderName, fields, N };
+}
+
+constexpr TrackInfoFieldSet kTrackInfoFieldSets[] = {
+    fieldSet("LibOpenMPT", kOpenMptFields),
+    fieldSet("VGMPlay", kVgmPlayFields),
+    fieldSet("FFmpeg", kFfmpegFields),
+    fieldSet("Game Music Emu", kGmeFields),
+    fieldSet("LazyUSF2", kLazyUsf2Fields),
+    fieldSet("Vio2SF", kVio2sfFields),
+    fieldSet("cRSID", kSidFields),
+    fieldSet("LibSIDPlayFP", kSidFields),
+    fieldSet("SC68", kSc68Fields),
+    fieldSet("AdPlug", kAdplugFields),
+    fieldSet("HivelyTracker", kHivelyFields),
+    fieldSet("Klystrack-plus", kKlystrackFields),
+    fieldSet("Furnace", kFurnaceFields),
+    fieldSet("UADE", kUadeFields),
+};
+
+const TrackInfoFieldSet* findTrackInfoFieldSet(const char* decoderName) {
+    for (const TrackInfoFieldSet& set : kTrackInfoFieldSets) {
+        if (std::strcmp(set.decoderName, decoderName) == 0) {
+            return &set;
+        }
+    }
+    return nullptr;
+}
+
+void appendCoreFields(AudioDecoder& decoder, const TrackInfoFieldSet* set, bool live, std::vector<std::string>& out) {
+    if (!set) return;
+    for (size_t i = 0; i < set->count; ++i) {
+        const TrackInfoField& field = set->fields[i];
+        if (field.live != live) continue;
+        out.emplace_back(std::string("core.") + field.key);
+        switch (field.kind) {
+            case TrackInfoFieldKind::String:
+                out.emplace_back(decoder.getCoreStringInfo(field.key));
+                break;
+            case TrackInfoFieldKind::Int:
+                out.emplace_back(std::to_string(decoder.getCoreIntInfo(field.key, field.fallback)));
+                break;
+            case TrackInfoFieldKind::Int64:
+                out.emplace_back(std::to_string(decoder.getCoreInt64Info(field.key, field.fallback)));
+                break;
+            case TrackInfoFieldKind::Float:
+                out.emplace_back(std::to_string(decoder.getCoreFloatInfo(field.key, static_cast<float>(field.fallback))));
+                break;
+        }
+    }
+}
+}
+
+void AudioEngine::invalidateTrackInfoSnapshotLocked() {
+    trackInfoSnapshotValid = false;
+    // Readers fall back to a locked publish until the render worker catches up.
+    std::lock_guard<std::mutex> publishLock(trackInfoPublishMutex);
+    trackInfoPublished.reset();
+}
+
+void AudioEngine::maybePublishTrackInfoLocked(int64_t nowNs) {
+    if (nowNs - trackInfoLastRequestNs.load(std::memory_order_relaxed) > kTrackInfoRequestWindowNs ||
+        nowNs - trackInfoLastPublishNs < kTrackInfoPublishIntervalNs) {
+        return;
+    }
+    publishTrackInfoLocked(nowNs);
+}
+
+void AudioEngine::publishTrackInfoLocked(int64_t nowNs) {
+    trackInfoLastPublishNs = nowNs;
+    std::shared_ptr<const PublishedTrackInfo> previous;
+    {
+        std::lock_guard<std::mutex> publishLock(trackInfoPublishMutex);
+        previous = trackInfoPublished;
+    }
+
+    const TrackInfoFieldSet* fieldSet = decoder ? findTrackInfoFieldSet(decoder->getName()) : nullptr;
+    const int subtuneIndex = decoder ? decoder->getCurrentSubtuneIndex() : -1;
+    std::shared_ptr<const std::vector<std::string>> staticFields = previous ? previous->staticFields : nullptr;
+    if (!trackInfoSnapshotValid || subtuneIndex != trackInfoSnapshotSubtune || !staticFields) {
+        auto fields = std::make_shared<std::vector<std::string>>();
+        if (decoder) {
+            const std::pair<const char*, std::string> tags[] = {
+                { "composer", decoder->getComposer() },
+                { "genre", decoder->getGenre() },
+                { "album", decoder->getAlbum() },
+                { "year", decoder->getYear() },
+                { "date", decoder->getDate() },
+                { "copyright", decoder->getCopyright() },
+                { "comment", decoder->getComment() },
+            };
+            for (const auto& [key, value] : tags) {
+                fields->emplace_back(key);
+                fields->push_back(value);
+            }
+            appendCoreFields(*decoder, fieldSet, false, *fields);
+        }
+        staticFields = std::move(fields);
+        trackInfoSnapshotValid = true;
+        trackInfoSnapshotSubtune = subtuneIndex;
+        trackInfoSnapshotVersion++;
+    }
+
+    std::vector<std::string> liveFields;
+    liveFields.reserve(24);
+    const std::pair<const char*, std::string> engineFields[] = {
+        { "bitrate", std::to_string(decoder ? decoder->getCoreIntInfo("bitrate", 0) : 0) },
+        { "isVbr", std::to_string(decoder ? decoder->getCoreIntInfo("isVbr", 0) : 0) },
+        { "audioBackend", getAudioBackendLabel() },
+        { "renderRateHz", std::to_string(decoderRenderSampleRate) },
+        { "outputRateHz", std::to_string(streamSampleRate) },
+    };
+    for (const auto& [key, value] : engineFields) {
+        liveFields.emplace_back(key);
+        liveFields.push_back(value);
+    }
+    if (decoder) {
+        appendCoreFields(*decoder, fieldSet, true, liveFields);
+    }
+
+    const bool staticChanged = !previous || previous->staticVersion != trackInfoSnapshotVersion;
+    if (!staticChanged && previous->liveFields == liveFields) {
+        // Same content: keep the version so idle polls stay one-element arrays,
+        // only refresh the time stamp readers use to detect a stalled worker.
+        auto refreshed = std::make_shared<PublishedTrackInfo>(*previous);
+        refreshed->publishedNs = nowNs;
+        std::lock_guard<std::mutex> publishLock(trackInfoPublishMutex);
+        trackInfoPublished = std::move(refreshed);
+        return;
+    }
+    auto published = std::make_shared<PublishedTrackInfo>();
+    published->staticVersion = trackInfoSnapshotVersion;
+    published->liveVersion = ++trackInfoLiveVersion;
+    published->publishedNs = nowNs;
+    published->staticFields = std::move(staticFields);
+    published->liveFields = std::move(liveFields);
+    std::lock_guard<std::mutex> publishLock(trackInfoPublishMutex);
+    trackInfoPublished = std::move(published);
+}
+
+std::vector<std::string> AudioEngine::getTrackInfoSnapshot(uint64_t knownVersion) {
+    const int64_t nowNs = RenderProfiler::nowNs();
+    trackInfoLastRequestNs.store(nowNs, std::memory_order_relaxed);
+    std::shared_ptr<const PublishedTrackInfo> published;
+    {
+        std::lock_guard<std::mutex> publishLock(trackInfoPublishMutex);
+        published = trackInfoPublished;
+    }
+    // Nothing published yet, or the render worker is idle (paused, stopped,
+    // seeking): build it here once instead.
+    if (!published || nowNs - published->publishedNs > kTrackInfoStaleNs) {
+        std::lock_guard<std::mutex> lock(decoderMutex);
+        publishTrackInfoLocked(nowNs);
+        std::lock_guard<std::mutex> publishLock(trackInfoPublishMutex);
+        published = trackInfoPublished;
+    }
+
+    const uint64_t version = (published->staticVersion << 32) | (published->liveVersion & 0xffffffffull);
+    std::vector<std::string> result;
+    result.emplace_back(std::to_string(version));
+    if (knownVersion == version) {
+        return result;
+    }
+    const bool sendStatic = (knownVersion >> 32) != published->staticVersion;
+    const std::vector<std::string>& staticFields = *published->staticFields;
+    result.reserve(2 + (sendStatic ? staticFields.size() : 0) + published->liveFields.size());
+    result.emplace_back(std::to_string(sendStatic ? staticFields.size() / 2 : 0));
+    if (sendStatic) {
+        result.insert(result.end(), staticFields.begin(), staticFields.end());
+    }
+    result.insert(result.end(), published->liveFields.begin(), published->liveFields.end());
+    return result;
+}
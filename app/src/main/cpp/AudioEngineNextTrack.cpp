@@ -0,0 +1,359 @@
+#include "AudioEngine.h"
+#include "decoders/DecoderPluginLoader.h"
+#include "decoders/DecoderRegistry.h"
+
+#include <android/log.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <pthread.h>
+
+#define LOG_TAG "AudioEngine"
+#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace {
+    constexpr int kNextTrackPrimeMs = 300;
+    constexpr int kNextTrackPrimeChunkFrames = 1024;
+    // Retired decoders the render worker can queue without allocating.
+    constexpr size_t kRetiredDecoderSlots = 4;
+
+    double elapsedMs(std::chrono::steady_clock::time_point since) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+    }
+}
+
+void AudioEngine::setNextUrl(const char* url) {
+    if (url == nullptr || url[0] == '\0') {
+        clearNextUrl();
+        return;
+    }
+    PreparedNextTrack stale;
+    {
+        std::lock_guard<std::mutex> lock(preloadMutex);
+        if (preparedNextTrack.decoder && preparedNextTrack.url == url) {
+            return;
+        }
+        if (preloadRequestPending && preloadRequestUrl == url) {
+            return;
+        }
+        stale = std::move(preparedNextTrack);
+        preparedNextTrack = PreparedNextTrack {};
+        preloadGeneration++;
+        preloadRequestUrl = url;
+        preloadRequestPending = true;
+        nextTrackPreloadState.store(kNextTrackPreloadLoading, std::memory_order_relaxed);
+    }
+    preloadCv.notify_one();
+    // stale (if any) is destroyed here, outside the lock.
+}
+
+void AudioEngine::clearNextUrl() {
+    PreparedNextTrack stale;
+    {
+        std::lock_guard<std::mutex> lock(preloadMutex);
+        stale = std::move(preparedNextTrack);
+        preparedNextTrack = PreparedNextTrack {};
+        preloadGeneration++;
+        preloadRequestUrl.clear();
+        preloadRequestPending = false;
+        nextTrackPreloadState.store(kNextTrackPreloadIdle, std::memory_order_relaxed);
+    }
+}
+
+bool AudioEngine::consumeGaplessTransitionEvent() {
+    return gaplessTransitionPending.exchange(false);
+}
+
+std::vector<double> AudioEngine::getNextTrackPreloadStats() {
+    return {
+            static_cast<double>(nextTrackPreloadState.load(std::memory_order_relaxed)),
+            nextTrackCreateMs.load(std::memory_order_relaxed),
+            nextTrackOpenMs.load(std::memory_order_relaxed),
+            nextTrackPrimeMs.load(std::memory_order_relaxed),
+            nextTrackPrimedMs.load(std::memory_order_relaxed)
+    };
+}
+
+bool AudioEngine::takePreparedNextTrack(const char* url, PreparedNextTrack& out) {
+    PreparedNextTrack stale;
+    bool matched = false;
+    {
+        std::lock_guard<std::mutex> lock(preloadMutex);
+        if (preparedNextTrack.decoder && url != nullptr && preparedNextTrack.url == url) {
+            out = std::move(preparedNextTrack);
+            matched = true;
+        } else {
+            stale = std::move(preparedNextTrack);
+        }
+        preparedNextTrack = PreparedNextTrack {};
+        preloadGeneration++;
+        preloadRequestUrl.clear();
+        preloadRequestPending = false;
+        nextTrackPreloadState.store(kNextTrackPreloadIdle, std::memory_order_relaxed);
+    }
+    return matched;
+}
+
+void AudioEngine::requeueNextTrackPreloadForCore(const std::string& coreName) {
+    PreparedNextTrack stale;
+    {
+        std::lock_guard<std::mutex> lock(preloadMutex);
+        if (!preparedNextTrack.decoder || coreName != preparedNextTrack.decoder->getName()) {
+            return;
+        }
+        preloadRequestUrl = preparedNextTrack.url;
+        stale = std::move(preparedNextTrack);
+        preparedNextTrack = PreparedNextTrack {};
+        preloadGeneration++;
+        preloadRequestPending = true;
+        nextTrackPreloadState.store(kNextTrackPreloadLoading, std::memory_order_relaxed);
+    }
+    preloadCv.notify_one();
+}
+
+int AudioEngine::readPrimedFramesLocked(float* buffer, int numFrames, int channels) {
+    if (activePrimedSamples.empty() || channels != activePrimedChannels) {
+        return 0;
+    }
+    const size_t availableFrames = (activePrimedSamples.size() - activePrimedOffset) / static_cast<size_t>(channels);
+    const size_t frames = std::min(availableFrames, static_cast<size_t>(numFrames));
+    std::memcpy(
+            buffer,
+            activePrimedSamples.data() + activePrimedOffset,
+            frames * static_cast<size_t>(channels) * sizeof(float)
+    );
+    activePrimedOffset += frames * static_cast<size_t>(channels);
+    if (activePrimedOffset >= activePrimedSamples.size()) {
+        discardActivePrimedFramesLocked();
+    }
+    return static_cast<int>(frames);
+}
+
+void AudioEngine::discardActivePrimedFramesLocked() {
+    activePrimedSamples.clear();
+    activePrimedOffset = 0;
+    activePrimedChannels = 0;
+}
+
+bool AudioEngine::promotePreparedNextTrackLocked(bool requireMatchingFormat) {
+    if (repeatMode.load() != 0) {
+        return false;
+    }
+    // Never block the render worker on the preload worker.
+    std::unique_lock<std::mutex> preloadLock(preloadMutex, std::try_to_lock);
+    if (!preloadLock.owns_lock() || !preparedNextTrack.decoder) {
+        return false;
+    }
+    const int channels = std::clamp(decoder ? decoder->getChannelCount() : 2, 1, 2);
+    if (requireMatchingFormat &&
+        (preparedNextTrack.sampleRate != decoderRenderSampleRate ||
+         preparedNextTrack.primedChannels != channels)) {
+        return false;
+    }
+
+    PreparedNextTrack next = std::move(preparedNextTrack);
+    preparedNextTrack = PreparedNextTrack {};
+    preloadGeneration++;
+    nextTrackPreloadState.store(kNextTrackPreloadIdle, std::memory_order_relaxed);
+    // Plugin unload, file close and emulator teardown of the outgoing decoder
+    // run on the preload worker.
+    retiredDecoders.push_back(std::move(decoder));
+    preloadLock.unlock();
+    preloadCv.notify_one();
+
+    decoder = std::move(next.decoder);
+    DecoderPluginLoader::getInstance().notePlayback(*decoder);
+    decoderSerial.fetch_add(1);
+    decoderKeyframeIndex.invalidate();
+    invalidateTrackInfoSnapshotLocked();
+    decoder->setRepeatMode(repeatMode.load());
+    activePrimedSamples = std::move(next.primedSamples);
+    activePrimedOffset = 0;
+    activePrimedChannels = next.primedChannels;
+    cachedDurationSeconds.store(decoder->getDuration());
+    if (!requireMatchingFormat) {
+        decoderRenderSampleRate = decoder->getSampleRate();
+        resetResamplerStateLocked();
+    }
+    const double consumedSeconds = decoderRenderSampleRate > 0
+            ? static_cast<double>(sharedAbsoluteInputPosition) / decoderRenderSampleRate
+            : 0.0;
+    positionSeconds.store(0.0);
+    sharedAbsoluteInputPositionBaseSeconds = -consumedSeconds;
+    outputClockSeconds = 0.0;
+    timelineSmoothedSeconds = 0.0;
+    timelineSmootherInitialized = false;
+    naturalEndPending.store(false);
+    gaplessTransitionPending.store(true);
+    LOGD(
+            "Gapless transition to %s (%s, inline=%d)",
+            next.url.c_str(),
+            decoder->getName(),
+            requireMatchingFormat ? 1 : 0
+    );
+    return true;
+}
+
+void AudioEngine::preloadWorkerLoop() {
+    pthread_setname_np(pthread_self(), "sp_preload");
+
+    {
+        std::lock_guard<std::mutex> lock(preloadMutex);
+        retiredDecoders.reserve(kRetiredDecoderSlots);
+    }
+    for (;;) {
+        std::string url;
+        uint64_t generation = 0;
+        std::vector<std::unique_ptr<AudioDecoder>> retired;
+        {
+            std::unique_lock<std::mutex> lock(preloadMutex);
+            preloadCv.wait(lock, [this]() {
+                return preloadWorkerStop || preloadRequestPending || !retiredDecoders.empty();
+            });
+            if (!retiredDecoders.empty()) {
+                // The swap leaves reserved capacity on the render worker's side.
+                retired.reserve(kRetiredDecoderSlots);
+                retired.swap(retiredDecoders);
+            } else if (preloadWorkerStop) {
+                break;
+            } else {
+                url = preloadRequestUrl;
+                generation = preloadGeneration;
+                preloadRequestPending = false;
+            }
+        }
+        if (!retired.empty()) {
+            const auto retireStart = std::chrono::steady_clock::now();
+            retired.clear();
+            LOGD("Retired outgoing gapless decoder in %.1fms", elapsedMs(retireStart));
+            continue;
+        }
+
+        const auto createStart = std::chrono::steady_clock::now();
+        DecoderRegistry& registry = DecoderRegistry::getInstance();
+        const std::string coreName = registry.resolveDecoderName(url.c_str());
+        DecoderStaticInfo staticInfo;
+        const bool singleInstance =
+                !coreName.empty() &&
+                registry.getDecoderStaticInfo(coreName, staticInfo) &&
+                staticInfo.hasPlaybackCapabilities &&
+                (staticInfo.playbackCapabilities & AudioDecoder::PLAYBACK_CAP_SINGLE_INSTANCE) != 0;
+
+        if (coreName.empty() || singleInstance) {
+            // Cores backed by one global emulator cannot be opened next to the
+            // playing track; setUrl() takes the regular path for those.
+            LOGD("Next-track preload skipped for %s (core=%s)", url.c_str(), coreName.empty() ? "none" : coreName.c_str());
+            std::lock_guard<std::mutex> lock(preloadMutex);
+            if (generation == preloadGeneration) {
+                nextTrackPreloadState.store(kNextTrackPreloadSkipped, std::memory_order_relaxed);
+            }
+            continue;
+        }
+
+        int targetRate = 0;
+        std::unordered_map<std::string, std::string> optionsForDecoder;
+        {
+            std::lock_guard<std::mutex> lock(decoderMutex);
+            targetRate = resolveOutputSampleRateForCore(coreName);
+            const auto optionsIt = coreOptions.find(coreName);
+            if (optionsIt != coreOptions.end()) {
+                optionsForDecoder = optionsIt->second;
+            }
+        }
+
+        auto nextDecoder = registry.createDecoder(url.c_str());
+        const double createMs = elapsedMs(createStart);
+        if (!nextDecoder) {
+            LOGE("Next-track preload: no decoder for %s", url.c_str());
+            std::lock_guard<std::mutex> lock(preloadMutex);
+            if (generation == preloadGeneration) {
+                nextTrackPreloadState.store(kNextTrackPreloadFailed, std::memory_order_relaxed);
+            }
+            continue;
+        }
+
+        const auto openStart = std::chrono::steady_clock::now();
+        nextDecoder->setOutputSampleRate(targetRate);
+        for (const auto& [name, value] : optionsForDecoder) {
+            nextDecoder->setOption(name.c_str(), value.c_str());
+        }
+        const bool opened = nextDecoder->open(url.c_str());
+        if (opened) {
+            nextDecoder->setRepeatMode(0);
+            for (const auto& [name, value] : optionsForDecoder) {
+                nextDecoder->setOption(name.c_str(), value.c_str());
+            }
+        }
+        const double openMs = elapsedMs(openStart);
+        if (!opened) {
+            LOGE("Next-track preload: failed to open %s", url.c_str());
+            std::lock_guard<std::mutex> lock(preloadMutex);
+            if (generation == preloadGeneration) {
+                nextTrackPreloadState.store(kNextTrackPreloadFailed, std::memory_order_relaxed);
+            }
+            continue;
+        }
+
+        // Render the first few hundred milliseconds now so the switch does not
+        // wait for emulator boot/warm-up on the render worker.
+        const auto primeStart = std::chrono::steady_clock::now();
+        PreparedNextTrack prepared;
+        prepared.url = url;
+        prepared.sampleRate = nextDecoder->getSampleRate();
+        prepared.primedChannels = std::clamp(nextDecoder->getChannelCount(), 1, 2);
+        const int sampleRate = prepared.sampleRate > 0 ? prepared.sampleRate : 48000;
+        const int primeFrames = (sampleRate * kNextTrackPrimeMs) / 1000;
+        prepared.primedSamples.resize(static_cast<size_t>(primeFrames) * prepared.primedChannels);
+        int primedFrames = 0;
+        while (primedFrames < primeFrames) {
+            {
+                std::lock_guard<std::mutex> lock(preloadMutex);
+                if (generation != preloadGeneration || preloadWorkerStop) {
+                    break;
+                }
+            }
+            const int framesToRead = std::min(kNextTrackPrimeChunkFrames, primeFrames - primedFrames);
+            const int framesRead = nextDecoder->read(
+                    prepared.primedSamples.data() + static_cast<size_t>(primedFrames) * prepared.primedChannels,
+                    framesToRead
+            );
+            if (framesRead <= 0) {
+                break;
+            }
+            primedFrames += framesRead;
+        }
+        prepared.primedSamples.resize(static_cast<size_t>(primedFrames) * prepared.primedChannels);
+        const double primeMs = elapsedMs(primeStart);
+        prepared.decoder = std::move(nextDecoder);
+
+        LOGD(
+                "Next-track preload ready: %s core=%s create=%.1fms open=%.1fms prime=%.1fms primed=%dms",
+                url.c_str(),
+                prepared.decoder->getName(),
+                createMs,
+                openMs,
+                primeMs,
+                (primedFrames * 1000) / sampleRate
+        );
+
+        PreparedNextTrack stale;
+        {
+            std::lock_guard<std::mutex> lock(preloadMutex);
+            if (generation == preloadGeneration && !preloadWorkerStop) {
+                stale = std::move(preparedNextTrack);
+                preparedNextTrack = std::move(prepared);
+                nextTrackCreateMs.store(createMs, std::memory_order_relaxed);
+                nextTrackOpenMs.store(openMs, std::memory_order_relaxed);
+                nextTrackPrimeMs.store(primeMs, std::memory_order_relaxed);
+                nextTrackPrimedMs.store(
+                        static_cast<double>(primedFrames) * 1000.0 / sampleRate,
+                        std::memory_order_relaxed
+                );
+                nextTrackPreloadState.store(kNextTrackPreloadReady, std::memory_order_relaxed);
+            } else {
+                stale = std::move(prepared);
+            }
+        }
+    }
+}
@@ -1,13 +1,18 @@
 #include "AudioEngine.h"
 
 #include <android/log.h>
+#include <cstdio>
 
 #define LOG_TAG "AudioEngine"
 #define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
 
 namespace {
     const char* outputResamplerName(int preference) {
-        return preference == 2 ? "SoX" : "Built-in";
+        switch (preference) {
+            case 2: return "SoX";
+            case 3: return "Polyphase sinc";
+            default: return "Built-in";
+        }
     }
 
     constexpr int kRenderChunkFramesVerySmall = 256;
@@ -20,6 +25,13 @@ namespace {
     constexpr int kRenderTargetFramesMedium = 8192;
     constexpr int kRenderTargetFramesLarge = 16384;
     constexpr int kRenderTargetFramesVeryLarge = 32768;
+    // Adaptive sizing may move the target within [preset / 2, preset * 4].
+    constexpr int kRenderAdaptiveMaxChunkFrames = 1024;
+    constexpr int kRenderAdaptiveMaxTargetFrames = 65536;
+
+    int latencyMsToFrames(int latencyMs, int sampleRate) {
+        return static_cast<int>(static_cast<int64_t>(latencyMs) * sampleRate / 1000);
+    }
 }
 
 void AudioEngine::setAudioPipelineConfig(
@@ -31,7 +43,7 @@ void AudioEngine::setAudioPipelineConfig(
     const int normalizedBackend = (backendPreference >= 0 && backendPreference <= 3) ? backendPreference : 0;
     const int normalizedPerformance = (performanceMode >= 0 && performanceMode <= 3) ? performanceMode : 1;
     const int normalizedBufferPreset = (bufferPreset >= 0 && bufferPreset <= 4) ? bufferPreset : 3;
-    const int normalizedResampler = (resamplerPreference >= 1 && resamplerPreference <= 2) ? resamplerPreference : 1;
+    const int normalizedResampler = (resamplerPreference >= 1 && resamplerPreference <= 3) ? resamplerPreference : 1;
 
     const bool changed =
             outputBackendPreference != normalizedBackend ||
@@ -98,12 +110,66 @@ void AudioEngine::updateRenderQueueTuning() {
     if (targetFrames < chunkFrames * 2) {
         targetFrames = chunkFrames * 2;
     }
+
+    RenderQueueController::Bounds bounds;
+    bounds.baseChunkFrames = chunkFrames;
+    bounds.baseTargetFrames = targetFrames;
+    if (renderQueueAdaptive.load(std::memory_order_relaxed)) {
+        const int sampleRate = streamSampleRate > 0 ? streamSampleRate : 48000;
+        const int minLatencyMs = renderQueueMinLatencyMs.load(std::memory_order_relaxed);
+        const int maxLatencyMs = renderQueueMaxLatencyMs.load(std::memory_order_relaxed);
+        bounds.minTargetFrames = minLatencyMs > 0
+                ? latencyMsToFrames(minLatencyMs, sampleRate)
+                : std::max(chunkFrames * 2, targetFrames / 2);
+        bounds.maxTargetFrames = maxLatencyMs > 0
+                ? latencyMsToFrames(maxLatencyMs, sampleRate)
+                : std::min(targetFrames * 4, kRenderAdaptiveMaxTargetFrames);
+        bounds.maxChunkFrames = std::max(chunkFrames, kRenderAdaptiveMaxChunkFrames);
+    } else {
+        bounds.minTargetFrames = targetFrames;
+        bounds.maxTargetFrames = targetFrames;
+        bounds.maxChunkFrames = chunkFrames;
+    }
+    renderQueueController.configure(bounds);
+    chunkFrames = renderQueueController.chunkFrames();
+    targetFrames = renderQueueController.targetFrames();
+
     renderWorkerChunkFrames.store(chunkFrames, std::memory_order_relaxed);
     renderWorkerTargetFrames.store(targetFrames, std::memory_order_relaxed);
-    {
-        std::lock_guard<std::mutex> lock(renderQueueMutex);
-        const int capacityFrames = std::max(targetFrames * 6, 16384);
-        ensureRenderQueueCapacityLocked(static_cast<size_t>(capacityFrames) * 2u);
-    }
-    LOGD("Render queue tuning: preset=%d chunk=%d target=%d", outputBufferPreset, chunkFrames, targetFrames);
+    const int capacityFrames = std::max(targetFrames * 6, 16384);
+    ensureRenderQueueCapacity(static_cast<size_t>(capacityFrames) * 2u);
+    LOGD(
+            "Render queue tuning: preset=%d chunk=%d target=%d adaptive=%d bounds=[%d,%d]",
+            outputBufferPreset,
+            chunkFrames,
+            targetFrames,
+            renderQueueAdaptive.load(std::memory_order_relaxed) ? 1 : 0,
+            bounds.minTargetFrames,
+            bounds.maxTargetFrames
+    );
+}
+
+void AudioEngine::setRenderQueueAdaptation(bool enabled, int minLatencyMs, int maxLatencyMs) {
+    renderQueueAdaptive.store(enabled, std::memory_order_relaxed);
+    renderQueueMinLatencyMs.store(std::max(0, minLatencyMs), std::memory_order_relaxed);
+    renderQueueMaxLatencyMs.store(std::max(0, maxLatencyMs), std::memory_order_relaxed);
+    updateRenderQueueTuning();
+    renderWorkerCv.notify_all();
+}
+
+std::string AudioEngine::getRenderQueueTuningSummary() const {
+    const uint64_t callbacks = renderQueueCallbackCount.load(std::memory_order_relaxed);
+    const uint64_t queueNs = renderQueueCallbackQueueNs.load(std::memory_order_relaxed);
+    char line[224];
+    std::snprintf(
+            line,
+            sizeof(line),
+            "callbacks=%llu queueOpsAvg=%lluns queueOpsMax=%lldns underruns=%llu missingFrames=%llu\n",
+            static_cast<unsigned long long>(callbacks),
+            static_cast<unsigned long long>(callbacks > 0 ? queueNs / callbacks : 0),
+            static_cast<long long>(renderQueueCallbackQueueMaxNs.load(std::memory_order_relaxed)),
+            static_cast<unsigned long long>(renderQueueUnderrunCount.load(std::memory_order_relaxed)),
+            static_cast<unsigned long long>(renderQueueUnderrunFrames.load(std::memory_order_relaxed))
+    );
+    return line + renderProfiler.decoderSummary() + renderQueueController.summary();
 }
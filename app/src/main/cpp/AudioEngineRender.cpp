@@ -60,7 +60,11 @@ namespace {
     }
 
     const char* outputResamplerName(int preference) {
-        return preference == 2 ? "SoX" : "Built-in";
+        switch (preference) {
+            case 2: return "SoX";
+            case 3: return "Polyphase sinc";
+            default: return "Built-in";
+        }
     }
 }
 
@@ -87,6 +91,8 @@ void AudioEngine::resetResamplerStateLocked(bool preserveBuffer) {
     pendingBackwardTimelineConfirmations = 0;
     resamplerPathLoggedForCurrentTrack = false;
     resamplerNoOpLoggedForCurrentTrack = false;
+    outputSincResampler.reset();
+    outputSincFlushed = false;
     if (outputSoxrContext != nullptr) {
         swr_close(outputSoxrContext);
         swr_init(outputSoxrContext);
@@ -166,12 +172,33 @@ bool AudioEngine::ensureOutputSoxrContextLocked(int channels, int inputRate, int
     return true;
 }
 
+int AudioEngine::readDecoderTimedLocked(float* buffer, int numFrames) {
+    const int64_t startNs = RenderProfiler::nowNs();
+    const int framesRead = decoder->read(buffer, numFrames);
+    renderChunkDecodeNs += RenderProfiler::nowNs() - startNs;
+    renderChunkDecodedFrames += std::max(0, framesRead);
+    return framesRead;
+}
+
 int AudioEngine::readFromDecoderLocked(float* buffer, int numFrames, int channels, bool& reachedEnd) {
     if (!decoder || !buffer || numFrames <= 0 || channels <= 0) return 0;
 
     const int mode = repeatMode.load();
 
-    int framesRead = decoder->read(buffer, numFrames);
+    const int primedFrames = readPrimedFramesLocked(buffer, numFrames, channels);
+    if (primedFrames > 0) {
+        if (primedFrames == numFrames) {
+            return primedFrames;
+        }
+        return primedFrames + readFromDecoderLocked(
+                buffer + static_cast<size_t>(primedFrames) * channels,
+                numFrames - primedFrames,
+                channels,
+                reachedEnd
+        );
+    }
+
+    int framesRead = readDecoderTimedLocked(buffer, numFrames);
     if (framesRead > 0) {
         if (mode == 2 && framesRead < numFrames) {
             // Keep filling in loop-point mode to avoid inserting silence when a
@@ -181,7 +208,7 @@ int AudioEngine::readFromDecoderLocked(float* buffer, int numFrames, int channel
             for (int round = 0; round < kMaxTopUpRounds && total < numFrames; ++round) {
                 float* writePtr = buffer + static_cast<size_t>(total) * channels;
                 const int remaining = numFrames - total;
-                int more = decoder->read(writePtr, remaining);
+                int more = readDecoderTimedLocked(writePtr, remaining);
                 if (more > 0) {
                     total += more;
                     continue;
@@ -189,7 +216,7 @@ int AudioEngine::readFromDecoderLocked(float* buffer, int numFrames, int channel
 
                 bool recovered = false;
                 for (int retry = 0; retry < 8; ++retry) {
-                    more = decoder->read(writePtr, remaining);
+                    more = readDecoderTimedLocked(writePtr, remaining);
                     if (more > 0) {
                         total += more;
                         recovered = true;
@@ -202,13 +229,29 @@ int AudioEngine::readFromDecoderLocked(float* buffer, int numFrames, int channel
             }
             return total;
         }
+        if (mode == 0 &&
+            framesRead < numFrames &&
+            nextTrackPreloadState.load(std::memory_order_relaxed) == kNextTrackPreloadReady) {
+            // Keep filling this chunk: from the same decoder if it has more, or
+            // from the next track at end so the switch is sample-contiguous.
+            return framesRead + readFromDecoderLocked(
+                    buffer + static_cast<size_t>(framesRead) * channels,
+                    numFrames - framesRead,
+                    channels,
+                    reachedEnd
+            );
+        }
         return framesRead;
     }
 
+    if (mode == 0 && promotePreparedNextTrackLocked(true)) {
+        return readFromDecoderLocked(buffer, numFrames, channels, reachedEnd);
+    }
+
     if (mode == 2) {
         // Loop-point mode can return transient 0-frame reads at wrap boundaries.
         for (int retry = 0; retry < 32; ++retry) {
-            framesRead = decoder->read(buffer, numFrames);
+            framesRead = readDecoderTimedLocked(buffer, numFrames);
             if (framesRead > 0) {
                 return framesRead;
             }
@@ -224,7 +267,7 @@ int AudioEngine::readFromDecoderLocked(float* buffer, int numFrames, int channel
         outputClockSeconds = 0.0;
         timelineSmoothedSeconds = 0.0;
         timelineSmootherInitialized = false;
-        framesRead = decoder->read(buffer, numFrames);
+        framesRead = readDecoderTimedLocked(buffer, numFrames);
         if (framesRead > 0) {
             return framesRead;
         }
@@ -253,7 +296,7 @@ int AudioEngine::readFromDecoderLocked(float* buffer, int numFrames, int channel
             outputClockSeconds = 0.0;
             timelineSmoothedSeconds = 0.0;
             timelineSmootherInitialized = false;
-            framesRead = decoder->read(buffer, numFrames);
+            framesRead = readDecoderTimedLocked(buffer, numFrames);
             if (framesRead > 0) {
                 return framesRead;
             }
@@ -265,7 +308,7 @@ int AudioEngine::readFromDecoderLocked(float* buffer, int numFrames, int channel
             outputClockSeconds = 0.0;
             timelineSmoothedSeconds = 0.0;
             timelineSmootherInitialized = false;
-            framesRead = decoder->read(buffer, numFrames);
+            framesRead = readDecoderTimedLocked(buffer, numFrames);
             if (framesRead > 0) {
                 return framesRead;
             }
@@ -317,6 +360,22 @@ void AudioEngine::renderResampledLocked(
     const bool decoderHasDiscontinuousTimeline =
             decoder->getTimelineMode() == AudioDecoder::TimelineMode::Discontinuous;
     const bool allowSoxForCurrentDecoder = !decoderHasDiscontinuousTimeline;
+    // The sinc resampler consumes input strictly in order with a fixed delay,
+    // so unlike SoX it stays usable for discontinuous-timeline decoders.
+    if (outputResamplerPreference == 3 && outputSincResampler.configure(channels, renderRate, streamRate)) {
+        if (!resamplerPathLoggedForCurrentTrack) {
+            LOGD(
+                    "Resampler path selected: Polyphase sinc (decoderRate=%d -> streamRate=%d, decoder=%s, taps=%d)",
+                    renderRate,
+                    streamRate,
+                    decoder ? decoder->getName() : "none",
+                    outputSincResampler.tapCount()
+            );
+            resamplerPathLoggedForCurrentTrack = true;
+        }
+        renderSincResampledLocked(outputData, numFrames, channels, reachedEnd);
+        return;
+    }
     if (outputResamplerPreference == 2 && !outputSoxrUnavailable && allowSoxForCurrentDecoder) {
         if (!resamplerPathLoggedForCurrentTrack) {
             LOGD(
@@ -535,129 +594,96 @@ void AudioEngine::renderSoxrResampledLocked(
     }
 }
 
-void AudioEngine::clearRenderQueue() {
-    std::lock_guard<std::mutex> lock(renderQueueMutex);
-    renderQueueReadIndex = 0;
-    renderQueueWriteIndex = 0;
-    renderQueueSampleCount = 0;
-    renderTerminalStopPending.store(false);
-}
-
-void AudioEngine::ensureRenderQueueCapacityLocked(size_t minSampleCapacity) {
-    minSampleCapacity = std::max<size_t>(minSampleCapacity, 4096u);
-    if (renderQueueRing.size() >= minSampleCapacity) {
-        return;
+void AudioEngine::renderSincResampledLocked(
+        float* outputData,
+        int32_t numFrames,
+        int channels,
+        bool& reachedEnd) {
+    constexpr int decodeChunkFrames = 1024;
+    const size_t neededScratchSize = static_cast<size_t>(decodeChunkFrames) * channels;
+    if (resampleDecodeScratch.size() < neededScratchSize) {
+        resampleDecodeScratch.resize(neededScratchSize);
     }
 
-    size_t newCapacity = renderQueueRing.empty() ? 4096u : renderQueueRing.size();
-    while (newCapacity < minSampleCapacity) {
-        newCapacity *= 2u;
+    int outFrame = 0;
+    while (outFrame < numFrames) {
+        outFrame += outputSincResampler.render(
+                outputData + static_cast<size_t>(outFrame) * channels,
+                numFrames - outFrame
+        );
+        if (outFrame >= numFrames) break;
+
+        const int request = std::min(decodeChunkFrames, outputSincResampler.writableInputFrames());
+        if (request <= 0) break;
+        const int decoded = readFromDecoderLocked(resampleDecodeScratch.data(), request, channels, reachedEnd);
+        if (decoded > 0) {
+            sharedAbsoluteInputPosition += decoded;
+            outputSincResampler.pushInput(resampleDecodeScratch.data(), decoded);
+            outputSincFlushed = false;
+            continue;
+        }
+        // Feed half a filter of silence once so the last real frames come out.
+        if (reachedEnd && !outputSincFlushed) {
+            outputSincResampler.pushSilence(outputSincResampler.flushInputFrames());
+            outputSincFlushed = true;
+            continue;
+        }
+        break;
     }
 
-    std::vector<float> resizedRing(newCapacity, 0.0f);
-    if (renderQueueSampleCount > 0 && !renderQueueRing.empty()) {
-        const size_t firstChunk = std::min(
-                renderQueueSampleCount,
-                renderQueueRing.size() - renderQueueReadIndex
-        );
-        std::memcpy(
-                resizedRing.data(),
-                renderQueueRing.data() + renderQueueReadIndex,
-                firstChunk * sizeof(float)
+    if (outFrame < numFrames) {
+        memset(
+                outputData + (static_cast<size_t>(outFrame) * channels),
+                0,
+                (numFrames - outFrame) * channels * sizeof(float)
         );
-        if (renderQueueSampleCount > firstChunk) {
-            std::memcpy(
-                    resizedRing.data() + firstChunk,
-                    renderQueueRing.data(),
-                    (renderQueueSampleCount - firstChunk) * sizeof(float)
-            );
-        }
     }
+}
+
+void AudioEngine::clearRenderQueue() {
+    renderQueueRing.clear();
+    renderTerminalStopPending.store(false);
+}
 
-    renderQueueRing.swap(resizedRing);
-    renderQueueReadIndex = 0;
-    renderQueueWriteIndex = renderQueueSampleCount % renderQueueRing.size();
+void AudioEngine::ensureRenderQueueCapacity(size_t minSampleCapacity) {
+    // Growth is handed off inside the ring: queued samples stay where they are
+    // and the consumer switches to the larger block once it has drained them.
+    renderQueueRing.reserve(minSampleCapacity);
 }
 
 void AudioEngine::appendRenderQueue(const float* data, int numFrames, int channels) {
     if (!data || numFrames <= 0 || channels <= 0) return;
-    std::lock_guard<std::mutex> lock(renderQueueMutex);
-    const size_t requestedStereoSamples = static_cast<size_t>(numFrames) * 2u;
-    if (renderQueueRing.empty()) {
-        ensureRenderQueueCapacityLocked(requestedStereoSamples);
-    }
-    if (renderQueueRing.empty()) {
-        return;
-    }
-    const size_t freeSamples = renderQueueRing.size() - renderQueueSampleCount;
-    if (freeSamples == 0u) {
-        return;
-    }
-
     if (channels == 2) {
-        const size_t sampleCount = std::min(requestedStereoSamples, freeSamples);
-        const size_t firstChunk = std::min(sampleCount, renderQueueRing.size() - renderQueueWriteIndex);
-        std::memcpy(
-                renderQueueRing.data() + renderQueueWriteIndex,
-                data,
-                firstChunk * sizeof(float)
-        );
-        if (sampleCount > firstChunk) {
-            std::memcpy(
-                    renderQueueRing.data(),
-                    data + firstChunk,
-                    (sampleCount - firstChunk) * sizeof(float)
-            );
-        }
-        renderQueueWriteIndex = (renderQueueWriteIndex + sampleCount) % renderQueueRing.size();
-        renderQueueSampleCount += sampleCount;
+        renderQueueRing.write(data, static_cast<size_t>(numFrames) * 2u);
         return;
     }
-
-    const size_t framesToWrite = std::min(static_cast<size_t>(numFrames), freeSamples / 2u);
-    for (size_t i = 0; i < framesToWrite; ++i) {
-        const float mono = data[i * channels];
-        renderQueueRing[renderQueueWriteIndex] = mono;
-        renderQueueWriteIndex = (renderQueueWriteIndex + 1u) % renderQueueRing.size();
-        renderQueueRing[renderQueueWriteIndex] = mono;
-        renderQueueWriteIndex = (renderQueueWriteIndex + 1u) % renderQueueRing.size();
-    }
-    renderQueueSampleCount += framesToWrite * 2u;
+    renderQueueRing.writeMonoAsStereo(data, static_cast<size_t>(numFrames), static_cast<size_t>(channels));
 }
 
 int AudioEngine::popRenderQueue(float* outputData, int numFrames, int channels) {
     if (!outputData || numFrames <= 0 || channels <= 0) return 0;
-    std::lock_guard<std::mutex> lock(renderQueueMutex);
-    const int availableFrames = static_cast<int>(renderQueueSampleCount / static_cast<size_t>(channels));
-    const int framesToCopy = std::min(numFrames, availableFrames);
-    const size_t samplesToCopy = static_cast<size_t>(framesToCopy) * static_cast<size_t>(channels);
-    if (samplesToCopy > 0u) {
-        const size_t firstChunk = std::min(samplesToCopy, renderQueueRing.size() - renderQueueReadIndex);
-        std::memcpy(
-                outputData,
-                renderQueueRing.data() + renderQueueReadIndex,
-                firstChunk * sizeof(float)
-        );
-        if (samplesToCopy > firstChunk) {
-            std::memcpy(
-                    outputData + firstChunk,
-                    renderQueueRing.data(),
-                    (samplesToCopy - firstChunk) * sizeof(float)
-            );
-        }
-        renderQueueReadIndex = (renderQueueReadIndex + samplesToCopy) % renderQueueRing.size();
-        renderQueueSampleCount -= samplesToCopy;
-        if (renderQueueSampleCount == 0u) {
-            renderQueueReadIndex = 0;
-            renderQueueWriteIndex = 0;
-        }
-    }
-    return framesToCopy;
+    const size_t samplesCopied = renderQueueRing.read(
+            outputData,
+            static_cast<size_t>(numFrames) * static_cast<size_t>(channels)
+    );
+    return static_cast<int>(samplesCopied / static_cast<size_t>(channels));
 }
 
 int AudioEngine::renderQueueFrames() const {
-    std::lock_guard<std::mutex> lock(renderQueueMutex);
-    return static_cast<int>(renderQueueSampleCount / 2u);
+    return static_cast<int>(renderQueueRing.size() / 2u);
+}
+
+std::vector<int64_t> AudioEngine::getRenderProfileSnapshot() const {
+    return renderProfiler.snapshot();
+}
+
+void AudioEngine::resetRenderProfile() {
+    renderProfiler.reset();
+    renderQueueCallbackCount.store(0, std::memory_order_relaxed);
+    renderQueueCallbackQueueNs.store(0, std::memory_order_relaxed);
+    renderQueueCallbackQueueMaxNs.store(0, std::memory_order_relaxed);
+    renderQueueUnderrunCount.store(0, std::memory_order_relaxed);
+    renderQueueUnderrunFrames.store(0, std::memory_order_relaxed);
 }
 
 void AudioEngine::renderWorkerLoop() {
@@ -690,8 +716,8 @@ void AudioEngine::renderWorkerLoop() {
         bool needsFill = false;
         int bufferedFramesBeforeFill = 0;
 
-        // Vis demand bumps queue headroom only; CPU-heavy 1/4-chunk burst
-        // stays gated on basic vis (channel scope captures per-sample anyway).
+        // Vis demand bumps queue headroom only. Chunk size is left alone: the
+        // bars are analyzed on the polling thread, not per render chunk.
         uint32_t demandFeaturesEarly = 0u;
         const bool visualizationDemand = shouldUpdateVisualization(&demandFeaturesEarly);
         (void)demandFeaturesEarly;
@@ -700,12 +726,19 @@ void AudioEngine::renderWorkerLoop() {
                 ? std::max(baseChunkFrames * 8, 2048) : 0;
         const int effectiveTarget = targetFrames + visualizationHeadroom;
         {
+            const int64_t queueLockStartNs = RenderProfiler::nowNs();
             std::unique_lock<std::mutex> lock(renderQueueMutex);
+            renderProfiler.record(
+                    RenderProfiler::Stage::QueueLockWait,
+                    RenderProfiler::nowNs() - queueLockStartNs
+            );
+            // The callback pops without this mutex, so a wake-up can slip in
+            // between the predicate check and the wait. It re-notifies on every
+            // callback while below target, which bounds the miss to one period.
             renderWorkerCv.wait(lock, [this, effectiveTarget]() {
                 if (renderWorkerStop) return true;
                 if (!isPlaying.load() || seekInProgress.load()) return false;
-                const int bufferedFrames = static_cast<int>(renderQueueSampleCount / 2u);
-                return bufferedFrames < effectiveTarget;
+                return renderQueueFrames() < effectiveTarget;
             });
             if (renderWorkerStop) {
                 break;
@@ -713,21 +746,20 @@ void AudioEngine::renderWorkerLoop() {
             if (!isPlaying.load() || seekInProgress.load()) {
                 continue;
             }
-            bufferedFramesBeforeFill = static_cast<int>(renderQueueSampleCount / 2u);
+            bufferedFramesBeforeFill = renderQueueFrames();
             needsFill = bufferedFramesBeforeFill < effectiveTarget;
         }
 
         if (!needsFill) {
             continue;
         }
+        const int64_t chunkStartNs = RenderProfiler::nowNs();
 
         bool reachedEnd = false;
         int channels = 2;
         uint32_t requestedVisualizationFeatures = 0u;
         const bool visualizationActive = shouldUpdateVisualization(&requestedVisualizationFeatures);
         const bool visualizeFromRenderWorker = visualizationActive;
-        const bool basicVisualizationActive =
-                (requestedVisualizationFeatures & ~kVisualizationFeatureChannelScope) != 0u;
         int chunkFrames = baseChunkFrames;
         const int deficitFrames = std::max(0, effectiveTarget - bufferedFramesBeforeFill);
         if (recoveryBoostActive || backgroundHeadroomActive ||
@@ -741,21 +773,42 @@ void AudioEngine::renderWorkerLoop() {
                     backgroundHeadroomActive ? 8192 : 4096
             );
         }
-        // Force small decode chunks so each wake-up captures many vis frames.
-        if (basicVisualizationActive && !recoveryBoostActive && !backgroundHeadroomActive) {
-            chunkFrames = std::min(chunkFrames, std::max(64, baseChunkFrames / 4));
-        }
         {
+            const int64_t decoderLockStartNs = RenderProfiler::nowNs();
             std::lock_guard<std::mutex> lock(decoderMutex);
+            renderProfiler.record(
+                    RenderProfiler::Stage::DecoderLockWait,
+                    RenderProfiler::nowNs() - decoderLockStartNs
+            );
             if (!decoder || !isPlaying.load()) {
                 continue;
             }
+            const char* decoderName = decoder->getName();
+            if (decoderName != renderQueueTunedDecoderName) {
+                renderQueueTunedDecoderName = decoderName;
+                renderQueueController.setDecoder(decoderName ? decoderName : "");
+            }
             channels = std::clamp(decoder->getChannelCount(), 1, 2);
             if (channels <= 0) channels = 2;
             localBuffer.resize(static_cast<size_t>(chunkFrames) * static_cast<size_t>(channels));
 
             const int outputSampleRate = streamSampleRate > 0 ? streamSampleRate : 48000;
+            renderChunkDecodeNs = 0;
+            renderChunkDecodedFrames = 0;
+            const int64_t renderStartNs = RenderProfiler::nowNs();
             renderResampledLocked(localBuffer.data(), chunkFrames, channels, outputSampleRate, reachedEnd);
+            const int64_t renderNs = RenderProfiler::nowNs() - renderStartNs;
+            if (renderChunkDecodedFrames > 0) {
+                renderProfiler.recordDecode(decoderName, renderChunkDecodeNs, renderChunkDecodedFrames);
+            }
+            renderProfiler.record(RenderProfiler::Stage::Resample, renderNs - renderChunkDecodeNs);
+            if (reachedEnd && promotePreparedNextTrackLocked(false)) {
+                // Next track needs a different render format; switch at the chunk
+                // boundary instead (the tail of this chunk is already silence).
+                reachedEnd = false;
+            }
+            captureDecoderKeyframeLocked(chunkFrames, outputSampleRate);
+            maybePublishTrackInfoLocked(renderStartNs);
 
             const double callbackDeltaSeconds = (outputSampleRate > 0)
                     ? static_cast<double>(chunkFrames) / outputSampleRate
@@ -862,12 +915,18 @@ void AudioEngine::renderWorkerLoop() {
 
             const double gainTimelinePosition = positionSeconds.load();
             const float endFadeGain = computeEndFadeGainLocked(gainTimelinePosition);
-            applyGain(localBuffer.data(), chunkFrames, channels, endFadeGain);
-            applyMasterChannelRouting(localBuffer.data(), chunkFrames, channels);
-            applyOpenMptDspEffects(localBuffer.data(), chunkFrames, channels, outputSampleRate);
-            applyMonoDownmix(localBuffer.data(), chunkFrames, channels);
-            applyOutputLimiter(localBuffer.data(), chunkFrames, channels);
-            applyLookaheadClipper(localBuffer.data(), chunkFrames, channels, outputSampleRate);
+            applyOutputDspChainLocked(localBuffer.data(), chunkFrames, channels, outputSampleRate, endFadeGain);
+            renderQueueController.onChunk(chunkFrames, RenderProfiler::nowNs() - renderStartNs);
+            const OutputDspChain::PassTimes& dspTimes = outputDspChain.lastPassTimes();
+            if (dspTimes.frontNs > 0) {
+                renderProfiler.record(RenderProfiler::Stage::DspFront, dspTimes.frontNs);
+            }
+            if (dspTimes.openMptNs > 0) {
+                renderProfiler.record(RenderProfiler::Stage::DspOpenMpt, dspTimes.openMptNs);
+            }
+            if (dspTimes.shapeNs > 0) {
+                renderProfiler.record(RenderProfiler::Stage::DspShape, dspTimes.shapeNs);
+            }
 
             const int mode = repeatMode.load();
             if (reachedEnd && mode != 1 && mode != 3) {
@@ -883,7 +942,10 @@ void AudioEngine::renderWorkerLoop() {
             }
         }
 
+        const int64_t appendStartNs = RenderProfiler::nowNs();
         appendRenderQueue(localBuffer.data(), chunkFrames, channels);
+        const int64_t appendEndNs = RenderProfiler::nowNs();
+        renderProfiler.record(RenderProfiler::Stage::QueueAppend, appendEndNs - appendStartNs);
 
         if (visualizeFromRenderWorker) {
             updateVisualizationDataFromOutputCallback(
@@ -892,6 +954,27 @@ void AudioEngine::renderWorkerLoop() {
                     channels,
                     requestedVisualizationFeatures
             );
+            renderProfiler.record(RenderProfiler::Stage::Visualization, RenderProfiler::nowNs() - appendEndNs);
+        }
+        const int64_t chunkEndNs = RenderProfiler::nowNs();
+        renderProfiler.record(RenderProfiler::Stage::WorkerChunk, chunkEndNs - chunkStartNs);
+
+        RenderQueueController::Decision queueDecision;
+        if (renderQueueController.evaluate(
+                    chunkEndNs,
+                    streamSampleRate,
+                    renderQueueTuningUnderrunCount.load(std::memory_order_relaxed),
+                    queueDecision)) {
+            renderWorkerChunkFrames.store(queueDecision.chunkFrames, std::memory_order_relaxed);
+            renderWorkerTargetFrames.store(queueDecision.targetFrames, std::memory_order_relaxed);
+            const int capacityFrames = std::max(queueDecision.targetFrames * 6, 16384);
+            ensureRenderQueueCapacity(static_cast<size_t>(capacityFrames) * 2u);
+            LOGD(
+                    "Render queue adapted: chunk=%d target=%d (%s)",
+                    queueDecision.chunkFrames,
+                    queueDecision.targetFrames,
+                    queueDecision.reason.c_str()
+            );
         }
 
         // Only apply a tiny pacing delay while visualization demand is active.
@@ -4,6 +4,7 @@
 #include <android/log.h>
 #include <android/api-level.h>
 #include <algorithm>
+#include <array>
 #include <cerrno>
 #include <chrono>
 #include <cstring>
@@ -27,6 +28,13 @@ namespace {
     constexpr int kOpenSlStartupMinQueuedBuffersFast = 1;
     constexpr int kAudioTrackStartupReadyWaitMs = 240;
     constexpr int kAudioTrackStartupPollIntervalMs = 2;
+    constexpr int kOutputFadeBlockFrames = 256;
+
+    int64_t steadyNowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()
+        ).count();
+    }
 
     pid_t currentThreadId() {
 #ifdef SYS_gettid
@@ -390,32 +398,56 @@ bool AudioEngine::createAudioTrackStream() {
     streamSampleRate = streamSampleRate > 0 ? streamSampleRate : 48000;
     streamChannelCount = 2;
     audioTrackBufferFrames = audioTrackBufferFramesForPreset(outputBufferPreset);
-    audioTrackFloatBuffer.assign(static_cast<size_t>(audioTrackBufferFrames) * 2u, 0.0f);
-    audioTrackPcmBuffer.assign(static_cast<size_t>(audioTrackBufferFrames) * 2u, 0);
     audioTrackStopRequested.store(false, std::memory_order_relaxed);
 
-    if (!createAudioTrackOutput(
+    // Float tracks take the render buffer as is (no int16 pass, no Java
+    // array copy); the builder path needed for them is M+.
+    audioTrackFloatOutput = android_get_device_api_level() >= __ANDROID_API_M__;
+    audioTrackTrackFrames = createAudioTrackOutput(
             streamSampleRate,
             audioTrackBufferFrames,
             outputPerformanceMode,
-            outputBufferPreset
-    )) {
+            outputBufferPreset,
+            audioTrackFloatOutput
+    );
+    if (audioTrackTrackFrames <= 0 && audioTrackFloatOutput) {
+        LOGD("Float AudioTrack unavailable, falling back to PCM16");
+        audioTrackFloatOutput = false;
+        audioTrackTrackFrames = createAudioTrackOutput(
+                streamSampleRate,
+                audioTrackBufferFrames,
+                outputPerformanceMode,
+                outputBufferPreset,
+                false
+        );
+    }
+    if (audioTrackTrackFrames <= 0) {
         closeAudioTrackStream();
         LOGE("AudioTrack output creation failed");
         return false;
     }
+    audioTrackWriteFrames = std::max(audioTrackBufferFrames, audioTrackTrackFrames / 2);
+    audioTrackFloatBuffer.assign(static_cast<size_t>(audioTrackWriteFrames) * 2u, 0.0f);
+    if (audioTrackFloatOutput) {
+        audioTrackPcmBuffer.clear();
+    } else {
+        audioTrackPcmBuffer.assign(static_cast<size_t>(audioTrackWriteFrames) * 2u, 0);
+    }
 
     activeOutputBackend.store(3, std::memory_order_relaxed);
     outputStreamReady.store(true, std::memory_order_relaxed);
     streamStartupPrerollPending = true;
     LOGD(
-            "AudioTrack stream opened: sampleRate=%d, channels=%d, backendPref=%d, perfMode=%d, bufferPreset=%d, frames=%d, allowFallback=%d",
+            "AudioTrack stream opened: sampleRate=%d, channels=%d, backendPref=%d, perfMode=%d, bufferPreset=%d, frames=%d, trackFrames=%d, writeFrames=%d, format=%s, allowFallback=%d",
             streamSampleRate,
             streamChannelCount,
             outputBackendPreference,
             outputPerformanceMode,
             outputBufferPreset,
             audioTrackBufferFrames,
+            audioTrackTrackFrames,
+            audioTrackWriteFrames,
+            audioTrackFloatOutput ? "float" : "pcm16",
             outputAllowFallback ? 1 : 0
     );
     return true;
@@ -506,9 +538,16 @@ void AudioEngine::applyStreamBufferPreset() {
     if (backend == 3) {
         aaudioBufferFrames = 0;
         audioTrackBufferFrames = audioTrackBufferFramesForPreset(outputBufferPreset);
-        audioTrackFloatBuffer.assign(static_cast<size_t>(audioTrackBufferFrames) * 2u, 0.0f);
-        audioTrackPcmBuffer.assign(static_cast<size_t>(audioTrackBufferFrames) * 2u, 0);
-        LOGD("AudioTrack buffer preset applied: frames=%d", audioTrackBufferFrames);
+        audioTrackWriteFrames = std::max(audioTrackBufferFrames, audioTrackTrackFrames / 2);
+        audioTrackFloatBuffer.assign(static_cast<size_t>(audioTrackWriteFrames) * 2u, 0.0f);
+        if (!audioTrackFloatOutput) {
+            audioTrackPcmBuffer.assign(static_cast<size_t>(audioTrackWriteFrames) * 2u, 0);
+        }
+        LOGD(
+                "AudioTrack buffer preset applied: frames=%d writeFrames=%d",
+                audioTrackBufferFrames,
+                audioTrackWriteFrames
+        );
         return;
     }
 
@@ -557,13 +596,22 @@ void AudioEngine::applyStreamBufferPreset() {
     );
 }
 
-bool AudioEngine::renderOutputCallbackFrames(float* outputData, int32_t numFrames, int callbackRate) {
+bool AudioEngine::renderOutputCallbackFrames(
+        float* outputData,
+        int32_t numFrames,
+        int callbackRate,
+        int16_t* pcm16Output
+) {
     if (!outputData || numFrames <= 0) {
         return false;
     }
 
     if (seekInProgress.load()) {
+        lastOutputCallbackNs = 0;
         std::memset(outputData, 0, static_cast<size_t>(numFrames) * 2u * sizeof(float));
+        if (pcm16Output) {
+            std::memset(pcm16Output, 0, static_cast<size_t>(numFrames) * 2u * sizeof(int16_t));
+        }
         return false;
     }
 
@@ -585,12 +633,34 @@ bool AudioEngine::renderOutputCallbackFrames(float* outputData, int32_t numFrame
     }
 
     renderQueueCallbackCount.fetch_add(1, std::memory_order_relaxed);
+    const int64_t queuePopStartNs = steadyNowNs();
     const int framesCopied = popRenderQueue(outputData, numFrames, 2);
+    const int64_t queuePopEndNs = steadyNowNs();
+    recordRenderQueueCallbackTime(queuePopEndNs - queuePopStartNs);
+    renderProfiler.record(RenderProfiler::Stage::QueuePop, queuePopEndNs - queuePopStartNs);
+    {
+        // Gaps longer than a second are pauses/restarts, not jitter.
+        const int64_t intervalNs = lastOutputCallbackNs > 0 ? queuePopStartNs - lastOutputCallbackNs : 0;
+        const int64_t expectedNs = callbackRate > 0
+                ? static_cast<int64_t>(numFrames) * 1000000000LL / callbackRate
+                : 0;
+        renderProfiler.recordCallback(
+                queuePopEndNs,
+                intervalNs < 1000000000LL ? intervalNs : 0,
+                expectedNs,
+                renderQueueFrames(),
+                numFrames - framesCopied
+        );
+        if (intervalNs > 0 && intervalNs < 1000000000LL && expectedNs > 0) {
+            renderQueueController.noteCallbackJitter(
+                    intervalNs > expectedNs ? intervalNs - expectedNs : expectedNs - intervalNs
+            );
+        }
+        lastOutputCallbackNs = queuePopStartNs;
+    }
     if (framesCopied < numFrames) {
         const uint64_t missingFrames = static_cast<uint64_t>(numFrames - framesCopied);
-        const int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                std::chrono::steady_clock::now().time_since_epoch()
-        ).count();
+        const int64_t nowNs = steadyNowNs();
         // Hold a higher queue target briefly after underrun to absorb transient CPU spikes
         // during app-switch/system UI animations.
         renderQueueRecoveryBoostUntilNs.store(
@@ -599,19 +669,26 @@ bool AudioEngine::renderOutputCallbackFrames(float* outputData, int32_t numFrame
         );
         renderQueueUnderrunCount.fetch_add(1, std::memory_order_relaxed);
         renderQueueUnderrunFrames.fetch_add(missingFrames, std::memory_order_relaxed);
+        if (isPlaying.load(std::memory_order_relaxed) &&
+            !renderTerminalStopPending.load(std::memory_order_relaxed)) {
+            renderQueueTuningUnderrunCount.fetch_add(1, std::memory_order_relaxed);
+        }
 #ifndef NDEBUG
         const int64_t previousLogNs = renderQueueLastUnderrunLogNs.load(std::memory_order_relaxed);
         if (nowNs - previousLogNs > 1000000000LL) {
             const uint64_t underruns = renderQueueUnderrunCount.load(std::memory_order_relaxed);
             const uint64_t underrunFrames = renderQueueUnderrunFrames.load(std::memory_order_relaxed);
             const uint64_t callbacks = renderQueueCallbackCount.load(std::memory_order_relaxed);
+            const uint64_t queueNs = renderQueueCallbackQueueNs.load(std::memory_order_relaxed);
             LOGD(
-                    "Render queue underrun: missing=%llu callbacks=%llu underruns=%llu totalMissingFrames=%llu bufferedFrames=%d",
+                    "Render queue underrun: missing=%llu callbacks=%llu underruns=%llu totalMissingFrames=%llu bufferedFrames=%d queueOpsAvgNs=%llu queueOpsMaxNs=%lld",
                     static_cast<unsigned long long>(missingFrames),
                     static_cast<unsigned long long>(callbacks),
                     static_cast<unsigned long long>(underruns),
                     static_cast<unsigned long long>(underrunFrames),
-                    renderQueueFrames()
+                    renderQueueFrames(),
+                    static_cast<unsigned long long>(callbacks > 0 ? queueNs / callbacks : 0),
+                    static_cast<long long>(renderQueueCallbackQueueMaxNs.load(std::memory_order_relaxed))
             );
             renderQueueLastUnderrunLogNs.store(nowNs, std::memory_order_relaxed);
         }
@@ -623,19 +700,25 @@ bool AudioEngine::renderOutputCallbackFrames(float* outputData, int32_t numFrame
         );
     }
 
+    // Fade, clamp and (for the int16 backends) conversion in one pass; the
+    // fade curve is evaluated per frame into a small block of gains first.
     if (pauseResumeFadeTotalFrames > 0) {
-        for (int frame = 0; frame < numFrames; ++frame) {
-            const float fadeGain = nextPauseResumeFadeGainLocked();
-            if (fadeGain == 1.0f) continue;
-            const size_t base = static_cast<size_t>(frame) * 2u;
-            outputData[base] *= fadeGain;
-            outputData[base + 1u] *= fadeGain;
+        std::array<float, kOutputFadeBlockFrames> fadeGains {};
+        for (int blockStart = 0; blockStart < numFrames; blockStart += kOutputFadeBlockFrames) {
+            const int blockFrames = std::min(kOutputFadeBlockFrames, numFrames - blockStart);
+            for (int frame = 0; frame < blockFrames; ++frame) {
+                fadeGains[frame] = nextPauseResumeFadeGainLocked();
+            }
+            const size_t base = static_cast<size_t>(blockStart) * 2u;
+            OutputDspChain::finishStereo(
+                    outputData + base,
+                    blockFrames,
+                    fadeGains.data(),
+                    pcm16Output ? pcm16Output + base : nullptr
+            );
         }
-    }
-
-    const size_t totalSamples = static_cast<size_t>(numFrames) * 2u;
-    for (size_t i = 0; i < totalSamples; ++i) {
-        outputData[i] = std::clamp(outputData[i], -1.0f, 1.0f);
+    } else {
+        OutputDspChain::finishStereo(outputData, numFrames, nullptr, pcm16Output);
     }
 
     if (pauseResumeFadeOutStopPending) {
@@ -652,6 +735,7 @@ bool AudioEngine::renderOutputCallbackFrames(float* outputData, int32_t numFrame
         return true;
     }
 
+    const int64_t queueTailStartNs = steadyNowNs();
     const int bufferedFrames = renderQueueFrames();
     const bool backgroundHeadroomActive = backgroundPlaybackMode.load(std::memory_order_relaxed);
     const int configuredChunkFrames = std::max(256, renderWorkerChunkFrames.load(std::memory_order_relaxed));
@@ -662,9 +746,7 @@ bool AudioEngine::renderOutputCallbackFrames(float* outputData, int32_t numFrame
     int targetFramesHint = backgroundHeadroomActive
             ? std::max(targetFramesBase * 2, std::max(configuredChunkFrames, 1024) * 2)
             : targetFramesBase;
-    const int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
-            std::chrono::steady_clock::now().time_since_epoch()
-    ).count();
+    const int64_t nowNs = queueTailStartNs;
     if (nowNs < renderQueueRecoveryBoostUntilNs.load(std::memory_order_relaxed)) {
         targetFramesHint = std::max(
                 targetFramesHint,
@@ -674,9 +756,19 @@ bool AudioEngine::renderOutputCallbackFrames(float* outputData, int32_t numFrame
     if (framesCopied < numFrames || bufferedFrames < targetFramesHint) {
         renderWorkerCv.notify_one();
     }
+    recordRenderQueueCallbackTime(steadyNowNs() - queueTailStartNs);
     return false;
 }
 
+void AudioEngine::recordRenderQueueCallbackTime(int64_t elapsedNs) {
+    if (elapsedNs <= 0) return;
+    renderQueueCallbackQueueNs.fetch_add(static_cast<uint64_t>(elapsedNs), std::memory_order_relaxed);
+    int64_t previousMax = renderQueueCallbackQueueMaxNs.load(std::memory_order_relaxed);
+    while (elapsedNs > previousMax &&
+           !renderQueueCallbackQueueMaxNs.compare_exchange_weak(previousMax, elapsedNs, std::memory_order_relaxed)) {
+    }
+}
+
 bool AudioEngine::enqueueOpenSlBuffer(bool allowUnderrun) {
     if (openSlBufferQueue == nullptr || openSlBufferFrames <= 0) {
         return false;
@@ -720,14 +812,10 @@ bool AudioEngine::enqueueOpenSlBuffer(bool allowUnderrun) {
     const bool shouldStop = renderOutputCallbackFrames(
             openSlFloatBuffer.data(),
             openSlBufferFrames,
-            streamSampleRate > 0 ? streamSampleRate : 48000
+            streamSampleRate > 0 ? streamSampleRate : 48000,
+            pcmBuffer.data()
     );
 
-    for (size_t i = 0; i < sampleCount; ++i) {
-        const float clamped = std::clamp(openSlFloatBuffer[i], -1.0f, 1.0f);
-        pcmBuffer[i] = static_cast<int16_t>(clamped * 32767.0f);
-    }
-
     const SLresult enqueueResult = (*openSlBufferQueue)->Enqueue(
             openSlBufferQueue,
             pcmBuffer.data(),
@@ -802,7 +890,7 @@ bool AudioEngine::requestStreamStart() {
         }
 
         const int minStartupFrames = std::max(
-                audioTrackBufferFrames * 2,
+                audioTrackWriteFrames * 2,
                 renderWorkerChunkFrames.load(std::memory_order_relaxed) * 2
         );
         const auto readyDeadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(
@@ -828,25 +916,9 @@ bool AudioEngine::requestStreamStart() {
         // Prime the AudioTrack internal buffer before play() so the first
         // audible frame is sample 0; otherwise the playback head advances
         // through silence before the render thread's first write lands.
-        const int primeFrames = audioTrackBufferFrames;
-        const size_t primeSampleCount = static_cast<size_t>(primeFrames) * 2u;
-        if (audioTrackFloatBuffer.size() != primeSampleCount) {
-            audioTrackFloatBuffer.assign(primeSampleCount, 0.0f);
-        }
-        if (audioTrackPcmBuffer.size() != primeSampleCount) {
-            audioTrackPcmBuffer.assign(primeSampleCount, 0);
-        }
         const int primeRate = streamSampleRate > 0 ? streamSampleRate : 48000;
-        const bool primeShouldStop = renderOutputCallbackFrames(
-                audioTrackFloatBuffer.data(),
-                primeFrames,
-                primeRate
-        );
-        for (size_t i = 0; i < primeSampleCount; ++i) {
-            const float clamped = std::clamp(audioTrackFloatBuffer[i], -1.0f, 1.0f);
-            audioTrackPcmBuffer[i] = static_cast<int16_t>(clamped * 32767.0f);
-        }
-        if (!writeAudioTrackOutput(audioTrackPcmBuffer.data(), static_cast<int>(primeSampleCount))) {
+        bool primeShouldStop = false;
+        if (!renderAudioTrackFrames(std::max(256, audioTrackWriteFrames), primeRate, primeShouldStop)) {
             LOGE("AudioTrack startup prime write failed");
             return false;
         }
@@ -942,7 +1014,7 @@ int AudioEngine::getStreamBurstFrames() const {
         return openSlBufferFrames;
     }
     if (backend == 3) {
-        return audioTrackBufferFrames;
+        return audioTrackWriteFrames;
     }
 
     if (stream == nullptr) {
@@ -1056,34 +1128,65 @@ void AudioEngine::closeOpenSlStream() {
     openSlNextBufferIndex = 0;
 }
 
-void AudioEngine::audioTrackRenderLoop() {
-    pthread_setname_np(pthread_self(), "sp_atrack");
-    promoteThreadForAudio("audiotrack-write", -16);
-    int callbackRate = streamSampleRate > 0 ? streamSampleRate : 48000;
-    int callbackFrames = std::max(256, audioTrackBufferFrames);
-    const size_t sampleCount = static_cast<size_t>(callbackFrames) * 2u;
+bool AudioEngine::renderAudioTrackFrames(int frames, int rate, bool& shouldStop) {
+    const size_t sampleCount = static_cast<size_t>(frames) * 2u;
     if (audioTrackFloatBuffer.size() != sampleCount) {
         audioTrackFloatBuffer.assign(sampleCount, 0.0f);
     }
+    if (audioTrackFloatOutput) {
+        // Rendered and clamped in place, then handed to Java as a direct
+        // buffer over the same memory.
+        shouldStop = renderOutputCallbackFrames(audioTrackFloatBuffer.data(), frames, rate);
+        return writeAudioTrackOutputFloat(audioTrackFloatBuffer.data(), static_cast<int>(sampleCount));
+    }
     if (audioTrackPcmBuffer.size() != sampleCount) {
         audioTrackPcmBuffer.assign(sampleCount, 0);
     }
+    shouldStop = renderOutputCallbackFrames(
+            audioTrackFloatBuffer.data(),
+            frames,
+            rate,
+            audioTrackPcmBuffer.data()
+    );
+    return writeAudioTrackOutput(audioTrackPcmBuffer.data(), static_cast<int>(sampleCount));
+}
 
-    while (!audioTrackStopRequested.load(std::memory_order_relaxed)) {
-        const bool shouldStop = renderOutputCallbackFrames(
-                audioTrackFloatBuffer.data(),
-                callbackFrames,
-                callbackRate
-        );
-        for (size_t i = 0; i < sampleCount; ++i) {
-            const float clamped = std::clamp(audioTrackFloatBuffer[i], -1.0f, 1.0f);
-            audioTrackPcmBuffer[i] = static_cast<int16_t>(clamped * 32767.0f);
+void AudioEngine::audioTrackRenderLoop() {
+    pthread_setname_np(pthread_self(), "sp_atrack");
+    promoteThreadForAudio("audiotrack-write", -16);
+    int callbackRate = streamSampleRate > 0 ? streamSampleRate : 48000;
+    int callbackFrames = std::max(256, audioTrackWriteFrames);
+    const char* formatName = audioTrackFloatOutput ? "float" : "pcm16";
+    auto logJniCost = [callbackRate, formatName](const char* when) {
+        const AudioTrackJniStats stats = getAudioTrackJniStats();
+        if (stats.frames <= 0) {
+            return;
         }
+        const double audioSeconds = static_cast<double>(stats.frames) / callbackRate;
+        LOGD(
+                "AudioTrack JNI cost (%s, %s): %.1f us CPU per second of audio over %.1f s",
+                formatName,
+                when,
+                static_cast<double>(stats.cpuNs) / 1000.0 / audioSeconds,
+                audioSeconds
+        );
+    };
+#ifndef NDEBUG
+    int64_t nextJniLogNs = steadyNowNs() + 10000000000LL;
+#endif
 
-        if (!writeAudioTrackOutput(audioTrackPcmBuffer.data(), static_cast<int>(sampleCount))) {
+    while (!audioTrackStopRequested.load(std::memory_order_relaxed)) {
+        bool shouldStop = false;
+        if (!renderAudioTrackFrames(callbackFrames, callbackRate, shouldStop)) {
             LOGE("AudioTrack write failed");
             break;
         }
+#ifndef NDEBUG
+        if (steadyNowNs() >= nextJniLogNs) {
+            logJniCost("running");
+            nextJniLogNs = steadyNowNs() + 10000000000LL;
+        }
+#endif
 
         if (shouldStop) {
             audioTrackStopRequested.store(true, std::memory_order_relaxed);
@@ -1095,6 +1198,7 @@ void AudioEngine::audioTrackRenderLoop() {
         }
     }
 
+    logJniCost("stopped");
     stopAudioTrackOutput();
 }
 
@@ -1,4 +1,5 @@
 #include "AudioEngine.h"
+#include "decoders/DecoderPluginLoader.h"
 #include "decoders/DecoderRegistry.h"
 
 #include <android/log.h>
@@ -98,13 +99,14 @@ bool AudioEngine::start() {
                 if (durationNow > 0.0 &&
                     !loopPointRepeatMode &&
                     positionSeconds.load() >= (durationNow - 0.01)) {
+                    discardActivePrimedFramesLocked();
                     decoder->seek(0.0);
                     positionSeconds.store(0.0);
                     resetResamplerStateLocked();
                     sharedAbsoluteInputPositionBaseSeconds = 0.0;
                 }
             }
-            outputLimiterGain = 1.0f;
+            outputDspChain.resetGainState();
             pauseResumeFadeTotalFrames = 0;
             pauseResumeFadeProcessedFrames = 0;
             pauseResumeFadeFromGain = 1.0f;
@@ -284,12 +286,15 @@ void AudioEngine::releaseCurrentDecoder() {
     clearRenderQueue();
     renderWorkerCv.notify_all();
 
+    clearNextUrl();
     std::lock_guard<std::mutex> lock(decoderMutex);
     decoder.reset();
+    invalidateTrackInfoSnapshotLocked();
+    discardActivePrimedFramesLocked();
     cachedDurationSeconds.store(0.0);
     resetResamplerStateLocked();
     openMptDspEffects.reset();
-    outputLimiterGain = 1.0f;
+    outputDspChain.resetGainState();
     decoderRenderSampleRate = streamSampleRate;
     positionSeconds.store(0.0);
     sharedAbsoluteInputPositionBaseSeconds = 0.0;
@@ -324,6 +329,12 @@ void AudioEngine::setUrl(const char* url) {
     decoderSerial.fetch_add(1);
     clearRenderQueue();
 
+    // Reuse the background-prepared decoder when the app switches to the track
+    // it announced via setNextUrl(); any other prepared track is dropped here,
+    // before the new decoder is opened.
+    PreparedNextTrack preloaded;
+    const bool usePreloaded = takePreparedNextTrack(url, preloaded);
+
     // Drop any previously loaded decoder first. If opening the new source fails,
     // playback should not continue from stale decoder state.
     {
@@ -332,10 +343,12 @@ void AudioEngine::setUrl(const char* url) {
             previousDecoderName = decoder->getName();
         }
         decoder.reset();
+        invalidateTrackInfoSnapshotLocked();
+        discardActivePrimedFramesLocked();
         cachedDurationSeconds.store(0.0);
         resetResamplerStateLocked();
         openMptDspEffects.reset();
-        outputLimiterGain = 1.0f;
+        outputDspChain.resetGainState();
         decoderRenderSampleRate = streamSampleRate;
         positionSeconds.store(0.0);
         sharedAbsoluteInputPositionBaseSeconds = 0.0;
@@ -343,6 +356,7 @@ void AudioEngine::setUrl(const char* url) {
         timelineSmoothedSeconds = 0.0;
         timelineSmootherInitialized = false;
         naturalEndPending.store(false);
+        gaplessTransitionPending.store(false);
     }
     {
         std::lock_guard<std::mutex> lock(seekWorkerMutex);
@@ -352,7 +366,9 @@ void AudioEngine::setUrl(const char* url) {
         stopStreamAfterSeek.store(false);
     }
 
-    auto newDecoder = DecoderRegistry::getInstance().createDecoder(url);
+    auto newDecoder = usePreloaded
+            ? std::move(preloaded.decoder)
+            : DecoderRegistry::getInstance().createDecoder(url);
     if (newDecoder) {
         const std::string newDecoderName = newDecoder->getName();
         const bool sameCoreSwitch = !previousDecoderName.empty() && previousDecoderName == newDecoderName;
@@ -377,16 +393,21 @@ void AudioEngine::setUrl(const char* url) {
             }
         }
 
-        newDecoder->setOutputSampleRate(targetRate);
-        if (!optionsForDecoder.empty()) {
-            for (const auto& [name, value] : optionsForDecoder) {
-                newDecoder->setOption(name.c_str(), value.c_str());
+        if (usePreloaded) {
+            LOGD("Using preloaded decoder for: %s", url);
+        } else {
+            newDecoder->setOutputSampleRate(targetRate);
+            if (!optionsForDecoder.empty()) {
+                for (const auto& [name, value] : optionsForDecoder) {
+                    newDecoder->setOption(name.c_str(), value.c_str());
+                }
+            }
+            if (!newDecoder->open(url)) {
+                LOGE("Failed to open file: %s", url);
+                return;
             }
         }
-        if (!newDecoder->open(url)) {
-            LOGE("Failed to open file: %s", url);
-            return;
-        }
+        DecoderPluginLoader::getInstance().notePlayback(*newDecoder);
         std::lock_guard<std::mutex> lock(decoderMutex);
         decoderRenderSampleRate = newDecoder->getSampleRate();
         newDecoder->setRepeatMode(repeatMode.load());
@@ -396,6 +417,12 @@ void AudioEngine::setUrl(const char* url) {
             }
         }
         decoder = std::move(newDecoder);
+        invalidateTrackInfoSnapshotLocked();
+        if (usePreloaded) {
+            activePrimedSamples = std::move(preloaded.primedSamples);
+            activePrimedOffset = 0;
+            activePrimedChannels = preloaded.primedChannels;
+        }
         cachedDurationSeconds.store(decoder->getDuration());
         resetResamplerStateLocked();
         positionSeconds.store(0.0);
@@ -483,6 +510,7 @@ double AudioEngine::runAsyncSeekLocked(double targetSeconds) {
         return position >= 0.0 ? position : 0.0;
     }
     const double clampedTarget = std::max(0.0, targetSeconds);
+    discardActivePrimedFramesLocked();
 
     // Prefer direct/random-access seek when a decoder can do it reliably.
     // We still execute it on the async seek worker to keep UI interactions non-blocking.
@@ -493,7 +521,6 @@ double AudioEngine::runAsyncSeekLocked(double targetSeconds) {
         return decoderPosition >= 0.0 ? decoderPosition : clampedTarget;
     }
 
-    decoder->seek(0.0);
     const int channels = std::max(1, decoder->getChannelCount());
     int decoderRate = decoderRenderSampleRate > 0 ? decoderRenderSampleRate : decoder->getSampleRate();
     if (decoderRate <= 0) {
@@ -504,6 +531,18 @@ double AudioEngine::runAsyncSeekLocked(double targetSeconds) {
     int64_t skippedFrames = 0;
     constexpr int kAsyncSeekChunkFrames = 4096;
 
+    // Start from the nearest snapshot keyframe when we have one, so only the
+    // remainder has to be rendered forward.
+    const bool keyframesAvailable = bindDecoderKeyframeIndexLocked();
+    const double keyframePosition = keyframesAvailable
+            ? decoderKeyframeIndex.restoreNearest(*decoder, clampedTarget)
+            : -1.0;
+    if (keyframePosition >= 0.0) {
+        skippedFrames = std::min(targetFrames, static_cast<int64_t>(std::llround(keyframePosition * decoderRate)));
+    } else {
+        decoder->seek(0.0);
+    }
+
     while (skippedFrames < targetFrames) {
         {
             std::lock_guard<std::mutex> seekLock(seekWorkerMutex);
@@ -521,6 +560,9 @@ double AudioEngine::runAsyncSeekLocked(double targetSeconds) {
             break;
         }
         skippedFrames += framesRead;
+        if (keyframesAvailable) {
+            decoderKeyframeIndex.maybeCapture(*decoder, decoder->getPlaybackPositionSeconds());
+        }
     }
 
     const double decoderPosition = decoder->getPlaybackPositionSeconds();
@@ -530,6 +572,41 @@ double AudioEngine::runAsyncSeekLocked(double targetSeconds) {
     return static_cast<double>(skippedFrames) / static_cast<double>(decoderRate);
 }
 
+bool AudioEngine::bindDecoderKeyframeIndexLocked() {
+    if (!decoder) {
+        decoderKeyframeIndex.invalidate();
+        return false;
+    }
+    const int sampleRate = decoderRenderSampleRate > 0 ? decoderRenderSampleRate : decoder->getSampleRate();
+    return decoderKeyframeIndex.bind(
+            *decoder,
+            decoderSerial.load(),
+            decoder->getCurrentSubtuneIndex(),
+            sampleRate
+    );
+}
+
+void AudioEngine::captureDecoderKeyframeLocked(int renderedFrames, int sampleRate) {
+    // Keyframes are seconds apart; skip the capability, bind and position
+    // queries (some take the decoder's own lock) on the chunks in between.
+    decoderKeyframeFramesUntilCheck -= renderedFrames;
+    if (decoderKeyframeFramesUntilCheck > 0) {
+        return;
+    }
+    decoderKeyframeFramesUntilCheck = static_cast<int64_t>(
+            decoderKeyframeIndex.checkPeriodSeconds() * std::max(1, sampleRate)
+    );
+    if (!decoder ||
+        (decoder->getPlaybackCapabilities() & AudioDecoder::PLAYBACK_CAP_STATE_SNAPSHOT) == 0 ||
+        !bindDecoderKeyframeIndexLocked()) {
+        return;
+    }
+    const double position = decoder->getPlaybackPositionSeconds();
+    if (position >= 0.0) {
+        decoderKeyframeIndex.maybeCapture(*decoder, position);
+    }
+}
+
 void AudioEngine::seekWorkerLoop() {
     pthread_setname_np(pthread_self(), "sp_seek");
     // Keep seek worker responsive but below render worker importance.
@@ -1,6 +1,9 @@
 #include "AudioTrackJniBridge.h"
 
 #include <android/log.h>
+#include <time.h>
+
+#include <atomic>
 #include <mutex>
 
 #define LOG_TAG "AudioTrackBridge"
@@ -15,9 +18,26 @@ namespace {
     jmethodID gStopMethod = nullptr;
     jmethodID gReleaseMethod = nullptr;
     jmethodID gWriteMethod = nullptr;
+    jmethodID gWriteFloatMethod = nullptr;
     jshortArray gWriteArray = nullptr;
     int gWriteArrayCapacity = 0;
+    jobject gWriteFloatBuffer = nullptr;
+    const float* gWriteFloatBufferAddress = nullptr;
+    int gWriteFloatBufferCapacity = 0;
     std::mutex gBridgeMutex;
+    std::atomic<int64_t> gJniCpuNs { 0 };
+    std::atomic<int64_t> gJniSamples { 0 };
+
+    int64_t threadCpuNs() {
+        timespec ts {};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return static_cast<int64_t>(ts.tv_sec) * 1000000000ll + ts.tv_nsec;
+    }
+
+    void recordWriteLocked(int64_t cpuStartNs, int sampleCount) {
+        gJniCpuNs.fetch_add(threadCpuNs() - cpuStartNs, std::memory_order_relaxed);
+        gJniSamples.fetch_add(sampleCount, std::memory_order_relaxed);
+    }
 
     JNIEnv* getEnv(bool& didAttach) {
         didAttach = false;
@@ -82,6 +102,58 @@ namespace {
         gWriteArrayCapacity = sampleCount;
         return true;
     }
+
+    void releaseWriteBuffersLocked(JNIEnv* env) {
+        if (env != nullptr && gWriteArray != nullptr) {
+            env->DeleteGlobalRef(gWriteArray);
+        }
+        gWriteArray = nullptr;
+        gWriteArrayCapacity = 0;
+        if (env != nullptr && gWriteFloatBuffer != nullptr) {
+            env->DeleteGlobalRef(gWriteFloatBuffer);
+        }
+        gWriteFloatBuffer = nullptr;
+        gWriteFloatBufferAddress = nullptr;
+        gWriteFloatBufferCapacity = 0;
+    }
+
+    // The direct buffer wraps the caller's render buffer, so it is only
+    // rebuilt when that buffer moves or grows.
+    bool ensureWriteFloatBufferLocked(JNIEnv* env, float* pcmData, int sampleCount) {
+        if (env == nullptr || pcmData == nullptr || sampleCount <= 0) {
+            return false;
+        }
+        if (gWriteFloatBuffer != nullptr &&
+            gWriteFloatBufferAddress == pcmData &&
+            gWriteFloatBufferCapacity >= sampleCount) {
+            return true;
+        }
+
+        if (gWriteFloatBuffer != nullptr) {
+            env->DeleteGlobalRef(gWriteFloatBuffer);
+            gWriteFloatBuffer = nullptr;
+            gWriteFloatBufferAddress = nullptr;
+            gWriteFloatBufferCapacity = 0;
+        }
+
+        jobject localBuffer = env->NewDirectByteBuffer(
+                pcmData,
+                static_cast<jlong>(sampleCount) * static_cast<jlong>(sizeof(float))
+        );
+        if (localBuffer == nullptr) {
+            clearExceptionIfAny(env, "NewDirectByteBuffer(writeFloatBuffer)");
+            return false;
+        }
+        gWriteFloatBuffer = env->NewGlobalRef(localBuffer);
+        env->DeleteLocalRef(localBuffer);
+        if (gWriteFloatBuffer == nullptr) {
+            clearExceptionIfAny(env, "NewGlobalRef(writeFloatBuffer)");
+            return false;
+        }
+        gWriteFloatBufferAddress = pcmData;
+        gWriteFloatBufferCapacity = sampleCount;
+        return true;
+    }
 }
 
 bool initAudioTrackJniBridge(JavaVM* vm, JNIEnv* env) {
@@ -108,17 +180,23 @@ bool initAudioTrackJniBridge(JavaVM* vm, JNIEnv* env) {
         return false;
     }
 
-    gCreateMethod = env->GetStaticMethodID(gNativeBridgeClass, "createAudioTrackOutput", "(IIII)Z");
+    gCreateMethod = env->GetStaticMethodID(gNativeBridgeClass, "createAudioTrackOutput", "(IIIIZ)I");
     gStartMethod = env->GetStaticMethodID(gNativeBridgeClass, "startAudioTrackOutput", "()Z");
     gStopMethod = env->GetStaticMethodID(gNativeBridgeClass, "stopAudioTrackOutput", "()V");
     gReleaseMethod = env->GetStaticMethodID(gNativeBridgeClass, "releaseAudioTrackOutput", "()V");
     gWriteMethod = env->GetStaticMethodID(gNativeBridgeClass, "writeAudioTrackOutput", "([SI)I");
+    gWriteFloatMethod = env->GetStaticMethodID(
+            gNativeBridgeClass,
+            "writeAudioTrackOutputFloat",
+            "(Ljava/nio/ByteBuffer;I)I"
+    );
 
     if (gCreateMethod == nullptr ||
         gStartMethod == nullptr ||
         gStopMethod == nullptr ||
         gReleaseMethod == nullptr ||
-        gWriteMethod == nullptr) {
+        gWriteMethod == nullptr ||
+        gWriteFloatMethod == nullptr) {
         clearExceptionIfAny(env, "GetStaticMethodID(AudioTrackOutput)");
         shutdownAudioTrackJniBridge(env);
         return false;
@@ -130,11 +208,7 @@ bool initAudioTrackJniBridge(JavaVM* vm, JNIEnv* env) {
 
 void shutdownAudioTrackJniBridge(JNIEnv* env) {
     std::lock_guard<std::mutex> lock(gBridgeMutex);
-    if (env != nullptr && gWriteArray != nullptr) {
-        env->DeleteGlobalRef(gWriteArray);
-    }
-    gWriteArray = nullptr;
-    gWriteArrayCapacity = 0;
+    releaseWriteBuffersLocked(env);
 
     if (env != nullptr && gNativeBridgeClass != nullptr) {
         env->DeleteGlobalRef(gNativeBridgeClass);
@@ -145,33 +219,39 @@ void shutdownAudioTrackJniBridge(JNIEnv* env) {
     gStopMethod = nullptr;
     gReleaseMethod = nullptr;
     gWriteMethod = nullptr;
+    gWriteFloatMethod = nullptr;
 }
 
-bool createAudioTrackOutput(int sampleRate, int bufferFrames, int performanceMode, int bufferPreset) {
+int createAudioTrackOutput(int sampleRate, int bufferFrames, int performanceMode, int bufferPreset, bool floatPcm) {
     bool didAttach = false;
     JNIEnv* env = getEnv(didAttach);
     if (env == nullptr) {
-        return false;
+        return 0;
     }
 
-    bool created = false;
+    int trackFrames = 0;
     {
         std::lock_guard<std::mutex> lock(gBridgeMutex);
         if (gNativeBridgeClass != nullptr && gCreateMethod != nullptr) {
-            const jboolean result = env->CallStaticBooleanMethod(
+            const jint result = env->CallStaticIntMethod(
                     gNativeBridgeClass,
                     gCreateMethod,
                     static_cast<jint>(sampleRate),
                     static_cast<jint>(bufferFrames),
                     static_cast<jint>(performanceMode),
-                    static_cast<jint>(bufferPreset)
+                    static_cast<jint>(bufferPreset),
+                    static_cast<jboolean>(floatPcm ? JNI_TRUE : JNI_FALSE)
             );
-            created = !clearExceptionIfAny(env, "createAudioTrackOutput") && result == JNI_TRUE;
+            if (!clearExceptionIfAny(env, "createAudioTrackOutput") && result > 0) {
+                trackFrames = static_cast<int>(result);
+            }
         }
+        gJniCpuNs.store(0, std::memory_order_relaxed);
+        gJniSamples.store(0, std::memory_order_relaxed);
     }
 
     detachIfNeeded(didAttach);
-    return created;
+    return trackFrames;
 }
 
 bool startAudioTrackOutput() {
@@ -225,11 +305,7 @@ void releaseAudioTrackOutput() {
             env->CallStaticVoidMethod(gNativeBridgeClass, gReleaseMethod);
             clearExceptionIfAny(env, "releaseAudioTrackOutput");
         }
-        if (gWriteArray != nullptr) {
-            env->DeleteGlobalRef(gWriteArray);
-            gWriteArray = nullptr;
-            gWriteArrayCapacity = 0;
-        }
+        releaseWriteBuffersLocked(env);
     }
 
     detachIfNeeded(didAttach);
@@ -249,6 +325,7 @@ bool writeAudioTrackOutput(const int16_t* pcmData, int sampleCount) {
     bool success = false;
     {
         std::lock_guard<std::mutex> lock(gBridgeMutex);
+        const int64_t cpuStartNs = threadCpuNs();
         if (gNativeBridgeClass != nullptr &&
             gWriteMethod != nullptr &&
             ensureWriteArrayCapacityLocked(env, sampleCount)) {
@@ -269,8 +346,50 @@ bool writeAudioTrackOutput(const int16_t* pcmData, int sampleCount) {
                           writtenSamples == static_cast<jint>(sampleCount);
             }
         }
+        recordWriteLocked(cpuStartNs, sampleCount);
+    }
+
+    detachIfNeeded(didAttach);
+    return success;
+}
+
+bool writeAudioTrackOutputFloat(float* pcmData, int sampleCount) {
+    if (pcmData == nullptr || sampleCount <= 0) {
+        return false;
+    }
+
+    bool didAttach = false;
+    JNIEnv* env = getEnv(didAttach);
+    if (env == nullptr) {
+        return false;
+    }
+
+    bool success = false;
+    {
+        std::lock_guard<std::mutex> lock(gBridgeMutex);
+        const int64_t cpuStartNs = threadCpuNs();
+        if (gNativeBridgeClass != nullptr &&
+            gWriteFloatMethod != nullptr &&
+            ensureWriteFloatBufferLocked(env, pcmData, sampleCount)) {
+            const jint writtenSamples = env->CallStaticIntMethod(
+                    gNativeBridgeClass,
+                    gWriteFloatMethod,
+                    gWriteFloatBuffer,
+                    static_cast<jint>(sampleCount)
+            );
+            success = !clearExceptionIfAny(env, "writeAudioTrackOutputFloat") &&
+                      writtenSamples == static_cast<jint>(sampleCount);
+        }
+        recordWriteLocked(cpuStartNs, sampleCount);
     }
 
     detachIfNeeded(didAttach);
     return success;
 }
+
+AudioTrackJniStats getAudioTrackJniStats() {
+    AudioTrackJniStats stats;
+    stats.cpuNs = gJniCpuNs.load(std::memory_order_relaxed);
+    stats.frames = gJniSamples.load(std::memory_order_relaxed) / 2;
+    return stats;
+}
@@ -6,10 +6,25 @@
 
 bool initAudioTrackJniBridge(JavaVM* vm, JNIEnv* env);
 void shutdownAudioTrackJniBridge(JNIEnv* env);
-bool createAudioTrackOutput(int sampleRate, int bufferFrames, int performanceMode, int bufferPreset);
+
+struct AudioTrackJniStats {
+    // Thread CPU time spent in the write calls (array copy, JNI transition
+    // and AudioTrack's own copy), excluding time blocked waiting for space.
+    int64_t cpuNs = 0;
+    int64_t frames = 0;
+};
+
+// Returns the created track's buffer size in frames, or 0 on failure.
+// floatPcm selects ENCODING_PCM_FLOAT; write with writeAudioTrackOutputFloat.
+int createAudioTrackOutput(int sampleRate, int bufferFrames, int performanceMode, int bufferPreset, bool floatPcm);
 bool startAudioTrackOutput();
 void stopAudioTrackOutput();
 void releaseAudioTrackOutput();
 bool writeAudioTrackOutput(const int16_t* pcmData, int sampleCount);
+// pcmData is wrapped in a direct ByteBuffer and handed to AudioTrack without
+// a copy; it must stay valid until the next write or releaseAudioTrackOutput.
+bool writeAudioTrackOutputFloat(float* pcmData, int sampleCount);
+// Counters since the last createAudioTrackOutput.
+AudioTrackJniStats getAudioTrackJniStats();
 
 #endif // SILICONPLAYER_AUDIOTRACKJNIBRIDGE_H
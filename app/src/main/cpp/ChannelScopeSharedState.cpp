@@ -2,17 +2,64 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+
+ChannelScopeSharedState::PublishBuffer ChannelScopeSharedState::beginPublish(int channels) {
+    Slot& slot = slots[static_cast<size_t>(producerSlot)];
+    const int clampedChannels = std::max(0, channels);
+    const size_t rawSize = static_cast<size_t>(clampedChannels) * kMaxSamples;
+    // Grow only; later shapes reuse the capacity.
+    if (slot.raw.size() < rawSize) {
+        slot.raw.resize(rawSize);
+    }
+    if (slot.vu.size() < static_cast<size_t>(clampedChannels)) {
+        slot.vu.resize(static_cast<size_t>(clampedChannels));
+    }
+    PublishBuffer buffer;
+    buffer.raw = slot.raw.data();
+    buffer.vu = slot.vu.data();
+    buffer.channels = clampedChannels;
+    return buffer;
+}
+
+void ChannelScopeSharedState::commitPublish(int channels, uint64_t serial) {
+    Slot& slot = slots[static_cast<size_t>(producerSlot)];
+    slot.channels = std::clamp(channels, 0, static_cast<int>(slot.vu.size()));
+    slot.serial = serial;
+    const uint32_t previous = pendingSlot.exchange(
+            static_cast<uint32_t>(producerSlot) | kSlotFreshFlag,
+            std::memory_order_acq_rel
+    );
+    producerSlot = static_cast<int>(previous & kSlotIndexMask);
+    clearPending.store(false, std::memory_order_release);
+}
 
 void ChannelScopeSharedState::clear() {
-    std::lock_guard<std::mutex> lock(mutex);
-    snapshotRaw.clear();
-    snapshotVu.clear();
-    snapshotChannels = 0;
-    snapshotSerial = 0;
-    prevSnapshot.clear();
-    interpolatedPrev.clear();
-    interpolatedCurr.clear();
-    frozenFrameCount.clear();
+    clearPending.store(true, std::memory_order_release);
+}
+
+float ChannelScopeSharedState::trailingPeak(const float* channelSamples, int trailingSamples) {
+    const int count = std::clamp(trailingSamples, 0, kMaxSamples);
+    const float* sample = channelSamples + (kMaxSamples - count);
+    float peak = 0.0f;
+    for (int i = 0; i < count; ++i) {
+        peak = std::max(peak, std::abs(sample[i]));
+    }
+    return std::clamp(peak, 0.0f, 1.0f);
+}
+
+void ChannelScopeSharedState::acquireLatestSlotLocked() {
+    if ((pendingSlot.load(std::memory_order_acquire) & kSlotFreshFlag) == 0u) {
+        return;
+    }
+    const uint32_t latest = pendingSlot.exchange(
+            static_cast<uint32_t>(consumerSlot),
+            std::memory_order_acq_rel
+    );
+    consumerSlot = static_cast<int>(latest & kSlotIndexMask);
+}
+
+void ChannelScopeSharedState::resetConsumerLocked() {
     lastChannels = 0;
     consumedSerial = 0;
     interpolationInitialized = false;
@@ -22,64 +69,44 @@ std::vector<float> ChannelScopeSharedState::getProcessedSamples(
         int samplesPerChannel,
         int presentationDelayFrames
 ) {
-    std::vector<float> localRaw;
-    std::vector<float> localVu;
-    int localChannels = 0;
-    uint64_t localSerial = 0;
-    {
-        std::lock_guard<std::mutex> lock(mutex);
-        if (snapshotChannels <= 0 || snapshotRaw.empty()) {
-            return {};
-        }
-        localChannels = snapshotChannels;
-        localSerial = snapshotSerial;
-        localRaw = snapshotRaw;
-        localVu = snapshotVu;
+    std::lock_guard<std::mutex> lock(consumerMutex);
+    acquireLatestSlotLocked();
+    const Slot& slot = slots[static_cast<size_t>(consumerSlot)];
+    if (clearPending.load(std::memory_order_acquire) || slot.channels <= 0 || slot.raw.empty()) {
+        resetConsumerLocked();
+        return {};
     }
 
     const int clampedSamples = std::clamp(samplesPerChannel, 16, kMaxSamples);
-    const int totalChannels = localChannels;
+    const int totalChannels = slot.channels;
     const int fullSamplesPerChannel = kMaxSamples;
-    const size_t processedFullSize = static_cast<size_t>(totalChannels * fullSamplesPerChannel);
-    const size_t flattenedSize = static_cast<size_t>(totalChannels * clampedSamples);
+    const size_t processedFullSize = static_cast<size_t>(totalChannels) * fullSamplesPerChannel;
+    const size_t flattenedSize = static_cast<size_t>(totalChannels) * clampedSamples;
 
     const bool scopeShapeChanged =
             lastChannels != totalChannels ||
             prevSnapshot.size() != processedFullSize ||
-            interpolatedPrev.size() != processedFullSize ||
-            interpolatedCurr.size() != processedFullSize ||
             frozenFrameCount.size() != static_cast<size_t>(totalChannels);
     if (scopeShapeChanged) {
         prevSnapshot.assign(processedFullSize, 0.0f);
-        interpolatedPrev.assign(processedFullSize, 0.0f);
-        interpolatedCurr.assign(processedFullSize, 0.0f);
         frozenFrameCount.assign(static_cast<size_t>(totalChannels), 0);
+        suppressedChannels.assign(static_cast<size_t>(totalChannels), 0);
         lastChannels = totalChannels;
         interpolationInitialized = false;
-        consumedSerial = localSerial;
+        consumedSerial = slot.serial;
     }
-    if (localSerial != consumedSerial || !interpolationInitialized) {
-        std::vector<float> raw(processedFullSize, 0.0f);
-        std::vector<float> processed(processedFullSize, 0.0f);
+    if (slot.serial != consumedSerial || !interpolationInitialized) {
         for (int channel = 0; channel < totalChannels; ++channel) {
             const size_t channelOffset = static_cast<size_t>(channel) * fullSamplesPerChannel;
-            float* rawDestination = raw.data() + channelOffset;
-            const size_t snapshotOffset = static_cast<size_t>(channel) * kMaxSamples;
-            const int copyLen = fullSamplesPerChannel;
-            std::copy(
-                    localRaw.data() + snapshotOffset,
-                    localRaw.data() + snapshotOffset + copyLen,
-                    rawDestination
-            );
-
-            const float* previous = prevSnapshot.data() + channelOffset;
+            const float* current = slot.raw.data() + channelOffset;
+            float* previous = prevSnapshot.data() + channelOffset;
             bool sameAsPrevious = true;
             float peak = 0.0f;
             float prevPeak = 0.0f;
             float deltaSum = 0.0f;
             float rmsAcc = 0.0f;
             for (int i = 0; i < fullSamplesPerChannel; ++i) {
-                const float value = rawDestination[i];
+                const float value = current[i];
                 const float prevValue = previous[i];
                 if (prevValue != value) sameAsPrevious = false;
                 deltaSum += std::abs(value - prevValue);
@@ -89,9 +116,7 @@ std::vector<float> ChannelScopeSharedState::getProcessedSamples(
             }
 
             auto& frozen = frozenFrameCount[static_cast<size_t>(channel)];
-            const float channelVu = (static_cast<size_t>(channel) < localVu.size())
-                    ? localVu[static_cast<size_t>(channel)]
-                    : 0.0f;
+            const float channelVu = slot.vu[static_cast<size_t>(channel)];
             const float meanDelta = deltaSum / static_cast<float>(fullSamplesPerChannel);
             const float rms = std::sqrt(rmsAcc / static_cast<float>(fullSamplesPerChannel));
             const bool frameNearlyFrozen = meanDelta < 0.0005f;
@@ -124,28 +149,11 @@ std::vector<float> ChannelScopeSharedState::getProcessedSamples(
                     suppressStaleScope = true;
                 }
             }
-
-            float* processedDestination = processed.data() + channelOffset;
-            if (suppressStaleScope) {
-                std::fill(processedDestination, processedDestination + fullSamplesPerChannel, 0.0f);
-            } else {
-                std::copy(rawDestination, rawDestination + fullSamplesPerChannel, processedDestination);
-            }
+            suppressedChannels[static_cast<size_t>(channel)] = suppressStaleScope ? 1 : 0;
+            std::memcpy(previous, current, static_cast<size_t>(fullSamplesPerChannel) * sizeof(float));
         }
-        prevSnapshot = std::move(raw);
-        if (!interpolationInitialized) {
-            interpolatedPrev = processed;
-            interpolatedCurr = processed;
-            interpolationInitialized = true;
-        } else {
-            interpolatedPrev = interpolatedCurr;
-            interpolatedCurr = processed;
-        }
-        consumedSerial = localSerial;
-    }
-
-    if (!interpolationInitialized || interpolatedCurr.size() != processedFullSize) {
-        return std::vector<float>(flattenedSize, 0.0f);
+        interpolationInitialized = true;
+        consumedSerial = slot.serial;
     }
 
     const int maxPresentationDelay = std::max(0, fullSamplesPerChannel - clampedSamples);
@@ -154,15 +162,145 @@ std::vector<float> ChannelScopeSharedState::getProcessedSamples(
 
     std::vector<float> flattened(flattenedSize, 0.0f);
     for (int channel = 0; channel < totalChannels; ++channel) {
+        if (suppressedChannels[static_cast<size_t>(channel)] != 0) {
+            continue;
+        }
         const size_t sourceOffset =
                 static_cast<size_t>(channel) * static_cast<size_t>(fullSamplesPerChannel) +
                 static_cast<size_t>(windowStart);
         const size_t destinationOffset = static_cast<size_t>(channel) * static_cast<size_t>(clampedSamples);
-        std::copy(
-                interpolatedCurr.data() + sourceOffset,
-                interpolatedCurr.data() + sourceOffset + clampedSamples,
-                flattened.data() + destinationOffset
+        std::memcpy(
+                flattened.data() + destinationOffset,
+                slot.raw.data() + sourceOffset,
+                static_cast<size_t>(clampedSamples) * sizeof(float)
         );
     }
     return flattened;
 }
+
+bool ChannelScopeRing::ensureChannels(int newChannels) {
+    const int clampedChannels = std::max(0, newChannels);
+    if (clampedChannels == channelCount) {
+        return false;
+    }
+    channelCount = clampedChannels;
+    const size_t requiredSize = static_cast<size_t>(clampedChannels) * kSamples;
+    if (samples.size() < requiredSize) {
+        samples.resize(requiredSize);
+    }
+    std::fill(samples.begin(), samples.begin() + static_cast<ptrdiff_t>(requiredSize), 0.0f);
+    publishedVu.assign(static_cast<size_t>(clampedChannels), 0.0f);
+    writePos = 0;
+    filled = 0;
+    return true;
+}
+
+void ChannelScopeRing::reset() {
+    channelCount = 0;
+    writePos = 0;
+    filled = 0;
+    publishedVu.clear();
+}
+
+void ChannelScopeRing::appendFrame(const float* perChannelSamples, int count) {
+    if (channelCount <= 0 || perChannelSamples == nullptr) {
+        return;
+    }
+    const int stored = std::clamp(count, 0, channelCount);
+    float* column = samples.data() + writePos;
+    for (int channel = 0; channel < stored; ++channel) {
+        column[static_cast<size_t>(channel) * kSamples] = perChannelSamples[channel];
+    }
+    for (int channel = stored; channel < channelCount; ++channel) {
+        column[static_cast<size_t>(channel) * kSamples] = 0.0f;
+    }
+    writePos = (writePos + 1) & (kSamples - 1);
+    filled = std::min(filled + 1, kSamples);
+}
+
+void ChannelScopeRing::appendFrameClamped(const float* perChannelSamples, int count) {
+    if (channelCount <= 0 || perChannelSamples == nullptr) {
+        return;
+    }
+    const int stored = std::clamp(count, 0, channelCount);
+    float* column = samples.data() + writePos;
+    for (int channel = 0; channel < stored; ++channel) {
+        column[static_cast<size_t>(channel) * kSamples] = std::clamp(perChannelSamples[channel], -1.0f, 1.0f);
+    }
+    for (int channel = stored; channel < channelCount; ++channel) {
+        column[static_cast<size_t>(channel) * kSamples] = 0.0f;
+    }
+    writePos = (writePos + 1) & (kSamples - 1);
+    filled = std::min(filled + 1, kSamples);
+}
+
+void ChannelScopeRing::appendBlock(const float* block, size_t channelStride, int frames) {
+    if (channelCount <= 0 || block == nullptr || frames <= 0) {
+        return;
+    }
+    // Only the newest kSamples frames can survive.
+    const int skipped = std::max(0, frames - kSamples);
+    const int kept = frames - skipped;
+    const int firstSpan = std::min(kept, kSamples - writePos);
+    for (int channel = 0; channel < channelCount; ++channel) {
+        const float* source = block + static_cast<size_t>(channel) * channelStride + skipped;
+        float* ring = samples.data() + static_cast<size_t>(channel) * kSamples;
+        std::memcpy(ring + writePos, source, static_cast<size_t>(firstSpan) * sizeof(float));
+        std::memcpy(ring, source + firstSpan, static_cast<size_t>(kept - firstSpan) * sizeof(float));
+    }
+    writePos = (writePos + kept) & (kSamples - 1);
+    filled = std::min(filled + kept, kSamples);
+}
+
+float ChannelScopeRing::recentSample(int channel, int samplesAgo) const {
+    if (channel < 0 || channel >= channelCount || samplesAgo < 0 || samplesAgo >= filled) {
+        return 0.0f;
+    }
+    const int index = (writePos - 1 - samplesAgo) & (kSamples - 1);
+    return samples[static_cast<size_t>(channel) * kSamples + static_cast<size_t>(index)];
+}
+
+float ChannelScopeRing::recentPeak(int channel, int sampleCount) const {
+    if (channel < 0 || channel >= channelCount) {
+        return 0.0f;
+    }
+    const int count = std::clamp(sampleCount, 0, filled);
+    const float* ring = samples.data() + static_cast<size_t>(channel) * kSamples;
+    float peak = 0.0f;
+    int index = (writePos - count) & (kSamples - 1);
+    for (int i = 0; i < count; ++i) {
+        peak = std::max(peak, std::abs(ring[index]));
+        index = (index + 1) & (kSamples - 1);
+    }
+    return peak;
+}
+
+void ChannelScopeRing::publish(ChannelScopeSharedState& state, uint64_t serial, int vuSamples) {
+    if (empty()) {
+        state.clear();
+        return;
+    }
+
+    const ChannelScopeSharedState::PublishBuffer buffer = state.beginPublish(channelCount);
+    const int zeroPrefix = kSamples - filled;
+    // Oldest sample sits at writePos once the ring has wrapped.
+    const int oldest = (writePos - filled) & (kSamples - 1);
+    const int firstSpan = std::min(filled, kSamples - oldest);
+    for (int channel = 0; channel < channelCount; ++channel) {
+        const float* ring = samples.data() + static_cast<size_t>(channel) * kSamples;
+        float* destination = buffer.raw + static_cast<size_t>(channel) * kSamples;
+        if (zeroPrefix > 0) {
+            std::memset(destination, 0, static_cast<size_t>(zeroPrefix) * sizeof(float));
+        }
+        std::memcpy(destination + zeroPrefix, ring + oldest, static_cast<size_t>(firstSpan) * sizeof(float));
+        std::memcpy(
+                destination + zeroPrefix + firstSpan,
+                ring,
+                static_cast<size_t>(filled - firstSpan) * sizeof(float)
+        );
+        const float peak = ChannelScopeSharedState::trailingPeak(destination, vuSamples);
+        buffer.vu[channel] = peak;
+        publishedVu[static_cast<size_t>(channel)] = peak;
+    }
+    state.commitPublish(channelCount, serial);
+}
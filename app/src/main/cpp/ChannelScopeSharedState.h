@@ -1,29 +1,114 @@
 #ifndef SILICONPLAYER_CHANNEL_SCOPE_SHARED_STATE_H
 #define SILICONPLAYER_CHANNEL_SCOPE_SHARED_STATE_H
 
+#include <array>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <mutex>
 #include <vector>
 
-struct ChannelScopeSharedState {
-    mutable std::mutex mutex;
+// Decoder -> UI hand-off of per-channel scope windows.
+//
+// Producers fill a preallocated back buffer in place (beginPublish) and swap
+// it in with a lock-free triple-buffer exchange (commitPublish). Producer
+// calls must be serialized by the caller (decoders publish under their own
+// decode lock), and never block on the UI. The consumer side picks up the
+// newest buffer, runs the stale-scope detection once per new snapshot and
+// copies out only the window it was asked for.
+class ChannelScopeSharedState {
+public:
     static constexpr int kMaxSamples = 32768;
 
-    std::vector<float> snapshotRaw;
-    std::vector<float> snapshotVu;
-    int snapshotChannels = 0;
-    uint64_t snapshotSerial = 0;
+    struct PublishBuffer {
+        float* raw = nullptr; // channels * kMaxSamples, channel-major, oldest first
+        float* vu = nullptr;  // channels
+        int channels = 0;
+    };
 
+    // Producer side. The returned buffer holds stale data from an earlier
+    // publication; producers overwrite every sample they publish.
+    PublishBuffer beginPublish(int channels);
+    // Publishes the first `channels` channels of the buffer from beginPublish.
+    void commitPublish(int channels, uint64_t serial);
+    // Hides the published snapshot until the next commitPublish. Unlike the
+    // calls above this is safe from any thread, so owners can clear the
+    // scope while a separate capture thread is publishing.
+    void clear();
+
+    // Consumer side (any thread).
+    std::vector<float> getProcessedSamples(int samplesPerChannel, int presentationDelayFrames = 0);
+
+    static float trailingPeak(const float* channelSamples, int trailingSamples);
+
+private:
+    struct Slot {
+        std::vector<float> raw;
+        std::vector<float> vu;
+        int channels = 0;
+        uint64_t serial = 0;
+    };
+
+    static constexpr uint32_t kSlotIndexMask = 0x3u;
+    static constexpr uint32_t kSlotFreshFlag = 0x4u;
+
+    void acquireLatestSlotLocked();
+    void resetConsumerLocked();
+
+    std::array<Slot, 3> slots;
+    int producerSlot = 0;
+    std::atomic<uint32_t> pendingSlot { 1u };
+    std::atomic<bool> clearPending { false };
+
+    // Consumer state; the mutex only serializes readers.
+    std::mutex consumerMutex;
+    int consumerSlot = 2;
     std::vector<float> prevSnapshot;
-    std::vector<float> interpolatedPrev;
-    std::vector<float> interpolatedCurr;
     std::vector<std::uint8_t> frozenFrameCount;
+    std::vector<std::uint8_t> suppressedChannels;
     int lastChannels = 0;
     uint64_t consumedSerial = 0;
     bool interpolationInitialized = false;
+};
 
-    std::vector<float> getProcessedSamples(int samplesPerChannel, int presentationDelayFrames = 0);
-    void clear();
+// Decoder-owned history ring for decoders that produce scope samples
+// incrementally. Shared so every decoder keeps the same layout and the same
+// unroll-and-publish path. Not thread-safe; use under the decoder's lock.
+class ChannelScopeRing {
+public:
+    static constexpr int kSamples = ChannelScopeSharedState::kMaxSamples;
+
+    // Reshapes (and clears) only when the channel count changes; returns
+    // true when it did. Storage is kept across reshapes that fit.
+    bool ensureChannels(int channels);
+    void reset();
+
+    int channels() const { return channelCount; }
+    int filledSamples() const { return filled; }
+    bool empty() const { return channelCount <= 0 || filled <= 0; }
+
+    // One sample per channel. Channels at or beyond `count` get silence.
+    void appendFrame(const float* perChannelSamples, int count);
+    void appendFrameClamped(const float* perChannelSamples, int count);
+    // Channel-major block: channel c starts at block + c * channelStride.
+    void appendBlock(const float* block, size_t channelStride, int frames);
+
+    // samplesAgo == 0 is the newest sample.
+    float recentSample(int channel, int samplesAgo) const;
+    float recentPeak(int channel, int samples) const;
+
+    // Unrolls into the state's back buffer (two copies per channel), computes
+    // VU peaks over the newest vuSamples and publishes. Clears the state when
+    // nothing has been captured yet.
+    void publish(ChannelScopeSharedState& state, uint64_t serial, int vuSamples);
+    const std::vector<float>& lastPublishedVu() const { return publishedVu; }
+
+private:
+    std::vector<float> samples;
+    std::vector<float> publishedVu;
+    int channelCount = 0;
+    int writePos = 0;
+    int filled = 0;
 };
 
 #endif // SILICONPLAYER_CHANNEL_SCOPE_SHARED_STATE_H
@@ -0,0 +1,137 @@
+#include "DecoderKeyframeIndex.h"
+
+#include "decoders/AudioDecoder.h"
+
+#include <algorithm>
+
+namespace {
+    constexpr size_t kMinimumKeyframeSlots = 4u;
+    constexpr size_t kNoKeyframe = static_cast<size_t>(-1);
+}
+
+bool DecoderKeyframeIndex::bind(
+        const AudioDecoder& decoder,
+        uint64_t decoderSerial,
+        int subtuneIndex,
+        int sampleRate) {
+    if ((decoder.getPlaybackCapabilities() & AudioDecoder::PLAYBACK_CAP_STATE_SNAPSHOT) == 0) {
+        invalidate();
+        return false;
+    }
+    const size_t size = decoder.getStateSnapshotSize();
+    if (size == 0u) {
+        invalidate();
+        return false;
+    }
+    if (decoderSerial != boundSerial ||
+        subtuneIndex != boundSubtune ||
+        sampleRate != boundSampleRate ||
+        size != snapshotSize) {
+        invalidate();
+        if (size != snapshotSize) {
+            arena.reset();
+            arenaSlots = 0;
+            snapshotSize = size;
+        }
+        boundSerial = decoderSerial;
+        boundSubtune = subtuneIndex;
+        boundSampleRate = sampleRate;
+    }
+    return true;
+}
+
+void DecoderKeyframeIndex::invalidate() {
+    keyframes.clear();
+    freeSlots.clear();
+    for (size_t slot = arenaSlots; slot > 0; --slot) {
+        freeSlots.push_back(slot - 1u);
+    }
+    intervalSeconds = kDefaultIntervalSeconds;
+    boundSubtune = -1;
+    boundSampleRate = 0;
+}
+
+bool DecoderKeyframeIndex::ensureArena() {
+    if (arena) return true;
+    if (snapshotSize == 0u || snapshotSize > kDefaultArenaBytes / kMinimumKeyframeSlots) {
+        return false;
+    }
+    arenaSlots = kDefaultArenaBytes / snapshotSize;
+    arena.reset(new uint8_t[arenaSlots * snapshotSize]);
+    keyframes.reserve(arenaSlots);
+    freeSlots.clear();
+    freeSlots.reserve(arenaSlots);
+    for (size_t slot = arenaSlots; slot > 0; --slot) {
+        freeSlots.push_back(slot - 1u);
+    }
+    return true;
+}
+
+size_t DecoderKeyframeIndex::findAtOrBefore(double positionSeconds) const {
+    auto it = std::upper_bound(
+            keyframes.begin(),
+            keyframes.end(),
+            positionSeconds,
+            [](double position, const Keyframe& keyframe) { return position < keyframe.positionSeconds; }
+    );
+    if (it == keyframes.begin()) return kNoKeyframe;
+    return static_cast<size_t>(std::distance(keyframes.begin(), it) - 1);
+}
+
+void DecoderKeyframeIndex::thinOut() {
+    // Keep even entries; odd ones go back to the free list.
+    size_t kept = 0;
+    for (size_t i = 0; i < keyframes.size(); ++i) {
+        if ((i & 1u) == 0u) {
+            keyframes[kept++] = keyframes[i];
+        } else {
+            freeSlots.push_back(keyframes[i].slot);
+        }
+    }
+    keyframes.resize(kept);
+    intervalSeconds *= 2.0;
+}
+
+void DecoderKeyframeIndex::maybeCapture(AudioDecoder& decoder, double positionSeconds) {
+    if (snapshotSize == 0u || positionSeconds < intervalSeconds) return;
+
+    const size_t previous = findAtOrBefore(positionSeconds);
+    if (previous != kNoKeyframe &&
+        positionSeconds - keyframes[previous].positionSeconds < intervalSeconds) {
+        return;
+    }
+    // A later keyframe this close means we are replaying a region we already indexed.
+    if (previous + 1u < keyframes.size() &&
+        keyframes[previous + 1u].positionSeconds - positionSeconds < intervalSeconds) {
+        return;
+    }
+    if (!ensureArena()) return;
+    if (freeSlots.empty()) {
+        thinOut();
+        maybeCapture(decoder, positionSeconds);
+        return;
+    }
+
+    const size_t slot = freeSlots.back();
+    if (!decoder.saveStateSnapshot(slotData(slot), snapshotSize)) {
+        return;
+    }
+    freeSlots.pop_back();
+    const size_t insertAt = previous == kNoKeyframe ? 0u : previous + 1u;
+    keyframes.insert(keyframes.begin() + static_cast<std::ptrdiff_t>(insertAt), Keyframe { positionSeconds, slot });
+}
+
+double DecoderKeyframeIndex::restoreNearest(AudioDecoder& decoder, double targetSeconds) {
+    size_t index = findAtOrBefore(targetSeconds);
+    while (index != kNoKeyframe) {
+        const Keyframe& keyframe = keyframes[index];
+        if (decoder.restoreStateSnapshot(slotData(keyframe.slot), snapshotSize)) {
+            return keyframe.positionSeconds;
+        }
+        // Drop snapshots the decoder refuses so we do not retry them on every seek.
+        freeSlots.push_back(keyframe.slot);
+        keyframes.erase(keyframes.begin() + static_cast<std::ptrdiff_t>(index));
+        index = index == 0u ? kNoKeyframe : index - 1u;
+    }
+    return -1.0;
+}
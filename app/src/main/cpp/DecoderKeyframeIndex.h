@@ -0,0 +1,63 @@
+#ifndef SILICONPLAYER_DECODER_KEYFRAME_INDEX_H
+#define SILICONPLAYER_DECODER_KEYFRAME_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class AudioDecoder;
+
+// Periodic emulator state snapshots for decoders that can only seek by
+// restarting and rendering forward (PLAYBACK_CAP_STATE_SNAPSHOT).
+//
+// Keyframes live in one arena allocated on first capture and bounded per
+// track. When the arena fills up every other keyframe is dropped and the
+// capture interval doubles, so long tracks keep an evenly spaced index.
+// An index belongs to one decoder instance, subtune and render rate; bind()
+// drops it when any of those change. Not thread-safe: callers hold the
+// engine decoder lock.
+class DecoderKeyframeIndex {
+public:
+    static constexpr double kDefaultIntervalSeconds = 10.0;
+    static constexpr size_t kDefaultArenaBytes = 16u * 1024u * 1024u;
+
+    // Returns false when the decoder does not support snapshots.
+    bool bind(const AudioDecoder& decoder, uint64_t decoderSerial, int subtuneIndex, int sampleRate);
+    void invalidate();
+
+    // Captures a keyframe at positionSeconds if the nearest earlier keyframe
+    // is at least one interval away.
+    void maybeCapture(AudioDecoder& decoder, double positionSeconds);
+    // How much playback may pass between maybeCapture() calls while keeping
+    // keyframes at most a quarter interval further apart than intended.
+    double checkPeriodSeconds() const { return intervalSeconds / 4.0; }
+
+    // Restores the closest keyframe at or before targetSeconds. Returns the
+    // restored position, or a negative value if nothing usable was found.
+    double restoreNearest(AudioDecoder& decoder, double targetSeconds);
+
+private:
+    struct Keyframe {
+        double positionSeconds = 0.0;
+        size_t slot = 0;
+    };
+
+    bool ensureArena();
+    void thinOut();
+    size_t findAtOrBefore(double positionSeconds) const;
+    uint8_t* slotData(size_t slot) { return arena.get() + slot * snapshotSize; }
+
+    uint64_t boundSerial = 0;
+    int boundSubtune = -1;
+    int boundSampleRate = 0;
+    size_t snapshotSize = 0;
+    double intervalSeconds = kDefaultIntervalSeconds;
+
+    std::unique_ptr<uint8_t[]> arena;
+    size_t arenaSlots = 0;
+    std::vector<Keyframe> keyframes;
+    std::vector<size_t> freeSlots;
+};
+
+#endif // SILICONPLAYER_DECODER_KEYFRAME_INDEX_H
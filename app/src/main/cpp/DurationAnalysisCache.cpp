@@ -0,0 +1,325 @@
+#include "DurationAnalysisCache.h"
+
+#include <android/log.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <sstream>
+#include <vector>
+
+#define LOG_TAG "DurationAnalysisCache"
+#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace {
+constexpr char kFileName[] = "duration_cache.bin";
+constexpr char kFileMagic[4] = { 'S', 'P', 'D', 'C' };
+// Bump when analysis semantics change so stale lengths are dropped.
+constexpr uint32_t kFileVersion = 1;
+constexpr size_t kFlushBatch = 16;
+constexpr auto kFlushInterval = std::chrono::seconds(10);
+// 2 MiB of records; past that the least recently used ones are dropped.
+constexpr size_t kMaxRecords = 65536;
+
+struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t recordCount;
+};
+static_assert(sizeof(FileHeader) == 16, "duration cache header layout changed");
+
+uint32_t nowMinutes() {
+    return static_cast<uint32_t>(std::max<std::time_t>(0, std::time(nullptr)) / 60);
+}
+
+const char* coreLabel(const char* coreName) {
+    return (coreName && coreName[0] != '\0') ? coreName : "unknown";
+}
+}
+
+DurationAnalysisCache& DurationAnalysisCache::getInstance() {
+    static DurationAnalysisCache instance;
+    return instance;
+}
+
+DurationAnalysisCache::~DurationAnalysisCache() {
+    std::lock_guard<std::mutex> lock(mutex);
+    flushLocked();
+    unmapFileLocked();
+}
+
+void DurationAnalysisCache::setDirectory(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const std::string nextPath = directory.empty() ? std::string() : directory + "/" + kFileName;
+    if (nextPath == filePath) {
+        return;
+    }
+    flushLocked();
+    unmapFileLocked();
+    touched.clear();
+    filePath = nextPath;
+    if (!directory.empty()) {
+        mkdir(directory.c_str(), 0700);
+    }
+    mapFileLocked();
+}
+
+void DurationAnalysisCache::mapFileLocked() {
+    if (filePath.empty()) {
+        return;
+    }
+    const int fd = open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return;
+    }
+    struct stat info {};
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(FileHeader))) {
+        close(fd);
+        return;
+    }
+    const size_t size = static_cast<size_t>(info.st_size);
+    void* base = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        return;
+    }
+    const auto* header = static_cast<const FileHeader*>(base);
+    const size_t available = (size - sizeof(FileHeader)) / sizeof(Record);
+    if (std::memcmp(header->magic, kFileMagic, sizeof(kFileMagic)) != 0 ||
+        header->version != kFileVersion ||
+        header->recordCount > available) {
+        LOGD("Ignoring stale duration cache %s", filePath.c_str());
+        munmap(base, size);
+        return;
+    }
+    mapBase = base;
+    mapSize = size;
+    mappedRecords = reinterpret_cast<const Record*>(static_cast<const char*>(base) + sizeof(FileHeader));
+    mappedCount = static_cast<size_t>(header->recordCount);
+}
+
+void DurationAnalysisCache::unmapFileLocked() {
+    if (mapBase) {
+        munmap(mapBase, mapSize);
+    }
+    mapBase = nullptr;
+    mapSize = 0;
+    mappedRecords = nullptr;
+    mappedCount = 0;
+}
+
+const DurationAnalysisCache::Record* DurationAnalysisCache::findMappedLocked(const RecordKey& key) const {
+    const Record* end = mappedRecords + mappedCount;
+    const Record* found = std::lower_bound(mappedRecords, end, key, [](const Record& record, const RecordKey& target) {
+        return RecordKey(record.contentHash, record.coreTag, record.subtune) < target;
+    });
+    if (found == end || RecordKey(found->contentHash, found->coreTag, found->subtune) != key) {
+        return nullptr;
+    }
+    return found;
+}
+
+bool DurationAnalysisCache::lookup(const char* coreName, const DurationCacheKey& key, DurationCacheEntry& entry) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const RecordKey recordKey(key.contentHash, key.coreTag, key.subtune);
+    CoreStats& coreStats = stats[coreLabel(coreName)];
+    const auto pendingIt = pending.find(recordKey);
+    if (pendingIt != pending.end()) {
+        entry = pendingIt->second;
+        coreStats.hits += 1;
+        return true;
+    }
+    if (const Record* record = findMappedLocked(recordKey)) {
+        touched.insert(recordKey);
+        entry.durationMs = record->durationMs;
+        entry.loopStartMs = record->loopStartMs;
+        entry.flags = record->flags;
+        coreStats.hits += 1;
+        return true;
+    }
+    coreStats.misses += 1;
+    return false;
+}
+
+void DurationAnalysisCache::store(
+        const char* coreName,
+        const DurationCacheKey& key,
+        const DurationCacheEntry& entry,
+        int64_t analysisNs) {
+    std::lock_guard<std::mutex> lock(mutex);
+    pending[RecordKey(key.contentHash, key.coreTag, key.subtune)] = entry;
+    CoreStats& coreStats = stats[coreLabel(coreName)];
+    coreStats.analyses += 1;
+    coreStats.analysisNs += std::max<int64_t>(0, analysisNs);
+    if (pending.size() >= kFlushBatch ||
+        std::chrono::steady_clock::now() - lastFlush >= kFlushInterval) {
+        flushLocked();
+    }
+}
+
+void DurationAnalysisCache::flush() {
+    std::lock_guard<std::mutex> lock(mutex);
+    flushLocked();
+}
+
+void DurationAnalysisCache::flushLocked() {
+    lastFlush = std::chrono::steady_clock::now();
+    if (filePath.empty() || pending.empty()) {
+        // Hits alone do not rewrite the file; their stamps wait for the next
+        // batch of results.
+        return;
+    }
+    const uint32_t stamp = nowMinutes();
+
+    // Both sides are sorted by key; a merge keeps the file sorted and lets
+    // fresh results replace older ones.
+    std::vector<Record> merged;
+    merged.reserve(mappedCount + pending.size());
+    const Record* mapped = mappedRecords;
+    const Record* mappedEnd = mappedRecords + mappedCount;
+    auto pendingIt = pending.begin();
+    while (mapped != mappedEnd || pendingIt != pending.end()) {
+        const bool takePending = mapped == mappedEnd ||
+                (pendingIt != pending.end() &&
+                 pendingIt->first <= RecordKey(mapped->contentHash, mapped->coreTag, mapped->subtune));
+        if (!takePending) {
+            merged.push_back(*mapped++);
+            if (touched.count(RecordKey(merged.back().contentHash, merged.back().coreTag, merged.back().subtune)) != 0) {
+                merged.back().lastUsedMinutes = stamp;
+            }
+            continue;
+        }
+        if (mapped != mappedEnd &&
+            pendingIt->first == RecordKey(mapped->contentHash, mapped->coreTag, mapped->subtune)) {
+            ++mapped;
+        }
+        Record record {};
+        record.contentHash = std::get<0>(pendingIt->first);
+        record.coreTag = std::get<1>(pendingIt->first);
+        record.subtune = std::get<2>(pendingIt->first);
+        record.durationMs = pendingIt->second.durationMs;
+        record.loopStartMs = pendingIt->second.loopStartMs;
+        record.flags = pendingIt->second.flags;
+        record.lastUsedMinutes = stamp;
+        merged.push_back(record);
+        ++pendingIt;
+    }
+    if (merged.size() > kMaxRecords) {
+        // Drop the overflow oldest stamp first, keeping the file sorted.
+        const size_t evict = merged.size() - kMaxRecords;
+        std::vector<uint32_t> stamps;
+        stamps.reserve(merged.size());
+        for (const Record& record : merged) {
+            stamps.push_back(record.lastUsedMinutes);
+        }
+        std::nth_element(stamps.begin(), stamps.begin() + static_cast<std::ptrdiff_t>(evict - 1), stamps.end());
+        const uint32_t cutoff = stamps[evict - 1];
+        size_t evictAtCutoff = evict - static_cast<size_t>(std::count_if(
+                merged.begin(), merged.end(), [cutoff](const Record& record) { return record.lastUsedMinutes < cutoff; }));
+        size_t kept = 0;
+        for (const Record& record : merged) {
+            if (record.lastUsedMinutes < cutoff) {
+                continue;
+            }
+            if (record.lastUsedMinutes == cutoff && evictAtCutoff > 0) {
+                --evictAtCutoff;
+                continue;
+            }
+            merged[kept++] = record;
+        }
+        merged.resize(kept);
+        LOGD("Dropped %zu least recently used duration records", evict);
+    }
+
+    const std::string tempPath = filePath + ".tmp";
+    FILE* file = std::fopen(tempPath.c_str(), "wb");
+    if (!file) {
+        LOGE("Cannot write duration cache %s", tempPath.c_str());
+        return;
+    }
+    FileHeader header {};
+    std::memcpy(header.magic, kFileMagic, sizeof(kFileMagic));
+    header.version = kFileVersion;
+    header.recordCount = merged.size();
+    bool written = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+            (merged.empty() || std::fwrite(merged.data(), sizeof(Record), merged.size(), file) == merged.size());
+    written = std::fclose(file) == 0 && written;
+    if (!written) {
+        std::remove(tempPath.c_str());
+        LOGE("Short write on duration cache %s", tempPath.c_str());
+        return;
+    }
+
+    unmapFileLocked();
+    if (std::rename(tempPath.c_str(), filePath.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        mapFileLocked();
+        return;
+    }
+    pending.clear();
+    touched.clear();
+    mapFileLocked();
+    LOGD("Flushed %zu duration records\n%s", merged.size(), statsSummaryLocked().c_str());
+}
+
+std::string DurationAnalysisCache::statsSummary() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return statsSummaryLocked();
+}
+
+std::string DurationAnalysisCache::statsSummaryLocked() const {
+    std::ostringstream out;
+    for (const auto& [core, coreStats] : stats) {
+        const uint64_t lookups = coreStats.hits + coreStats.misses;
+        const double hitRate = lookups > 0
+                ? 100.0 * static_cast<double>(coreStats.hits) / static_cast<double>(lookups)
+                : 0.0;
+        const double meanMs = coreStats.analyses > 0
+                ? static_cast<double>(coreStats.analysisNs) / 1.0e6 / static_cast<double>(coreStats.analyses)
+                : 0.0;
+        char line[256];
+        std::snprintf(
+                line,
+                sizeof(line),
+                "%s: %llu lookups, %.1f%% hits, %llu analyses, %.1f ms mean\n",
+                core.c_str(),
+                static_cast<unsigned long long>(lookups),
+                hitRate,
+                static_cast<unsigned long long>(coreStats.analyses),
+                meanMs
+        );
+        out << line;
+    }
+    return out.str();
+}
+
+extern "C" __attribute__((visibility("default")))
+int siliconplayer_duration_cache_lookup(
+        const char* coreName,
+        const DurationCacheKey* key,
+        DurationCacheEntry* entry
+) {
+    if (key == nullptr || entry == nullptr) {
+        return 0;
+    }
+    return DurationAnalysisCache::getInstance().lookup(coreName, *key, *entry) ? 1 : 0;
+}
+
+extern "C" __attribute__((visibility("default")))
+void siliconplayer_duration_cache_store(
+        const char* coreName,
+        const DurationCacheKey* key,
+        const DurationCacheEntry* entry,
+        int64_t analysisNs
+) {
+    if (key == nullptr || entry == nullptr) {
+        return;
+    }
+    DurationAnalysisCache::getInstance().store(coreName, *key, *entry, analysisNs);
+}
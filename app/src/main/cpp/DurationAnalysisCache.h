@@ -0,0 +1,102 @@
+#ifndef SILICONPLAYER_DURATION_ANALYSIS_CACHE_H
+#define SILICONPLAYER_DURATION_ANALYSIS_CACHE_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <tuple>
+
+// Entry flags.
+constexpr uint32_t kDurationFlagReliable = 1u << 0; // analysis reached a real song end
+constexpr uint32_t kDurationFlagHasLoop = 1u << 1;  // loopStartMs is meaningful
+
+// Plain C layout: these cross the plugin boundary (see DurationAnalysisClient).
+struct DurationCacheKey {
+    uint64_t contentHash = 0; // DurationAnalysisClient::hashContent() of the file
+    uint32_t coreTag = 0;     // DurationAnalysisClient::coreTag() of the decoder name
+    uint32_t subtune = 0;
+};
+
+struct DurationCacheEntry {
+    uint32_t durationMs = 0;
+    uint32_t loopStartMs = 0;
+    uint32_t flags = 0;
+};
+
+// Persistent per-subtune duration/loop cache for decoders that can only learn
+// a length by emulating the tune.
+//
+// Lives in the main library; decoder plugins reach it through the exported
+// siliconplayer_duration_cache_* functions. The on-disk file is a sorted
+// array of fixed-size records behind a small header, mapped read-only and
+// binary searched. New results collect in an in-memory overlay and are
+// merged into a fresh file (write + rename) in batches. Each record carries
+// when it was last stored or hit; past kMaxRecords the least recently used
+// ones are dropped.
+class DurationAnalysisCache {
+public:
+    static DurationAnalysisCache& getInstance();
+
+    ~DurationAnalysisCache();
+
+    // Maps <directory>/duration_cache.bin; an empty directory keeps the
+    // cache memory-only. Flushes the previous file first.
+    void setDirectory(const std::string& directory);
+
+    // coreName is only used for the per-core statistics.
+    bool lookup(const char* coreName, const DurationCacheKey& key, DurationCacheEntry& entry);
+    void store(const char* coreName, const DurationCacheKey& key, const DurationCacheEntry& entry, int64_t analysisNs);
+    void flush();
+
+    // One line per core: lookups, hit rate, analyses and mean analysis time.
+    std::string statsSummary() const;
+
+private:
+    struct Record {
+        uint64_t contentHash;
+        uint32_t coreTag;
+        uint32_t subtune;
+        uint32_t durationMs;
+        uint32_t loopStartMs;
+        uint32_t flags;
+        // Wall-clock minutes since the epoch of the last store or hit; 0 in
+        // files written before it was tracked, so those go first.
+        uint32_t lastUsedMinutes;
+    };
+    static_assert(sizeof(Record) == 32, "duration cache record layout changed");
+
+    struct CoreStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t analyses = 0;
+        int64_t analysisNs = 0;
+    };
+
+    using RecordKey = std::tuple<uint64_t, uint32_t, uint32_t>;
+
+    DurationAnalysisCache() = default;
+
+    void mapFileLocked();
+    void unmapFileLocked();
+    void flushLocked();
+    const Record* findMappedLocked(const RecordKey& key) const;
+    std::string statsSummaryLocked() const;
+
+    mutable std::mutex mutex;
+    std::string filePath;
+    void* mapBase = nullptr;
+    size_t mapSize = 0;
+    const Record* mappedRecords = nullptr;
+    size_t mappedCount = 0;
+    std::map<RecordKey, DurationCacheEntry> pending;
+    // Mapped records hit since the last flush; restamped when it runs.
+    std::set<RecordKey> touched;
+    std::map<std::string, CoreStats> stats;
+    std::chrono::steady_clock::time_point lastFlush = std::chrono::steady_clock::now();
+};
+
+#endif // SILICONPLAYER_DURATION_ANALYSIS_CACHE_H
@@ -0,0 +1,175 @@
+#include "DurationAnalysisClient.h"
+
+#include "FileSource.h"
+
+#include <dlfcn.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+
+namespace {
+// One analysis at a time per plugin keeps the scan off the performance
+// cores' critical path; plugins each bring their own worker.
+constexpr int kWorkerThreads = 1;
+// Background priority: below the render and UI threads, above idle.
+constexpr int kWorkerNice = 10;
+constexpr uint64_t kFnvOffset = 1469598103934665603ull;
+constexpr uint64_t kFnvPrime = 1099511628211ull;
+}
+
+DurationAnalysisClient& DurationAnalysisClient::getInstance() {
+    static DurationAnalysisClient instance;
+    return instance;
+}
+
+DurationAnalysisClient::DurationAnalysisClient() {
+    void* handle = dlopen("libsiliconplayer.so", RTLD_NOW | RTLD_NOLOAD);
+    if (handle != nullptr) {
+        hostLookup = reinterpret_cast<LookupFn>(dlsym(handle, "siliconplayer_duration_cache_lookup"));
+        hostStore = reinterpret_cast<StoreFn>(dlsym(handle, "siliconplayer_duration_cache_store"));
+        if (hostLookup == nullptr || hostStore == nullptr) {
+            hostLookup = nullptr;
+            hostStore = nullptr;
+        }
+    }
+    workers.reserve(kWorkerThreads);
+    for (int i = 0; i < kWorkerThreads; ++i) {
+        workers.emplace_back(&DurationAnalysisClient::workerLoop, this);
+    }
+}
+
+DurationAnalysisClient::~DurationAnalysisClient() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        queue.clear();
+    }
+    wakeCv.notify_all();
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+bool DurationAnalysisClient::lookup(const char* coreName, const DurationCacheKey& key, DurationCacheEntry& entry) {
+    if (hostLookup != nullptr) {
+        return hostLookup(coreName, &key, &entry) != 0;
+    }
+    return poll(key, entry);
+}
+
+bool DurationAnalysisClient::poll(const DurationCacheKey& key, DurationCacheEntry& entry) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto it = localResults.find(JobKey(key.contentHash, key.coreTag, key.subtune));
+    if (it == localResults.end()) {
+        return false;
+    }
+    it->second.lastUse = ++useCounter;
+    entry = it->second.entry;
+    return true;
+}
+
+void DurationAnalysisClient::request(const char* coreName, const DurationCacheKey& key, Job job) {
+    if (!job) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping || !inFlight.insert(JobKey(key.contentHash, key.coreTag, key.subtune)).second) {
+            return;
+        }
+        queue.push_back(PendingJob { coreName, key, std::move(job) });
+    }
+    wakeCv.notify_one();
+}
+
+void DurationAnalysisClient::workerLoop() {
+    setpriority(PRIO_PROCESS, static_cast<id_t>(gettid()), kWorkerNice);
+    while (true) {
+        PendingJob pendingJob;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeCv.wait(lock, [this]() {
+                return stopping || !queue.empty();
+            });
+            if (stopping) {
+                return;
+            }
+            pendingJob = std::move(queue.front());
+            queue.pop_front();
+        }
+
+        DurationCacheEntry entry;
+        const auto start = std::chrono::steady_clock::now();
+        const bool analyzed = pendingJob.job(entry);
+        const int64_t analysisNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start
+        ).count();
+        if (analyzed) {
+            storeResult(pendingJob.coreName, pendingJob.key, entry, analysisNs);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        inFlight.erase(JobKey(pendingJob.key.contentHash, pendingJob.key.coreTag, pendingJob.key.subtune));
+    }
+}
+
+void DurationAnalysisClient::storeResult(
+        const char* coreName,
+        const DurationCacheKey& key,
+        const DurationCacheEntry& entry,
+        int64_t analysisNs) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        localResults[JobKey(key.contentHash, key.coreTag, key.subtune)] = LocalResult { entry, ++useCounter };
+        if (localResults.size() > kMaxLocalResults) {
+            const auto oldest = std::min_element(localResults.begin(), localResults.end(), [](const auto& a, const auto& b) {
+                return a.second.lastUse < b.second.lastUse;
+            });
+            localResults.erase(oldest);
+        }
+    }
+    if (hostStore != nullptr) {
+        hostStore(coreName, &key, &entry, analysisNs);
+    }
+}
+
+uint64_t DurationAnalysisClient::hashContent(const void* data, size_t size) {
+    // FNV-1a over 64-bit words with the length mixed in; this only has to
+    // tell files apart, not resist crafted collisions.
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    uint64_t hash = kFnvOffset ^ static_cast<uint64_t>(size);
+    size_t offset = 0;
+    for (; offset + sizeof(uint64_t) <= size; offset += sizeof(uint64_t)) {
+        uint64_t word = 0;
+        std::copy_n(bytes + offset, sizeof(word), reinterpret_cast<unsigned char*>(&word));
+        hash = (hash ^ word) * kFnvPrime;
+        hash ^= hash >> 29;
+    }
+    for (; offset < size; ++offset) {
+        hash = (hash ^ bytes[offset]) * kFnvPrime;
+    }
+    return hash;
+}
+
+bool DurationAnalysisClient::hashFile(const std::string& path, uint64_t& hash) {
+    const auto source = FileSource::open(path);
+    if (!source) {
+        return false;
+    }
+    hash = hashContent(source->data(), source->size());
+    return true;
+}
+
+uint32_t DurationAnalysisClient::coreTag(const char* coreName) {
+    uint32_t hash = 2166136261u;
+    for (const char* p = coreName ? coreName : ""; *p != '\0'; ++p) {
+        hash = (hash ^ static_cast<unsigned char>(*p)) * 16777619u;
+    }
+    return hash;
+}
@@ -0,0 +1,93 @@
+#ifndef SILICONPLAYER_DURATION_ANALYSIS_CLIENT_H
+#define SILICONPLAYER_DURATION_ANALYSIS_CLIENT_H
+
+#include "DurationAnalysisCache.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+// Decoder-side access to the duration cache, compiled into each decoder
+// plugin.
+//
+// Lookups and stores go to DurationAnalysisCache in libsiliconplayer.so;
+// without it (host tools) results only live in this process. Misses are
+// analyzed by low-priority workers owned by this copy of the client, so the
+// render path never waits for a length. The workers are joined when the
+// plugin unloads: jobs that have not started yet are dropped and will be
+// requested again by the next decoder that misses. Results analyzed here are
+// also kept locally for poll(), up to kMaxLocalResults, least recently used
+// first out.
+class DurationAnalysisClient {
+public:
+    // Fills entry and returns true on success; false means the tune could
+    // not be analyzed and nothing is cached.
+    using Job = std::function<bool(DurationCacheEntry& entry)>;
+
+    static constexpr size_t kMaxLocalResults = 256;
+
+    static DurationAnalysisClient& getInstance();
+
+    ~DurationAnalysisClient();
+
+    DurationAnalysisClient(const DurationAnalysisClient&) = delete;
+    DurationAnalysisClient& operator=(const DurationAnalysisClient&) = delete;
+
+    // Counted cache lookup (hit/miss statistics).
+    bool lookup(const char* coreName, const DurationCacheKey& key, DurationCacheEntry& entry);
+    // Checks only results analyzed by this client, for decoders waiting on
+    // a job they requested; does not touch the statistics.
+    bool poll(const DurationCacheKey& key, DurationCacheEntry& entry);
+
+    // Queues job for key unless the same key is already queued or running.
+    // coreName must outlive the job (decoders pass their getName() literal).
+    void request(const char* coreName, const DurationCacheKey& key, Job job);
+
+    static uint64_t hashContent(const void* data, size_t size);
+    static bool hashFile(const std::string& path, uint64_t& hash);
+    static uint32_t coreTag(const char* coreName);
+
+private:
+    struct PendingJob {
+        const char* coreName = nullptr;
+        DurationCacheKey key;
+        Job job;
+    };
+
+    struct LocalResult {
+        DurationCacheEntry entry;
+        uint64_t lastUse = 0;
+    };
+
+    using JobKey = std::tuple<uint64_t, uint32_t, uint32_t>;
+    using LookupFn = int (*)(const char*, const DurationCacheKey*, DurationCacheEntry*);
+    using StoreFn = void (*)(const char*, const DurationCacheKey*, const DurationCacheEntry*, int64_t);
+
+    DurationAnalysisClient();
+
+    void workerLoop();
+    void storeResult(const char* coreName, const DurationCacheKey& key, const DurationCacheEntry& entry, int64_t analysisNs);
+
+    LookupFn hostLookup = nullptr;
+    StoreFn hostStore = nullptr;
+
+    std::mutex mutex;
+    std::condition_variable wakeCv;
+    std::deque<PendingJob> queue;
+    std::set<JobKey> inFlight;
+    std::map<JobKey, LocalResult> localResults;
+    uint64_t useCounter = 0;
+    std::vector<std::thread> workers;
+    bool stopping = false;
+};
+
+#endif // SILICONPLAYER_DURATION_ANALYSIS_CLIENT_H
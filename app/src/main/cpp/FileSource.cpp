@@ -0,0 +1,163 @@
+#include "FileSource.h"
+
+#include <android/log.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+
+#define LOG_TAG "FileSource"
+#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
+
+namespace {
+// Below this a mapping costs more (VMA setup, a fault, munmap) than one read.
+constexpr size_t kMinMappedBytes = 16 * 1024;
+constexpr size_t kReadChunkBytes = 16 * 1024;
+
+struct CacheEntry {
+    std::weak_ptr<const FileSource> source;
+    size_t size = 0;
+    timespec mtime {};
+};
+
+std::mutex cacheMutex;
+std::unordered_map<std::string, CacheEntry> cache;
+
+bool sameTime(const timespec& a, const timespec& b) {
+    return a.tv_sec == b.tv_sec && a.tv_nsec == b.tv_nsec;
+}
+
+bool readAll(int fd, size_t expectedSize, std::vector<uint8_t>& out) {
+    out.clear();
+    if (expectedSize > 0) {
+        out.resize(expectedSize);
+        size_t offset = 0;
+        while (offset < expectedSize) {
+            const ssize_t count = pread(fd, out.data() + offset, expectedSize - offset, static_cast<off_t>(offset));
+            if (count < 0 && errno == EINTR) {
+                continue;
+            }
+            if (count <= 0) {
+                break;
+            }
+            offset += static_cast<size_t>(count);
+        }
+        out.resize(offset);
+        return offset == expectedSize;
+    }
+
+    // Size unknown (not a regular file): read to EOF.
+    uint8_t chunk[kReadChunkBytes];
+    while (true) {
+        const ssize_t count = read(fd, chunk, sizeof(chunk));
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count < 0) {
+            return false;
+        }
+        if (count == 0) {
+            return true;
+        }
+        out.insert(out.end(), chunk, chunk + count);
+    }
+}
+}
+
+std::shared_ptr<const FileSource> FileSource::open(const std::string& path) {
+    if (path.empty()) {
+        return nullptr;
+    }
+
+    struct stat info {};
+    const bool statted = stat(path.c_str(), &info) == 0 && S_ISREG(info.st_mode);
+    if (statted) {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        const auto it = cache.find(path);
+        if (it != cache.end()) {
+            auto shared = it->second.source.lock();
+            if (shared &&
+                it->second.size == static_cast<size_t>(info.st_size) &&
+                sameTime(it->second.mtime, info.st_mtim)) {
+                return shared;
+            }
+        }
+    }
+
+    // Load outside the lock; a concurrent open of the same file may load it
+    // twice, and the first one cached wins.
+    size_t fileSize = 0;
+    timespec mtime {};
+    std::shared_ptr<const FileSource> source = load(path, fileSize, mtime);
+    if (!source || fileSize == 0) {
+        return source;
+    }
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    for (auto it = cache.begin(); it != cache.end();) {
+        it = it->second.source.expired() ? cache.erase(it) : std::next(it);
+    }
+    CacheEntry& entry = cache[path];
+    auto existing = entry.source.lock();
+    if (existing && entry.size == fileSize && sameTime(entry.mtime, mtime)) {
+        return existing;
+    }
+    entry.source = source;
+    entry.size = fileSize;
+    entry.mtime = mtime;
+    return source;
+}
+
+std::shared_ptr<const FileSource> FileSource::load(const std::string& path, size_t& fileSize, timespec& mtime) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    std::shared_ptr<FileSource> source(new FileSource());
+    struct stat info {};
+    const bool regular = fstat(fd, &info) == 0 && S_ISREG(info.st_mode);
+    const size_t regularSize = regular ? static_cast<size_t>(info.st_size) : 0;
+    if (regular) {
+        fileSize = regularSize;
+        mtime = info.st_mtim;
+    }
+
+    if (regularSize >= kMinMappedBytes) {
+        void* mapping = mmap(nullptr, regularSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+            // Every caller parses the whole file right away.
+            madvise(mapping, regularSize, MADV_WILLNEED);
+            source->bytes = static_cast<const uint8_t*>(mapping);
+            source->length = regularSize;
+            source->mapped = true;
+        } else {
+            LOGD("mmap failed for %s (%s), reading instead", path.c_str(), std::strerror(errno));
+        }
+    }
+    if (!source->mapped) {
+        if (!readAll(fd, regularSize, source->heapCopy)) {
+            source->heapCopy.clear();
+        }
+        source->bytes = source->heapCopy.data();
+        source->length = source->heapCopy.size();
+    }
+    close(fd);
+
+    if (source->length == 0) {
+        return nullptr;
+    }
+    return source;
+}
+
+FileSource::~FileSource() {
+    if (mapped) {
+        munmap(const_cast<uint8_t*>(bytes), length);
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef SILICONPLAYER_FILE_SOURCE_H
+#define SILICONPLAYER_FILE_SOURCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Read-only contents of a whole file, for decoders that parse from memory.
+//
+// Regular files are mapped PROT_READ/MAP_PRIVATE, so the bytes are page cache
+// pages shared with every other reader instead of a private heap copy. Small
+// files, and files the kernel refuses to map (some FUSE and content-provider
+// backed paths), are read into the heap instead; callers cannot tell the
+// difference.
+//
+// open() returns a shared instance while any holder is alive and the file's
+// size and mtime are unchanged, so the playing decoder, a preloaded next
+// track and duration analysis jobs on the same file share one mapping. The
+// cache is per copy of this file: each decoder plugin has its own.
+class FileSource {
+public:
+    // nullptr if the file cannot be read or is empty.
+    static std::shared_ptr<const FileSource> open(const std::string& path);
+
+    ~FileSource();
+
+    FileSource(const FileSource&) = delete;
+    FileSource& operator=(const FileSource&) = delete;
+
+    const uint8_t* data() const { return bytes; }
+    size_t size() const { return length; }
+    bool isMapped() const { return mapped; }
+
+private:
+    FileSource() = default;
+
+    static std::shared_ptr<const FileSource> load(const std::string& path, size_t& fileSize, timespec& mtime);
+
+    const uint8_t* bytes = nullptr;
+    size_t length = 0;
+    bool mapped = false;
+    std::vector<uint8_t> heapCopy;
+};
+
+#endif // SILICONPLAYER_FILE_SOURCE_H
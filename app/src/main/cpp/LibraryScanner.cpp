@@ -0,0 +1,268 @@
+#include "LibraryScanner.h"
+
+#include "ParallelWorkPool.h"
+
+#include <android/log.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <system_error>
+#include <utility>
+
+#define LOG_TAG "LibraryScanner"
+#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
+
+namespace {
+constexpr int kMaxWorkerThreads = 8;
+// Same background priority as the duration analysis workers.
+constexpr int kWorkerNice = 10;
+// Files handed to the workers per walker lock.
+constexpr size_t kWalkBatch = 64;
+// How far past the queue head a worker looks for a file whose core still has
+// a free probe slot before it waits.
+constexpr size_t kTakeWindow = 256;
+}
+
+LibraryScanner& LibraryScanner::getInstance() {
+    static LibraryScanner instance;
+    return instance;
+}
+
+LibraryScanner::~LibraryScanner() {
+    cancel();
+}
+
+bool LibraryScanner::start(const std::string& rootPath, int workerThreads) {
+    std::unique_lock<std::mutex> lock(mutex);
+    stopLocked(lock);
+
+    std::error_code error;
+    if (rootPath.empty() || !std::filesystem::is_directory(rootPath, error)) {
+        return false;
+    }
+
+    const int threadCount = std::clamp(
+            workerThreads > 0 ? workerThreads : ParallelWorkPool::performanceCoreCount(),
+            1,
+            kMaxWorkerThreads
+    );
+    stopping = false;
+    walking = true;
+    liveWorkers = threadCount;
+    pending.clear();
+    activeProbesByCore.clear();
+    coreLimits.clear();
+    results.clear();
+    progress = Progress {};
+    progress.running = true;
+
+    LOGD("Library scan started: %s threads=%d", rootPath.c_str(), threadCount);
+    walker = std::thread(&LibraryScanner::walkerLoop, this, rootPath);
+    workers.reserve(static_cast<size_t>(threadCount));
+    for (int i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&LibraryScanner::workerLoop, this);
+    }
+    return true;
+}
+
+void LibraryScanner::cancel() {
+    std::unique_lock<std::mutex> lock(mutex);
+    stopLocked(lock);
+}
+
+void LibraryScanner::stopLocked(std::unique_lock<std::mutex>& lock) {
+    stopping = true;
+    pending.clear();
+    std::thread walkerThread = std::move(walker);
+    std::vector<std::thread> workerThreads = std::move(workers);
+    workers.clear();
+    lock.unlock();
+    wakeCv.notify_all();
+    // Probes already running finish first; the decoders cannot be interrupted.
+    if (walkerThread.joinable()) {
+        walkerThread.join();
+    }
+    for (auto& worker : workerThreads) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    lock.lock();
+    progress.running = false;
+}
+
+void LibraryScanner::poll(std::vector<DecoderProbeResult>& out, size_t maxResults) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const size_t count = std::min(maxResults, results.size());
+    out.reserve(out.size() + count);
+    for (size_t i = 0; i < count; ++i) {
+        out.push_back(std::move(results.front()));
+        results.pop_front();
+    }
+}
+
+LibraryScanner::Progress LibraryScanner::getProgress() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return progress;
+}
+
+void LibraryScanner::walkerLoop(std::string rootPath) {
+    setpriority(PRIO_PROCESS, static_cast<id_t>(gettid()), kWorkerNice);
+    DecoderRegistry& registry = DecoderRegistry::getInstance();
+    std::vector<PendingFile> batch;
+    batch.reserve(kWalkBatch);
+
+    const auto flush = [this, &batch]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping) {
+            return false;
+        }
+        for (auto& file : batch) {
+            pending.push_back(std::move(file));
+        }
+        progress.queued += batch.size();
+        batch.clear();
+        wakeCv.notify_all();
+        return true;
+    };
+
+    std::error_code error;
+    auto it = std::filesystem::recursive_directory_iterator(
+            rootPath,
+            std::filesystem::directory_options::skip_permission_denied,
+            error
+    );
+    for (; !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+        std::error_code typeError;
+        if (!it->is_regular_file(typeError)) {
+            continue;
+        }
+        std::string path = it->path().string();
+        // Files no enabled decoder claims are not part of the library.
+        std::string decoderName;
+        std::string coreName;
+        registry.resolveDecoderNames(path.c_str(), decoderName, coreName);
+        if (decoderName.empty()) {
+            continue;
+        }
+        batch.push_back(PendingFile { std::move(path), std::move(coreName) });
+        if (batch.size() >= kWalkBatch && !flush()) {
+            return;
+        }
+    }
+    if (error) {
+        LOGD("Library scan walk stopped at %s: %s", rootPath.c_str(), error.message().c_str());
+    }
+    flush();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    walking = false;
+    wakeCv.notify_all();
+}
+
+void LibraryScanner::workerLoop() {
+    setpriority(PRIO_PROCESS, static_cast<id_t>(gettid()), kWorkerNice);
+    DecoderRegistry& registry = DecoderRegistry::getInstance();
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        PendingFile file;
+        if (!takeFileLocked(file)) {
+            if (!walking && pending.empty()) {
+                break;
+            }
+            wakeCv.wait(lock);
+            continue;
+        }
+
+        // takeFileLocked() counted the file against its first candidate.
+        std::string heldCore = std::move(file.coreName);
+        lock.unlock();
+        DecoderProbeResult result = registry.probe(
+                file.path.c_str(),
+                [this, &heldCore](const std::string& decoderName) { return moveProbeSlot(heldCore, decoderName); }
+        );
+        lock.lock();
+
+        releaseProbeSlotLocked(heldCore);
+        if (stopping) {
+            break;
+        }
+        progress.probed += 1;
+        if (result.status != DecoderProbeResult::Status::Ok) {
+            progress.failed += 1;
+        }
+        results.push_back(std::move(result));
+    }
+
+    liveWorkers -= 1;
+    if (liveWorkers == 0 && !stopping) {
+        progress.running = false;
+        LOGD("Library scan finished: probed=%llu failed=%llu",
+             static_cast<unsigned long long>(progress.probed),
+             static_cast<unsigned long long>(progress.failed));
+    }
+}
+
+bool LibraryScanner::takeFileLocked(PendingFile& file) {
+    const size_t window = std::min(pending.size(), kTakeWindow);
+    for (size_t i = 0; i < window; ++i) {
+        const std::string& coreName = pending[i].coreName;
+        if (!coreName.empty()) {
+            const int limit = coreLimitLocked(coreName);
+            int& active = activeProbesByCore[coreName];
+            if (limit > 0 && active >= limit) {
+                continue;
+            }
+            active += 1;
+        }
+        file = std::move(pending[i]);
+        pending.erase(pending.begin() + static_cast<std::ptrdiff_t>(i));
+        return true;
+    }
+    return false;
+}
+
+bool LibraryScanner::moveProbeSlot(std::string& heldCore, const std::string& coreName) {
+    if (coreName == heldCore) {
+        return true;
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    // Released before waiting, so no worker holds one slot while it waits
+    // for another.
+    releaseProbeSlotLocked(heldCore);
+    const int limit = coreLimitLocked(coreName);
+    wakeCv.wait(lock, [this, &coreName, limit]() {
+        return stopping || limit <= 0 || activeProbesByCore[coreName] < limit;
+    });
+    if (stopping) {
+        return false;
+    }
+    activeProbesByCore[coreName] += 1;
+    heldCore = coreName;
+    return true;
+}
+
+void LibraryScanner::releaseProbeSlotLocked(std::string& heldCore) {
+    if (heldCore.empty()) {
+        return;
+    }
+    activeProbesByCore[heldCore] -= 1;
+    heldCore.clear();
+    // A core slot opened up for files other workers had to pass over.
+    wakeCv.notify_all();
+}
+
+int LibraryScanner::coreLimitLocked(const std::string& coreName) {
+    const auto it = coreLimits.find(coreName);
+    if (it != coreLimits.end()) {
+        return it->second;
+    }
+    DecoderStaticInfo staticInfo;
+    const int limit = DecoderRegistry::getInstance().getDecoderStaticInfo(coreName, staticInfo)
+            ? staticInfo.maxConcurrentProbes
+            : 0;
+    coreLimits.emplace(coreName, limit);
+    return limit;
+}
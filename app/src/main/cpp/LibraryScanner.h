@@ -0,0 +1,89 @@
+#ifndef SILICONPLAYER_LIBRARY_SCANNER_H
+#define SILICONPLAYER_LIBRARY_SCANNER_H
+
+#include "decoders/DecoderRegistry.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Background metadata scan of a directory tree.
+//
+// A walker thread lists the tree and queues every file some enabled decoder
+// claims; a bounded pool of low-priority workers runs DecoderRegistry::probe()
+// on them. Each core's concurrent probes are capped by its
+// DecoderStaticInfo::maxConcurrentProbes, so a worker whose next file belongs
+// to a saturated core takes a file for another core instead. Files are queued
+// under their first probe candidate; when probe() falls through to another
+// core, the worker moves its slot there and waits if that core is saturated.
+// Finished probes collect in a buffer the app drains in batches with poll().
+//
+// One scan at a time; start() cancels the previous one.
+//
+// Not part of the app library yet: there is no library database for its
+// results to feed, so only siliconplayer_library_scan_bench builds it. The
+// app reads single tracks through DecoderRegistry::probe() (probeTrack).
+class LibraryScanner {
+public:
+    struct Progress {
+        uint64_t queued = 0;
+        uint64_t probed = 0;
+        uint64_t failed = 0;
+        bool running = false;
+    };
+
+    static LibraryScanner& getInstance();
+
+    ~LibraryScanner();
+
+    LibraryScanner(const LibraryScanner&) = delete;
+    LibraryScanner& operator=(const LibraryScanner&) = delete;
+
+    // workerThreads <= 0 picks the performance core count.
+    bool start(const std::string& rootPath, int workerThreads);
+    void cancel();
+
+    // Moves up to maxResults finished probes into out, oldest first.
+    void poll(std::vector<DecoderProbeResult>& out, size_t maxResults);
+    Progress getProgress();
+
+private:
+    struct PendingFile {
+        std::string path;
+        std::string coreName;
+    };
+
+    LibraryScanner() = default;
+
+    void stopLocked(std::unique_lock<std::mutex>& lock);
+    void walkerLoop(std::string rootPath);
+    void workerLoop();
+    bool takeFileLocked(PendingFile& file);
+    // Moves the worker's probe slot from heldCore to coreName; false when the
+    // scan stops while it waits for a free slot.
+    bool moveProbeSlot(std::string& heldCore, const std::string& coreName);
+    void releaseProbeSlotLocked(std::string& heldCore);
+    int coreLimitLocked(const std::string& coreName);
+
+    std::mutex mutex;
+    std::condition_variable wakeCv;
+    std::thread walker;
+    std::vector<std::thread> workers;
+    bool stopping = false;
+    bool walking = false;
+    int liveWorkers = 0;
+
+    std::deque<PendingFile> pending;
+    std::unordered_map<std::string, int> activeProbesByCore;
+    std::unordered_map<std::string, int> coreLimits;
+    std::deque<DecoderProbeResult> results;
+    Progress progress;
+};
+
+#endif // SILICONPLAYER_LIBRARY_SCANNER_H
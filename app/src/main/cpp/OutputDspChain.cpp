@@ -0,0 +1,497 @@
+#include "OutputDspChain.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define SILICONPLAYER_OUTPUT_DSP_NEON 1
+#elif defined(__SSE2__) || defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SILICONPLAYER_OUTPUT_DSP_SSE 1
+#endif
+
+#if defined(SILICONPLAYER_OUTPUT_DSP_NEON) || defined(SILICONPLAYER_OUTPUT_DSP_SSE)
+#define SILICONPLAYER_OUTPUT_DSP_SIMD 1
+#endif
+
+namespace {
+    constexpr float kDspBusPreGain = 0.5623413f; // -5.0 dB
+    constexpr float kDspBusMakeupGain = 1.5848932f; // +4.0 dB (net: -1.0 dB)
+    constexpr float kDspBusKneeThreshold = 0.90f;
+    constexpr float kLimiterAttack = 0.45f;
+    constexpr float kLimiterRelease = 0.04f;
+    constexpr float kLimiterSoftClipStart = 0.92f;
+    constexpr float kLimiterSoftClipDrive = 1.45f;
+    constexpr float kLookaheadKneeThreshold = 0.86f;
+
+    using ScaleArgs = OutputDspChain::ScaleArgs;
+    using ShapeArgs = OutputDspChain::ShapeArgs;
+    using ScaleKernel = OutputDspChain::ScaleKernel;
+    using ShapeKernel = OutputDspChain::ShapeKernel;
+
+    int64_t steadyNowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()
+        ).count();
+    }
+
+    inline float clampUnit(float sample) {
+        return std::clamp(sample, -1.0f, 1.0f);
+    }
+
+    inline float softKnee(float sample, float threshold) {
+        const float absSample = std::abs(sample);
+        if (absSample <= threshold) {
+            return sample;
+        }
+        const float kneeWidth = 1.0f - threshold;
+        const float sign = sample < 0.0f ? -1.0f : 1.0f;
+        const float over = (absSample - threshold) / kneeWidth;
+        return sign * (threshold + (kneeWidth * (1.0f - std::exp(-over))));
+    }
+
+    inline float limiterSoftClip(float sample) {
+        static const float tanhNorm = std::tanh(kLimiterSoftClipDrive);
+        if (std::abs(sample) <= kLimiterSoftClipStart) {
+            return sample;
+        }
+        return std::tanh(sample * kLimiterSoftClipDrive) / tanhNorm;
+    }
+
+#if defined(SILICONPLAYER_OUTPUT_DSP_NEON)
+    using Vec = float32x4_t;
+    inline Vec load(const float* p) { return vld1q_f32(p); }
+    inline void store(float* p, Vec v) { vst1q_f32(p, v); }
+    inline Vec splat(float v) { return vdupq_n_f32(v); }
+    inline Vec set4(float a, float b, float c, float d) {
+        const float values[4] = { a, b, c, d };
+        return vld1q_f32(values);
+    }
+    inline Vec mul(Vec a, Vec b) { return vmulq_f32(a, b); }
+    inline Vec add(Vec a, Vec b) { return vaddq_f32(a, b); }
+    inline Vec vmax(Vec a, Vec b) { return vmaxq_f32(a, b); }
+    inline Vec vabs(Vec a) { return vabsq_f32(a); }
+    inline Vec clampUnit(Vec a) { return vminq_f32(vmaxq_f32(a, vdupq_n_f32(-1.0f)), vdupq_n_f32(1.0f)); }
+    // (l0, r0, l1, r1) -> (r0, l0, r1, l1)
+    inline Vec swapPairs(Vec a) { return vrev64q_f32(a); }
+    inline bool anyGreater(Vec a, Vec b) {
+        const uint32x4_t mask = vcgtq_f32(a, b);
+        const uint32x2_t folded = vorr_u32(vget_low_u32(mask), vget_high_u32(mask));
+        return (vget_lane_u32(folded, 0) | vget_lane_u32(folded, 1)) != 0u;
+    }
+    // (g0, g1) -> (g0, g0, g1, g1)
+    inline Vec loadFrameGainPair(const float* gains) {
+        const float32x2_t pair = vld1_f32(gains);
+        const float32x2x2_t zipped = vzip_f32(pair, pair);
+        return vcombine_f32(zipped.val[0], zipped.val[1]);
+    }
+    inline void storePcm16(int16_t* out, Vec scaled) {
+        vst1_s16(out, vqmovn_s32(vcvtq_s32_f32(scaled)));
+    }
+#elif defined(SILICONPLAYER_OUTPUT_DSP_SSE)
+    using Vec = __m128;
+    inline Vec load(const float* p) { return _mm_loadu_ps(p); }
+    inline void store(float* p, Vec v) { _mm_storeu_ps(p, v); }
+    inline Vec splat(float v) { return _mm_set1_ps(v); }
+    inline Vec set4(float a, float b, float c, float d) { return _mm_setr_ps(a, b, c, d); }
+    inline Vec mul(Vec a, Vec b) { return _mm_mul_ps(a, b); }
+    inline Vec add(Vec a, Vec b) { return _mm_add_ps(a, b); }
+    inline Vec vmax(Vec a, Vec b) { return _mm_max_ps(a, b); }
+    inline Vec vabs(Vec a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    inline Vec clampUnit(Vec a) { return _mm_min_ps(_mm_max_ps(a, _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f)); }
+    inline Vec swapPairs(Vec a) { return _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)); }
+    inline bool anyGreater(Vec a, Vec b) { return _mm_movemask_ps(_mm_cmpgt_ps(a, b)) != 0; }
+    inline Vec loadFrameGainPair(const float* gains) {
+        const __m128 pair = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(gains)));
+        return _mm_unpacklo_ps(pair, pair);
+    }
+    inline void storePcm16(int16_t* out, Vec scaled) {
+        const __m128i words = _mm_cvttps_epi32(scaled);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_packs_epi32(words, words));
+    }
+#endif
+
+#if defined(SILICONPLAYER_OUTPUT_DSP_SIMD)
+    // Runs a scalar fix-up over the four lanes of v.
+    template <typename Fn>
+    inline Vec mapLanes(Vec v, Fn fn) {
+        float lanes[4];
+        store(lanes, v);
+        for (float& lane : lanes) {
+            lane = fn(lane);
+        }
+        return load(lanes);
+    }
+#endif
+
+    // Gain (optionally ramped) x routing, then optionally the DSP bus
+    // pre-gain and knee, mono downmix and peak measurement, in one pass.
+    // The ramp reaches the target gain on the last frame of the chunk.
+    template <bool Ramp, bool Stereo, bool PreClip, bool Mono, bool Peak>
+    float scaleKernel(float* buffer, const ScaleArgs& args) {
+        static_assert(Stereo || !Mono, "mono downmix needs stereo input");
+        constexpr int channels = Stereo ? 2 : 1;
+        const int samples = args.frames * channels;
+        float peak = 0.0f;
+        int i = 0;
+#if defined(SILICONPLAYER_OUTPUT_DSP_SIMD)
+        const Vec start = Stereo
+                ? set4(args.startLeft, args.startRight, args.startLeft, args.startRight)
+                : splat(args.startLeft);
+        const Vec step = Stereo
+                ? set4(args.stepLeft, args.stepRight, args.stepLeft, args.stepRight)
+                : splat(args.stepLeft);
+        Vec frameIndex = Stereo ? set4(1.0f, 1.0f, 2.0f, 2.0f) : set4(1.0f, 2.0f, 3.0f, 4.0f);
+        const Vec frameAdvance = splat(Stereo ? 2.0f : 4.0f);
+        const Vec preGain = splat(kDspBusPreGain);
+        const Vec kneeThreshold = splat(kDspBusKneeThreshold);
+        const Vec half = splat(0.5f);
+        Vec peakVec = splat(0.0f);
+        for (; i + 4 <= samples; i += 4) {
+            Vec gain = start;
+            if constexpr (Ramp) {
+                gain = add(start, mul(step, frameIndex));
+                frameIndex = add(frameIndex, frameAdvance);
+            }
+            Vec x = mul(load(buffer + i), gain);
+            if constexpr (PreClip) {
+                x = mul(x, preGain);
+                if (anyGreater(vabs(x), kneeThreshold)) {
+                    x = mapLanes(x, [](float s) { return softKnee(s, kDspBusKneeThreshold); });
+                }
+                x = clampUnit(x);
+            }
+            if constexpr (Mono) {
+                x = mul(add(x, swapPairs(x)), half);
+            }
+            if constexpr (Peak) {
+                peakVec = vmax(peakVec, vabs(x));
+            }
+            store(buffer + i, x);
+        }
+        if constexpr (Peak) {
+            float lanes[4];
+            store(lanes, peakVec);
+            peak = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+        }
+#endif
+        for (int frame = i / channels; frame < args.frames; ++frame) {
+            float* out = buffer + static_cast<size_t>(frame) * channels;
+            const float position = static_cast<float>(frame + 1);
+            for (int channel = 0; channel < channels; ++channel) {
+                float gain = channel == 0 ? args.startLeft : args.startRight;
+                if constexpr (Ramp) {
+                    gain += (channel == 0 ? args.stepLeft : args.stepRight) * position;
+                }
+                float sample = out[channel] * gain;
+                if constexpr (PreClip) {
+                    sample = clampUnit(softKnee(sample * kDspBusPreGain, kDspBusKneeThreshold));
+                }
+                out[channel] = sample;
+            }
+            if constexpr (Mono) {
+                const float mono = (out[0] + out[1]) * 0.5f;
+                out[0] = mono;
+                out[1] = mono;
+            }
+            if constexpr (Peak) {
+                for (int channel = 0; channel < channels; ++channel) {
+                    peak = std::max(peak, std::abs(out[channel]));
+                }
+            }
+        }
+        return peak;
+    }
+
+    template <bool Ramp, bool Stereo>
+    ScaleKernel selectScaleKernel(bool preClip, bool mono, bool peak) {
+        if constexpr (Stereo) {
+            const int index = (preClip ? 4 : 0) | (mono ? 2 : 0) | (peak ? 1 : 0);
+            switch (index) {
+                case 0: return scaleKernel<Ramp, true, false, false, false>;
+                case 1: return scaleKernel<Ramp, true, false, false, true>;
+                case 2: return scaleKernel<Ramp, true, false, true, false>;
+                case 3: return scaleKernel<Ramp, true, false, true, true>;
+                case 4: return scaleKernel<Ramp, true, true, false, false>;
+                case 5: return scaleKernel<Ramp, true, true, false, true>;
+                case 6: return scaleKernel<Ramp, true, true, true, false>;
+                default: return scaleKernel<Ramp, true, true, true, true>;
+            }
+        } else {
+            const int index = (preClip ? 2 : 0) | (peak ? 1 : 0);
+            switch (index) {
+                case 0: return scaleKernel<Ramp, false, false, false, false>;
+                case 1: return scaleKernel<Ramp, false, false, false, true>;
+                case 2: return scaleKernel<Ramp, false, true, false, false>;
+                default: return scaleKernel<Ramp, false, true, false, true>;
+            }
+        }
+    }
+
+    // Limiter gain + soft clip, then the lookahead delay and its knee. Every
+    // sample leaves clamped to [-1, 1].
+    template <bool Limit, int ClipMode>
+    void shapeSpan(float* buffer, float* delay, size_t count, float limiterGain) {
+        size_t i = 0;
+#if defined(SILICONPLAYER_OUTPUT_DSP_SIMD)
+        const Vec gain = splat(limiterGain);
+        const Vec limiterStart = splat(kLimiterSoftClipStart);
+        const Vec lookaheadKnee = splat(kLookaheadKneeThreshold);
+        for (; i + 4 <= count; i += 4) {
+            Vec x = load(buffer + i);
+            if constexpr (Limit) {
+                x = mul(x, gain);
+                if (anyGreater(vabs(x), limiterStart)) {
+                    x = mapLanes(x, limiterSoftClip);
+                }
+                x = clampUnit(x);
+            }
+            if constexpr (ClipMode > 0) {
+                const Vec delayed = load(delay + i);
+                store(delay + i, x);
+                x = delayed;
+                if constexpr (ClipMode == 1) {
+                    if (anyGreater(vabs(x), lookaheadKnee)) {
+                        x = mapLanes(x, [](float s) { return softKnee(s, kLookaheadKneeThreshold); });
+                    }
+                }
+                x = clampUnit(x);
+            }
+            store(buffer + i, x);
+        }
+#endif
+        for (; i < count; ++i) {
+            float sample = buffer[i];
+            if constexpr (Limit) {
+                sample = clampUnit(limiterSoftClip(sample * limiterGain));
+            }
+            if constexpr (ClipMode > 0) {
+                const float delayed = delay[i];
+                delay[i] = sample;
+                sample = delayed;
+                if constexpr (ClipMode == 1) {
+                    sample = softKnee(sample, kLookaheadKneeThreshold);
+                }
+                sample = clampUnit(sample);
+            }
+            buffer[i] = sample;
+        }
+    }
+
+    template <bool Limit, int ClipMode>
+    void shapeKernel(float* buffer, size_t samples, const ShapeArgs& args) {
+        if constexpr (ClipMode == 0) {
+            shapeSpan<Limit, 0>(buffer, nullptr, samples, args.limiterGain);
+        } else {
+            // Walk the delay ring in contiguous spans so the kernel never
+            // wraps mid-vector.
+            size_t done = 0;
+            size_t writeIndex = *args.writeIndex;
+            while (done < samples) {
+                const size_t span = std::min(samples - done, args.delaySamples - writeIndex);
+                shapeSpan<Limit, ClipMode>(buffer + done, args.delayLine + writeIndex, span, args.limiterGain);
+                done += span;
+                writeIndex += span;
+                if (writeIndex == args.delaySamples) {
+                    writeIndex = 0;
+                }
+            }
+            *args.writeIndex = writeIndex;
+        }
+    }
+
+    ShapeKernel selectShapeKernel(bool limit, int clipMode) {
+        switch (clipMode) {
+            case 1: return limit ? shapeKernel<true, 1> : shapeKernel<false, 1>;
+            case 2: return limit ? shapeKernel<true, 2> : shapeKernel<false, 2>;
+            default: return limit ? shapeKernel<true, 0> : nullptr;
+        }
+    }
+}
+
+OutputDspChain::OutputDspChain() {
+    configure(OutputDspSettings {});
+}
+
+void OutputDspChain::configure(const OutputDspSettings& nextSettings) {
+    const bool limiterWasEnabled = settings.limiterEnabled;
+    settings = nextSettings;
+    settings.lookaheadClipperMode = std::clamp(settings.lookaheadClipperMode, 0, 2);
+
+    const auto& dsp = settings.openMpt;
+    openMptActive = dsp.bassEnabled || dsp.surroundEnabled || dsp.reverbEnabled || dsp.bitCrushEnabled;
+    const bool limiter = settings.limiterEnabled;
+
+    // Without the DSP bus the front pass carries mono and the limiter peak;
+    // with it, both move behind the effect into the make-up pass.
+    const bool frontMono = settings.forceMono && !openMptActive;
+    frontNeedsPeak = limiter && !openMptActive;
+    frontHasWork = openMptActive || frontMono || frontNeedsPeak;
+    frontKernels[0][0] = selectScaleKernel<false, false>(openMptActive, false, frontNeedsPeak);
+    frontKernels[0][1] = selectScaleKernel<false, true>(openMptActive, frontMono, frontNeedsPeak);
+    frontKernels[1][0] = selectScaleKernel<true, false>(openMptActive, false, frontNeedsPeak);
+    frontKernels[1][1] = selectScaleKernel<true, true>(openMptActive, frontMono, frontNeedsPeak);
+    postKernels[0] = selectScaleKernel<false, false>(false, false, limiter);
+    postKernels[1] = selectScaleKernel<false, true>(false, settings.forceMono, limiter);
+    shapeKernel = selectShapeKernel(limiter, settings.lookaheadClipperMode);
+
+    if (!limiter || !limiterWasEnabled) {
+        limiterGain = 1.0f;
+    }
+    if (settings.lookaheadClipperMode != lookaheadMode) {
+        resetLookahead();
+        lookaheadMode = settings.lookaheadClipperMode;
+    }
+}
+
+void OutputDspChain::resetGainState() {
+    limiterGain = 1.0f;
+    appliedGainChannels = 0;
+}
+
+void OutputDspChain::resetLookahead() {
+    std::fill(lookaheadDelayLine.begin(), lookaheadDelayLine.end(), 0.0f);
+    lookaheadWriteIndex = 0;
+    lookaheadSampleRate = 0;
+    lookaheadChannels = 0;
+}
+
+int OutputDspChain::passCount() const {
+    int passes = frontHasWork ? 1 : 0;
+    if (openMptActive) {
+        passes += 1;
+    }
+    if (shapeKernel != nullptr) {
+        passes += 1;
+    }
+    return passes;
+}
+
+void OutputDspChain::prepareLookahead(int sampleRate, int channels) {
+    const int safeRate = std::max(sampleRate, 8000);
+    const int lookaheadFrames = std::clamp((safeRate * 5) / 1000, 32, 512);
+    const size_t delaySamples = static_cast<size_t>(lookaheadFrames) * static_cast<size_t>(channels);
+    if (lookaheadDelayLine.size() != delaySamples ||
+        lookaheadSampleRate != safeRate ||
+        lookaheadChannels != channels) {
+        lookaheadDelayLine.assign(delaySamples, 0.0f);
+        lookaheadWriteIndex = 0;
+        lookaheadSampleRate = safeRate;
+        lookaheadChannels = channels;
+    }
+}
+
+void OutputDspChain::process(
+        float* buffer,
+        int frames,
+        int channels,
+        int sampleRate,
+        float extraGain,
+        siliconplayer::effects::OpenMptDspEffects& openMptDsp
+) {
+    if (!buffer || frames <= 0 || channels <= 0 || channels > 2) {
+        return;
+    }
+    const bool stereo = channels == 2;
+    const size_t samples = static_cast<size_t>(frames) * static_cast<size_t>(channels);
+
+    // Routing only applies to stereo, matching the channel mute/solo UI.
+    const float baseGain = settings.gain * std::clamp(extraGain, 0.0f, 1.0f);
+    const float targetLeft = (!stereo || settings.leftEnabled) ? baseGain : 0.0f;
+    const float targetRight = (!stereo || settings.rightEnabled) ? baseGain : 0.0f;
+    if (appliedGainChannels != channels) {
+        appliedGainLeft = targetLeft;
+        appliedGainRight = targetRight;
+        appliedGainChannels = channels;
+    }
+    const bool ramp = appliedGainLeft != targetLeft || appliedGainRight != targetRight;
+    const bool unity = !ramp && targetLeft == 1.0f && targetRight == 1.0f;
+
+    passTimes = PassTimes {};
+    int64_t passStartNs = steadyNowNs();
+    float peak = 0.0f;
+    if (ramp || !unity || frontHasWork) {
+        const float invFrames = 1.0f / static_cast<float>(frames);
+        const ScaleArgs args {
+                ramp ? appliedGainLeft : targetLeft,
+                ramp ? appliedGainRight : targetRight,
+                (targetLeft - appliedGainLeft) * invFrames,
+                (targetRight - appliedGainRight) * invFrames,
+                frames,
+                channels
+        };
+        peak = frontKernels[ramp ? 1 : 0][stereo ? 1 : 0](buffer, args);
+        const int64_t passEndNs = steadyNowNs();
+        passTimes.frontNs = passEndNs - passStartNs;
+        passStartNs = passEndNs;
+    }
+    appliedGainLeft = targetLeft;
+    appliedGainRight = targetRight;
+
+    if (openMptActive) {
+        openMptDsp.process(buffer, frames, channels, sampleRate, settings.openMpt);
+        const ScaleArgs args { kDspBusMakeupGain, kDspBusMakeupGain, 0.0f, 0.0f, frames, channels };
+        peak = postKernels[stereo ? 1 : 0](buffer, args);
+        const int64_t passEndNs = steadyNowNs();
+        passTimes.openMptNs = passEndNs - passStartNs;
+        passStartNs = passEndNs;
+    }
+
+    if (shapeKernel == nullptr) {
+        return;
+    }
+    if (settings.limiterEnabled) {
+        const float targetGain = (peak > 1.0f) ? (1.0f / peak) : 1.0f;
+        const float coeff = (targetGain < limiterGain) ? kLimiterAttack : kLimiterRelease;
+        limiterGain += (targetGain - limiterGain) * coeff;
+        limiterGain = std::clamp(limiterGain, 0.1f, 1.0f);
+    }
+    if (settings.lookaheadClipperMode > 0) {
+        prepareLookahead(sampleRate, channels);
+    }
+    const ShapeArgs args {
+            limiterGain,
+            lookaheadDelayLine.data(),
+            lookaheadDelayLine.size(),
+            &lookaheadWriteIndex
+    };
+    shapeKernel(buffer, samples, args);
+    passTimes.shapeNs = steadyNowNs() - passStartNs;
+}
+
+void OutputDspChain::finishStereo(float* buffer, int frames, const float* frameGains, int16_t* pcm16) {
+    if (!buffer || frames <= 0) {
+        return;
+    }
+    int frame = 0;
+#if defined(SILICONPLAYER_OUTPUT_DSP_SIMD)
+    const Vec pcmScale = splat(32767.0f);
+    for (; frame + 2 <= frames; frame += 2) {
+        const size_t base = static_cast<size_t>(frame) * 2u;
+        Vec x = load(buffer + base);
+        if (frameGains) {
+            x = mul(x, loadFrameGainPair(frameGains + frame));
+        }
+        x = clampUnit(x);
+        if (pcm16) {
+            storePcm16(pcm16 + base, mul(x, pcmScale));
+        } else {
+            store(buffer + base, x);
+        }
+    }
+#endif
+    for (; frame < frames; ++frame) {
+        const size_t base = static_cast<size_t>(frame) * 2u;
+        const float gain = frameGains ? frameGains[frame] : 1.0f;
+        for (size_t channel = 0; channel < 2u; ++channel) {
+            const float sample = clampUnit(buffer[base + channel] * gain);
+            if (pcm16) {
+                pcm16[base + channel] = static_cast<int16_t>(sample * 32767.0f);
+            } else {
+                buffer[base + channel] = sample;
+            }
+        }
+    }
+}
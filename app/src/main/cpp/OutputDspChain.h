@@ -0,0 +1,118 @@
+#ifndef SILICONPLAYER_OUTPUT_DSP_CHAIN_H
+#define SILICONPLAYER_OUTPUT_DSP_CHAIN_H
+
+#include "effects/openmpt_dsp/OpenMptDspEffects.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Snapshot of the user settings that shape the render worker's output.
+struct OutputDspSettings {
+    float gain = 1.0f; // master x (song or plugin), linear
+    bool leftEnabled = true;
+    bool rightEnabled = true;
+    bool forceMono = false;
+    bool limiterEnabled = false;
+    int lookaheadClipperMode = 0; // 0 off, 1 soft knee, 2 hard clamp
+    siliconplayer::effects::OpenMptDspParams openMpt;
+};
+
+// Post-decode output chain of the render worker: gain, L/R routing, the
+// OpenMPT DSP bus, mono downmix, output limiter and lookahead clipper.
+//
+// configure() compiles the settings into at most three fused passes over a
+// chunk instead of one pass per stage. Gain, routing and mono downmix share
+// the first pass, which also takes the limiter peak; the OpenMPT bus splits
+// it around the effect (pre-gain and knee before, make-up gain, mono and peak
+// after); the limiter and the lookahead clipper share the last pass. Stereo
+// runs through NEON/SSE kernels, with the rare soft-knee samples finished in
+// scalar code using the same curves.
+//
+// Gain changes (master/song/plugin gain, end fade, mute/solo) ramp linearly
+// across the chunk that picks them up instead of stepping.
+//
+// Not thread-safe; owned by the render path under decoderMutex.
+class OutputDspChain {
+public:
+    OutputDspChain();
+
+    void configure(const OutputDspSettings& settings);
+    const OutputDspSettings& getSettings() const { return settings; }
+
+    // extraGain (end fade) is clamped to [0, 1] and multiplies the gain.
+    void process(
+            float* buffer,
+            int frames,
+            int channels,
+            int sampleRate,
+            float extraGain,
+            siliconplayer::effects::OpenMptDspEffects& openMptDsp
+    );
+
+    // Limiter envelope and gain ramp; the next chunk starts at its target gain.
+    void resetGainState();
+    void resetLookahead();
+
+    // Passes over the buffer per chunk for the current settings, not counting
+    // the OpenMPT effect itself.
+    int passCount() const;
+
+    // Wall time of each pass in the last process() call; 0 for skipped passes.
+    struct PassTimes {
+        int64_t frontNs = 0;
+        int64_t openMptNs = 0; // effect plus make-up pass
+        int64_t shapeNs = 0;
+    };
+    const PassTimes& lastPassTimes() const { return passTimes; }
+
+    // Output-callback tail for interleaved stereo: optional per-frame gain,
+    // clamp to [-1, 1], then either write back or convert to int16 (same
+    // truncation as static_cast<int16_t>(x * 32767)).
+    static void finishStereo(float* buffer, int frames, const float* frameGains, int16_t* pcm16);
+
+    struct ScaleArgs {
+        float startLeft;
+        float startRight;
+        float stepLeft;  // per frame
+        float stepRight;
+        int frames;
+        int channels;
+    };
+    using ScaleKernel = float (*)(float* buffer, const ScaleArgs& args);
+
+    struct ShapeArgs {
+        float limiterGain;
+        float* delayLine;
+        size_t delaySamples;
+        size_t* writeIndex;
+    };
+    using ShapeKernel = void (*)(float* buffer, size_t samples, const ShapeArgs& args);
+
+private:
+    void prepareLookahead(int sampleRate, int channels);
+
+    OutputDspSettings settings;
+    bool openMptActive = false;
+    // Kernels indexed by [ramp][stereo]; null when the pass has nothing to do
+    // for unity gain.
+    ScaleKernel frontKernels[2][2] {};
+    ScaleKernel postKernels[2] {};
+    ShapeKernel shapeKernel = nullptr;
+    bool frontNeedsPeak = false;
+    bool frontHasWork = false;
+
+    float appliedGainLeft = 1.0f;
+    float appliedGainRight = 1.0f;
+    int appliedGainChannels = 0;
+    float limiterGain = 1.0f;
+    PassTimes passTimes;
+
+    std::vector<float> lookaheadDelayLine;
+    size_t lookaheadWriteIndex = 0;
+    int lookaheadSampleRate = 0;
+    int lookaheadChannels = 0;
+    int lookaheadMode = 0;
+};
+
+#endif // SILICONPLAYER_OUTPUT_DSP_CHAIN_H
@@ -0,0 +1,191 @@
+#include "ParallelWorkPool.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+namespace {
+constexpr uint64_t kSpanLowMask = 0xFFFFFFFFull;
+
+uint64_t packSpan(uint32_t begin, uint32_t end) {
+    return (static_cast<uint64_t>(begin) << 32) | static_cast<uint64_t>(end);
+}
+
+uint32_t spanBegin(uint64_t span) {
+    return static_cast<uint32_t>(span >> 32);
+}
+
+uint32_t spanEnd(uint64_t span) {
+    return static_cast<uint32_t>(span & kSpanLowMask);
+}
+
+long readSysfsLong(const std::string& path) {
+    FILE* file = std::fopen(path.c_str(), "r");
+    if (!file) {
+        return -1;
+    }
+    long value = -1;
+    if (std::fscanf(file, "%ld", &value) != 1) {
+        value = -1;
+    }
+    std::fclose(file);
+    return value;
+}
+}
+
+ParallelWorkPool::ParallelWorkPool(int workerThreads) {
+    const int participants = std::max(0, workerThreads) + 1;
+    lanes.reserve(static_cast<size_t>(participants));
+    for (int i = 0; i < participants; ++i) {
+        lanes.push_back(std::make_unique<Lane>());
+    }
+    workers.reserve(static_cast<size_t>(participants - 1));
+    for (int i = 1; i < participants; ++i) {
+        workers.emplace_back(&ParallelWorkPool::workerLoop, this, i);
+    }
+}
+
+ParallelWorkPool::~ParallelWorkPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeCv.notify_all();
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void ParallelWorkPool::run(int taskCount, const std::function<void(int)>& task) {
+    if (taskCount <= 0) {
+        return;
+    }
+    const int participants = concurrency();
+    if (participants <= 1 || taskCount == 1) {
+        for (int i = 0; i < taskCount; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    currentTask.store(&task, std::memory_order_release);
+    pendingTasks.store(taskCount, std::memory_order_release);
+    for (int lane = 0; lane < participants; ++lane) {
+        const auto begin = static_cast<uint32_t>((static_cast<int64_t>(taskCount) * lane) / participants);
+        const auto end = static_cast<uint32_t>((static_cast<int64_t>(taskCount) * (lane + 1)) / participants);
+        lanes[static_cast<size_t>(lane)]->span.store(packSpan(begin, end), std::memory_order_release);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        generation += 1;
+    }
+    wakeCv.notify_all();
+
+    drain(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCv.wait(lock, [this]() {
+        return pendingTasks.load(std::memory_order_acquire) == 0;
+    });
+}
+
+void ParallelWorkPool::workerLoop(int laneIndex) {
+    uint64_t seenGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeCv.wait(lock, [this, seenGeneration]() {
+                return stopping || generation != seenGeneration;
+            });
+            if (stopping) {
+                return;
+            }
+            seenGeneration = generation;
+        }
+        drain(laneIndex);
+    }
+}
+
+void ParallelWorkPool::drain(int laneIndex) {
+    int taskIndex = 0;
+    while (popOwn(laneIndex, taskIndex) || stealFrom(laneIndex, taskIndex)) {
+        execute(taskIndex);
+    }
+}
+
+bool ParallelWorkPool::popOwn(int laneIndex, int& taskIndex) {
+    std::atomic<uint64_t>& span = lanes[static_cast<size_t>(laneIndex)]->span;
+    uint64_t current = span.load(std::memory_order_acquire);
+    while (spanBegin(current) < spanEnd(current)) {
+        const uint32_t begin = spanBegin(current);
+        if (span.compare_exchange_weak(
+                current,
+                packSpan(begin + 1u, spanEnd(current)),
+                std::memory_order_acq_rel,
+                std::memory_order_acquire)) {
+            taskIndex = static_cast<int>(begin);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ParallelWorkPool::stealFrom(int laneIndex, int& taskIndex) {
+    const int participants = concurrency();
+    for (int offset = 1; offset < participants; ++offset) {
+        const int victim = (laneIndex + offset) % participants;
+        std::atomic<uint64_t>& span = lanes[static_cast<size_t>(victim)]->span;
+        uint64_t current = span.load(std::memory_order_acquire);
+        while (spanBegin(current) < spanEnd(current)) {
+            const uint32_t end = spanEnd(current);
+            if (span.compare_exchange_weak(
+                    current,
+                    packSpan(spanBegin(current), end - 1u),
+                    std::memory_order_acq_rel,
+                    std::memory_order_acquire)) {
+                taskIndex = static_cast<int>(end - 1u);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void ParallelWorkPool::execute(int taskIndex) {
+    const std::function<void(int)>* task = currentTask.load(std::memory_order_acquire);
+    if (task) {
+        (*task)(taskIndex);
+    }
+    if (pendingTasks.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<std::mutex> lock(mutex);
+        doneCv.notify_all();
+    }
+}
+
+int ParallelWorkPool::performanceCoreCount() {
+    static const int cached = []() {
+        const int cpuCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        std::vector<long> capacities(static_cast<size_t>(cpuCount), -1);
+        for (int cpu = 0; cpu < cpuCount; ++cpu) {
+            const std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+            long capacity = readSysfsLong(base + "/cpu_capacity");
+            if (capacity <= 0) {
+                capacity = readSysfsLong(base + "/cpufreq/cpuinfo_max_freq");
+            }
+            capacities[static_cast<size_t>(cpu)] = capacity;
+        }
+        const long strongest = *std::max_element(capacities.begin(), capacities.end());
+        if (strongest <= 0) {
+            return cpuCount;
+        }
+        // Little cores on current big.LITTLE parts sit well under half the
+        // prime core; mid and prime cores land above it.
+        const auto count = std::count_if(capacities.begin(), capacities.end(), [strongest](long capacity) {
+            return capacity * 2 > strongest;
+        });
+        return std::max(1, static_cast<int>(count));
+    }();
+    return cached;
+}
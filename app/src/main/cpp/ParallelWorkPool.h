@@ -0,0 +1,68 @@
+#ifndef SILICONPLAYER_PARALLEL_WORK_POOL_H
+#define SILICONPLAYER_PARALLEL_WORK_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Small fork-join pool for decoder side work that splits into independent,
+// similarly sized tasks (scope shadow emulators, analysis passes).
+//
+// run() hands every participant (the workers plus the calling thread) a
+// contiguous span of task indices. Participants pop from the front of their
+// own span and, once it is empty, steal single tasks from the back of the
+// others, so a slow task does not leave the rest of its span waiting.
+//
+// One run() at a time; callers serialize (each owner keeps its own pool).
+class ParallelWorkPool {
+public:
+    // workerThreads extra threads are started; the caller of run() is the
+    // remaining participant, so 0 runs everything inline.
+    explicit ParallelWorkPool(int workerThreads);
+    ~ParallelWorkPool();
+
+    ParallelWorkPool(const ParallelWorkPool&) = delete;
+    ParallelWorkPool& operator=(const ParallelWorkPool&) = delete;
+
+    int concurrency() const { return static_cast<int>(lanes.size()); }
+
+    // Runs task(index) for every index in [0, taskCount) and returns once all
+    // of them finished.
+    void run(int taskCount, const std::function<void(int)>& task);
+
+    // Cores worth scheduling parallel work on: the big/prime cluster on
+    // heterogeneous SoCs (by cpu_capacity or max frequency), otherwise all.
+    static int performanceCoreCount();
+
+private:
+    struct alignas(64) Lane {
+        // begin in the high half, end in the low half, so owner pops and
+        // thief steals race on one word.
+        std::atomic<uint64_t> span { 0 };
+    };
+
+    void workerLoop(int laneIndex);
+    void drain(int laneIndex);
+    bool popOwn(int laneIndex, int& taskIndex);
+    bool stealFrom(int laneIndex, int& taskIndex);
+    void execute(int taskIndex);
+
+    std::vector<std::unique_ptr<Lane>> lanes;
+    std::vector<std::thread> workers;
+
+    std::atomic<const std::function<void(int)>*> currentTask { nullptr };
+    std::atomic<int> pendingTasks { 0 };
+
+    std::mutex mutex;
+    std::condition_variable wakeCv;
+    std::condition_variable doneCv;
+    uint64_t generation = 0;
+    bool stopping = false;
+};
+
+#endif // SILICONPLAYER_PARALLEL_WORK_POOL_H
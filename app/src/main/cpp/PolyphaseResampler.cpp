@@ -0,0 +1,379 @@
+#include "PolyphaseResampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <numeric>
+#include <utility>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define SILICONPLAYER_RESAMPLER_NEON 1
+#elif defined(__SSE__) || defined(__x86_64__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define SILICONPLAYER_RESAMPLER_SSE 1
+#endif
+
+namespace {
+    constexpr int kBaseTaps = 64;
+    constexpr int kMaxTaps = 256;
+    constexpr int kMaxExactRows = 512;
+    constexpr int kInterpolatedRowBits = 9;
+    constexpr int kInterpolatedRows = 1 << kInterpolatedRowBits;
+    constexpr int kInterpolatedWeightBits = 32 - kInterpolatedRowBits;
+    constexpr double kPassbandFraction = 0.95;
+    constexpr double kKaiserBeta = 8.0;
+    constexpr size_t kMaxCachedTables = 8;
+    constexpr int kMaxChannels = 8;
+    constexpr double kPi = 3.14159265358979323846;
+
+    double besselI0(double x) {
+        double sum = 1.0;
+        double term = 1.0;
+        const double halfX = x * 0.5;
+        for (int k = 1; k < 64; ++k) {
+            const double factor = halfX / k;
+            term *= factor * factor;
+            sum += term;
+            if (term < sum * 1e-12) break;
+        }
+        return sum;
+    }
+
+    int roundUpToPowerOfTwo(int value) {
+        int result = 1;
+        while (result < value) result <<= 1;
+        return result;
+    }
+
+    // Both kernels expect sampleCount to be a multiple of 8.
+    inline void dotStereo(const float* window, const float* coefficients, int sampleCount, float& left, float& right) {
+#if defined(SILICONPLAYER_RESAMPLER_NEON)
+        float32x4_t accA = vdupq_n_f32(0.0f);
+        float32x4_t accB = vdupq_n_f32(0.0f);
+        for (int i = 0; i < sampleCount; i += 8) {
+            accA = vmlaq_f32(accA, vld1q_f32(window + i), vld1q_f32(coefficients + i));
+            accB = vmlaq_f32(accB, vld1q_f32(window + i + 4), vld1q_f32(coefficients + i + 4));
+        }
+        const float32x4_t acc = vaddq_f32(accA, accB);
+        const float32x2_t pair = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+        left = vget_lane_f32(pair, 0);
+        right = vget_lane_f32(pair, 1);
+#elif defined(SILICONPLAYER_RESAMPLER_SSE)
+        __m128 accA = _mm_setzero_ps();
+        __m128 accB = _mm_setzero_ps();
+        for (int i = 0; i < sampleCount; i += 8) {
+            accA = _mm_add_ps(accA, _mm_mul_ps(_mm_loadu_ps(window + i), _mm_loadu_ps(coefficients + i)));
+            accB = _mm_add_ps(accB, _mm_mul_ps(_mm_loadu_ps(window + i + 4), _mm_loadu_ps(coefficients + i + 4)));
+        }
+        const __m128 acc = _mm_add_ps(accA, accB);
+        const __m128 pair = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+        left = _mm_cvtss_f32(pair);
+        right = _mm_cvtss_f32(_mm_shuffle_ps(pair, pair, _MM_SHUFFLE(1, 1, 1, 1)));
+#else
+        float sumLeft = 0.0f;
+        float sumRight = 0.0f;
+        for (int i = 0; i < sampleCount; i += 2) {
+            sumLeft += window[i] * coefficients[i];
+            sumRight += window[i + 1] * coefficients[i + 1];
+        }
+        left = sumLeft;
+        right = sumRight;
+#endif
+    }
+
+    // Expects sampleCount to be a multiple of 4.
+    inline float dotMono(const float* window, const float* coefficients, int sampleCount) {
+#if defined(SILICONPLAYER_RESAMPLER_NEON)
+        float32x4_t acc = vdupq_n_f32(0.0f);
+        for (int i = 0; i < sampleCount; i += 4) {
+            acc = vmlaq_f32(acc, vld1q_f32(window + i), vld1q_f32(coefficients + i));
+        }
+        const float32x2_t pair = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+        return vget_lane_f32(vpadd_f32(pair, pair), 0);
+#elif defined(SILICONPLAYER_RESAMPLER_SSE)
+        __m128 acc = _mm_setzero_ps();
+        for (int i = 0; i < sampleCount; i += 4) {
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(window + i), _mm_loadu_ps(coefficients + i)));
+        }
+        const __m128 pair = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+        return _mm_cvtss_f32(_mm_add_ss(pair, _mm_shuffle_ps(pair, pair, _MM_SHUFFLE(1, 1, 1, 1))));
+#else
+        float sum = 0.0f;
+        for (int i = 0; i < sampleCount; ++i) {
+            sum += window[i] * coefficients[i];
+        }
+        return sum;
+#endif
+    }
+}
+
+struct PolyphaseResampler::CoefficientTable {
+    int taps = 0;
+    int rows = 0;
+    bool exact = false;
+    uint64_t phaseDenominator = 0; // exact: reduced output rate, interpolated: 2^32
+    int stepWhole = 0;
+    uint64_t stepFraction = 0;
+    std::vector<float> mono;   // rows * taps
+    std::vector<float> stereo; // rows * taps * 2, each tap duplicated for L/R
+};
+
+std::shared_ptr<const PolyphaseResampler::CoefficientTable> PolyphaseResampler::acquireTable(
+        int inputRate,
+        int outputRate) {
+    static std::mutex cacheMutex;
+    static std::vector<std::pair<uint64_t, std::shared_ptr<const CoefficientTable>>> cache;
+
+    const uint64_t key = (static_cast<uint64_t>(inputRate) << 32) | static_cast<uint32_t>(outputRate);
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto it = std::find_if(cache.begin(), cache.end(), [key](const auto& entry) {
+            return entry.first == key;
+        });
+        if (it != cache.end()) {
+            auto found = it->second;
+            // Keep most recently used pairs at the back.
+            std::rotate(it, it + 1, cache.end());
+            return found;
+        }
+    }
+
+    auto built = std::make_shared<CoefficientTable>();
+    const int divisor = std::gcd(inputRate, outputRate);
+    const int reducedInput = inputRate / divisor;
+    const int reducedOutput = outputRate / divisor;
+    built->exact = reducedOutput <= kMaxExactRows;
+    if (built->exact) {
+        built->rows = reducedOutput;
+        built->phaseDenominator = static_cast<uint64_t>(reducedOutput);
+        built->stepWhole = reducedInput / reducedOutput;
+        built->stepFraction = static_cast<uint64_t>(reducedInput % reducedOutput);
+    } else {
+        // One extra row so the interpolation can always read row + 1.
+        built->rows = kInterpolatedRows + 1;
+        built->phaseDenominator = 1ull << 32;
+        built->stepWhole = inputRate / outputRate;
+        built->stepFraction =
+                (static_cast<uint64_t>(inputRate % outputRate) << 32) / static_cast<uint64_t>(outputRate);
+    }
+
+    // Downsampling lowers the cutoff, so the kernel widens to keep the same
+    // transition steepness relative to the output band.
+    const double ratio = static_cast<double>(outputRate) / static_cast<double>(inputRate);
+    const double bandwidth = std::min(1.0, ratio);
+    int taps = static_cast<int>(std::ceil(kBaseTaps / bandwidth));
+    taps = std::clamp((taps + 3) & ~3, kBaseTaps, kMaxTaps);
+    built->taps = taps;
+
+    const double cutoff = 0.5 * bandwidth * kPassbandFraction; // cycles per input sample
+    const double halfWidth = taps * 0.5;
+    const double windowNorm = 1.0 / besselI0(kKaiserBeta);
+    const int centerTap = taps / 2 - 1;
+    const double rowScale = built->exact ? 1.0 / built->rows : 1.0 / kInterpolatedRows;
+
+    built->mono.resize(static_cast<size_t>(built->rows) * taps);
+    built->stereo.resize(static_cast<size_t>(built->rows) * taps * 2);
+    std::vector<double> row(static_cast<size_t>(taps));
+    for (int r = 0; r < built->rows; ++r) {
+        const double fraction = r * rowScale;
+        double sum = 0.0;
+        for (int t = 0; t < taps; ++t) {
+            const double x = (t - centerTap) - fraction;
+            const double arg = 2.0 * cutoff * x;
+            const double sinc = std::abs(arg) < 1e-12 ? 1.0 : std::sin(kPi * arg) / (kPi * arg);
+            const double normalized = std::clamp(x / halfWidth, -1.0, 1.0);
+            const double window = besselI0(kKaiserBeta * std::sqrt(1.0 - normalized * normalized)) * windowNorm;
+            row[t] = 2.0 * cutoff * sinc * window;
+            sum += row[t];
+        }
+        const double gain = sum != 0.0 ? 1.0 / sum : 1.0;
+        float* monoRow = built->mono.data() + static_cast<size_t>(r) * taps;
+        float* stereoRow = built->stereo.data() + static_cast<size_t>(r) * taps * 2;
+        for (int t = 0; t < taps; ++t) {
+            const float value = static_cast<float>(row[t] * gain);
+            monoRow[t] = value;
+            stereoRow[t * 2] = value;
+            stereoRow[t * 2 + 1] = value;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    if (cache.size() >= kMaxCachedTables) {
+        cache.erase(cache.begin());
+    }
+    cache.emplace_back(key, built);
+    return built;
+}
+
+bool PolyphaseResampler::configure(int newChannels, int newInputRate, int newOutputRate) {
+    if (newChannels <= 0 || newChannels > kMaxChannels || newInputRate <= 0 || newOutputRate <= 0) {
+        return false;
+    }
+    if (isConfiguredFor(newChannels, newInputRate, newOutputRate)) {
+        return true;
+    }
+    table = acquireTable(newInputRate, newOutputRate);
+    channels = newChannels;
+    inputRate = newInputRate;
+    outputRate = newOutputRate;
+    ringFrames = roundUpToPowerOfTwo(table->taps + kMaxPushFrames);
+    ringMask = ringFrames - 1;
+    ring.assign(static_cast<size_t>(ringFrames) * 2 * channels, 0.0f);
+    interpolationScratch.assign(static_cast<size_t>(channels) * 2, 0.0f);
+    reset();
+    return true;
+}
+
+bool PolyphaseResampler::isConfiguredFor(int queryChannels, int queryInputRate, int queryOutputRate) const {
+    return table != nullptr &&
+           channels == queryChannels &&
+           inputRate == queryInputRate &&
+           outputRate == queryOutputRate;
+}
+
+void PolyphaseResampler::reset() {
+    if (!table) return;
+    std::fill(ring.begin(), ring.end(), 0.0f);
+    readFrame = 0;
+    phase = 0;
+    // Pre-roll with silence so the first output is centered on input frame 0.
+    bufferedFrames = table->taps / 2 - 1;
+}
+
+int PolyphaseResampler::writableInputFrames() const {
+    if (!table) return 0;
+    return ringFrames - bufferedFrames;
+}
+
+int PolyphaseResampler::flushInputFrames() const {
+    return table ? table->taps / 2 : 0;
+}
+
+int PolyphaseResampler::tapCount() const {
+    return table ? table->taps : 0;
+}
+
+void PolyphaseResampler::writeRing(const float* data, int frames) {
+    int writeFrame = (readFrame + bufferedFrames) & ringMask;
+    int remaining = frames;
+    while (remaining > 0) {
+        const int span = std::min(remaining, ringFrames - writeFrame);
+        const size_t bytes = static_cast<size_t>(span) * channels * sizeof(float);
+        float* primary = ring.data() + static_cast<size_t>(writeFrame) * channels;
+        float* mirror = primary + static_cast<size_t>(ringFrames) * channels;
+        if (data != nullptr) {
+            std::memcpy(primary, data, bytes);
+            std::memcpy(mirror, data, bytes);
+            data += static_cast<size_t>(span) * channels;
+        } else {
+            std::memset(primary, 0, bytes);
+            std::memset(mirror, 0, bytes);
+        }
+        writeFrame = (writeFrame + span) & ringMask;
+        remaining -= span;
+    }
+    bufferedFrames += frames;
+}
+
+int PolyphaseResampler::pushInput(const float* data, int frames) {
+    if (!table || data == nullptr || frames <= 0) return 0;
+    const int accepted = std::min(frames, writableInputFrames());
+    if (accepted > 0) writeRing(data, accepted);
+    return accepted;
+}
+
+int PolyphaseResampler::pushSilence(int frames) {
+    if (!table || frames <= 0) return 0;
+    const int accepted = std::min(frames, writableInputFrames());
+    if (accepted > 0) writeRing(nullptr, accepted);
+    return accepted;
+}
+
+void PolyphaseResampler::filterFrame(
+        const float* window,
+        const float* row,
+        const float* monoRow,
+        float* output) const {
+    const int taps = table->taps;
+    if (channels == 2) {
+        dotStereo(window, row, taps * 2, output[0], output[1]);
+    } else if (channels == 1) {
+        output[0] = dotMono(window, monoRow, taps);
+    } else {
+        for (int c = 0; c < channels; ++c) {
+            float sum = 0.0f;
+            const float* sample = window + c;
+            for (int t = 0; t < taps; ++t) {
+                sum += sample[static_cast<size_t>(t) * channels] * monoRow[t];
+            }
+            output[c] = sum;
+        }
+    }
+}
+
+int PolyphaseResampler::render(float* output, int maxFrames) {
+    if (!table || output == nullptr || maxFrames <= 0) return 0;
+    return table->exact ? renderExact(output, maxFrames) : renderInterpolated(output, maxFrames);
+}
+
+int PolyphaseResampler::renderExact(float* output, int maxFrames) {
+    const int taps = table->taps;
+    const uint64_t denominator = table->phaseDenominator;
+    const float* stereoRows = table->stereo.data();
+    const float* monoRows = table->mono.data();
+    int produced = 0;
+    while (produced < maxFrames && bufferedFrames >= taps) {
+        const float* window = ring.data() + static_cast<size_t>(readFrame) * channels;
+        const size_t rowIndex = static_cast<size_t>(phase);
+        filterFrame(
+                window,
+                stereoRows + rowIndex * taps * 2,
+                monoRows + rowIndex * taps,
+                output + static_cast<size_t>(produced) * channels
+        );
+        ++produced;
+
+        int advance = table->stepWhole;
+        phase += table->stepFraction;
+        if (phase >= denominator) {
+            phase -= denominator;
+            ++advance;
+        }
+        readFrame = (readFrame + advance) & ringMask;
+        bufferedFrames -= advance;
+    }
+    return produced;
+}
+
+int PolyphaseResampler::renderInterpolated(float* output, int maxFrames) {
+    const int taps = table->taps;
+    const float* stereoRows = table->stereo.data();
+    const float* monoRows = table->mono.data();
+    float* lower = interpolationScratch.data();
+    float* upper = lower + channels;
+    constexpr uint64_t kPhaseMask = (1ull << 32) - 1ull;
+    constexpr uint64_t kWeightMask = (1ull << kInterpolatedWeightBits) - 1ull;
+    constexpr float kWeightScale = 1.0f / static_cast<float>(1u << kInterpolatedWeightBits);
+    int produced = 0;
+    while (produced < maxFrames && bufferedFrames >= taps) {
+        const float* window = ring.data() + static_cast<size_t>(readFrame) * channels;
+        const size_t rowIndex = static_cast<size_t>(phase >> kInterpolatedWeightBits);
+        const float weight = static_cast<float>(phase & kWeightMask) * kWeightScale;
+        filterFrame(window, stereoRows + rowIndex * taps * 2, monoRows + rowIndex * taps, lower);
+        filterFrame(window, stereoRows + (rowIndex + 1) * taps * 2, monoRows + (rowIndex + 1) * taps, upper);
+        float* frame = output + static_cast<size_t>(produced) * channels;
+        for (int c = 0; c < channels; ++c) {
+            frame[c] = lower[c] + (upper[c] - lower[c]) * weight;
+        }
+        ++produced;
+
+        phase += table->stepFraction;
+        const int advance = table->stepWhole + static_cast<int>(phase >> 32);
+        phase &= kPhaseMask;
+        readFrame = (readFrame + advance) & ringMask;
+        bufferedFrames -= advance;
+    }
+    return produced;
+}
@@ -0,0 +1,73 @@
+#ifndef SILICONPLAYER_POLYPHASE_RESAMPLER_H
+#define SILICONPLAYER_POLYPHASE_RESAMPLER_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Windowed-sinc (Kaiser) polyphase resampler for interleaved float audio.
+//
+// Coefficient tables are built once per (inputRate, outputRate) pair and
+// shared between instances. When the reduced ratio has a small enough
+// numerator every output phase gets its own exact row; otherwise a fixed
+// grid of rows is interpolated. Input history lives in a mirrored ring, so
+// the filter window is always contiguous and nothing is moved when input is
+// consumed. Stereo and mono use NEON/SSE kernels; other layouts fall back to
+// a scalar loop.
+//
+// The resampler keeps no notion of timeline: input is consumed strictly in
+// order with a fixed group delay, so decoders that jump (loops, subsong
+// wraps) are filtered across the jump like any other sample boundary.
+//
+// Not thread-safe; owned by the render path under decoderMutex.
+class PolyphaseResampler {
+public:
+    PolyphaseResampler() = default;
+
+    PolyphaseResampler(const PolyphaseResampler&) = delete;
+    PolyphaseResampler& operator=(const PolyphaseResampler&) = delete;
+
+    // Rebuilds state only when the format actually changes. Returns false for
+    // unsupported parameters.
+    bool configure(int channels, int inputRate, int outputRate);
+    bool isConfiguredFor(int channels, int inputRate, int outputRate) const;
+    void reset();
+
+    int writableInputFrames() const;
+    int pushInput(const float* data, int frames);
+    int pushSilence(int frames);
+
+    // Produces up to maxFrames output frames from buffered input.
+    int render(float* output, int maxFrames);
+
+    // Input frames the filter needs after the last real frame to emit it.
+    int flushInputFrames() const;
+    int tapCount() const;
+
+    static constexpr int kMaxPushFrames = 4096;
+
+private:
+    struct CoefficientTable;
+
+    static std::shared_ptr<const CoefficientTable> acquireTable(int inputRate, int outputRate);
+
+    void writeRing(const float* data, int frames);
+    int renderExact(float* output, int maxFrames);
+    int renderInterpolated(float* output, int maxFrames);
+    void filterFrame(const float* window, const float* row, const float* monoRow, float* output) const;
+
+    std::shared_ptr<const CoefficientTable> table;
+    int channels = 0;
+    int inputRate = 0;
+    int outputRate = 0;
+
+    std::vector<float> ring; // 2 * ringFrames * channels (mirrored)
+    std::vector<float> interpolationScratch;
+    int ringFrames = 0;
+    int ringMask = 0;
+    int readFrame = 0;
+    int bufferedFrames = 0;
+    uint64_t phase = 0;
+};
+
+#endif // SILICONPLAYER_POLYPHASE_RESAMPLER_H
@@ -0,0 +1,220 @@
+#include "ReadAheadCache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+namespace {
+constexpr int kMinBlockBytes = 4096;
+constexpr int kMinBlockCount = 4;
+}
+
+ReadAheadCache::ReadAheadCache(ReadFn readFn, int64_t sizeBytes, int blockBytes, int blockCount)
+    : readFn(std::move(readFn)),
+      sizeBytes(std::max<int64_t>(0, sizeBytes)),
+      blockBytes(std::max(kMinBlockBytes, blockBytes)),
+      blockTotal((this->sizeBytes + this->blockBytes - 1) / this->blockBytes),
+      slots(static_cast<size_t>(std::max(kMinBlockCount, blockCount))) {
+    for (Slot& slot : slots) {
+        slot.data = std::make_unique<uint8_t[]>(static_cast<size_t>(this->blockBytes));
+    }
+    // The remaining quarter keeps recently played blocks for back seeks.
+    prefetchBlocks = std::max(1, static_cast<int>(slots.size() * 3 / 4));
+    worker = std::thread(&ReadAheadCache::workerLoop, this);
+}
+
+ReadAheadCache::~ReadAheadCache() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeCv.notify_all();
+    readyCv.notify_all();
+    // A fetch in progress finishes first; readFn cannot be interrupted.
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+int ReadAheadCache::read(int64_t offset, uint8_t* buffer, int length) {
+    if (buffer == nullptr || length <= 0 || offset < 0) {
+        return -1;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    if (prefetchPaused) {
+        prefetchPaused = false;
+        wakeCv.notify_one();
+    }
+    int copied = 0;
+    while (copied < length && !stopping) {
+        const int64_t position = offset + copied;
+        if (position >= sizeBytes) {
+            break;
+        }
+        const int64_t block = position / blockBytes;
+        if (block != readerBlock) {
+            readerBlock = block;
+            wakeCv.notify_one();
+        }
+
+        Slot* slot = findSlotLocked(block);
+        if (slot != nullptr && slot->state == Slot::State::Failed) {
+            // A failed prefetch is retried once on demand.
+            slot->block = -1;
+            slot->state = Slot::State::Empty;
+            slot = nullptr;
+        }
+        if (slot != nullptr && slot->state == Slot::State::Ready) {
+            stats.hits += 1;
+        } else {
+            const bool demanded = slot == nullptr;
+            if (demanded) {
+                stats.misses += 1;
+                demandBlock = block;
+                wakeCv.notify_one();
+            }
+            stats.stalls += 1;
+            const auto waitStart = std::chrono::steady_clock::now();
+            readyCv.wait(lock, [this, block, &slot]() {
+                slot = findSlotLocked(block);
+                return stopping || (slot != nullptr && slot->state != Slot::State::Fetching);
+            });
+            stats.stallNs += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - waitStart).count());
+            if (stopping) {
+                break;
+            }
+            if (slot->state == Slot::State::Failed) {
+                if (!demanded) {
+                    continue;
+                }
+                // Drop the failed block so the next read fetches it again.
+                slot->block = -1;
+                slot->state = Slot::State::Empty;
+                return copied > 0 ? copied : -1;
+            }
+        }
+
+        const int offsetInBlock = static_cast<int>(position - block * blockBytes);
+        const int available = slot->bytes - offsetInBlock;
+        if (available <= 0) {
+            // Short block: the source ended early.
+            break;
+        }
+        const int count = std::min(available, length - copied);
+        std::memcpy(buffer + copied, slot->data.get() + offsetInBlock, static_cast<size_t>(count));
+        slot->lastUse = ++useClock;
+        copied += count;
+    }
+    if (stopping && copied == 0) {
+        return -1;
+    }
+    return copied;
+}
+
+ReadAheadCache::Stats ReadAheadCache::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+void ReadAheadCache::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        if (demandBlock >= 0 && findSlotLocked(demandBlock) != nullptr) {
+            demandBlock = -1;
+        }
+        const int64_t block = demandBlock >= 0 ? demandBlock : nextPrefetchBlockLocked();
+        Slot* slot = block >= 0 ? claimSlotLocked() : nullptr;
+        if (slot == nullptr) {
+            wakeCv.wait(lock);
+            continue;
+        }
+        const bool demanded = block == demandBlock;
+        if (demanded) {
+            demandBlock = -1;
+        }
+
+        slot->block = block;
+        slot->state = Slot::State::Fetching;
+        slot->bytes = 0;
+        uint8_t* data = slot->data.get();
+        const int expected = blockLength(block);
+        lock.unlock();
+
+        int fetched = 0;
+        bool failed = false;
+        while (fetched < expected) {
+            const int count = readFn(block * blockBytes + fetched, data + fetched, expected - fetched);
+            if (count < 0) {
+                failed = true;
+                break;
+            }
+            if (count == 0) {
+                break;
+            }
+            fetched += count;
+        }
+
+        lock.lock();
+        slot->bytes = fetched;
+        slot->state = (failed || fetched == 0) ? Slot::State::Failed : Slot::State::Ready;
+        if (slot->state == Slot::State::Failed && !demanded) {
+            // Do not hammer a failing source; the next read resumes prefetch.
+            prefetchPaused = true;
+        }
+        slot->lastUse = ++useClock;
+        stats.blocksFetched += 1;
+        stats.bytesFetched += static_cast<uint64_t>(fetched);
+        readyCv.notify_all();
+    }
+}
+
+ReadAheadCache::Slot* ReadAheadCache::findSlotLocked(int64_t block) {
+    for (Slot& slot : slots) {
+        if (slot.block == block && slot.state != Slot::State::Empty) {
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+ReadAheadCache::Slot* ReadAheadCache::claimSlotLocked() {
+    // Never evict the reader's block or the prefetch window ahead of it;
+    // among the rest prefer empty slots, then the least recently used.
+    const int64_t windowEnd = readerBlock + prefetchBlocks;
+    Slot* victim = nullptr;
+    for (Slot& slot : slots) {
+        if (slot.state == Slot::State::Fetching) {
+            continue;
+        }
+        if (slot.state == Slot::State::Empty) {
+            return &slot;
+        }
+        if (slot.block >= readerBlock && slot.block <= windowEnd && slot.state != Slot::State::Failed) {
+            continue;
+        }
+        if (victim == nullptr || slot.lastUse < victim->lastUse) {
+            victim = &slot;
+        }
+    }
+    return victim;
+}
+
+int64_t ReadAheadCache::nextPrefetchBlockLocked() {
+    if (prefetchPaused) {
+        return -1;
+    }
+    const int64_t last = std::min(readerBlock + prefetchBlocks, blockTotal - 1);
+    for (int64_t block = readerBlock; block <= last; ++block) {
+        if (findSlotLocked(block) == nullptr) {
+            return block;
+        }
+    }
+    return -1;
+}
+
+int ReadAheadCache::blockLength(int64_t block) const {
+    return static_cast<int>(std::min<int64_t>(blockBytes, sizeBytes - block * blockBytes));
+}
@@ -0,0 +1,98 @@
+#ifndef SILICONPLAYER_READ_AHEAD_CACHE_H
+#define SILICONPLAYER_READ_AHEAD_CACHE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Block cache with a background prefetch thread in front of a slow
+// positional reader (the SMB AVIO bridge into Java).
+//
+// The source is split into fixed blocks held in a small ring of slots. A
+// prefetch thread fetches the blocks ahead of the reader's position in
+// sequential order, so steady playback finds every block already resident
+// and never waits on the network. A read for a block that is not resident
+// (a seek, or playback outrunning the network) is fetched on the same
+// thread ahead of any prefetch, and the reader waits for it. Blocks behind
+// the reader stay until their slot is needed, so short back seeks are
+// served from memory.
+//
+// All fetches run on the prefetch thread, one at a time; readFn is never
+// called concurrently. read() may be called from any one thread at a time.
+class ReadAheadCache {
+public:
+    // Reads up to length bytes at offset; returns the count, 0 at end of
+    // data, or -1 on error.
+    using ReadFn = std::function<int(int64_t offset, uint8_t* buffer, int length)>;
+
+    struct Stats {
+        // Block lookups served from resident blocks.
+        uint64_t hits = 0;
+        // Block lookups that found the block neither resident nor in flight.
+        uint64_t misses = 0;
+        // Block lookups that waited on a fetch: every miss, plus blocks the
+        // prefetch thread was still fetching.
+        uint64_t stalls = 0;
+        uint64_t stallNs = 0;
+        uint64_t blocksFetched = 0;
+        uint64_t bytesFetched = 0;
+    };
+
+    static constexpr int kDefaultBlockBytes = 256 * 1024;
+    static constexpr int kDefaultBlockCount = 16;
+
+    // sizeBytes is the total source size; reads past it return 0.
+    ReadAheadCache(ReadFn readFn, int64_t sizeBytes,
+                   int blockBytes = kDefaultBlockBytes,
+                   int blockCount = kDefaultBlockCount);
+    ~ReadAheadCache();
+
+    ReadAheadCache(const ReadAheadCache&) = delete;
+    ReadAheadCache& operator=(const ReadAheadCache&) = delete;
+
+    int read(int64_t offset, uint8_t* buffer, int length);
+    int64_t size() const { return sizeBytes; }
+    Stats getStats() const;
+
+private:
+    struct Slot {
+        enum class State { Empty, Fetching, Ready, Failed };
+
+        int64_t block = -1;
+        State state = State::Empty;
+        int bytes = 0;
+        uint64_t lastUse = 0;
+        std::unique_ptr<uint8_t[]> data;
+    };
+
+    void workerLoop();
+    Slot* findSlotLocked(int64_t block);
+    Slot* claimSlotLocked();
+    int64_t nextPrefetchBlockLocked();
+    int blockLength(int64_t block) const;
+
+    const ReadFn readFn;
+    const int64_t sizeBytes;
+    const int blockBytes;
+    const int64_t blockTotal;
+    int prefetchBlocks = 0;
+
+    mutable std::mutex mutex;
+    std::condition_variable wakeCv;  // worker: demand or reader moved
+    std::condition_variable readyCv; // reader: a fetch finished
+    std::vector<Slot> slots;
+    int64_t readerBlock = 0;
+    int64_t demandBlock = -1;
+    uint64_t useClock = 0;
+    bool prefetchPaused = false;
+    bool stopping = false;
+    Stats stats;
+    std::thread worker;
+};
+
+#endif // SILICONPLAYER_READ_AHEAD_CACHE_H
@@ -0,0 +1,233 @@
+#include "RenderProfiler.h"
+
+#include <time.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+// Bucket 0 ends at 1024 ns; sub-microsecond durations are not worth splitting.
+constexpr int kFirstBucketLog2 = 10;
+constexpr uint64_t kFillFramesMask = 0x7fffffffull;
+constexpr uint64_t kFillUnderrunBit = 1ull << 31;
+constexpr const char* kOtherDecoderName = "other";
+constexpr const char* kUnnamedDecoderName = "-";
+
+void storeMax(std::atomic<int64_t>& target, int64_t value) {
+    int64_t current = target.load(std::memory_order_relaxed);
+    while (value > current &&
+           !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+}
+
+RenderProfiler::RenderProfiler() : epochNs(nowNs()) {}
+
+int64_t RenderProfiler::nowNs() {
+    timespec ts {};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000ll + ts.tv_nsec;
+}
+
+int RenderProfiler::bucketFor(int64_t ns) {
+    if (ns <= 0) {
+        return 0;
+    }
+    const int log2 = 63 - __builtin_clzll(static_cast<uint64_t>(ns));
+    return std::clamp(log2 - kFirstBucketLog2 + 1, 0, kHistogramBuckets - 1);
+}
+
+void RenderProfiler::record(Stage stage, int64_t ns) {
+    const int index = static_cast<int>(stage);
+    if (index < 0 || index >= kStageCount) {
+        return;
+    }
+    ns = std::max<int64_t>(0, ns);
+    StageStats& stats = stages[static_cast<size_t>(index)];
+    stats.count.fetch_add(1, std::memory_order_relaxed);
+    stats.sumNs.fetch_add(static_cast<uint64_t>(ns), std::memory_order_relaxed);
+    storeMax(stats.maxNs, ns);
+    stats.buckets[static_cast<size_t>(bucketFor(ns))].fetch_add(1, std::memory_order_relaxed);
+}
+
+bool RenderProfiler::claimSlot(DecoderStats& slot, const char* name) {
+    SlotState expected = slot.state.load(std::memory_order_acquire);
+    if (expected != SlotState::Empty ||
+        !slot.state.compare_exchange_strong(expected, SlotState::Claiming, std::memory_order_acquire)) {
+        return false;
+    }
+    std::strncpy(slot.name, name, kDecoderNameLength - 1);
+    slot.name[kDecoderNameLength - 1] = '\0';
+    slot.state.store(SlotState::Ready, std::memory_order_release);
+    return true;
+}
+
+bool RenderProfiler::waitReady(const DecoderStats& slot) {
+    // A claim is a short copy; only a second recording thread can see one.
+    SlotState state = slot.state.load(std::memory_order_acquire);
+    while (state == SlotState::Claiming) {
+        state = slot.state.load(std::memory_order_acquire);
+    }
+    return state == SlotState::Ready;
+}
+
+RenderProfiler::DecoderStats& RenderProfiler::decoderSlot(const char* name) {
+    // Slots fill in order and are never released, so the first empty slot
+    // ends the search.
+    for (int i = 0; i < kMaxDecoders - 1; ++i) {
+        DecoderStats& slot = decoders[static_cast<size_t>(i)];
+        if (claimSlot(slot, name)) {
+            return slot;
+        }
+        if (waitReady(slot) && std::strncmp(slot.name, name, kDecoderNameLength - 1) == 0) {
+            return slot;
+        }
+    }
+    DecoderStats& other = decoders[static_cast<size_t>(kMaxDecoders - 1)];
+    if (!claimSlot(other, kOtherDecoderName)) {
+        waitReady(other);
+    }
+    return other;
+}
+
+int RenderProfiler::decoderSlotCount() const {
+    int count = 0;
+    while (count < kMaxDecoders &&
+           decoders[static_cast<size_t>(count)].state.load(std::memory_order_acquire) == SlotState::Ready) {
+        ++count;
+    }
+    return count;
+}
+
+void RenderProfiler::recordDecode(const char* decoderName, int64_t ns, int frames) {
+    record(Stage::DecoderRead, ns);
+    DecoderStats& stats = decoderSlot(decoderName != nullptr ? decoderName : kUnnamedDecoderName);
+    stats.chunks.fetch_add(1, std::memory_order_relaxed);
+    stats.frames.fetch_add(static_cast<uint64_t>(std::max(0, frames)), std::memory_order_relaxed);
+    stats.decodeNs.fetch_add(static_cast<uint64_t>(std::max<int64_t>(0, ns)), std::memory_order_relaxed);
+}
+
+void RenderProfiler::recordCallback(
+        int64_t now,
+        int64_t intervalNs,
+        int64_t expectedNs,
+        int queueFrames,
+        int missingFrames) {
+    if (intervalNs > 0 && expectedNs > 0) {
+        record(Stage::CallbackJitter, intervalNs > expectedNs ? intervalNs - expectedNs : expectedNs - intervalNs);
+    }
+    const bool underrun = missingFrames > 0;
+    if (underrun) {
+        underruns.fetch_add(1, std::memory_order_relaxed);
+        underrunFrames.fetch_add(static_cast<uint64_t>(missingFrames), std::memory_order_relaxed);
+    }
+    if (!underrun && now - lastFillSampleNs < kFillSampleIntervalNs) {
+        return;
+    }
+    lastFillSampleNs = now;
+    const uint64_t timeMs = static_cast<uint64_t>(std::max<int64_t>(0, (now - epochNs) / 1000000));
+    const uint64_t packed =
+            ((timeMs & 0xffffffffull) << 32) |
+            (underrun ? kFillUnderrunBit : 0ull) |
+            (static_cast<uint64_t>(std::max(0, queueFrames)) & kFillFramesMask);
+    const uint64_t index = fillWriteIndex.load(std::memory_order_relaxed);
+    fillRing[static_cast<size_t>(index % kFillRingSize)].store(packed, std::memory_order_relaxed);
+    fillWriteIndex.store(index + 1, std::memory_order_release);
+}
+
+std::vector<int64_t> RenderProfiler::snapshot() const {
+    const uint64_t writeIndex = fillWriteIndex.load(std::memory_order_acquire);
+    const int fillCount = static_cast<int>(std::min<uint64_t>(writeIndex, kFillRingSize));
+    const int decoderCount = decoderSlotCount();
+
+    std::vector<int64_t> out;
+    out.reserve(8 +
+                static_cast<size_t>(kStageCount) * (3 + kHistogramBuckets) +
+                static_cast<size_t>(decoderCount) * 3 +
+                static_cast<size_t>(fillCount) * 3);
+    out.push_back(kSnapshotVersion);
+    out.push_back(kStageCount);
+    out.push_back(kHistogramBuckets);
+    out.push_back(decoderCount);
+    out.push_back(fillCount);
+    out.push_back((nowNs() - epochNs) / 1000000);
+    out.push_back(static_cast<int64_t>(underruns.load(std::memory_order_relaxed)));
+    out.push_back(static_cast<int64_t>(underrunFrames.load(std::memory_order_relaxed)));
+
+    for (const StageStats& stats : stages) {
+        out.push_back(static_cast<int64_t>(stats.count.load(std::memory_order_relaxed)));
+        out.push_back(static_cast<int64_t>(stats.sumNs.load(std::memory_order_relaxed)));
+        out.push_back(stats.maxNs.load(std::memory_order_relaxed));
+        for (const auto& bucket : stats.buckets) {
+            out.push_back(bucket.load(std::memory_order_relaxed));
+        }
+    }
+    for (int i = 0; i < decoderCount; ++i) {
+        const DecoderStats& stats = decoders[static_cast<size_t>(i)];
+        out.push_back(static_cast<int64_t>(stats.chunks.load(std::memory_order_relaxed)));
+        out.push_back(static_cast<int64_t>(stats.frames.load(std::memory_order_relaxed)));
+        out.push_back(static_cast<int64_t>(stats.decodeNs.load(std::memory_order_relaxed)));
+    }
+    // Slots older than the ring may be overwritten while we copy; that only
+    // makes the oldest entry newer than its neighbours, never torn.
+    for (uint64_t i = writeIndex - static_cast<uint64_t>(fillCount); i < writeIndex; ++i) {
+        const uint64_t packed = fillRing[static_cast<size_t>(i % kFillRingSize)].load(std::memory_order_relaxed);
+        out.push_back(static_cast<int64_t>(packed >> 32));
+        out.push_back(static_cast<int64_t>(packed & kFillFramesMask));
+        out.push_back((packed & kFillUnderrunBit) != 0 ? 1 : 0);
+    }
+    return out;
+}
+
+std::vector<std::string> RenderProfiler::decoderNames() const {
+    std::vector<std::string> names;
+    const int count = decoderSlotCount();
+    names.reserve(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) {
+        names.emplace_back(decoders[static_cast<size_t>(i)].name);
+    }
+    return names;
+}
+
+std::string RenderProfiler::decoderSummary() const {
+    std::string out;
+    const int count = decoderSlotCount();
+    for (int i = 0; i < count; ++i) {
+        const DecoderStats& stats = decoders[static_cast<size_t>(i)];
+        const uint64_t chunks = stats.chunks.load(std::memory_order_relaxed);
+        const uint64_t frames = stats.frames.load(std::memory_order_relaxed);
+        const uint64_t decodeNs = stats.decodeNs.load(std::memory_order_relaxed);
+        char line[160];
+        std::snprintf(
+                line,
+                sizeof(line),
+                "decode %s: chunks=%llu frames=%llu %.0fns/f\n",
+                stats.name,
+                static_cast<unsigned long long>(chunks),
+                static_cast<unsigned long long>(frames),
+                frames > 0 ? static_cast<double>(decodeNs) / static_cast<double>(frames) : 0.0
+        );
+        out += line;
+    }
+    return out;
+}
+
+void RenderProfiler::reset() {
+    for (StageStats& stats : stages) {
+        stats.count.store(0, std::memory_order_relaxed);
+        stats.sumNs.store(0, std::memory_order_relaxed);
+        stats.maxNs.store(0, std::memory_order_relaxed);
+        for (auto& bucket : stats.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+    for (DecoderStats& stats : decoders) {
+        stats.chunks.store(0, std::memory_order_relaxed);
+        stats.frames.store(0, std::memory_order_relaxed);
+        stats.decodeNs.store(0, std::memory_order_relaxed);
+    }
+    underruns.store(0, std::memory_order_relaxed);
+    underrunFrames.store(0, std::memory_order_relaxed);
+    // The fill ring keeps its history; it is a time series, not a counter.
+}
@@ -0,0 +1,122 @@
+#ifndef SILICONPLAYER_RENDER_PROFILER_H
+#define SILICONPLAYER_RENDER_PROFILER_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Always-on timing of the render pipeline, cheap enough to leave enabled in
+// release builds so crackle reports from the field come with numbers.
+//
+// Each stage keeps a log2 histogram of its durations (bucket b holds
+// [2^(b+9), 2^(b+10)) ns, the first and last buckets are open ended) plus
+// count, sum and max. Decoder reads are also split by decoder, so a report
+// shows what each decoder costs per frame next to the rest. The output
+// callback records the queue fill level into a fixed ring at most every
+// kFillSampleIntervalNs, and on every underrun.
+//
+// Recording is lock-free: histogram cells are relaxed atomics, a decoder
+// slot is claimed once by compare-exchange on its state and publishes a copy
+// of the name (decoders can live in plugins that are unloaded while the
+// profiler keeps their slot), and the fill ring has a single writer (the output callback) whose slots are one packed
+// 64-bit word each, so a concurrent snapshot never sees a torn entry. A
+// snapshot taken while recording runs may mix counters from adjacent
+// chunks; it is a diagnostic, not an accounting record.
+class RenderProfiler {
+public:
+    enum class Stage : int {
+        WorkerChunk,     // one render worker fill, excluding the wait for demand
+        DecoderRead,     // decoder read calls in one chunk
+        Resample,        // resampler work in one chunk, decoder reads excluded
+        DspFront,        // gain/routing/mono pass
+        DspOpenMpt,      // OpenMPT DSP bus incl. make-up pass
+        DspShape,        // limiter/lookahead clipper pass
+        Visualization,   // worker-side visualization update
+        QueueAppend,     // worker append into the render queue
+        QueuePop,        // callback pop from the render queue
+        DecoderLockWait, // render worker waiting for decoderMutex
+        QueueLockWait,   // render worker waiting for renderQueueMutex
+        CallbackJitter,  // |callback interval - expected period|
+        Count
+    };
+
+    static constexpr int kStageCount = static_cast<int>(Stage::Count);
+    static constexpr int kHistogramBuckets = 24;
+    static constexpr int kMaxDecoders = 16;
+    static constexpr int kDecoderNameLength = 32;
+    static constexpr int kFillRingSize = 256;
+    static constexpr int64_t kFillSampleIntervalNs = 20000000;
+    static constexpr int kSnapshotVersion = 2;
+
+    RenderProfiler();
+
+    RenderProfiler(const RenderProfiler&) = delete;
+    RenderProfiler& operator=(const RenderProfiler&) = delete;
+
+    static int64_t nowNs();
+
+    void record(Stage stage, int64_t ns);
+    // One chunk's decoder reads. decoderName is copied into the slot, cut to
+    // kDecoderNameLength - 1 chars; past kMaxDecoders distinct names, the
+    // rest share the last slot as "other".
+    void recordDecode(const char* decoderName, int64_t ns, int frames);
+    // Output callback only; intervalNs is the time since the previous
+    // callback (0 for the first one after a gap), expectedNs the period of
+    // its frame count, missingFrames what the queue could not supply.
+    void recordCallback(int64_t nowNs, int64_t intervalNs, int64_t expectedNs, int queueFrames, int missingFrames);
+
+    // Packed for JNI, all values int64:
+    //   [version, stageCount, bucketCount, decoderCount, fillCount, uptimeMs,
+    //    underruns, underrunFrames]
+    //   per stage:   count, sumNs, maxNs, buckets[bucketCount]
+    //   per decoder: chunks, frames, decodeNs, in decoderNames() order
+    //   fill ring, oldest first: timeMs, queueFrames, underrun (0/1)
+    std::vector<int64_t> snapshot() const;
+    // Names of the decoder slots in use, in snapshot order.
+    std::vector<std::string> decoderNames() const;
+    // One line per decoder: chunks, frames and decode ns per frame.
+    std::string decoderSummary() const;
+    // Clears counters; decoder slots keep their names so snapshot order
+    // stays stable.
+    void reset();
+
+private:
+    struct StageStats {
+        std::atomic<uint64_t> count { 0 };
+        std::atomic<uint64_t> sumNs { 0 };
+        std::atomic<int64_t> maxNs { 0 };
+        std::array<std::atomic<uint32_t>, kHistogramBuckets> buckets {};
+    };
+
+    enum class SlotState : uint8_t { Empty, Claiming, Ready };
+
+    struct DecoderStats {
+        std::atomic<SlotState> state { SlotState::Empty };
+        char name[kDecoderNameLength] {}; // written once while Claiming
+        std::atomic<uint64_t> chunks { 0 };
+        std::atomic<uint64_t> frames { 0 };
+        std::atomic<uint64_t> decodeNs { 0 };
+    };
+
+    static int bucketFor(int64_t ns);
+    static bool claimSlot(DecoderStats& slot, const char* name);
+    static bool waitReady(const DecoderStats& slot);
+    DecoderStats& decoderSlot(const char* name);
+    int decoderSlotCount() const;
+
+    const int64_t epochNs;
+    std::array<StageStats, kStageCount> stages;
+    std::array<DecoderStats, kMaxDecoders> decoders;
+    std::atomic<uint64_t> underruns { 0 };
+    std::atomic<uint64_t> underrunFrames { 0 };
+
+    // Slot: timeMs << 32 | underrun << 31 | queueFrames (31 bits).
+    std::array<std::atomic<uint64_t>, kFillRingSize> fillRing {};
+    std::atomic<uint64_t> fillWriteIndex { 0 };
+    int64_t lastFillSampleNs = 0; // callback thread only
+};
+
+#endif // SILICONPLAYER_RENDER_PROFILER_H
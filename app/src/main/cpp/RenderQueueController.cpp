@@ -0,0 +1,271 @@
+#include "RenderQueueController.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+// Covers wake-up latency of the render worker itself.
+constexpr int64_t kSchedulingMarginNs = 8000000;
+constexpr float kMaxLoadForScaling = 0.8f;
+constexpr int kTargetGranularityFrames = 256;
+constexpr int kMinChunkFrames = 256;
+
+int roundUpFrames(int64_t frames) {
+    const int64_t rounded = ((frames + kTargetGranularityFrames - 1) / kTargetGranularityFrames) *
+            kTargetGranularityFrames;
+    return static_cast<int>(std::min<int64_t>(rounded, 1 << 24));
+}
+}
+
+void RenderQueueController::configure(const Bounds& requested) {
+    Bounds next = requested;
+    next.baseChunkFrames = std::max(kMinChunkFrames, next.baseChunkFrames);
+    next.maxChunkFrames = std::max(next.baseChunkFrames, next.maxChunkFrames);
+    next.minTargetFrames = std::max(next.baseChunkFrames * 2, next.minTargetFrames);
+    next.maxTargetFrames = std::max(next.minTargetFrames, next.maxTargetFrames);
+    next.baseTargetFrames = std::clamp(next.baseTargetFrames, next.minTargetFrames, next.maxTargetFrames);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    // Settings pushes re-send the whole pipeline config; one that leaves the
+    // bounds alone must not throw away what the queue has learned.
+    if (next == bounds) {
+        return;
+    }
+    bounds = next;
+    for (auto& entry : learned) {
+        entry.second.chunkFrames = clampChunkLocked(entry.second.chunkFrames);
+        entry.second.targetFrames = clampTargetLocked(entry.second.targetFrames);
+    }
+    resetWindowLocked();
+    underrunBaselineValid = false;
+    lastEvaluateNs = 0;
+    currentChunkFrames = clampChunkLocked(currentChunkFrames);
+    currentTargetFrames = clampTargetLocked(currentTargetFrames);
+    pendingReason = "configured";
+}
+
+void RenderQueueController::setDecoder(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (name == decoderName) {
+        return;
+    }
+    if (!decoderName.empty()) {
+        learned[decoderName] = Learned { currentChunkFrames, currentTargetFrames };
+    }
+    decoderName = name;
+    resetWindowLocked();
+
+    const auto it = learned.find(name);
+    const int chunk = it != learned.end() ? it->second.chunkFrames : bounds.baseChunkFrames;
+    const int target = it != learned.end() ? it->second.targetFrames : bounds.baseTargetFrames;
+    if (chunk != currentChunkFrames || target != currentTargetFrames) {
+        currentChunkFrames = chunk;
+        currentTargetFrames = clampTargetLocked(target);
+        pendingReason = it != learned.end() ? "restored for " + name : "defaults for " + name;
+    }
+}
+
+void RenderQueueController::onChunk(int frames, int64_t renderNs) {
+    if (frames <= 0 || renderNs < 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    costNsPerFrame[static_cast<size_t>(costNext)] = static_cast<float>(renderNs) / static_cast<float>(frames);
+    costNext = (costNext + 1) % kCostWindow;
+    costCount = std::min(costCount + 1, kCostWindow);
+}
+
+void RenderQueueController::noteCallbackJitter(int64_t jitterNs) {
+    int64_t current = windowJitterNs.load(std::memory_order_relaxed);
+    while (jitterNs > current &&
+           !windowJitterNs.compare_exchange_weak(current, jitterNs, std::memory_order_relaxed)) {
+    }
+}
+
+bool RenderQueueController::evaluate(int64_t nowNs, int sampleRate, uint64_t underrunCount, Decision& out) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const int rate = sampleRate > 0 ? sampleRate : 48000;
+    lastSampleRate = rate;
+    if (!pendingReason.empty()) {
+        const std::string reason = pendingReason;
+        pendingReason.clear();
+        applyLocked(currentChunkFrames, currentTargetFrames, reason, nowNs, out);
+        return true;
+    }
+    if (!underrunBaselineValid) {
+        lastUnderrunCount = underrunCount;
+        underrunBaselineValid = true;
+        lastEvaluateNs = nowNs;
+        return false;
+    }
+    if (nowNs - lastEvaluateNs < kEvaluateIntervalNs) {
+        return false;
+    }
+    lastEvaluateNs = nowNs;
+    const uint64_t newUnderruns = underrunCount >= lastUnderrunCount ? underrunCount - lastUnderrunCount : 0;
+    lastUnderrunCount = underrunCount;
+    const int64_t windowJitter = windowJitterNs.exchange(0, std::memory_order_relaxed);
+    smoothedJitterNs = std::max(windowJitter, smoothedJitterNs - smoothedJitterNs / 8);
+
+    if (costCount < kMinSamplesForDecision && newUnderruns == 0) {
+        return false;
+    }
+
+    int desiredChunk = currentChunkFrames;
+    int requiredFrames = currentTargetFrames;
+    if (costCount > 0) {
+        std::array<float, kCostWindow> sorted {};
+        std::copy_n(costNsPerFrame.begin(), costCount, sorted.begin());
+        const auto end = sorted.begin() + costCount;
+        const auto p50 = sorted.begin() + (costCount - 1) / 2;
+        std::nth_element(sorted.begin(), p50, end);
+        lastP50NsPerFrame = *p50;
+        const auto p99 = sorted.begin() + ((costCount - 1) * 99) / 100;
+        std::nth_element(sorted.begin(), p99, end);
+        lastP99NsPerFrame = *p99;
+        lastLoad = lastP50NsPerFrame * static_cast<float>(rate) / 1.0e9f;
+
+        // Heavier cores render in larger chunks: fewer wake-ups and lock
+        // round trips per second of audio.
+        desiredChunk = bounds.baseChunkFrames;
+        if (lastLoad > 0.5f) {
+            desiredChunk *= 4;
+        } else if (lastLoad > 0.25f) {
+            desiredChunk *= 2;
+        }
+        desiredChunk = std::clamp(desiredChunk, bounds.baseChunkFrames, bounds.maxChunkFrames);
+
+        // The queue has to ride out one worst-case chunk plus a late
+        // callback; the busier the worker, the slower it wins that back.
+        const double stallNs = static_cast<double>(lastP99NsPerFrame) * desiredChunk +
+                static_cast<double>(smoothedJitterNs) +
+                static_cast<double>(kSchedulingMarginNs);
+        const double scale = 1.5 / (1.0 - std::min(lastLoad, kMaxLoadForScaling));
+        requiredFrames = std::max(
+                roundUpFrames(static_cast<int64_t>(std::ceil(stallNs * scale * rate / 1.0e9))),
+                desiredChunk * 2
+        );
+        lastRequiredFrames = requiredFrames;
+    }
+
+    char reason[160] = {};
+    int target = currentTargetFrames;
+    if (newUnderruns > 0) {
+        target = std::max(currentTargetFrames * 2, requiredFrames);
+        std::snprintf(reason, sizeof(reason), "%llu underrun(s)", static_cast<unsigned long long>(newUnderruns));
+        calmEvaluations = 0;
+    } else if (requiredFrames > currentTargetFrames) {
+        target = requiredFrames;
+        std::snprintf(
+                reason,
+                sizeof(reason),
+                "need %d: p99 %.0f us/chunk, jitter %lld us, load %.0f%%",
+                requiredFrames,
+                lastP99NsPerFrame * desiredChunk / 1000.0f,
+                static_cast<long long>(smoothedJitterNs / 1000),
+                lastLoad * 100.0f
+        );
+        calmEvaluations = 0;
+    } else if (requiredFrames * 2 < currentTargetFrames) {
+        if (++calmEvaluations >= kShrinkAfterEvaluations) {
+            target = std::max(requiredFrames, currentTargetFrames - currentTargetFrames / 4);
+            std::snprintf(reason, sizeof(reason), "calm for %d evaluations, need %d", calmEvaluations, requiredFrames);
+            calmEvaluations = 0;
+        }
+    } else {
+        calmEvaluations = 0;
+    }
+    target = clampTargetLocked(roundUpFrames(target));
+
+    if (target == currentTargetFrames && desiredChunk == currentChunkFrames) {
+        return false;
+    }
+    if (reason[0] == '\0') {
+        std::snprintf(reason, sizeof(reason), "load %.0f%%", lastLoad * 100.0f);
+    }
+    applyLocked(desiredChunk, target, reason, nowNs, out);
+    return true;
+}
+
+int RenderQueueController::chunkFrames() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return currentChunkFrames;
+}
+
+int RenderQueueController::targetFrames() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return currentTargetFrames;
+}
+
+std::string RenderQueueController::summary() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    char line[320];
+    std::snprintf(
+            line,
+            sizeof(line),
+            "decoder=%s chunk=%d target=%d (%.0f ms) bounds=[%d,%d] p50=%.0fns/f p99=%.0fns/f load=%.0f%% jitter=%lldus need=%d",
+            decoderName.empty() ? "-" : decoderName.c_str(),
+            currentChunkFrames,
+            currentTargetFrames,
+            currentTargetFrames * 1000.0 / lastSampleRate,
+            bounds.minTargetFrames,
+            bounds.maxTargetFrames,
+            lastP50NsPerFrame,
+            lastP99NsPerFrame,
+            lastLoad * 100.0f,
+            static_cast<long long>(smoothedJitterNs / 1000),
+            lastRequiredFrames
+    );
+    std::string out = line;
+    for (const HistoryEntry& entry : history) {
+        std::snprintf(
+                line,
+                sizeof(line),
+                "\n%lldms %s chunk=%d target=%d: ",
+                static_cast<long long>(entry.timeMs),
+                entry.decoder.empty() ? "-" : entry.decoder.c_str(),
+                entry.chunkFrames,
+                entry.targetFrames
+        );
+        out += line;
+        out += entry.reason;
+    }
+    return out;
+}
+
+int RenderQueueController::clampChunkLocked(int frames) const {
+    return std::clamp(frames, bounds.baseChunkFrames, bounds.maxChunkFrames);
+}
+
+int RenderQueueController::clampTargetLocked(int frames) const {
+    return std::clamp(frames, bounds.minTargetFrames, bounds.maxTargetFrames);
+}
+
+void RenderQueueController::resetWindowLocked() {
+    costCount = 0;
+    costNext = 0;
+    calmEvaluations = 0;
+    smoothedJitterNs = 0;
+    windowJitterNs.store(0, std::memory_order_relaxed);
+}
+
+void RenderQueueController::applyLocked(
+        int chunk,
+        int target,
+        const std::string& reason,
+        int64_t nowNs,
+        Decision& out) {
+    currentChunkFrames = chunk;
+    currentTargetFrames = target;
+    if (!decoderName.empty()) {
+        learned[decoderName] = Learned { chunk, target };
+    }
+    if (history.size() >= static_cast<size_t>(kHistorySize)) {
+        history.erase(history.begin());
+    }
+    history.push_back(HistoryEntry { nowNs / 1000000, chunk, target, decoderName, reason });
+    out.chunkFrames = chunk;
+    out.targetFrames = target;
+    out.reason = reason;
+}
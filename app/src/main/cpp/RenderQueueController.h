@@ -0,0 +1,123 @@
+#ifndef SILICONPLAYER_RENDER_QUEUE_CONTROLLER_H
+#define SILICONPLAYER_RENDER_QUEUE_CONTROLLER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Picks the render worker's chunk size and queue target from what the
+// current decoder actually costs, instead of from the buffer preset alone.
+//
+// The render worker reports each chunk's render time (decode, resample and
+// DSP); the output callback reports how far each callback strayed from its
+// period. Every kEvaluateIntervalNs the controller computes how much queued
+// audio covers a worst-case chunk (p99 cost) plus callback jitter, scaled up
+// as the decoder's share of real time grows, and:
+//   - doubles the target on any underrun,
+//   - grows it at once when the requirement exceeds it,
+//   - shrinks it by a quarter after kShrinkAfterEvaluations calm periods in
+//     which the requirement stayed below half of it.
+// Chunk size steps up with the decoder's load so heavy cores pay the
+// per-chunk overhead less often. Everything stays within the configured
+// bounds; with minTargetFrames == maxTargetFrames the target is fixed.
+//
+// What was learned is remembered per decoder, so switching back to a heavy
+// core starts from its last target instead of re-learning through underruns.
+// It survives reconfiguration too, clamped into the new bounds.
+//
+// Thread-safe; the callback side (noteCallbackJitter) is a relaxed atomic.
+class RenderQueueController {
+public:
+    struct Bounds {
+        int baseChunkFrames = 256;
+        int baseTargetFrames = 8192;
+        int minTargetFrames = 8192;
+        int maxTargetFrames = 8192;
+        int maxChunkFrames = 1024;
+
+        bool operator==(const Bounds&) const = default;
+    };
+
+    struct Decision {
+        int chunkFrames = 0;
+        int targetFrames = 0;
+        std::string reason;
+    };
+
+    static constexpr int kCostWindow = 512;
+    static constexpr int kMinSamplesForDecision = 32;
+    static constexpr int64_t kEvaluateIntervalNs = 500000000;
+    static constexpr int kShrinkAfterEvaluations = 20;
+    static constexpr int kHistorySize = 8;
+
+    // Sets the bounds; a no-op when they are unchanged. Learned values are
+    // kept and clamped into the new bounds.
+    void configure(const Bounds& bounds);
+    // Switches the cost window to another decoder and restores its last values.
+    void setDecoder(const std::string& name);
+    void onChunk(int frames, int64_t renderNs);
+    void noteCallbackJitter(int64_t jitterNs);
+    // Returns true and fills out when chunk size or target changed. Call
+    // from the render worker; cheap when the interval has not elapsed.
+    bool evaluate(int64_t nowNs, int sampleRate, uint64_t underrunCount, Decision& out);
+
+    int chunkFrames() const;
+    int targetFrames() const;
+    // Current values, the inputs behind them and the last changes.
+    std::string summary() const;
+
+private:
+    struct Learned {
+        int chunkFrames = 0;
+        int targetFrames = 0;
+    };
+
+    struct HistoryEntry {
+        int64_t timeMs = 0;
+        int chunkFrames = 0;
+        int targetFrames = 0;
+        std::string decoder;
+        std::string reason;
+    };
+
+    int clampChunkLocked(int frames) const;
+    int clampTargetLocked(int frames) const;
+    void resetWindowLocked();
+    void applyLocked(int chunk, int target, const std::string& reason, int64_t nowNs, Decision& out);
+
+    mutable std::mutex mutex;
+    Bounds bounds;
+    int currentChunkFrames = 256;
+    int currentTargetFrames = 8192;
+    std::string decoderName;
+    std::unordered_map<std::string, Learned> learned;
+    // Set when configure()/setDecoder() moved the values; the next
+    // evaluate() reports them without waiting for the interval.
+    std::string pendingReason;
+
+    std::array<float, kCostWindow> costNsPerFrame {};
+    int costCount = 0;
+    int costNext = 0;
+    std::atomic<int64_t> windowJitterNs { 0 };
+    int64_t smoothedJitterNs = 0;
+
+    int64_t lastEvaluateNs = 0;
+    uint64_t lastUnderrunCount = 0;
+    bool underrunBaselineValid = false;
+    int calmEvaluations = 0;
+
+    // Inputs of the last evaluation, for summary().
+    float lastP50NsPerFrame = 0.0f;
+    float lastP99NsPerFrame = 0.0f;
+    float lastLoad = 0.0f;
+    int lastRequiredFrames = 0;
+    int lastSampleRate = 48000;
+
+    std::vector<HistoryEntry> history;
+};
+
+#endif // SILICONPLAYER_RENDER_QUEUE_CONTROLLER_H
@@ -0,0 +1,194 @@
+#include "RenderQueueRing.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    constexpr size_t kMinimumRingSamples = 4096u;
+
+    size_t roundUpToPowerOfTwo(size_t value, size_t start) {
+        size_t result = std::max(start, kMinimumRingSamples);
+        while (result < value) {
+            result *= 2u;
+        }
+        return result;
+    }
+}
+
+RenderQueueRing::Block::Block(size_t sampleCapacity, uint64_t firstPosition)
+        : capacity(sampleCapacity),
+          mask(sampleCapacity - 1u),
+          basePosition(firstPosition),
+          samples(new float[sampleCapacity]()) {
+}
+
+RenderQueueRing::~RenderQueueRing() {
+    Block* block = oldestBlock;
+    while (block != nullptr) {
+        Block* next = block->next.load(std::memory_order_relaxed);
+        delete block;
+        block = next;
+    }
+}
+
+void RenderQueueRing::reserve(size_t minSampleCapacity) {
+    std::lock_guard<std::mutex> lock(producerMutex);
+    releaseRetiredBlocksLocked();
+    minSampleCapacity = std::max(minSampleCapacity, kMinimumRingSamples);
+    if (producerBlock != nullptr && producerBlock->capacity >= minSampleCapacity) {
+        return;
+    }
+
+    const size_t newCapacity = roundUpToPowerOfTwo(
+            minSampleCapacity,
+            producerBlock != nullptr ? producerBlock->capacity : kMinimumRingSamples
+    );
+    // New samples land in the new block from the current write position on;
+    // anything still queued stays in the old block until the consumer drains it.
+    auto* block = new Block(newCapacity, writePosition.load(std::memory_order_relaxed));
+    if (producerBlock != nullptr) {
+        producerBlock->next.store(block, std::memory_order_release);
+    } else {
+        oldestBlock = block;
+        consumerBlock.store(block, std::memory_order_release);
+    }
+    producerBlock = block;
+    publishedCapacity.store(newCapacity, std::memory_order_relaxed);
+}
+
+size_t RenderQueueRing::writableSamplesLocked(uint64_t writePos) const {
+    const uint64_t readPos = readPosition.load(std::memory_order_acquire);
+    const uint64_t occupiedFrom = std::max(readPos, producerBlock->basePosition);
+    const uint64_t occupied = writePos > occupiedFrom ? writePos - occupiedFrom : 0u;
+    return occupied >= producerBlock->capacity
+            ? 0u
+            : producerBlock->capacity - static_cast<size_t>(occupied);
+}
+
+void RenderQueueRing::releaseRetiredBlocksLocked() {
+    Block* current = consumerBlock.load(std::memory_order_acquire);
+    while (oldestBlock != nullptr && oldestBlock != current) {
+        Block* next = oldestBlock->next.load(std::memory_order_acquire);
+        delete oldestBlock;
+        oldestBlock = next;
+    }
+}
+
+size_t RenderQueueRing::write(const float* data, size_t sampleCount) {
+    if (data == nullptr || sampleCount == 0u) return 0u;
+    if (capacity() == 0u) {
+        reserve(sampleCount);
+    }
+
+    std::lock_guard<std::mutex> lock(producerMutex);
+    releaseRetiredBlocksLocked();
+    const uint64_t writePos = writePosition.load(std::memory_order_relaxed);
+    const size_t count = std::min(sampleCount, writableSamplesLocked(writePos));
+    if (count == 0u) return 0u;
+
+    Block* block = producerBlock;
+    const size_t index = static_cast<size_t>(writePos - block->basePosition) & block->mask;
+    const size_t firstChunk = std::min(count, block->capacity - index);
+    std::memcpy(block->samples.get() + index, data, firstChunk * sizeof(float));
+    if (count > firstChunk) {
+        std::memcpy(block->samples.get(), data + firstChunk, (count - firstChunk) * sizeof(float));
+    }
+    writePosition.store(writePos + count, std::memory_order_release);
+    return count;
+}
+
+size_t RenderQueueRing::writeMonoAsStereo(const float* data, size_t frameCount, size_t sourceStride) {
+    if (data == nullptr || frameCount == 0u || sourceStride == 0u) return 0u;
+    if (capacity() == 0u) {
+        reserve(frameCount * 2u);
+    }
+
+    std::lock_guard<std::mutex> lock(producerMutex);
+    releaseRetiredBlocksLocked();
+    const uint64_t writePos = writePosition.load(std::memory_order_relaxed);
+    const size_t frames = std::min(frameCount, writableSamplesLocked(writePos) / 2u);
+    if (frames == 0u) return 0u;
+
+    Block* block = producerBlock;
+    float* samples = block->samples.get();
+    size_t index = static_cast<size_t>(writePos - block->basePosition) & block->mask;
+    for (size_t i = 0; i < frames; ++i) {
+        const float mono = data[i * sourceStride];
+        samples[index] = mono;
+        index = (index + 1u) & block->mask;
+        samples[index] = mono;
+        index = (index + 1u) & block->mask;
+    }
+    writePosition.store(writePos + frames * 2u, std::memory_order_release);
+    return frames * 2u;
+}
+
+size_t RenderQueueRing::read(float* output, size_t sampleCount) {
+    if (output == nullptr || sampleCount == 0u) return 0u;
+    Block* const startBlock = consumerBlock.load(std::memory_order_acquire);
+    if (startBlock == nullptr) return 0u;
+
+    const uint64_t readPos = readPosition.load(std::memory_order_acquire);
+    const uint64_t writePos = writePosition.load(std::memory_order_acquire);
+    const size_t available = writePos > readPos ? static_cast<size_t>(writePos - readPos) : 0u;
+    const size_t count = std::min(sampleCount, available);
+
+    Block* block = startBlock;
+    uint64_t position = readPos;
+    size_t copied = 0u;
+    while (copied < count) {
+        Block* next = block->next.load(std::memory_order_acquire);
+        while (next != nullptr && position >= next->basePosition) {
+            block = next;
+            next = block->next.load(std::memory_order_acquire);
+        }
+        const size_t blockRemaining = next != nullptr
+                ? static_cast<size_t>(next->basePosition - position)
+                : count - copied;
+        const size_t chunk = std::min(count - copied, blockRemaining);
+        const size_t index = static_cast<size_t>(position - block->basePosition) & block->mask;
+        const size_t firstChunk = std::min(chunk, block->capacity - index);
+        std::memcpy(output + copied, block->samples.get() + index, firstChunk * sizeof(float));
+        if (chunk > firstChunk) {
+            std::memcpy(output + copied + firstChunk, block->samples.get(), (chunk - firstChunk) * sizeof(float));
+        }
+        copied += chunk;
+        position += chunk;
+    }
+
+    // Step onto a newer block once the old one is drained so the producer can free it.
+    Block* next = block->next.load(std::memory_order_acquire);
+    while (next != nullptr && position >= next->basePosition) {
+        block = next;
+        next = block->next.load(std::memory_order_acquire);
+    }
+    if (block != startBlock) {
+        consumerBlock.store(block, std::memory_order_release);
+    }
+
+    // clear() may have moved the read position concurrently; only ever move it forward.
+    uint64_t expected = readPos;
+    const uint64_t target = readPos + count;
+    while (expected < target &&
+           !readPosition.compare_exchange_weak(expected, target, std::memory_order_acq_rel, std::memory_order_acquire)) {
+    }
+    return count;
+}
+
+size_t RenderQueueRing::size() const {
+    const uint64_t readPos = readPosition.load(std::memory_order_acquire);
+    const uint64_t writePos = writePosition.load(std::memory_order_acquire);
+    return writePos > readPos ? static_cast<size_t>(writePos - readPos) : 0u;
+}
+
+size_t RenderQueueRing::capacity() const {
+    return publishedCapacity.load(std::memory_order_relaxed);
+}
+
+void RenderQueueRing::clear() {
+    uint64_t readPos = readPosition.load(std::memory_order_acquire);
+    const uint64_t writePos = writePosition.load(std::memory_order_acquire);
+    while (readPos < writePos &&
+           !readPosition.compare_exchange_weak(readPos, writePos, std::memory_order_acq_rel, std::memory_order_acquire)) {
+    }
+}
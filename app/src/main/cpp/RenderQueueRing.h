@@ -0,0 +1,69 @@
+#ifndef SILICONPLAYER_RENDER_QUEUE_RING_H
+#define SILICONPLAYER_RENDER_QUEUE_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+// Single-consumer float ring between the render worker and the output callback.
+//
+// The consumer side (read/size/clear) never takes a lock, so the real-time
+// callback cannot block behind the render worker. Positions are monotonic
+// sample counters kept on separate cache lines.
+//
+// Growing the ring does not move queued samples: the producer links a larger
+// block whose first position is the current write position, the consumer
+// drains the old block and then follows the link, and the producer frees
+// blocks the consumer has left. Producers are serialized by an internal mutex
+// (render worker plus the occasional startup preroll/tuning call); the
+// consumer never touches it.
+class RenderQueueRing {
+public:
+    RenderQueueRing() = default;
+    ~RenderQueueRing();
+
+    RenderQueueRing(const RenderQueueRing&) = delete;
+    RenderQueueRing& operator=(const RenderQueueRing&) = delete;
+
+    // Producer side.
+    void reserve(size_t minSampleCapacity);
+    size_t write(const float* data, size_t sampleCount);
+    size_t writeMonoAsStereo(const float* data, size_t frameCount, size_t sourceStride);
+
+    // Consumer side (wait-free).
+    size_t read(float* output, size_t sampleCount);
+
+    // Any thread.
+    size_t size() const;
+    size_t capacity() const;
+    void clear();
+
+private:
+    struct Block {
+        explicit Block(size_t sampleCapacity, uint64_t firstPosition);
+
+        const size_t capacity;
+        const size_t mask;
+        const uint64_t basePosition;
+        std::unique_ptr<float[]> samples;
+        std::atomic<Block*> next { nullptr };
+    };
+
+    static constexpr size_t kCacheLineSize = 64;
+
+    size_t writableSamplesLocked(uint64_t writePos) const;
+    void releaseRetiredBlocksLocked();
+
+    alignas(kCacheLineSize) std::atomic<uint64_t> writePosition { 0 };
+    alignas(kCacheLineSize) std::atomic<uint64_t> readPosition { 0 };
+    alignas(kCacheLineSize) std::atomic<Block*> consumerBlock { nullptr };
+
+    alignas(kCacheLineSize) mutable std::mutex producerMutex;
+    Block* producerBlock = nullptr;
+    Block* oldestBlock = nullptr;
+    std::atomic<size_t> publishedCapacity { 0 };
+};
+
+#endif // SILICONPLAYER_RENDER_QUEUE_RING_H
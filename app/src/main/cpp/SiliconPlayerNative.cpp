@@ -5,6 +5,8 @@
 #include "AudioEngine.h"
 #include "AudioTrackJniBridge.h"
 #include "ChannelScopeTrigger.h"
+#include "DurationAnalysisCache.h"
+#include "decoders/DecoderPluginLoader.h"
 #include "decoders/DecoderRegistry.h"
 #include <algorithm>
 #include <vector>
@@ -16,6 +18,7 @@ static AudioEngine *audioEngine = nullptr;
 static std::mutex engineMutex;
 static ChannelScopeTrigger channelScopeTrigger;
 static jstring toJString(JNIEnv* env, std::string_view value);
+static jobjectArray toJStringArray(JNIEnv* env, const std::vector<std::string>& values);
 static JavaVM* gJavaVm = nullptr;
 static jclass gNativeBridgeClass = nullptr;
 static jmethodID gResolveArchiveCompanionMethod = nullptr;
@@ -153,8 +156,15 @@ int readSmbAvioHandleForNative(int64_t handleId, int64_t offset, uint8_t* buffer
     }
 
     JNIEnv* env = attachedEnv.env;
-    jbyteArray jBuffer = env->NewByteArray(length);
+    // Java fills the caller's memory through a direct buffer view: no
+    // byte[] allocation per read and no copy back out of the Java heap.
+    // Callers reuse their destination (the read-ahead block slots), so only
+    // the small wrapper object is created here.
+    jobject jBuffer = env->NewDirectByteBuffer(buffer, static_cast<jlong>(length));
     if (jBuffer == nullptr) {
+        if (env->ExceptionCheck()) {
+            env->ExceptionClear();
+        }
         return -1;
     }
 
@@ -166,29 +176,12 @@ int readSmbAvioHandleForNative(int64_t handleId, int64_t offset, uint8_t* buffer
             jBuffer,
             static_cast<jint>(length)
     );
+    env->DeleteLocalRef(jBuffer);
     if (env->ExceptionCheck()) {
         env->ExceptionClear();
-        env->DeleteLocalRef(jBuffer);
         return -1;
     }
-
-    const int bytesRead = static_cast<int>(readCount);
-    if (bytesRead > 0) {
-        env->GetByteArrayRegion(
-                jBuffer,
-                0,
-                static_cast<jsize>(std::min(bytesRead, length)),
-                reinterpret_cast<jbyte*>(buffer)
-        );
-        if (env->ExceptionCheck()) {
-            env->ExceptionClear();
-            env->DeleteLocalRef(jBuffer);
-            return -1;
-        }
-    }
-
-    env->DeleteLocalRef(jBuffer);
-    return std::max(0, bytesRead);
+    return std::clamp(static_cast<int>(readCount), 0, length);
 }
 
 int64_t getSmbAvioHandleSizeForNative(int64_t handleId) {
@@ -317,7 +310,7 @@ extern "C" JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void*) {
     gReadSmbAvioHandleMethod = env->GetStaticMethodID(
             gNativeBridgeClass,
             "readSmbAvioHandle",
-            "(JJ[BI)I"
+            "(JJLjava/nio/ByteBuffer;I)I"
     );
     if (gReadSmbAvioHandleMethod == nullptr) {
         return JNI_ERR;
@@ -416,6 +409,78 @@ Java_com_flopster101_siliconplayer_NativeBridge_setUadeRuntimePaths(
     }
 }
 
+extern "C" JNIEXPORT void JNICALL
+Java_com_flopster101_siliconplayer_NativeBridge_setDurationCacheDirectory(
+        JNIEnv* env,
+        jobject,
+        jstring directory) {
+    std::string nativeDirectory;
+    if (directory != nullptr) {
+        const char* chars = env->GetStringUTFChars(directory, 0);
+        if (chars != nullptr) {
+            nativeDirectory = chars;
+            env->ReleaseStringUTFChars(directory, chars);
+        }
+    }
+    DurationAnalysisCache::getInstance().setDirectory(nativeDirectory);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_flopster101_siliconplayer_NativeBridge_flushDurationCache(
+        JNIEnv*,
+        jobject) {
+    DurationAnalysisCache::getInstance().flush();
+}
+
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_flopster101_siliconplayer_NativeBridge_getDurationCacheStats(
+        JNIEnv* env,
+        jobject) {
+    return env->NewStringUTF(DurationAnalysisCache::getInstance().statsSummary().c_str());
+}
+
+// Probe results cross JNI flattened: path, status, decoder, title, artist,
+// composer, album, genre, year, durationMs, durationReliable, sampleRateHz,
+// channels, subtuneCount, then subtuneCount (title, durationMs) pairs.
+static void appendProbeResult(std::vector<std::string>& out, const DecoderProbeResult& result) {
+    out.push_back(result.path);
+    out.push_back(std::to_string(static_cast<int>(result.status)));
+    out.push_back(result.decoderName);
+    out.push_back(result.title);
+    out.push_back(result.artist);
+    out.push_back(result.composer);
+    out.push_back(result.album);
+    out.push_back(result.genre);
+    out.push_back(result.year);
+    out.push_back(std::to_string(static_cast<int64_t>(result.durationSeconds * 1000.0)));
+    out.push_back(result.durationReliable ? "1" : "0");
+    out.push_back(std::to_string(result.sampleRateHz));
+    out.push_back(std::to_string(result.channelCount));
+    out.push_back(std::to_string(result.subtuneTitles.size()));
+    for (size_t i = 0; i < result.subtuneTitles.size(); ++i) {
+        out.push_back(result.subtuneTitles[i]);
+        out.push_back(std::to_string(static_cast<int64_t>(result.subtuneDurationSeconds[i] * 1000.0)));
+    }
+}
+
+extern "C" JNIEXPORT jobjectArray JNICALL
+Java_com_flopster101_siliconplayer_NativeBridge_probeTrack(
+        JNIEnv* env,
+        jobject,
+        jstring path) {
+    std::string nativePath;
+    if (path != nullptr) {
+        const char* chars = env->GetStringUTFChars(path, 0);
+        if (chars != nullptr) {
+            nativePath = chars;
+            env->ReleaseStringUTFChars(path, chars);
+        }
+    }
+    std::vector<std::string> packed;
+    appendProbeResult(packed, DecoderRegistry::getInstance().probe(nativePath.c_str()));
+    return toJStringArray(env, packed);
+}
+
 extern "C" __attribute__((visibility("default")))
 int siliconplayer_get_uade_runtime_paths(
         char* baseDir,
@@ -1961,6 +2026,15 @@ Java_com_flopster101_siliconplayer_NativeBridge_getUadeSubsongBytes(JNIEnv*, job
     return static_cast<jlong>(audioEngine->getUadeSubsongBytes());
 }
 
+extern "C" JNIEXPORT jobjectArray JNICALL
+Java_com_flopster101_siliconplayer_NativeBridge_getTrackInfoSnapshot(
+        JNIEnv* env, jobject, jlong knownVersion) {
+    if (audioEngine == nullptr) {
+        return env->NewObjectArray(0, env->FindClass("java/lang/String"), nullptr);
+    }
+    return toJStringArray(env, audioEngine->getTrackInfoSnapshot(static_cast<uint64_t>(knownVersion)));
+}
+
 extern "C" JNIEXPORT void JNICALL
 Java_com_flopster101_siliconplayer_NativeBridge_startEngine(JNIEnv* env, jobject thiz) {
     Java_com_flopster101_siliconplayer_MainActivity_startEngine(env, thiz);
@@ -2003,6 +2077,94 @@ Java_com_flopster101_siliconplayer_NativeBridge_loadAudio(JNIEnv* env, jobject t
     Java_com_flopster101_siliconplayer_MainActivity_loadAudio(env, thiz, path);
 }
 
+extern "C" JNIEXPORT void JNICALL
+Java_com_flopster101_siliconplayer_NativeBridge_setNextAudio(JNIEnv* env, jobject, jstring path) {
+    ensureEngine();
+    if (path == nullptr) {
+        audioEngine->clearNextUrl();
+        return;
+    }
+    const char* nativePath = env->GetStringUTFChars(path, 0);
+    audioEngine->setNextUrl(nativePath);
+    env->ReleaseStringUTFChars(path, nativePath);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_flopster101_siliconplayer_NativeBridge_clearNextAudio(JNIEnv*, jobject) {
+    if (audioEngine == nullptr) {
+        return;
+    }
+    audioEngine->clearNextUrl();
+}
+
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_flopster101_siliconplayer_NativeBridge_consumeGaplessTransitionEvent(JNIEnv*, jobject) {
+    if (audioEngine == nullptr) {
+        return JNI_FALSE;
+    }
+    return audioEngine->consumeGaplessTransitionEvent() ? JNI_TRUE : JNI_FALSE;
+}
+
+extern "C" JNIEXPORT jdoubleArray JNICALL
+Java_com_flopster101_siliconplayer_NativeBridge_getNextAudioPreloadStats(JNIEnv* env, jobject) {
+    if (audioEngine == nullptr) {
+        return env->NewDoubleArray(0);
+    }
+    const std::vector<double> stats = audioEngine->getNextTrackPreloadStats();
+    jdoubleArray array = env->NewDoubleArray(static_cast<jsize>(stats.size()));
+    if (array == nullptr || stats.empty()) {
+        return array;
+    }
+    env->SetDoubleArrayRegion(array, 0, static_cast<jsize>(stats.size()), stats.data());
+    return array;
+}
+
+extern "C" JNIEXPORT jlongArray JNICALL
+Java_com_flopster101_siliconplayer_NativeBridge_getRenderProfileSnapshot(JNIEnv* env, jobject) {
+    if (audioEngine == nullptr) {
+        return env->NewLongArray(0);
+    }
+    const std::vector<int64_t> values = audioEngine->getRenderProfileSnapshot();
+    jlongArray array = env->NewLongArray(static_cast<jsize>(values.size()));
+    if (array == nullptr || values.empty()) {
+        return array;
+    }
+    static_assert(sizeof(jlong) == sizeof(int64_t), "jlong must be 64-bit");
+    env->SetLongArrayRegion(
+            array,
+            0,
+            static_cast<jsize>(values.size()),
+            reinterpret_cast<const jlong*>(values.data())
+    );
+    return array;
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_flopster101_siliconplayer_NativeBridge_resetRenderProfile(JNIEnv*, jobject) {
+    if (audioEngine != nullptr) {
+        audioEngine->resetRenderProfile();
+    }
+}
+
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_flopster101_siliconplayer_NativeBridge_getRenderQueueTuning(JNIEnv* env, jobject) {
+    if (audioEngine == nullptr) {
+        return env->NewStringUTF("");
+    }
+    return env->NewStringUTF(audioEngine->getRenderQueueTuningSummary().c_str());
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_flopster101_siliconplayer_NativeBridge_setRenderQueueAdaptation(
+        JNIEnv*,
+        jobject,
+        jboolean enabled,
+        jint minLatencyMs,
+        jint maxLatencyMs) {
+    ensureEngine();
+    audioEngine->setRenderQueueAdaptation(enabled == JNI_TRUE, minLatencyMs, maxLatencyMs);
+}
+
 extern "C" JNIEXPORT void JNICALL
 Java_com_flopster101_siliconplayer_NativeBridge_setFastTrackSwitchStartupHint(
         JNIEnv*,
@@ -2788,3 +2950,32 @@ Java_com_flopster101_siliconplayer_NativeBridge_setDecoderEnabledExtensions(
     DecoderRegistry::getInstance().setDecoderEnabledExtensions(name, extVector);
     env->ReleaseStringUTFChars(decoderName, name);
 }
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_flopster101_siliconplayer_NativeBridge_prewarmDecoderPlugins(
+        JNIEnv* env, jobject, jobjectArray paths) {
+    std::vector<std::string> libraries;
+    const jsize length = paths != nullptr ? env->GetArrayLength(paths) : 0;
+    for (jsize i = 0; i < length; ++i) {
+        jstring path = (jstring) env->GetObjectArrayElement(paths, i);
+        if (path == nullptr) continue;
+        const char* pathChars = env->GetStringUTFChars(path, 0);
+        std::string library = DecoderRegistry::getInstance().resolvePluginLibrary(pathChars);
+        env->ReleaseStringUTFChars(path, pathChars);
+        env->DeleteLocalRef(path);
+        if (!library.empty() && std::find(libraries.begin(), libraries.end(), library) == libraries.end()) {
+            libraries.push_back(std::move(library));
+        }
+    }
+    DecoderPluginLoader::getInstance().prewarm(libraries);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_flopster101_siliconplayer_NativeBridge_trimDecoderPlugins(JNIEnv*, jobject, jint level) {
+    DecoderPluginLoader::getInstance().onTrimMemory(level);
+}
+
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_flopster101_siliconplayer_NativeBridge_getDecoderPluginStats(JNIEnv* env, jobject) {
+    return env->NewStringUTF(DecoderPluginLoader::getInstance().statsSummary().c_str());
+}
@@ -0,0 +1,147 @@
+#include "SpectrumAnalyzer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+constexpr float kMinDisplayHz = 35.0f;
+constexpr float kBarGain = 68.0f;
+constexpr int kHalfSizeBits = 10; // log2(1024)
+
+float tiltCompensation(float freqNorm) {
+    const float clamped = std::clamp(freqNorm, 0.0f, 1.0f);
+    const float shaped = std::pow(clamped, 0.85f);
+    // Attenuate low-end dominance while preserving high-band detail.
+    return 0.24f + (1.76f * shaped);
+}
+}
+
+SpectrumAnalyzer::SpectrumAnalyzer() {
+    const double invSizeMinusOne = 1.0 / static_cast<double>(kFftSize - 1);
+    for (int n = 0; n < kFftSize; ++n) {
+        hann[n] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * M_PI * static_cast<double>(n) * invSizeMinusOne));
+    }
+    for (int i = 0; i < kHalfSize; ++i) {
+        int x = i;
+        int reversed = 0;
+        for (int bit = 0; bit < kHalfSizeBits; ++bit) {
+            reversed = (reversed << 1) | (x & 1);
+            x >>= 1;
+        }
+        bitReverse[i] = reversed;
+    }
+    for (int k = 0; k < kHalfSize / 2; ++k) {
+        const double theta = -2.0 * M_PI * static_cast<double>(k) / static_cast<double>(kHalfSize);
+        twiddleRe[k] = static_cast<float>(std::cos(theta));
+        twiddleIm[k] = static_cast<float>(std::sin(theta));
+    }
+    for (int k = 0; k < kHalfSize; ++k) {
+        const double theta = -2.0 * M_PI * static_cast<double>(k) / static_cast<double>(kFftSize);
+        splitRe[k] = static_cast<float>(std::cos(theta));
+        splitIm[k] = static_cast<float>(std::sin(theta));
+    }
+}
+
+void SpectrumAnalyzer::prepareBands(int sampleRateHz) {
+    bandsSampleRate = sampleRateHz;
+    const float sampleRate = static_cast<float>(std::max(sampleRateHz, 1));
+    const float rawMinBin = (kMinDisplayHz / sampleRate) * static_cast<float>(kFftSize);
+    const int minBin = std::clamp(static_cast<int>(std::ceil(rawMinBin)), 1, kHalfSize - 2);
+    const int maxBin = kHalfSize - 1;
+    const float minFrequencyHz = (static_cast<float>(minBin) * sampleRate) / static_cast<float>(kFftSize);
+    const float maxFrequencyHz = (static_cast<float>(maxBin) * sampleRate) / static_cast<float>(kFftSize);
+    const float frequencyRatio = std::max(maxFrequencyHz / std::max(minFrequencyHz, 1.0f), 1.001f);
+    for (int band = 0; band < kBands; ++band) {
+        const float t0 = static_cast<float>(band) / static_cast<float>(kBands);
+        const float t1 = static_cast<float>(band + 1) / static_cast<float>(kBands);
+        const float startFrequencyHz = minFrequencyHz * std::pow(frequencyRatio, t0);
+        const float endFrequencyHz = minFrequencyHz * std::pow(frequencyRatio, t1);
+        const int startBin = static_cast<int>(std::floor((startFrequencyHz / sampleRate) * static_cast<float>(kFftSize)));
+        const int endBin = static_cast<int>(std::ceil((endFrequencyHz / sampleRate) * static_cast<float>(kFftSize))) - 1;
+        const int clampedStart = std::clamp(startBin, minBin, maxBin);
+        const int clampedEnd = std::clamp(std::max(endBin, clampedStart), clampedStart, maxBin);
+        bandStart[band] = clampedStart;
+        bandEnd[band] = clampedEnd;
+        bandInvCount[band] = 1.0f / static_cast<float>(clampedEnd - clampedStart + 1);
+        bandWeight[band] = (kBarGain * tiltCompensation(t0)) / static_cast<float>(kFftSize);
+    }
+}
+
+void SpectrumAnalyzer::complexFft() {
+    for (int i = 0; i < kHalfSize; ++i) {
+        const int j = bitReverse[i];
+        if (j > i) {
+            std::swap(workRe[i], workRe[j]);
+            std::swap(workIm[i], workIm[j]);
+        }
+    }
+    for (int len = 2, twiddleStride = kHalfSize / 2; len <= kHalfSize; len <<= 1, twiddleStride >>= 1) {
+        const int halfLen = len >> 1;
+        for (int i = 0; i < kHalfSize; i += len) {
+            float* evenRe = workRe.data() + i;
+            float* evenIm = workIm.data() + i;
+            float* oddRe = evenRe + halfLen;
+            float* oddIm = evenIm + halfLen;
+            for (int j = 0; j < halfLen; ++j) {
+                const float wRe = twiddleRe[j * twiddleStride];
+                const float wIm = twiddleIm[j * twiddleStride];
+                const float tRe = (wRe * oddRe[j]) - (wIm * oddIm[j]);
+                const float tIm = (wRe * oddIm[j]) + (wIm * oddRe[j]);
+                oddRe[j] = evenRe[j] - tRe;
+                oddIm[j] = evenIm[j] - tIm;
+                evenRe[j] += tRe;
+                evenIm[j] += tIm;
+            }
+        }
+    }
+}
+
+void SpectrumAnalyzer::analyze(const float* window, int sampleRateHz, std::array<float, kBands>& bars) {
+    if (sampleRateHz != bandsSampleRate) {
+        prepareBands(sampleRateHz);
+    }
+
+    // Remove DC and apply the Hann window, packing even/odd samples into the
+    // real/imaginary halves of the half-size complex input.
+    double sum = 0.0;
+    for (int n = 0; n < kFftSize; ++n) {
+        sum += window[n];
+    }
+    const float mean = static_cast<float>(sum / static_cast<double>(kFftSize));
+    for (int n = 0; n < kHalfSize; ++n) {
+        workRe[n] = (window[2 * n] - mean) * hann[2 * n];
+        workIm[n] = (window[2 * n + 1] - mean) * hann[2 * n + 1];
+    }
+
+    complexFft();
+
+    // Split the packed transform into bins 1..kHalfSize-1 of the real FFT.
+    for (int k = 1; k < kHalfSize; ++k) {
+        // zm = conj(Z[N/2 - k]); even = (Z[k] + zm) / 2, odd = (Z[k] - zm) / 2i.
+        const float zkRe = workRe[k];
+        const float zkIm = workIm[k];
+        const float zmRe = workRe[kHalfSize - k];
+        const float zmIm = -workIm[kHalfSize - k];
+        const float evenRe = 0.5f * (zkRe + zmRe);
+        const float evenIm = 0.5f * (zkIm + zmIm);
+        const float oddRe = 0.5f * (zkIm - zmIm);
+        const float oddIm = -0.5f * (zkRe - zmRe);
+        const float re = evenRe + (splitRe[k] * oddRe) - (splitIm[k] * oddIm);
+        const float im = evenIm + (splitRe[k] * oddIm) + (splitIm[k] * oddRe);
+        power[k] = (re * re) + (im * im);
+    }
+
+    for (int band = 0; band < kBands; ++band) {
+        float powerSum = 0.0f;
+        for (int bin = bandStart[band]; bin <= bandEnd[band]; ++bin) {
+            powerSum += power[bin];
+        }
+        const float weighted = std::sqrt(powerSum * bandInvCount[band]) * bandWeight[band];
+        // Soft knee prevents early saturation while preserving detail.
+        bars[band] = std::clamp(weighted / (1.0f + weighted), 0.0f, 1.0f);
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef SILICONPLAYER_SPECTRUM_ANALYZER_H
+#define SILICONPLAYER_SPECTRUM_ANALYZER_H
+
+#include <array>
+
+// Log-spaced bar spectrum for the Bars visualization.
+//
+// A 2048-point real-input FFT (a 1024-point complex FFT plus a split pass)
+// over a DC-removed, Hann-windowed mono window. Twiddles, window and the
+// bit-reversal table are built once; the band-to-bin ranges and per-band
+// weights are rebuilt only when the sample rate changes.
+//
+// Not thread-safe; callers serialize analyze().
+class SpectrumAnalyzer {
+public:
+    static constexpr int kFftSize = 2048;
+    static constexpr int kBands = 256;
+
+    SpectrumAnalyzer();
+
+    // window holds kFftSize mono samples, oldest first.
+    void analyze(const float* window, int sampleRateHz, std::array<float, kBands>& bars);
+
+private:
+    static constexpr int kHalfSize = kFftSize / 2;
+
+    void prepareBands(int sampleRateHz);
+    void complexFft();
+
+    std::array<float, kFftSize> hann {};
+    std::array<int, kHalfSize> bitReverse {};
+    // Split real/imaginary arrays keep the butterflies in plain float lanes.
+    std::array<float, kHalfSize / 2> twiddleRe {}; // e^(-2 pi i k / kHalfSize)
+    std::array<float, kHalfSize / 2> twiddleIm {};
+    std::array<float, kHalfSize> splitRe {}; // e^(-2 pi i k / kFftSize)
+    std::array<float, kHalfSize> splitIm {};
+    std::array<float, kHalfSize> workRe {};
+    std::array<float, kHalfSize> workIm {};
+    std::array<float, kHalfSize> power {};
+
+    int bandsSampleRate = 0;
+    std::array<int, kBands> bandStart {};
+    std::array<int, kBands> bandEnd {};
+    std::array<float, kBands> bandInvCount {};
+    std::array<float, kBands> bandWeight {};
+};
+
+#endif // SILICONPLAYER_SPECTRUM_ANALYZER_H
@@ -0,0 +1,291 @@
+// cRSID quality-mode throughput and null test.
+//
+// Renders a SID tune through each cRSID quality mode (light, high, sinc) with
+// one, two and three SIDs and reports how much faster than realtime it runs.
+// The SID count is forced by rewriting the PSID header: SID2 and SID3 are
+// mapped onto $D400 as well, so every chip plays the real tune (with the
+// stereo routing of a 2SID/3SID file) instead of idling on silent registers.
+//
+// The same source is built twice: siliconplayer_crsid_quality_bench with the
+// SIMD filter/resampler lanes (CRSID_SIMD default) and
+// siliconplayer_crsid_quality_bench_scalar with CRSID_SIMD=0. --dump writes
+// the stereo PCM and the per-voice scope planes of every run to a directory,
+// --compare checks them against an earlier dump, e.g.
+//
+//   siliconplayer_crsid_quality_bench_scalar --dump /tmp/crsid-ref
+//   siliconplayer_crsid_quality_bench --compare /tmp/crsid-ref
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wregister"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wregister"
+#endif
+extern "C" {
+#include <crsid/libcRSID.h>
+}
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace {
+
+constexpr int kSampleRate = 48000;
+constexpr int kBlockFrames = 512;
+constexpr int kVoicePlanesPerSid = 4;
+constexpr int kMaxSids = 3;
+// PSID v4 header fields (offsets into the file).
+constexpr size_t kVersionOffset = 0x04;
+constexpr size_t kSid2AddressOffset = 0x7A;
+constexpr size_t kSid3AddressOffset = 0x7B;
+constexpr size_t kHeaderSize = 0x7C;
+
+// Thread CPU time: on a shared or throttled core wall time swings more
+// than the differences being measured.
+double threadCpuSeconds() {
+    timespec now {};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return static_cast<double>(now.tv_sec) + static_cast<double>(now.tv_nsec) * 1e-9;
+}
+
+struct Mode {
+    const char* name;
+    unsigned char highQualitySid;
+    unsigned char highQualityResampler;
+};
+
+constexpr Mode kModes[] = {
+        { "light", 0, 0 },
+        { "high", 1, 0 },
+        { "sinc", 1, 1 },
+};
+
+struct Options {
+    std::string tune;
+    double seconds = 60.0;
+    int runs = 3;
+    std::vector<std::string> modes;
+    std::vector<int> sidCounts;
+    std::string dumpDir;
+    std::string compareDir;
+};
+
+bool readFile(const std::string& path, std::vector<unsigned char>& data) {
+    std::ifstream input(path, std::ios::binary);
+    if (!input) return false;
+    data.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    return true;
+}
+
+std::vector<unsigned char> withSidCount(std::vector<unsigned char> tune, int sids) {
+    tune[kVersionOffset] = 0;
+    tune[kVersionOffset + 1] = 4;
+    tune[kSid2AddressOffset] = sids >= 2 ? 0x40 : 0;
+    tune[kSid3AddressOffset] = sids >= 3 ? 0x40 : 0;
+    return tune;
+}
+
+struct Run {
+    double seconds = 0.0;
+    std::vector<int16_t> pcm;
+    std::vector<int32_t> voices;
+};
+
+// Renders options.seconds of audio; the output is kept only when asked for.
+bool render(const std::vector<unsigned char>& tune, const Mode& mode, const Options& options, bool keep, Run& run) {
+    cRSID_C64instance* emulator = cRSID_newC64();
+    if (emulator == nullptr || cRSID_initC64(emulator, kSampleRate, kBlockFrames) == nullptr) {
+        cRSID_deleteC64(emulator);
+        return false;
+    }
+    cRSID_Interface* crsid = cRSID_getInterfaceC64(emulator);
+    crsid->AutoAdvance = 0;
+    crsid->AutoExit = 0;
+    crsid->FadeOut = 0;
+    crsid->PlaybackSpeed = 1;
+    crsid->MainVolume = 255;
+    crsid->Stereo = CRSID_CHANNELMODE_STEREO;
+    crsid->HighQualitySID = mode.highQualitySid;
+    crsid->HighQualityResampler = mode.highQualityResampler;
+
+    // cRSID keeps a pointer into the file data.
+    std::vector<unsigned char> data = tune;
+    cRSID_SIDheader* header = cRSID_processSIDfileDataC64(emulator, data.data(), static_cast<int>(data.size()));
+    if (header == nullptr) {
+        cRSID_closeC64(emulator);
+        cRSID_deleteC64(emulator);
+        return false;
+    }
+    cRSID_initSIDtuneC64(emulator, header, 1);
+    cRSID_playSIDtuneC64(emulator);
+
+    const int64_t totalFrames = static_cast<int64_t>(options.seconds * kSampleRate);
+    std::vector<int16_t> pcm(static_cast<size_t>(kBlockFrames) * 2);
+    std::vector<int32_t> voices(static_cast<size_t>(kMaxSids * kVoicePlanesPerSid * kBlockFrames));
+    run.pcm.clear();
+    run.voices.clear();
+    const double start = threadCpuSeconds();
+    for (int64_t done = 0; done < totalFrames; done += kBlockFrames) {
+        const int frames = static_cast<int>(std::min<int64_t>(kBlockFrames, totalFrames - done));
+        cRSID_generateSamplesC64(emulator, pcm.data(), frames, voices.data(), kBlockFrames);
+        if (keep) {
+            run.pcm.insert(run.pcm.end(), pcm.begin(), pcm.begin() + frames * 2);
+            for (int plane = 0; plane < kMaxSids * kVoicePlanesPerSid; ++plane) {
+                const int32_t* planeData = voices.data() + static_cast<size_t>(plane) * kBlockFrames;
+                run.voices.insert(run.voices.end(), planeData, planeData + frames);
+            }
+        }
+    }
+    run.seconds = threadCpuSeconds() - start;
+    cRSID_closeC64(emulator);
+    cRSID_deleteC64(emulator);
+    return true;
+}
+
+std::string dumpPath(const std::string& dir, const Mode& mode, int sids) {
+    return dir + "/crsid_" + mode.name + "_" + std::to_string(sids) + "sid.raw";
+}
+
+bool writeDump(const std::string& path, const Run& run) {
+    std::ofstream output(path, std::ios::binary);
+    output.write(reinterpret_cast<const char*>(run.pcm.data()), static_cast<std::streamsize>(run.pcm.size() * sizeof(int16_t)));
+    output.write(reinterpret_cast<const char*>(run.voices.data()), static_cast<std::streamsize>(run.voices.size() * sizeof(int32_t)));
+    return static_cast<bool>(output);
+}
+
+// Prints the PCM and scope-plane difference against a dump; true when equal.
+bool compareDump(const std::string& path, const Run& run) {
+    std::vector<unsigned char> reference;
+    const size_t pcmBytes = run.pcm.size() * sizeof(int16_t);
+    const size_t voiceBytes = run.voices.size() * sizeof(int32_t);
+    if (!readFile(path, reference) || reference.size() != pcmBytes + voiceBytes) {
+        std::printf("  %s: missing or different length\n", path.c_str());
+        return false;
+    }
+    int maxPcmDiff = 0;
+    size_t pcmMismatches = 0;
+    for (size_t i = 0; i < run.pcm.size(); ++i) {
+        int16_t value;
+        std::memcpy(&value, reference.data() + i * sizeof(int16_t), sizeof(value));
+        const int diff = std::abs(static_cast<int>(value) - run.pcm[i]);
+        maxPcmDiff = std::max(maxPcmDiff, diff);
+        pcmMismatches += diff != 0;
+    }
+    int64_t maxVoiceDiff = 0;
+    size_t voiceMismatches = 0;
+    for (size_t i = 0; i < run.voices.size(); ++i) {
+        int32_t value;
+        std::memcpy(&value, reference.data() + pcmBytes + i * sizeof(int32_t), sizeof(value));
+        const int64_t diff = std::llabs(static_cast<int64_t>(value) - run.voices[i]);
+        maxVoiceDiff = std::max(maxVoiceDiff, diff);
+        voiceMismatches += diff != 0;
+    }
+    std::printf("  pcm: %zu/%zu samples differ (max %d)   scope: %zu/%zu differ (max %lld)\n",
+                pcmMismatches, run.pcm.size(), maxPcmDiff,
+                voiceMismatches, run.voices.size(), static_cast<long long>(maxVoiceDiff));
+    return pcmMismatches == 0 && voiceMismatches == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--tune" && i + 1 < argc) {
+            options.tune = argv[++i];
+        } else if (arg == "--seconds" && i + 1 < argc) {
+            options.seconds = std::max(1.0, std::atof(argv[++i]));
+        } else if (arg == "--runs" && i + 1 < argc) {
+            options.runs = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--mode" && i + 1 < argc) {
+            options.modes.emplace_back(argv[++i]);
+        } else if (arg == "--sids" && i + 1 < argc) {
+            options.sidCounts.push_back(std::clamp(std::atoi(argv[++i]), 1, kMaxSids));
+        } else if (arg == "--dump" && i + 1 < argc) {
+            options.dumpDir = argv[++i];
+        } else if (arg == "--compare" && i + 1 < argc) {
+            options.compareDir = argv[++i];
+        } else {
+            std::printf(
+                    "usage: siliconplayer_crsid_quality_bench [--tune FILE.sid] [--seconds S] [--runs N]\n"
+                    "       [--mode light|high|sinc]... [--sids 1|2|3]... [--dump DIR | --compare DIR]\n"
+                    "Renders S seconds (default 60) of the tune per quality mode and SID count and\n"
+                    "reports the best of N runs. --dump/--compare write or check the rendered PCM\n"
+                    "and scope planes, to null-test the SIMD build against the _scalar one.\n"
+            );
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+#ifdef SILICONPLAYER_BENCH_DEFAULT_TUNE
+    if (options.tune.empty()) {
+        options.tune = SILICONPLAYER_BENCH_DEFAULT_TUNE;
+    }
+#endif
+    if (options.modes.empty()) {
+        for (const Mode& mode : kModes) options.modes.emplace_back(mode.name);
+    }
+    if (options.sidCounts.empty()) {
+        options.sidCounts = { 1, 2, 3 };
+    }
+    std::vector<unsigned char> tune;
+    if (!readFile(options.tune, tune) || tune.size() <= kHeaderSize) {
+        std::fprintf(stderr, "could not read a PSID file from '%s'\n", options.tune.c_str());
+        return 1;
+    }
+
+    std::printf("%s, %.0f s at %d Hz, best of %d\n", options.tune.c_str(), options.seconds, kSampleRate, options.runs);
+    std::printf("%-6s %5s %13s %12s\n", "mode", "sids", "cpu ns/frame", "x realtime");
+    bool identical = true;
+    for (const std::string& modeName : options.modes) {
+        const Mode* mode = nullptr;
+        for (const Mode& candidate : kModes) {
+            if (modeName == candidate.name) mode = &candidate;
+        }
+        if (mode == nullptr) {
+            std::fprintf(stderr, "unknown mode '%s'\n", modeName.c_str());
+            return 1;
+        }
+        for (const int sids : options.sidCounts) {
+            const std::vector<unsigned char> variant = withSidCount(tune, sids);
+            const bool keep = !options.dumpDir.empty() || !options.compareDir.empty();
+            double best = 0.0;
+            Run kept;
+            for (int pass = 0; pass < options.runs; ++pass) {
+                Run run;
+                if (!render(variant, *mode, options, keep && pass == 0, run)) {
+                    std::fprintf(stderr, "cRSID could not play '%s'\n", options.tune.c_str());
+                    return 1;
+                }
+                best = pass == 0 ? run.seconds : std::min(best, run.seconds);
+                if (pass == 0) kept = std::move(run);
+            }
+            const double frames = options.seconds * kSampleRate;
+            std::printf("%-6s %5d %13.1f %12.1f\n", mode->name, sids, best * 1e9 / frames, options.seconds / best);
+            if (!options.dumpDir.empty() && !writeDump(dumpPath(options.dumpDir, *mode, sids), kept)) {
+                std::fprintf(stderr, "could not write to '%s'\n", options.dumpDir.c_str());
+                return 1;
+            }
+            if (!options.compareDir.empty()) {
+                identical = compareDump(dumpPath(options.compareDir, *mode, sids), kept) && identical;
+            }
+            std::fflush(stdout);
+        }
+    }
+    return identical ? 0 : 2;
+}
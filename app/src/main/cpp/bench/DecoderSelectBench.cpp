@@ -0,0 +1,450 @@
+// Decoder selection benchmark over a synthetic library.
+//
+// Writes a corpus of small files (default 50k) whose headers carry the real
+// signatures of the formats the app plays, named the way real collections
+// are: mostly with the right extension, Amiga modules partly in prefix style
+// ("mod.title"), and a share misnamed or with no extension at all. UADE-only
+// formats without a usable signature are mixed in. The decoders are
+// registered with the app's names, priorities and extension lists; their
+// factories return stand-ins whose open() succeeds only for content the
+// real core accepts, so probe() counts the trial opens selection causes.
+//
+// Modes:
+//   legacy  the previous per-call linear scan over every decoder's
+//           extension list, by name only
+//   index   DecoderRegistry's hashed index, by name only (remote-style
+//           paths, which are never sniffed)
+//   sniff   index plus the signature sniffer on the local file (page cache
+//           warm: the corpus was just written)
+
+#include "decoders/DecoderRegistry.h"
+#include "decoders/DecoderSignatureSniffer.h"
+#include "decoders/UadeExtensions.h"
+
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+constexpr const char* kRemotePrefix = "smb://bench/";
+
+struct Format {
+    const char* extension;
+    // Decoders whose open() accepts the content, in no particular order.
+    std::vector<std::string> acceptedBy;
+    std::vector<uint8_t> (*build)(std::mt19937& rng);
+    bool amigaPrefix;
+};
+
+struct CorpusFile {
+    std::string name;
+    const Format* format;
+};
+
+std::vector<uint8_t> withMagic(const char* magic, size_t offset, size_t size, std::mt19937& rng) {
+    std::vector<uint8_t> bytes(size);
+    for (uint8_t& byte : bytes) {
+        byte = static_cast<uint8_t>(rng() & 0x7f);
+    }
+    std::memcpy(bytes.data() + offset, magic, std::strlen(magic));
+    return bytes;
+}
+
+std::vector<uint8_t> compress(const std::vector<uint8_t>& input, int windowBits) {
+    z_stream stream {};
+    deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY);
+    std::vector<uint8_t> output(deflateBound(&stream, input.size()) + 32);
+    stream.next_in = const_cast<Bytef*>(input.data());
+    stream.avail_in = static_cast<uInt>(input.size());
+    stream.next_out = output.data();
+    stream.avail_out = static_cast<uInt>(output.size());
+    deflate(&stream, Z_FINISH);
+    output.resize(output.size() - stream.avail_out);
+    deflateEnd(&stream);
+    return output;
+}
+
+const std::vector<Format>& formats() {
+    static const std::vector<Format> list = {
+            { "sid", { "cRSID", "LibSIDPlayFP" }, [](std::mt19937& r) { return withMagic("PSID", 0, 512, r); }, false },
+            { "sndh", { "SC68" }, [](std::mt19937& r) { return withMagic("SNDH", 12, 512, r); }, false },
+            { "vgm", { "VGMPlay", "Game Music Emu" }, [](std::mt19937& r) { return withMagic("Vgm ", 0, 512, r); }, false },
+            { "vgz", { "VGMPlay", "Game Music Emu" }, [](std::mt19937& r) {
+                return compress(withMagic("Vgm ", 0, 512, r), 15 + 16);
+            }, false },
+            { "nsf", { "Game Music Emu" }, [](std::mt19937& r) { return withMagic("NESM\x1a", 0, 256, r); }, false },
+            { "spc", { "Game Music Emu" }, [](std::mt19937& r) {
+                return withMagic("SNES-SPC700 Sound File Data v0.30", 0, 512, r);
+            }, false },
+            { "it", { "LibOpenMPT" }, [](std::mt19937& r) { return withMagic("IMPM", 0, 512, r); }, false },
+            { "xm", { "LibOpenMPT" }, [](std::mt19937& r) { return withMagic("Extended Module: ", 0, 512, r); }, false },
+            { "s3m", { "LibOpenMPT" }, [](std::mt19937& r) { return withMagic("SCRM", 44, 512, r); }, false },
+            { "mod", { "LibOpenMPT", "UADE" }, [](std::mt19937& r) { return withMagic("M.K.", 1080, 1600, r); }, true },
+            { "ahx", { "HivelyTracker", "UADE" }, [](std::mt19937& r) {
+                auto bytes = withMagic("THX", 0, 512, r);
+                bytes[3] = 0;
+                return bytes;
+            }, false },
+            { "hvl", { "HivelyTracker" }, [](std::mt19937& r) {
+                auto bytes = withMagic("HVL", 0, 512, r);
+                bytes[3] = 1;
+                return bytes;
+            }, false },
+            { "fur", { "Furnace" }, [](std::mt19937& r) {
+                return compress(withMagic("-Furnace module-", 0, 512, r), 15);
+            }, false },
+            // DefleMask; OpenMPT's "dmf" is X-Tracker and rejects it.
+            { "dmf", { "Furnace" }, [](std::mt19937& r) {
+                return compress(withMagic(".DelekDefleMask.", 0, 512, r), 15);
+            }, false },
+            { "usf", { "LazyUSF2" }, [](std::mt19937& r) { return withMagic("PSF\x21", 0, 256, r); }, false },
+            { "kt", { "Klystrack-plus" }, [](std::mt19937& r) { return withMagic("cyd!song", 0, 256, r); }, false },
+            { "flac", { "FFmpeg" }, [](std::mt19937& r) { return withMagic("fLaC", 0, 256, r); }, false },
+            { "ogg", { "FFmpeg" }, [](std::mt19937& r) { return withMagic("OggS", 0, 256, r); }, false },
+            { "mp3", { "FFmpeg" }, [](std::mt19937& r) { return withMagic("ID3", 0, 256, r); }, false },
+            { "wav", { "FFmpeg" }, [](std::mt19937& r) {
+                auto bytes = withMagic("RIFF", 0, 256, r);
+                std::memcpy(bytes.data() + 8, "WAVE", 4);
+                return bytes;
+            }, false },
+            // UADE-only player formats; nothing to sniff.
+            { "mdat", { "UADE" }, [](std::mt19937& r) { return withMagic("", 0, 512, r); }, true },
+            { "cust", { "UADE" }, [](std::mt19937& r) { return withMagic("", 0, 512, r); }, true },
+            { "bp", { "UADE" }, [](std::mt19937& r) { return withMagic("", 0, 512, r); }, true },
+    };
+    return list;
+}
+
+std::unordered_map<std::string, const Format*> gTruth; // file name -> format
+std::atomic<uint64_t> gOpens { 0 };
+
+std::string fileNameOf(const char* path) {
+    const char* slash = std::strrchr(path, '/');
+    return slash ? slash + 1 : path;
+}
+
+class StandInDecoder : public AudioDecoder {
+public:
+    explicit StandInDecoder(std::string name) : name(std::move(name)) {}
+    bool open(const char* path) override {
+        gOpens.fetch_add(1, std::memory_order_relaxed);
+        const auto it = gTruth.find(fileNameOf(path));
+        if (it == gTruth.end()) return false;
+        const auto& accepted = it->second->acceptedBy;
+        return std::find(accepted.begin(), accepted.end(), name) != accepted.end();
+    }
+    void close() override {}
+    int read(float*, int) override { return 0; }
+    void seek(double) override {}
+    double getDuration() override { return 0.0; }
+    int getSampleRate() override { return 48000; }
+    int getChannelCount() override { return 2; }
+    std::string getTitle() override { return ""; }
+    std::string getArtist() override { return ""; }
+    const char* getName() const override { return name.c_str(); }
+
+private:
+    std::string name;
+};
+
+void registerDecoders() {
+    struct Entry {
+        const char* name;
+        std::vector<std::string> extensions;
+        int priority;
+    };
+    const std::vector<Entry> entries = {
+            { "FFmpeg", {
+                    "3g2", "3gp", "aa", "aac", "ac3", "aif", "aifc", "aiff", "alac",
+                    "amr", "ape", "asf", "au", "caf", "dts", "dsf", "eac3", "flac",
+                    "m4a", "m4b", "m4p", "m4r", "mka", "mkv", "mov", "mp2", "mp3",
+                    "mp4", "mpc", "oga", "ogg", "opus", "qcp", "ra", "tta", "voc",
+                    "w64", "wav", "weba", "webm", "wma", "wmv", "wv", "xwma" }, 0 },
+            { "cRSID", { "sid", "psid", "rsid" }, 4 },
+            { "VGMPlay", { "vgm", "vgz", "vgm.gz" }, 5 },
+            { "Game Music Emu", { "ay", "gbs", "gym", "hes", "kss", "nsf", "nsfe", "sap", "spc", "vgm", "vgz" }, 6 },
+            { "LibSIDPlayFP", { "sid", "psid", "rsid", "mus", "str", "prg", "p00", "c64", "dat" }, 7 },
+            { "LazyUSF2", { "usf", "miniusf" }, 8 },
+            { "Vio2SF", { "2sf", "mini2sf" }, 9 },
+            { "LibOpenMPT", {
+                    "669", "amf", "ams", "c67", "dbm", "digi", "dmf", "dsm", "dtm",
+                    "far", "gdm", "ice", "imf", "it", "j2b", "m15", "mdl", "med",
+                    "mms", "mod", "mt2", "mtm", "nst", "okt", "plm", "psm", "pt36",
+                    "s3m", "sfx", "sfx2", "st26", "stk", "stm", "stp", "symmod",
+                    "ult", "umx", "wow", "xm" }, 10 },
+            { "SC68", { "sc68", "sndh" }, 11 },
+            { "AdPlug", {
+                    "hsc", "sng", "imf", "wlf", "adlib", "a2m", "a2t", "xms",
+                    "bam", "cmf", "adl", "d00", "dfm", "hsp", "ksm", "mad",
+                    "mus", "mdy", "ims", "mdi", "mid", "sci", "laa", "mkj",
+                    "cff", "dmo", "s3m", "dtm", "mtk", "mtr", "rad", "rac",
+                    "raw", "sat", "sa2", "xad", "lds", "plx", "m", "rol",
+                    "xsm", "dro", "pis", "msc", "rix", "mkf", "jbm", "got",
+                    "vgm", "vgz", "sop", "hsq", "sqx", "sdb", "agd", "ha2" }, 12 },
+            { "HivelyTracker", { "ahx", "hvl" }, 13 },
+            { "UADE", getUadeSupportedExtensions(), 14 },
+            { "Klystrack-plus", { "kt" }, 15 },
+            { "Furnace", { "fur", "dmf" }, 16 },
+    };
+    for (const Entry& entry : entries) {
+        const std::string name = entry.name;
+        DecoderRegistry::getInstance().registerDecoder(name, entry.extensions, [name]() {
+            return std::unique_ptr<AudioDecoder>(new StandInDecoder(name));
+        }, entry.priority);
+    }
+}
+
+// The registry's matching before the index: every decoder's list scanned and
+// lowercased per candidate extension.
+class LegacySelector {
+public:
+    LegacySelector() {
+        DecoderRegistry& registry = DecoderRegistry::getInstance();
+        for (const std::string& name : registry.getRegisteredDecoderNames()) {
+            decoders.push_back({ name, registry.getDecoderSupportedExtensions(name) });
+        }
+    }
+
+    std::vector<std::string> candidates(const std::string& fileName) const {
+        std::vector<std::string> out;
+        for (const std::string& extension : extensionCandidates(fileName)) {
+            for (const auto& decoder : decoders) {
+                bool supported = false;
+                for (const std::string& ext : decoder.extensions) {
+                    if (lower(ext) == extension) {
+                        supported = true;
+                        break;
+                    }
+                }
+                if (supported && std::find(out.begin(), out.end(), decoder.name) == out.end()) {
+                    out.push_back(decoder.name);
+                }
+            }
+        }
+        return out;
+    }
+
+private:
+    struct Decoder {
+        std::string name;
+        std::vector<std::string> extensions;
+    };
+
+    static std::string lower(std::string value) {
+        for (char& c : value) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        return value;
+    }
+
+    static std::vector<std::string> extensionCandidates(const std::string& baseName) {
+        std::vector<std::string> raw;
+        const size_t firstDot = baseName.find('.');
+        const size_t lastDot = baseName.rfind('.');
+        if (lastDot != std::string::npos && lastDot > 0 && lastDot + 1 < baseName.size()) {
+            raw.push_back(baseName.substr(lastDot + 1));
+        }
+        if (lastDot != std::string::npos && lastDot > 0) {
+            const size_t secondLastDot = baseName.rfind('.', lastDot - 1);
+            if (secondLastDot != std::string::npos && secondLastDot < lastDot) {
+                raw.push_back(baseName.substr(secondLastDot + 1));
+            }
+        }
+        if (firstDot != std::string::npos && firstDot > 0) {
+            raw.push_back(baseName.substr(0, firstDot));
+        }
+        std::vector<std::string> out;
+        for (std::string& candidate : raw) {
+            candidate = lower(candidate);
+            if (!candidate.empty() && std::find(out.begin(), out.end(), candidate) == out.end()) {
+                out.push_back(candidate);
+            }
+        }
+        return out;
+    }
+
+    std::vector<Decoder> decoders;
+};
+
+std::vector<CorpusFile> writeCorpus(const std::filesystem::path& dir, int count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    const auto& list = formats();
+    std::vector<CorpusFile> files;
+    files.reserve(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) {
+        const Format& format = list[rng() % list.size()];
+        const std::string stem = "track" + std::to_string(i);
+        const uint32_t naming = rng() % 100;
+        std::string name;
+        if (naming < 80) {
+            name = format.amigaPrefix && (rng() & 1) ? std::string(format.extension) + "." + stem
+                                                     : stem + "." + format.extension;
+        } else if (naming < 90) {
+            // Misnamed: another format's extension or a generic one.
+            const Format& other = list[rng() % list.size()];
+            name = stem + "." + (&other == &format || (rng() & 1) ? "bin" : other.extension);
+        } else {
+            name = stem;
+        }
+        const std::vector<uint8_t> bytes = format.build(rng);
+        std::ofstream out(dir / name, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        files.push_back({ name, &format });
+        gTruth[name] = &format;
+    }
+    return files;
+}
+
+// First decoder by priority that accepts the content: what a correctly
+// named file routes to.
+std::string preferredDecoder(const Format& format) {
+    for (const std::string& name : DecoderRegistry::getInstance().getRegisteredDecoderNames()) {
+        if (std::find(format.acceptedBy.begin(), format.acceptedBy.end(), name) != format.acceptedBy.end()) {
+            return name;
+        }
+    }
+    return "";
+}
+
+struct ModeResult {
+    double selectUs = 0.0;
+    int preferred = 0;
+    int opened = 0;
+    uint64_t opens = 0;
+};
+
+void printResult(const char* mode, const ModeResult& result, size_t files) {
+    std::printf(
+            "%-7s %9.2f %9.1f%% %9.1f%% %8.3f %12llu\n",
+            mode,
+            result.selectUs,
+            100.0 * result.preferred / static_cast<double>(files),
+            100.0 * result.opened / static_cast<double>(files),
+            result.opened > 0 ? static_cast<double>(result.opens) / result.opened : 0.0,
+            static_cast<unsigned long long>(result.opens - static_cast<uint64_t>(result.opened))
+    );
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int fileCount = 50000;
+    int rounds = 3;
+    uint32_t seed = 1234;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--files" && i + 1 < argc) {
+            fileCount = std::max(100, std::atoi(argv[++i]));
+        } else if (arg == "--rounds" && i + 1 < argc) {
+            rounds = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            std::printf(
+                    "usage: siliconplayer_decoder_select_bench [--files N] [--rounds N] [--seed N]\n"
+                    "Writes a synthetic library of N files (default 50000) to a temp dir and\n"
+                    "compares decoder selection by linear extension scan, by the registry's\n"
+                    "extension index, and by the index plus signature sniffing.\n"
+            );
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+
+    registerDecoders();
+    DecoderRegistry& registry = DecoderRegistry::getInstance();
+    const LegacySelector legacy;
+
+    namespace fs = std::filesystem;
+    const fs::path dir = fs::temp_directory_path() / ("sp_select_bench_" + std::to_string(getpid()));
+    fs::create_directories(dir);
+    const auto files = writeCorpus(dir, fileCount, seed);
+    std::vector<std::string> localPaths;
+    std::vector<std::string> remotePaths;
+    std::vector<std::string> preferred;
+    for (const CorpusFile& file : files) {
+        localPaths.push_back((dir / file.name).string());
+        remotePaths.push_back(kRemotePrefix + file.name);
+        preferred.push_back(preferredDecoder(*file.format));
+    }
+
+    // Selection time: best of several rounds, name of the first candidate only.
+    const auto timeSelection = [&](auto&& select) {
+        double best = 1e30;
+        for (int round = 0; round < rounds; ++round) {
+            const auto start = Clock::now();
+            size_t checksum = 0;
+            for (size_t i = 0; i < files.size(); ++i) {
+                checksum += select(i).size();
+            }
+            const double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+            best = std::min(best, us / static_cast<double>(files.size()));
+            if (checksum == static_cast<size_t>(-1)) std::printf("%zu\n", checksum);
+        }
+        return best;
+    };
+
+    ModeResult legacyResult;
+    legacyResult.selectUs = timeSelection([&](size_t i) {
+        const auto candidates = legacy.candidates(files[i].name);
+        return candidates.empty() ? std::string() : candidates.front();
+    });
+    for (size_t i = 0; i < files.size(); ++i) {
+        const auto candidates = legacy.candidates(files[i].name);
+        if (!candidates.empty() && candidates.front() == preferred[i]) legacyResult.preferred += 1;
+        // probe(): trial open in candidate order until one succeeds.
+        for (const std::string& name : candidates) {
+            legacyResult.opens += 1;
+            if (StandInDecoder(name).open(files[i].name.c_str())) {
+                legacyResult.opened += 1;
+                break;
+            }
+        }
+    }
+
+    const auto runRegistry = [&](const std::vector<std::string>& paths) {
+        ModeResult result;
+        result.selectUs = timeSelection([&](size_t i) { return registry.resolveDecoderName(paths[i].c_str()); });
+        gOpens.store(0);
+        for (size_t i = 0; i < files.size(); ++i) {
+            if (registry.resolveDecoderName(paths[i].c_str()) == preferred[i]) result.preferred += 1;
+            if (registry.probe(paths[i].c_str()).status == DecoderProbeResult::Status::Ok) result.opened += 1;
+        }
+        result.opens = gOpens.load();
+        return result;
+    };
+    const ModeResult indexResult = runRegistry(remotePaths);
+    const ModeResult sniffResult = runRegistry(localPaths);
+
+    // The index has to pick exactly what the linear scan picked.
+    int mismatches = 0;
+    for (size_t i = 0; i < files.size(); ++i) {
+        const auto candidates = legacy.candidates(files[i].name);
+        const std::string expected = candidates.empty() ? std::string() : candidates.front();
+        if (registry.resolveDecoderName(remotePaths[i].c_str()) != expected) mismatches += 1;
+    }
+
+    std::printf("%zu files, %zu formats, %zu registered decoders\n",
+                files.size(), formats().size(), registry.getRegisteredDecoderNames().size());
+    std::printf("%-7s %9s %10s %10s %8s %12s\n",
+                "mode", "us/file", "preferred", "opened", "opens/ok", "failed opens");
+    printResult("legacy", legacyResult, files.size());
+    printResult("index", indexResult, files.size());
+    printResult("sniff", sniffResult, files.size());
+    std::printf("index vs linear scan first-choice mismatches: %d\n", mismatches);
+
+    fs::remove_all(dir);
+    return mismatches == 0 ? 0 : 1;
+}
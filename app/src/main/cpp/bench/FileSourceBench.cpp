@@ -0,0 +1,205 @@
+// Whole-file load benchmark: ifstream into a vector vs FileSource.
+//
+// For each file it runs both loaders in a fresh child process, holding
+// --holders loads of the same file at once (the playing decoder, a preloaded
+// next track and a duration analysis job), and reports:
+//   open us  - median wall time of one load plus a pass over every byte
+//              (page cache warm), microseconds
+//   anon KiB - anonymous (private heap) memory added by the held loads
+//   hwm KiB  - peak RSS of the child, file-backed pages included
+// Mapped pages show up in hwm but are clean page cache the kernel can drop;
+// anon is what the loads actually cost the app.
+//
+// Without file arguments a 64 MiB scratch file is written to /tmp.
+
+#include "FileSource.h"
+
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr size_t kScratchBytes = 64u << 20;
+
+volatile uint64_t checksumSink = 0;
+
+struct Sample {
+    double openUs = 0.0;
+    long anonKiB = 0;
+    long hwmKiB = 0;
+};
+
+int64_t monotonicNs() {
+    timespec ts {};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000ll + ts.tv_nsec;
+}
+
+long statusKiB(const char* field) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    const std::string prefix = std::string(field) + ":";
+    while (std::getline(status, line)) {
+        if (line.compare(0, prefix.size(), prefix) == 0) {
+            return std::atol(line.c_str() + prefix.size());
+        }
+    }
+    return 0;
+}
+
+// Touches every page the way a parser would, so neither loader gets away
+// with lazy work.
+uint64_t checksum(const uint8_t* data, size_t size) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < size; i += 64) {
+        sum += data[i];
+    }
+    return sum;
+}
+
+struct Load {
+    std::vector<char> heap;
+    std::shared_ptr<const FileSource> source;
+};
+
+bool load(const std::string& path, bool mapped, Load& out, uint64_t& sum) {
+    if (mapped) {
+        out.source = FileSource::open(path);
+        if (!out.source) {
+            return false;
+        }
+        sum += checksum(out.source->data(), out.source->size());
+        return true;
+    }
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    out.heap.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    sum += checksum(reinterpret_cast<const uint8_t*>(out.heap.data()), out.heap.size());
+    return !out.heap.empty();
+}
+
+// Runs in the child; the result goes back through a pipe.
+Sample measure(const std::string& path, bool mapped, int holders, int runs) {
+    Sample sample;
+    uint64_t sum = 0;
+    std::vector<double> times;
+    for (int run = 0; run < runs; ++run) {
+        Load scratch;
+        const int64_t start = monotonicNs();
+        if (!load(path, mapped, scratch, sum)) {
+            return sample;
+        }
+        times.push_back(static_cast<double>(monotonicNs() - start) / 1000.0);
+    }
+    std::sort(times.begin(), times.end());
+    sample.openUs = times[times.size() / 2];
+
+    const long anonBefore = statusKiB("RssAnon");
+    std::vector<Load> held(static_cast<size_t>(holders));
+    for (Load& entry : held) {
+        load(path, mapped, entry, sum);
+    }
+    sample.anonKiB = statusKiB("RssAnon") - anonBefore;
+    sample.hwmKiB = statusKiB("VmHWM");
+    checksumSink = sum;
+    return sample;
+}
+
+bool runChild(const std::string& path, bool mapped, int holders, int runs, Sample& sample) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return false;
+    }
+    const pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        const Sample result = measure(path, mapped, holders, runs);
+        const ssize_t written = write(fds[1], &result, sizeof(result));
+        _exit(written == static_cast<ssize_t>(sizeof(result)) ? 0 : 1);
+    }
+    close(fds[1]);
+    const bool ok = pid > 0 && read(fds[0], &sample, sizeof(sample)) == static_cast<ssize_t>(sizeof(sample));
+    close(fds[0]);
+    if (pid > 0) {
+        int status = 0;
+        waitpid(pid, &status, 0);
+    }
+    return ok && sample.openUs > 0.0;
+}
+
+std::string writeScratchFile() {
+    const std::string path = "/tmp/siliconplayer_file_source_bench.bin";
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    std::vector<char> block(1u << 20);
+    uint32_t seed = 1u;
+    for (size_t written = 0; written < kScratchBytes; written += block.size()) {
+        for (char& byte : block) {
+            seed = seed * 1664525u + 1013904223u;
+            byte = static_cast<char>(seed >> 24);
+        }
+        file.write(block.data(), static_cast<std::streamsize>(block.size()));
+    }
+    return path;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int holders = 3;
+    int runs = 9;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--holders" && i + 1 < argc) {
+            holders = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--runs" && i + 1 < argc) {
+            runs = std::max(1, std::atoi(argv[++i]));
+        } else if (!arg.empty() && arg[0] != '-') {
+            paths.push_back(arg);
+        } else {
+            std::printf(
+                    "usage: siliconplayer_file_source_bench [--holders N] [--runs N] [file...]\n"
+                    "Compares whole-file loads through ifstream and FileSource: open\n"
+                    "latency, anonymous memory and peak RSS with N loads held at once.\n"
+            );
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+    if (paths.empty()) {
+        paths.push_back(writeScratchFile());
+    }
+
+    std::printf("%-40s %-10s %10s %10s %10s\n", "file", "loader", "open us", "anon KiB", "hwm KiB");
+    for (const std::string& path : paths) {
+        const std::string name = path.size() > 40 ? "..." + path.substr(path.size() - 37) : path;
+        for (const bool mapped : { false, true }) {
+            Sample sample;
+            if (!runChild(path, mapped, holders, runs, sample)) {
+                std::printf("%-40s %-10s %10s\n", name.c_str(), mapped ? "FileSource" : "ifstream", "failed");
+                continue;
+            }
+            std::printf(
+                    "%-40s %-10s %10.1f %10ld %10ld\n",
+                    name.c_str(),
+                    mapped ? "FileSource" : "ifstream",
+                    sample.openUs,
+                    sample.anonKiB,
+                    sample.hwmKiB
+            );
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,42 @@
+#include <android/log.h>
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+    int minimumPriority() {
+        static const int priority = []() {
+            const char* value = std::getenv("SP_BENCH_LOG_LEVEL");
+            return value != nullptr ? std::atoi(value) : static_cast<int>(ANDROID_LOG_WARN);
+        }();
+        return priority;
+    }
+
+    char priorityLetter(int prio) {
+        switch (prio) {
+            case ANDROID_LOG_VERBOSE: return 'V';
+            case ANDROID_LOG_DEBUG: return 'D';
+            case ANDROID_LOG_INFO: return 'I';
+            case ANDROID_LOG_WARN: return 'W';
+            case ANDROID_LOG_ERROR: return 'E';
+            case ANDROID_LOG_FATAL: return 'F';
+            default: return '?';
+        }
+    }
+}
+
+extern "C" int __android_log_print(int prio, const char* tag, const char* fmt, ...) {
+    if (prio < minimumPriority()) return 0;
+    std::fprintf(stderr, "%c/%s: ", priorityLetter(prio), tag != nullptr ? tag : "");
+    va_list args;
+    va_start(args, fmt);
+    const int written = std::vfprintf(stderr, fmt, args);
+    va_end(args);
+    std::fputc('\n', stderr);
+    return written;
+}
+
+extern "C" int __android_log_write(int prio, const char* tag, const char* text) {
+    return __android_log_print(prio, tag, "%s", text != nullptr ? text : "");
+}
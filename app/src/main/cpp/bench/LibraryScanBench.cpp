@@ -0,0 +1,248 @@
+// Library scanner check: per-core probe caps and cancellation.
+//
+// Writes a synthetic tree and registers stand-in decoders whose open() takes
+// --probe-ms and records how many instances of each core are open at once:
+//   Tracker   first candidate for .mod, uncapped; rejects the "fallthrough"
+//             half of the .mod files
+//   Amiga     capped at 2; second candidate for .mod, so the scanner queues
+//             those files under Tracker and probe() only reaches Amiga by
+//             falling through
+//   N64       capped at 2; only candidate for .usf
+//   Module    uncapped; only candidate for .xm
+//
+// The cap pass scans the whole tree and fails if a capped core ever had more
+// than its limit open, or if a file is lost. The cancel pass cancels a scan
+// mid-way, times cancel(), and fails if a probe is still open afterwards,
+// results keep arriving, or a following scan does not run to completion.
+
+#include "LibraryScanner.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct CoreSpec {
+    const char* name;
+    std::vector<std::string> extensions;
+    int priority;
+    int maxConcurrentProbes;
+};
+
+const CoreSpec kCores[] = {
+        { "Tracker", { "mod" }, 10, 0 },
+        { "Amiga", { "mod" }, 20, 2 },
+        { "N64", { "usf" }, 10, 2 },
+        { "Module", { "xm" }, 10, 0 },
+};
+constexpr size_t kCoreCount = sizeof(kCores) / sizeof(kCores[0]);
+
+struct CoreCounters {
+    std::atomic<int> active { 0 };
+    std::atomic<int> peak { 0 };
+    std::atomic<int> opens { 0 };
+};
+
+CoreCounters gCounters[kCoreCount];
+std::atomic<int> gProbeMs { 4 };
+
+class StandInDecoder : public AudioDecoder {
+public:
+    explicit StandInDecoder(size_t core) : core(core) {}
+    bool open(const char* path) override {
+        CoreCounters& counters = gCounters[core];
+        const int active = counters.active.fetch_add(1) + 1;
+        int peak = counters.peak.load();
+        while (active > peak && !counters.peak.compare_exchange_weak(peak, active)) {
+        }
+        counters.opens.fetch_add(1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(gProbeMs.load()));
+        counters.active.fetch_sub(1);
+        return core != 0 || std::strstr(path, "fallthrough") == nullptr;
+    }
+    void close() override {}
+    int read(float*, int) override { return 0; }
+    void seek(double) override {}
+    double getDuration() override { return 0.0; }
+    int getSampleRate() override { return 48000; }
+    int getChannelCount() override { return 2; }
+    std::string getTitle() override { return ""; }
+    std::string getArtist() override { return ""; }
+    const char* getName() const override { return kCores[core].name; }
+
+private:
+    size_t core;
+};
+
+void registerDecoders() {
+    for (size_t core = 0; core < kCoreCount; ++core) {
+        DecoderStaticInfo staticInfo;
+        staticInfo.maxConcurrentProbes = kCores[core].maxConcurrentProbes;
+        DecoderRegistry::getInstance().registerDecoder(kCores[core].name, kCores[core].extensions, [core]() {
+            return std::unique_ptr<AudioDecoder>(new StandInDecoder(core));
+        }, kCores[core].priority, std::move(staticInfo));
+    }
+}
+
+size_t writeTree(const std::filesystem::path& root, int fileCount) {
+    static const char* const kNames[] = { "fallthrough.mod", "song.mod", "song.usf", "song.xm", "notes.txt" };
+    size_t playable = 0;
+    for (int i = 0; i < fileCount; ++i) {
+        const std::filesystem::path dir = root / ("artist" + std::to_string(i % 37)) / ("disc" + std::to_string(i % 3));
+        std::filesystem::create_directories(dir);
+        const char* name = kNames[i % 5];
+        std::ofstream(dir / (std::to_string(i) + "_" + name)) << "bench";
+        if (std::strcmp(name, "notes.txt") != 0) playable += 1;
+    }
+    return playable;
+}
+
+void resetCounters() {
+    for (CoreCounters& counters : gCounters) {
+        counters.active.store(0);
+        counters.peak.store(0);
+        counters.opens.store(0);
+    }
+}
+
+size_t drain(LibraryScanner& scanner, size_t& failed) {
+    std::vector<DecoderProbeResult> batch;
+    scanner.poll(batch, 1u << 20);
+    for (const DecoderProbeResult& result : batch) {
+        if (result.status != DecoderProbeResult::Status::Ok) failed += 1;
+    }
+    return batch.size();
+}
+
+// Runs a scan to completion; returns the number of results collected.
+size_t scanToEnd(LibraryScanner& scanner, const std::string& root, int threads, size_t& failed) {
+    if (!scanner.start(root, threads)) return 0;
+    size_t collected = 0;
+    for (;;) {
+        const bool running = scanner.getProgress().running;
+        collected += drain(scanner, failed);
+        if (!running) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return collected + drain(scanner, failed);
+}
+
+int runCapPass(LibraryScanner& scanner, const std::string& root, int threads, size_t playable) {
+    resetCounters();
+    size_t failed = 0;
+    const auto start = Clock::now();
+    const size_t collected = scanToEnd(scanner, root, threads, failed);
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    int status = 0;
+    std::printf("cap pass: %zu/%zu files in %.2f s, %zu failed\n", collected, playable, seconds, failed);
+    std::printf("  %-8s %5s %6s %6s\n", "core", "cap", "peak", "opens");
+    for (size_t core = 0; core < kCoreCount; ++core) {
+        const int cap = kCores[core].maxConcurrentProbes;
+        const int peak = gCounters[core].peak.load();
+        std::printf("  %-8s %5d %6d %6d%s\n", kCores[core].name, cap, peak, gCounters[core].opens.load(),
+                    cap > 0 && peak > cap ? "  OVER CAP" : "");
+        if (cap > 0 && peak > cap) status = 1;
+    }
+    if (collected != playable || failed != 0) {
+        std::printf("  FAILED: expected %zu results, all Ok\n", playable);
+        status = 1;
+    }
+    return status;
+}
+
+int runCancelPass(LibraryScanner& scanner, const std::string& root, int threads, size_t playable, int cancelAfterMs) {
+    resetCounters();
+    int status = 0;
+    if (!scanner.start(root, threads)) {
+        std::printf("cancel pass: start FAILED\n");
+        return 1;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(cancelAfterMs));
+    const auto start = Clock::now();
+    scanner.cancel();
+    const double cancelMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    size_t failed = 0;
+    const LibraryScanner::Progress progress = scanner.getProgress();
+    drain(scanner, failed);
+    int stillOpen = 0;
+    for (const CoreCounters& counters : gCounters) stillOpen += counters.active.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(gProbeMs.load() * 4));
+    const size_t late = drain(scanner, failed);
+
+    std::printf("cancel pass: cancel() took %.2f ms after %d ms, %llu of %zu probed, %zu late results, %d still open\n",
+                cancelMs, cancelAfterMs, static_cast<unsigned long long>(progress.probed), playable, late, stillOpen);
+    // In-flight probes finish first: at most one (maybe falling through to a
+    // second core) per worker, plus scheduling slack.
+    const double budgetMs = gProbeMs.load() * 2.0 + 50.0;
+    if (progress.running || late != 0 || stillOpen != 0 || cancelMs > budgetMs) {
+        std::printf("  FAILED: cancel must stop the scan within %.0f ms and leave nothing running\n", budgetMs);
+        status = 1;
+    }
+
+    failed = 0;
+    const size_t rerun = scanToEnd(scanner, root, threads, failed);
+    std::printf("  rescan after cancel: %zu/%zu files\n", rerun, playable);
+    if (rerun != playable || failed != 0) {
+        std::printf("  FAILED: rescan incomplete\n");
+        status = 1;
+    }
+    return status;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int fileCount = 2000;
+    int threads = 8;
+    int cancelAfterMs = 100;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--files" && i + 1 < argc) {
+            fileCount = std::max(10, std::atoi(argv[++i]));
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--probe-ms" && i + 1 < argc) {
+            gProbeMs.store(std::max(0, std::atoi(argv[++i])));
+        } else if (arg == "--cancel-after-ms" && i + 1 < argc) {
+            cancelAfterMs = std::max(0, std::atoi(argv[++i]));
+        } else {
+            std::printf(
+                    "usage: siliconplayer_library_scan_bench [--files N] [--threads N]\n"
+                    "       [--probe-ms MS] [--cancel-after-ms MS]\n"
+                    "Scans a synthetic tree of N files (default 2000) with stand-in decoders\n"
+                    "taking --probe-ms (default 4) per open. Checks that capped cores never\n"
+                    "exceed their probe limit, including files that fall through to them from\n"
+                    "another core, and that cancel() stops a running scan promptly.\n"
+            );
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+
+    registerDecoders();
+    namespace fs = std::filesystem;
+    const fs::path root = fs::temp_directory_path() / ("sp_scan_bench_" + std::to_string(getpid()));
+    const size_t playable = writeTree(root, fileCount);
+    std::printf("%zu playable files of %d, %d workers, %d ms per open\n",
+                playable, fileCount, threads, gProbeMs.load());
+
+    LibraryScanner& scanner = LibraryScanner::getInstance();
+    int status = runCapPass(scanner, root.string(), threads, playable);
+    status |= runCancelPass(scanner, root.string(), threads, playable, cancelAfterMs);
+    fs::remove_all(root);
+    return status;
+}
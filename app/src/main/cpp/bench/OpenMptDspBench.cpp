@@ -0,0 +1,196 @@
+// OpenMPT DSP engine null test and benchmark.
+//
+// Runs the same synthetic stereo signal through the surround and reverb
+// effects twice, once on the original integer port and once on the float32
+// engine, in render-worker sized chunks. For every reverb preset and a set
+// of surround settings it reports:
+//   residual - RMS of (float - integer) relative to the integer output, dB
+//   peak     - largest single-sample difference, in float units
+//   int ns / float ns - thread CPU nanoseconds per stereo frame
+// The residual is dominated by the integer port's int16 delay lines and its
+// clamps, so it sits far below the effect itself rather than at zero. A case
+// whose residual or peak passes --max-residual-db / --max-peak fails the run
+// with exit code 2; the float engine is the default, so this is the bound on
+// how far it may drift from the integer port.
+
+#include "effects/openmpt_dsp/OpenMptDspEffects.h"
+
+#include <time.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+using siliconplayer::effects::OpenMptDspEffects;
+using siliconplayer::effects::OpenMptDspParams;
+
+constexpr int kChannels = 2;
+constexpr int kSampleRate = 48000;
+constexpr int kChunkFrames = 256; // AudioEnginePipeline render chunk
+constexpr int kReverbPresets = 29;
+// Worst cases measured at introduction: -36.0 dB (reverb 23), 0.0101 peak.
+constexpr double kDefaultMaxResidualDb = -30.0;
+constexpr double kDefaultMaxPeak = 0.02;
+
+struct Case {
+    std::string name;
+    OpenMptDspParams params;
+};
+
+std::vector<Case> makeCases() {
+    std::vector<Case> cases;
+    for (const int delayMs : { 5, 20, 45 }) {
+        for (const int depth : { 1, 8, 16 }) {
+            OpenMptDspParams params;
+            params.surroundEnabled = true;
+            params.surroundDelayMs = delayMs;
+            params.surroundDepth = depth;
+            cases.push_back({ "surround " + std::to_string(delayMs) + "ms d" + std::to_string(depth), params });
+        }
+    }
+    for (int preset = 0; preset < kReverbPresets; ++preset) {
+        OpenMptDspParams params;
+        params.reverbEnabled = true;
+        params.reverbPreset = preset;
+        params.reverbDepth = 8;
+        cases.push_back({ "reverb " + std::to_string(preset), params });
+    }
+    OpenMptDspParams params;
+    params.surroundEnabled = true;
+    params.reverbEnabled = true;
+    params.reverbPreset = 4;
+    params.reverbDepth = 16;
+    cases.push_back({ "surround+reverb 4", params });
+    return cases;
+}
+
+int64_t threadCpuNs() {
+    timespec ts {};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000ll + ts.tv_nsec;
+}
+
+// Tones, a decaying click train and noise, peaking around -4 dBFS so neither
+// engine hits its output clamp.
+std::vector<float> makeSignal(double seconds) {
+    const int frames = static_cast<int>(seconds * kSampleRate);
+    std::vector<float> signal(static_cast<size_t>(frames) * kChannels);
+    uint32_t seed = 1u;
+    for (int i = 0; i < frames; ++i) {
+        const double t = static_cast<double>(i) / kSampleRate;
+        seed = seed * 1664525u + 1013904223u;
+        const float noise = (static_cast<float>(seed >> 8) / 16777216.0f - 0.5f) * 0.05f;
+        const float click = static_cast<float>(0.2 * std::exp(-static_cast<double>(i % 12000) / 400.0));
+        const float tone = static_cast<float>(0.25 * std::sin(2.0 * M_PI * 110.0 * t) +
+                                              0.15 * std::sin(2.0 * M_PI * 1870.0 * t));
+        signal[static_cast<size_t>(i) * 2] = tone + click + noise;
+        signal[static_cast<size_t>(i) * 2 + 1] = tone * 0.7f - click * 0.5f - noise;
+    }
+    return signal;
+}
+
+// Processes the whole signal in render chunks; returns CPU ns per frame.
+double render(const std::vector<float>& signal, OpenMptDspParams params, bool floatEngine, std::vector<float>& out) {
+    params.floatEngine = floatEngine;
+    OpenMptDspEffects effects;
+    out = signal;
+    const int frames = static_cast<int>(signal.size() / kChannels);
+    const int64_t start = threadCpuNs();
+    for (int offset = 0; offset < frames; offset += kChunkFrames) {
+        const int chunk = std::min(kChunkFrames, frames - offset);
+        effects.process(out.data() + static_cast<size_t>(offset) * kChannels, chunk, kChannels, kSampleRate, params);
+    }
+    return static_cast<double>(threadCpuNs() - start) / static_cast<double>(frames);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    double seconds = 10.0;
+    int runs = 3;
+    double maxResidualDb = kDefaultMaxResidualDb;
+    double maxPeak = kDefaultMaxPeak;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--seconds" && i + 1 < argc) {
+            seconds = std::max(1.0, std::atof(argv[++i]));
+        } else if (arg == "--runs" && i + 1 < argc) {
+            runs = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--max-residual-db" && i + 1 < argc) {
+            maxResidualDb = std::atof(argv[++i]);
+        } else if (arg == "--max-peak" && i + 1 < argc) {
+            maxPeak = std::atof(argv[++i]);
+        } else {
+            std::printf(
+                    "usage: siliconplayer_openmpt_dsp_bench [--seconds S] [--runs N]\n"
+                    "       [--max-residual-db DB] [--max-peak P]\n"
+                    "Null-tests the float32 surround/reverb engine against the integer port\n"
+                    "and reports thread CPU nanoseconds per stereo frame for both. Exits 2\n"
+                    "if any case's residual exceeds DB (default -30) or its peak\n"
+                    "difference exceeds P (default 0.02).\n"
+            );
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+
+    const std::vector<float> signal = makeSignal(seconds);
+    std::printf(
+            "%-22s %10s %10s %10s %10s %8s\n",
+            "case", "residual", "peak", "int ns", "float ns", "speedup"
+    );
+    int failures = 0;
+    std::vector<float> intOut;
+    std::vector<float> floatOut;
+    for (const Case& testCase : makeCases()) {
+        double intNs = 0.0;
+        double floatNs = 0.0;
+        for (int run = 0; run < runs; ++run) {
+            const double i = render(signal, testCase.params, false, intOut);
+            const double f = render(signal, testCase.params, true, floatOut);
+            intNs = run == 0 ? i : std::min(intNs, i);
+            floatNs = run == 0 ? f : std::min(floatNs, f);
+        }
+
+        double reference = 0.0;
+        double residual = 0.0;
+        float peak = 0.0f;
+        for (size_t i = 0; i < intOut.size(); ++i) {
+            const double diff = static_cast<double>(floatOut[i]) - intOut[i];
+            reference += static_cast<double>(intOut[i]) * intOut[i];
+            residual += diff * diff;
+            peak = std::max(peak, std::abs(floatOut[i] - intOut[i]));
+        }
+        const double residualDb = residual > 0.0 && reference > 0.0
+                                  ? 10.0 * std::log10(residual / reference)
+                                  : -999.0;
+        const bool failed = residualDb > maxResidualDb || static_cast<double>(peak) > maxPeak;
+        failures += failed ? 1 : 0;
+        std::printf(
+                "%-22s %7.1f dB %10.6f %10.1f %10.1f %7.2fx%s\n",
+                testCase.name.c_str(),
+                residualDb,
+                static_cast<double>(peak),
+                intNs,
+                floatNs,
+                floatNs > 0.0 ? intNs / floatNs : 0.0,
+                failed ? "  FAIL" : ""
+        );
+    }
+    if (failures > 0) {
+        std::printf(
+                "FAILED: %d case(s) past %.1f dB residual or %.4f peak\n",
+                failures,
+                maxResidualDb,
+                maxPeak
+        );
+        return 2;
+    }
+    std::printf("ok: every case within %.1f dB residual and %.4f peak\n", maxResidualDb, maxPeak);
+    return 0;
+}
@@ -0,0 +1,353 @@
+// Output DSP chain benchmark.
+//
+// Runs a synthetic stereo signal through the render worker's output chain at
+// each buffer preset's chunk sizes and reports CPU nanoseconds per frame:
+//   render  - legacy per-stage passes vs the fused OutputDspChain
+//   output  - callback clamp + int16 conversion (OpenSL/AudioTrack) vs
+//             OutputDspChain::finishStereo
+// Each line also carries the largest sample difference between the two
+// paths, which stays at float rounding level for a steady gain.
+
+#include "OutputDspChain.h"
+
+#include <time.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int kChannels = 2;
+constexpr int kSampleRate = 48000;
+
+struct BufferPreset {
+    const char* name;
+    int renderChunkFrames; // AudioEnginePipeline kRenderChunkFrames*
+    int outputFrames;      // OpenSL/AudioTrack buffer frames
+};
+
+constexpr BufferPreset kPresets[] = {
+        { "very-small", 256, 512 },
+        { "small", 256, 1024 },
+        { "medium", 256, 2048 },
+        { "large", 256, 4096 },
+        { "very-large", 512, 8192 },
+};
+
+struct ChainConfig {
+    const char* name;
+    OutputDspSettings settings;
+};
+
+std::vector<ChainConfig> makeConfigs() {
+    std::vector<ChainConfig> configs;
+    OutputDspSettings settings;
+    settings.lookaheadClipperMode = 1;
+    configs.push_back({ "default", settings });
+
+    settings.gain = 1.4125375f; // +3 dB, drives the knees
+    settings.forceMono = true;
+    settings.limiterEnabled = true;
+    configs.push_back({ "gain+mono+limit", settings });
+
+    settings.forceMono = false;
+    settings.rightEnabled = false;
+    settings.lookaheadClipperMode = 2;
+    configs.push_back({ "mute-r+limit+hard", settings });
+
+    settings = OutputDspSettings {};
+    settings.gain = 0.7079458f; // -3 dB
+    settings.limiterEnabled = true;
+    settings.lookaheadClipperMode = 1;
+    settings.openMpt.bassEnabled = true;
+    settings.openMpt.reverbEnabled = true;
+    configs.push_back({ "openmpt+limit", settings });
+    return configs;
+}
+
+int64_t threadCpuNs() {
+    timespec ts {};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000ll + ts.tv_nsec;
+}
+
+// One second of tones plus noise peaking a little above full scale.
+std::vector<float> makeSignal() {
+    std::vector<float> signal(static_cast<size_t>(kSampleRate) * kChannels);
+    uint32_t seed = 1u;
+    for (int i = 0; i < kSampleRate; ++i) {
+        const double t = static_cast<double>(i) / kSampleRate;
+        seed = seed * 1664525u + 1013904223u;
+        const float noise = (static_cast<float>(seed >> 8) / 16777216.0f - 0.5f) * 0.1f;
+        const float tone = static_cast<float>(0.6 * std::sin(2.0 * M_PI * 110.0 * t) +
+                                              0.45 * std::sin(2.0 * M_PI * 3300.0 * t));
+        signal[static_cast<size_t>(i) * 2] = tone + noise;
+        signal[static_cast<size_t>(i) * 2 + 1] = tone * 0.8f - noise;
+    }
+    return signal;
+}
+
+// Mirror of the per-stage AudioEngine path this chain replaced.
+class LegacyChain {
+public:
+    explicit LegacyChain(const OutputDspSettings& settings) : settings(settings) {}
+
+    void process(float* buffer, int frames, int channels, int sampleRate) {
+        applyGain(buffer, frames, channels);
+        applyRouting(buffer, frames, channels);
+        applyOpenMpt(buffer, frames, channels, sampleRate);
+        applyMono(buffer, frames, channels);
+        applyLimiter(buffer, frames, channels);
+        applyClipper(buffer, frames, channels, sampleRate);
+    }
+
+private:
+    static float knee(float sample, float threshold) {
+        const float absSample = std::abs(sample);
+        if (absSample <= threshold) return sample;
+        const float kneeWidth = 1.0f - threshold;
+        const float sign = sample < 0.0f ? -1.0f : 1.0f;
+        const float over = (absSample - threshold) / kneeWidth;
+        return sign * (threshold + (kneeWidth * (1.0f - std::exp(-over))));
+    }
+
+    void applyGain(float* buffer, int frames, int channels) const {
+        if (settings.gain == 1.0f) return;
+        for (int i = 0; i < frames * channels; ++i) buffer[i] *= settings.gain;
+    }
+
+    void applyRouting(float* buffer, int frames, int channels) const {
+        if (channels < 2 || (settings.leftEnabled && settings.rightEnabled)) return;
+        for (int i = 0; i < frames; ++i) {
+            if (!settings.leftEnabled) buffer[i * channels] = 0.0f;
+            if (!settings.rightEnabled) buffer[i * channels + 1] = 0.0f;
+        }
+    }
+
+    void applyOpenMpt(float* buffer, int frames, int channels, int sampleRate) {
+        const auto& p = settings.openMpt;
+        if (!(p.bassEnabled || p.surroundEnabled || p.reverbEnabled || p.bitCrushEnabled)) return;
+        const int total = frames * channels;
+        for (int i = 0; i < total; ++i) {
+            buffer[i] = std::clamp(knee(buffer[i] * 0.5623413f, 0.90f), -1.0f, 1.0f);
+        }
+        dsp.process(buffer, frames, channels, sampleRate, p);
+        for (int i = 0; i < total; ++i) buffer[i] *= 1.5848932f;
+    }
+
+    void applyMono(float* buffer, int frames, int channels) const {
+        if (!settings.forceMono || channels != 2) return;
+        for (int i = 0; i < frames; ++i) {
+            const float mono = (buffer[i * 2] + buffer[i * 2 + 1]) * 0.5f;
+            buffer[i * 2] = mono;
+            buffer[i * 2 + 1] = mono;
+        }
+    }
+
+    void applyLimiter(float* buffer, int frames, int channels) {
+        if (!settings.limiterEnabled) return;
+        const int total = frames * channels;
+        float peak = 0.0f;
+        for (int i = 0; i < total; ++i) peak = std::max(peak, std::abs(buffer[i]));
+        const float target = peak > 1.0f ? 1.0f / peak : 1.0f;
+        limiterGain += (target - limiterGain) * (target < limiterGain ? 0.45f : 0.04f);
+        limiterGain = std::clamp(limiterGain, 0.1f, 1.0f);
+        const float tanhNorm = std::tanh(1.45f);
+        for (int i = 0; i < total; ++i) {
+            float sample = buffer[i] * limiterGain;
+            if (std::abs(sample) > 0.92f) sample = std::tanh(sample * 1.45f) / tanhNorm;
+            buffer[i] = std::clamp(sample, -1.0f, 1.0f);
+        }
+    }
+
+    void applyClipper(float* buffer, int frames, int channels, int sampleRate) {
+        const int mode = settings.lookaheadClipperMode;
+        if (mode <= 0) return;
+        const size_t delaySamples =
+                static_cast<size_t>(std::clamp((sampleRate * 5) / 1000, 32, 512)) * static_cast<size_t>(channels);
+        if (delay.size() != delaySamples) {
+            delay.assign(delaySamples, 0.0f);
+            writeIndex = 0;
+        }
+        for (int i = 0; i < frames * channels; ++i) {
+            const float delayed = delay[writeIndex];
+            delay[writeIndex] = buffer[i];
+            writeIndex = (writeIndex + 1u) % delaySamples;
+            buffer[i] = std::clamp(mode == 2 ? delayed : knee(delayed, 0.86f), -1.0f, 1.0f);
+        }
+    }
+
+    OutputDspSettings settings;
+    siliconplayer::effects::OpenMptDspEffects dsp;
+    float limiterGain = 1.0f;
+    std::vector<float> delay;
+    size_t writeIndex = 0;
+};
+
+struct RenderResult {
+    double legacyNs = 0.0;
+    double fusedNs = 0.0;
+    float maxDiff = 0.0f;
+    int passes = 0;
+};
+
+RenderResult measureRender(const std::vector<float>& signal, const OutputDspSettings& settings, int chunkFrames, double seconds, int runs) {
+    RenderResult result;
+    const size_t signalFrames = signal.size() / kChannels;
+    const int64_t totalFrames = static_cast<int64_t>(seconds * kSampleRate);
+    std::vector<float> legacyBuffer(static_cast<size_t>(chunkFrames) * kChannels);
+    std::vector<float> fusedBuffer(legacyBuffer.size());
+
+    for (int run = 0; run < runs; ++run) {
+        LegacyChain legacy(settings);
+        OutputDspChain fused;
+        siliconplayer::effects::OpenMptDspEffects fusedDsp;
+        fused.configure(settings);
+        result.passes = fused.passCount();
+
+        int64_t legacyNs = 0;
+        int64_t fusedNs = 0;
+        size_t cursor = 0;
+        for (int64_t done = 0; done < totalFrames; done += chunkFrames) {
+            for (int frame = 0; frame < chunkFrames; ++frame) {
+                const size_t src = ((cursor + frame) % signalFrames) * kChannels;
+                legacyBuffer[frame * kChannels] = signal[src];
+                legacyBuffer[frame * kChannels + 1] = signal[src + 1];
+            }
+            cursor = (cursor + chunkFrames) % signalFrames;
+            fusedBuffer = legacyBuffer;
+
+            int64_t start = threadCpuNs();
+            legacy.process(legacyBuffer.data(), chunkFrames, kChannels, kSampleRate);
+            legacyNs += threadCpuNs() - start;
+            start = threadCpuNs();
+            fused.process(fusedBuffer.data(), chunkFrames, kChannels, kSampleRate, 1.0f, fusedDsp);
+            fusedNs += threadCpuNs() - start;
+
+            for (size_t i = 0; i < legacyBuffer.size(); ++i) {
+                result.maxDiff = std::max(result.maxDiff, std::abs(legacyBuffer[i] - fusedBuffer[i]));
+            }
+        }
+        const double legacyPerFrame = static_cast<double>(legacyNs) / static_cast<double>(totalFrames);
+        const double fusedPerFrame = static_cast<double>(fusedNs) / static_cast<double>(totalFrames);
+        if (run == 0 || legacyPerFrame < result.legacyNs) result.legacyNs = legacyPerFrame;
+        if (run == 0 || fusedPerFrame < result.fusedNs) result.fusedNs = fusedPerFrame;
+    }
+    return result;
+}
+
+RenderResult measureOutput(const std::vector<float>& signal, int outputFrames, double seconds, int runs) {
+    RenderResult result;
+    const size_t samples = static_cast<size_t>(outputFrames) * kChannels;
+    const int64_t totalFrames = static_cast<int64_t>(seconds * kSampleRate);
+    std::vector<float> scratch(samples);
+    std::vector<int16_t> legacyPcm(samples);
+    std::vector<int16_t> fusedPcm(samples);
+
+    for (int run = 0; run < runs; ++run) {
+        int64_t legacyNs = 0;
+        int64_t fusedNs = 0;
+        size_t cursor = 0;
+        for (int64_t done = 0; done < totalFrames; done += outputFrames) {
+            const size_t offset = cursor;
+            cursor = (cursor + samples) % (signal.size() - samples);
+
+            // Callback clamp pass followed by the backend's clamp + convert.
+            std::copy_n(signal.data() + offset, samples, scratch.data());
+            int64_t start = threadCpuNs();
+            for (size_t i = 0; i < samples; ++i) {
+                scratch[i] = std::clamp(scratch[i], -1.0f, 1.0f);
+            }
+            for (size_t i = 0; i < samples; ++i) {
+                legacyPcm[i] = static_cast<int16_t>(std::clamp(scratch[i], -1.0f, 1.0f) * 32767.0f);
+            }
+            legacyNs += threadCpuNs() - start;
+
+            std::copy_n(signal.data() + offset, samples, scratch.data());
+            start = threadCpuNs();
+            OutputDspChain::finishStereo(scratch.data(), outputFrames, nullptr, fusedPcm.data());
+            fusedNs += threadCpuNs() - start;
+
+            for (size_t i = 0; i < samples; ++i) {
+                result.maxDiff = std::max(
+                        result.maxDiff,
+                        static_cast<float>(std::abs(legacyPcm[i] - fusedPcm[i]))
+                );
+            }
+        }
+        const double legacyPerFrame = static_cast<double>(legacyNs) / static_cast<double>(totalFrames);
+        const double fusedPerFrame = static_cast<double>(fusedNs) / static_cast<double>(totalFrames);
+        if (run == 0 || legacyPerFrame < result.legacyNs) result.legacyNs = legacyPerFrame;
+        if (run == 0 || fusedPerFrame < result.fusedNs) result.fusedNs = fusedPerFrame;
+    }
+    result.passes = 1;
+    return result;
+}
+
+void printResult(const char* preset, const char* stage, const char* config, int frames, const RenderResult& r) {
+    std::printf(
+            "%-11s %-7s %-18s %6d %6d %10.2f %10.2f %7.2fx %10.3g\n",
+            preset,
+            stage,
+            config,
+            frames,
+            r.passes,
+            r.legacyNs,
+            r.fusedNs,
+            r.fusedNs > 0.0 ? r.legacyNs / r.fusedNs : 0.0,
+            static_cast<double>(r.maxDiff)
+    );
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    double seconds = 20.0;
+    int runs = 3;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--seconds" && i + 1 < argc) {
+            seconds = std::max(1.0, std::atof(argv[++i]));
+        } else if (arg == "--runs" && i + 1 < argc) {
+            runs = std::max(1, std::atoi(argv[++i]));
+        } else {
+            std::printf(
+                    "usage: siliconplayer_output_dsp_bench [--seconds S] [--runs N]\n"
+                    "Reports thread CPU nanoseconds per stereo frame, legacy vs fused.\n"
+                    "maxdiff is in float units for render and int16 steps for output.\n"
+            );
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+
+    const std::vector<float> signal = makeSignal();
+    const std::vector<ChainConfig> configs = makeConfigs();
+    std::printf(
+            "%-11s %-7s %-18s %6s %6s %10s %10s %8s %10s\n",
+            "preset", "stage", "chain", "frames", "passes", "legacy ns", "fused ns", "speedup", "maxdiff"
+    );
+    for (const BufferPreset& preset : kPresets) {
+        for (const ChainConfig& config : configs) {
+            printResult(
+                    preset.name,
+                    "render",
+                    config.name,
+                    preset.renderChunkFrames,
+                    measureRender(signal, config.settings, preset.renderChunkFrames, seconds, runs)
+            );
+        }
+        printResult(
+                preset.name,
+                "output",
+                "clamp+int16",
+                preset.outputFrames,
+                measureOutput(signal, preset.outputFrames, seconds, runs)
+        );
+    }
+    return 0;
+}
@@ -0,0 +1,204 @@
+// Decoder plugin loader track-change benchmark.
+//
+// Plays a mixed playlist (A -> B -> C -> A ...) through DecoderPluginLoader and
+// times each track change: dropping the previous decoder and creating the
+// next one, which is where a cold plugin pays dlopen, relocation and static
+// init. Each plugin is a copy of a host-built in-tree plugin (cRSID by
+// default) under its own file name, so the dynamic loader treats them as the
+// separate cores of a real playlist.
+//
+// Time is scaled down: a track lasts --track-ms and the idle lease is a
+// quarter of that, matching the stock 5 s lease against multi-minute tracks.
+// Modes run in separate processes so each starts with nothing loaded:
+//   fixed      the previous loader: fixed idle lease, no pre-warming
+//   predictive adaptive idle lease and successor prediction only
+//   prewarm    predictive plus prewarm() of the next two tracks, as the app
+//              does when the current track changes
+// Each track also takes --scan-leases short background leases of the
+// playlist's libraries in reverse order, as a library scan or probe running
+// during playback would; they must not pull the prediction off the playlist.
+
+#include "decoders/DecoderPluginLoader.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::vector<std::string> plugins;
+    int copies = 3;
+    int tracks = 30;
+    int trackMs = 400;
+    int scanLeases = 2;
+    bool verbose = false;
+};
+
+double percentile(std::vector<double> values, double fraction) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    const size_t index = std::min(values.size() - 1, static_cast<size_t>(fraction * static_cast<double>(values.size() - 1) + 0.5));
+    return values[index];
+}
+
+int runMode(const std::string& mode, const std::vector<std::string>& libraries, const Options& options) {
+    DecoderPluginLoader& loader = DecoderPluginLoader::getInstance();
+    DecoderPluginLoader::Policy policy;
+    policy.minIdle = std::chrono::milliseconds(std::max(1, options.trackMs / 4));
+    policy.minPlayedLease = std::chrono::milliseconds(std::max(1, options.trackMs / 2));
+    policy.pressureHold = std::chrono::milliseconds(options.trackMs * 4);
+    if (mode == "fixed") {
+        policy.maxIdle = policy.minIdle;
+        policy.maxPredicted = 0;
+    } else {
+        // Same ratio to minIdle as the stock 10 min / 5 s.
+        policy.maxIdle = policy.minIdle * 120;
+    }
+    loader.setPolicy(policy);
+    const bool prewarm = mode == "prewarm";
+
+    std::vector<double> changeMs;
+    std::unique_ptr<AudioDecoder> current;
+    for (int track = 0; track < options.tracks; ++track) {
+        const std::string& library = libraries[static_cast<size_t>(track) % libraries.size()];
+        const auto start = Clock::now();
+        current.reset();
+        current = loader.createDecoder(library);
+        const double elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        if (!current) {
+            std::fprintf(stderr, "could not create a decoder from %s\n", library.c_str());
+            return 1;
+        }
+        loader.notePlayback(*current);
+        changeMs.push_back(elapsedMs);
+        if (options.verbose) {
+            std::printf("  %-10s track %2d %-28s %8.3f ms\n",
+                        mode.c_str(),
+                        track,
+                        std::filesystem::path(library).filename().c_str(),
+                        elapsedMs);
+        }
+        if (prewarm) {
+            std::vector<std::string> upcoming;
+            for (int offset = 1; offset <= 2; ++offset) {
+                upcoming.push_back(libraries[static_cast<size_t>(track + offset) % libraries.size()]);
+            }
+            loader.prewarm(upcoming);
+        }
+        for (int lease = 0; lease < options.scanLeases; ++lease) {
+            const size_t reverse = libraries.size() - 1 - static_cast<size_t>(track + lease) % libraries.size();
+            loader.createDecoder(libraries[reverse]).reset();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(options.trackMs));
+    }
+    current.reset();
+
+    // The first pass over the playlist is cold in every mode.
+    const size_t warmup = std::min(changeMs.size(), libraries.size());
+    const std::vector<double> steady(changeMs.begin() + static_cast<std::ptrdiff_t>(warmup), changeMs.end());
+    double sum = 0.0;
+    for (const double value : steady) sum += value;
+    std::printf(
+            "%-10s %7.3f %7.3f %7.3f %8.3f\n",
+            mode.c_str(),
+            steady.empty() ? 0.0 : sum / static_cast<double>(steady.size()),
+            percentile(steady, 0.5),
+            percentile(steady, 0.9),
+            steady.empty() ? 0.0 : *std::max_element(steady.begin(), steady.end())
+    );
+    if (options.verbose) {
+        std::printf("%s", loader.statsSummary().c_str());
+    }
+    std::fflush(stdout);
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    std::vector<std::string> modes = { "fixed", "predictive", "prewarm" };
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--plugin" && i + 1 < argc) {
+            options.plugins.emplace_back(argv[++i]);
+        } else if (arg == "--copies" && i + 1 < argc) {
+            options.copies = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--tracks" && i + 1 < argc) {
+            options.tracks = std::max(2, std::atoi(argv[++i]));
+        } else if (arg == "--track-ms" && i + 1 < argc) {
+            options.trackMs = std::max(20, std::atoi(argv[++i]));
+        } else if (arg == "--scan-leases" && i + 1 < argc) {
+            options.scanLeases = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--mode" && i + 1 < argc) {
+            modes = { argv[++i] };
+        } else if (arg == "--verbose") {
+            options.verbose = true;
+        } else {
+            std::printf(
+                    "usage: siliconplayer_plugin_loader_bench [--plugin PATH]... [--copies N]\n"
+                    "       [--tracks N] [--track-ms MS] [--scan-leases N]\n"
+                    "       [--mode fixed|predictive|prewarm] [--verbose]\n"
+                    "Times track changes through a mixed playlist of decoder plugins. Each\n"
+                    "plugin is copied --copies times (default 3) to stand in for distinct cores;\n"
+                    "the default plugin is the host build of the in-tree cRSID plugin.\n"
+                    "--scan-leases (default 2) background leases per track stand in for a\n"
+                    "library scan running during playback.\n"
+            );
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+#ifdef SILICONPLAYER_BENCH_DEFAULT_PLUGIN
+    if (options.plugins.empty()) {
+        options.plugins.emplace_back(SILICONPLAYER_BENCH_DEFAULT_PLUGIN);
+    }
+#endif
+    if (options.plugins.empty()) {
+        std::fprintf(stderr, "no plugin given\n");
+        return 1;
+    }
+
+    namespace fs = std::filesystem;
+    const fs::path workDir = fs::temp_directory_path() / ("sp_plugin_bench_" + std::to_string(getpid()));
+    fs::create_directories(workDir);
+    std::vector<std::string> libraries;
+    for (int copy = 0; copy < options.copies; ++copy) {
+        for (size_t plugin = 0; plugin < options.plugins.size(); ++plugin) {
+            const fs::path target = workDir /
+                    ("libbench_core_" + std::to_string(copy) + "_" + std::to_string(plugin) + ".so");
+            fs::copy_file(options.plugins[plugin], target, fs::copy_options::overwrite_existing);
+            libraries.push_back(target.string());
+        }
+    }
+
+    std::printf("%zu libraries, %d tracks of %d ms, idle lease %d ms\n",
+                libraries.size(), options.tracks, options.trackMs, std::max(1, options.trackMs / 4));
+    std::printf("track change after the first pass, ms:\n");
+    std::printf("%-10s %7s %7s %7s %8s\n", "mode", "mean", "p50", "p90", "max");
+    std::fflush(stdout);
+    int status = 0;
+    for (const std::string& mode : modes) {
+        const pid_t child = fork();
+        if (child == 0) {
+            _exit(runMode(mode, libraries, options));
+        }
+        int childStatus = 0;
+        waitpid(child, &childStatus, 0);
+        if (!WIFEXITED(childStatus) || WEXITSTATUS(childStatus) != 0) {
+            status = 1;
+        }
+    }
+    fs::remove_all(workDir);
+    return status;
+}
@@ -0,0 +1,186 @@
+// SMB read-ahead cache benchmark and check.
+//
+// Plays a synthetic remote file through a stand-in for the SMB AVIO read
+// (fixed per-call latency, limited bandwidth and periodic hiccups), reading
+// 64 KiB at a time like the FFmpeg custom AVIO at a steady playback pace,
+// with a few seeks mixed in. Runs once with the old direct reads and once
+// through ReadAheadCache, verifies every byte, and reports the time the
+// reader spent blocked (total, worst single read) plus the cache counters.
+
+#include "ReadAheadCache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kReadBytes = 64 * 1024; // kSmbAvioBufferSize
+
+struct RemoteParams {
+    int64_t sizeBytes = 24ll << 20;
+    double latencyMs = 3.0;
+    double bandwidthMBps = 12.0;
+    int hiccupEvery = 40; // calls
+    double hiccupMs = 120.0;
+};
+
+uint8_t byteAt(int64_t offset) {
+    return static_cast<uint8_t>((offset * 2654435761ll) >> 13);
+}
+
+// Stand-in for siliconplayer_read_smb_avio_handle.
+class FakeRemote {
+public:
+    explicit FakeRemote(RemoteParams params) : params(params) {}
+
+    int read(int64_t offset, uint8_t* buffer, int length) {
+        if (offset >= params.sizeBytes) {
+            return 0;
+        }
+        const int count = static_cast<int>(std::min<int64_t>(length, params.sizeBytes - offset));
+        double delayMs = params.latencyMs + (count / (params.bandwidthMBps * 1048576.0)) * 1000.0;
+        if (params.hiccupEvery > 0 && ++calls % params.hiccupEvery == 0) {
+            delayMs += params.hiccupMs;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(static_cast<int64_t>(delayMs * 1000.0)));
+        for (int i = 0; i < count; ++i) {
+            buffer[i] = byteAt(offset + i);
+        }
+        return count;
+    }
+
+private:
+    RemoteParams params;
+    std::atomic<uint64_t> calls { 0 };
+};
+
+struct Result {
+    double blockedMs = 0.0;
+    double worstMs = 0.0;
+    bool valid = true;
+};
+
+// Reads the whole file at paceMBps with seeks at a few fixed points.
+Result play(const RemoteParams& params, double paceMBps, bool cached, ReadAheadCache::Stats& stats) {
+    FakeRemote remote(params);
+    std::unique_ptr<ReadAheadCache> cache;
+    if (cached) {
+        cache = std::make_unique<ReadAheadCache>(
+                [&remote](int64_t offset, uint8_t* buffer, int length) {
+                    return remote.read(offset, buffer, length);
+                },
+                params.sizeBytes
+        );
+    }
+
+    // (at offset, jump to offset): a forward skip, a short back seek, a long
+    // back seek.
+    const std::vector<std::pair<int64_t, int64_t>> seeks = {
+            { params.sizeBytes / 4, params.sizeBytes / 2 },
+            { params.sizeBytes * 5 / 8, params.sizeBytes * 5 / 8 - (512 << 10) },
+            { params.sizeBytes * 3 / 4, params.sizeBytes / 8 },
+    };
+    size_t nextSeek = 0;
+
+    Result result;
+    std::vector<uint8_t> buffer(kReadBytes);
+    const auto paceInterval = std::chrono::microseconds(
+            static_cast<int64_t>(kReadBytes / (paceMBps * 1048576.0) * 1000000.0));
+    int64_t position = 0;
+    int64_t consumed = 0;
+    auto nextRead = Clock::now();
+    while (position < params.sizeBytes && consumed < params.sizeBytes) {
+        if (nextSeek < seeks.size() && position >= seeks[nextSeek].first) {
+            position = seeks[nextSeek].second;
+            ++nextSeek;
+        }
+        std::this_thread::sleep_until(nextRead);
+        const auto start = Clock::now();
+        const int count = cached
+                ? cache->read(position, buffer.data(), kReadBytes)
+                : remote.read(position, buffer.data(), kReadBytes);
+        const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        result.blockedMs += ms;
+        result.worstMs = std::max(result.worstMs, ms);
+        if (count <= 0) {
+            result.valid = false;
+            break;
+        }
+        for (int i = 0; i < count; ++i) {
+            if (buffer[static_cast<size_t>(i)] != byteAt(position + i)) {
+                result.valid = false;
+            }
+        }
+        position += count;
+        consumed += count;
+        nextRead = std::max(nextRead + paceInterval, Clock::now());
+    }
+    if (cache) {
+        stats = cache->getStats();
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    RemoteParams params;
+    double paceMBps = 2.0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--size-mib" && i + 1 < argc) {
+            params.sizeBytes = static_cast<int64_t>(std::max(1, std::atoi(argv[++i]))) << 20;
+        } else if (arg == "--latency-ms" && i + 1 < argc) {
+            params.latencyMs = std::max(0.0, std::atof(argv[++i]));
+        } else if (arg == "--bandwidth" && i + 1 < argc) {
+            params.bandwidthMBps = std::max(0.1, std::atof(argv[++i]));
+        } else if (arg == "--hiccup-ms" && i + 1 < argc) {
+            params.hiccupMs = std::max(0.0, std::atof(argv[++i]));
+        } else if (arg == "--pace" && i + 1 < argc) {
+            paceMBps = std::max(0.1, std::atof(argv[++i]));
+        } else {
+            std::printf(
+                    "usage: siliconplayer_read_ahead_bench [--size-mib N] [--latency-ms L]\n"
+                    "       [--bandwidth MBps] [--hiccup-ms H] [--pace MBps]\n"
+                    "Plays a simulated SMB file with direct reads and through the read-ahead\n"
+                    "cache, and reports how long the reader was blocked.\n"
+            );
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+
+    std::printf("%-10s %12s %12s %6s\n", "mode", "blocked ms", "worst ms", "data");
+    bool ok = true;
+    for (const bool cached : { false, true }) {
+        ReadAheadCache::Stats stats;
+        const Result result = play(params, paceMBps, cached, stats);
+        ok = ok && result.valid;
+        std::printf(
+                "%-10s %12.1f %12.1f %6s\n",
+                cached ? "read-ahead" : "direct",
+                result.blockedMs,
+                result.worstMs,
+                result.valid ? "ok" : "BAD"
+        );
+        if (cached) {
+            std::printf(
+                    "cache: hits=%llu misses=%llu stalls=%llu stall=%.1fms fetched=%llu blocks\n",
+                    static_cast<unsigned long long>(stats.hits),
+                    static_cast<unsigned long long>(stats.misses),
+                    static_cast<unsigned long long>(stats.stalls),
+                    static_cast<double>(stats.stallNs) / 1000000.0,
+                    static_cast<unsigned long long>(stats.blocksFetched)
+            );
+        }
+    }
+    return ok ? 0 : 1;
+}
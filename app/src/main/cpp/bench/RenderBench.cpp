@@ -0,0 +1,620 @@
+// Headless decoder render benchmark.
+//
+// Renders each input file through AudioDecoder::read() into a null sink and
+// reports realtime factor, wall/CPU ns per frame, open time, heap allocations
+// (during open and during steady-state rendering) and peak RSS, per decoder
+// and per core-option variant. A previous --csv run can be passed as
+// --baseline to turn the run into a regression gate. --concurrent also
+// renders every file on its own thread at once, next to a registry probe of
+// it, and checks the output against a serial render, for decoders that claim
+// to be multi-instance safe.
+
+#include "decoders/AudioDecoder.h"
+#include "decoders/CRSIDDecoder.h"
+#include "decoders/DecoderRegistry.h"
+#if defined(SILICONPLAYER_BENCH_HAS_SC68)
+#include "decoders/Sc68Decoder.h"
+#endif
+
+#include <dlfcn.h>
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Allocation accounting (glibc malloc interposition; counts C and C++ heaps)
+// -----------------------------------------------------------------------------
+namespace {
+    std::atomic<uint64_t> gAllocationCount { 0 };
+    std::atomic<uint64_t> gAllocationBytes { 0 };
+
+    void noteAllocation(size_t bytes) {
+        gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+        gAllocationBytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+}
+
+#if defined(__GLIBC__)
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+
+void* malloc(size_t size) {
+    noteAllocation(size);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+    noteAllocation(count * size);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, size_t size) {
+    noteAllocation(size);
+    return __libc_realloc(pointer, size);
+}
+
+void* memalign(size_t alignment, size_t size) {
+    noteAllocation(size);
+    return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    noteAllocation(size);
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** result, size_t alignment, size_t size) {
+    noteAllocation(size);
+    void* pointer = __libc_memalign(alignment, size);
+    if (pointer == nullptr) return ENOMEM;
+    *result = pointer;
+    return 0;
+}
+}
+#endif
+
+namespace {
+
+struct BenchConfig {
+    double maxSeconds = 30.0;
+    int sampleRate = 48000;
+    int chunkFrames = 1024;
+    int runs = 3;
+    std::string forcedDecoder;
+    std::vector<std::pair<std::string, std::string>> options;
+    // Each sweep multiplies the variant set: name -> values.
+    std::vector<std::pair<std::string, std::vector<std::string>>> sweeps;
+    std::string csvPath;
+    std::string baselinePath;
+    double maxRegression = 0.10;
+    bool concurrent = false;
+    std::vector<std::string> files;
+};
+
+struct BenchResult {
+    std::string decoder;
+    std::string file;
+    std::string variant;
+    double audioSeconds = 0.0;
+    double wallMs = 0.0;
+    double realtimeFactor = 0.0;
+    double nsPerFrame = 0.0;
+    double cpuNsPerFrame = 0.0;
+    double openMs = 0.0;
+    uint64_t openAllocations = 0;
+    uint64_t renderAllocations = 0;
+    uint64_t renderAllocatedBytes = 0;
+    long peakRssKb = 0;
+};
+
+void printUsage() {
+    std::printf(
+            "usage: siliconplayer_render_bench [options] FILE...\n"
+            "  --seconds S            render at most S seconds per file (default 30)\n"
+            "  --rate HZ              requested output sample rate (default 48000)\n"
+            "  --chunk FRAMES         frames per read() call (default 1024)\n"
+            "  --runs N               runs per file/variant, best is reported (default 3)\n"
+            "  --decoder NAME         force a decoder instead of extension lookup\n"
+            "  --option NAME=VALUE    core option applied to every run\n"
+            "  --sweep NAME=V1,V2,..  benchmark each value (repeatable, cartesian)\n"
+            "  --plugin NAME:EXT,..:PATH  register a host-built decoder plugin\n"
+            "  --csv PATH             write results as CSV\n"
+            "  --baseline PATH        compare ns/frame against a previous CSV\n"
+            "  --max-regression F     allowed ns/frame slowdown vs baseline (default 0.10)\n"
+            "  --concurrent           verify concurrent renders (next to probes) match serial ones\n"
+            "Environment: SP_BENCH_LOG_LEVEL=<android priority> for decoder logs.\n"
+    );
+}
+
+std::vector<std::string> splitString(const std::string& value, char separator) {
+    std::vector<std::string> parts;
+    std::stringstream stream(value);
+    std::string part;
+    while (std::getline(stream, part, separator)) {
+        if (!part.empty()) parts.push_back(part);
+    }
+    return parts;
+}
+
+bool splitAssignment(const std::string& value, std::string& name, std::string& rhs) {
+    const size_t equals = value.find('=');
+    if (equals == std::string::npos || equals == 0) return false;
+    name = value.substr(0, equals);
+    rhs = value.substr(equals + 1);
+    return true;
+}
+
+bool registerPlugin(const std::string& spec) {
+    const std::vector<std::string> parts = splitString(spec, ':');
+    if (parts.size() != 3) {
+        std::fprintf(stderr, "bad --plugin spec: %s\n", spec.c_str());
+        return false;
+    }
+    void* handle = dlopen(parts[2].c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (handle == nullptr) {
+        std::fprintf(stderr, "dlopen failed for %s: %s\n", parts[2].c_str(), dlerror());
+        return false;
+    }
+    using CreateFn = AudioDecoder* (*)();
+    auto create = reinterpret_cast<CreateFn>(dlsym(handle, "siliconplayer_create_decoder"));
+    if (create == nullptr) {
+        std::fprintf(stderr, "%s has no siliconplayer_create_decoder\n", parts[2].c_str());
+        return false;
+    }
+    DecoderRegistry::getInstance().registerDecoder(parts[0], splitString(parts[1], ','), [create]() {
+        return std::unique_ptr<AudioDecoder>(create());
+    });
+    return true;
+}
+
+// Registry entries carry the capabilities the decoder reports, as the app's
+// static entries must, so probe() skips exactly the single-instance cores.
+template <typename Decoder>
+void registerBuiltinDecoder(const char* name) {
+    DecoderStaticInfo staticInfo;
+    staticInfo.hasPlaybackCapabilities = true;
+    staticInfo.playbackCapabilities = Decoder().getPlaybackCapabilities();
+    DecoderRegistry::getInstance().registerDecoder(name, Decoder::getSupportedExtensions(), []() {
+        return std::make_unique<Decoder>();
+    }, 0, std::move(staticInfo));
+}
+
+void registerBuiltinDecoders() {
+    registerBuiltinDecoder<CRSIDDecoder>("cRSID");
+#if defined(SILICONPLAYER_BENCH_HAS_SC68)
+    registerBuiltinDecoder<Sc68Decoder>("SC68");
+#endif
+}
+
+bool parseArguments(int argc, char** argv, BenchConfig& config) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto nextValue = [&](const char* flag) -> const char* {
+            if (i + 1 >= argc) {
+                std::fprintf(stderr, "%s needs a value\n", flag);
+                return nullptr;
+            }
+            return argv[++i];
+        };
+        if (arg == "--help" || arg == "-h") {
+            printUsage();
+            std::exit(0);
+        } else if (arg == "--seconds") {
+            const char* value = nextValue("--seconds");
+            if (!value) return false;
+            config.maxSeconds = std::max(0.1, std::atof(value));
+        } else if (arg == "--rate") {
+            const char* value = nextValue("--rate");
+            if (!value) return false;
+            config.sampleRate = std::max(8000, std::atoi(value));
+        } else if (arg == "--chunk") {
+            const char* value = nextValue("--chunk");
+            if (!value) return false;
+            config.chunkFrames = std::clamp(std::atoi(value), 16, 65536);
+        } else if (arg == "--runs") {
+            const char* value = nextValue("--runs");
+            if (!value) return false;
+            config.runs = std::max(1, std::atoi(value));
+        } else if (arg == "--decoder") {
+            const char* value = nextValue("--decoder");
+            if (!value) return false;
+            config.forcedDecoder = value;
+        } else if (arg == "--option") {
+            const char* value = nextValue("--option");
+            if (!value) return false;
+            std::string name;
+            std::string optionValue;
+            if (!splitAssignment(value, name, optionValue)) return false;
+            config.options.emplace_back(name, optionValue);
+        } else if (arg == "--sweep") {
+            const char* value = nextValue("--sweep");
+            if (!value) return false;
+            std::string name;
+            std::string values;
+            if (!splitAssignment(value, name, values)) return false;
+            config.sweeps.emplace_back(name, splitString(values, ','));
+        } else if (arg == "--plugin") {
+            const char* value = nextValue("--plugin");
+            if (!value || !registerPlugin(value)) return false;
+        } else if (arg == "--csv") {
+            const char* value = nextValue("--csv");
+            if (!value) return false;
+            config.csvPath = value;
+        } else if (arg == "--baseline") {
+            const char* value = nextValue("--baseline");
+            if (!value) return false;
+            config.baselinePath = value;
+        } else if (arg == "--max-regression") {
+            const char* value = nextValue("--max-regression");
+            if (!value) return false;
+            config.maxRegression = std::max(0.0, std::atof(value));
+        } else if (arg == "--concurrent") {
+            config.concurrent = true;
+        } else if (!arg.empty() && arg[0] == '-') {
+            std::fprintf(stderr, "unknown option: %s\n", arg.c_str());
+            return false;
+        } else {
+            config.files.push_back(arg);
+        }
+    }
+    return !config.files.empty();
+}
+
+std::vector<std::vector<std::pair<std::string, std::string>>> buildVariants(const BenchConfig& config) {
+    std::vector<std::vector<std::pair<std::string, std::string>>> variants(1);
+    for (const auto& [name, values] : config.sweeps) {
+        std::vector<std::vector<std::pair<std::string, std::string>>> expanded;
+        for (const auto& variant : variants) {
+            for (const auto& value : values) {
+                auto next = variant;
+                next.emplace_back(name, value);
+                expanded.push_back(std::move(next));
+            }
+        }
+        variants = std::move(expanded);
+    }
+    return variants;
+}
+
+std::string variantLabel(const std::vector<std::pair<std::string, std::string>>& variant) {
+    if (variant.empty()) return "default";
+    std::string label;
+    for (const auto& [name, value] : variant) {
+        if (!label.empty()) label += ' ';
+        label += name + "=" + value;
+    }
+    return label;
+}
+
+// Resets the kernel's peak-RSS watermark so each run reports its own peak.
+void resetPeakRss() {
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    if (clearRefs) clearRefs << "5";
+}
+
+long readPeakRssKb() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("VmHWM:", 0) == 0) {
+            return std::atol(line.c_str() + 6);
+        }
+    }
+    return 0;
+}
+
+int64_t threadCpuNs() {
+    timespec ts {};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+std::unique_ptr<AudioDecoder> createDecoder(const BenchConfig& config, const std::string& path) {
+    if (!config.forcedDecoder.empty()) {
+        return DecoderRegistry::getInstance().createDecoderByName(config.forcedDecoder);
+    }
+    return DecoderRegistry::getInstance().createDecoder(path.c_str());
+}
+
+bool runOnce(
+        const BenchConfig& config,
+        const std::string& path,
+        const std::vector<std::pair<std::string, std::string>>& variant,
+        std::vector<float>& sink,
+        BenchResult& result) {
+    resetPeakRss();
+    const uint64_t allocationsBeforeOpen = gAllocationCount.load(std::memory_order_relaxed);
+    const auto openStart = std::chrono::steady_clock::now();
+
+    std::unique_ptr<AudioDecoder> decoder = createDecoder(config, path);
+    if (!decoder) {
+        std::fprintf(stderr, "no decoder for %s\n", path.c_str());
+        return false;
+    }
+    decoder->setOutputSampleRate(config.sampleRate);
+    for (const auto& [name, value] : config.options) {
+        decoder->setOption(name.c_str(), value.c_str());
+    }
+    for (const auto& [name, value] : variant) {
+        decoder->setOption(name.c_str(), value.c_str());
+    }
+    if (!decoder->open(path.c_str())) {
+        std::fprintf(stderr, "%s failed to open %s\n", decoder->getName(), path.c_str());
+        return false;
+    }
+    decoder->setRepeatMode(0);
+
+    const double openMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - openStart
+    ).count();
+    const uint64_t allocationsAfterOpen = gAllocationCount.load(std::memory_order_relaxed);
+
+    const int channels = std::max(1, decoder->getChannelCount());
+    const int sampleRate = std::max(1, decoder->getSampleRate());
+    sink.resize(static_cast<size_t>(config.chunkFrames) * channels);
+    const int64_t frameBudget = static_cast<int64_t>(config.maxSeconds * sampleRate);
+
+    const uint64_t bytesBeforeRender = gAllocationBytes.load(std::memory_order_relaxed);
+    const int64_t cpuStart = threadCpuNs();
+    const auto renderStart = std::chrono::steady_clock::now();
+    int64_t framesRendered = 0;
+    while (framesRendered < frameBudget) {
+        const int request = static_cast<int>(std::min<int64_t>(config.chunkFrames, frameBudget - framesRendered));
+        const int frames = decoder->read(sink.data(), request);
+        if (frames <= 0) break;
+        framesRendered += frames;
+    }
+    const double wallNs = std::chrono::duration<double, std::nano>(
+            std::chrono::steady_clock::now() - renderStart
+    ).count();
+    const int64_t cpuNs = threadCpuNs() - cpuStart;
+    const uint64_t allocationsAfterRender = gAllocationCount.load(std::memory_order_relaxed);
+    const uint64_t bytesAfterRender = gAllocationBytes.load(std::memory_order_relaxed);
+
+    result.decoder = decoder->getName();
+    result.file = std::filesystem::path(path).filename().string();
+    result.variant = variantLabel(variant);
+    result.audioSeconds = static_cast<double>(framesRendered) / sampleRate;
+    result.wallMs = wallNs / 1.0e6;
+    result.realtimeFactor = wallNs > 0.0 ? (result.audioSeconds * 1.0e9) / wallNs : 0.0;
+    result.nsPerFrame = framesRendered > 0 ? wallNs / static_cast<double>(framesRendered) : 0.0;
+    result.cpuNsPerFrame = framesRendered > 0 ? static_cast<double>(cpuNs) / static_cast<double>(framesRendered) : 0.0;
+    result.openMs = openMs;
+    result.openAllocations = allocationsAfterOpen - allocationsBeforeOpen;
+    result.renderAllocations = allocationsAfterRender - allocationsAfterOpen;
+    result.renderAllocatedBytes = bytesAfterRender - bytesBeforeRender;
+    result.peakRssKb = readPeakRssKb();
+    return framesRendered > 0;
+}
+
+// Renders the frame budget of one file and folds the output bits into an
+// FNV-1a hash. Sets singleInstance (and hashes nothing) for decoders that
+// cannot run next to another instance of themselves.
+bool renderHash(
+        const BenchConfig& config,
+        const std::string& path,
+        const std::vector<std::pair<std::string, std::string>>& variant,
+        uint64_t& hash,
+        bool& singleInstance) {
+    hash = 1469598103934665603ull;
+    singleInstance = false;
+    std::unique_ptr<AudioDecoder> decoder = createDecoder(config, path);
+    if (!decoder) return false;
+    if ((decoder->getPlaybackCapabilities() & AudioDecoder::PLAYBACK_CAP_SINGLE_INSTANCE) != 0) {
+        singleInstance = true;
+        return true;
+    }
+    decoder->setOutputSampleRate(config.sampleRate);
+    for (const auto& [name, value] : config.options) {
+        decoder->setOption(name.c_str(), value.c_str());
+    }
+    for (const auto& [name, value] : variant) {
+        decoder->setOption(name.c_str(), value.c_str());
+    }
+    if (!decoder->open(path.c_str())) return false;
+    decoder->setRepeatMode(0);
+
+    const int channels = std::max(1, decoder->getChannelCount());
+    const int64_t frameBudget = static_cast<int64_t>(config.maxSeconds * std::max(1, decoder->getSampleRate()));
+    std::vector<float> buffer(static_cast<size_t>(config.chunkFrames) * channels);
+    int64_t framesRendered = 0;
+    while (framesRendered < frameBudget) {
+        const int request = static_cast<int>(std::min<int64_t>(config.chunkFrames, frameBudget - framesRendered));
+        const int frames = decoder->read(buffer.data(), request);
+        if (frames <= 0) break;
+        const auto* bytes = reinterpret_cast<const unsigned char*>(buffer.data());
+        const size_t byteCount = static_cast<size_t>(frames) * channels * sizeof(float);
+        for (size_t i = 0; i < byteCount; ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+        framesRendered += frames;
+    }
+    return framesRendered > 0;
+}
+
+// Serial hashes first, then every file on its own thread at once.
+bool verifyConcurrentRenders(
+        const BenchConfig& config,
+        const std::vector<std::pair<std::string, std::string>>& variant) {
+    const size_t count = config.files.size();
+    std::vector<uint64_t> serial(count, 0);
+    std::vector<uint64_t> concurrent(count, 0);
+    std::vector<char> skipped(count, 0);
+    std::vector<char> serialOk(count, 0);
+    std::vector<char> concurrentOk(count, 0);
+    for (size_t i = 0; i < count; ++i) {
+        bool singleInstance = false;
+        serialOk[i] = renderHash(config, config.files[i], variant, serial[i], singleInstance);
+        skipped[i] = singleInstance;
+    }
+    // A library-scan probe of every file runs next to the renders, the way
+    // probe, scan and gapless preload open a second instance of a playing core.
+    std::vector<DecoderProbeResult::Status> probes(count, DecoderProbeResult::Status::Unsupported);
+    std::vector<std::thread> threads;
+    threads.reserve(count * 2);
+    for (size_t i = 0; i < count; ++i) {
+        if (skipped[i] || !serialOk[i]) continue;
+        threads.emplace_back([&, i]() {
+            bool singleInstance = false;
+            concurrentOk[i] = renderHash(config, config.files[i], variant, concurrent[i], singleInstance);
+        });
+        threads.emplace_back([&, i]() {
+            probes[i] = DecoderRegistry::getInstance().probe(config.files[i].c_str()).status;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    bool allMatch = true;
+    for (size_t i = 0; i < count; ++i) {
+        const std::string file = std::filesystem::path(config.files[i]).filename().string();
+        const char* status = "ok";
+        if (skipped[i]) {
+            status = "skipped (single instance)";
+        } else if (!serialOk[i] || !concurrentOk[i]) {
+            status = "FAILED to render";
+            allMatch = false;
+        } else if (serial[i] != concurrent[i]) {
+            status = "MISMATCH";
+            allMatch = false;
+        } else if (probes[i] != DecoderProbeResult::Status::Ok) {
+            status = "probe FAILED next to render";
+            allMatch = false;
+        }
+        std::printf("concurrent %-28.28s [%s]: %s\n", file.c_str(), variantLabel(variant).c_str(), status);
+    }
+    return allMatch;
+}
+
+std::string resultKey(const BenchResult& result) {
+    return result.decoder + "|" + result.file + "|" + result.variant;
+}
+
+void writeCsv(const std::string& path, const std::vector<BenchResult>& results) {
+    std::ofstream out(path);
+    out << "decoder,file,variant,audio_s,wall_ms,realtime_x,ns_per_frame,cpu_ns_per_frame,"
+           "open_ms,open_allocs,render_allocs,render_alloc_bytes,peak_rss_kb\n";
+    for (const auto& r : results) {
+        out << r.decoder << ',' << r.file << ',' << r.variant << ','
+            << r.audioSeconds << ',' << r.wallMs << ',' << r.realtimeFactor << ','
+            << r.nsPerFrame << ',' << r.cpuNsPerFrame << ',' << r.openMs << ','
+            << r.openAllocations << ',' << r.renderAllocations << ',' << r.renderAllocatedBytes << ','
+            << r.peakRssKb << '\n';
+    }
+}
+
+std::map<std::string, double> readBaseline(const std::string& path) {
+    std::map<std::string, double> baseline;
+    std::ifstream in(path);
+    std::string line;
+    std::getline(in, line); // header
+    while (std::getline(in, line)) {
+        std::vector<std::string> fields;
+        std::stringstream stream(line);
+        std::string field;
+        while (std::getline(stream, field, ',')) fields.push_back(field);
+        if (fields.size() < 7) continue;
+        baseline[fields[0] + "|" + fields[1] + "|" + fields[2]] = std::atof(fields[6].c_str());
+    }
+    return baseline;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    registerBuiltinDecoders();
+    BenchConfig config;
+    if (!parseArguments(argc, argv, config)) {
+        printUsage();
+        return 1;
+    }
+
+    const auto variants = buildVariants(config);
+    std::vector<BenchResult> results;
+    std::vector<float> sink;
+    bool anyFailure = false;
+
+    std::printf(
+            "%-10s %-28s %-26s %8s %9s %9s %9s %8s %7s %9s %9s\n",
+            "decoder", "file", "variant", "audio_s", "realtime", "ns/frame", "cpu_ns/f",
+            "open_ms", "allocs", "r_allocs", "rss_kb"
+    );
+    for (const auto& path : config.files) {
+        for (const auto& variant : variants) {
+            BenchResult best;
+            bool haveBest = false;
+            for (int run = 0; run < config.runs; ++run) {
+                BenchResult current;
+                if (!runOnce(config, path, variant, sink, current)) {
+                    anyFailure = true;
+                    break;
+                }
+                if (!haveBest || current.nsPerFrame < best.nsPerFrame) {
+                    best = current;
+                    haveBest = true;
+                }
+            }
+            if (!haveBest) continue;
+            std::printf(
+                    "%-10s %-28.28s %-26.26s %8.2f %8.1fx %9.1f %9.1f %8.2f %7llu %9llu %9ld\n",
+                    best.decoder.c_str(), best.file.c_str(), best.variant.c_str(),
+                    best.audioSeconds, best.realtimeFactor, best.nsPerFrame, best.cpuNsPerFrame,
+                    best.openMs,
+                    static_cast<unsigned long long>(best.openAllocations),
+                    static_cast<unsigned long long>(best.renderAllocations),
+                    best.peakRssKb
+            );
+            results.push_back(std::move(best));
+        }
+    }
+
+    if (!config.csvPath.empty()) {
+        writeCsv(config.csvPath, results);
+    }
+
+    int exitCode = anyFailure ? 1 : 0;
+    if (config.concurrent) {
+        for (const auto& variant : variants) {
+            if (!verifyConcurrentRenders(config, variant)) {
+                exitCode = 3;
+            }
+        }
+    }
+    if (!config.baselinePath.empty()) {
+        const auto baseline = readBaseline(config.baselinePath);
+        for (const auto& result : results) {
+            const auto it = baseline.find(resultKey(result));
+            if (it == baseline.end() || it->second <= 0.0) continue;
+            const double change = (result.nsPerFrame - it->second) / it->second;
+            if (change > config.maxRegression) {
+                std::printf(
+                        "REGRESSION %s %s [%s]: %.1f -> %.1f ns/frame (%+.1f%%)\n",
+                        result.decoder.c_str(), result.file.c_str(), result.variant.c_str(),
+                        it->second, result.nsPerFrame, change * 100.0
+                );
+                exitCode = 2;
+            }
+        }
+    }
+    return exitCode;
+}
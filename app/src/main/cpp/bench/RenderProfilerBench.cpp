@@ -0,0 +1,213 @@
+// Render profiler overhead and snapshot check.
+//
+// Simulates the render worker recording every stage of a chunk and an output
+// callback recording pops, jitter and fill level on another thread, while a
+// third thread takes snapshots like the JNI poller. Reports the cost of one
+// record() call and of one snapshot, and checks every snapshot decodes to a
+// well-formed layout (bucket totals never exceed stage counts by more than
+// the records in flight, fill ring time stamps never go backwards). The
+// worker alternates two decoders of known cost per frame; the final
+// snapshot must attribute each one's decode time to its own slot. Their
+// names live in buffers that are overwritten before the final check, as a
+// plugin's name is unmapped when the plugin unloads.
+
+#include "RenderProfiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Stage = RenderProfiler::Stage;
+
+double elapsedNs(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+struct CheckResult {
+    int snapshots = 0;
+    int bad = 0;
+    double snapshotNs = 0.0;
+};
+
+bool checkSnapshot(const std::vector<int64_t>& values) {
+    if (values.size() < 8 || values[0] != RenderProfiler::kSnapshotVersion) {
+        return false;
+    }
+    const int64_t stageCount = values[1];
+    const int64_t bucketCount = values[2];
+    const int64_t decoderCount = values[3];
+    const int64_t fillCount = values[4];
+    const size_t expected = 8 +
+            static_cast<size_t>(stageCount * (3 + bucketCount) + decoderCount * 3 + fillCount * 3);
+    if (values.size() != expected) {
+        return false;
+    }
+    size_t offset = 8;
+    for (int64_t stage = 0; stage < stageCount; ++stage) {
+        const int64_t count = values[offset];
+        int64_t bucketTotal = 0;
+        for (int64_t bucket = 0; bucket < bucketCount; ++bucket) {
+            bucketTotal += values[offset + 3 + static_cast<size_t>(bucket)];
+        }
+        // Counters are read one by one while writers run; allow a few
+        // records landing between the reads.
+        if (bucketTotal > count + 8 || count > bucketTotal + 8) {
+            return false;
+        }
+        offset += 3 + static_cast<size_t>(bucketCount);
+    }
+    offset += static_cast<size_t>(decoderCount * 3);
+    int64_t previousMs = -1;
+    for (int64_t i = 0; i < fillCount; ++i) {
+        const int64_t timeMs = values[offset];
+        // The oldest slot may already be overwritten by a newer sample.
+        if (i > 1 && timeMs < previousMs) {
+            return false;
+        }
+        previousMs = timeMs;
+        offset += 3;
+    }
+    return true;
+}
+
+constexpr int64_t kHeavyNsPerFrame = 16;
+constexpr int64_t kLightNsPerFrame = 2;
+
+// Decoder slots follow the stages; heavy was recorded first.
+bool checkDecoders(const RenderProfiler& profiler, const std::vector<int64_t>& values) {
+    const std::vector<std::string> names = profiler.decoderNames();
+    if (names.size() != 2 || names[0] != "heavy" || names[1] != "light" || values[3] != 2) {
+        return false;
+    }
+    const size_t offset = 8 + static_cast<size_t>(values[1] * (3 + values[2]));
+    const int64_t expectedNsPerFrame[] = { kHeavyNsPerFrame, kLightNsPerFrame };
+    for (size_t i = 0; i < 2; ++i) {
+        const int64_t frames = values[offset + i * 3 + 1];
+        const int64_t decodeNs = values[offset + i * 3 + 2];
+        if (frames <= 0 || decodeNs != frames * expectedNsPerFrame[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int seconds = 3;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--seconds" && i + 1 < argc) {
+            seconds = std::max(1, std::atoi(argv[++i]));
+        } else {
+            std::printf(
+                    "usage: siliconplayer_render_profiler_bench [--seconds N]\n"
+                    "Measures RenderProfiler record/snapshot cost with a simulated render\n"
+                    "worker, output callback and snapshot poller running at once.\n"
+            );
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+
+    RenderProfiler profiler;
+
+    // Uncontended cost first.
+    constexpr int kSoloRecords = 2000000;
+    auto start = Clock::now();
+    for (int i = 0; i < kSoloRecords; ++i) {
+        profiler.record(Stage::Resample, 1000 + (i & 0xffff) * 37);
+    }
+    const double soloNs = elapsedNs(start) / kSoloRecords;
+    profiler.reset();
+
+    std::atomic<bool> stop { false };
+    std::atomic<uint64_t> workerRecords { 0 };
+    std::atomic<uint64_t> callbackRecords { 0 };
+    std::atomic<double> workerNsPerRecord { 0.0 };
+
+    std::string lightName = "light";
+    std::string heavyName = "heavy";
+    std::thread worker([&]() {
+        uint64_t records = 0;
+        const auto workerStart = Clock::now();
+        while (!stop.load(std::memory_order_relaxed)) {
+            const int64_t base = 20000 + static_cast<int64_t>(records % 5000);
+            profiler.record(Stage::QueueLockWait, base / 50);
+            profiler.record(Stage::DecoderLockWait, base / 40);
+            if ((records & 8u) != 0) {
+                profiler.recordDecode(lightName.c_str(), kLightNsPerFrame * 1024, 1024);
+            } else {
+                profiler.recordDecode(heavyName.c_str(), kHeavyNsPerFrame * 1024, 1024);
+            }
+            profiler.record(Stage::Resample, base * 2);
+            profiler.record(Stage::DspFront, base / 4);
+            profiler.record(Stage::DspShape, base / 5);
+            profiler.record(Stage::QueueAppend, base / 10);
+            profiler.record(Stage::WorkerChunk, base * 12);
+            records += 8;
+        }
+        workerNsPerRecord.store(elapsedNs(workerStart) / static_cast<double>(std::max<uint64_t>(1, records)));
+        workerRecords.store(records);
+    });
+
+    std::thread callback([&]() {
+        uint64_t records = 0;
+        int64_t last = 0;
+        int queueFrames = 8192;
+        while (!stop.load(std::memory_order_relaxed)) {
+            const int64_t now = RenderProfiler::nowNs();
+            profiler.record(Stage::QueuePop, 300);
+            queueFrames = (queueFrames + 977) % 16384;
+            profiler.recordCallback(now, last > 0 ? now - last : 0, 5333333, queueFrames, queueFrames < 200 ? 64 : 0);
+            last = now;
+            records += 2;
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        callbackRecords.store(records);
+    });
+
+    CheckResult check;
+    const auto deadline = Clock::now() + std::chrono::seconds(seconds);
+    double snapshotNsTotal = 0.0;
+    while (Clock::now() < deadline) {
+        const auto snapshotStart = Clock::now();
+        const std::vector<int64_t> values = profiler.snapshot();
+        snapshotNsTotal += elapsedNs(snapshotStart);
+        check.snapshots += 1;
+        if (!checkSnapshot(values)) {
+            check.bad += 1;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    stop.store(true);
+    worker.join();
+    callback.join();
+    check.snapshotNs = snapshotNsTotal / std::max(1, check.snapshots);
+    lightName.assign(lightName.size(), '#');
+    heavyName.assign(heavyName.size(), '#');
+
+    const std::vector<int64_t> finalValues = profiler.snapshot();
+    const bool finalOk = checkSnapshot(finalValues);
+    const bool decodersOk = checkDecoders(profiler, finalValues);
+    std::printf("record, uncontended:       %8.1f ns\n", soloNs);
+    std::printf("record, worker under load: %8.1f ns (%llu records)\n",
+                workerNsPerRecord.load(),
+                static_cast<unsigned long long>(workerRecords.load()));
+    std::printf("callback records:          %8llu\n", static_cast<unsigned long long>(callbackRecords.load()));
+    std::printf("snapshot:                  %8.1f us, %zu values\n", check.snapshotNs / 1000.0, finalValues.size());
+    std::printf("snapshots checked:         %8d, malformed %d, final %s\n",
+                check.snapshots,
+                check.bad,
+                finalOk ? "ok" : "BAD");
+    std::printf("per-decoder decode:        %s\n%s", decodersOk ? "ok" : "BAD", profiler.decoderSummary().c_str());
+    return check.bad == 0 && finalOk && decodersOk ? 0 : 1;
+}
@@ -0,0 +1,278 @@
+// Render queue sizing simulation: fixed preset vs RenderQueueController.
+//
+// Plays a simulated decoder through an event-driven model of the render
+// path: the output callback drains one period every few milliseconds (with
+// jitter and occasional late callbacks), and the render worker refills the
+// queue a chunk at a time while it is below target, paying the decoder's
+// per-frame cost with random spikes, rare scheduler stalls (GC, a busy big
+// core) and periodic slow phases (the worker migrated to a little core or
+// the SoC throttling). For each decoder profile it reports underruns and
+// the average queue target (the latency the queue adds) for the fixed
+// Medium preset and for the adaptive controller bounded to the Very small ..
+// Very large preset range.
+
+#include "RenderQueueController.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+namespace {
+
+constexpr int kSampleRate = 48000;
+constexpr int kCallbackFrames = 192;
+constexpr int64_t kCallbackPeriodNs = static_cast<int64_t>(kCallbackFrames) * 1000000000ll / kSampleRate;
+
+struct Profile {
+    const char* name;
+    double nsPerFrame;
+    double spikeChance; // per chunk
+    double spikeFactor;
+};
+
+struct Environment {
+    double stallsPerSecond = 0.3;
+    double stallMinMs = 10.0;
+    double stallMaxMs = 80.0;
+    double lateCallbackChance = 0.01;
+    double lateCallbackMs = 12.0;
+    double slowEverySeconds = 25.0;
+    double slowSeconds = 2.0;
+    double slowFactor = 1.5;
+};
+
+struct Result {
+    uint64_t underruns = 0;
+    double meanTargetMs = 0.0;
+    int finalChunk = 0;
+    int finalTarget = 0;
+    int changes = 0;
+};
+
+Result simulate(const Profile& profile, const Environment& env, bool adaptive, double seconds, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::normal_distribution<double> jitterNormal(0.0, 0.25); // ms
+
+    RenderQueueController controller;
+    RenderQueueController::Bounds bounds;
+    bounds.baseChunkFrames = 256;
+    bounds.baseTargetFrames = 8192;
+    bounds.minTargetFrames = adaptive ? 2048 : 8192;
+    bounds.maxTargetFrames = adaptive ? 32768 : 8192;
+    bounds.maxChunkFrames = adaptive ? 1024 : 256;
+    controller.configure(bounds);
+    controller.setDecoder(profile.name);
+
+    int chunkFrames = bounds.baseChunkFrames;
+    int targetFrames = bounds.baseTargetFrames;
+    const int64_t endNs = static_cast<int64_t>(seconds * 1e9);
+
+    int64_t queueFrames = targetFrames;
+    int64_t nextCallbackNs = kCallbackPeriodNs;
+    int64_t chunkDoneNs = -1;
+    int chunkInFlight = 0;
+    int64_t chunkCostNs = 0;
+    int64_t workerReadyNs = 0;
+    Result result;
+    double targetTimeSum = 0.0;
+    int64_t lastNs = 0;
+
+    auto startChunkIfNeeded = [&](int64_t now) {
+        if (chunkInFlight > 0 || queueFrames >= targetFrames || now < workerReadyNs) {
+            return;
+        }
+        double cost = profile.nsPerFrame * chunkFrames * (1.0 + 0.2 * unit(rng));
+        const double phaseSeconds = std::fmod(static_cast<double>(now) / 1e9, env.slowEverySeconds);
+        if (phaseSeconds >= env.slowEverySeconds - env.slowSeconds) {
+            cost *= env.slowFactor;
+        }
+        if (unit(rng) < profile.spikeChance) {
+            cost *= profile.spikeFactor;
+        }
+        chunkCostNs = static_cast<int64_t>(cost);
+        // The worker loses the CPU now and then for a while.
+        const double chunkSeconds = cost / 1e9 + static_cast<double>(chunkFrames) / kSampleRate * 0.05;
+        int64_t stallNs = 0;
+        if (unit(rng) < env.stallsPerSecond * chunkSeconds) {
+            stallNs = static_cast<int64_t>((env.stallMinMs + (env.stallMaxMs - env.stallMinMs) * unit(rng)) * 1e6);
+        }
+        chunkInFlight = chunkFrames;
+        chunkDoneNs = now + chunkCostNs + stallNs + 20000; // + fixed per-chunk overhead
+    };
+
+    uint64_t callbackCount = 0;
+    while (true) {
+        const int64_t now = (chunkInFlight > 0 && chunkDoneNs < nextCallbackNs) ? chunkDoneNs : nextCallbackNs;
+        if (now > endNs) {
+            break;
+        }
+        targetTimeSum += static_cast<double>(targetFrames) * static_cast<double>(now - lastNs);
+        lastNs = now;
+
+        if (chunkInFlight > 0 && now == chunkDoneNs) {
+            queueFrames += chunkInFlight;
+            controller.onChunk(chunkInFlight, chunkCostNs);
+            chunkInFlight = 0;
+            RenderQueueController::Decision decision;
+            if (controller.evaluate(now, kSampleRate, result.underruns, decision)) {
+                chunkFrames = decision.chunkFrames;
+                targetFrames = decision.targetFrames;
+                result.changes += 1;
+            }
+            startChunkIfNeeded(now);
+            continue;
+        }
+
+        // Output callback: drains one period at the hardware's steady pace;
+        // its observed arrival time is what jitters.
+        double jitterMs = std::abs(jitterNormal(rng));
+        if (unit(rng) < env.lateCallbackChance) {
+            jitterMs += env.lateCallbackMs * (0.5 + unit(rng));
+        }
+        controller.noteCallbackJitter(static_cast<int64_t>(jitterMs * 1e6));
+        if (queueFrames < kCallbackFrames) {
+            result.underruns += 1;
+            queueFrames = 0;
+        } else {
+            queueFrames -= kCallbackFrames;
+        }
+        callbackCount += 1;
+        nextCallbackNs += kCallbackPeriodNs;
+        // The callback's notify wakes the worker after a short delay.
+        workerReadyNs = now + static_cast<int64_t>((0.05 + 0.25 * unit(rng) + jitterMs * 0.1) * 1e6);
+        if (chunkInFlight == 0 && queueFrames < targetFrames) {
+            // Approximate the wake-up by starting the chunk at workerReadyNs.
+            const int64_t saved = workerReadyNs;
+            workerReadyNs = 0;
+            startChunkIfNeeded(saved);
+        }
+    }
+    (void)callbackCount;
+    result.meanTargetMs = targetTimeSum / static_cast<double>(std::max<int64_t>(1, lastNs)) * 1000.0 / kSampleRate;
+    result.finalChunk = chunkFrames;
+    result.finalTarget = targetFrames;
+    return result;
+}
+
+// Learns a heavy target, then re-pushes the same bounds and narrower ones
+// the way a settings change re-sends the pipeline config. Returns false if
+// the learned target was dropped instead of kept or clamped.
+bool checkReconfigureKeepsLearned() {
+    RenderQueueController controller;
+    RenderQueueController::Bounds bounds;
+    bounds.baseTargetFrames = 2048;
+    bounds.minTargetFrames = 2048;
+    bounds.maxTargetFrames = 32768;
+    controller.configure(bounds);
+    controller.setDecoder("heavy");
+    for (int i = 0; i < 64; ++i) {
+        controller.onChunk(1024, 1024 * 15000);
+    }
+    RenderQueueController::Decision decision;
+    controller.evaluate(1, kSampleRate, 0, decision);
+    controller.evaluate(2, kSampleRate, 0, decision);
+    controller.evaluate(RenderQueueController::kEvaluateIntervalNs + 2, kSampleRate, 0, decision);
+    const int learnedTarget = controller.targetFrames();
+
+    controller.configure(bounds);
+    const int afterSamePush = controller.targetFrames();
+    bounds.maxTargetFrames = std::max(bounds.minTargetFrames, learnedTarget / 2);
+    controller.configure(bounds);
+    const int afterNarrowing = controller.targetFrames();
+    controller.setDecoder("light");
+    controller.setDecoder("heavy");
+    const int afterSwitchBack = controller.targetFrames();
+
+    const int clamped = bounds.maxTargetFrames;
+    const bool ok = learnedTarget > bounds.baseTargetFrames * 2 &&
+            afterSamePush == learnedTarget &&
+            afterNarrowing == clamped &&
+            afterSwitchBack == clamped;
+    std::printf(
+            "\nreconfigure: learned %d, same bounds %d, narrowed %d, switched back %d: %s\n",
+            learnedTarget,
+            afterSamePush,
+            afterNarrowing,
+            afterSwitchBack,
+            ok ? "ok" : "FAILED"
+    );
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    double seconds = 180.0;
+    Environment env;
+    bool verbose = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--seconds" && i + 1 < argc) {
+            seconds = std::max(5.0, std::atof(argv[++i]));
+        } else if (arg == "--stalls" && i + 1 < argc) {
+            env.stallsPerSecond = std::max(0.0, std::atof(argv[++i]));
+        } else if (arg == "--late-ms" && i + 1 < argc) {
+            env.lateCallbackMs = std::max(0.0, std::atof(argv[++i]));
+        } else if (arg == "--slow-factor" && i + 1 < argc) {
+            env.slowFactor = std::max(1.0, std::atof(argv[++i]));
+        } else if (arg == "--verbose") {
+            verbose = true;
+        } else {
+            std::printf(
+                    "usage: siliconplayer_render_queue_bench [--seconds S] [--stalls PER_S]\n"
+                    "       [--late-ms MS] [--slow-factor F] [--verbose]\n"
+                    "Simulates light and heavy decoders through the render queue with the\n"
+                    "fixed Medium preset and with the adaptive controller, and reports\n"
+                    "underruns and the average queue target.\n"
+            );
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+
+    const Profile profiles[] = {
+            { "mp3", 150.0, 0.01, 3.0 },
+            { "openmpt-64ch", 1800.0, 0.02, 2.5 },
+            { "sid-3sid-resid", 7000.0, 0.02, 2.5 },
+            { "furnace-multichip", 13000.0, 0.03, 2.2 },
+    };
+
+    std::printf("%-18s %-9s %10s %12s %7s %7s %8s\n",
+                "decoder", "mode", "underruns", "target ms", "chunk", "target", "changes");
+    for (const Profile& profile : profiles) {
+        for (const bool adaptive : { false, true }) {
+            const Result result = simulate(profile, env, adaptive, seconds, 12345u);
+            std::printf(
+                    "%-18s %-9s %10llu %12.1f %7d %7d %8d\n",
+                    profile.name,
+                    adaptive ? "adaptive" : "fixed",
+                    static_cast<unsigned long long>(result.underruns),
+                    result.meanTargetMs,
+                    result.finalChunk,
+                    result.finalTarget,
+                    result.changes
+            );
+        }
+    }
+    if (verbose) {
+        RenderQueueController controller;
+        RenderQueueController::Bounds bounds;
+        bounds.minTargetFrames = 2048;
+        bounds.maxTargetFrames = 32768;
+        controller.configure(bounds);
+        controller.setDecoder("example");
+        for (int i = 0; i < 64; ++i) {
+            controller.onChunk(1024, 1024 * 9000);
+        }
+        RenderQueueController::Decision decision;
+        controller.evaluate(1, kSampleRate, 0, decision);
+        controller.evaluate(2, kSampleRate, 0, decision);
+        controller.evaluate(RenderQueueController::kEvaluateIntervalNs + 2, kSampleRate, 0, decision);
+        std::printf("\n%s\n", controller.summary().c_str());
+    }
+    return checkReconfigureKeepsLearned() ? 0 : 1;
+}
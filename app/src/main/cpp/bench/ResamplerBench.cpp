@@ -0,0 +1,260 @@
+// Output resampler benchmark.
+//
+// Pushes a synthetic stereo signal through each output resampler path the
+// engine offers and reports CPU time per second of produced audio:
+//   linear  - mirror of the built-in path in AudioEngine::renderResampledLocked
+//   sinc    - PolyphaseResampler (outputResamplerPreference == 3)
+//   sox     - swresample with the SoX engine, when the bench links it
+
+#include "PolyphaseResampler.h"
+
+#if defined(SILICONPLAYER_BENCH_HAS_SWRESAMPLE)
+extern "C" {
+#include <libavutil/channel_layout.h>
+#include <libavutil/opt.h>
+#include <libswresample/swresample.h>
+}
+#endif
+
+#include <time.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr int kChannels = 2;
+constexpr int kDecodeChunkFrames = 1024;
+constexpr int kOutputChunkFrames = 256;
+
+int64_t threadCpuNs() {
+    timespec ts {};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000ll + ts.tv_nsec;
+}
+
+// Deterministic "decoder": one second of tones plus LCG noise, generated up
+// front and looped so the measurement is dominated by the resampler.
+class SignalSource {
+public:
+    explicit SignalSource(int rate) : frames(static_cast<size_t>(rate) * kChannels) {
+        uint32_t seed = 1u;
+        for (int i = 0; i < rate; ++i) {
+            const double t = static_cast<double>(i) / rate;
+            seed = seed * 1664525u + 1013904223u;
+            const float noise = (static_cast<float>(seed >> 8) / 16777216.0f - 0.5f) * 0.05f;
+            const float tone = static_cast<float>(0.3 * std::sin(2.0 * M_PI * 440.0 * t) +
+                                                  0.2 * std::sin(2.0 * M_PI * 5000.0 * t));
+            frames[static_cast<size_t>(i) * 2] = tone + noise;
+            frames[static_cast<size_t>(i) * 2 + 1] = tone - noise;
+        }
+    }
+
+    int read(float* output, int count) {
+        const size_t totalFrames = frames.size() / kChannels;
+        int written = 0;
+        while (written < count) {
+            const int span = static_cast<int>(std::min<size_t>(count - written, totalFrames - cursor));
+            std::memcpy(output + static_cast<size_t>(written) * kChannels,
+                        frames.data() + cursor * kChannels,
+                        static_cast<size_t>(span) * kChannels * sizeof(float));
+            written += span;
+            cursor = (cursor + span) % totalFrames;
+        }
+        return count;
+    }
+
+private:
+    std::vector<float> frames;
+    size_t cursor = 0;
+};
+
+using RenderFn = std::function<void(float* output, int frames)>;
+
+// Same algorithm as the built-in linear path, including the vector growth
+// and periodic front erase.
+RenderFn makeLinear(SignalSource& source, int inputRate, int outputRate) {
+    struct State {
+        std::vector<float> buffer;
+        std::vector<float> scratch = std::vector<float>(kDecodeChunkFrames * kChannels);
+        int startFrame = 0;
+        double position = 0.0;
+    };
+    auto state = std::make_shared<State>();
+    const double step = static_cast<double>(inputRate) / outputRate;
+    return [state, step, &source](float* output, int frames) {
+        State& s = *state;
+        for (int outFrame = 0; outFrame < frames; ++outFrame) {
+            int available = static_cast<int>(s.buffer.size() / kChannels) - s.startFrame;
+            int base = static_cast<int>(std::floor(s.position));
+            while (base + 1 >= available) {
+                const int decoded = source.read(s.scratch.data(), kDecodeChunkFrames);
+                s.buffer.insert(s.buffer.end(), s.scratch.begin(), s.scratch.begin() + decoded * kChannels);
+                available = static_cast<int>(s.buffer.size() / kChannels) - s.startFrame;
+            }
+            const double frac = std::clamp(s.position - base, 0.0, 1.0);
+            const size_t a = static_cast<size_t>(s.startFrame + base) * kChannels;
+            const size_t b = a + kChannels;
+            for (int c = 0; c < kChannels; ++c) {
+                output[outFrame * kChannels + c] =
+                        static_cast<float>(s.buffer[a + c] + (s.buffer[b + c] - s.buffer[a + c]) * frac);
+            }
+            s.position += step;
+        }
+        const int trim = std::max(0, static_cast<int>(std::floor(s.position)) - 1);
+        s.startFrame += trim;
+        s.position -= trim;
+        if (s.startFrame > 4096) {
+            s.buffer.erase(s.buffer.begin(), s.buffer.begin() + static_cast<size_t>(s.startFrame) * kChannels);
+            s.startFrame = 0;
+        }
+    };
+}
+
+RenderFn makeSinc(SignalSource& source, int inputRate, int outputRate) {
+    auto resampler = std::make_shared<PolyphaseResampler>();
+    auto scratch = std::make_shared<std::vector<float>>(kDecodeChunkFrames * kChannels);
+    resampler->configure(kChannels, inputRate, outputRate);
+    return [resampler, scratch, &source](float* output, int frames) {
+        int produced = 0;
+        while (produced < frames) {
+            produced += resampler->render(output + produced * kChannels, frames - produced);
+            if (produced >= frames) break;
+            const int request = std::min(kDecodeChunkFrames, resampler->writableInputFrames());
+            const int decoded = source.read(scratch->data(), request);
+            resampler->pushInput(scratch->data(), decoded);
+        }
+    };
+}
+
+#if defined(SILICONPLAYER_BENCH_HAS_SWRESAMPLE)
+RenderFn makeSox(SignalSource& source, int inputRate, int outputRate) {
+    SwrContext* context = swr_alloc();
+    AVChannelLayout layout;
+    av_channel_layout_default(&layout, kChannels);
+    av_opt_set_chlayout(context, "in_chlayout", &layout, 0);
+    av_opt_set_chlayout(context, "out_chlayout", &layout, 0);
+    av_opt_set_int(context, "in_sample_rate", inputRate, 0);
+    av_opt_set_int(context, "out_sample_rate", outputRate, 0);
+    av_opt_set_sample_fmt(context, "in_sample_fmt", AV_SAMPLE_FMT_FLT, 0);
+    av_opt_set_sample_fmt(context, "out_sample_fmt", AV_SAMPLE_FMT_FLT, 0);
+    av_opt_set(context, "resampler", "soxr", 0);
+    if (swr_init(context) < 0) {
+        swr_free(&context);
+        return nullptr;
+    }
+    auto owner = std::shared_ptr<SwrContext>(context, [](SwrContext* c) { swr_free(&c); });
+    auto scratch = std::make_shared<std::vector<float>>(kDecodeChunkFrames * kChannels);
+    return [owner, scratch, &source](float* output, int frames) {
+        int produced = 0;
+        while (produced < frames) {
+            uint8_t* out[1] = { reinterpret_cast<uint8_t*>(output + produced * kChannels) };
+            int converted = swr_convert(owner.get(), out, frames - produced, nullptr, 0);
+            if (converted <= 0) {
+                const int decoded = source.read(scratch->data(), kDecodeChunkFrames);
+                const uint8_t* in[1] = { reinterpret_cast<const uint8_t*>(scratch->data()) };
+                converted = swr_convert(owner.get(), out, frames - produced, in, decoded);
+            }
+            produced += std::max(0, converted);
+        }
+    };
+}
+#endif
+
+double measure(const std::function<RenderFn(SignalSource&)>& factory, int inputRate, int outputRate, double seconds, int runs) {
+    double best = 0.0;
+    std::vector<float> output(kOutputChunkFrames * kChannels);
+    const int64_t totalFrames = static_cast<int64_t>(seconds * outputRate);
+    for (int run = 0; run < runs; ++run) {
+        SignalSource source(inputRate);
+        RenderFn render = factory(source);
+        if (!render) return -1.0;
+        const int64_t start = threadCpuNs();
+        for (int64_t done = 0; done < totalFrames; done += kOutputChunkFrames) {
+            render(output.data(), kOutputChunkFrames);
+        }
+        const double ms = static_cast<double>(threadCpuNs() - start) / 1e6;
+        const double perSecond = ms / seconds;
+        if (run == 0 || perSecond < best) best = perSecond;
+    }
+    return best;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    double seconds = 60.0;
+    int runs = 3;
+    std::vector<std::pair<int, int>> pairs = {
+            { 44100, 48000 },
+            { 48000, 44100 },
+            { 32000, 48000 },
+            { 96000, 48000 },
+            { 44100, 48001 },
+    };
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--seconds" && i + 1 < argc) {
+            seconds = std::max(1.0, std::atof(argv[++i]));
+        } else if (arg == "--runs" && i + 1 < argc) {
+            runs = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--pair" && i + 1 < argc) {
+            int in = 0;
+            int out = 0;
+            if (std::sscanf(argv[++i], "%d:%d", &in, &out) != 2 || in <= 0 || out <= 0) {
+                std::fprintf(stderr, "bad --pair, expected IN:OUT\n");
+                return 1;
+            }
+            static bool customPairs = false;
+            if (!customPairs) pairs.clear();
+            customPairs = true;
+            pairs.emplace_back(in, out);
+        } else {
+            std::printf(
+                    "usage: siliconplayer_resampler_bench [--seconds S] [--runs N] [--pair IN:OUT]...\n"
+                    "Reports thread CPU milliseconds per second of stereo output audio.\n"
+            );
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+
+    std::vector<std::pair<const char*, std::function<RenderFn(SignalSource&, int, int)>>> paths = {
+            { "linear", makeLinear },
+            { "sinc", makeSinc },
+#if defined(SILICONPLAYER_BENCH_HAS_SWRESAMPLE)
+            { "sox", makeSox },
+#endif
+    };
+
+    std::printf("%-8s %-15s %14s\n", "path", "rates", "cpu ms/audio s");
+    for (const auto& [inputRate, outputRate] : pairs) {
+        for (const auto& [name, make] : paths) {
+            const int in = inputRate;
+            const int out = outputRate;
+            const double ms = measure(
+                    [&make, in, out](SignalSource& source) { return make(source, in, out); },
+                    inputRate,
+                    outputRate,
+                    seconds,
+                    runs
+            );
+            char rates[32];
+            std::snprintf(rates, sizeof(rates), "%d->%d", inputRate, outputRate);
+            if (ms < 0.0) {
+                std::printf("%-8s %-15s %14s\n", name, rates, "unavailable");
+            } else {
+                std::printf("%-8s %-15s %14.3f\n", name, rates, ms);
+            }
+        }
+    }
+    return 0;
+}
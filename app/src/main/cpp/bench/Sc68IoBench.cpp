@@ -0,0 +1,520 @@
+// sc68 YM-2149 pulse generator and Paula mixer null test and throughput.
+//
+// Renders each tune twice per configuration, once with the per-sample
+// reference code (ym-block / amiga-block off) and once with the block code
+// that fills steady generator runs at once and mixes the Paula voices in
+// vector lanes, checks that the PCM and voice taps are bit-identical and
+// reports CPU time per output frame for both. YM tunes run through every
+// ym-filter of the pulse engine, Amiga tunes through both Paula engines
+// (amiga-filter off/on), at 48 and 96 kHz.
+//
+// Two tunes are built in, hand-assembled below: an Atari SNDH playing tone,
+// noise and envelope voices under a ~10 kHz timer-A digi-drum (the low-end
+// worst case), and an Amiga sc68 file looping four Paula voices with period
+// and volume sweeps. --tune adds real SNDH/sc68 files. --dump writes the
+// block renders to a directory and --compare checks them against an earlier
+// dump, e.g. from a build before a change to io68:
+//
+//   siliconplayer_sc68_io_bench --dump /tmp/sc68-io-ref
+//   siliconplayer_sc68_io_bench --compare /tmp/sc68-io-ref
+
+#include <sc68/sc68.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <initializer_list>
+#include <iterator>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr int kBlockFrames = 1024;
+constexpr int kTapPlanes = SC68_SCOPE_MAX_CHANNELS;
+constexpr int kRates[] = { 48000, 96000 };
+constexpr const char* kYmFilters[] = { "2-poles", "mixed", "1-pole", "boxcar", "none" };
+constexpr const char* kPaulaEngines[] = { "simple", "linear" };
+
+// Thread CPU time: on a shared or throttled core wall time swings more
+// than the differences being measured.
+double threadCpuSeconds() {
+    timespec now {};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return static_cast<double>(now.tv_sec) + static_cast<double>(now.tv_nsec) * 1e-9;
+}
+
+// Just enough of a 68000 assembler for the built-in tunes: opcode words are
+// written out by hand, PC-relative operands and branches are patched once
+// every label is known.
+class Code68 {
+public:
+    void word(uint16_t value) {
+        bytes_.push_back(static_cast<uint8_t>(value >> 8));
+        bytes_.push_back(static_cast<uint8_t>(value));
+    }
+    void words(std::initializer_list<uint16_t> values) {
+        for (const uint16_t value : values) word(value);
+    }
+    void text(const char* value) {
+        bytes_.insert(bytes_.end(), value, value + std::strlen(value) + 1);
+    }
+    void data(const std::vector<uint8_t>& values) {
+        bytes_.insert(bytes_.end(), values.begin(), values.end());
+    }
+    void even() {
+        if (bytes_.size() & 1) bytes_.push_back(0);
+    }
+    void label(const std::string& name) {
+        labels_[name] = bytes_.size();
+    }
+    // 16-bit displacement from this extension word to the label, as taken
+    // by (d16,PC) operands and bra.w/bsr.w.
+    void pcRelative(const std::string& name) {
+        fixups_.emplace_back(bytes_.size(), name);
+        word(0);
+    }
+    std::vector<uint8_t> finish() const {
+        std::vector<uint8_t> out = bytes_;
+        for (const auto& [offset, name] : fixups_) {
+            const auto target = labels_.find(name);
+            if (target == labels_.end()) {
+                std::fprintf(stderr, "Code68: undefined label '%s'\n", name.c_str());
+                std::abort();
+            }
+            const auto displacement = static_cast<uint16_t>(static_cast<int>(target->second) - static_cast<int>(offset));
+            out[offset] = static_cast<uint8_t>(displacement >> 8);
+            out[offset + 1] = static_cast<uint8_t>(displacement);
+        }
+        return out;
+    }
+
+private:
+    std::vector<uint8_t> bytes_;
+    std::map<std::string, size_t> labels_;
+    std::vector<std::pair<size_t, std::string>> fixups_;
+};
+
+// move.b #reg,(a0) / move.b #value,2(a0) with a0 = $ffff8800.
+void ymWrite(Code68& code, uint8_t reg, uint8_t value) {
+    code.words({ 0x10BC, reg, 0x117C, value, 0x0002 });
+}
+
+// Tone on A and B, noise on B, envelope on C, and volume A driven by a
+// timer-A interrupt at 2457600/4/61 = ~10 kHz stepping a 4-bit sawtooth.
+std::vector<uint8_t> builtInSndh() {
+    Code68 code;
+    code.word(0x6000); code.pcRelative("init");
+    code.word(0x6000); code.pcRelative("exit");
+    code.word(0x6000); code.pcRelative("play");
+    code.text("SNDH");
+    code.text("TITLsc68 io bench digi");
+    code.text("TC50");
+    code.text("HDNS");
+    code.even();
+
+    code.label("init");
+    code.words({ 0x41F8, 0x8800 });                 // lea $ffff8800.w,a0
+    ymWrite(code, 0, 0x80); ymWrite(code, 1, 0x01); // A period
+    ymWrite(code, 2, 0xC3); ymWrite(code, 3, 0x00); // B period
+    ymWrite(code, 4, 0x20); ymWrite(code, 5, 0x02); // C period
+    ymWrite(code, 6, 0x07);                         // noise period
+    ymWrite(code, 7, 0xE8);                         // tone ABC, noise B
+    ymWrite(code, 8, 0x0F); ymWrite(code, 9, 0x0C); ymWrite(code, 10, 0x10);
+    ymWrite(code, 11, 0x00); ymWrite(code, 12, 0x04); ymWrite(code, 13, 0x0C);
+    code.word(0x43FA); code.pcRelative("digi");     // lea digi(pc),a1
+    code.words({ 0x21C9, 0x0134 });                 // move.l a1,$134.w
+    code.words({ 0x11FC, 0x0040, 0xFA17 });         // move.b #$40,$fffffa17.w (VR)
+    code.words({ 0x11FC, 0x003D, 0xFA1F });         // move.b #61,$fffffa1f.w (TADR)
+    code.words({ 0x11FC, 0x0001, 0xFA19 });         // move.b #1,$fffffa19.w (TACR /4)
+    code.words({ 0x08F8, 0x0005, 0xFA07 });         // bset #5,$fffffa07.w (IERA)
+    code.words({ 0x08F8, 0x0005, 0xFA13 });         // bset #5,$fffffa13.w (IMRA)
+    code.label("exit");
+    code.word(0x4E75);                              // rts
+
+    code.label("play");
+    code.words({ 0x41F8, 0x8800 });                 // lea $ffff8800.w,a0
+    code.word(0x43FA); code.pcRelative("frame");    // lea frame(pc),a1
+    code.words({ 0x5251, 0x3011 });                 // addq.w #1,(a1) / move.w (a1),d0
+    code.words({ 0x10BC, 0x0000, 0x1140, 0x0002 }); // A period low = frame
+    code.words({ 0x0A00, 0x005A });                 // eori.b #$5a,d0
+    code.words({ 0x10BC, 0x0002, 0x1140, 0x0002 }); // B period low
+    code.words({ 0x10BC, 0x0006, 0x1140, 0x0002 }); // noise period
+    code.words({ 0x3200, 0xC27C, 0x000F });         // move.w d0,d1 / and.w #15,d1
+    code.word(0x660A);                              // bne.s +10
+    ymWrite(code, 13, 0x0C);                        // retrigger the envelope
+    code.word(0x4E75);                              // rts
+
+    code.label("digi");
+    code.words({ 0x2F08, 0x2F00 });                 // move.l a0,-(sp) / move.l d0,-(sp)
+    code.word(0x41FA); code.pcRelative("phase");    // lea phase(pc),a0
+    code.words({ 0x5210, 0x1010 });                 // addq.b #1,(a0) / move.b (a0),d0
+    code.words({ 0x0200, 0x000F });                 // andi.b #15,d0
+    code.words({ 0x11FC, 0x0008, 0x8800 });         // move.b #8,$ffff8800.w
+    code.words({ 0x11C0, 0x8802 });                 // move.b d0,$ffff8802.w
+    code.words({ 0x201F, 0x205F });                 // move.l (sp)+,d0 / move.l (sp)+,a0
+    code.words({ 0x08B8, 0x0005, 0xFA0F });         // bclr #5,$fffffa0f.w (ISRA)
+    code.word(0x4E73);                              // rte
+
+    code.label("frame");
+    code.word(0);
+    code.label("phase");
+    code.word(0);
+    return code.finish();
+}
+
+void appendLittle32(std::vector<uint8_t>& out, uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) out.push_back(static_cast<uint8_t>(value >> shift));
+}
+
+void appendChunk(std::vector<uint8_t>& out, const char* id, const std::vector<uint8_t>& payload) {
+    out.insert(out.end(), { 'S', 'C', static_cast<uint8_t>(id[0]), static_cast<uint8_t>(id[1]) });
+    appendLittle32(out, static_cast<uint32_t>(payload.size()));
+    out.insert(out.end(), payload.begin(), payload.end());
+}
+
+// Four voices looping 8-bit samples of different lengths: voice 0 sweeps its
+// period, voice 1 its volume, voice 3 alternates between two samples.
+std::vector<uint8_t> builtInAmiga() {
+    Code68 code;
+    code.word(0x6000); code.pcRelative("init");
+    code.words({ 0x4E75, 0x4E71 });                 // exit: rts / nop
+    code.word(0x6000); code.pcRelative("play");
+
+    static constexpr struct {
+        const char* sample;
+        uint16_t period;
+        uint16_t volume;
+    } kVoices[] = {
+            { "saw", 428, 64 },
+            { "square", 214, 48 },
+            { "noise", 160, 40 },
+            { "sine", 340, 64 },
+    };
+    code.label("init");
+    code.words({ 0x4DF9, 0x00DF, 0xF000 });         // lea $dff000,a6
+    for (int voice = 0; voice < 4; ++voice) {
+        const uint16_t base = static_cast<uint16_t>(0xA0 + voice * 0x10);
+        code.word(0x41FA); code.pcRelative(kVoices[voice].sample); // lea sample(pc),a0
+        code.words({ 0x2D48, base });               // move.l a0,AUDxLC(a6)
+        code.words({ 0x3D7C, static_cast<uint16_t>(voice == 2 ? 0x0300 : voice == 3 ? 0x0080 : 0x0040),
+                     static_cast<uint16_t>(base + 4) }); // AUDxLEN (words)
+        code.words({ 0x3D7C, kVoices[voice].period, static_cast<uint16_t>(base + 6) });
+        code.words({ 0x3D7C, kVoices[voice].volume, static_cast<uint16_t>(base + 8) });
+    }
+    code.words({ 0x3D7C, 0x820F, 0x0096 });         // DMACON: DMAEN + AUD0-3
+    code.word(0x4E75);                              // rts
+
+    code.label("play");
+    code.words({ 0x4DF9, 0x00DF, 0xF000 });         // lea $dff000,a6
+    code.word(0x41FA); code.pcRelative("frame");    // lea frame(pc),a0
+    code.words({ 0x5250, 0x3010 });                 // addq.w #1,(a0) / move.w (a0),d0
+    code.words({ 0x3200, 0xC27C, 0x003F });         // move.w d0,d1 / and.w #63,d1
+    code.words({ 0xD241, 0xD241, 0xD27C, 0x00C8 }); // d1 = d1 * 4 + 200
+    code.words({ 0x3D41, 0x00A6 });                 // AUD0PER
+    code.words({ 0x3200, 0xC27C, 0x003F });         // move.w d0,d1 / and.w #63,d1
+    code.words({ 0x3D41, 0x00B8 });                 // AUD1VOL
+    code.word(0x43FA); code.pcRelative("sine");     // lea sine(pc),a1
+    code.words({ 0x0800, 0x0003, 0x6704 });         // btst #3,d0 / beq.s +4
+    code.word(0x43FA); code.pcRelative("saw");      // lea saw(pc),a1
+    code.words({ 0x2D49, 0x00D0 });                 // AUD3LC
+    code.word(0x4E75);                              // rts
+
+    code.label("frame");
+    code.word(0);
+    std::vector<uint8_t> saw(128), square(128), noise(1536), sine(256);
+    for (size_t i = 0; i < saw.size(); ++i) saw[i] = static_cast<uint8_t>(i * 2 - 128);
+    for (size_t i = 0; i < square.size(); ++i) square[i] = i < square.size() / 2 ? 0x60 : 0xA0;
+    uint32_t seed = 0x1234567u;
+    for (uint8_t& value : noise) {
+        seed = seed * 1103515245u + 12345u;
+        value = static_cast<uint8_t>(seed >> 24);
+    }
+    // Quarter-wave table mirrored into a full period.
+    static constexpr uint8_t kQuarter[] = { 0, 12, 25, 37, 49, 60, 71, 81, 90, 98, 106, 112, 117, 122, 125, 126 };
+    for (size_t i = 0; i < sine.size(); ++i) {
+        const size_t phase = i % 64 / 4;
+        const int value = (i / 64) % 2 == 0 ? kQuarter[phase] : kQuarter[15 - phase];
+        sine[i] = static_cast<uint8_t>(i < 128 ? value : -value);
+    }
+    code.label("saw"); code.data(saw);
+    code.label("square"); code.data(square);
+    code.label("noise"); code.data(noise);
+    code.label("sine"); code.data(sine);
+    const std::vector<uint8_t> music = code.finish();
+
+    std::vector<uint8_t> body;
+    appendChunk(body, "MU", {});
+    appendChunk(body, "MN", { 's', 'c', '6', '8', ' ', 'i', 'o', ' ', 'b', 'e', 'n', 'c', 'h', ' ', 'p', 'a', 'u', 'l', 'a', 0 });
+    std::vector<uint8_t> hardware;
+    appendLittle32(hardware, 1u << 2);              // SC68_AGA
+    appendChunk(body, "TY", hardware);
+    appendChunk(body, "DA", music);
+    appendChunk(body, "EF", {});
+
+    const char* const id = "SC68 Music-file / (c) (BeN)jamin Gerard / SasHipA-Dev  ";
+    std::vector<uint8_t> file(id, id + std::strlen(id) + 1);
+    file.insert(file.end(), { 'S', 'C', '6', '8' });
+    appendLittle32(file, static_cast<uint32_t>(body.size() + 8));
+    file.insert(file.end(), body.begin(), body.end());
+    return file;
+}
+
+struct Tune {
+    std::string name;
+    std::vector<uint8_t> data;
+    bool amiga = false;
+};
+
+struct Options {
+    std::vector<std::string> tunes;
+    double seconds = 30.0;
+    int runs = 3;
+    std::string dumpDir;
+    std::string compareDir;
+};
+
+bool readFile(const std::string& path, std::vector<uint8_t>& data) {
+    std::ifstream input(path, std::ios::binary);
+    if (!input) return false;
+    data.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    return true;
+}
+
+// The options are read when an instance (and its chips) is created.
+void setOptions(const Tune& tune, const char* variant, bool block) {
+    sc68_cntl(nullptr, SC68_SET_OPT_STR, "ym-engine", "pulse");
+    if (tune.amiga) {
+        sc68_cntl(nullptr, SC68_SET_OPT_INT, "amiga-filter", std::strcmp(variant, "linear") == 0 ? 1 : 0);
+    } else {
+        sc68_cntl(nullptr, SC68_SET_OPT_STR, "ym-filter", variant);
+    }
+    sc68_cntl(nullptr, SC68_SET_OPT_INT, "ym-block", block ? 1 : 0);
+    sc68_cntl(nullptr, SC68_SET_OPT_INT, "amiga-block", block ? 1 : 0);
+}
+
+sc68_t* open(const Tune& tune, int rate) {
+    sc68_create_t create {};
+    create.sampling_rate = static_cast<unsigned>(rate);
+    sc68_t* handle = sc68_create(&create);
+    if (handle == nullptr) return nullptr;
+    sc68_cntl(handle, SC68_SET_PCM, SC68_PCM_S16);
+    if (sc68_load_mem(handle, tune.data.data(), static_cast<int>(tune.data.size())) != 0 ||
+        sc68_play(handle, 1, SC68_INF_LOOP) != 0) {
+        sc68_destroy(handle);
+        return nullptr;
+    }
+    return handle;
+}
+
+struct Run {
+    double seconds = 0.0;
+    std::vector<int16_t> pcm;
+    std::vector<int16_t> taps;
+};
+
+// Renders options.seconds of audio. A kept run also installs the voice taps
+// and stores the output; timed runs do neither.
+bool render(const Tune& tune, const char* variant, int rate, bool block, const Options& options, bool keep, Run& run) {
+    setOptions(tune, variant, block);
+    sc68_t* handle = open(tune, rate);
+    if (handle == nullptr) return false;
+    std::vector<int16_t> pcm(static_cast<size_t>(kBlockFrames) * 2);
+    std::vector<int16_t> planes(static_cast<size_t>(kTapPlanes) * kBlockFrames);
+    sc68_voice_taps_t taps {};
+    if (keep) {
+        for (int plane = 0; plane < kTapPlanes; ++plane) taps.planes[plane] = planes.data() + plane * kBlockFrames;
+        taps.capacity = kBlockFrames;
+        sc68_cntl(handle, SC68_SET_VOICE_TAPS, &taps);
+    }
+    const int64_t totalFrames = static_cast<int64_t>(options.seconds * rate);
+    run.pcm.clear();
+    run.taps.clear();
+    bool ok = true;
+    const double start = threadCpuSeconds();
+    for (int64_t done = 0; done < totalFrames && ok;) {
+        int frames = static_cast<int>(std::min<int64_t>(kBlockFrames, totalFrames - done));
+        ok = sc68_process(handle, pcm.data(), &frames) != SC68_ERROR;
+        done += frames;
+        if (keep) {
+            run.pcm.insert(run.pcm.end(), pcm.begin(), pcm.begin() + frames * 2);
+            for (int plane = 0; plane < taps.channels; ++plane) {
+                const int16_t* planeData = planes.data() + plane * kBlockFrames;
+                run.taps.insert(run.taps.end(), planeData, planeData + taps.frames);
+            }
+        }
+    }
+    run.seconds = threadCpuSeconds() - start;
+    sc68_destroy(handle);
+    return ok;
+}
+
+// Prints where two renders differ; true when they are identical.
+bool compareRuns(const char* label, const Run& expected, const Run& actual) {
+    if (expected.pcm.size() != actual.pcm.size() || expected.taps.size() != actual.taps.size()) {
+        std::printf("  %s: different length\n", label);
+        return false;
+    }
+    size_t pcmMismatches = 0;
+    int maxDiff = 0;
+    for (size_t i = 0; i < expected.pcm.size(); ++i) {
+        const int diff = std::abs(expected.pcm[i] - actual.pcm[i]);
+        maxDiff = std::max(maxDiff, diff);
+        pcmMismatches += diff != 0;
+    }
+    size_t tapMismatches = 0;
+    for (size_t i = 0; i < expected.taps.size(); ++i) tapMismatches += expected.taps[i] != actual.taps[i];
+    if (pcmMismatches != 0 || tapMismatches != 0) {
+        std::printf("  %s: pcm %zu/%zu samples differ (max %d), taps %zu/%zu differ\n", label,
+                    pcmMismatches, expected.pcm.size(), maxDiff, tapMismatches, expected.taps.size());
+        return false;
+    }
+    return true;
+}
+
+std::string dumpPath(const std::string& dir, const Tune& tune, const char* variant, int rate) {
+    return dir + "/sc68io_" + tune.name + "_" + variant + "_" + std::to_string(rate) + ".raw";
+}
+
+bool writeDump(const std::string& path, const Run& run) {
+    std::ofstream output(path, std::ios::binary);
+    output.write(reinterpret_cast<const char*>(run.pcm.data()), static_cast<std::streamsize>(run.pcm.size() * sizeof(int16_t)));
+    output.write(reinterpret_cast<const char*>(run.taps.data()), static_cast<std::streamsize>(run.taps.size() * sizeof(int16_t)));
+    return static_cast<bool>(output);
+}
+
+bool readDump(const std::string& path, const Run& shape, Run& run) {
+    std::vector<uint8_t> data;
+    if (!readFile(path, data) || data.size() != (shape.pcm.size() + shape.taps.size()) * sizeof(int16_t)) {
+        return false;
+    }
+    run.pcm.resize(shape.pcm.size());
+    run.taps.resize(shape.taps.size());
+    std::memcpy(run.pcm.data(), data.data(), run.pcm.size() * sizeof(int16_t));
+    std::memcpy(run.taps.data(), data.data() + run.pcm.size() * sizeof(int16_t), run.taps.size() * sizeof(int16_t));
+    return true;
+}
+
+bool probeAmiga(Tune& tune) {
+    sc68_t* handle = open(tune, kRates[0]);
+    if (handle == nullptr) return false;
+    sc68_music_info_t info {};
+    const bool ok = sc68_music_info(handle, &info, 1, nullptr) == 0;
+    tune.amiga = ok && info.trk.amiga;
+    sc68_destroy(handle);
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--tune" && i + 1 < argc) {
+            options.tunes.emplace_back(argv[++i]);
+        } else if (arg == "--seconds" && i + 1 < argc) {
+            options.seconds = std::max(1.0, std::atof(argv[++i]));
+        } else if (arg == "--runs" && i + 1 < argc) {
+            options.runs = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--dump" && i + 1 < argc) {
+            options.dumpDir = argv[++i];
+        } else if (arg == "--compare" && i + 1 < argc) {
+            options.compareDir = argv[++i];
+        } else {
+            std::printf(
+                    "usage: siliconplayer_sc68_io_bench [--tune FILE.sndh|FILE.sc68]... [--seconds S]\n"
+                    "       [--runs N] [--dump DIR | --compare DIR]\n"
+                    "Renders S seconds (default 30) of the built-in tunes and every --tune with the\n"
+                    "io68 reference and block code, checks they match and reports the best of N\n"
+                    "runs. --dump/--compare write or check the block renders against a directory.\n"
+            );
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+
+    sc68_init_t init {};
+    init.flags.no_load_config = 1;
+    init.flags.no_save_config = 1;
+    if (sc68_init(&init) != 0) {
+        std::fprintf(stderr, "sc68_init failed\n");
+        return 1;
+    }
+
+    std::vector<Tune> tunes;
+    tunes.push_back({ "digi", builtInSndh() });
+    tunes.push_back({ "paula", builtInAmiga() });
+    for (const std::string& path : options.tunes) {
+        Tune tune;
+        tune.name = path.substr(path.find_last_of('/') + 1);
+        if (!readFile(path, tune.data)) {
+            std::fprintf(stderr, "could not read '%s'\n", path.c_str());
+            return 1;
+        }
+        tunes.push_back(std::move(tune));
+    }
+
+    std::printf("%.0f s per render, best of %d\n", options.seconds, options.runs);
+    std::printf("%-16s %-8s %6s %14s %14s %8s %s\n", "tune", "variant", "hz", "ref ns/frame", "block ns/frame", "speedup", "");
+    bool identical = true;
+    for (Tune& tune : tunes) {
+        if (!probeAmiga(tune)) {
+            std::fprintf(stderr, "sc68 could not play '%s'\n", tune.name.c_str());
+            return 1;
+        }
+        std::vector<const char*> variants;
+        if (tune.amiga) {
+            variants.assign(std::begin(kPaulaEngines), std::end(kPaulaEngines));
+        } else {
+            variants.assign(std::begin(kYmFilters), std::end(kYmFilters));
+        }
+        for (const char* variant : variants) {
+            for (const int rate : kRates) {
+                Run reference, block;
+                if (!render(tune, variant, rate, false, options, true, reference) ||
+                    !render(tune, variant, rate, true, options, true, block)) {
+                    std::fprintf(stderr, "sc68 could not render '%s'\n", tune.name.c_str());
+                    return 1;
+                }
+                const bool same = compareRuns("block vs reference", reference, block);
+                identical = same && identical;
+                // Interleaved so drifting clock speed hits both sides alike.
+                double bestReference = 0.0, bestBlock = 0.0;
+                for (int pass = 0; pass < options.runs; ++pass) {
+                    Run timed;
+                    render(tune, variant, rate, false, options, false, timed);
+                    bestReference = pass == 0 ? timed.seconds : std::min(bestReference, timed.seconds);
+                    render(tune, variant, rate, true, options, false, timed);
+                    bestBlock = pass == 0 ? timed.seconds : std::min(bestBlock, timed.seconds);
+                }
+                const double frames = options.seconds * rate;
+                std::printf("%-16s %-8s %6d %14.1f %14.1f %7.2fx %s\n", tune.name.c_str(), variant, rate,
+                            bestReference * 1e9 / frames, bestBlock * 1e9 / frames,
+                            bestReference / bestBlock, same ? "identical" : "DIFFERENT");
+                if (!options.dumpDir.empty() && !writeDump(dumpPath(options.dumpDir, tune, variant, rate), block)) {
+                    std::fprintf(stderr, "could not write to '%s'\n", options.dumpDir.c_str());
+                    return 1;
+                }
+                if (!options.compareDir.empty()) {
+                    Run golden;
+                    const std::string path = dumpPath(options.compareDir, tune, variant, rate);
+                    if (!readDump(path, block, golden)) {
+                        std::printf("  %s: missing or different length\n", path.c_str());
+                        identical = false;
+                    } else {
+                        identical = compareRuns("block vs dump", golden, block) && identical;
+                    }
+                }
+                std::fflush(stdout);
+            }
+        }
+    }
+    sc68_shutdown();
+    return identical ? 0 : 2;
+}
@@ -0,0 +1,381 @@
+// Spectrum visualization benchmark.
+//
+// Compares the render-thread cost of keeping the Bars visualization fed:
+//   legacy - render worker forced to 64-frame chunks, mono history append
+//            plus a 2048-point complex FFT every sampleRate/60 frames
+//   paced  - render worker at its normal chunk size, history append only;
+//            SpectrumAnalyzer runs on the polling thread, once per poll
+// Costs are thread CPU milliseconds per second of audio. maxdiff is the
+// largest bar difference between the two analyzers on identical windows.
+
+#include "SpectrumAnalyzer.h"
+
+#include <time.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int kChannels = 2;
+constexpr int kSampleRate = 48000;
+constexpr int kLegacyChunkFrames = 64; // max(64, baseChunkFrames / 4)
+constexpr int kLegacyHistorySize = 4096;
+constexpr int kPacedHistorySize = 16384;
+constexpr int kChunkSizes[] = { 256, 512, 1024 };
+constexpr int kPollsPerSecond = 60;
+
+int64_t threadCpuNs() {
+    timespec ts {};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000ll + ts.tv_nsec;
+}
+
+// One second of a swept tone over noise.
+std::vector<float> makeSignal() {
+    std::vector<float> signal(static_cast<size_t>(kSampleRate) * kChannels);
+    uint32_t seed = 1u;
+    double phase = 0.0;
+    for (int i = 0; i < kSampleRate; ++i) {
+        const double t = static_cast<double>(i) / kSampleRate;
+        phase += 2.0 * M_PI * (60.0 * std::pow(300.0, t)) / kSampleRate;
+        seed = seed * 1664525u + 1013904223u;
+        const float noise = (static_cast<float>(seed >> 8) / 16777216.0f - 0.5f) * 0.05f;
+        const float tone = static_cast<float>(0.5 * std::sin(phase));
+        signal[static_cast<size_t>(i) * 2] = tone + noise;
+        signal[static_cast<size_t>(i) * 2 + 1] = tone - noise;
+    }
+    return signal;
+}
+
+// Mirror of the per-hop AudioEngine analysis this benchmark replaces.
+constexpr int kLegacyFftSize = 2048;
+constexpr int kVisualizationSpectrumBins = 256;
+constexpr float kVisualizationMinDisplayHz = 35.0f;
+
+int computeVisualizationMinBin(int sampleRateHz) {
+    const int fftHalf = kLegacyFftSize / 2;
+    const float sampleRate = static_cast<float>(std::max(sampleRateHz, 1));
+    const float rawBin = (kVisualizationMinDisplayHz / sampleRate) * static_cast<float>(kLegacyFftSize);
+    return std::clamp(static_cast<int>(std::ceil(rawBin)), 1, fftHalf - 2);
+}
+
+float computeVisualizationTiltCompensation(float freqNorm) {
+    const float clamped = std::clamp(freqNorm, 0.0f, 1.0f);
+    const float shaped = std::pow(clamped, 0.85f);
+    // Attenuate low-end dominance while preserving high-band detail.
+    return 0.24f + (1.76f * shaped);
+}
+
+void fftInPlace(std::array<float, kLegacyFftSize>& real,
+                std::array<float, kLegacyFftSize>& imag) {
+    static bool bitReverseInitialized = false;
+    static std::array<int, kLegacyFftSize> bitReverse {};
+    if (!bitReverseInitialized) {
+        constexpr int kBitCount = 11; // log2(2048)
+        for (int i = 0; i < kLegacyFftSize; ++i) {
+            int x = i;
+            int reversed = 0;
+            for (int bit = 0; bit < kBitCount; ++bit) {
+                reversed = (reversed << 1) | (x & 1);
+                x >>= 1;
+            }
+            bitReverse[i] = reversed;
+        }
+        bitReverseInitialized = true;
+    }
+
+    for (int i = 0; i < kLegacyFftSize; ++i) {
+        const int j = bitReverse[i];
+        if (j > i) {
+            std::swap(real[i], real[j]);
+            std::swap(imag[i], imag[j]);
+        }
+    }
+
+    for (int len = 2; len <= kLegacyFftSize; len <<= 1) {
+        const int halfLen = len >> 1;
+        const float theta = -2.0f * static_cast<float>(M_PI) / static_cast<float>(len);
+        const float phaseStepReal = std::cos(theta);
+        const float phaseStepImag = std::sin(theta);
+        for (int i = 0; i < kLegacyFftSize; i += len) {
+            float twiddleReal = 1.0f;
+            float twiddleImag = 0.0f;
+            for (int j = 0; j < halfLen; ++j) {
+                const int even = i + j;
+                const int odd = even + halfLen;
+                const float oddReal = real[odd];
+                const float oddImag = imag[odd];
+                const float tReal = (twiddleReal * oddReal) - (twiddleImag * oddImag);
+                const float tImag = (twiddleReal * oddImag) + (twiddleImag * oddReal);
+                const float evenReal = real[even];
+                const float evenImag = imag[even];
+
+                real[odd] = evenReal - tReal;
+                imag[odd] = evenImag - tImag;
+                real[even] = evenReal + tReal;
+                imag[even] = evenImag + tImag;
+
+                const float nextTwiddleReal =
+                        (twiddleReal * phaseStepReal) - (twiddleImag * phaseStepImag);
+                const float nextTwiddleImag =
+                        (twiddleReal * phaseStepImag) + (twiddleImag * phaseStepReal);
+                twiddleReal = nextTwiddleReal;
+                twiddleImag = nextTwiddleImag;
+            }
+        }
+    }
+}
+
+std::array<float, kVisualizationSpectrumBins> buildVisualizationBarsFromMonoHistory(
+        const std::array<float, 4096>& monoHistory,
+        int monoWriteIndex,
+        int sampleRateHz
+) {
+    std::array<float, kVisualizationSpectrumBins> bars {};
+    std::array<float, kLegacyFftSize> fftReal {};
+    std::array<float, kLegacyFftSize> fftImag {};
+    constexpr int kMonoHistorySize = 4096;
+    const int safeWriteIndex =
+            ((monoWriteIndex % kMonoHistorySize) + kMonoHistorySize) % kMonoHistorySize;
+    for (int n = 0; n < kLegacyFftSize; ++n) {
+        const int historyIndex =
+                (safeWriteIndex - kLegacyFftSize + n + kMonoHistorySize) % kMonoHistorySize;
+        fftReal[n] = monoHistory[historyIndex];
+    }
+
+    // Remove DC and apply Hann window before FFT.
+    double mean = 0.0;
+    for (float sample : fftReal) {
+        mean += sample;
+    }
+    mean /= static_cast<double>(kLegacyFftSize);
+    const float invSizeMinusOne = 1.0f / static_cast<float>(kLegacyFftSize - 1);
+    for (int n = 0; n < kLegacyFftSize; ++n) {
+        const float centered = fftReal[n] - static_cast<float>(mean);
+        const float phase = static_cast<float>(n) * invSizeMinusOne;
+        const float hann = 0.5f - (0.5f * std::cos(2.0f * static_cast<float>(M_PI) * phase));
+        fftReal[n] = centered * hann;
+        fftImag[n] = 0.0f;
+    }
+
+    fftInPlace(fftReal, fftImag);
+
+    const int fftHalf = kLegacyFftSize / 2;
+    const float sampleRate = static_cast<float>(std::max(sampleRateHz, 1));
+    const int minBin = computeVisualizationMinBin(sampleRateHz);
+    const int maxBin = fftHalf - 1;
+    const float minFrequencyHz =
+            (static_cast<float>(minBin) * sampleRate) / static_cast<float>(kLegacyFftSize);
+    const float maxFrequencyHz =
+            (static_cast<float>(maxBin) * sampleRate) / static_cast<float>(kLegacyFftSize);
+    const float frequencyRatio = std::max(maxFrequencyHz / std::max(minFrequencyHz, 1.0f), 1.001f);
+    for (int band = 0; band < kVisualizationSpectrumBins; ++band) {
+        const float t0 = static_cast<float>(band) / static_cast<float>(kVisualizationSpectrumBins);
+        const float t1 = static_cast<float>(band + 1) / static_cast<float>(kVisualizationSpectrumBins);
+        const float startFrequencyHz = minFrequencyHz * std::pow(frequencyRatio, t0);
+        const float endFrequencyHz = minFrequencyHz * std::pow(frequencyRatio, t1);
+        const int startBin = static_cast<int>(std::floor(
+                (startFrequencyHz / sampleRate) * static_cast<float>(kLegacyFftSize)));
+        const int endBin = static_cast<int>(std::ceil(
+                (endFrequencyHz / sampleRate) * static_cast<float>(kLegacyFftSize))) - 1;
+        const int clampedStart = std::clamp(startBin, minBin, maxBin);
+        const int clampedEnd = std::clamp(std::max(endBin, clampedStart), clampedStart, maxBin);
+
+        double powerSum = 0.0;
+        int count = 0;
+        for (int bin = clampedStart; bin <= clampedEnd; ++bin) {
+            const double re = fftReal[bin];
+            const double im = fftImag[bin];
+            powerSum += (re * re) + (im * im);
+            count += 1;
+        }
+        if (count <= 0) {
+            bars[band] = 0.0f;
+            continue;
+        }
+
+        const double avgPower = powerSum / static_cast<double>(count);
+        const double magnitude = std::sqrt(avgPower) / static_cast<double>(kLegacyFftSize);
+        const float freqNorm = t0;
+        const float tiltCompensation = computeVisualizationTiltCompensation(freqNorm);
+        const double weighted = magnitude * static_cast<double>(68.0f * tiltCompensation);
+        // Soft knee prevents early saturation while preserving detail.
+        bars[band] = static_cast<float>(std::clamp(weighted / (1.0 + weighted), 0.0, 1.0));
+    }
+    return bars;
+}
+
+template <size_t N>
+void appendMono(const float* chunk, int frames, std::array<float, N>& history, int& writeIndex) {
+    for (int frame = 0; frame < frames; ++frame) {
+        const float mono = 0.5f * (chunk[frame * kChannels] + chunk[frame * kChannels + 1]);
+        history[writeIndex] = std::clamp(mono, -1.0f, 1.0f);
+        writeIndex = (writeIndex + 1) % static_cast<int>(N);
+    }
+}
+
+struct Result {
+    double renderMsPerSecond = 0.0;
+    double pollMsPerSecond = 0.0;
+    int chunksPerSecond = 0;
+    int analysesPerSecond = 0;
+};
+
+Result measureLegacy(const std::vector<float>& signal, double seconds) {
+    Result result;
+    std::array<float, kLegacyHistorySize> history {};
+    int writeIndex = 0;
+    int framesSinceAnalysis = 0;
+    const int hopFrames = std::clamp(kSampleRate / 60, 128, 4096);
+    const int64_t totalFrames = static_cast<int64_t>(seconds * kSampleRate);
+    const size_t signalFrames = signal.size() / kChannels;
+    int64_t chunks = 0;
+    int64_t analyses = 0;
+    size_t cursor = 0;
+
+    const int64_t start = threadCpuNs();
+    for (int64_t done = 0; done < totalFrames; done += kLegacyChunkFrames) {
+        appendMono(signal.data() + cursor * kChannels, kLegacyChunkFrames, history, writeIndex);
+        cursor = (cursor + kLegacyChunkFrames) % signalFrames;
+        ++chunks;
+        framesSinceAnalysis += kLegacyChunkFrames;
+        if (framesSinceAnalysis >= hopFrames) {
+            framesSinceAnalysis %= hopFrames;
+            const std::array<float, kLegacyHistorySize> snapshot = history;
+            const auto bars = buildVisualizationBarsFromMonoHistory(snapshot, writeIndex, kSampleRate);
+            volatile float sink = bars[0];
+            (void)sink;
+            ++analyses;
+        }
+    }
+    result.renderMsPerSecond = static_cast<double>(threadCpuNs() - start) / 1.0e6 / seconds;
+    result.chunksPerSecond = static_cast<int>(static_cast<double>(chunks) / seconds);
+    result.analysesPerSecond = static_cast<int>(static_cast<double>(analyses) / seconds);
+    return result;
+}
+
+Result measurePaced(const std::vector<float>& signal, int chunkFrames, double seconds) {
+    Result result;
+    std::array<float, kPacedHistorySize> history {};
+    std::array<float, SpectrumAnalyzer::kFftSize> window {};
+    std::array<float, SpectrumAnalyzer::kBands> bars {};
+    SpectrumAnalyzer analyzer;
+    int writeIndex = 0;
+    const int64_t totalFrames = static_cast<int64_t>(seconds * kSampleRate);
+    const size_t signalFrames = signal.size() / kChannels;
+    const int pollFrames = kSampleRate / kPollsPerSecond;
+    int64_t nextPollFrame = pollFrames;
+    int64_t renderNs = 0;
+    int64_t pollNs = 0;
+    int64_t chunks = 0;
+    int64_t analyses = 0;
+    size_t cursor = 0;
+
+    for (int64_t done = 0; done < totalFrames; done += chunkFrames) {
+        int64_t start = threadCpuNs();
+        for (int remaining = chunkFrames; remaining > 0;) {
+            const int frames = std::min(remaining, static_cast<int>(signalFrames - cursor));
+            appendMono(signal.data() + cursor * kChannels, frames, history, writeIndex);
+            cursor = (cursor + frames) % signalFrames;
+            remaining -= frames;
+        }
+        renderNs += threadCpuNs() - start;
+        ++chunks;
+
+        // Polls that land inside this chunk, as seen by the UI thread.
+        start = threadCpuNs();
+        while (nextPollFrame <= done + chunkFrames) {
+            const int windowStart = (writeIndex - SpectrumAnalyzer::kFftSize + kPacedHistorySize) % kPacedHistorySize;
+            const int firstPart = std::min(SpectrumAnalyzer::kFftSize, kPacedHistorySize - windowStart);
+            std::copy_n(history.begin() + windowStart, firstPart, window.begin());
+            std::copy_n(history.begin(), SpectrumAnalyzer::kFftSize - firstPart, window.begin() + firstPart);
+            analyzer.analyze(window.data(), kSampleRate, bars);
+            nextPollFrame += pollFrames;
+            ++analyses;
+        }
+        pollNs += threadCpuNs() - start;
+    }
+    result.renderMsPerSecond = static_cast<double>(renderNs) / 1.0e6 / seconds;
+    result.pollMsPerSecond = static_cast<double>(pollNs) / 1.0e6 / seconds;
+    result.chunksPerSecond = static_cast<int>(static_cast<double>(chunks) / seconds);
+    result.analysesPerSecond = static_cast<int>(static_cast<double>(analyses) / seconds);
+    return result;
+}
+
+float measureMaxDiff(const std::vector<float>& signal) {
+    std::array<float, kLegacyHistorySize> history {};
+    std::array<float, SpectrumAnalyzer::kBands> bars {};
+    SpectrumAnalyzer analyzer;
+    float maxDiff = 0.0f;
+    const int signalFrames = static_cast<int>(signal.size() / kChannels);
+    for (int end = kLegacyHistorySize; end <= signalFrames; end += 997) {
+        int writeIndex = 0;
+        appendMono(signal.data() + static_cast<size_t>(end - kLegacyHistorySize) * kChannels, kLegacyHistorySize, history, writeIndex);
+        const auto legacy = buildVisualizationBarsFromMonoHistory(history, writeIndex, kSampleRate);
+        analyzer.analyze(history.data() + kLegacyHistorySize - SpectrumAnalyzer::kFftSize, kSampleRate, bars);
+        for (int band = 0; band < SpectrumAnalyzer::kBands; ++band) {
+            maxDiff = std::max(maxDiff, std::abs(legacy[band] - bars[band]));
+        }
+    }
+    return maxDiff;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    double seconds = 30.0;
+    int runs = 3;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--seconds" && i + 1 < argc) {
+            seconds = std::max(1.0, std::atof(argv[++i]));
+        } else if (arg == "--runs" && i + 1 < argc) {
+            runs = std::max(1, std::atoi(argv[++i]));
+        } else {
+            std::printf(
+                    "usage: siliconplayer_spectrum_bench [--seconds S] [--runs N]\n"
+                    "Reports render-thread and polling-thread CPU ms per second of audio\n"
+                    "with the Bars visualization visible, legacy vs demand-paced.\n"
+            );
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+
+    const std::vector<float> signal = makeSignal();
+    std::printf("bars maxdiff legacy vs SpectrumAnalyzer: %.3g\n\n", static_cast<double>(measureMaxDiff(signal)));
+    std::printf(
+            "%-7s %6s %8s %10s %12s %11s\n",
+            "path", "chunk", "chunks/s", "analyses/s", "render ms/s", "poll ms/s"
+    );
+
+    Result best;
+    for (int run = 0; run < runs; ++run) {
+        const Result r = measureLegacy(signal, seconds);
+        if (run == 0 || r.renderMsPerSecond < best.renderMsPerSecond) best = r;
+    }
+    std::printf(
+            "%-7s %6d %8d %10d %12.3f %11s\n",
+            "legacy", kLegacyChunkFrames, best.chunksPerSecond, best.analysesPerSecond, best.renderMsPerSecond, "-"
+    );
+    for (const int chunkFrames : kChunkSizes) {
+        for (int run = 0; run < runs; ++run) {
+            const Result r = measurePaced(signal, chunkFrames, seconds);
+            if (run == 0 || r.renderMsPerSecond + r.pollMsPerSecond < best.renderMsPerSecond + best.pollMsPerSecond) {
+                best = r;
+            }
+        }
+        std::printf(
+                "%-7s %6d %8d %10d %12.3f %11.3f\n",
+                "paced", chunkFrames, best.chunksPerSecond, best.analysesPerSecond, best.renderMsPerSecond,
+                best.pollMsPerSecond
+        );
+    }
+    return 0;
+}
@@ -0,0 +1,32 @@
+#ifndef SILICONPLAYER_BENCH_ANDROID_LOG_H
+#define SILICONPLAYER_BENCH_ANDROID_LOG_H
+
+// Host stand-in for <android/log.h> so decoder sources build unchanged in the
+// render benchmark. Output goes to stderr, filtered by SP_BENCH_LOG_LEVEL
+// (Android priority number, default ANDROID_LOG_WARN).
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum android_LogPriority {
+    ANDROID_LOG_UNKNOWN = 0,
+    ANDROID_LOG_DEFAULT,
+    ANDROID_LOG_VERBOSE,
+    ANDROID_LOG_DEBUG,
+    ANDROID_LOG_INFO,
+    ANDROID_LOG_WARN,
+    ANDROID_LOG_ERROR,
+    ANDROID_LOG_FATAL,
+    ANDROID_LOG_SILENT
+} android_LogPriority;
+
+int __android_log_print(int prio, const char* tag, const char* fmt, ...)
+        __attribute__((format(printf, 3, 4)));
+int __android_log_write(int prio, const char* tag, const char* text);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SILICONPLAYER_BENCH_ANDROID_LOG_H
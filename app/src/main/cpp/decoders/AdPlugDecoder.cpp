@@ -5,6 +5,7 @@
 #include <adplug/kemuopl.h>
 #include <adplug/nemuopl.h>
 #include <adplug/player.h>
+#include <adplug/silentopl.h>
 #include <adplug/wemuopl.h>
 
 #include <algorithm>
@@ -249,6 +250,23 @@ int normalizeAdlibCore(int value) {
 std::string safeString(const std::string& value) {
     return value;
 }
+
+// Runs on the duration analysis worker: songlength() replays the whole
+// subtune, so it gets its own player on a silent OPL.
+bool analyzeAdPlugSubtune(const std::string& path, int index, DurationCacheEntry& entry) {
+    entry = DurationCacheEntry();
+    CSilentopl silentOpl;
+    std::unique_ptr<CPlayer> probe(CAdPlug::factory(path, &silentOpl));
+    if (!probe) {
+        return false;
+    }
+    const unsigned long durationMs = probe->songlength(index);
+    if (durationMs > 0) {
+        entry.durationMs = static_cast<uint32_t>(std::min<unsigned long>(durationMs, UINT32_MAX));
+        entry.flags = kDurationFlagReliable;
+    }
+    return true;
+}
 }
 
 AdPlugDecoder::AdPlugDecoder()
@@ -288,9 +306,12 @@ bool AdPlugDecoder::open(const char* path) {
     subtuneCount = std::max(1u, player->getsubsongs());
     currentSubtuneIndex = std::clamp(static_cast<int>(player->getsubsong()), 0, subtuneCount - 1);
 
-    const unsigned long durationMs = player->songlength(currentSubtuneIndex);
-    durationReliable = durationMs > 0;
-    durationSeconds = durationMs > 0 ? static_cast<double>(durationMs) / 1000.0 : 0.0;
+    subtuneDurationMs.assign(static_cast<size_t>(subtuneCount), -1);
+    subtuneDurationRequested.assign(static_cast<size_t>(subtuneCount), 0u);
+    if (!DurationAnalysisClient::hashFile(sourcePath, contentHash)) {
+        contentHash = 0;
+    }
+    updateCurrentDurationLocked();
 
     remainingTickFrames = 0;
     playbackPositionSeconds = 0.0;
@@ -319,6 +340,49 @@ void AdPlugDecoder::closeInternalLocked() {
     reachedEnd = false;
     toggleChannelNames.clear();
     toggleChannelMuted.clear();
+    subtuneDurationMs.clear();
+    subtuneDurationRequested.clear();
+    contentHash = 0;
+}
+
+int64_t AdPlugDecoder::refreshSubtuneDurationLocked(int index) {
+    if (index < 0 || index >= static_cast<int>(subtuneDurationMs.size())) {
+        return 0;
+    }
+    const size_t slot = static_cast<size_t>(index);
+    if (subtuneDurationMs[slot] >= 0 || contentHash == 0) {
+        return std::max<int64_t>(0, subtuneDurationMs[slot]);
+    }
+
+    DurationCacheKey key;
+    key.contentHash = contentHash;
+    key.coreTag = DurationAnalysisClient::coreTag(getName());
+    key.subtune = static_cast<uint32_t>(index);
+    DurationCacheEntry entry;
+    DurationAnalysisClient& durations = DurationAnalysisClient::getInstance();
+    if (subtuneDurationRequested[slot] != 0u) {
+        if (!durations.poll(key, entry)) {
+            return 0;
+        }
+    } else if (!durations.lookup(getName(), key, entry)) {
+        // Analyze off the render path; read() picks the result up.
+        subtuneDurationRequested[slot] = 1u;
+        const std::string path = sourcePath;
+        durations.request(getName(), key, [path, index](DurationCacheEntry& result) {
+            return analyzeAdPlugSubtune(path, index, result);
+        });
+        return 0;
+    }
+    subtuneDurationMs[slot] = (entry.flags & kDurationFlagReliable) != 0u
+            ? static_cast<int64_t>(entry.durationMs)
+            : 0;
+    return subtuneDurationMs[slot];
+}
+
+void AdPlugDecoder::updateCurrentDurationLocked() {
+    const int64_t durationMs = refreshSubtuneDurationLocked(currentSubtuneIndex);
+    durationReliable = durationMs > 0;
+    durationSeconds = durationMs > 0 ? static_cast<double>(durationMs) / 1000.0 : 0.0;
 }
 
 void AdPlugDecoder::close() {
@@ -333,6 +397,9 @@ int AdPlugDecoder::read(float* buffer, int numFrames) {
         return 0;
     }
     syncToggleChannelsLocked();
+    if (!durationReliable) {
+        updateCurrentDurationLocked();
+    }
 
     const int mode = repeatMode.load();
     const bool hasReliableDuration = durationSeconds >= 1.0;
@@ -506,10 +573,7 @@ bool AdPlugDecoder::selectSubtune(int index) {
     remainingTickFrames = 0;
     playbackPositionSeconds = 0.0;
     reachedEnd = false;
-
-    const unsigned long durationMs = player->songlength(currentSubtuneIndex);
-    durationReliable = durationMs > 0;
-    durationSeconds = durationMs > 0 ? static_cast<double>(durationMs) / 1000.0 : 0.0;
+    updateCurrentDurationLocked();
     return true;
 }
 
@@ -534,7 +598,7 @@ double AdPlugDecoder::getSubtuneDurationSeconds(int index) {
     if (!player || index < 0 || index >= subtuneCount) {
         return 0.0;
     }
-    const unsigned long durationMs = player->songlength(index);
+    const int64_t durationMs = refreshSubtuneDurationLocked(index);
     return durationMs > 0 ? static_cast<double>(durationMs) / 1000.0 : 0.0;
 }
 
@@ -842,29 +906,16 @@ std::shared_ptr<ChannelScopeSharedState> AdPlugDecoder::getChannelScopeSharedSta
 
 std::vector<int32_t> AdPlugDecoder::getChannelScopeTextState(int maxChannels) {
     std::lock_guard<std::mutex> lock(decodeMutex);
-    if (scopeRingChannels <= 0 || scopeRingSamples <= 0 || scopeRingRaw.empty()) {
+    if (scopeRing.empty()) {
         return {};
     }
 
-    const int channelsToExport = std::min(scopeRingChannels, std::clamp(maxChannels, 1, 18));
+    const int channelsToExport = std::min(scopeRing.channels(), std::clamp(maxChannels, 1, 18));
     std::vector<int32_t> flat(static_cast<size_t>(channelsToExport * 10), -1);
     const int trailingSamples = std::clamp(sampleRateHz > 0 ? sampleRateHz / 50 : 64, 64, 1024);
-    const int recentSamples = std::min(scopeRingSamples, trailingSamples);
 
     for (int channel = 0; channel < channelsToExport; ++channel) {
-        float recentPeak = 0.0f;
-        for (int i = 0; i < recentSamples; ++i) {
-            const int ringIndex =
-                    (scopeRingWritePos - recentSamples + i + ChannelScopeSharedState::kMaxSamples) %
-                    ChannelScopeSharedState::kMaxSamples;
-            recentPeak = std::max(
-                    recentPeak,
-                    std::abs(scopeRingRaw[
-                            static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples +
-                            static_cast<size_t>(ringIndex)
-                    ])
-            );
-        }
+        const float recentPeak = scopeRing.recentPeak(channel, trailingSamples);
 
         const size_t base = static_cast<size_t>(channel * 10);
         int flags = 0;
@@ -892,82 +943,29 @@ void AdPlugDecoder::captureScopeSnapshotLocked(int numFrames) {
     }
     auto* trackingProxy = dynamic_cast<TrackingOplProxy*>(opl.get());
     const int activeChannels = trackingProxy ? trackingProxy->getVoiceCount() : 18;
-
-    if (scopeRingChannels != activeChannels || scopeRingRaw.size() != static_cast<size_t>(activeChannels * ChannelScopeSharedState::kMaxSamples)) {
-        scopeRingRaw.assign(static_cast<size_t>(activeChannels * ChannelScopeSharedState::kMaxSamples), 0.0f);
-        scopeRingChannels = activeChannels;
-        scopeRingWritePos = 0;
-        scopeRingSamples = 0;
-    }
+    scopeRing.ensureChannels(activeChannels);
 
     const bool isInterleaved = trackingProxy && trackingProxy->isScopeInterleaved();
-
-    if (isInterleaved) {
-        // Nuked OPL: interleaved format with 18 values per frame
-        for (int frame = 0; frame < numFrames; ++frame) {
-            for (int ch = 0; ch < activeChannels; ++ch) {
-                scopeRingRaw[
-                    static_cast<size_t>(ch) * ChannelScopeSharedState::kMaxSamples +
-                    static_cast<size_t>(scopeRingWritePos)
-                ] = std::clamp((static_cast<float>(scopeScratch[frame * 18 + ch]) / 32768.0f) * kAdPlugScopeGain, -1.0f, 1.0f);
-            }
-            scopeRingWritePos = (scopeRingWritePos + 1) % ChannelScopeSharedState::kMaxSamples;
-            scopeRingSamples = std::min(scopeRingSamples + 1, ChannelScopeSharedState::kMaxSamples);
-        }
-    } else {
-        // Planar engines (Mame, DosBox, KenSilverman): channels in sequence
-        for (int frame = 0; frame < numFrames; ++frame) {
-            const int dstIndex = (scopeRingWritePos + frame) % ChannelScopeSharedState::kMaxSamples;
-            for (int ch = 0; ch < activeChannels; ++ch) {
-                const int srcIndex = ch * numFrames + frame;
-                scopeRingRaw[
-                    static_cast<size_t>(ch) * ChannelScopeSharedState::kMaxSamples +
-                    static_cast<size_t>(dstIndex)
-                ] = std::clamp((static_cast<float>(scopeScratch[srcIndex]) / 32768.0f) * kAdPlugScopeGain, -1.0f, 1.0f);
-            }
-        }
-        scopeRingWritePos = (scopeRingWritePos + numFrames) % ChannelScopeSharedState::kMaxSamples;
-        scopeRingSamples = std::min(scopeRingSamples + numFrames, ChannelScopeSharedState::kMaxSamples);
-    }
-
-    if (scopeRingChannels <= 0 || scopeRingRaw.empty() || scopeRingSamples <= 0) {
-        channelScopeState->clear();
-        return;
+    const size_t blockSize = static_cast<size_t>(activeChannels) * static_cast<size_t>(std::max(0, numFrames));
+    if (scopeBlockScratch.size() < blockSize) {
+        scopeBlockScratch.resize(blockSize);
     }
-
-    std::vector<float> raw(
-            static_cast<size_t>(scopeRingChannels) * ChannelScopeSharedState::kMaxSamples,
-            0.0f
-    );
-    std::vector<float> vu(static_cast<size_t>(scopeRingChannels), 0.0f);
-    const int filledSamples = std::clamp(scopeRingSamples, 0, ChannelScopeSharedState::kMaxSamples);
-    const int zeroPrefix = ChannelScopeSharedState::kMaxSamples - filledSamples;
-    const int trailingSamples = std::clamp(sampleRateHz > 0 ? sampleRateHz / 50 : 64, 64, 1024);
-
-    for (int channel = 0; channel < scopeRingChannels; ++channel) {
-        float* dst = raw.data() + static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples;
-        for (int i = 0; i < filledSamples; ++i) {
-            const int ringIndex =
-                    (scopeRingWritePos - filledSamples + i + ChannelScopeSharedState::kMaxSamples) %
-                    ChannelScopeSharedState::kMaxSamples;
-            dst[zeroPrefix + i] = scopeRingRaw[
-                    static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples +
-                    static_cast<size_t>(ringIndex)
-            ];
-        }
-
-        float peak = 0.0f;
-        const int start = std::max(0, ChannelScopeSharedState::kMaxSamples - trailingSamples);
-        for (int i = start; i < ChannelScopeSharedState::kMaxSamples; ++i) {
-            peak = std::max(peak, std::abs(dst[i]));
+    for (int ch = 0; ch < activeChannels; ++ch) {
+        float* dst = scopeBlockScratch.data() + static_cast<size_t>(ch) * static_cast<size_t>(numFrames);
+        for (int frame = 0; frame < numFrames; ++frame) {
+            // Nuked OPL interleaves 18 values per frame; Mame, DosBox and
+            // KenSilverman write channels in sequence.
+            const int srcIndex = isInterleaved ? frame * 18 + ch : ch * numFrames + frame;
+            dst[frame] = std::clamp(
+                    (static_cast<float>(scopeScratch[srcIndex]) / 32768.0f) * kAdPlugScopeGain,
+                    -1.0f,
+                    1.0f
+            );
         }
-        vu[static_cast<size_t>(channel)] = std::clamp(peak, 0.0f, 1.0f);
     }
+    scopeRing.appendBlock(scopeBlockScratch.data(), static_cast<size_t>(numFrames), numFrames);
 
     static uint64_t channelScopeSourceSerial = 0;
-    std::lock_guard<std::mutex> channelScopeLock(channelScopeState->mutex);
-    channelScopeState->snapshotRaw = std::move(raw);
-    channelScopeState->snapshotVu = std::move(vu);
-    channelScopeState->snapshotChannels = scopeRingChannels;
-    channelScopeState->snapshotSerial = ++channelScopeSourceSerial;
+    const int trailingSamples = std::clamp(sampleRateHz > 0 ? sampleRateHz / 50 : 64, 64, 1024);
+    scopeRing.publish(*channelScopeState, ++channelScopeSourceSerial, trailingSamples);
 }
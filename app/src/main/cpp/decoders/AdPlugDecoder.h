@@ -2,6 +2,7 @@
 #define SILICONPLAYER_ADPLUGDECODER_H
 
 #include "AudioDecoder.h"
+#include "../DurationAnalysisClient.h"
 
 #include <atomic>
 #include <memory>
@@ -77,10 +78,8 @@ private:
     std::vector<short> scopeScratch;
     std::shared_ptr<ChannelScopeSharedState> channelScopeState;
 
-    std::vector<float> scopeRingRaw;
-    int scopeRingChannels = 0;
-    int scopeRingWritePos = 0;
-    int scopeRingSamples = 0;
+    ChannelScopeRing scopeRing;
+    std::vector<float> scopeBlockScratch;
 
     int sampleRateHz = 44100;
     int adlibCore = 2;
@@ -102,8 +101,14 @@ private:
     std::string genre;
     std::vector<std::string> toggleChannelNames;
     std::vector<bool> toggleChannelMuted;
+    // Per-subtune lengths from the duration cache; -1 while unknown.
+    std::vector<int64_t> subtuneDurationMs;
+    std::vector<uint8_t> subtuneDurationRequested;
+    uint64_t contentHash = 0;
 
     void closeInternalLocked();
+    int64_t refreshSubtuneDurationLocked(int index);
+    void updateCurrentDurationLocked();
     void syncToggleChannelsLocked();
     void applyToggleMutesLocked();
     void captureScopeSnapshotLocked(int numFrames);
@@ -1,6 +1,7 @@
 #ifndef SILICONPLAYER_AUDIODECODER_H
 #define SILICONPLAYER_AUDIODECODER_H
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -21,6 +22,9 @@ public:
     static constexpr int PLAYBACK_CAP_FIXED_SAMPLE_RATE = 1 << 5;
     static constexpr int PLAYBACK_CAP_DIRECT_SEEK = 1 << 6;
     static constexpr int PLAYBACK_CAP_ASYNC_DIRECT_SEEK = 1 << 7;
+    static constexpr int PLAYBACK_CAP_STATE_SNAPSHOT = 1 << 8;
+    // Backed by process-global emulator state: only one open instance at a time.
+    static constexpr int PLAYBACK_CAP_SINGLE_INSTANCE = 1 << 9;
     static constexpr int OPTION_APPLY_LIVE = 0;
     static constexpr int OPTION_APPLY_REQUIRES_PLAYBACK_RESTART = 1;
     enum class TimelineMode {
@@ -71,6 +75,13 @@ public:
     virtual int getFixedSampleRateHz() const { return 0; }
     virtual double getPlaybackPositionSeconds() { return -1.0; }
     virtual TimelineMode getTimelineMode() const { return TimelineMode::Unknown; }
+    // Opaque emulator state snapshots (PLAYBACK_CAP_STATE_SNAPSHOT).
+    // A snapshot is only valid for the same opened file, subtune and output rate.
+    // cRSID implements these; LazyUsf2 and Vio2sf still seek by rendering
+    // forward, as their libraries keep emulator state in private heap blocks.
+    virtual size_t getStateSnapshotSize() const { return 0; }
+    virtual bool saveStateSnapshot(uint8_t* /*destination*/, size_t /*capacity*/) { return false; }
+    virtual bool restoreStateSnapshot(const uint8_t* /*source*/, size_t /*size*/) { return false; }
 
     // Configuration
     virtual void setOption(const char* /*name*/, const char* /*value*/) {}
@@ -97,9 +108,17 @@ public:
     void attachDynamicLibraryLease(std::shared_ptr<void> lease) {
         dynamicLibraryLease = std::move(lease);
     }
+    const std::shared_ptr<void>& getDynamicLibraryLease() const { return dynamicLibraryLease; }
+
+    // Set before open() by DecoderRegistry::probe(). The instance only answers
+    // metadata and duration queries and is closed right after, so decoders
+    // skip scope capture and other playback-only setup.
+    void setMetadataOnly(bool enabled) { metadataOnly = enabled; }
+    bool isMetadataOnly() const { return metadataOnly; }
 
 private:
     std::shared_ptr<void> dynamicLibraryLease;
+    bool metadataOnly = false;
 };
 
 #endif //SILICONPLAYER_AUDIODECODER_H
@@ -6,8 +6,6 @@
 #include <cstdint>
 #include <cmath>
 #include <cstring>
-#include <fstream>
-#include <iterator>
 #include <sstream>
 
 #if defined(__clang__)
@@ -27,6 +25,10 @@ constexpr int kCrsidMaxSampleRateHz = 65535;
 constexpr int kCrsidOutputChannels = 2;
 constexpr int kCrsidBufferFrames = 2048;
 constexpr int kCrsidSeekDiscardChunkFrames = 4096;
+// Frames per cRSID_generateSamplesC64() call; also the stride of the per-voice
+// scope planes, so the scratch buffers stay a fixed size.
+constexpr int kCrsidRenderBlockFrames = 512;
+constexpr float kCrsidPcmScale = 1.0f / 32768.0f;
 constexpr int kCrsidChannelScopeTextStride = 10;
 constexpr int kCrsidChannelScopeTextFlagActive = 1 << 0;
 constexpr int kCrsidVoicesPerSid = 3;
@@ -35,6 +37,14 @@ constexpr int kCrsidMaxSidCount = 4;
 constexpr int kCrsidMaxScopeVoices = kCrsidChannelsPerSid * kCrsidMaxSidCount;
 constexpr unsigned char kCrsidFileVersionWebSid = 0x4E;
 
+struct CrsidSnapshotHeader {
+    int32_t subtuneIndex;
+    int32_t sampleRate;
+    double playbackPositionSeconds;
+    int32_t endReached;
+    int32_t reserved;
+};
+
 int clampSampleRate(int sampleRateHz) {
     return std::clamp(sampleRateHz, kCrsidMinSampleRateHz, kCrsidMaxSampleRateHz);
 }
@@ -111,8 +121,8 @@ std::string sidClockFromHeader(const cRSID_SIDheader* header) {
     }
 }
 
-std::string sidClockFromRuntime() {
-    return cRSID.VideoStandard ? "PAL" : "NTSC";
+std::string sidClockFromRuntime(const cRSID_Interface& crsid) {
+    return crsid.VideoStandard ? "PAL" : "NTSC";
 }
 
 std::string sidClockOverrideLabel(int mode) {
@@ -131,8 +141,8 @@ std::string sidCompatibilityFromHeader(const cRSID_SIDheader* header) {
     return "PSID";
 }
 
-std::string sidSpeedFromRuntime() {
-    return cRSID.TimerSource ? "CIA" : "Vertical blank";
+std::string sidSpeedFromRuntime(const cRSID_Interface& crsid) {
+    return crsid.TimerSource ? "CIA" : "Vertical blank";
 }
 
 std::string sidModelBitsToString(unsigned char bits) {
@@ -176,8 +186,8 @@ std::string declaredModelForIndex(const cRSID_SIDheader* header, int sidIndex) {
     return "Unknown";
 }
 
-std::string currentModelForChip(int sidNumber) {
-    switch (cRSID_getSIDmodel(sidNumber)) {
+std::string currentModelForChip(cRSID_C64instance* emulator, int sidNumber) {
+    switch (cRSID_getSIDmodelC64(emulator, sidNumber)) {
         case 6581: return "6581";
         case 8580: return "8580";
         default: return "Unknown";
@@ -201,10 +211,14 @@ float normalizeVoiceLevel(signed int level) {
 }
 }
 
-CRSIDDecoder::CRSIDDecoder() : channelScopeState(std::make_shared<ChannelScopeSharedState>()) {}
+CRSIDDecoder::CRSIDDecoder()
+    : emulator(cRSID_newC64()),
+      crsid(emulator ? cRSID_getInterfaceC64(emulator) : nullptr),
+      channelScopeState(std::make_shared<ChannelScopeSharedState>()) {}
 
 CRSIDDecoder::~CRSIDDecoder() {
     close();
+    cRSID_deleteC64(emulator);
 }
 
 bool CRSIDDecoder::open(const char* path) {
@@ -222,141 +236,77 @@ bool CRSIDDecoder::open(const char* path) {
 void CRSIDDecoder::close() {
     std::lock_guard<std::mutex> lock(decodeMutex);
     closeLocked();
-    fileData.clear();
+    fileSource.reset();
     sourcePath.clear();
 }
 
 void CRSIDDecoder::resetChannelScopeLocked() {
-    scopeRingRaw.clear();
-    scopeFrameScratch.clear();
-    scopeRingChannels = 0;
-    scopeRingWritePos = 0;
-    scopeRingSamples = 0;
+    scopeRing.reset();
     if (channelScopeState) {
         channelScopeState->clear();
     }
 }
 
 void CRSIDDecoder::ensureScopeRingShapeLocked(int channelsToKeep) {
-    const int clampedChannels = std::clamp(channelsToKeep, 0, kCrsidMaxScopeVoices);
-    if (clampedChannels <= 0) {
-        scopeRingRaw.clear();
-        scopeRingChannels = 0;
-        scopeRingWritePos = 0;
-        scopeRingSamples = 0;
-        return;
-    }
-    const size_t requiredSize =
-            static_cast<size_t>(clampedChannels) * ChannelScopeSharedState::kMaxSamples;
-    if (scopeRingChannels == clampedChannels && scopeRingRaw.size() == requiredSize) {
-        return;
-    }
-    scopeRingRaw.assign(requiredSize, 0.0f);
-    scopeRingChannels = clampedChannels;
-    scopeRingWritePos = 0;
-    scopeRingSamples = 0;
+    scopeRing.ensureChannels(std::clamp(channelsToKeep, 0, kCrsidMaxScopeVoices));
 }
 
-void CRSIDDecoder::appendScopeFrameLocked(const float* perVoiceSamples, int channelsToWrite) {
-    if (!perVoiceSamples || channelsToWrite <= 0) {
-        return;
+void CRSIDDecoder::renderBlockLocked(float* output, int frames) {
+    if (blockPcmScratch.empty()) {
+        blockPcmScratch.resize(static_cast<size_t>(kCrsidRenderBlockFrames * kCrsidOutputChannels), 0);
     }
-    ensureScopeRingShapeLocked(channelsToWrite);
-    if (scopeRingChannels <= 0 || scopeRingRaw.empty()) {
-        return;
+    const bool captureScope = scopeCaptureEnabled && !toggleChannelNames.empty();
+    if (captureScope && blockVoiceScratch.empty()) {
+        blockVoiceScratch.resize(static_cast<size_t>(kCrsidMaxScopeVoices * kCrsidRenderBlockFrames), 0);
+        scopeBlockScratch.resize(static_cast<size_t>(kCrsidMaxScopeVoices * kCrsidRenderBlockFrames), 0.0f);
     }
-    const int storedChannels = std::min(scopeRingChannels, channelsToWrite);
-    for (int channel = 0; channel < storedChannels; ++channel) {
-        scopeRingRaw[
-                static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples +
-                static_cast<size_t>(scopeRingWritePos)
-        ] = std::clamp(perVoiceSamples[channel], -1.0f, 1.0f);
+
+    cRSID_generateSamplesC64(
+            emulator,
+            blockPcmScratch.data(),
+            frames,
+            captureScope ? blockVoiceScratch.data() : nullptr,
+            kCrsidRenderBlockFrames
+    );
+
+    // Plain strided loop over a flat buffer; the compiler vectorizes it.
+    const signed short* pcm = blockPcmScratch.data();
+    const int samples = frames * kCrsidOutputChannels;
+    for (int i = 0; i < samples; ++i) {
+        output[i] = static_cast<float>(pcm[i]) * kCrsidPcmScale;
     }
-    for (int channel = storedChannels; channel < scopeRingChannels; ++channel) {
-        scopeRingRaw[
-                static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples +
-                static_cast<size_t>(scopeRingWritePos)
-        ] = 0.0f;
+
+    if (captureScope) {
+        captureChannelScopeBlockLocked(frames);
     }
-    scopeRingWritePos = (scopeRingWritePos + 1) % ChannelScopeSharedState::kMaxSamples;
-    scopeRingSamples = std::min(scopeRingSamples + 1, ChannelScopeSharedState::kMaxSamples);
 }
-
 void CRSIDDecoder::publishScopeSnapshotLocked() {
     if (!channelScopeState) {
         return;
     }
-    if (scopeRingChannels <= 0 || scopeRingRaw.empty() || scopeRingSamples <= 0) {
-        channelScopeState->clear();
-        return;
-    }
-
-    std::vector<float> raw(
-            static_cast<size_t>(scopeRingChannels) * ChannelScopeSharedState::kMaxSamples,
-            0.0f
-    );
-    std::vector<float> vu(static_cast<size_t>(scopeRingChannels), 0.0f);
-    const int filledSamples = std::clamp(scopeRingSamples, 0, ChannelScopeSharedState::kMaxSamples);
-    const int zeroPrefix = ChannelScopeSharedState::kMaxSamples - filledSamples;
     const int trailingSamples = std::clamp(activeSampleRate > 0 ? activeSampleRate / 50 : 64, 64, 1024);
-
-    for (int channel = 0; channel < scopeRingChannels; ++channel) {
-        float* dst = raw.data() + static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples;
-        for (int i = 0; i < filledSamples; ++i) {
-            const int ringIndex =
-                    (scopeRingWritePos - filledSamples + i + ChannelScopeSharedState::kMaxSamples) %
-                    ChannelScopeSharedState::kMaxSamples;
-            dst[zeroPrefix + i] = scopeRingRaw[
-                    static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples +
-                    static_cast<size_t>(ringIndex)
-            ];
-        }
-
-        float peak = 0.0f;
-        const int start = std::max(0, ChannelScopeSharedState::kMaxSamples - trailingSamples);
-        for (int i = start; i < ChannelScopeSharedState::kMaxSamples; ++i) {
-            peak = std::max(peak, std::abs(dst[i]));
-        }
-        vu[static_cast<size_t>(channel)] = std::clamp(peak, 0.0f, 1.0f);
-    }
-
-    std::lock_guard<std::mutex> channelScopeLock(channelScopeState->mutex);
-    channelScopeState->snapshotRaw = std::move(raw);
-    channelScopeState->snapshotVu = std::move(vu);
-    channelScopeState->snapshotChannels = scopeRingChannels;
-    channelScopeState->snapshotSerial = ++channelScopeSourceSerial;
+    scopeRing.publish(*channelScopeState, ++channelScopeSourceSerial, trailingSamples);
 }
 
-void CRSIDDecoder::captureChannelScopeFrameLocked() {
-    if (!scopeCaptureEnabled || toggleChannelNames.empty()) {
-        return;
-    }
-
+void CRSIDDecoder::captureChannelScopeBlockLocked(int frames) {
     const int totalChannels = std::min(static_cast<int>(toggleChannelNames.size()), kCrsidMaxScopeVoices);
-    if (totalChannels <= 0) {
+    if (totalChannels <= 0 || frames <= 0) {
         return;
     }
 
-    if (static_cast<int>(scopeFrameScratch.size()) < totalChannels) {
-        scopeFrameScratch.resize(static_cast<size_t>(totalChannels), 0.0f);
-    }
-
-    std::array<signed int, kCrsidVoicesPerSid> voiceLevels {};
-    int lastSidNumber = -1;
     for (int channel = 0; channel < totalChannels; ++channel) {
         const int sidNumber = toggleChannelSidNumbers[static_cast<size_t>(channel)];
         const int voiceNumber = toggleChannelVoiceNumbers[static_cast<size_t>(channel)];
-        if (sidNumber != lastSidNumber) {
-            cRSID_getVoiceLevels(sidNumber, voiceLevels.data());
-            lastSidNumber = sidNumber;
+        const int plane = ((sidNumber - 1) * kCrsidChannelsPerSid) + voiceNumber;
+        const signed int* levels = blockVoiceScratch.data() + (static_cast<size_t>(plane) * kCrsidRenderBlockFrames);
+        float* scopeSamples = scopeBlockScratch.data() + (static_cast<size_t>(channel) * kCrsidRenderBlockFrames);
+        for (int frame = 0; frame < frames; ++frame) {
+            scopeSamples[frame] = normalizeVoiceLevel(levels[frame]);
         }
-        scopeFrameScratch[static_cast<size_t>(channel)] = (voiceNumber < kCrsidVoicesPerSid)
-                ? normalizeVoiceLevel(voiceLevels[static_cast<size_t>(voiceNumber)])
-                : normalizeVoiceLevel(cRSID_getDigiLevel(sidNumber));
     }
-    appendScopeFrameLocked(scopeFrameScratch.data(), totalChannels);
+    ensureScopeRingShapeLocked(totalChannels);
+    scopeRing.appendBlock(scopeBlockScratch.data(), kCrsidRenderBlockFrames, frames);
 }
-
 void CRSIDDecoder::rebuildToggleChannelsLocked() {
     const std::vector<bool> previousMuted = toggleChannelMuted;
     const std::vector<int> previousSidNumbers = toggleChannelSidNumbers;
@@ -369,13 +319,13 @@ void CRSIDDecoder::rebuildToggleChannelsLocked() {
 
     int activeSidCount = 0;
     for (int sidNumber = 1; sidNumber <= kCrsidMaxSidCount; ++sidNumber) {
-        if (cRSID_getSIDbase(sidNumber) != 0) {
+        if (cRSID_getSIDbaseC64(emulator, sidNumber) != 0) {
             ++activeSidCount;
         }
     }
 
     for (int sidNumber = 1; sidNumber <= kCrsidMaxSidCount; ++sidNumber) {
-        if (cRSID_getSIDbase(sidNumber) == 0) {
+        if (cRSID_getSIDbaseC64(emulator, sidNumber) == 0) {
             continue;
         }
         for (int voiceNumber = 0; voiceNumber < kCrsidChannelsPerSid; ++voiceNumber) {
@@ -424,13 +374,13 @@ void CRSIDDecoder::applyToggleChannelMutesLocked() {
         }
     }
     for (int sidNumber = 1; sidNumber <= kCrsidMaxSidCount; ++sidNumber) {
-        cRSID_setVoiceMuteMask(sidNumber, muteMasks[static_cast<size_t>(sidNumber)]);
+        cRSID_setVoiceMuteMaskC64(emulator, sidNumber, muteMasks[static_cast<size_t>(sidNumber)]);
     }
 }
 
 int CRSIDDecoder::read(float* buffer, int numFrames) {
     std::lock_guard<std::mutex> lock(decodeMutex);
-    if (!buffer || numFrames <= 0 || fileData.empty()) {
+    if (!buffer || numFrames <= 0 || !fileSource) {
         return 0;
     }
 
@@ -453,12 +403,22 @@ int CRSIDDecoder::read(float* buffer, int numFrames) {
             break;
         }
 
-        const cRSID_Output output = cRSID_generateSample();
-        buffer[framesWritten * 2] = static_cast<float>(output.L) / 32768.0f;
-        buffer[(framesWritten * 2) + 1] = static_cast<float>(output.R) / 32768.0f;
-        captureChannelScopeFrameLocked();
-        ++framesWritten;
-        playbackPositionSeconds += 1.0 / static_cast<double>(activeSampleRate);
+        int framesThisPass = std::min(numFrames - framesWritten, kCrsidRenderBlockFrames);
+        if (!loopPointRepeatActive && durationReliable && currentDurationSeconds > 0.0) {
+            // Stop the block on the end frame so repeat/end handling sees it
+            // exactly where the per-frame loop used to.
+            const double framesToEnd = std::ceil(
+                    (currentDurationSeconds - playbackPositionSeconds) * static_cast<double>(activeSampleRate));
+            framesThisPass = std::clamp(
+                    static_cast<int>(std::min(framesToEnd, static_cast<double>(framesThisPass))),
+                    1,
+                    framesThisPass
+            );
+        }
+
+        renderBlockLocked(buffer + (static_cast<size_t>(framesWritten) * kCrsidOutputChannels), framesThisPass);
+        framesWritten += framesThisPass;
+        playbackPositionSeconds += static_cast<double>(framesThisPass) / static_cast<double>(activeSampleRate);
     }
 
     if (framesWritten > 0 && scopeCaptureEnabled) {
@@ -470,7 +430,7 @@ int CRSIDDecoder::read(float* buffer, int numFrames) {
 
 void CRSIDDecoder::seek(double seconds) {
     std::lock_guard<std::mutex> lock(decodeMutex);
-    if (fileData.empty()) {
+    if (!fileSource) {
         return;
     }
 
@@ -484,14 +444,13 @@ void CRSIDDecoder::seek(double seconds) {
     }
 
     const uint64_t targetFrames = static_cast<uint64_t>(targetSeconds * static_cast<double>(activeSampleRate));
-    std::array<cRSID_Output, kCrsidSeekDiscardChunkFrames> discardBuffer {};
+    std::array<signed short, kCrsidSeekDiscardChunkFrames * kCrsidOutputChannels> discardBuffer {};
     uint64_t discardedFrames = 0;
     while (discardedFrames < targetFrames) {
         const uint64_t remaining = targetFrames - discardedFrames;
-        const int framesThisPass = static_cast<int>(std::min<uint64_t>(remaining, discardBuffer.size()));
-        for (int i = 0; i < framesThisPass; ++i) {
-            discardBuffer[static_cast<size_t>(i)] = cRSID_generateSample();
-        }
+        const int framesThisPass = static_cast<int>(
+                std::min<uint64_t>(remaining, static_cast<uint64_t>(kCrsidSeekDiscardChunkFrames)));
+        cRSID_generateSamplesC64(emulator, discardBuffer.data(), framesThisPass, nullptr, 0);
         discardedFrames += static_cast<uint64_t>(framesThisPass);
     }
 
@@ -600,7 +559,7 @@ void CRSIDDecoder::setOutputSampleRate(int sampleRateHz) {
     // cRSID sample-rate changes are restart-required.
     // Keep the requested value and apply it on the next open()/reinitialize path
     // instead of restarting playback on every resume.
-    if (fileData.empty()) {
+    if (!fileSource) {
         activeSampleRate = normalizedRate;
     }
 }
@@ -616,7 +575,46 @@ int CRSIDDecoder::getRepeatModeCapabilities() const {
 int CRSIDDecoder::getPlaybackCapabilities() const {
     return PLAYBACK_CAP_SEEK |
            PLAYBACK_CAP_CUSTOM_SAMPLE_RATE |
-           PLAYBACK_CAP_LIVE_REPEAT_MODE;
+           PLAYBACK_CAP_LIVE_REPEAT_MODE |
+           PLAYBACK_CAP_STATE_SNAPSHOT;
+}
+
+size_t CRSIDDecoder::getStateSnapshotSize() const {
+    return sizeof(CrsidSnapshotHeader) + cRSID_getStateSize();
+}
+
+bool CRSIDDecoder::saveStateSnapshot(uint8_t* destination, size_t capacity) {
+    std::lock_guard<std::mutex> lock(decodeMutex);
+    if (!destination || !fileSource || capacity < getStateSnapshotSize()) {
+        return false;
+    }
+    CrsidSnapshotHeader header {};
+    header.subtuneIndex = currentSubtuneIndex;
+    header.sampleRate = activeSampleRate;
+    header.playbackPositionSeconds = playbackPositionSeconds;
+    header.endReached = endReached ? 1 : 0;
+    std::memcpy(destination, &header, sizeof(header));
+    return cRSID_saveStateC64(emulator, destination + sizeof(header), capacity - sizeof(header)) > 0;
+}
+
+bool CRSIDDecoder::restoreStateSnapshot(const uint8_t* source, size_t size) {
+    std::lock_guard<std::mutex> lock(decodeMutex);
+    if (!source || !fileSource || size != getStateSnapshotSize()) {
+        return false;
+    }
+    CrsidSnapshotHeader header {};
+    std::memcpy(&header, source, sizeof(header));
+    if (header.subtuneIndex != currentSubtuneIndex || header.sampleRate != activeSampleRate) {
+        return false;
+    }
+    if (!cRSID_loadStateC64(emulator, source + sizeof(header), size - sizeof(header))) {
+        return false;
+    }
+    playbackPositionSeconds = header.playbackPositionSeconds;
+    endReached = header.endReached != 0;
+    applyToggleChannelMutesLocked();
+    resetChannelScopeLocked();
+    return true;
 }
 
 double CRSIDDecoder::getPlaybackPositionSeconds() {
@@ -660,28 +658,15 @@ void CRSIDDecoder::clearToggleChannelMutes() {
 
 std::vector<int32_t> CRSIDDecoder::getChannelScopeTextState(int maxChannels) {
     std::lock_guard<std::mutex> lock(decodeMutex);
-    if (scopeRingChannels <= 0 || scopeRingSamples <= 0 || scopeRingRaw.empty()) {
+    if (scopeRing.empty()) {
         return {};
     }
 
-    const int channelsToExport = std::min(scopeRingChannels, std::clamp(maxChannels, 1, kCrsidMaxScopeVoices));
+    const int channelsToExport = std::min(scopeRing.channels(), std::clamp(maxChannels, 1, kCrsidMaxScopeVoices));
     std::vector<int32_t> flat(static_cast<size_t>(channelsToExport * kCrsidChannelScopeTextStride), -1);
     const int trailingSamples = std::clamp(activeSampleRate > 0 ? activeSampleRate / 50 : 64, 64, 1024);
-    const int recentSamples = std::min(scopeRingSamples, trailingSamples);
     for (int channel = 0; channel < channelsToExport; ++channel) {
-        float recentPeak = 0.0f;
-        for (int i = 0; i < recentSamples; ++i) {
-            const int ringIndex =
-                    (scopeRingWritePos - recentSamples + i + ChannelScopeSharedState::kMaxSamples) %
-                    ChannelScopeSharedState::kMaxSamples;
-            recentPeak = std::max(
-                    recentPeak,
-                    std::abs(scopeRingRaw[
-                            static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples +
-                            static_cast<size_t>(ringIndex)
-                    ])
-            );
-        }
+        const float recentPeak = scopeRing.recentPeak(channel, trailingSamples);
 
         const size_t base = static_cast<size_t>(channel * kCrsidChannelScopeTextStride);
         int flags = 0;
@@ -777,37 +762,39 @@ std::vector<std::string> CRSIDDecoder::getSupportedExtensions() {
 }
 
 bool CRSIDDecoder::loadFileLocked(const char* path) {
-    std::ifstream input(path, std::ios::binary);
-    if (!input) {
-        return false;
-    }
+    fileSource = FileSource::open(path);
+    return fileSource != nullptr;
+}
 
-    fileData.assign(
-            std::istreambuf_iterator<char>(input),
-            std::istreambuf_iterator<char>()
+cRSID_SIDheader* CRSIDDecoder::processSidFileLocked() {
+    // cRSID only reads the file but keeps a header pointer into it, so
+    // fileSource is released only after closeLocked().
+    return cRSID_processSIDfileDataC64(
+            emulator,
+            const_cast<unsigned char*>(fileSource->data()),
+            static_cast<int>(fileSource->size())
     );
-    return !fileData.empty();
 }
 
 bool CRSIDDecoder::initializeEngineLocked(int subtuneIndex) {
     closeLocked();
-    if (fileData.empty()) {
+    if (!fileSource) {
         return false;
     }
 
     activeSampleRate = clampSampleRate(requestedSampleRate);
-    if (cRSID_init(static_cast<unsigned short>(activeSampleRate), kCrsidBufferFrames) == nullptr) {
+    if (!emulator || cRSID_initC64(emulator, static_cast<unsigned short>(activeSampleRate), kCrsidBufferFrames) == nullptr) {
         return false;
     }
 
-    cRSID.AutoAdvance = 0;
-    cRSID.AutoExit = 0;
-    cRSID.FadeOut = 0;
-    cRSID.PlaybackSpeed = 1;
-    cRSID.FallbackPlayTime = 0;
+    crsid->AutoAdvance = 0;
+    crsid->AutoExit = 0;
+    crsid->FadeOut = 0;
+    crsid->PlaybackSpeed = 1;
+    crsid->FallbackPlayTime = 0;
     applyPlaybackOptionsLocked();
 
-    auto* header = cRSID_processSIDfileData(fileData.data(), static_cast<int>(fileData.size()));
+    auto* header = processSidFileLocked();
     if (!header) {
         closeLocked();
         return false;
@@ -818,7 +805,7 @@ bool CRSIDDecoder::initializeEngineLocked(int subtuneIndex) {
     declaredSubtuneDurationsSeconds.assign(static_cast<size_t>(subtuneCount), 0.0);
     subtuneDurationsSeconds.assign(static_cast<size_t>(subtuneCount), 0.0);
     for (int i = 0; i < subtuneCount; ++i) {
-        const unsigned short seconds = cRSID.SubtuneDurations[i + 1];
+        const unsigned short seconds = crsid->SubtuneDurations[i + 1];
         const double declaredDuration = seconds > 0 ? static_cast<double>(seconds) : 0.0;
         declaredSubtuneDurationsSeconds[static_cast<size_t>(i)] = declaredDuration;
         subtuneDurationsSeconds[static_cast<size_t>(i)] = declaredDuration > 0.0
@@ -836,17 +823,17 @@ bool CRSIDDecoder::initializeEngineLocked(int subtuneIndex) {
 }
 
 bool CRSIDDecoder::startSubtuneLocked(int subtuneIndex) {
-    if (fileData.empty() || subtuneIndex < 0 || subtuneIndex >= subtuneCount) {
+    if (!fileSource || subtuneIndex < 0 || subtuneIndex >= subtuneCount) {
         return false;
     }
 
-    auto* header = cRSID_processSIDfileData(fileData.data(), static_cast<int>(fileData.size()));
+    auto* header = processSidFileLocked();
     if (!header) {
         return false;
     }
 
-    cRSID_initSIDtune(header, static_cast<char>(subtuneIndex + 1));
-    cRSID_playSIDtune();
+    cRSID_initSIDtuneC64(emulator, header, static_cast<char>(subtuneIndex + 1));
+    cRSID_playSIDtuneC64(emulator);
 
     currentSubtuneIndex = subtuneIndex;
     playbackPositionSeconds = 0.0;
@@ -861,7 +848,9 @@ bool CRSIDDecoder::startSubtuneLocked(int subtuneIndex) {
 }
 
 void CRSIDDecoder::closeLocked() {
-    cRSID_close();
+    if (emulator) {
+        cRSID_closeC64(emulator);
+    }
     title.clear();
     artist.clear();
     composer.clear();
@@ -892,9 +881,9 @@ void CRSIDDecoder::closeLocked() {
 }
 
 void CRSIDDecoder::applyPlaybackOptionsLocked() {
-    cRSID.MainVolume = 255;
-    cRSID.Stereo = CRSID_CHANNELMODE_STEREO;
-    cRSID.FallbackPlayTime = static_cast<int>(std::clamp(
+    crsid->MainVolume = 255;
+    crsid->Stereo = CRSID_CHANNELMODE_STEREO;
+    crsid->FallbackPlayTime = static_cast<int>(std::clamp(
             fallbackDurationSeconds,
             0.0,
             86400.0
@@ -902,47 +891,47 @@ void CRSIDDecoder::applyPlaybackOptionsLocked() {
 
     switch (qualityMode) {
         case QualityMode::Light:
-            cRSID.HighQualitySID = 0;
-            cRSID.HighQualityResampler = 0;
+            crsid->HighQualitySID = 0;
+            crsid->HighQualityResampler = 0;
             break;
         case QualityMode::Sinc:
-            cRSID.HighQualitySID = 1;
-            cRSID.HighQualityResampler = 1;
+            crsid->HighQualitySID = 1;
+            crsid->HighQualityResampler = 1;
             break;
         case QualityMode::High:
         default:
-            cRSID.HighQualitySID = 1;
-            cRSID.HighQualityResampler = 0;
+            crsid->HighQualitySID = 1;
+            crsid->HighQualityResampler = 0;
             break;
     }
 
     switch (sidModelMode) {
         case SidModelMode::Mos6581:
-            cRSID.SelectedSIDmodel = 6581;
+            crsid->SelectedSIDmodel = 6581;
             break;
         case SidModelMode::Mos8580:
-            cRSID.SelectedSIDmodel = 8580;
+            crsid->SelectedSIDmodel = 8580;
             break;
         case SidModelMode::Auto:
         default:
-            cRSID.SelectedSIDmodel = 0;
+            crsid->SelectedSIDmodel = 0;
             break;
     }
 
     switch (clockMode) {
         case ClockMode::Pal:
-            cRSID.ForcedVideoStandard = CRSID_VIDEOSTANDARD_PAL;
+            crsid->ForcedVideoStandard = CRSID_VIDEOSTANDARD_PAL;
             break;
         case ClockMode::Ntsc:
-            cRSID.ForcedVideoStandard = CRSID_VIDEOSTANDARD_NTSC;
+            crsid->ForcedVideoStandard = CRSID_VIDEOSTANDARD_NTSC;
             break;
         case ClockMode::Auto:
         default:
-            cRSID.ForcedVideoStandard = CRSID_VIDEOSTANDARD_AUTO;
+            crsid->ForcedVideoStandard = CRSID_VIDEOSTANDARD_AUTO;
             break;
     }
 
-    cRSID_set6581FilterPreset(static_cast<unsigned char>(filter6581Preset));
+    cRSID_set6581FilterPresetC64(emulator, static_cast<unsigned char>(filter6581Preset));
 }
 
 void CRSIDDecoder::refreshHeaderMetadataLocked(const cRSID_SIDheader* header) {
@@ -966,9 +955,9 @@ void CRSIDDecoder::refreshHeaderMetadataLocked(const cRSID_SIDheader* header) {
 }
 
 void CRSIDDecoder::refreshRuntimeMetadataLocked(const cRSID_SIDheader* header) {
-    sidSpeedName = sidSpeedFromRuntime();
+    sidSpeedName = sidSpeedFromRuntime(*crsid);
     const std::string declaredClock = sidClockFromHeader(header);
-    const std::string effectiveClock = sidClockFromRuntime();
+    const std::string effectiveClock = sidClockFromRuntime(*crsid);
     const std::string forcedClock = sidClockOverrideLabel(static_cast<int>(clockMode));
 
     if (forcedClock.empty()) {
@@ -986,7 +975,7 @@ void CRSIDDecoder::refreshRuntimeMetadataLocked(const cRSID_SIDheader* header) {
     std::vector<std::string> currentModels;
     std::vector<std::string> baseAddresses;
     for (int sidNumber = 1; sidNumber <= 4; ++sidNumber) {
-        const unsigned short base = cRSID_getSIDbase(sidNumber);
+        const unsigned short base = cRSID_getSIDbaseC64(emulator, sidNumber);
         if (base == 0) {
             continue;
         }
@@ -998,7 +987,7 @@ void CRSIDDecoder::refreshRuntimeMetadataLocked(const cRSID_SIDheader* header) {
         baseAddresses.push_back(baseLabel.str());
 
         declaredModels.push_back("SID " + std::to_string(sidNumber) + ": " + declaredModelForIndex(header, sidNumber));
-        currentModels.push_back("SID " + std::to_string(sidNumber) + ": " + currentModelForChip(sidNumber));
+        currentModels.push_back("SID " + std::to_string(sidNumber) + ": " + currentModelForChip(emulator, sidNumber));
     }
 
     sidChipCount = std::max(sidChipCount, 1);
@@ -1097,7 +1086,9 @@ void CRSIDDecoder::setOption(const char* name, const char* value) {
 
     if (optionName == "crsid.stereo") {
         const bool enabled = parseBoolString(optionValue, true);
-        cRSID.Stereo = enabled ? CRSID_CHANNELMODE_STEREO : CRSID_CHANNELMODE_MONO;
+        if (crsid) {
+            crsid->Stereo = enabled ? CRSID_CHANNELMODE_STEREO : CRSID_CHANNELMODE_MONO;
+        }
         return;
     }
 
@@ -2,14 +2,18 @@
 #define SILICONPLAYER_CRSIDDECODER_H
 
 #include "../ChannelScopeSharedState.h"
+#include "../FileSource.h"
 #include "AudioDecoder.h"
 #include "SidMetadataProvider.h"
 #include <atomic>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
 
 struct cRSID_SIDheader;
+struct cRSID_Interface;
+struct cRSID_C64instance;
 
 class CRSIDDecoder : public AudioDecoder, public SidMetadataProvider {
 public:
@@ -42,6 +46,9 @@ public:
     int getPlaybackCapabilities() const override;
     double getPlaybackPositionSeconds() override;
     TimelineMode getTimelineMode() const override;
+    size_t getStateSnapshotSize() const override;
+    bool saveStateSnapshot(uint8_t* destination, size_t capacity) override;
+    bool restoreStateSnapshot(const uint8_t* source, size_t size) override;
     void setOption(const char* name, const char* value) override;
     int getOptionApplyPolicy(const char* name) const override;
     std::vector<std::string> getToggleChannelNames() override;
@@ -95,7 +102,12 @@ private:
 
     mutable std::mutex decodeMutex;
 
-    std::vector<unsigned char> fileData;
+    // Private emulator instance, so several decoders can render side by side;
+    // crsid is its option/runtime interface. Null only if allocation failed.
+    cRSID_C64instance* emulator = nullptr;
+    cRSID_Interface* crsid = nullptr;
+
+    std::shared_ptr<const FileSource> fileSource;
     std::string sourcePath;
     std::string title;
     std::string artist;
@@ -134,15 +146,15 @@ private:
     std::vector<int> toggleChannelSidNumbers;
     std::vector<int> toggleChannelVoiceNumbers;
     std::shared_ptr<ChannelScopeSharedState> channelScopeState;
-    std::vector<float> scopeRingRaw;
-    std::vector<float> scopeFrameScratch;
-    int scopeRingChannels = 0;
-    int scopeRingWritePos = 0;
-    int scopeRingSamples = 0;
+    ChannelScopeRing scopeRing;
+    std::vector<signed short> blockPcmScratch;
+    std::vector<signed int> blockVoiceScratch;
+    std::vector<float> scopeBlockScratch;
     uint64_t channelScopeSourceSerial = 0;
     bool scopeCaptureEnabled = false;
 
     bool loadFileLocked(const char* path);
+    cRSID_SIDheader* processSidFileLocked();
     bool initializeEngineLocked(int subtuneIndex);
     bool startSubtuneLocked(int subtuneIndex);
     void closeLocked();
@@ -151,9 +163,9 @@ private:
     void applyToggleChannelMutesLocked();
     void resetChannelScopeLocked();
     void ensureScopeRingShapeLocked(int channelsToKeep);
-    void appendScopeFrameLocked(const float* perVoiceSamples, int channelsToWrite);
     void publishScopeSnapshotLocked();
-    void captureChannelScopeFrameLocked();
+    void renderBlockLocked(float* output, int frames);
+    void captureChannelScopeBlockLocked(int frames);
     void refreshHeaderMetadataLocked(const cRSID_SIDheader* header);
     void refreshRuntimeMetadataLocked(const cRSID_SIDheader* header);
 };
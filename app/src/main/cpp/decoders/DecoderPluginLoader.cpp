@@ -4,8 +4,12 @@
 #include <algorithm>
 #include <chrono>
 #include <condition_variable>
+#include <cstdio>
+#include <deque>
 #include <dlfcn.h>
+#include <map>
 #include <mutex>
+#include <sstream>
 #include <thread>
 #include <unordered_map>
 #include <utility>
@@ -17,7 +21,25 @@
 namespace {
 using CreateDecoderFn = AudioDecoder* (*)();
 using Clock = std::chrono::steady_clock;
-constexpr auto kUnloadDelay = std::chrono::seconds(5);
+using Milliseconds = std::chrono::milliseconds;
+
+// Weight of the newest reuse gap in the running average.
+constexpr double kReuseGapWeight = 0.3;
+// Idle delay as a multiple of the usual gap between two uses.
+constexpr double kIdleGapFactor = 1.5;
+constexpr int kUsesBeforeAdaptiveIdle = 2;
+// A successor is pre-warmed once it followed the plugin this often and
+// makes up at least this share of what followed it.
+constexpr int kMinTransitionsForPrediction = 2;
+constexpr double kMinTransitionShare = 0.34;
+// ComponentCallbacks2 trim levels.
+constexpr int kTrimRunningCritical = 15;
+constexpr int kTrimUiHidden = 20;
+constexpr int kTrimModerate = 60;
+
+int64_t elapsedNs(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
 
 struct LoadedPlugin {
     std::string libraryName;
@@ -32,10 +54,34 @@ struct LoadedPlugin {
     }
 };
 
+struct PluginStats {
+    uint64_t loads = 0;
+    uint64_t prewarmLoads = 0;
+    uint64_t failedLoads = 0;
+    uint64_t unloads = 0;
+    // How acquires were served: already loaded, after waiting for a load in
+    // flight on the loader thread, or by loading on the caller's thread.
+    uint64_t warmAcquires = 0;
+    uint64_t waitedAcquires = 0;
+    uint64_t coldAcquires = 0;
+    int64_t loadNsTotal = 0;
+    int64_t loadNsMax = 0;
+    int64_t acquireNsMax = 0;
+};
+
 struct PluginSlot {
     std::shared_ptr<LoadedPlugin> plugin;
     int activeLeases = 0;
+    bool loading = false;
+    bool prewarmed = false;
+    bool predicted = false;
     Clock::time_point unloadAfter = Clock::time_point::max();
+    Clock::time_point lastUsed {};
+    Clock::time_point lastPlayedRelease {};
+    int playbackLeases = 0;
+    int uses = 0;
+    double reuseGapMs = 0.0;
+    PluginStats stats;
 };
 
 class DecoderPluginLoaderImpl {
@@ -44,16 +90,19 @@ public:
         DecoderPluginLoaderImpl* owner = nullptr;
         std::string libraryName;
         std::shared_ptr<LoadedPlugin> plugin;
+        // Set once the decoder holding the lease starts playing.
+        bool playback = false;
+        Clock::time_point playbackStartedAt {};
 
         ~PluginLease() {
             if (owner != nullptr) {
-                owner->release(libraryName);
+                owner->release(*this);
             }
         }
     };
 
     DecoderPluginLoaderImpl() {
-        worker = std::thread([this] { unloadWorkerLoop(); });
+        worker = std::thread([this] { loaderWorkerLoop(); });
     }
 
     ~DecoderPluginLoaderImpl() {
@@ -86,30 +135,169 @@ public:
         return std::unique_ptr<AudioDecoder>(rawDecoder);
     }
 
+    void notePlayback(const std::shared_ptr<void>& leaseHandle) {
+        if (!leaseHandle) {
+            return;
+        }
+        auto* lease = static_cast<PluginLease*>(leaseHandle.get());
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (lease->playback) {
+                return;
+            }
+            const auto now = Clock::now();
+            PluginSlot& slot = plugins[lease->libraryName];
+            noteUseLocked(lease->libraryName, slot, now);
+            slot.playbackLeases += 1;
+            lease->playback = true;
+            lease->playbackStartedAt = now;
+        }
+        cv.notify_one();
+    }
+
+    void prewarm(const std::vector<std::string>& libraryNames) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            const auto now = Clock::now();
+            if (now < pressureUntil) {
+                LOGD("Skipping plugin pre-warm under memory pressure");
+                return;
+            }
+            for (auto& [name, slot] : plugins) {
+                const bool wanted = std::find(libraryNames.begin(), libraryNames.end(), name) != libraryNames.end();
+                if (slot.prewarmed && !wanted) {
+                    slot.prewarmed = false;
+                    scheduleIdleUnloadLocked(slot, now);
+                }
+            }
+            for (const auto& name : libraryNames) {
+                if (name.empty()) continue;
+                PluginSlot& slot = plugins[name];
+                slot.prewarmed = true;
+                slot.unloadAfter = Clock::time_point::max();
+                if (!slot.plugin && !slot.loading) {
+                    prewarmQueue.push_back(name);
+                }
+            }
+        }
+        cv.notify_one();
+    }
+
+    void onTrimMemory(int level) {
+        const bool critical = level == kTrimRunningCritical || level >= kTrimModerate;
+        if (level == kTrimUiHidden) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            const auto now = Clock::now();
+            pressureUntil = now + policy.pressureHold;
+            prewarmQueue.clear();
+            for (auto& [name, slot] : plugins) {
+                if (critical) {
+                    slot.prewarmed = false;
+                    slot.predicted = false;
+                }
+                if (slot.activeLeases == 0 && !slot.prewarmed && !slot.predicted) {
+                    slot.unloadAfter = critical
+                            ? now
+                            : std::min(slot.unloadAfter, now + policy.minIdle);
+                }
+            }
+            LOGD("Decoder plugin trim: level=%d critical=%d", level, critical ? 1 : 0);
+        }
+        cv.notify_one();
+    }
+
+    void setPolicy(const DecoderPluginLoader::Policy& requested) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            policy = requested;
+            policy.maxIdle = std::max(policy.maxIdle, policy.minIdle);
+            policy.maxIdlePlugins = std::max(0, policy.maxIdlePlugins);
+            policy.maxPredicted = std::max(0, policy.maxPredicted);
+        }
+        cv.notify_one();
+    }
+
+    std::string statsSummary() {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::map<std::string, const PluginSlot*> sorted;
+        for (const auto& [name, slot] : plugins) {
+            sorted.emplace(name, &slot);
+        }
+        std::ostringstream out;
+        for (const auto& [name, slot] : sorted) {
+            const PluginStats& stats = slot->stats;
+            const double meanLoadMs = stats.loads > 0
+                    ? static_cast<double>(stats.loadNsTotal) / 1.0e6 / static_cast<double>(stats.loads)
+                    : 0.0;
+            char line[384];
+            std::snprintf(
+                    line,
+                    sizeof(line),
+                    "%s: %s, %llu loads (%llu pre-warmed, %llu failed), %llu unloads, "
+                    "acquires %llu warm / %llu waited / %llu cold, load %.1f ms mean %.1f ms max, "
+                    "acquire %.1f ms max, reuse gap %.1f s\n",
+                    name.c_str(),
+                    slot->plugin ? (slot->activeLeases > 0 ? "leased" : "idle") : "unloaded",
+                    static_cast<unsigned long long>(stats.loads),
+                    static_cast<unsigned long long>(stats.prewarmLoads),
+                    static_cast<unsigned long long>(stats.failedLoads),
+                    static_cast<unsigned long long>(stats.unloads),
+                    static_cast<unsigned long long>(stats.warmAcquires),
+                    static_cast<unsigned long long>(stats.waitedAcquires),
+                    static_cast<unsigned long long>(stats.coldAcquires),
+                    meanLoadMs,
+                    static_cast<double>(stats.loadNsMax) / 1.0e6,
+                    static_cast<double>(stats.acquireNsMax) / 1.0e6,
+                    slot->reuseGapMs / 1000.0
+            );
+            out << line;
+        }
+        return out.str();
+    }
+
 private:
     std::shared_ptr<void> acquire(const std::string& libraryName) {
-        std::lock_guard<std::mutex> lock(mutex);
-        auto& slot = plugins[libraryName];
-        if (!slot.plugin) {
-            slot.plugin = loadPlugin(libraryName);
-            if (!slot.plugin) {
-                plugins.erase(libraryName);
+        const auto start = Clock::now();
+        std::unique_lock<std::mutex> lock(mutex);
+        PluginSlot& slot = plugins[libraryName];
+
+        bool waited = false;
+        while (slot.loading) {
+            waited = true;
+            loadCv.wait(lock);
+        }
+        if (slot.plugin && waited) {
+            slot.stats.waitedAcquires += 1;
+        } else if (slot.plugin) {
+            slot.stats.warmAcquires += 1;
+        } else {
+            if (!loadLocked(libraryName, slot, lock, false)) {
                 return {};
             }
+            slot.stats.coldAcquires += 1;
         }
 
+        const auto acquiredAt = Clock::now();
         slot.activeLeases += 1;
         slot.unloadAfter = Clock::time_point::max();
+        slot.lastUsed = acquiredAt;
+        slot.stats.acquireNsMax = std::max(slot.stats.acquireNsMax, elapsedNs(start, acquiredAt));
         LOGD("Acquired decoder plugin lease: %s active=%d", libraryName.c_str(), slot.activeLeases);
 
         auto lease = std::make_shared<PluginLease>();
         lease->owner = this;
         lease->libraryName = libraryName;
         lease->plugin = slot.plugin;
+        lock.unlock();
+        cv.notify_one();
         return lease;
     }
 
-    void release(const std::string& libraryName) {
+    void release(const PluginLease& lease) {
+        const std::string& libraryName = lease.libraryName;
         {
             std::lock_guard<std::mutex> lock(mutex);
             auto it = plugins.find(libraryName);
@@ -120,11 +308,21 @@ private:
             if (slot.activeLeases > 0) {
                 slot.activeLeases -= 1;
             }
+            const auto now = Clock::now();
+            slot.lastUsed = now;
+            if (lease.playback) {
+                slot.playbackLeases -= 1;
+                if (now - lease.playbackStartedAt >= policy.minPlayedLease) {
+                    slot.lastPlayedRelease = now;
+                    if (!lastPlayed.empty() && lastPlayed != libraryName) {
+                        transitions[lastPlayed][libraryName] += 1;
+                    }
+                    lastPlayed = libraryName;
+                }
+            }
             if (slot.activeLeases == 0) {
-                slot.unloadAfter = Clock::now() + kUnloadDelay;
-                LOGD("Released final decoder plugin lease, unload scheduled: %s delay=%llds",
-                     libraryName.c_str(),
-                     static_cast<long long>(std::chrono::duration_cast<std::chrono::seconds>(kUnloadDelay).count()));
+                scheduleIdleUnloadLocked(slot, now);
+                LOGD("Released final decoder plugin lease: %s", libraryName.c_str());
             } else {
                 LOGD("Released decoder plugin lease: %s active=%d", libraryName.c_str(), slot.activeLeases);
             }
@@ -132,6 +330,112 @@ private:
         cv.notify_one();
     }
 
+    // Playback leases only: probes, scans and preloads would otherwise pull
+    // the prediction and the reuse gap away from what the user plays.
+    void noteUseLocked(const std::string& libraryName, PluginSlot& slot, Clock::time_point now) {
+        slot.uses += 1;
+        if (slot.lastPlayedRelease != Clock::time_point {} && slot.playbackLeases == 0) {
+            const double gapMs = std::chrono::duration<double, std::milli>(now - slot.lastPlayedRelease).count();
+            slot.reuseGapMs = slot.reuseGapMs > 0.0
+                    ? slot.reuseGapMs + kReuseGapWeight * (gapMs - slot.reuseGapMs)
+                    : gapMs;
+            slot.lastPlayedRelease = {};
+        }
+        predictSuccessorsLocked(libraryName, now);
+    }
+
+    // Keeps the plugins that usually follow libraryName warm until the next
+    // playback moves the prediction on.
+    void predictSuccessorsLocked(const std::string& libraryName, Clock::time_point now) {
+        std::vector<std::pair<int, std::string>> successors;
+        const auto transitionsIt = transitions.find(libraryName);
+        if (transitionsIt != transitions.end() && policy.maxPredicted > 0 && now >= pressureUntil) {
+            int total = 0;
+            for (const auto& [next, count] : transitionsIt->second) {
+                total += count;
+            }
+            for (const auto& [next, count] : transitionsIt->second) {
+                if (count >= kMinTransitionsForPrediction &&
+                    static_cast<double>(count) >= kMinTransitionShare * static_cast<double>(total)) {
+                    successors.emplace_back(count, next);
+                }
+            }
+            std::sort(successors.begin(), successors.end(), [](const auto& a, const auto& b) {
+                return a.first > b.first;
+            });
+            if (successors.size() > static_cast<size_t>(policy.maxPredicted)) {
+                successors.resize(static_cast<size_t>(policy.maxPredicted));
+            }
+        }
+
+        for (auto& [name, slot] : plugins) {
+            const bool predicted = std::any_of(successors.begin(), successors.end(), [&](const auto& successor) {
+                return successor.second == name;
+            });
+            if (slot.predicted && !predicted) {
+                slot.predicted = false;
+                if (slot.activeLeases == 0) {
+                    scheduleIdleUnloadLocked(slot, now);
+                }
+            }
+        }
+        for (const auto& successor : successors) {
+            PluginSlot& slot = plugins[successor.second];
+            if (slot.predicted) continue;
+            slot.predicted = true;
+            slot.unloadAfter = Clock::time_point::max();
+            if (!slot.plugin && !slot.loading) {
+                LOGD("Predicting decoder plugin %s after %s", successor.second.c_str(), libraryName.c_str());
+                prewarmQueue.push_back(successor.second);
+            }
+        }
+    }
+
+    void scheduleIdleUnloadLocked(PluginSlot& slot, Clock::time_point now) {
+        if (slot.prewarmed || slot.predicted || slot.activeLeases > 0) {
+            slot.unloadAfter = Clock::time_point::max();
+            return;
+        }
+        auto delay = policy.minIdle;
+        if (slot.uses >= kUsesBeforeAdaptiveIdle && slot.reuseGapMs > 0.0 && now >= pressureUntil) {
+            const auto gapDelay = Milliseconds(static_cast<int64_t>(slot.reuseGapMs * kIdleGapFactor));
+            delay = std::clamp(gapDelay, policy.minIdle, policy.maxIdle);
+        }
+        slot.unloadAfter = now + delay;
+    }
+
+    // Drops the lock around dlopen so leases of other plugins are not held up.
+    bool loadLocked(
+            const std::string& libraryName,
+            PluginSlot& slot,
+            std::unique_lock<std::mutex>& lock,
+            bool prewarming) {
+        slot.loading = true;
+        lock.unlock();
+        const auto start = Clock::now();
+        std::shared_ptr<LoadedPlugin> plugin = loadPlugin(libraryName);
+        const int64_t loadNs = elapsedNs(start, Clock::now());
+        lock.lock();
+        slot.loading = false;
+        loadCv.notify_all();
+        if (!plugin) {
+            slot.stats.failedLoads += 1;
+            slot.prewarmed = false;
+            slot.predicted = false;
+            return false;
+        }
+        slot.plugin = std::move(plugin);
+        slot.stats.loads += 1;
+        slot.stats.loadNsTotal += loadNs;
+        slot.stats.loadNsMax = std::max(slot.stats.loadNsMax, loadNs);
+        if (prewarming) {
+            slot.stats.prewarmLoads += 1;
+            slot.lastUsed = Clock::now();
+            scheduleIdleUnloadLocked(slot, slot.lastUsed);
+        }
+        return true;
+    }
+
     std::shared_ptr<LoadedPlugin> loadPlugin(const std::string& libraryName) {
         LOGD("Loading decoder plugin: %s", libraryName.c_str());
         void* handle = dlopen(libraryName.c_str(), RTLD_NOW | RTLD_LOCAL);
@@ -159,23 +463,65 @@ private:
         return plugin;
     }
 
-    void unloadWorkerLoop() {
+    // Moves plugins due for unloading into unloaded; returns when to look again.
+    Clock::time_point collectUnloadsLocked(
+            Clock::time_point now,
+            std::vector<std::shared_ptr<LoadedPlugin>>& unloaded) {
+        auto nextWake = Clock::time_point::max();
+        std::vector<PluginSlot*> idle;
+        for (auto& [name, slot] : plugins) {
+            if (!slot.plugin || slot.loading || slot.activeLeases > 0 || slot.prewarmed || slot.predicted) {
+                continue;
+            }
+            if (slot.unloadAfter <= now) {
+                LOGD("Decoder plugin unload delay elapsed: %s", name.c_str());
+                slot.stats.unloads += 1;
+                unloaded.push_back(std::move(slot.plugin));
+                continue;
+            }
+            idle.push_back(&slot);
+            nextWake = std::min(nextWake, slot.unloadAfter);
+        }
+
+        const int idleLimit = now < pressureUntil ? std::min(1, policy.maxIdlePlugins) : policy.maxIdlePlugins;
+        if (idle.size() > static_cast<size_t>(idleLimit)) {
+            std::sort(idle.begin(), idle.end(), [](const PluginSlot* a, const PluginSlot* b) {
+                return a->lastUsed < b->lastUsed;
+            });
+            const size_t excess = idle.size() - static_cast<size_t>(idleLimit);
+            for (size_t i = 0; i < excess; ++i) {
+                LOGD("Unloading least recently used idle decoder plugin: %s", idle[i]->plugin->libraryName.c_str());
+                idle[i]->stats.unloads += 1;
+                unloaded.push_back(std::move(idle[i]->plugin));
+            }
+        }
+        if (now < pressureUntil) {
+            nextWake = std::min(nextWake, pressureUntil);
+        }
+        return nextWake;
+    }
+
+    void loaderWorkerLoop() {
         std::unique_lock<std::mutex> lock(mutex);
         while (!stopping) {
-            auto nextWake = Clock::time_point::max();
-            const auto now = Clock::now();
-
-            for (auto it = plugins.begin(); it != plugins.end();) {
-                const auto& slot = it->second;
-                if (slot.activeLeases == 0 && slot.unloadAfter <= now) {
-                    LOGD("Decoder plugin unload delay elapsed: %s", it->first.c_str());
-                    it = plugins.erase(it);
-                } else {
-                    if (slot.activeLeases == 0) {
-                        nextWake = std::min(nextWake, slot.unloadAfter);
-                    }
-                    ++it;
+            if (!prewarmQueue.empty()) {
+                const std::string libraryName = std::move(prewarmQueue.front());
+                prewarmQueue.pop_front();
+                PluginSlot& slot = plugins[libraryName];
+                if ((slot.prewarmed || slot.predicted) && !slot.plugin && !slot.loading) {
+                    loadLocked(libraryName, slot, lock, true);
                 }
+                continue;
+            }
+
+            std::vector<std::shared_ptr<LoadedPlugin>> unloaded;
+            const auto nextWake = collectUnloadsLocked(Clock::now(), unloaded);
+            if (!unloaded.empty()) {
+                // dlclose() runs static destructors; keep them out of the lock.
+                lock.unlock();
+                unloaded.clear();
+                lock.lock();
+                continue;
             }
 
             if (nextWake == Clock::time_point::max()) {
@@ -188,10 +534,24 @@ private:
 
     std::mutex mutex;
     std::condition_variable cv;
+    // Signalled whenever a load finishes, successfully or not.
+    std::condition_variable loadCv;
+    // Slots are never erased, so references into the map stay valid.
     std::unordered_map<std::string, PluginSlot> plugins;
+    std::deque<std::string> prewarmQueue;
+    // Played-track transitions between plugins: from -> to -> count.
+    std::unordered_map<std::string, std::unordered_map<std::string, int>> transitions;
+    std::string lastPlayed;
+    DecoderPluginLoader::Policy policy;
+    Clock::time_point pressureUntil {};
     std::thread worker;
     bool stopping = false;
 };
+
+DecoderPluginLoaderImpl& loaderImpl() {
+    static DecoderPluginLoaderImpl impl;
+    return impl;
+}
 } // namespace
 
 DecoderPluginLoader& DecoderPluginLoader::getInstance() {
@@ -203,6 +563,25 @@ DecoderPluginLoader::DecoderPluginLoader() = default;
 DecoderPluginLoader::~DecoderPluginLoader() = default;
 
 std::unique_ptr<AudioDecoder> DecoderPluginLoader::createDecoder(const std::string& libraryName) {
-    static DecoderPluginLoaderImpl impl;
-    return impl.createDecoder(libraryName);
+    return loaderImpl().createDecoder(libraryName);
+}
+
+void DecoderPluginLoader::notePlayback(const AudioDecoder& decoder) {
+    loaderImpl().notePlayback(decoder.getDynamicLibraryLease());
+}
+
+void DecoderPluginLoader::prewarm(const std::vector<std::string>& libraryNames) {
+    loaderImpl().prewarm(libraryNames);
+}
+
+void DecoderPluginLoader::onTrimMemory(int level) {
+    loaderImpl().onTrimMemory(level);
+}
+
+void DecoderPluginLoader::setPolicy(const Policy& policy) {
+    loaderImpl().setPolicy(policy);
+}
+
+std::string DecoderPluginLoader::statsSummary() {
+    return loaderImpl().statsSummary();
 }
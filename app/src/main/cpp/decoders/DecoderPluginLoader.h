@@ -3,14 +3,58 @@
 
 #include "AudioDecoder.h"
 
+#include <chrono>
 #include <memory>
 #include <string>
+#include <vector>
 
+// Loads decoder plugins on demand and keeps them resident while decoders lease
+// them. Idle plugins are unloaded after a delay that follows how often each
+// one comes back: a core reused every few minutes stays loaded between its
+// tracks, a one-off is dropped after minIdle.
+//
+// Loading is taken off the track-change path where possible: prewarm() loads
+// the libraries of upcoming queue entries on the loader thread and keeps them
+// until the next prewarm() names a different set, and the loader learns which
+// plugin tends to follow which (MOD -> SID -> VGM) and pre-warms the likely
+// successor whenever a plugin starts playing. A lease request that finds its
+// library still loading waits for that load instead of starting another.
+//
+// Leases start out as background leases (probe, library scan, gapless
+// preload). Only leases passed to notePlayback() count as uses for the idle
+// delay and as steps of the played sequence the prediction learns from.
+//
+// Under memory pressure (onTrimMemory) idle and pre-warmed plugins are dropped
+// and pre-warming pauses for a while.
 class DecoderPluginLoader {
 public:
+    struct Policy {
+        std::chrono::milliseconds minIdle { 5000 };
+        std::chrono::milliseconds maxIdle { 600000 };
+        // Idle (unleased, not pre-warmed) plugins kept at once; least recently
+        // used go first.
+        int maxIdlePlugins = 4;
+        // Successors pre-warmed per played track; 0 disables prediction.
+        int maxPredicted = 1;
+        // Playback leases held at least this long count as played tracks;
+        // skipped tracks say nothing about what plays next.
+        std::chrono::milliseconds minPlayedLease { 10000 };
+        std::chrono::milliseconds pressureHold { 60000 };
+    };
+
     static DecoderPluginLoader& getInstance();
 
     std::unique_ptr<AudioDecoder> createDecoder(const std::string& libraryName);
+    // Marks the decoder's lease as playback once it becomes the playing
+    // decoder; no-op for decoders linked into the engine.
+    void notePlayback(const AudioDecoder& decoder);
+    // Replaces the pre-warmed set; loading happens on the loader thread.
+    void prewarm(const std::vector<std::string>& libraryNames);
+    // ComponentCallbacks2 trim level.
+    void onTrimMemory(int level);
+    void setPolicy(const Policy& policy);
+    // Per plugin: loads/unloads, how acquires were served and load latency.
+    std::string statsSummary();
 
 private:
     DecoderPluginLoader();
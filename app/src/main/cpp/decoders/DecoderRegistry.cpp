@@ -1,4 +1,5 @@
 #include "DecoderRegistry.h"
+#include "DecoderSignatureSniffer.h"
 #include <iostream>
 #include <algorithm>
 #include <filesystem>
@@ -55,17 +56,54 @@ std::vector<std::string> buildExtensionCandidates(const std::string& filePath) {
     return candidates;
 }
 
-bool decoderSupportsExtension(const DecoderInfo& info, const std::string& extension) {
-    if (info.enabledExtensions.empty()) {
-        for (const auto& ext : info.supportedExtensions) {
-            if (toLowerAscii(ext) == extension) return true;
-        }
-        return false;
+// Sniffed format first, then the name's extension candidates.
+std::vector<std::string> buildLookupKeys(const char* path) {
+    std::vector<std::string> keys = buildExtensionCandidates(path);
+    const std::string sniffed = sniffDecoderExtension(path);
+    if (!sniffed.empty()) {
+        keys.erase(std::remove(keys.begin(), keys.end(), sniffed), keys.end());
+        keys.insert(keys.begin(), sniffed);
     }
-    for (const auto& ext : info.enabledExtensions) {
-        if (toLowerAscii(ext) == extension) return true;
+    return keys;
+}
+
+bool isSingleInstance(const DecoderInfo& info) {
+    return info.staticInfo.hasPlaybackCapabilities &&
+           (info.staticInfo.playbackCapabilities & AudioDecoder::PLAYBACK_CAP_SINGLE_INSTANCE) != 0;
+}
+
+struct DecoderCandidate {
+    std::string name;
+    DecoderFactory factory;
+};
+
+// Enabled decoders for path in trial order: lookup keys first, then
+// priority. Factories are copied so they can run without the registry lock.
+std::vector<DecoderCandidate> collectCandidates(
+        const std::vector<DecoderInfo>& decoders,
+        const std::unordered_map<std::string, std::vector<size_t>>& extensionIndex,
+        const std::vector<std::string>& keys,
+        bool skipSingleInstance) {
+    std::vector<DecoderCandidate> candidates;
+    for (const auto& key : keys) {
+        const auto it = extensionIndex.find(key);
+        if (it == extensionIndex.end()) {
+            continue;
+        }
+        for (const size_t index : it->second) {
+            const DecoderInfo& info = decoders[index];
+            if (skipSingleInstance && isSingleInstance(info)) {
+                continue;
+            }
+            const bool seen = std::any_of(candidates.begin(), candidates.end(), [&](const DecoderCandidate& candidate) {
+                return candidate.name == info.name;
+            });
+            if (!seen) {
+                candidates.push_back({ info.name, info.factory });
+            }
+        }
     }
-    return false;
+    return candidates;
 }
 }
 
@@ -90,9 +128,11 @@ void DecoderRegistry::registerDecoder(
     info.enabledExtensions = {}; // Empty means all extensions enabled
     info.staticInfo = std::move(staticInfo);
 
+    std::lock_guard<std::mutex> lock(mutex);
     decoders.push_back(info);
 
     sortDecodersByPriority();
+    rebuildExtensionIndexLocked();
 
     LOGD("Registered decoder: %s with priority %d", name.c_str(), priority);
 }
@@ -101,31 +141,28 @@ std::unique_ptr<AudioDecoder> DecoderRegistry::createDecoder(const char* path) {
     if (!path) return nullptr;
 
     std::string filePath = path;
-    const std::vector<std::string> extensionCandidates = buildExtensionCandidates(filePath);
-    if (extensionCandidates.empty()) {
+    const std::vector<std::string> keys = buildLookupKeys(path);
+    if (keys.empty()) {
         LOGE("No extension candidates resolved for file: %s", filePath.c_str());
         return nullptr;
     }
 
     LOGD("Looking for decoder for extension candidates: first=%s count=%zu",
-         extensionCandidates.front().c_str(),
-         extensionCandidates.size());
+         keys.front().c_str(),
+         keys.size());
+
+    std::vector<DecoderCandidate> candidates;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        candidates = collectCandidates(decoders, extensionIndex, keys, false);
+    }
 
     // Try to find an enabled decoder that supports this extension
-    for (const auto& extension : extensionCandidates) {
-        for (const auto& info : decoders) {
-            if (!info.enabled) {
-                continue;
-            }
-            if (!decoderSupportsExtension(info, extension)) {
-                continue;
-            }
-            LOGD("Found matching decoder: %s (priority %d) for extension: %s",
-                 info.name.c_str(), info.priority, extension.c_str());
-            auto decoder = info.factory();
-            if (decoder) {
-                return decoder;
-            }
+    for (const auto& candidate : candidates) {
+        LOGD("Found matching decoder: %s", candidate.name.c_str());
+        auto decoder = candidate.factory();
+        if (decoder) {
+            return decoder;
         }
     }
 
@@ -133,17 +170,127 @@ std::unique_ptr<AudioDecoder> DecoderRegistry::createDecoder(const char* path) {
     return nullptr;
 }
 
+std::string DecoderRegistry::resolveDecoderName(const char* path) {
+    if (!path) return "";
+
+    const std::vector<std::string> keys = buildLookupKeys(path);
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto candidates = collectCandidates(decoders, extensionIndex, keys, false);
+    return candidates.empty() ? "" : candidates.front().name;
+}
+
+std::string DecoderRegistry::resolvePluginLibrary(const char* path) {
+    if (!path) return "";
+
+    const std::vector<std::string> keys = buildLookupKeys(path);
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto candidates = collectCandidates(decoders, extensionIndex, keys, false);
+    if (candidates.empty()) return "";
+    const DecoderInfo* info = findDecoderInfo(candidates.front().name);
+    return info ? info->staticInfo.pluginLibrary : "";
+}
+
+DecoderProbeResult DecoderRegistry::probe(const char* path, const ProbeCandidateGate& gate) {
+    DecoderProbeResult result;
+    if (!path) return result;
+    result.path = path;
+
+    const std::vector<std::string> keys = buildLookupKeys(path);
+    std::vector<DecoderCandidate> candidates;
+    bool anyCandidate = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        candidates = collectCandidates(decoders, extensionIndex, keys, true);
+        anyCandidate = !candidates.empty() || !collectCandidates(decoders, extensionIndex, keys, false).empty();
+    }
+    if (candidates.empty()) {
+        result.status = anyCandidate ? DecoderProbeResult::Status::Skipped : DecoderProbeResult::Status::Unsupported;
+        return result;
+    }
+
+    result.status = DecoderProbeResult::Status::OpenFailed;
+    for (const auto& candidate : candidates) {
+        if (gate && !gate(candidate.name)) {
+            continue;
+        }
+        std::unique_ptr<AudioDecoder> decoder = candidate.factory();
+        if (!decoder) {
+            continue;
+        }
+        decoder->setMetadataOnly(true);
+        if (!decoder->open(path)) {
+            continue;
+        }
+
+        result.status = DecoderProbeResult::Status::Ok;
+        result.decoderName = decoder->getName();
+        result.title = decoder->getTitle();
+        result.artist = decoder->getArtist();
+        result.composer = decoder->getComposer();
+        result.album = decoder->getAlbum();
+        result.genre = decoder->getGenre();
+        result.year = decoder->getYear();
+        result.durationSeconds = decoder->getDuration();
+        result.durationReliable =
+                (decoder->getPlaybackCapabilities() & AudioDecoder::PLAYBACK_CAP_RELIABLE_DURATION) != 0;
+        result.sampleRateHz = decoder->getSampleRate();
+        result.channelCount = decoder->getDisplayChannelCount();
+        const int subtuneCount = std::max(1, decoder->getSubtuneCount());
+        if (subtuneCount > 1) {
+            result.subtuneTitles.reserve(static_cast<size_t>(subtuneCount));
+            result.subtuneDurationSeconds.reserve(static_cast<size_t>(subtuneCount));
+            for (int index = 0; index < subtuneCount; ++index) {
+                result.subtuneTitles.push_back(decoder->getSubtuneTitle(index));
+                result.subtuneDurationSeconds.push_back(decoder->getSubtuneDurationSeconds(index));
+            }
+        }
+        decoder->close();
+        break;
+    }
+    return result;
+}
+
+std::string DecoderRegistry::resolveProbeDecoderName(const char* path) {
+    if (!path) return "";
+
+    const std::vector<std::string> keys = buildLookupKeys(path);
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto candidates = collectCandidates(decoders, extensionIndex, keys, true);
+    return candidates.empty() ? "" : candidates.front().name;
+}
+
+void DecoderRegistry::resolveDecoderNames(const char* path, std::string& decoderName, std::string& probeDecoderName) {
+    decoderName.clear();
+    probeDecoderName.clear();
+    if (!path) return;
+
+    const std::vector<std::string> keys = buildLookupKeys(path);
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto candidates = collectCandidates(decoders, extensionIndex, keys, false);
+    if (candidates.empty()) return;
+    decoderName = candidates.front().name;
+    const auto probeCandidates = collectCandidates(decoders, extensionIndex, keys, true);
+    if (!probeCandidates.empty()) {
+        probeDecoderName = probeCandidates.front().name;
+    }
+}
+
 std::unique_ptr<AudioDecoder> DecoderRegistry::createDecoderByName(const std::string& name) {
-    for (const auto& info : decoders) {
-        if (info.name == name) {
-            return info.factory();
+    DecoderFactory factory;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        DecoderInfo* info = findDecoderInfo(name);
+        if (!info) {
+            return nullptr;
         }
+        factory = info->factory;
     }
-    return nullptr;
+    return factory();
 }
 
 std::vector<std::string> DecoderRegistry::getSupportedExtensions() {
     std::vector<std::string> allExtensions;
+    std::lock_guard<std::mutex> lock(mutex);
     for (const auto& info : decoders) {
         // Skip disabled decoders
         if (!info.enabled) {
@@ -179,47 +326,74 @@ void DecoderRegistry::sortDecodersByPriority() {
     });
 }
 
+void DecoderRegistry::rebuildExtensionIndexLocked() {
+    extensionIndex.clear();
+    for (size_t index = 0; index < decoders.size(); ++index) {
+        const DecoderInfo& info = decoders[index];
+        if (!info.enabled) {
+            continue;
+        }
+        const auto& extensions = info.enabledExtensions.empty() ? info.supportedExtensions : info.enabledExtensions;
+        for (const auto& extension : extensions) {
+            std::vector<size_t>& entries = extensionIndex[toLowerAscii(extension)];
+            if (entries.empty() || entries.back() != index) {
+                entries.push_back(index);
+            }
+        }
+    }
+}
+
 void DecoderRegistry::setDecoderEnabled(const std::string& name, bool enabled) {
+    std::lock_guard<std::mutex> lock(mutex);
     DecoderInfo* info = findDecoderInfo(name);
     if (info) {
         info->enabled = enabled;
+        rebuildExtensionIndexLocked();
         LOGD("Decoder %s %s", name.c_str(), enabled ? "enabled" : "disabled");
     }
 }
 
 bool DecoderRegistry::isDecoderEnabled(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex);
     DecoderInfo* info = findDecoderInfo(name);
     return info ? info->enabled : false;
 }
 
 void DecoderRegistry::setDecoderPriority(const std::string& name, int priority) {
+    std::lock_guard<std::mutex> lock(mutex);
     DecoderInfo* info = findDecoderInfo(name);
     if (info) {
         info->priority = priority;
         sortDecodersByPriority();
+        rebuildExtensionIndexLocked();
         LOGD("Decoder %s priority set to %d", name.c_str(), priority);
     }
 }
 
 int DecoderRegistry::getDecoderPriority(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex);
     DecoderInfo* info = findDecoderInfo(name);
     return info ? info->priority : 0;
 }
 
 int DecoderRegistry::getDecoderDefaultPriority(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex);
     DecoderInfo* info = findDecoderInfo(name);
     return info ? info->defaultPriority : 0;
 }
 
 void DecoderRegistry::setDecoderEnabledExtensions(const std::string& name, const std::vector<std::string>& extensions) {
+    std::lock_guard<std::mutex> lock(mutex);
     DecoderInfo* info = findDecoderInfo(name);
     if (info) {
         info->enabledExtensions = extensions;
+        rebuildExtensionIndexLocked();
         LOGD("Decoder %s enabled extensions updated (%zu extensions)", name.c_str(), extensions.size());
     }
 }
 
 std::vector<std::string> DecoderRegistry::getDecoderEnabledExtensions(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex);
     DecoderInfo* info = findDecoderInfo(name);
     if (info) {
         // If empty, return all supported extensions (means all are enabled)
@@ -232,12 +406,14 @@ std::vector<std::string> DecoderRegistry::getDecoderEnabledExtensions(const std:
 }
 
 std::vector<std::string> DecoderRegistry::getDecoderSupportedExtensions(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex);
     DecoderInfo* info = findDecoderInfo(name);
     return info ? info->supportedExtensions : std::vector<std::string>{};
 }
 
 std::vector<std::string> DecoderRegistry::getRegisteredDecoderNames() {
     std::vector<std::string> names;
+    std::lock_guard<std::mutex> lock(mutex);
     for (const auto& info : decoders) {
         names.push_back(info.name);
     }
@@ -245,6 +421,7 @@ std::vector<std::string> DecoderRegistry::getRegisteredDecoderNames() {
 }
 
 bool DecoderRegistry::getDecoderStaticInfo(const std::string& name, DecoderStaticInfo& staticInfo) {
+    std::lock_guard<std::mutex> lock(mutex);
     DecoderInfo* info = findDecoderInfo(name);
     if (!info) {
         return false;
@@ -5,6 +5,8 @@
 #include <string>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include "AudioDecoder.h"
 
 // Factory function type
@@ -20,6 +22,36 @@ struct DecoderStaticInfo {
     bool hasFixedSampleRateHz = false;
     int fixedSampleRateHz = 0;
     std::function<int(const char*)> optionApplyPolicy;
+    // Upper bound on concurrent probe() instances during library scans; 0 = no limit.
+    int maxConcurrentProbes = 0;
+    // Shared library the factory loads through DecoderPluginLoader; empty for
+    // decoders linked into the engine.
+    std::string pluginLibrary;
+};
+
+struct DecoderProbeResult {
+    enum class Status {
+        Ok = 0,
+        Unsupported = 1, // No enabled decoder handles the file
+        OpenFailed = 2,
+        Skipped = 3 // Only single-instance cores handle the file
+    };
+
+    Status status = Status::Unsupported;
+    std::string path;
+    std::string decoderName;
+    std::string title;
+    std::string artist;
+    std::string composer;
+    std::string album;
+    std::string genre;
+    std::string year;
+    double durationSeconds = 0.0;
+    bool durationReliable = false;
+    int sampleRateHz = 0;
+    int channelCount = 0;
+    std::vector<std::string> subtuneTitles;
+    std::vector<double> subtuneDurationSeconds;
 };
 
 struct DecoderInfo {
@@ -44,8 +76,29 @@ public:
             int priority = 0,
             DecoderStaticInfo staticInfo = {});
 
+    // Tries the decoders for the format a local file's signature names first,
+    // then those for its extensions, each in priority order.
     std::unique_ptr<AudioDecoder> createDecoder(const char* path);
     std::unique_ptr<AudioDecoder> createDecoderByName(const std::string& name);
+    // Name of the decoder createDecoder() would try first, without instantiating it.
+    std::string resolveDecoderName(const char* path);
+    // Plugin library of that decoder, or "" when it is built in or none matches.
+    std::string resolvePluginLibrary(const char* path);
+
+    // Asked before probe() instantiates each candidate; returning false skips
+    // that decoder. Lets callers account for the core actually being opened.
+    using ProbeCandidateGate = std::function<bool(const std::string& decoderName)>;
+
+    // Opens path on a metadata-only decoder instance, reads tags, duration and
+    // subtune info, and closes it again before returning; the plugin lease
+    // lasts only as long as the call. Decoders are tried in createDecoder()
+    // order, moving on when open() fails. Single-instance cores are never
+    // probed, since the playing track may own their global emulator.
+    DecoderProbeResult probe(const char* path, const ProbeCandidateGate& gate = {});
+    // Name of the decoder probe() would try first, without instantiating it.
+    std::string resolveProbeDecoderName(const char* path);
+    // Both of the above from one lookup, reading the file's signature once.
+    void resolveDecoderNames(const char* path, std::string& decoderName, std::string& probeDecoderName);
 
     // List supported extensions (only from enabled decoders with enabled extensions)
     std::vector<std::string> getSupportedExtensions();
@@ -64,10 +117,17 @@ public:
 
 private:
     DecoderRegistry() = default;
+    // Guards decoders; factories run outside it. Library scans query the
+    // registry from several threads while settings may change it.
+    std::mutex mutex;
     std::vector<DecoderInfo> decoders;
+    // Lowercase extension -> indices into decoders of the enabled decoders
+    // that accept it, in priority order. Rebuilt whenever decoders changes.
+    std::unordered_map<std::string, std::vector<size_t>> extensionIndex;
 
     DecoderInfo* findDecoderInfo(const std::string& name);
     void sortDecodersByPriority();
+    void rebuildExtensionIndexLocked();
 };
 
 #endif //SILICONPLAYER_DECODERREGISTRY_H
@@ -0,0 +1,182 @@
+#include "DecoderSignatureSniffer.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <cctype>
+#include <cstring>
+
+namespace {
+// Enough inflated bytes to see any header checked below.
+constexpr size_t kInflatedHeaderBytes = 32;
+// MOD sample table ends here; the channel tag follows.
+constexpr size_t kModTagOffset = 1080;
+constexpr size_t kS3mTagOffset = 44;
+constexpr size_t kSndhTagOffset = 12;
+
+struct Signature {
+    size_t offset;
+    const char* magic;
+    const char* extension;
+};
+
+// Checked in order; the first match wins.
+constexpr Signature kSignatures[] = {
+        { 0, "PSID", "sid" },
+        { 0, "RSID", "sid" },
+        { kSndhTagOffset, "SNDH", "sndh" },
+        // ICE-packed SNDH; sc68 unpacks it.
+        { 0, "ICE!", "sndh" },
+        { 0, "Ice!", "sndh" },
+        { 0, "SC68 Music-file", "sc68" },
+        { 0, "Vgm ", "vgm" },
+        { 0, "-Furnace module-", "fur" },
+        // Furnace loads DefleMask modules by content; the "dmf" key would try
+        // OpenMPT's unrelated X-Tracker format first.
+        { 0, ".DelekDefleMask.", "fur" },
+        { 0, "DDMF", "dmf" },
+        { 0, "IMPM", "it" },
+        { 0, "Extended Module: ", "xm" },
+        { kS3mTagOffset, "SCRM", "s3m" },
+        { 0, "MMD0", "med" },
+        { 0, "MMD1", "med" },
+        { 0, "MMD2", "med" },
+        { 0, "MMD3", "med" },
+        { 0, "OKTASONG", "okt" },
+        { 0, "MTM\x10", "mtm" },
+        { 0, "NESM\x1a", "nsf" },
+        { 0, "NSFE", "nsfe" },
+        { 0, "SNES-SPC700 Sound File Data", "spc" },
+        { 0, "GBS\x01", "gbs" },
+        { 0, "HESM", "hes" },
+        { 0, "KSCC", "kss" },
+        { 0, "KSSX", "kss" },
+        { 0, "SAP\r\n", "sap" },
+        { 0, "GYMX", "gym" },
+        { 0, "ZXAYEMUL", "ay" },
+        { 0, "PSF\x21", "usf" },
+        { 0, "PSF\x24", "2sf" },
+        { 0, "cyd!song", "kt" },
+        { 0, "DBRAWOPL", "dro" },
+        { 0, "fLaC", "flac" },
+        { 0, "OggS", "ogg" },
+        { 0, "MAC ", "ape" },
+        { 0, "wvpk", "wv" },
+        { 4, "ftyp", "m4a" },
+        // Last among the containers: ID3v2 can front other formats, and
+        // FFmpeg probes those by content either way.
+        { 0, "ID3", "mp3" },
+};
+
+bool hasBytesAt(const uint8_t* data, size_t size, size_t offset, const char* magic, size_t length) {
+    return offset + length <= size && std::memcmp(data + offset, magic, length) == 0;
+}
+
+bool hasMagicAt(const uint8_t* data, size_t size, size_t offset, const char* magic) {
+    return hasBytesAt(data, size, offset, magic, std::strlen(magic));
+}
+
+// Inflates the start of a gzip (windowBits 31) or zlib (15) stream.
+size_t inflateHeader(const uint8_t* data, size_t size, int windowBits, uint8_t* out, size_t outSize) {
+    z_stream stream {};
+    if (inflateInit2(&stream, windowBits) != Z_OK) {
+        return 0;
+    }
+    stream.next_in = const_cast<Bytef*>(data);
+    stream.avail_in = static_cast<uInt>(size);
+    stream.next_out = out;
+    stream.avail_out = static_cast<uInt>(outSize);
+    const int status = inflate(&stream, Z_SYNC_FLUSH);
+    const size_t produced = outSize - stream.avail_out;
+    inflateEnd(&stream);
+    return status == Z_OK || status == Z_STREAM_END || status == Z_BUF_ERROR ? produced : 0;
+}
+
+std::string sniffCompressed(const uint8_t* data, size_t size) {
+    uint8_t header[kInflatedHeaderBytes] = {};
+    if (size >= 3 && data[0] == 0x1f && data[1] == 0x8b && data[2] == 0x08) {
+        const size_t length = inflateHeader(data, size, 15 + 16, header, sizeof(header));
+        return hasMagicAt(header, length, 0, "Vgm ") ? "vgz" : "";
+    }
+    // zlib: deflate method, 32 KiB window or less, header checksum.
+    if (size >= 2 && (data[0] & 0x0f) == 8 && (data[0] >> 4) <= 7 &&
+        ((data[0] << 8) | data[1]) % 31 == 0) {
+        const size_t length = inflateHeader(data, size, 15, header, sizeof(header));
+        if (hasMagicAt(header, length, 0, "-Furnace module-") ||
+            hasMagicAt(header, length, 0, ".DelekDefleMask.")) {
+            return "fur";
+        }
+    }
+    return "";
+}
+
+// ProTracker and its clones tag the channel count after the sample table.
+bool hasModTag(const uint8_t* data, size_t size) {
+    if (kModTagOffset + 4 > size) {
+        return false;
+    }
+    const char* tag = reinterpret_cast<const char*>(data + kModTagOffset);
+    static constexpr const char* kTags[] = { "M.K.", "M!K!", "M&K!", "FLT4", "FLT8", "CD81", "OKTA", "OCTA" };
+    for (const char* known : kTags) {
+        if (std::memcmp(tag, known, 4) == 0) {
+            return true;
+        }
+    }
+    const auto digit = [](char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; };
+    // "6CHN", "8CHN" ... and "10CH" .. "32CH".
+    return (digit(tag[0]) && std::memcmp(tag + 1, "CHN", 3) == 0) ||
+           (digit(tag[0]) && digit(tag[1]) && tag[2] == 'C' && tag[3] == 'H');
+}
+}
+
+std::string sniffDecoderExtension(const uint8_t* data, size_t size) {
+    if (data == nullptr || size < 4) {
+        return "";
+    }
+    for (const Signature& signature : kSignatures) {
+        if (hasMagicAt(data, size, signature.offset, signature.magic)) {
+            return signature.extension;
+        }
+    }
+    // The version byte follows the tag and is 0 or 1 in every release.
+    if (hasBytesAt(data, size, 0, "THX", 3) && data[3] <= 1) {
+        return "ahx";
+    }
+    if (hasBytesAt(data, size, 0, "HVL", 3) && data[3] <= 1) {
+        return "hvl";
+    }
+    if (hasMagicAt(data, size, 0, "RIFF") && hasMagicAt(data, size, 8, "WAVE")) {
+        return "wav";
+    }
+    if (hasMagicAt(data, size, 0, "FORM") &&
+        (hasMagicAt(data, size, 8, "AIFF") || hasMagicAt(data, size, 8, "AIFC"))) {
+        return "aiff";
+    }
+    std::string compressed = sniffCompressed(data, size);
+    if (!compressed.empty()) {
+        return compressed;
+    }
+    return hasModTag(data, size) ? "mod" : "";
+}
+
+std::string sniffDecoderExtension(const char* path) {
+    if (path == nullptr || std::strstr(path, "://") != nullptr) {
+        return "";
+    }
+    const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return "";
+    }
+    uint8_t head[kDecoderSniffBytes];
+    size_t filled = 0;
+    while (filled < sizeof(head)) {
+        const ssize_t count = ::read(fd, head + filled, sizeof(head) - filled);
+        if (count <= 0) {
+            break;
+        }
+        filled += static_cast<size_t>(count);
+    }
+    ::close(fd);
+    return sniffDecoderExtension(head, filled);
+}
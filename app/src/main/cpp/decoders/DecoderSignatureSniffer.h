@@ -0,0 +1,22 @@
+#ifndef SILICONPLAYER_DECODERSIGNATURESNIFFER_H
+#define SILICONPLAYER_DECODERSIGNATURESNIFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Identifies a file's format from its first few KiB (PSID/RSID, SNDH, Vgm and
+// gzipped VGZ, Furnace, tracker module tags, chip-music headers, common audio
+// containers) and names it by the registry extension its decoders list, so
+// DecoderRegistry can route files with a wrong or missing extension without
+// trial opens.
+
+constexpr size_t kDecoderSniffBytes = 4096;
+
+// Lowercase extension key, or "" when nothing matched.
+std::string sniffDecoderExtension(const uint8_t* data, size_t size);
+// Reads at most kDecoderSniffBytes of a local file; "" for URLs and files
+// that cannot be read.
+std::string sniffDecoderExtension(const char* path);
+
+#endif // SILICONPLAYER_DECODERSIGNATURESNIFFER_H
@@ -593,6 +593,18 @@ bool FFmpegDecoder::openSmbCustomIoLocked(const char* path) {
     }
 
     smbAvioPosition = 0;
+    smbAvioSizeBytes = getSmbAvioHandleSizeForPlugin(smbAvioHandleId);
+    if (smbAvioSizeBytes >= 0) {
+        // Every read used to cross into Java on the render worker; the
+        // prefetch thread now pays that cost ahead of playback.
+        const int64_t handleId = smbAvioHandleId;
+        smbReadAhead = std::make_unique<ReadAheadCache>(
+                [handleId](int64_t offset, uint8_t* buffer, int length) {
+                    return readSmbAvioHandleForPlugin(handleId, offset, buffer, length);
+                },
+                smbAvioSizeBytes
+        );
+    }
     avioBuffer = static_cast<uint8_t*>(av_malloc(kSmbAvioBufferSize));
     if (avioBuffer == nullptr) {
         LOGE("Failed to allocate SMB AVIO buffer");
@@ -643,11 +655,25 @@ void FFmpegDecoder::closeSmbCustomIoLocked() {
         avio_context_free(&avioContext);
     }
     avioBuffer = nullptr;
+    if (smbReadAhead) {
+        const ReadAheadCache::Stats stats = smbReadAhead->getStats();
+        LOGD(
+                "SMB read-ahead: hits=%llu misses=%llu stalls=%llu stall=%.1fms fetched=%lluKiB",
+                static_cast<unsigned long long>(stats.hits),
+                static_cast<unsigned long long>(stats.misses),
+                static_cast<unsigned long long>(stats.stalls),
+                static_cast<double>(stats.stallNs) / 1000000.0,
+                static_cast<unsigned long long>(stats.bytesFetched / 1024)
+        );
+        // Joins the prefetch thread before its handle goes away.
+        smbReadAhead.reset();
+    }
     if (smbAvioHandleId > 0) {
         closeSmbAvioHandleForPlugin(smbAvioHandleId);
         smbAvioHandleId = 0;
     }
     smbAvioPosition = 0;
+    smbAvioSizeBytes = -1;
     usingSmbCustomIo = false;
 }
 
@@ -657,12 +683,14 @@ int FFmpegDecoder::readPacketCallback(void* opaque, uint8_t* buffer, int bufferS
         return AVERROR(EINVAL);
     }
 
-    const int bytesRead = readSmbAvioHandleForPlugin(
-            decoder->smbAvioHandleId,
-            decoder->smbAvioPosition,
-            buffer,
-            bufferSize
-    );
+    const int bytesRead = decoder->smbReadAhead
+            ? decoder->smbReadAhead->read(decoder->smbAvioPosition, buffer, bufferSize)
+            : readSmbAvioHandleForPlugin(
+                    decoder->smbAvioHandleId,
+                    decoder->smbAvioPosition,
+                    buffer,
+                    bufferSize
+            );
     if (bytesRead < 0) {
         return AVERROR(EIO);
     }
@@ -687,12 +715,16 @@ int64_t FFmpegDecoder::seekCallback(void* opaque, int64_t offset, int whence) {
         return AVERROR(EINVAL);
     }
 
+    // The size is fixed for the handle's lifetime; only ask Java again if
+    // it was unknown at open.
+    const int64_t sizeBytes = decoder->smbAvioSizeBytes >= 0
+            ? decoder->smbAvioSizeBytes
+            : getSmbAvioHandleSizeForPlugin(decoder->smbAvioHandleId);
     if ((whence & AVSEEK_SIZE) == AVSEEK_SIZE) {
-        return getSmbAvioHandleSizeForPlugin(decoder->smbAvioHandleId);
+        return sizeBytes;
     }
 
     const int baseWhence = whence & ~AVSEEK_FORCE;
-    const int64_t sizeBytes = getSmbAvioHandleSizeForPlugin(decoder->smbAvioHandleId);
     if (sizeBytes < 0) {
         return AVERROR(EIO);
     }
@@ -1389,6 +1421,20 @@ int FFmpegDecoder::getCoreIntInfo(const char* name, int fallback) {
     return fallback;
 }
 
+int64_t FFmpegDecoder::getCoreInt64Info(const char* name, int64_t fallback) {
+    if (name == nullptr) return fallback;
+    std::lock_guard<std::mutex> lock(decodeMutex);
+    if (!smbReadAhead) return fallback;
+    const std::string key(name);
+    const ReadAheadCache::Stats stats = smbReadAhead->getStats();
+    if (key == "readAheadHits") return static_cast<int64_t>(stats.hits);
+    if (key == "readAheadMisses") return static_cast<int64_t>(stats.misses);
+    if (key == "readAheadStalls") return static_cast<int64_t>(stats.stalls);
+    if (key == "readAheadStallNs") return static_cast<int64_t>(stats.stallNs);
+    if (key == "readAheadFetchedBytes") return static_cast<int64_t>(stats.bytesFetched);
+    return fallback;
+}
+
 std::vector<std::string> FFmpegDecoder::getSupportedExtensions() {
     static std::vector<std::string> cached;
     static std::once_flag once;
@@ -2,6 +2,7 @@
 #define SILICONPLAYER_FFMPEGDECODER_H
 
 #include "AudioDecoder.h"
+#include "../ReadAheadCache.h"
 #include <vector>
 #include <mutex>
 #include <memory>
@@ -59,6 +60,8 @@ public:
     TimelineMode getTimelineMode() const override { return TimelineMode::ContinuousLinear; }
     std::string getCoreStringInfo(const char* name) override;
     int getCoreIntInfo(const char* name, int fallback = 0) override;
+    // readAhead* counters of the SMB read-ahead cache; fallback without one.
+    int64_t getCoreInt64Info(const char* name, int64_t fallback = 0) override;
 
     // Bitrate information
     int64_t getBitrate() const;
@@ -118,6 +121,8 @@ private:
     uint8_t* avioBuffer = nullptr;
     int64_t smbAvioHandleId = 0;
     int64_t smbAvioPosition = 0;
+    int64_t smbAvioSizeBytes = -1;
+    std::unique_ptr<ReadAheadCache> smbReadAhead;
     bool usingSmbCustomIo = false;
     std::string openedPath;
 
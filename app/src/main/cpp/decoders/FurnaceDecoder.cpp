@@ -1,12 +1,13 @@
 #include "FurnaceDecoder.h"
 
+#include "../FileSource.h"
+
 #include <algorithm>
 #include <cctype>
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
 #include <filesystem>
-#include <fstream>
 #include <iterator>
 #include <limits>
 
@@ -29,25 +30,6 @@ constexpr int kMaxChannelScopeChannels = 64;
 constexpr float kFurnaceDefaultScopeGain = 0.5f;
 constexpr float kFurnaceTsuScopeGain = 1.0f;
 
-std::vector<unsigned char> readBinaryFile(const std::string& path) {
-    std::ifstream stream(path, std::ios::binary | std::ios::ate);
-    if (!stream) {
-        return {};
-    }
-
-    const std::streamsize size = stream.tellg();
-    if (size <= 0) {
-        return {};
-    }
-
-    std::vector<unsigned char> data(static_cast<size_t>(size));
-    stream.seekg(0, std::ios::beg);
-    if (!stream.read(reinterpret_cast<char*>(data.data()), size)) {
-        return {};
-    }
-    return data;
-}
-
 std::string uppercaseExtensionWithoutDot(const std::filesystem::path& path) {
     std::string ext = path.extension().string();
     if (!ext.empty() && ext[0] == '.') {
@@ -161,8 +143,8 @@ bool FurnaceDecoder::open(const char* path) {
     }
 
     sourcePath = path;
-    const auto fileData = readBinaryFile(sourcePath);
-    if (fileData.empty()) {
+    const auto fileSource = FileSource::open(sourcePath);
+    if (!fileSource) {
         closeInternalLocked();
         return false;
     }
@@ -176,10 +158,12 @@ bool FurnaceDecoder::open(const char* path) {
     localEngine->setConf("audioBufSize", 1024);
     applyCoreOptionsLocked(localEngine.get());
 
-    auto* ownedData = new unsigned char[fileData.size()];
-    std::memcpy(ownedData, fileData.data(), fileData.size());
+    // DivEngine::load() takes ownership of its buffer, so it gets the one
+    // heap copy, made straight from the mapping.
+    auto* ownedData = new unsigned char[fileSource->size()];
+    std::memcpy(ownedData, fileSource->data(), fileSource->size());
 
-    if (!localEngine->load(ownedData, fileData.size(), sourcePath.c_str())) {
+    if (!localEngine->load(ownedData, fileSource->size(), sourcePath.c_str())) {
         localEngine->quit(false);
         closeInternalLocked();
         return false;
@@ -926,48 +910,30 @@ void FurnaceDecoder::captureChannelScopeSnapshotLocked() {
         return;
     }
 
-    std::vector<float> raw(
-            static_cast<size_t>(totalChannels) * ChannelScopeSharedState::kMaxSamples,
-            0.0f
-    );
-    std::vector<float> vu(static_cast<size_t>(totalChannels), 0.0f);
+    const ChannelScopeSharedState::PublishBuffer publishBuffer = channelScopeState->beginPublish(totalChannels);
     const int trailingSamples = std::clamp(sampleRateHz / 50, 64, 2048);
 
     for (int channel = 0; channel < totalChannels; ++channel) {
-        const size_t channelOffset =
-                static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples;
+        float* channelSamples =
+                publishBuffer.raw + static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples;
         captureFurnaceOscBufferWindow(
                 engine->getOscBuffer(channel),
                 sampleRateHz,
-                raw.data() + channelOffset,
+                channelSamples,
                 ChannelScopeSharedState::kMaxSamples
         );
 
         const float gain = furnaceChannelScopeGain(engine->song.sysOfChan[channel]);
         if (gain != 1.0f) {
             for (int sample = 0; sample < ChannelScopeSharedState::kMaxSamples; ++sample) {
-                raw[channelOffset + static_cast<size_t>(sample)] *= gain;
+                channelSamples[sample] *= gain;
             }
         }
 
-        float peak = 0.0f;
-        const int start = std::max(0, ChannelScopeSharedState::kMaxSamples - trailingSamples);
-        for (int sample = start; sample < ChannelScopeSharedState::kMaxSamples; ++sample) {
-            peak = std::max(
-                    peak,
-                    std::abs(raw[channelOffset + static_cast<size_t>(sample)])
-            );
-        }
-        vu[static_cast<size_t>(channel)] = std::clamp(peak, 0.0f, 1.0f);
+        publishBuffer.vu[channel] = ChannelScopeSharedState::trailingPeak(channelSamples, trailingSamples);
     }
 
-    {
-        std::lock_guard<std::mutex> scopeLock(channelScopeState->mutex);
-        channelScopeState->snapshotRaw = std::move(raw);
-        channelScopeState->snapshotVu = std::move(vu);
-        channelScopeState->snapshotChannels = totalChannels;
-        channelScopeState->snapshotSerial = ++channelScopeSourceSerial;
-    }
+    channelScopeState->commitPublish(totalChannels, ++channelScopeSourceSerial);
 }
 
 std::string FurnaceDecoder::getFormatNameInfo() {
@@ -517,10 +517,7 @@ Music_Emu* GmeDecoder::createScopeShadowLocked(bool multiChannel) {
 }
 
 void GmeDecoder::resetChannelScopeLocked() {
-    scopeRingRaw.clear();
-    scopeRingChannels = 0;
-    scopeRingWritePos = 0;
-    scopeRingSamples = 0;
+    scopeRing.reset();
     scopePcmScratch.clear();
     if (channelScopeState) {
         channelScopeState->clear();
@@ -528,23 +525,7 @@ void GmeDecoder::resetChannelScopeLocked() {
 }
 
 void GmeDecoder::ensureScopeRingShapeLocked(int channelsToKeep) {
-    const int clampedChannels = std::clamp(channelsToKeep, 0, kGmeScopeMaxVoices);
-    if (clampedChannels <= 0) {
-        scopeRingRaw.clear();
-        scopeRingChannels = 0;
-        scopeRingWritePos = 0;
-        scopeRingSamples = 0;
-        return;
-    }
-    const size_t requiredSize =
-            static_cast<size_t>(clampedChannels) * ChannelScopeSharedState::kMaxSamples;
-    if (scopeRingChannels == clampedChannels && scopeRingRaw.size() == requiredSize) {
-        return;
-    }
-    scopeRingRaw.assign(requiredSize, 0.0f);
-    scopeRingChannels = clampedChannels;
-    scopeRingWritePos = 0;
-    scopeRingSamples = 0;
+    scopeRing.ensureChannels(std::clamp(channelsToKeep, 0, kGmeScopeMaxVoices));
 }
 
 void GmeDecoder::appendScopeFrameLocked(const float* perVoiceSamples, int channelsToWrite) {
@@ -552,69 +533,15 @@ void GmeDecoder::appendScopeFrameLocked(const float* perVoiceSamples, int channe
         return;
     }
     ensureScopeRingShapeLocked(channelsToWrite);
-    if (scopeRingChannels <= 0 || scopeRingRaw.empty()) {
-        return;
-    }
-    const int storedChannels = std::min(scopeRingChannels, channelsToWrite);
-    for (int channel = 0; channel < storedChannels; ++channel) {
-        scopeRingRaw[
-                static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples +
-                static_cast<size_t>(scopeRingWritePos)
-        ] = std::clamp(perVoiceSamples[channel], -1.0f, 1.0f);
-    }
-    for (int channel = storedChannels; channel < scopeRingChannels; ++channel) {
-        scopeRingRaw[
-                static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples +
-                static_cast<size_t>(scopeRingWritePos)
-        ] = 0.0f;
-    }
-    scopeRingWritePos = (scopeRingWritePos + 1) % ChannelScopeSharedState::kMaxSamples;
-    scopeRingSamples = std::min(scopeRingSamples + 1, ChannelScopeSharedState::kMaxSamples);
+    scopeRing.appendFrameClamped(perVoiceSamples, channelsToWrite);
 }
 
 void GmeDecoder::publishScopeSnapshotLocked() {
     if (!channelScopeState) {
         return;
     }
-    if (scopeRingChannels <= 0 || scopeRingRaw.empty() || scopeRingSamples <= 0) {
-        channelScopeState->clear();
-        return;
-    }
-
-    std::vector<float> raw(
-            static_cast<size_t>(scopeRingChannels) * ChannelScopeSharedState::kMaxSamples,
-            0.0f
-    );
-    std::vector<float> vu(static_cast<size_t>(scopeRingChannels), 0.0f);
-    const int filledSamples = std::clamp(scopeRingSamples, 0, ChannelScopeSharedState::kMaxSamples);
-    const int zeroPrefix = ChannelScopeSharedState::kMaxSamples - filledSamples;
     const int trailingSamples = std::clamp(activeSampleRate > 0 ? activeSampleRate / 50 : 64, 64, 1024);
-
-    for (int channel = 0; channel < scopeRingChannels; ++channel) {
-        float* dst = raw.data() + static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples;
-        for (int i = 0; i < filledSamples; ++i) {
-            const int ringIndex =
-                    (scopeRingWritePos - filledSamples + i + ChannelScopeSharedState::kMaxSamples) %
-                    ChannelScopeSharedState::kMaxSamples;
-            dst[zeroPrefix + i] = scopeRingRaw[
-                    static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples +
-                    static_cast<size_t>(ringIndex)
-            ];
-        }
-
-        float peak = 0.0f;
-        const int start = std::max(0, ChannelScopeSharedState::kMaxSamples - trailingSamples);
-        for (int i = start; i < ChannelScopeSharedState::kMaxSamples; ++i) {
-            peak = std::max(peak, std::abs(dst[i]));
-        }
-        vu[static_cast<size_t>(channel)] = std::clamp(peak, 0.0f, 1.0f);
-    }
-
-    std::lock_guard<std::mutex> channelScopeLock(channelScopeState->mutex);
-    channelScopeState->snapshotRaw = std::move(raw);
-    channelScopeState->snapshotVu = std::move(vu);
-    channelScopeState->snapshotChannels = scopeRingChannels;
-    channelScopeState->snapshotSerial = ++channelScopeSourceSerial;
+    scopeRing.publish(*channelScopeState, ++channelScopeSourceSerial, trailingSamples);
 }
 
 void GmeDecoder::applyRepeatBehaviorToEmuLocked(Music_Emu* target) {
@@ -890,8 +817,10 @@ void GmeDecoder::captureChannelScopeBlockLocked(int frames) {
         return;
     }
 
-    std::vector<float> perVoiceFrame(static_cast<size_t>(totalVoices), 0.0f);
-    std::vector<float> capturedBlocks(static_cast<size_t>(totalVoices * frames), 0.0f);
+    scopeFrameScratch.assign(static_cast<size_t>(totalVoices), 0.0f);
+    scopeBlockScratch.assign(static_cast<size_t>(totalVoices * frames), 0.0f);
+    std::vector<float>& perVoiceFrame = scopeFrameScratch;
+    std::vector<float>& capturedBlocks = scopeBlockScratch;
     if (scopeMultiEmu != nullptr) {
         const int multiVoices = std::min(totalVoices, kGmeMultiChannelVoices);
         const int outputChannels = kGmeMultiChannelVoices * 2;
@@ -1579,28 +1508,15 @@ double GmeDecoder::getPlaybackPositionSeconds() {
 
 std::vector<int32_t> GmeDecoder::getChannelScopeTextState(int maxChannels) {
     std::lock_guard<std::mutex> lock(decodeMutex);
-    if (scopeRingChannels <= 0 || scopeRingSamples <= 0 || scopeRingRaw.empty()) {
+    if (scopeRing.empty()) {
         return {};
     }
 
-    const int channelsToExport = std::min(scopeRingChannels, std::clamp(maxChannels, 1, kGmeScopeMaxVoices));
+    const int channelsToExport = std::min(scopeRing.channels(), std::clamp(maxChannels, 1, kGmeScopeMaxVoices));
     std::vector<int32_t> flat(static_cast<size_t>(channelsToExport * kChannelScopeTextStride), -1);
     const int trailingSamples = std::clamp(activeSampleRate > 0 ? activeSampleRate / 50 : 64, 64, 1024);
-    const int recentSamples = std::min(scopeRingSamples, trailingSamples);
     for (int channel = 0; channel < channelsToExport; ++channel) {
-        float recentPeak = 0.0f;
-        for (int i = 0; i < recentSamples; ++i) {
-            const int ringIndex =
-                    (scopeRingWritePos - recentSamples + i + ChannelScopeSharedState::kMaxSamples) %
-                    ChannelScopeSharedState::kMaxSamples;
-            recentPeak = std::max(
-                    recentPeak,
-                    std::abs(scopeRingRaw[
-                            static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples +
-                            static_cast<size_t>(ringIndex)
-                    ])
-            );
-        }
+        const float recentPeak = scopeRing.recentPeak(channel, trailingSamples);
 
         const size_t base = static_cast<size_t>(channel * kChannelScopeTextStride);
         int flags = 0;
@@ -117,14 +117,13 @@ private:
     int scopeVrc6BaseVoice = -1;
     int scopeMmc5BaseVoice = -1;
     std::shared_ptr<ChannelScopeSharedState> channelScopeState;
-    std::vector<float> scopeRingRaw;
+    ChannelScopeRing scopeRing;
+    std::vector<float> scopeFrameScratch;
+    std::vector<float> scopeBlockScratch;
     std::vector<short> scopePcmScratch;
     std::vector<short> scopeApuScratch;
     std::vector<short> scopeVrc6Scratch;
     std::vector<short> scopeMmc5Scratch;
-    int scopeRingChannels = 0;
-    int scopeRingWritePos = 0;
-    int scopeRingSamples = 0;
     uint64_t channelScopeSourceSerial = 0;
     bool scopeCaptureEnabled = false;
 
@@ -103,6 +103,65 @@ bool isAmigaLeftChannel(int channel) {
     const int mod4 = channel & 3;
     return mod4 == 0 || mod4 == 3;
 }
+
+hvl_tune* parseHivelyTune(const FileSource& source, int sampleRateHz, int panningMode) {
+    return hvl_ParseTune(
+            source.data(),
+            static_cast<uint32>(source.size()),
+            static_cast<uint32>(sampleRateHz),
+            static_cast<uint32>(panningMode)
+    );
+}
+
+// Runs on the duration analysis worker with its own tune, so it must not
+// touch decoder state. hvl_InitReplayer() has run by the time a decoder
+// requests analysis.
+bool analyzeHivelySubtune(
+        const FileSource& source,
+        int sampleRateHz,
+        int panningMode,
+        int index,
+        DurationCacheEntry& entry) {
+    entry = DurationCacheEntry();
+    hvl_tune* analysisTune = parseHivelyTune(source, sampleRateHz, panningMode);
+    if (!analysisTune) {
+        return true;
+    }
+    if (!hvl_InitSubsong(analysisTune, static_cast<uint32>(index))) {
+        hvl_FreeTune(analysisTune);
+        return true;
+    }
+
+    const int analysisRate = std::max(8000, static_cast<int>(analysisTune->ht_Frequency));
+    const int frameSamples = std::max(1, analysisRate / 50);
+    std::vector<int16_t> scratch(static_cast<size_t>(frameSamples * 2));
+    int8* scratchBytes = reinterpret_cast<int8*>(scratch.data());
+    const int64_t maxFramesToAnalyze = static_cast<int64_t>(analysisRate) * 60 * 30; // 30 minutes cap.
+    int64_t decodedFrames = 0;
+    bool reachedSongEnd = false;
+
+    while (decodedFrames < maxFramesToAnalyze) {
+        if (analysisTune->ht_SongEndReached != 0) {
+            reachedSongEnd = true;
+            break;
+        }
+        hvl_DecodeFrame(
+                analysisTune,
+                scratchBytes,
+                scratchBytes + static_cast<int32>(sizeof(int16_t)),
+                static_cast<int32>(sizeof(int16_t) * 2)
+        );
+        decodedFrames += frameSamples;
+    }
+
+    hvl_FreeTune(analysisTune);
+
+    if (reachedSongEnd) {
+        entry.durationMs = static_cast<uint32_t>((decodedFrames * 1000) / analysisRate);
+        entry.flags = kDurationFlagReliable;
+    }
+    return true;
+}
 }
 
 HivelyTrackerDecoder::HivelyTrackerDecoder()
@@ -123,10 +182,17 @@ bool HivelyTrackerDecoder::open(const char* path) {
     hvl_InitReplayer();
 
     sourcePath = path;
-    tune = hvl_LoadTune(
-            sourcePath.c_str(),
-            static_cast<uint32>(clampSampleRate(requestedSampleRateHz)),
-            static_cast<uint32>((optionPanningMode >= 0) ? optionPanningMode : 2));
+    // Parsed from the shared file source; duration analysis jobs reuse it
+    // instead of reloading the file.
+    fileSource = FileSource::open(sourcePath);
+    if (!fileSource) {
+        closeInternalLocked();
+        return false;
+    }
+    tune = parseHivelyTune(
+            *fileSource,
+            clampSampleRate(requestedSampleRateHz),
+            (optionPanningMode >= 0) ? optionPanningMode : 2);
     if (!tune) {
         closeInternalLocked();
         return false;
@@ -182,7 +248,9 @@ bool HivelyTrackerDecoder::open(const char* path) {
     subtuneDurationSeconds.assign(static_cast<size_t>(subtuneCount), 0.0);
     subtuneDurationKnown.assign(static_cast<size_t>(subtuneCount), 0u);
     subtuneDurationReliable.assign(static_cast<size_t>(subtuneCount), 0u);
-    analyzeSubtuneDurationLocked(currentSubtuneIndex);
+    subtuneDurationRequested.assign(static_cast<size_t>(subtuneCount), 0u);
+    contentHash = DurationAnalysisClient::hashContent(fileSource->data(), fileSource->size());
+    refreshSubtuneDurationLocked(currentSubtuneIndex);
     updateCurrentDurationFromCacheLocked();
     return true;
 }
@@ -192,6 +260,7 @@ void HivelyTrackerDecoder::closeInternalLocked() {
         hvl_FreeTune(tune);
         tune = nullptr;
     }
+    fileSource.reset();
     sourcePath.clear();
     title.clear();
     artist.clear();
@@ -215,6 +284,8 @@ void HivelyTrackerDecoder::closeInternalLocked() {
     subtuneDurationSeconds.clear();
     subtuneDurationKnown.clear();
     subtuneDurationReliable.clear();
+    subtuneDurationRequested.clear();
+    contentHash = 0;
     toggleChannelNames.clear();
     toggleChannelMuted.clear();
     channelScopeSourceSerial = 0;
@@ -290,47 +361,30 @@ void HivelyTrackerDecoder::captureChannelScopeSnapshotLocked() {
         return;
     }
 
-    std::vector<float> raw(
-            static_cast<size_t>(totalChannels) * ChannelScopeSharedState::kMaxSamples,
-            0.0f
-    );
-    const int capturedChannels = std::max(
-            0,
+    const ChannelScopeSharedState::PublishBuffer publishBuffer = channelScopeState->beginPublish(totalChannels);
+    const int capturedChannels = std::clamp(
             hvl_GetChannelScopeSamples(
                     tune,
-                    raw.data(),
+                    publishBuffer.raw,
                     ChannelScopeSharedState::kMaxSamples,
                     totalChannels
-            )
+            ),
+            0,
+            totalChannels
     );
     if (capturedChannels <= 0) {
         return;
     }
-    raw.resize(static_cast<size_t>(capturedChannels) * ChannelScopeSharedState::kMaxSamples);
 
-    std::vector<float> vu(static_cast<size_t>(capturedChannels), 0.0f);
     const int trailingSamples = std::clamp(sampleRateHz / 50, 64, 1024);
     for (int channel = 0; channel < capturedChannels; ++channel) {
-        const size_t channelOffset =
-                static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples;
-        const int start = std::max(0, ChannelScopeSharedState::kMaxSamples - trailingSamples);
-        float peak = 0.0f;
-        for (int sample = start; sample < ChannelScopeSharedState::kMaxSamples; ++sample) {
-            peak = std::max(
-                    peak,
-                    std::abs(raw[channelOffset + static_cast<size_t>(sample)])
-            );
-        }
-        vu[static_cast<size_t>(channel)] = std::clamp(peak, 0.0f, 1.0f);
+        publishBuffer.vu[channel] = ChannelScopeSharedState::trailingPeak(
+                publishBuffer.raw + static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples,
+                trailingSamples
+        );
     }
 
-    {
-        std::lock_guard<std::mutex> scopeLock(channelScopeState->mutex);
-        channelScopeState->snapshotRaw = std::move(raw);
-        channelScopeState->snapshotVu = std::move(vu);
-        channelScopeState->snapshotChannels = capturedChannels;
-        channelScopeState->snapshotSerial = ++channelScopeSourceSerial;
-    }
+    channelScopeState->commitPublish(capturedChannels, ++channelScopeSourceSerial);
 }
 
 bool HivelyTrackerDecoder::resetToSubtuneStartLocked() {
@@ -351,76 +405,48 @@ bool HivelyTrackerDecoder::resetToSubtuneStartLocked() {
     return true;
 }
 
-bool HivelyTrackerDecoder::analyzeSubtuneDurationLocked(int index) {
+bool HivelyTrackerDecoder::refreshSubtuneDurationLocked(int index) {
     if (index < 0 || index >= subtuneCount) {
         return false;
     }
     const size_t cacheIndex = static_cast<size_t>(index);
-    if (cacheIndex < subtuneDurationKnown.size() && subtuneDurationKnown[cacheIndex] != 0u) {
-        return subtuneDurationReliable[cacheIndex] != 0u;
-    }
-    if (sourcePath.empty()) {
+    if (cacheIndex >= subtuneDurationKnown.size()) {
         return false;
     }
-
-    hvl_InitReplayer();
-    hvl_tune* analysisTune = hvl_LoadTune(
-            sourcePath.c_str(),
-            static_cast<uint32>(sampleRateHz),
-            static_cast<uint32>((optionPanningMode >= 0) ? optionPanningMode : 2)
-    );
-    if (!analysisTune) {
-        if (cacheIndex < subtuneDurationKnown.size()) {
-            subtuneDurationKnown[cacheIndex] = 1u;
-            subtuneDurationReliable[cacheIndex] = 0u;
-            subtuneDurationSeconds[cacheIndex] = 0.0;
-        }
-        return false;
+    if (subtuneDurationKnown[cacheIndex] != 0u) {
+        return subtuneDurationReliable[cacheIndex] != 0u;
     }
-
-    if (!hvl_InitSubsong(analysisTune, static_cast<uint32>(index))) {
-        hvl_FreeTune(analysisTune);
-        if (cacheIndex < subtuneDurationKnown.size()) {
-            subtuneDurationKnown[cacheIndex] = 1u;
-            subtuneDurationReliable[cacheIndex] = 0u;
-            subtuneDurationSeconds[cacheIndex] = 0.0;
-        }
+    if (contentHash == 0) {
         return false;
     }
 
-    const int analysisRate = std::max(8000, static_cast<int>(analysisTune->ht_Frequency));
-    const int frameSamples = std::max(1, analysisRate / 50);
-    std::vector<int16_t> scratch(static_cast<size_t>(frameSamples * 2));
-    int8* scratchBytes = reinterpret_cast<int8*>(scratch.data());
-    const int64_t maxFramesToAnalyze = static_cast<int64_t>(analysisRate) * 60 * 30; // 30 minutes cap.
-    int64_t decodedFrames = 0;
-    bool reachedSongEnd = false;
-
-    while (decodedFrames < maxFramesToAnalyze) {
-        if (analysisTune->ht_SongEndReached != 0) {
-            reachedSongEnd = true;
-            break;
+    DurationCacheKey key;
+    key.contentHash = contentHash;
+    key.coreTag = DurationAnalysisClient::coreTag(getName());
+    key.subtune = static_cast<uint32_t>(index);
+    DurationCacheEntry entry;
+    DurationAnalysisClient& durations = DurationAnalysisClient::getInstance();
+    if (subtuneDurationRequested[cacheIndex] != 0u) {
+        if (!durations.poll(key, entry)) {
+            return false;
         }
-        hvl_DecodeFrame(
-                analysisTune,
-                scratchBytes,
-                scratchBytes + static_cast<int32>(sizeof(int16_t)),
-                static_cast<int32>(sizeof(int16_t) * 2)
-        );
-        decodedFrames += frameSamples;
-    }
-
-    hvl_FreeTune(analysisTune);
-
-    if (cacheIndex < subtuneDurationKnown.size()) {
-        subtuneDurationKnown[cacheIndex] = 1u;
-        subtuneDurationReliable[cacheIndex] = reachedSongEnd ? 1u : 0u;
-        subtuneDurationSeconds[cacheIndex] = reachedSongEnd
-                ? static_cast<double>(decodedFrames) / static_cast<double>(analysisRate)
-                : 0.0;
+    } else if (!durations.lookup(getName(), key, entry)) {
+        // Analyze off the render path; read() picks the result up.
+        subtuneDurationRequested[cacheIndex] = 1u;
+        const std::shared_ptr<const FileSource> source = fileSource;
+        const int rate = sampleRateHz;
+        const int panning = (optionPanningMode >= 0) ? optionPanningMode : 2;
+        durations.request(getName(), key, [source, rate, panning, index](DurationCacheEntry& result) {
+            return analyzeHivelySubtune(*source, rate, panning, index, result);
+        });
+        return false;
     }
 
-    return reachedSongEnd;
+    const bool reliable = (entry.flags & kDurationFlagReliable) != 0u;
+    subtuneDurationKnown[cacheIndex] = 1u;
+    subtuneDurationReliable[cacheIndex] = reliable ? 1u : 0u;
+    subtuneDurationSeconds[cacheIndex] = reliable ? static_cast<double>(entry.durationMs) / 1000.0 : 0.0;
+    return reliable;
 }
 
 void HivelyTrackerDecoder::updateCurrentDurationFromCacheLocked() {
@@ -446,6 +472,12 @@ int HivelyTrackerDecoder::read(float* buffer, int numFrames) {
         return 0;
     }
 
+    if (!durationReliable.load() &&
+        refreshSubtuneDurationLocked(currentSubtuneIndex)) {
+        // The background analysis finished since the last block.
+        updateCurrentDurationFromCacheLocked();
+    }
+
     int framesTarget = numFrames;
     const int mode = repeatMode.load();
     const bool hasReliableDuration = durationReliable.load() && durationSeconds > 0.0;
@@ -624,7 +656,7 @@ bool HivelyTrackerDecoder::selectSubtune(int index) {
     syncToggleChannelsLocked();
     applyToggleMutesLocked();
     currentSubtuneIndex = index;
-    analyzeSubtuneDurationLocked(currentSubtuneIndex);
+    refreshSubtuneDurationLocked(currentSubtuneIndex);
     updateCurrentDurationFromCacheLocked();
     stopAfterPendingDrain = false;
     pendingInterleaved.clear();
@@ -649,7 +681,7 @@ double HivelyTrackerDecoder::getSubtuneDurationSeconds(int index) {
     std::lock_guard<std::mutex> lock(decodeMutex);
     if (subtuneCount <= 0) return 0.0;
     if (index < 0 || index >= subtuneCount) return 0.0;
-    analyzeSubtuneDurationLocked(index);
+    refreshSubtuneDurationLocked(index);
     const size_t cacheIndex = static_cast<size_t>(index);
     if (cacheIndex < subtuneDurationKnown.size() &&
         subtuneDurationKnown[cacheIndex] != 0u &&
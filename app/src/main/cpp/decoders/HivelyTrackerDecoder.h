@@ -3,6 +3,8 @@
 
 #include "AudioDecoder.h"
 #include "../ChannelScopeSharedState.h"
+#include "../DurationAnalysisClient.h"
+#include "../FileSource.h"
 
 #include <atomic>
 #include <cstddef>
@@ -78,6 +80,7 @@ private:
     hvl_tune* tune = nullptr;
 
     std::string sourcePath;
+    std::shared_ptr<const FileSource> fileSource;
     std::string title;
     std::string artist;
     std::string composer;
@@ -106,6 +109,9 @@ private:
     std::vector<double> subtuneDurationSeconds;
     std::vector<uint8_t> subtuneDurationKnown;
     std::vector<uint8_t> subtuneDurationReliable;
+    std::vector<uint8_t> subtuneDurationRequested;
+    // Duration cache key of the open file; 0 when it could not be hashed.
+    uint64_t contentHash = 0;
     std::vector<std::string> toggleChannelNames;
     std::vector<bool> toggleChannelMuted;
     std::shared_ptr<ChannelScopeSharedState> channelScopeState;
@@ -116,7 +122,7 @@ private:
     int getFrameSamplesPerDecodeLocked() const;
     bool decodeFrameIntoPendingLocked();
     bool resetToSubtuneStartLocked();
-    bool analyzeSubtuneDurationLocked(int index);
+    bool refreshSubtuneDurationLocked(int index);
     void updateCurrentDurationFromCacheLocked();
     void syncToggleChannelsLocked();
     void applyMixGainLocked();
@@ -266,35 +266,28 @@ void KlystrackDecoder::captureChannelScopeSnapshotLocked() {
         return;
     }
 
-    std::vector<float> raw(static_cast<size_t>(totalChannels) * ChannelScopeSharedState::kMaxSamples, 0.0f);
-    const int capturedChannels = std::max(
-            0,
+    const ChannelScopeSharedState::PublishBuffer publishBuffer = channelScopeState->beginPublish(totalChannels);
+    const int capturedChannels = std::clamp(
             KSND_GetChannelScopeSamples(
                     player,
-                    raw.data(),
+                    publishBuffer.raw,
                     ChannelScopeSharedState::kMaxSamples,
                     totalChannels
-            )
+            ),
+            0,
+            totalChannels
     );
     if (capturedChannels <= 0) {
         return;
     }
-    raw.resize(static_cast<size_t>(capturedChannels) * ChannelScopeSharedState::kMaxSamples);
 
     int rawVu[64] = { 0 };
     KSND_GetVUMeters(player, rawVu, capturedChannels);
-    std::vector<float> vu(static_cast<size_t>(capturedChannels), 0.0f);
     for (int i = 0; i < capturedChannels; ++i) {
-        vu[static_cast<size_t>(i)] = std::clamp(rawVu[i] / 128.0f, 0.0f, 1.0f);
+        publishBuffer.vu[i] = std::clamp(rawVu[i] / 128.0f, 0.0f, 1.0f);
     }
 
-    {
-        std::lock_guard<std::mutex> scopeLock(channelScopeState->mutex);
-        channelScopeState->snapshotRaw = std::move(raw);
-        channelScopeState->snapshotVu = std::move(vu);
-        channelScopeState->snapshotChannels = capturedChannels;
-        channelScopeState->snapshotSerial = ++channelScopeSourceSerial;
-    }
+    channelScopeState->commitPublish(capturedChannels, ++channelScopeSourceSerial);
 }
 
 std::vector<int32_t> KlystrackDecoder::getChannelScopeTextState(int maxChannels) {
@@ -1,6 +1,5 @@
 #include "LibOpenMPTDecoder.h"
 #include <android/log.h>
-#include <fstream>
 #include <algorithm>
 #include <cctype>
 #include <cmath>
@@ -136,29 +135,15 @@ bool LibOpenMPTDecoder::open(const char* path) {
     std::lock_guard<std::mutex> lock(decodeMutex);
     close();
 
-    std::ifstream file(path, std::ios::binary | std::ios::ate);
-    if (!file.is_open()) {
-        LOGE("Failed to open file: %s", path);
-        return false;
-    }
-
-    std::streamsize size = file.tellg();
-    file.seekg(0, std::ios::beg);
-
-    if (size <= 0) {
-        LOGE("File is empty: %s", path);
+    fileSource = FileSource::open(path ? path : "");
+    if (!fileSource) {
+        LOGE("Failed to read file or file is empty: %s", path);
         return false;
     }
 
     try {
-        fileBuffer.resize(size);
-        if (!file.read(fileBuffer.data(), size)) {
-             LOGE("Failed to read file: %s", path);
-             return false;
-        }
-
-        // Create module from memory buffer
-        module = std::make_unique<openmpt::module_ext>(fileBuffer);
+        // Create module from the mapped file
+        module = std::make_unique<openmpt::module_ext>(fileSource->data(), fileSource->size());
         isAmigaModule = detectAmigaModule(path ? path : "", module.get());
         isXmModule = detectXmModule(path ? path : "", module.get());
         applyRenderSettingsLocked();
@@ -228,7 +213,7 @@ bool LibOpenMPTDecoder::open(const char* path) {
 void LibOpenMPTDecoder::close() {
     // lock should be held by caller or strictly sequential
     module.reset();
-    fileBuffer.clear();
+    fileSource.reset();
     duration = 0.0;
     moduleChannels = 0;
     isAmigaModule = false;
@@ -266,15 +251,9 @@ void LibOpenMPTDecoder::captureChannelScopeSnapshotLocked() {
     if (totalChannels <= 0) return;
 
     const int maxSamples = ChannelScopeSharedState::kMaxSamples;
-    const size_t flatSize = static_cast<size_t>(totalChannels) * maxSamples;
-
-    thread_local std::vector<float> scratchRaw;
-    thread_local std::vector<float> scratchVu;
-    scratchRaw.resize(flatSize);
-    scratchVu.resize(static_cast<size_t>(totalChannels));
-
+    const ChannelScopeSharedState::PublishBuffer publishBuffer = channelScopeState->beginPublish(totalChannels);
     for (int ch = 0; ch < totalChannels; ++ch) {
-        float* dest = scratchRaw.data() + static_cast<size_t>(ch) * maxSamples;
+        float* dest = publishBuffer.raw + static_cast<size_t>(ch) * maxSamples;
         const int written = static_cast<int>(
                 module->get_current_channel_scope(ch, dest, maxSamples));
         if (written < maxSamples && written > 0) {
@@ -282,25 +261,9 @@ void LibOpenMPTDecoder::captureChannelScopeSnapshotLocked() {
         } else if (written <= 0) {
             std::fill(dest, dest + maxSamples, 0.0f);
         }
-        scratchVu[static_cast<size_t>(ch)] =
-                std::clamp(module->get_current_channel_vu_mono(ch), 0.0f, 1.0f);
-    }
-
-    {
-        std::lock_guard<std::mutex> scopeLock(channelScopeState->mutex);
-        if (channelScopeState->snapshotRaw.size() != flatSize) {
-            channelScopeState->snapshotRaw.resize(flatSize);
-        }
-        std::copy(scratchRaw.begin(), scratchRaw.begin() + static_cast<ptrdiff_t>(flatSize),
-                  channelScopeState->snapshotRaw.begin());
-        if (channelScopeState->snapshotVu.size() != static_cast<size_t>(totalChannels)) {
-            channelScopeState->snapshotVu.resize(static_cast<size_t>(totalChannels));
-        }
-        std::copy(scratchVu.begin(), scratchVu.begin() + totalChannels,
-                  channelScopeState->snapshotVu.begin());
-        channelScopeState->snapshotChannels = totalChannels;
-        channelScopeState->snapshotSerial = channelScopeSourceSerial;
+        publishBuffer.vu[ch] = std::clamp(module->get_current_channel_vu_mono(ch), 0.0f, 1.0f);
     }
+    channelScopeState->commitPublish(totalChannels, channelScopeSourceSerial);
 }
 
 int LibOpenMPTDecoder::read(float* buffer, int numFrames) {
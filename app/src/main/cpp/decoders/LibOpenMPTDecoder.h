@@ -3,6 +3,7 @@
 
 #include "AudioDecoder.h"
 #include "../ChannelScopeSharedState.h"
+#include "../FileSource.h"
 #include <libopenmpt/libopenmpt.hpp>
 #include <libopenmpt/libopenmpt_ext.hpp>
 #include <memory>
@@ -81,8 +82,8 @@ private:
     std::unique_ptr<openmpt::module_ext> module;
     mutable std::mutex decodeMutex;
 
-    // Buffer to hold file data in memory
-    std::vector<char> fileBuffer;
+    // File contents, held for the module's lifetime
+    std::shared_ptr<const FileSource> fileSource;
 
     double duration = 0.0;
     int sampleRate = 48000; // Reported playback technical default
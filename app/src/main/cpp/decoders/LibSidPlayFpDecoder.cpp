@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <cstring>
 #include <sstream>
+#include <time.h>
 #include <vector>
 
 #include <sidplayfp/sidplayfp.h>
@@ -19,6 +20,7 @@
 #include <sidplayfp/builders/residfp.h>
 #include <sidplayfp/builders/sidlite.h>
 #include "sid/ReSidBuilder.h"
+#include "../ParallelWorkPool.h"
 
 #define LOG_TAG "LibSidPlayFpDecoder"
 #define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
@@ -41,6 +43,12 @@ constexpr float kSidVoiceScopeGain = 1.20f;
 constexpr float kSidDigiScopeGain = 6.05f;
 constexpr float kSidScopeDcFollow = 0.0025f;
 
+int64_t threadCpuTimeNs() {
+    timespec ts {};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000ll + ts.tv_nsec;
+}
+
 std::string safeString(const char* value) {
     return value ? std::string(value) : "";
 }
@@ -306,6 +314,7 @@ struct LibSidPlayFpDecoder::ScopeConfigSnapshot {
     bool reSidFpFastSampling = true;
     SidConfig::sid_cw_t combinedWaveformsStrength = SidConfig::AVERAGE;
     std::vector<bool> toggleChannelMuted;
+    int maxShadows = 0;
 };
 
 struct LibSidPlayFpDecoder::ScopeShadow {
@@ -317,6 +326,11 @@ struct LibSidPlayFpDecoder::ScopeShadow {
     float dcEstimate = 0.0f;
     int soloChannel = -1;
     int soloChip = 0;
+    // Written by whichever pool thread renders this shadow, read after run().
+    std::vector<float> output;
+    int producedFrames = 0;
+    int64_t cpuNs = 0;
+    int64_t renderedFrames = 0;
 };
 
 LibSidPlayFpDecoder::LibSidPlayFpDecoder()
@@ -430,6 +444,7 @@ LibSidPlayFpDecoder::ScopeConfigSnapshot LibSidPlayFpDecoder::captureScopeConfig
     snapshot.reSidFpFastSampling = reSidFpFastSampling;
     snapshot.combinedWaveformsStrength = reSidFpCombinedWaveformsStrength;
     snapshot.toggleChannelMuted = toggleChannelMuted;
+    snapshot.maxShadows = scopeMaxShadows;
     return snapshot;
 }
 
@@ -537,11 +552,7 @@ void LibSidPlayFpDecoder::closeScopeCaptureLocked() {
 }
 
 void LibSidPlayFpDecoder::resetChannelScopeLocked() {
-    scopeRingRaw.clear();
-    scopeFrameScratch.clear();
-    scopeRingChannels = 0;
-    scopeRingWritePos = 0;
-    scopeRingSamples = 0;
+    scopeRing.reset();
     channelScopeSourceSerial = 0;
     if (channelScopeState) {
         channelScopeState->clear();
@@ -554,100 +565,15 @@ void LibSidPlayFpDecoder::ensureScopeRingShapeLocked(int channelsToKeep) {
             0,
             kSidMaxToggleChipCount * kSidToggleChannelsPerChip
     );
-    if (clampedChannels <= 0) {
-        scopeRingRaw.clear();
-        scopeFrameScratch.clear();
-        scopeRingChannels = 0;
-        scopeRingWritePos = 0;
-        scopeRingSamples = 0;
-        return;
-    }
-
-    const size_t requiredSize =
-            static_cast<size_t>(clampedChannels) * ChannelScopeSharedState::kMaxSamples;
-    if (scopeRingChannels == clampedChannels && scopeRingRaw.size() == requiredSize) {
-        if (scopeFrameScratch.size() != static_cast<size_t>(clampedChannels)) {
-            scopeFrameScratch.assign(static_cast<size_t>(clampedChannels), 0.0f);
-        }
-        return;
-    }
-
-    scopeRingRaw.assign(requiredSize, 0.0f);
-    scopeFrameScratch.assign(static_cast<size_t>(clampedChannels), 0.0f);
-    scopeRingChannels = clampedChannels;
-    scopeRingWritePos = 0;
-    scopeRingSamples = 0;
-}
-
-void LibSidPlayFpDecoder::appendScopeFrameLocked(const float* perVoiceSamples, int channelsToWrite) {
-    if (!perVoiceSamples || channelsToWrite <= 0) {
-        return;
-    }
-    ensureScopeRingShapeLocked(channelsToWrite);
-    if (scopeRingChannels <= 0 || scopeRingRaw.empty()) {
-        return;
-    }
-
-    const int storedChannels = std::min(scopeRingChannels, channelsToWrite);
-    for (int channel = 0; channel < storedChannels; ++channel) {
-        scopeRingRaw[
-                static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples +
-                static_cast<size_t>(scopeRingWritePos)
-        ] = std::clamp(perVoiceSamples[channel], -1.0f, 1.0f);
-    }
-    for (int channel = storedChannels; channel < scopeRingChannels; ++channel) {
-        scopeRingRaw[
-                static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples +
-                static_cast<size_t>(scopeRingWritePos)
-        ] = 0.0f;
-    }
-    scopeRingWritePos = (scopeRingWritePos + 1) % ChannelScopeSharedState::kMaxSamples;
-    scopeRingSamples = std::min(scopeRingSamples + 1, ChannelScopeSharedState::kMaxSamples);
+    scopeRing.ensureChannels(clampedChannels);
 }
 
 void LibSidPlayFpDecoder::publishScopeSnapshotLocked() {
     if (!channelScopeState) {
         return;
     }
-    if (scopeRingChannels <= 0 || scopeRingRaw.empty() || scopeRingSamples <= 0) {
-        channelScopeState->clear();
-        return;
-    }
-
-    std::vector<float> raw(
-            static_cast<size_t>(scopeRingChannels) * ChannelScopeSharedState::kMaxSamples,
-            0.0f
-    );
-    std::vector<float> vu(static_cast<size_t>(scopeRingChannels), 0.0f);
-    const int filledSamples = std::clamp(scopeRingSamples, 0, ChannelScopeSharedState::kMaxSamples);
-    const int zeroPrefix = ChannelScopeSharedState::kMaxSamples - filledSamples;
     const int trailingSamples = std::clamp(activeSampleRate > 0 ? activeSampleRate / 50 : 64, 64, 1024);
-
-    for (int channel = 0; channel < scopeRingChannels; ++channel) {
-        float* dst = raw.data() + static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples;
-        for (int i = 0; i < filledSamples; ++i) {
-            const int ringIndex =
-                    (scopeRingWritePos - filledSamples + i + ChannelScopeSharedState::kMaxSamples) %
-                    ChannelScopeSharedState::kMaxSamples;
-            dst[zeroPrefix + i] = scopeRingRaw[
-                    static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples +
-                    static_cast<size_t>(ringIndex)
-            ];
-        }
-
-        float peak = 0.0f;
-        const int start = std::max(0, ChannelScopeSharedState::kMaxSamples - trailingSamples);
-        for (int i = start; i < ChannelScopeSharedState::kMaxSamples; ++i) {
-            peak = std::max(peak, std::abs(dst[i]));
-        }
-        vu[static_cast<size_t>(channel)] = std::clamp(peak, 0.0f, 1.0f);
-    }
-
-    std::lock_guard<std::mutex> scopeLock(channelScopeState->mutex);
-    channelScopeState->snapshotRaw = std::move(raw);
-    channelScopeState->snapshotVu = std::move(vu);
-    channelScopeState->snapshotChannels = scopeRingChannels;
-    channelScopeState->snapshotSerial = ++channelScopeSourceSerial;
+    scopeRing.publish(*channelScopeState, ++channelScopeSourceSerial, trailingSamples);
 }
 
 void LibSidPlayFpDecoder::applyToggleChannelMutesToScopeShadowLocked(
@@ -691,9 +617,30 @@ bool LibSidPlayFpDecoder::recreateScopeCaptureLocked(const ScopeConfigSnapshot&
     const int chipCount = std::clamp(snapshot.chipCount, 1, kSidMaxToggleChipCount);
     const int totalChannels = sidScopeChannelCount(chipCount);
     ensureScopeRingShapeLocked(totalChannels);
-    scopeVoiceShadows.reserve(static_cast<size_t>(totalChannels));
+    scopeVoiceShadows.resize(static_cast<size_t>(totalChannels));
+
+    // A shadow solos its voice with the user mutes applied, so muted voices
+    // would only render silence; they get none. The rest are capped by
+    // sidplayfp.scope_max_shadows in voice order. Keep at least one shadow so
+    // the scope clock still advances.
+    std::vector<int> shadowChannels;
+    shadowChannels.reserve(static_cast<size_t>(totalChannels));
+    for (int channel = 0; channel < totalChannels; ++channel) {
+        const bool muted =
+                channel < static_cast<int>(snapshot.toggleChannelMuted.size()) &&
+                snapshot.toggleChannelMuted[static_cast<size_t>(channel)];
+        if (!muted) {
+            shadowChannels.push_back(channel);
+        }
+    }
+    if (shadowChannels.empty()) {
+        shadowChannels.push_back(0);
+    }
+    if (snapshot.maxShadows > 0 && static_cast<int>(shadowChannels.size()) > snapshot.maxShadows) {
+        shadowChannels.resize(static_cast<size_t>(snapshot.maxShadows));
+    }
 
-    for (int shadowIndex = 0; shadowIndex < totalChannels; ++shadowIndex) {
+    for (const int shadowIndex : shadowChannels) {
         auto shadow = std::make_unique<ScopeShadow>();
         shadow->soloChannel = shadowIndex;
         shadow->soloChip = shadowIndex / kSidToggleChannelsPerChip;
@@ -739,86 +686,142 @@ bool LibSidPlayFpDecoder::recreateScopeCaptureLocked(const ScopeConfigSnapshot&
         );
         applyToggleChannelMutesToScopeShadowLocked(snapshot, *shadow, shadow->soloChannel);
         shadow->dcEstimate = 0.0f;
-        scopeVoiceShadows.push_back(std::move(shadow));
+        scopeVoiceShadows[static_cast<size_t>(shadowIndex)] = std::move(shadow);
     }
 
+    ensureScopeShadowPoolLocked();
     scopeCaptureDirty = false;
     return !scopeVoiceShadows.empty();
 }
 
+void LibSidPlayFpDecoder::ensureScopeShadowPoolLocked() {
+    const int activeShadows = static_cast<int>(std::count_if(
+            scopeVoiceShadows.begin(),
+            scopeVoiceShadows.end(),
+            [](const std::unique_ptr<ScopeShadow>& shadow) { return shadow && shadow->player; }
+    ));
+    const int participants = std::clamp(
+            std::min(ParallelWorkPool::performanceCoreCount(), activeShadows),
+            1,
+            kSidMaxToggleChipCount * kSidToggleChannelsPerChip
+    );
+    if (participants <= 1) {
+        scopeShadowPool.reset();
+        return;
+    }
+    if (scopeShadowPool && scopeShadowPool->concurrency() == participants) {
+        return;
+    }
+    scopeShadowPool = std::make_unique<ParallelWorkPool>(participants - 1);
+}
+
 bool LibSidPlayFpDecoder::captureChannelScopeBlockLocked(unsigned int renderCycles) {
     if (scopeVoiceShadows.empty()) {
         return false;
     }
 
     const int totalChannels = std::min(
-            scopeRingChannels,
+            scopeRing.channels(),
             static_cast<int>(scopeVoiceShadows.size())
     );
     ensureScopeRingShapeLocked(totalChannels);
-    if (scopeFrameScratch.size() < static_cast<size_t>(totalChannels)) {
-        scopeFrameScratch.assign(static_cast<size_t>(totalChannels), 0.0f);
-    }
 
-    std::vector<int> producedFrames(static_cast<size_t>(totalChannels), 0);
-    int maxProducedFrames = 0;
-    for (int channel = 0; channel < totalChannels; ++channel) {
-        auto& shadow = scopeVoiceShadows[static_cast<size_t>(channel)];
+    // Shadows are independent emulators: advance them in parallel, each into
+    // its own buffer, and merge into the ring once all of them are done.
+    const auto renderShadow = [this, renderCycles](int channel) {
+        ScopeShadow* shadow = scopeVoiceShadows[static_cast<size_t>(channel)].get();
         if (!shadow || !shadow->player) {
-            continue;
+            return;
         }
+        const int64_t cpuStartNs = threadCpuTimeNs();
+        shadow->producedFrames = 0;
         const int produced = shadow->player->play(renderCycles);
-        if (produced <= 0) {
-            continue;
+        if (produced > 0) {
+            shadow->chipBuffers.fill(nullptr);
+            shadow->player->buffers(shadow->chipBuffers.data());
+            const short* chipBuffer =
+                    (shadow->soloChip >= 0 && shadow->soloChip < kSidMaxToggleChipCount)
+                    ? shadow->chipBuffers[static_cast<size_t>(shadow->soloChip)]
+                    : nullptr;
+            if (chipBuffer) {
+                if (shadow->output.size() < static_cast<size_t>(produced)) {
+                    shadow->output.resize(static_cast<size_t>(produced));
+                }
+                const float gain =
+                        ((channel % kSidToggleChannelsPerChip) == (kSidToggleChannelsPerChip - 1))
+                        ? kSidDigiScopeGain
+                        : kSidVoiceScopeGain;
+                for (int frame = 0; frame < produced; ++frame) {
+                    shadow->output[static_cast<size_t>(frame)] =
+                            applySidScopeDcBlock(chipBuffer[frame], shadow->dcEstimate, gain);
+                }
+                shadow->producedFrames = produced;
+            }
         }
-        shadow->chipBuffers.fill(nullptr);
-        shadow->player->buffers(shadow->chipBuffers.data());
-        const short* chipBuffer =
-                (shadow->soloChip >= 0 && shadow->soloChip < kSidMaxToggleChipCount)
-                ? shadow->chipBuffers[static_cast<size_t>(shadow->soloChip)]
-                : nullptr;
-        if (!chipBuffer) {
-            continue;
+        shadow->cpuNs += threadCpuTimeNs() - cpuStartNs;
+        shadow->renderedFrames += shadow->producedFrames;
+    };
+    if (scopeShadowPool) {
+        scopeShadowPool->run(totalChannels, renderShadow);
+    } else {
+        for (int channel = 0; channel < totalChannels; ++channel) {
+            renderShadow(channel);
         }
-        producedFrames[static_cast<size_t>(channel)] = produced;
-        maxProducedFrames = std::max(maxProducedFrames, produced);
     }
 
+    int maxProducedFrames = 0;
+    for (int channel = 0; channel < totalChannels; ++channel) {
+        const auto& shadow = scopeVoiceShadows[static_cast<size_t>(channel)];
+        if (shadow) {
+            maxProducedFrames = std::max(maxProducedFrames, shadow->producedFrames);
+        }
+    }
     if (maxProducedFrames <= 0) {
         return false;
     }
 
-    for (int frame = 0; frame < maxProducedFrames; ++frame) {
-        std::fill(scopeFrameScratch.begin(), scopeFrameScratch.end(), 0.0f);
-        for (int channel = 0; channel < totalChannels; ++channel) {
-            auto& shadow = scopeVoiceShadows[static_cast<size_t>(channel)];
-            if (!shadow || frame >= producedFrames[static_cast<size_t>(channel)]) {
-                continue;
-            }
-            const short* chipBuffer =
-                    (shadow->soloChip >= 0 && shadow->soloChip < kSidMaxToggleChipCount)
-                    ? shadow->chipBuffers[static_cast<size_t>(shadow->soloChip)]
-                    : nullptr;
-            if (!chipBuffer) {
-                continue;
-            }
-            const float gain =
-                    ((channel % kSidToggleChannelsPerChip) == (kSidToggleChannelsPerChip - 1))
-                    ? kSidDigiScopeGain
-                    : kSidVoiceScopeGain;
-            scopeFrameScratch[static_cast<size_t>(channel)] = applySidScopeDcBlock(
-                    chipBuffer[frame],
-                    shadow->dcEstimate,
-                    gain
-            );
+    const size_t blockSize = static_cast<size_t>(totalChannels) * static_cast<size_t>(maxProducedFrames);
+    if (scopeBlockScratch.size() < blockSize) {
+        scopeBlockScratch.resize(blockSize);
+    }
+    for (int channel = 0; channel < totalChannels; ++channel) {
+        const auto& shadow = scopeVoiceShadows[static_cast<size_t>(channel)];
+        float* dst = scopeBlockScratch.data() + static_cast<size_t>(channel) * static_cast<size_t>(maxProducedFrames);
+        const int frames = shadow ? shadow->producedFrames : 0;
+        if (frames > 0) {
+            std::memcpy(dst, shadow->output.data(), static_cast<size_t>(frames) * sizeof(float));
         }
-        appendScopeFrameLocked(scopeFrameScratch.data(), totalChannels);
+        std::fill(dst + frames, dst + maxProducedFrames, 0.0f);
     }
+    scopeRing.appendBlock(scopeBlockScratch.data(), static_cast<size_t>(maxProducedFrames), maxProducedFrames);
 
     publishScopeSnapshotLocked();
     return true;
 }
 
+void LibSidPlayFpDecoder::publishScopeShadowStatsLocked(
+        int sampleRate,
+        double catchUpWallMs,
+        uint32_t catchUpLagMs
+) {
+    std::lock_guard<std::mutex> statsLock(scopeWorkerMutex);
+    scopeShadowCpuMsPerSecond.assign(scopeVoiceShadows.size(), 0.0f);
+    for (size_t channel = 0; channel < scopeVoiceShadows.size(); ++channel) {
+        const auto& shadow = scopeVoiceShadows[channel];
+        if (!shadow || shadow->renderedFrames <= 0 || sampleRate <= 0) {
+            continue;
+        }
+        const double audioSeconds = static_cast<double>(shadow->renderedFrames) / sampleRate;
+        scopeShadowCpuMsPerSecond[channel] =
+                static_cast<float>((static_cast<double>(shadow->cpuNs) / 1e6) / audioSeconds);
+    }
+    scopeCatchUpStats = {
+            static_cast<float>(catchUpWallMs),
+            static_cast<float>(catchUpLagMs),
+            static_cast<float>(scopeShadowPool ? scopeShadowPool->concurrency() : 1)
+    };
+}
+
 uint32_t LibSidPlayFpDecoder::getScopePlaybackPositionMsLocked() const {
     for (const auto& shadow : scopeVoiceShadows) {
         if (shadow && shadow->player) {
@@ -830,6 +833,11 @@ uint32_t LibSidPlayFpDecoder::getScopePlaybackPositionMsLocked() const {
 
 void LibSidPlayFpDecoder::scopeWorkerLoop() {
     uint64_t appliedGeneration = 0;
+    bool catchingUp = false;
+    uint32_t catchUpLagMs = 0;
+    std::chrono::steady_clock::time_point catchUpStart;
+    double lastCatchUpWallMs = 0.0;
+    uint32_t lastCatchUpLagMs = 0;
 
     while (!scopeWorkerStop.load(std::memory_order_relaxed)) {
         ScopeConfigSnapshot snapshot;
@@ -843,7 +851,7 @@ void LibSidPlayFpDecoder::scopeWorkerLoop() {
         }
 
         if (!snapshot.valid) {
-            if (!scopeVoiceShadows.empty() || scopeRingSamples > 0) {
+            if (!scopeVoiceShadows.empty() || scopeRing.filledSamples() > 0) {
                 closeScopeCaptureLocked();
                 resetChannelScopeLocked();
             }
@@ -871,6 +879,11 @@ void LibSidPlayFpDecoder::scopeWorkerLoop() {
         }
 
         const uint32_t lagMs = targetMs > shadowMs ? (targetMs - shadowMs) : 0u;
+        if (!catchingUp && lagMs > 1000u) {
+            catchingUp = true;
+            catchUpLagMs = lagMs;
+            catchUpStart = std::chrono::steady_clock::now();
+        }
         int maxBlocks = 0;
         int blockFrames = 1024;
         if (lagMs > 20000u) {
@@ -903,6 +916,41 @@ void LibSidPlayFpDecoder::scopeWorkerLoop() {
             advanced = true;
         }
 
+        if (catchingUp && getScopePlaybackPositionMsLocked() + 200u >= targetMs) {
+            catchingUp = false;
+            lastCatchUpLagMs = catchUpLagMs;
+            lastCatchUpWallMs = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - catchUpStart
+            ).count();
+            float maxCpuMs = 0.0f;
+            float sumCpuMs = 0.0f;
+            int shadowCount = 0;
+            for (const auto& shadow : scopeVoiceShadows) {
+                if (!shadow || shadow->renderedFrames <= 0 || snapshot.sampleRate <= 0) {
+                    continue;
+                }
+                const float cpuMs = static_cast<float>(
+                        (static_cast<double>(shadow->cpuNs) / 1e6) /
+                        (static_cast<double>(shadow->renderedFrames) / snapshot.sampleRate)
+                );
+                maxCpuMs = std::max(maxCpuMs, cpuMs);
+                sumCpuMs += cpuMs;
+                shadowCount += 1;
+            }
+            LOGD(
+                    "Scope catch-up of %u ms took %.1f ms on %d thread(s); %d shadow(s), cpu per audio second avg %.2f ms max %.2f ms",
+                    lastCatchUpLagMs,
+                    lastCatchUpWallMs,
+                    scopeShadowPool ? scopeShadowPool->concurrency() : 1,
+                    shadowCount,
+                    shadowCount > 0 ? sumCpuMs / shadowCount : 0.0f,
+                    maxCpuMs
+            );
+        }
+        if (advanced) {
+            publishScopeShadowStatsLocked(snapshot.sampleRate, lastCatchUpWallMs, lastCatchUpLagMs);
+        }
+
         std::unique_lock<std::mutex> waitLock(scopeWorkerMutex);
         scopeWorkerCv.wait_for(
                 waitLock,
@@ -912,6 +960,7 @@ void LibSidPlayFpDecoder::scopeWorkerLoop() {
 
     closeScopeCaptureLocked();
     resetChannelScopeLocked();
+    scopeShadowPool.reset();
 }
 
 void LibSidPlayFpDecoder::refreshMetadataLocked() {
@@ -1469,6 +1518,15 @@ void LibSidPlayFpDecoder::setOption(const char* name, const char* value) {
         }
         return;
     }
+    if (optionName == "sidplayfp.scope_max_shadows") {
+        const int parsed = parseIntString(optionValue, scopeMaxShadows);
+        const int clamped = std::clamp(parsed, 0, kSidMaxToggleChipCount * kSidToggleChannelsPerChip);
+        if (clamped != scopeMaxShadows) {
+            scopeMaxShadows = clamped;
+            markScopeConfigDirtyLocked(false);
+        }
+        return;
+    }
     if (optionName == "sidplayfp.unknown_duration_seconds") {
         const int parsed = parseIntString(optionValue, static_cast<int>(fallbackDurationSeconds));
         const int clamped = std::clamp(parsed, 1, 86400);
@@ -1526,6 +1584,9 @@ int LibSidPlayFpDecoder::getOptionApplyPolicy(const char* name) const {
     if (optionName == "sidplayfp.residfp_combined_waveforms_strength") {
         return OPTION_APPLY_LIVE;
     }
+    if (optionName == "sidplayfp.scope_max_shadows") {
+        return OPTION_APPLY_LIVE;
+    }
     if (optionName == "sidplayfp.unknown_duration_seconds") {
         return OPTION_APPLY_LIVE;
     }
@@ -1709,6 +1770,16 @@ int LibSidPlayFpDecoder::getCoreIntInfo(const char* name, int fallback) {
     return fallback;
 }
 
+std::vector<float> LibSidPlayFpDecoder::getCoreFloatVectorInfo(const char* name) {
+    if (name == nullptr) return {};
+    std::lock_guard<std::mutex> statsLock(scopeWorkerMutex);
+    // CPU milliseconds each voice's scope shadow costs per second of audio.
+    if (std::strcmp(name, "scopeShadowCpuMsPerSecond") == 0) return scopeShadowCpuMsPerSecond;
+    // { wall ms, lag ms } of the last scope catch-up, then pool threads.
+    if (std::strcmp(name, "scopeCatchUpStats") == 0) return scopeCatchUpStats;
+    return {};
+}
+
 void LibSidPlayFpDecoder::setRepeatMode(int mode) {
     const int normalizedMode = (mode >= 0 && mode <= 3) ? mode : 0;
     repeatMode.store(normalizedMode);
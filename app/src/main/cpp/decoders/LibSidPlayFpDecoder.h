@@ -17,6 +17,7 @@ class sidplayfp;
 class SidTune;
 class SidConfig;
 class sidbuilder;
+class ParallelWorkPool;
 
 enum class SidBackend {
     ReSID,
@@ -86,6 +87,7 @@ public:
     std::shared_ptr<ChannelScopeSharedState> getChannelScopeSharedState() const override { return channelScopeState; }
     std::string getCoreStringInfo(const char* name) override;
     int getCoreIntInfo(const char* name, int fallback = 0) override;
+    std::vector<float> getCoreFloatVectorInfo(const char* name) override;
 
     const char* getName() const override { return "LibSIDPlayFP"; }
     static std::vector<std::string> getSupportedExtensions();
@@ -134,11 +136,7 @@ private:
     std::vector<std::unique_ptr<ScopeShadow>> scopeVoiceShadows;
     bool scopeCaptureEnabled = false;
     bool scopeCaptureDirty = false;
-    std::vector<float> scopeRingRaw;
-    std::vector<float> scopeFrameScratch;
-    int scopeRingChannels = 0;
-    int scopeRingWritePos = 0;
-    int scopeRingSamples = 0;
+    ChannelScopeRing scopeRing;
     uint64_t channelScopeSourceSerial = 0;
     std::mutex scopeWorkerMutex;
     std::condition_variable scopeWorkerCv;
@@ -146,6 +144,13 @@ private:
     std::atomic<bool> scopeWorkerStop { false };
     std::atomic<uint32_t> scopeTargetPositionMs { 0 };
     uint64_t scopeConfigGeneration = 1;
+    int scopeMaxShadows = 0; // 0 = one shadow per voice
+    // Owned by the scope worker thread.
+    std::unique_ptr<ParallelWorkPool> scopeShadowPool;
+    std::vector<float> scopeBlockScratch;
+    // Shadow render stats, published by the scope worker under scopeWorkerMutex.
+    std::vector<float> scopeShadowCpuMsPerSecond;
+    std::vector<float> scopeCatchUpStats;
     std::atomic<double> playbackPositionSecondsAtomic { 0.0 };
     std::atomic<double> currentSubtuneDurationSecondsAtomic { 180.0 };
     std::atomic<bool> durationReliableAtomic { false };
@@ -175,9 +180,10 @@ private:
     void closeScopeCaptureLocked();
     void resetChannelScopeLocked();
     void ensureScopeRingShapeLocked(int channelsToKeep);
-    void appendScopeFrameLocked(const float* perVoiceSamples, int channelsToWrite);
     void publishScopeSnapshotLocked();
+    void ensureScopeShadowPoolLocked();
     bool captureChannelScopeBlockLocked(unsigned int renderCycles);
+    void publishScopeShadowStatsLocked(int sampleRate, double catchUpWallMs, uint32_t catchUpLagMs);
     uint32_t getScopePlaybackPositionMsLocked() const;
     void applyToggleChannelMutesToScopeShadowLocked(
             const ScopeConfigSnapshot& snapshot,
@@ -33,7 +33,7 @@ constexpr int kSc68ScopeMaxChannels = static_cast<int>(SC68_SCOPE_MAX_CHANNELS);
 constexpr int kChannelScopeTextFlagActive = 1 << 0;
 constexpr int kChannelScopeTextFlagAmigaLeft = 1 << 1;
 constexpr int kChannelScopeTextFlagAmigaRight = 1 << 2;
-constexpr float kSc68ShadowScopeGain = 0.9f;
+constexpr float kSc68TapScopeGain = 0.9f;
 constexpr float kSc68YmScopeGain = 0.9f;
 constexpr float kSc68SteScopeGain = 0.65f;
 constexpr float kSc68PaulaScopeGain = 0.8f;
@@ -434,7 +434,7 @@ bool Sc68Decoder::open(const char* path) {
     refreshDurationLocked();
     rebuildToggleChannelsLocked();
     applyToggleChannelMutesLocked();
-    refreshScopeCaptureStateLocked(0);
+    refreshScopeCaptureStateLocked();
     return true;
 }
 
@@ -443,19 +443,8 @@ void Sc68Decoder::close() {
     closeInternalLocked();
 }
 
-void Sc68Decoder::closeScopeAudioShadowsLocked() {
-    for (auto& shadow : scopeAudioShadows) {
-        if (shadow.handle) {
-            sc68_close(shadow.handle);
-            sc68_destroy(shadow.handle);
-            shadow.handle = nullptr;
-        }
-    }
-    scopeAudioShadows.clear();
-}
-
 void Sc68Decoder::closeInternalLocked() {
-    closeScopeAudioShadowsLocked();
+    voiceTapsInstalled = false;
     if (handle) {
         sc68_close(handle);
         sc68_destroy(handle);
@@ -496,162 +485,40 @@ void Sc68Decoder::closeInternalLocked() {
     resetChannelScopeLocked();
 }
 
-bool Sc68Decoder::createScopeAudioShadowLocked(ScopeAudioShadow& shadow, int positionMs) {
-    if (sourcePath.empty()) {
-        return false;
-    }
-
-    sc68_create_t create{};
-    create.sampling_rate = static_cast<unsigned>(
-            requestedSampleRateHz > 0 ? requestedSampleRateHz : kDefaultSampleRateHz
-    );
-    shadow.handle = sc68_create(&create);
-    if (!shadow.handle) {
-        return false;
-    }
-
-    sc68_cntl(shadow.handle, SC68_SET_PCM, SC68_PCM_S16);
-    sc68_cntl(
-            shadow.handle,
-            SC68_SET_SPR,
-            requestedSampleRateHz > 0 ? requestedSampleRateHz : kDefaultSampleRateHz
-    );
-    applyCoreOptionsToHandleLocked(shadow.handle);
-
-    if (sc68_load_uri(shadow.handle, sourcePath.c_str()) != 0 ||
-        sc68_play(shadow.handle, currentTrack1Based, SC68_INF_LOOP) != 0) {
-        sc68_close(shadow.handle);
-        sc68_destroy(shadow.handle);
-        shadow.handle = nullptr;
-        return false;
-    }
-
-    sc68_cntl(shadow.handle, SC68_SET_OPT_INT, "ym-chans", shadow.ymMask);
-    sc68_cntl(shadow.handle, SC68_SET_OPT_INT, "ste-enable", shadow.steEnable);
-    if (positionMs > 0 && !fastForwardScopeHandleLocked(shadow.handle, positionMs)) {
-        sc68_close(shadow.handle);
-        sc68_destroy(shadow.handle);
-        shadow.handle = nullptr;
-        return false;
-    }
-    return true;
-}
-
-int Sc68Decoder::processScopeHandleChunkLocked(sc68_t* target, int16_t* pcm, int requestedFrames) {
-    if (!target || !pcm || requestedFrames <= 0) {
-        return 0;
-    }
-
-    for (int retry = 0; retry < 4; ++retry) {
-        int producedFrames = requestedFrames;
-        const int status = sc68_process(target, pcm, &producedFrames);
-        if (status == SC68_ERROR) {
-            return -1;
-        }
-        if (producedFrames > 0) {
-            return producedFrames;
-        }
-    }
-
-    return 0;
-}
-
-bool Sc68Decoder::fastForwardScopeHandleLocked(sc68_t* target, int positionMs) {
-    if (!target || positionMs <= 0) {
-        return true;
-    }
-
-    const int effectiveSampleRate =
-            sampleRateHz > 0
-                    ? sampleRateHz
-                    : (requestedSampleRateHz > 0 ? requestedSampleRateHz : kDefaultSampleRateHz);
-    int64_t framesToSkip =
-            static_cast<int64_t>(std::llround(
-                    (static_cast<double>(positionMs) / 1000.0) * static_cast<double>(effectiveSampleRate)
-            ));
-    if (framesToSkip <= 0) {
-        return true;
-    }
-
-    std::vector<int16_t> discard(static_cast<size_t>(kSeekDiscardChunkFrames) * 2u);
-    while (framesToSkip > 0) {
-        int chunk = static_cast<int>(std::min<int64_t>(kSeekDiscardChunkFrames, framesToSkip));
-        const int producedFrames = processScopeHandleChunkLocked(target, discard.data(), chunk);
-        if (producedFrames <= 0) {
-            return false;
-        }
-        framesToSkip -= producedFrames;
-    }
-    return true;
-}
-
-void Sc68Decoder::refreshScopeAudioShadowsLocked(int positionMs) {
-    closeScopeAudioShadowsLocked();
-
-    if (!handle || sourcePath.empty() || trackUsesAgaPath || trackHasAmiga) {
-        return;
-    }
-
-    std::vector<ScopeAudioShadow> shadows;
-    if (trackHasYm) {
-        for (int voice = 0; voice < 3; ++voice) {
-            ScopeAudioShadow shadow;
-            shadow.ymMask = 1 << voice;
-            shadow.steEnable = 0;
-            shadows.push_back(shadow);
+void Sc68Decoder::refreshScopeCaptureStateLocked() {
+    if (!scopeCaptureEnabled) {
+        if (handle && voiceTapsInstalled) {
+            sc68_cntl(handle, SC68_SET_VOICE_TAPS, nullptr);
         }
-    }
-    if (trackHasSte) {
-        ScopeAudioShadow shadow;
-        shadow.ymMask = 0;
-        shadow.steEnable = 1;
-        shadows.push_back(shadow);
-    }
-    if (shadows.empty()) {
+        voiceTapsInstalled = false;
+        voiceTapScratch.clear();
+        voiceTapScratch.shrink_to_fit();
+        resetChannelScopeLocked();
         return;
     }
-
-    const int seekPositionMs = positionMs >= 0
-            ? positionMs
-            : std::max(
-                    0,
-                    lastCorePositionMs >= 0
-                            ? lastCorePositionMs
-                            : static_cast<int>(std::llround(playbackPositionSeconds * 1000.0))
-            );
-    for (auto& shadow : shadows) {
-        if (!createScopeAudioShadowLocked(shadow, seekPositionMs)) {
-            for (auto& created : shadows) {
-                if (created.handle) {
-                    sc68_close(created.handle);
-                    sc68_destroy(created.handle);
-                    created.handle = nullptr;
-                }
-            }
-            return;
-        }
+    if (handle && !voiceTapsInstalled) {
+        voiceTaps = sc68_voice_taps_t {};
+        voiceTapsInstalled = sc68_cntl(handle, SC68_SET_VOICE_TAPS, &voiceTaps) == 0;
     }
-
-    scopeAudioShadows = std::move(shadows);
-    applyToggleChannelMutesLocked();
 }
 
-void Sc68Decoder::refreshScopeCaptureStateLocked(int positionMs) {
-    if (!scopeCaptureEnabled) {
-        closeScopeAudioShadowsLocked();
-        resetChannelScopeLocked();
-        return;
+void Sc68Decoder::prepareVoiceTapsLocked(int frames) {
+    const size_t planeSize = static_cast<size_t>(std::max(frames, 0));
+    if (voiceTapScratch.size() < planeSize * kSc68ScopeMaxChannels) {
+        voiceTapScratch.resize(planeSize * kSc68ScopeMaxChannels);
     }
-    refreshScopeAudioShadowsLocked(positionMs);
+    for (int channel = 0; channel < kSc68ScopeMaxChannels; ++channel) {
+        voiceTaps.planes[channel] = voiceTapScratch.data() + static_cast<size_t>(channel) * planeSize;
+    }
+    voiceTaps.capacity = frames;
+    voiceTaps.channels = 0;
+    voiceTaps.frames = 0;
 }
 
 void Sc68Decoder::resetChannelScopeLocked() {
-    scopeRingRaw.clear();
+    scopeRing.reset();
     scopeChannelVolumes.clear();
     scopeChannelFlags.clear();
-    scopeRingChannels = 0;
-    scopeRingWritePos = 0;
-    scopeRingSamples = 0;
     channelScopeSourceSerial = 0;
     if (channelScopeState) {
         channelScopeState->clear();
@@ -664,20 +531,12 @@ void Sc68Decoder::ensureScopeRingShapeLocked(int channels) {
         resetChannelScopeLocked();
         return;
     }
-    if (scopeRingChannels == clampedChannels &&
-        scopeRingRaw.size() == static_cast<size_t>(clampedChannels * ChannelScopeSharedState::kMaxSamples)) {
+    if (!scopeRing.ensureChannels(clampedChannels)) {
         return;
     }
 
-    scopeRingChannels = clampedChannels;
-    scopeRingRaw.assign(
-            static_cast<size_t>(clampedChannels * ChannelScopeSharedState::kMaxSamples),
-            0.0f
-    );
     scopeChannelVolumes.assign(static_cast<size_t>(clampedChannels), 0);
     scopeChannelFlags.assign(static_cast<size_t>(clampedChannels), 0);
-    scopeRingWritePos = 0;
-    scopeRingSamples = 0;
     channelScopeSourceSerial = 0;
     if (channelScopeState) {
         channelScopeState->clear();
@@ -689,75 +548,21 @@ void Sc68Decoder::appendScopeFrameLocked(const float* perChannelSamples, int cha
         return;
     }
     ensureScopeRingShapeLocked(channels);
-    if (scopeRingChannels <= 0 || scopeRingRaw.empty()) {
-        return;
-    }
-
-    for (int channel = 0; channel < scopeRingChannels; ++channel) {
-        const size_t index =
-                static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples +
-                static_cast<size_t>(scopeRingWritePos);
-        scopeRingRaw[index] = perChannelSamples[channel];
-    }
-    scopeRingWritePos = (scopeRingWritePos + 1) % ChannelScopeSharedState::kMaxSamples;
-    scopeRingSamples = std::min(scopeRingSamples + 1, ChannelScopeSharedState::kMaxSamples);
+    scopeRing.appendFrame(perChannelSamples, channels);
 }
 
 void Sc68Decoder::publishScopeSnapshotLocked() {
     if (!channelScopeState) {
         return;
     }
-    if (scopeRingChannels <= 0 || scopeRingRaw.empty() || scopeRingSamples <= 0) {
-        channelScopeState->clear();
-        return;
-    }
-
-    std::vector<float> raw(
-            static_cast<size_t>(scopeRingChannels * ChannelScopeSharedState::kMaxSamples),
-            0.0f
-    );
-    const int filledSamples = std::clamp(scopeRingSamples, 0, ChannelScopeSharedState::kMaxSamples);
-    const int zeroPrefix = ChannelScopeSharedState::kMaxSamples - filledSamples;
-    for (int channel = 0; channel < scopeRingChannels; ++channel) {
-        float* destination =
-                raw.data() + static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples;
-        for (int i = 0; i < filledSamples; ++i) {
-            const int sourceIndex =
-                    (scopeRingWritePos - filledSamples + i + ChannelScopeSharedState::kMaxSamples) %
-                    ChannelScopeSharedState::kMaxSamples;
-            destination[zeroPrefix + i] =
-                    scopeRingRaw[
-                            static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples +
-                            static_cast<size_t>(sourceIndex)
-                    ];
-        }
-    }
-
     const int trailingSamples = std::clamp(sampleRateHz > 0 ? sampleRateHz / 50 : 64, 64, 1024);
-    std::vector<float> vu(static_cast<size_t>(scopeRingChannels), 0.0f);
-    for (int channel = 0; channel < scopeRingChannels; ++channel) {
-        const size_t base = static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples;
-        const int start = std::max(0, ChannelScopeSharedState::kMaxSamples - trailingSamples);
-        float peak = 0.0f;
-        for (int sample = start; sample < ChannelScopeSharedState::kMaxSamples; ++sample) {
-            peak = std::max(peak, std::abs(raw[base + static_cast<size_t>(sample)]));
-        }
-        vu[static_cast<size_t>(channel)] = std::clamp(peak, 0.0f, 1.0f);
-    }
-
-    {
-        std::lock_guard<std::mutex> scopeLock(channelScopeState->mutex);
-        channelScopeState->snapshotRaw = std::move(raw);
-        channelScopeState->snapshotVu = std::move(vu);
-        channelScopeState->snapshotChannels = scopeRingChannels;
-        channelScopeState->snapshotSerial = ++channelScopeSourceSerial;
-    }
+    scopeRing.publish(*channelScopeState, ++channelScopeSourceSerial, trailingSamples);
 }
 
 void Sc68Decoder::updateScopeTextStateLocked(const sc68_scope_snapshot_t& snapshot) {
     const int channels = std::min(
             static_cast<int>(snapshot.channel_count),
-            std::max(0, scopeRingChannels)
+            scopeRing.channels()
     );
     if (channels <= 0) {
         return;
@@ -794,89 +599,61 @@ void Sc68Decoder::captureChannelScopeBlockLocked(const sc68_scope_snapshot_t& sn
         working.output_hz = static_cast<uint32_t>(sampleRateHz > 0 ? sampleRateHz : kDefaultSampleRateHz);
     }
 
-    std::vector<float> frame(static_cast<size_t>(channels), 0.0f);
+    scopeFrameScratch.resize(static_cast<size_t>(channels));
+    float* frame = scopeFrameScratch.data();
     for (int sample = 0; sample < frames; ++sample) {
         for (int channel = 0; channel < channels; ++channel) {
             auto& source = working.channels[channel];
             switch (source.kind) {
                 case SC68_SCOPE_CHANNEL_YM:
-                    frame[static_cast<size_t>(channel)] =
-                            synthesizeYmScopeSample(source, working.output_hz);
+                    frame[channel] = synthesizeYmScopeSample(source, working.output_hz);
                     break;
                 case SC68_SCOPE_CHANNEL_STE:
-                    frame[static_cast<size_t>(channel)] =
-                            synthesizeSteScopeSample(source);
+                    frame[channel] = synthesizeSteScopeSample(source);
                     break;
                 case SC68_SCOPE_CHANNEL_PAULA:
-                    frame[static_cast<size_t>(channel)] =
-                            synthesizePaulaScopeSample(source);
+                    frame[channel] = synthesizePaulaScopeSample(source);
                     break;
                 default:
-                    frame[static_cast<size_t>(channel)] = 0.0f;
+                    frame[channel] = 0.0f;
                     break;
             }
         }
-        appendScopeFrameLocked(frame.data(), channels);
+        appendScopeFrameLocked(frame, channels);
     }
 }
 
-bool Sc68Decoder::captureChannelScopeFromShadowsLocked(int frames) {
-    if (frames <= 0 || scopeAudioShadows.empty()) {
+bool Sc68Decoder::captureChannelScopeFromTapsLocked(int frames) {
+    const int channels = std::min(voiceTaps.channels, kSc68ScopeMaxChannels);
+    if (!voiceTapsInstalled || frames <= 0 || channels <= 0 || voiceTaps.frames < frames) {
         return false;
     }
 
-    const int channels = static_cast<int>(scopeAudioShadows.size());
     ensureScopeRingShapeLocked(channels);
-    if (scopeRingChannels <= 0) {
+    if (scopeRing.channels() <= 0) {
         return false;
     }
 
-    std::vector<int16_t> pcm(static_cast<size_t>(frames) * 2u);
-    std::vector<float> mono(
-            static_cast<size_t>(channels * frames),
-            0.0f
-    );
-
-    bool capturedAny = false;
+    // Paula taps peak at 64 * 2 * 127 per voice; YM and STE taps use the
+    // full 16-bit range.
+    const float scale = trackHasAmiga
+            ? kSc68PaulaScopeGain / 16384.0f
+            : kSc68TapScopeGain / 32768.0f;
+    scopeBlockScratch.assign(static_cast<size_t>(channels) * frames, 0.0f);
+    float* mono = scopeBlockScratch.data();
     for (int channel = 0; channel < channels; ++channel) {
         if (channel < static_cast<int>(toggleChannelMuted.size()) &&
             toggleChannelMuted[static_cast<size_t>(channel)]) {
             continue;
         }
-
-        auto& shadow = scopeAudioShadows[static_cast<size_t>(channel)];
-        if (!shadow.handle) {
-            continue;
-        }
-
-        const int producedFrames = processScopeHandleChunkLocked(shadow.handle, pcm.data(), frames);
-        if (producedFrames <= 0) {
-            continue;
-        }
-        capturedAny = true;
-
-        float* destination = mono.data() + static_cast<size_t>(channel * frames);
-        for (int frame = 0; frame < producedFrames; ++frame) {
-            const int left = pcm[static_cast<size_t>(frame) * 2u];
-            const int right = pcm[static_cast<size_t>(frame) * 2u + 1u];
-            destination[frame] = clampScopeSample(
-                    (static_cast<float>(left + right) / 65536.0f) * kSc68ShadowScopeGain
-            );
+        const int16_t* source = voiceTaps.planes[channel];
+        float* destination = mono + static_cast<size_t>(channel) * frames;
+        for (int frame = 0; frame < frames; ++frame) {
+            destination[frame] = clampScopeSample(static_cast<float>(source[frame]) * scale);
         }
     }
 
-    if (!capturedAny) {
-        return false;
-    }
-
-    std::vector<float> frame(static_cast<size_t>(channels), 0.0f);
-    for (int sample = 0; sample < frames; ++sample) {
-        for (int channel = 0; channel < channels; ++channel) {
-            frame[static_cast<size_t>(channel)] =
-                    mono[static_cast<size_t>(channel * frames + sample)];
-        }
-        appendScopeFrameLocked(frame.data(), channels);
-    }
+    scopeRing.appendBlock(mono, static_cast<size_t>(frames), frames);
     return true;
 }
 
@@ -1130,9 +907,6 @@ void Sc68Decoder::applyCoreOptionsToHandleLocked(sc68_t* target) {
 
 void Sc68Decoder::applyCoreOptionsLocked() {
     applyCoreOptionsToHandleLocked(handle);
-    for (auto& shadow : scopeAudioShadows) {
-        applyCoreOptionsToHandleLocked(shadow.handle);
-    }
 }
 
 void Sc68Decoder::applyCoreDefaultsLocked() {
@@ -1155,6 +929,9 @@ int Sc68Decoder::processIntoLocked(float* buffer, int numFrames) {
     const bool haveScopeBefore = scopeCaptureEnabled &&
             sc68_get_scope_snapshot(handle, &scopeBefore) > 0;
     std::vector<int16_t> pcm(static_cast<size_t>(numFrames) * 2u);
+    if (voiceTapsInstalled) {
+        prepareVoiceTapsLocked(numFrames);
+    }
     int requestedFrames = numFrames;
     const int status = sc68_process(handle, pcm.data(), &requestedFrames);
     if (status == SC68_ERROR || requestedFrames <= 0) {
@@ -1167,7 +944,7 @@ int Sc68Decoder::processIntoLocked(float* buffer, int numFrames) {
     }
 
     if (scopeCaptureEnabled) {
-        if (!captureChannelScopeFromShadowsLocked(requestedFrames) && haveScopeBefore) {
+        if (!captureChannelScopeFromTapsLocked(requestedFrames) && haveScopeBefore) {
             captureChannelScopeBlockLocked(scopeBefore, requestedFrames);
         }
 
@@ -1185,7 +962,7 @@ int Sc68Decoder::processIntoLocked(float* buffer, int numFrames) {
         refreshDurationLocked();
         rebuildToggleChannelsLocked();
         applyToggleChannelMutesLocked();
-        refreshScopeCaptureStateLocked(lastCorePositionMs);
+        refreshScopeCaptureStateLocked();
     }
     return requestedFrames;
 }
@@ -1234,7 +1011,7 @@ void Sc68Decoder::seek(double seconds) {
         playbackPositionSeconds = static_cast<double>(directSeekPosMs) / 1000.0;
         lastCorePositionMs = directSeekPosMs;
         resetChannelScopeLocked();
-        refreshScopeCaptureStateLocked(directSeekPosMs);
+        refreshScopeCaptureStateLocked();
         return;
     }
 
@@ -1312,7 +1089,7 @@ bool Sc68Decoder::setTrackLocked(int track1Based) {
     refreshDurationLocked();
     rebuildToggleChannelsLocked();
     applyToggleChannelMutesLocked();
-    refreshScopeCaptureStateLocked(lastCorePositionMs);
+    refreshScopeCaptureStateLocked();
     resetChannelScopeLocked();
     return true;
 }
@@ -1544,34 +1321,19 @@ double Sc68Decoder::getPlaybackPositionSeconds() {
 
 std::vector<int32_t> Sc68Decoder::getChannelScopeTextState(int maxChannels) {
     std::lock_guard<std::mutex> lock(decodeMutex);
-    if (scopeRingChannels <= 0 || scopeRingRaw.empty() || scopeRingSamples <= 0) {
+    if (scopeRing.empty()) {
         return {};
     }
 
     const int channels = std::min(
             std::clamp(maxChannels, 1, kSc68ScopeMaxChannels),
-            scopeRingChannels
+            scopeRing.channels()
     );
     std::vector<int32_t> flat(static_cast<size_t>(channels * kChannelScopeTextStride), -1);
     const int trailingSamples = std::clamp(sampleRateHz > 0 ? sampleRateHz / 50 : 64, 64, 1024);
-    const int recentSamples = std::min(scopeRingSamples, trailingSamples);
 
     for (int channel = 0; channel < channels; ++channel) {
-        float recentPeak = 0.0f;
-        for (int i = 0; i < recentSamples; ++i) {
-            const int ringIndex =
-                    (scopeRingWritePos - recentSamples + i + ChannelScopeSharedState::kMaxSamples) %
-                    ChannelScopeSharedState::kMaxSamples;
-            recentPeak = std::max(
-                    recentPeak,
-                    std::abs(
-                            scopeRingRaw[
-                                    static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples +
-                                    static_cast<size_t>(ringIndex)
-                            ]
-                    )
-            );
-        }
+        const float recentPeak = scopeRing.recentPeak(channel, trailingSamples);
 
         const size_t base = static_cast<size_t>(channel * kChannelScopeTextStride);
         const int exportedVolume =
@@ -1617,7 +1379,7 @@ void Sc68Decoder::setOption(const char* name, const char* value) {
             return;
         }
         scopeCaptureEnabled = enabled;
-        refreshScopeCaptureStateLocked(lastCorePositionMs);
+        refreshScopeCaptureStateLocked();
         return;
     } else if (optionName == "sc68.asid") {
         optionAsid = std::clamp(parseIntString(value, optionAsid), 0, 2);
@@ -1639,7 +1401,7 @@ void Sc68Decoder::setOption(const char* name, const char* value) {
 
     if (handle) {
         applyCoreOptionsLocked();
-        refreshScopeCaptureStateLocked(lastCorePositionMs);
+        refreshScopeCaptureStateLocked();
         if (scopeCaptureEnabled) {
             resetChannelScopeLocked();
         }
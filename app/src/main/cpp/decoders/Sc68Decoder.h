@@ -77,12 +77,6 @@ public:
     static std::vector<std::string> getSupportedExtensions();
 
 private:
-    struct ScopeAudioShadow {
-        sc68_t* handle = nullptr;
-        int ymMask = 0;
-        int steEnable = 0;
-    };
-
     mutable std::mutex decodeMutex;
     sc68_t* handle = nullptr;
     bool isOpen = false;
@@ -128,23 +122,21 @@ private:
     int optionAmigaBlend = 0x50;
     int optionAmigaClock = 0;
     std::shared_ptr<ChannelScopeSharedState> channelScopeState;
-    std::vector<float> scopeRingRaw;
+    ChannelScopeRing scopeRing;
     std::vector<int> scopeChannelVolumes;
     std::vector<int> scopeChannelFlags;
-    int scopeRingChannels = 0;
-    int scopeRingWritePos = 0;
-    int scopeRingSamples = 0;
+    std::vector<float> scopeFrameScratch;
+    std::vector<float> scopeBlockScratch;
     uint64_t channelScopeSourceSerial = 0;
-    std::vector<ScopeAudioShadow> scopeAudioShadows;
+    // Per-voice planes written by sc68_process() while scopes are shown.
+    sc68_voice_taps_t voiceTaps {};
+    std::vector<int16_t> voiceTapScratch;
+    bool voiceTapsInstalled = false;
     bool scopeCaptureEnabled = false;
 
     void closeInternalLocked();
-    void closeScopeAudioShadowsLocked();
-    int processScopeHandleChunkLocked(sc68_t* target, int16_t* pcm, int requestedFrames);
-    bool fastForwardScopeHandleLocked(sc68_t* target, int positionMs);
-    bool createScopeAudioShadowLocked(ScopeAudioShadow& shadow, int positionMs);
-    void refreshScopeAudioShadowsLocked(int positionMs = -1);
-    void refreshScopeCaptureStateLocked(int positionMs = -1);
+    void refreshScopeCaptureStateLocked();
+    void prepareVoiceTapsLocked(int frames);
     bool refreshTrackStateLocked();
     void refreshMetadataLocked();
     void refreshDurationLocked();
@@ -162,7 +154,7 @@ private:
     void publishScopeSnapshotLocked();
     void updateScopeTextStateLocked(const sc68_scope_snapshot_t& snapshot);
     void captureChannelScopeBlockLocked(const sc68_scope_snapshot_t& snapshot, int frames);
-    bool captureChannelScopeFromShadowsLocked(int frames);
+    bool captureChannelScopeFromTapsLocked(int frames);
 };
 
 #endif // SILICONPLAYER_SC68DECODER_H
@@ -330,7 +330,7 @@ uade_state* UadeDecoder::createStateLocked() {
         );
         uade_config_set_option(config, UC_PANNING_VALUE, panningValue);
     }
-    if (openScopePipeLocked()) {
+    if (!isMetadataOnly() && openScopePipeLocked()) {
         uade_config_set_option(config, UC_WRITE_AUDIO_FD, std::to_string(scopeWriteFd).c_str());
     }
     // Keep UADE running internally; app repeat modes enforce end/restart semantics.
@@ -433,9 +433,7 @@ void UadeDecoder::resetScopeTrackingLocked() {
     scopeParseBuffer.clear();
     std::fill(std::begin(scopeCurrentOutputByVoice), std::end(scopeCurrentOutputByVoice), 0);
     std::fill(std::begin(scopeVolumeByUiChannel), std::end(scopeVolumeByUiChannel), 0);
-    scopeRingRaw.clear();
-    scopeRingWritePos = 0;
-    scopeRingSamples = 0;
+    scopeRing.reset();
     scopeTickAccumulator = 0.0;
     scopeTicksPerOutputSample = 0.0;
     scopeUsesNtscClock = false;
@@ -596,99 +594,29 @@ void UadeDecoder::appendScopeSampleLocked(const float* uiOrderedSamples) {
     if (!uiOrderedSamples) {
         return;
     }
-    if (scopeRingRaw.size() != static_cast<size_t>(kUadeScopeChannelCount * ChannelScopeSharedState::kMaxSamples)) {
-        scopeRingRaw.assign(
-                static_cast<size_t>(kUadeScopeChannelCount * ChannelScopeSharedState::kMaxSamples),
-                0.0f
-        );
-    }
-    for (int channel = 0; channel < kUadeScopeChannelCount; ++channel) {
-        const size_t index =
-                static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples +
-                static_cast<size_t>(scopeRingWritePos);
-        scopeRingRaw[index] = uiOrderedSamples[channel];
-    }
-    scopeRingWritePos = (scopeRingWritePos + 1) % ChannelScopeSharedState::kMaxSamples;
-    scopeRingSamples = std::min(scopeRingSamples + 1, ChannelScopeSharedState::kMaxSamples);
+    scopeRing.ensureChannels(kUadeScopeChannelCount);
+    scopeRing.appendFrame(uiOrderedSamples, kUadeScopeChannelCount);
 }
 
 void UadeDecoder::publishScopeSnapshotLocked() {
     if (!channelScopeState) {
         return;
     }
-    if (scopeRingRaw.empty() || scopeRingSamples <= 0) {
-        channelScopeState->clear();
-        return;
-    }
-
-    std::vector<float> raw(
-            static_cast<size_t>(kUadeScopeChannelCount * ChannelScopeSharedState::kMaxSamples),
-            0.0f
-    );
-    const int filledSamples = std::clamp(scopeRingSamples, 0, ChannelScopeSharedState::kMaxSamples);
-    const int zeroPrefix = ChannelScopeSharedState::kMaxSamples - filledSamples;
-    for (int channel = 0; channel < kUadeScopeChannelCount; ++channel) {
-        float* destination =
-                raw.data() + static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples;
-        for (int i = 0; i < filledSamples; ++i) {
-            const int sourceIndex =
-                    (scopeRingWritePos - filledSamples + i + ChannelScopeSharedState::kMaxSamples) %
-                    ChannelScopeSharedState::kMaxSamples;
-            destination[zeroPrefix + i] =
-                    scopeRingRaw[
-                            static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples +
-                            static_cast<size_t>(sourceIndex)
-                    ];
-        }
-    }
-
     const int trailingSamples = std::clamp(sampleRateHz > 0 ? sampleRateHz / 50 : 64, 64, 1024);
-    std::vector<float> vu(static_cast<size_t>(kUadeScopeChannelCount), 0.0f);
-    for (int channel = 0; channel < kUadeScopeChannelCount; ++channel) {
-        const size_t base = static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples;
-        float peak = 0.0f;
-        const int start = std::max(0, ChannelScopeSharedState::kMaxSamples - trailingSamples);
-        for (int i = start; i < ChannelScopeSharedState::kMaxSamples; ++i) {
-            peak = std::max(peak, std::abs(raw[base + static_cast<size_t>(i)]));
-        }
-        vu[static_cast<size_t>(channel)] = std::clamp(peak, 0.0f, 1.0f);
-    }
-
-    {
-        std::lock_guard<std::mutex> channelScopeLock(channelScopeState->mutex);
-        channelScopeState->snapshotRaw = std::move(raw);
-        channelScopeState->snapshotVu = std::move(vu);
-        channelScopeState->snapshotChannels = kUadeScopeChannelCount;
-        channelScopeState->snapshotSerial = ++channelScopeSourceSerial;
-    }
+    scopeRing.publish(*channelScopeState, ++channelScopeSourceSerial, trailingSamples);
 }
 
 std::vector<int32_t> UadeDecoder::getChannelScopeTextState(int maxChannels) {
     std::lock_guard<std::mutex> scopeLock(scopeMutex);
-    if (scopeRingSamples <= 0 || scopeRingRaw.empty()) {
+    if (scopeRing.empty()) {
         return {};
     }
 
     const int channels = std::min(kUadeScopeChannelCount, std::clamp(maxChannels, 1, kUadeScopeChannelCount));
     std::vector<int32_t> flat(static_cast<size_t>(channels * kChannelScopeTextStride), -1);
     const int trailingSamples = std::clamp(sampleRateHz > 0 ? sampleRateHz / 50 : 64, 64, 1024);
-    const int recentSamples = std::min(scopeRingSamples, trailingSamples);
     for (int channel = 0; channel < channels; ++channel) {
-        float recentPeak = 0.0f;
-        for (int i = 0; i < recentSamples; ++i) {
-            const int ringIndex =
-                    (scopeRingWritePos - recentSamples + i + ChannelScopeSharedState::kMaxSamples) %
-                    ChannelScopeSharedState::kMaxSamples;
-            recentPeak = std::max(
-                    recentPeak,
-                    std::abs(
-                            scopeRingRaw[
-                                    static_cast<size_t>(channel) * ChannelScopeSharedState::kMaxSamples +
-                                    static_cast<size_t>(ringIndex)
-                            ]
-                    )
-            );
-        }
+        const float recentPeak = scopeRing.recentPeak(channel, trailingSamples);
 
         const size_t base = static_cast<size_t>(channel * kChannelScopeTextStride);
         int flags = 0;
@@ -905,7 +833,7 @@ bool UadeDecoder::selectSubtune(int index) {
     const int targetSubsong = subtuneMin + index;
     stopScopeReaderLocked();
     closeScopePipeLocked();
-    if (openScopePipeLocked()) {
+    if (!isMetadataOnly() && openScopePipeLocked()) {
         state->config.write_audio_fd = scopeWriteFd;
         state->config.write_audio_fd_set = 1;
     } else {
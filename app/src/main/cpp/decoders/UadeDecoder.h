@@ -130,9 +130,7 @@ private:
     std::vector<uint8_t> scopeParseBuffer;
     int scopeCurrentOutputByVoice[4] = { 0, 0, 0, 0 };
     int scopeVolumeByUiChannel[4] = { 0, 0, 0, 0 };
-    std::vector<float> scopeRingRaw;
-    int scopeRingWritePos = 0;
-    int scopeRingSamples = 0;
+    ChannelScopeRing scopeRing;
     double scopeTickAccumulator = 0.0;
     double scopeTicksPerOutputSample = 0.0;
     bool scopeUsesNtscClock = false;
@@ -4,7 +4,6 @@
 #include <algorithm>
 #include <cmath>
 #include <cstring>
-#include <fstream>
 #include <limits>
 #include <cctype>
 #include <vector>
@@ -120,31 +119,19 @@ bool VGMDecoder::open(const char* path) {
     pendingTerminalEnd = false;
     playbackTimeOffsetSeconds = 0.0;
 
-    std::ifstream file(path, std::ios::binary | std::ios::ate);
-    if (!file.is_open()) {
-        LOGE("Failed to open file: %s", path);
+    fileSource = FileSource::open(path);
+    if (!fileSource) {
+        LOGE("Failed to read file or file is empty: %s", path);
         return false;
     }
-
-    const std::streamsize size = file.tellg();
-    file.seekg(0, std::ios::beg);
-    if (size <= 0) {
-        LOGE("Invalid file size for %s", path);
-        return false;
-    }
-    if (static_cast<uint64_t>(size) > std::numeric_limits<UINT32>::max()) {
-        LOGE("File too large for libvgm loader: %lld", static_cast<long long>(size));
-        return false;
-    }
-
-    fileData.resize(static_cast<size_t>(size));
-    if (!file.read(reinterpret_cast<char*>(fileData.data()), size)) {
-        LOGE("Failed to read file: %s", path);
+    if (static_cast<uint64_t>(fileSource->size()) > std::numeric_limits<UINT32>::max()) {
+        LOGE("File too large for libvgm loader: %llu", static_cast<unsigned long long>(fileSource->size()));
+        fileSource.reset();
         return false;
     }
-    file.close();
 
-    dataLoaderHandle = MemoryLoader_Init(fileData.data(), static_cast<UINT32>(fileData.size()));
+    // The memory loader reads straight from the mapping during playback.
+    dataLoaderHandle = MemoryLoader_Init(fileSource->data(), static_cast<UINT32>(fileSource->size()));
     if (dataLoaderHandle == nullptr) {
         LOGE("MemoryLoader_Init failed");
         return false;
@@ -258,7 +245,7 @@ void VGMDecoder::closeInternal() {
         dataLoaderHandle = nullptr;
     }
 
-    fileData.clear();
+    fileSource.reset();
     title.clear();
     artist.clear();
     gameName.clear();
@@ -282,10 +269,7 @@ void VGMDecoder::closeInternal() {
         channelScopeState->clear();
     }
     channelScopeSourceSerial = 0;
-    scopeRingRaw.clear();
-    scopeRingChannels = 0;
-    scopeRingWritePos = 0;
-    scopeRingSamples = 0;
+    scopeRing.reset();
 }
 
 void VGMDecoder::close() {
@@ -918,11 +902,7 @@ std::vector<int32_t> VGMDecoder::getChannelScopeTextState(int maxChannels) {
         return {};
     }
 
-    std::vector<float> vu;
-    if (channelScopeState) {
-        std::lock_guard<std::mutex> scopeLock(channelScopeState->mutex);
-        vu = channelScopeState->snapshotVu;
-    }
+    const std::vector<float>& vu = scopeRing.lastPublishedVu();
 
     std::vector<int32_t> flat(static_cast<size_t>(channels * kChannelScopeTextStride), -1);
     for (int channel = 0; channel < channels; ++channel) {
@@ -967,13 +947,7 @@ void VGMDecoder::captureScopeSnapshotLocked(VGMPlayer* vgmPlayer) {
 
     const int numChannels = std::min(static_cast<int>(toggleChipEntries.size()), 64);
     const int maxSamples = ChannelScopeSharedState::kMaxSamples;
-    const size_t ringSize = static_cast<size_t>(numChannels) * maxSamples;
-    if (scopeRingChannels != numChannels || scopeRingRaw.size() != ringSize) {
-        scopeRingRaw.assign(ringSize, 0.0f);
-        scopeRingChannels = numChannels;
-        scopeRingWritePos = 0;
-        scopeRingSamples = 0;
-    }
+    scopeRing.ensureChannels(numChannels);
 
     const UINT32 samplesToRead = std::min(static_cast<UINT32>(maxSamples), sampleCount);
 
@@ -1002,53 +976,8 @@ void VGMDecoder::captureScopeSnapshotLocked(VGMPlayer* vgmPlayer) {
         }
     }
 
-    for (UINT32 s = 0; s < samplesToRead; ++s) {
-        for (int channel = 0; channel < numChannels; ++channel) {
-            scopeRingRaw[
-                    static_cast<size_t>(channel) * maxSamples +
-                    static_cast<size_t>(scopeRingWritePos)
-            ] = channelBlock[
-                    static_cast<size_t>(channel) * samplesToRead +
-                    static_cast<size_t>(s)
-            ];
-        }
-        scopeRingWritePos = (scopeRingWritePos + 1) % maxSamples;
-    }
-    scopeRingSamples = std::min(
-            scopeRingSamples + static_cast<int>(samplesToRead),
-            maxSamples
-    );
+    scopeRing.appendBlock(channelBlock.data(), samplesToRead, static_cast<int>(samplesToRead));
 
-    std::vector<float> raw(ringSize, 0.0f);
-    std::vector<float> vu(static_cast<size_t>(numChannels), 0.0f);
-    const int filledSamples = std::clamp(scopeRingSamples, 0, maxSamples);
-    const int zeroPrefix = maxSamples - filledSamples;
     const int trailingSamples = std::clamp(sampleRate > 0 ? sampleRate / 50 : 64, 64, 2048);
-
-    for (int channel = 0; channel < numChannels; ++channel) {
-        float* dest = raw.data() + static_cast<size_t>(channel) * maxSamples;
-        for (int i = 0; i < filledSamples; ++i) {
-            const int ringIndex =
-                    (scopeRingWritePos - filledSamples + i + maxSamples) % maxSamples;
-            dest[zeroPrefix + i] = scopeRingRaw[
-                    static_cast<size_t>(channel) * maxSamples +
-                    static_cast<size_t>(ringIndex)
-            ];
-        }
-
-        float peak = 0.0f;
-        const int start = std::max(0, maxSamples - trailingSamples);
-        for (int i = start; i < maxSamples; ++i) {
-            peak = std::max(peak, std::abs(dest[i]));
-        }
-        vu[static_cast<size_t>(channel)] = std::clamp(peak, 0.0f, 1.0f);
-    }
-
-    {
-        std::lock_guard<std::mutex> scopeLock(channelScopeState->mutex);
-        channelScopeState->snapshotRaw = std::move(raw);
-        channelScopeState->snapshotVu = std::move(vu);
-        channelScopeState->snapshotChannels = numChannels;
-        channelScopeState->snapshotSerial = ++channelScopeSourceSerial;
-    }
+    scopeRing.publish(*channelScopeState, ++channelScopeSourceSerial, trailingSamples);
 }
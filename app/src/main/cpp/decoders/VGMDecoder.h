@@ -2,6 +2,7 @@
 #define SILICONPLAYER_VGMDECODER_H
 
 #include "AudioDecoder.h"
+#include "../FileSource.h"
 #include <vector>
 #include <mutex>
 #include <memory>
@@ -74,8 +75,8 @@ private:
     std::unique_ptr<PlayerA> player;
     mutable std::mutex decodeMutex;
 
-    // File data buffer
-    std::vector<uint8_t> fileData;
+    // File contents the memory loader reads from
+    std::shared_ptr<const FileSource> fileSource;
     DATA_LOADER* dataLoaderHandle = nullptr;
 
     double duration = 0.0;
@@ -132,10 +133,7 @@ private:
     // Channel scope support
     std::shared_ptr<ChannelScopeSharedState> channelScopeState;
     uint32_t channelScopeSourceSerial = 0;
-    std::vector<float> scopeRingRaw;
-    int scopeRingChannels = 0;
-    int scopeRingWritePos = 0;
-    int scopeRingSamples = 0;
+    ChannelScopeRing scopeRing;
 
     void captureScopeSnapshotLocked(VGMPlayer* vgmPlayer);
 };
@@ -21,6 +21,14 @@
 #include <cstring>
 #include <limits>
 
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define SILICONPLAYER_OPENMPT_DSP_NEON 1
+#elif defined(__SSE2__) || defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SILICONPLAYER_OPENMPT_DSP_SSE 1
+#endif
+
 namespace {
 
 constexpr float kPi = 3.14159265358979323846f;
@@ -240,6 +248,107 @@ void writeStereo(std::vector<int16_t>& buffer, int pos, int16_t l, int16_t r) {
     buffer[idx + 1] = r;
 }
 
+// Float engine lanes: a Pair is one (L, R) frame, a Quad two of them. The
+// delay lines are interleaved, so a tap is a single 64-bit load.
+#if defined(SILICONPLAYER_OPENMPT_DSP_NEON)
+using Pair = float32x2_t;
+using Quad = float32x4_t;
+inline Pair pairLoad(const float* p) { return vld1_f32(p); }
+inline void pairStore(float* p, Pair v) { vst1_f32(p, v); }
+inline Pair pairSet(float l, float r) {
+    const float values[2] = { l, r };
+    return vld1_f32(values);
+}
+inline Pair pairSplat(float v) { return vdup_n_f32(v); }
+inline Pair padd(Pair a, Pair b) { return vadd_f32(a, b); }
+inline Pair psub(Pair a, Pair b) { return vsub_f32(a, b); }
+inline Pair pmul(Pair a, Pair b) { return vmul_f32(a, b); }
+inline Pair pclamp(Pair a) { return vmin_f32(vmax_f32(a, vdup_n_f32(-1.0f)), vdup_n_f32(1.0f)); }
+inline float left(Pair a) { return vget_lane_f32(a, 0); }
+inline float right(Pair a) { return vget_lane_f32(a, 1); }
+inline Pair dupLeft(Pair a) { return vdup_lane_f32(a, 0); }
+inline Pair dupRight(Pair a) { return vdup_lane_f32(a, 1); }
+// (a.l, b.r)
+inline Pair pairLeftRight(Pair a, Pair b) { return vset_lane_f32(vget_lane_f32(a, 0), b, 0); }
+inline Quad quadLoad(const float* p) { return vld1q_f32(p); }
+inline void quadStore(float* p, Quad v) { vst1q_f32(p, v); }
+inline Quad quadJoin(Pair lo, Pair hi) { return vcombine_f32(lo, hi); }
+inline Quad qsplat(float v) { return vdupq_n_f32(v); }
+inline Quad qadd(Quad a, Quad b) { return vaddq_f32(a, b); }
+inline Quad qsub(Quad a, Quad b) { return vsubq_f32(a, b); }
+inline Quad qmul(Quad a, Quad b) { return vmulq_f32(a, b); }
+inline Pair quadLow(Quad a) { return vget_low_f32(a); }
+inline Pair quadHigh(Quad a) { return vget_high_f32(a); }
+// (a0 + a1, a2 + a3)
+inline Pair quadPairSums(Quad a) { return vpadd_f32(vget_low_f32(a), vget_high_f32(a)); }
+#elif defined(SILICONPLAYER_OPENMPT_DSP_SSE)
+// Pairs live in the low two lanes; the upper lanes stay zero.
+using Pair = __m128;
+using Quad = __m128;
+inline Pair pairLoad(const float* p) { return _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(p))); }
+inline void pairStore(float* p, Pair v) { _mm_store_sd(reinterpret_cast<double*>(p), _mm_castps_pd(v)); }
+inline Pair pairSet(float l, float r) { return _mm_setr_ps(l, r, 0.0f, 0.0f); }
+inline Pair pairSplat(float v) { return _mm_setr_ps(v, v, 0.0f, 0.0f); }
+inline Pair padd(Pair a, Pair b) { return _mm_add_ps(a, b); }
+inline Pair psub(Pair a, Pair b) { return _mm_sub_ps(a, b); }
+inline Pair pmul(Pair a, Pair b) { return _mm_mul_ps(a, b); }
+inline Pair pclamp(Pair a) { return _mm_min_ps(_mm_max_ps(a, _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f)); }
+inline float left(Pair a) { return _mm_cvtss_f32(a); }
+inline float right(Pair a) { return _mm_cvtss_f32(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 2, 1, 1))); }
+inline Pair dupLeft(Pair a) { return _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 2, 0, 0)); }
+inline Pair dupRight(Pair a) { return _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 2, 1, 1)); }
+inline Pair pairLeftRight(Pair a, Pair b) { return _mm_move_ss(b, a); }
+inline Quad quadLoad(const float* p) { return _mm_loadu_ps(p); }
+inline void quadStore(float* p, Quad v) { _mm_storeu_ps(p, v); }
+inline Quad quadJoin(Pair lo, Pair hi) { return _mm_movelh_ps(lo, hi); }
+inline Quad qsplat(float v) { return _mm_set1_ps(v); }
+inline Quad qadd(Quad a, Quad b) { return _mm_add_ps(a, b); }
+inline Quad qsub(Quad a, Quad b) { return _mm_sub_ps(a, b); }
+inline Quad qmul(Quad a, Quad b) { return _mm_mul_ps(a, b); }
+inline Pair quadLow(Quad a) { return _mm_movelh_ps(a, _mm_setzero_ps()); }
+inline Pair quadHigh(Quad a) { return _mm_movehl_ps(_mm_setzero_ps(), a); }
+inline Pair quadPairSums(Quad a) {
+    const __m128 even = _mm_shuffle_ps(a, _mm_setzero_ps(), _MM_SHUFFLE(0, 0, 2, 0));
+    const __m128 odd = _mm_shuffle_ps(a, _mm_setzero_ps(), _MM_SHUFFLE(0, 0, 3, 1));
+    return _mm_add_ps(even, odd);
+}
+#else
+struct Pair {
+    float l;
+    float r;
+};
+struct Quad {
+    float v[4];
+};
+inline Pair pairLoad(const float* p) { return { p[0], p[1] }; }
+inline void pairStore(float* p, Pair v) { p[0] = v.l; p[1] = v.r; }
+inline Pair pairSet(float l, float r) { return { l, r }; }
+inline Pair pairSplat(float v) { return { v, v }; }
+inline Pair padd(Pair a, Pair b) { return { a.l + b.l, a.r + b.r }; }
+inline Pair psub(Pair a, Pair b) { return { a.l - b.l, a.r - b.r }; }
+inline Pair pmul(Pair a, Pair b) { return { a.l * b.l, a.r * b.r }; }
+inline Pair pclamp(Pair a) { return { clampSample(a.l), clampSample(a.r) }; }
+inline float left(Pair a) { return a.l; }
+inline float right(Pair a) { return a.r; }
+inline Pair dupLeft(Pair a) { return { a.l, a.l }; }
+inline Pair dupRight(Pair a) { return { a.r, a.r }; }
+inline Pair pairLeftRight(Pair a, Pair b) { return { a.l, b.r }; }
+inline Quad quadLoad(const float* p) { return { { p[0], p[1], p[2], p[3] } }; }
+inline void quadStore(float* p, Quad q) { std::memcpy(p, q.v, sizeof(q.v)); }
+inline Quad quadJoin(Pair lo, Pair hi) { return { { lo.l, lo.r, hi.l, hi.r } }; }
+inline Quad qsplat(float v) { return { { v, v, v, v } }; }
+inline Quad qadd(Quad a, Quad b) { return { { a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] } }; }
+inline Quad qsub(Quad a, Quad b) { return { { a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3] } }; }
+inline Quad qmul(Quad a, Quad b) { return { { a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] } }; }
+inline Pair quadLow(Quad a) { return { a.v[0], a.v[1] }; }
+inline Pair quadHigh(Quad a) { return { a.v[2], a.v[3] }; }
+inline Pair quadPairSums(Quad a) { return { a.v[0] + a.v[1], a.v[2] + a.v[3] }; }
+#endif
+
+float* framePtr(std::vector<float>& buffer, int pos) {
+    return buffer.data() + static_cast<size_t>(pos) * 2;
+}
+
 } // namespace
 
 namespace siliconplayer::effects {
@@ -341,6 +450,12 @@ void OpenMptDspEffects::reset() {
     reverbDelay2.clear();
     reverbWetWork.clear();
     reverbDryWork.clear();
+    reverbFloat = {};
+    surroundDelayFloat.clear();
+    surroundFloatHpX1 = 0.0f;
+    surroundFloatHpY1 = 0.0f;
+    surroundFloatLpY1 = 0.0f;
+    configuredEngine = -1;
 }
 
 void OpenMptDspEffects::resetForSampleRate(int sampleRate) {
@@ -396,6 +511,73 @@ void OpenMptDspEffects::resetForSampleRate(int sampleRate) {
     reverbDiffusion2.assign(static_cast<size_t>(kRvbDlyMask + 1) * 2, 0);
     reverbDelay1.assign(static_cast<size_t>(kRvbDlyMask + 1) * 2, 0);
     reverbDelay2.assign(static_cast<size_t>(kRvbDlyMask + 1) * 2, 0);
+
+    surroundDelayFloat.assign(surroundDelay.size(), 0.0f);
+    surroundFloatHpX1 = 0.0f;
+    surroundFloatHpY1 = 0.0f;
+    surroundFloatLpY1 = 0.0f;
+    reverbFloat.inputY1 = {};
+    reverbFloat.roomHistory = {};
+    reverbFloat.lpHist = {};
+    reverbFloat.dcrX1 = {};
+    reverbFloat.dcrY1 = {};
+    reverbFloat.refDelay.assign(reverbRefDelayBuffer.size(), 0.0f);
+    reverbFloat.preDifBuffer.assign(reverbPreDifBuffer.size(), 0.0f);
+    reverbFloat.refOut.assign(reverbRefOutBuffer.size(), 0.0f);
+    reverbFloat.diffusion1.assign(reverbDiffusion1.size(), 0.0f);
+    reverbFloat.diffusion2.assign(reverbDiffusion2.size(), 0.0f);
+    reverbFloat.delay1.assign(reverbDelay1.size(), 0.0f);
+    reverbFloat.delay2.assign(reverbDelay2.size(), 0.0f);
+}
+
+void OpenMptDspEffects::selectEngine(bool floatEngine) {
+    const int engine = floatEngine ? 1 : 0;
+    if (engine == configuredEngine) {
+        return;
+    }
+    configuredEngine = engine;
+
+    // The engines keep separate history; switching starts both tails from
+    // silence instead of splicing one engine's state into the other.
+    std::fill(surroundDelay.begin(), surroundDelay.end(), 0);
+    std::fill(surroundDelayFloat.begin(), surroundDelayFloat.end(), 0.0f);
+    surroundWritePos = 0;
+    surroundHpX1 = 0;
+    surroundHpY1 = 0;
+    surroundLpY1 = 0;
+    surroundFloatHpX1 = 0.0f;
+    surroundFloatHpY1 = 0.0f;
+    surroundFloatLpY1 = 0.0f;
+
+    reverbInputY1L = 0;
+    reverbInputY1R = 0;
+    reverbDcrX1L = 0;
+    reverbDcrX1R = 0;
+    reverbDcrY1L = 0;
+    reverbDcrY1R = 0;
+    reverbPreDifPos = 0;
+    reverbDelayPos = 0;
+    reverbRefOutPos = 0;
+    reverbLateDelayPos = 0;
+    reverbRoomHistoryL = 0;
+    reverbRoomHistoryR = 0;
+    reverbLpHist0L = 0;
+    reverbLpHist0R = 0;
+    reverbLpHist1L = 0;
+    reverbLpHist1R = 0;
+    for (auto* line : { &reverbRefDelayBuffer, &reverbPreDifBuffer, &reverbRefOutBuffer,
+                        &reverbDiffusion1, &reverbDiffusion2, &reverbDelay1, &reverbDelay2 }) {
+        std::fill(line->begin(), line->end(), 0);
+    }
+    reverbFloat.inputY1 = {};
+    reverbFloat.roomHistory = {};
+    reverbFloat.lpHist = {};
+    reverbFloat.dcrX1 = {};
+    reverbFloat.dcrY1 = {};
+    for (auto* line : { &reverbFloat.refDelay, &reverbFloat.preDifBuffer, &reverbFloat.refOut,
+                        &reverbFloat.diffusion1, &reverbFloat.diffusion2, &reverbFloat.delay1, &reverbFloat.delay2 }) {
+        std::fill(line->begin(), line->end(), 0.0f);
+    }
 }
 
 void OpenMptDspEffects::process(
@@ -409,6 +591,7 @@ void OpenMptDspEffects::process(
     }
 
     resetForSampleRate(sampleRate);
+    selectEngine(params.floatEngine);
 
     if (params.bassEnabled) {
         applyBass(interleavedBuffer, frames, channels, sampleRate, params);
@@ -523,12 +706,16 @@ void OpenMptDspEffects::applySurround(
     if (delayMs != surroundConfiguredDelayMs || depth != surroundConfiguredDepth) {
         const int safeRate = std::max(sampleRate, 8000);
         std::fill(surroundDelay.begin(), surroundDelay.end(), 0);
+        std::fill(surroundDelayFloat.begin(), surroundDelayFloat.end(), 0.0f);
         surroundWritePos = 0;
         surroundConfiguredDelayMs = delayMs;
         surroundConfiguredDepth = depth;
         surroundHpX1 = 0;
         surroundHpY1 = 0;
         surroundLpY1 = 0;
+        surroundFloatHpX1 = 0.0f;
+        surroundFloatHpY1 = 0.0f;
+        surroundFloatLpY1 = 0.0f;
         shelfEq(1024, surroundHpA1, surroundHpB0, surroundHpB1, 200, safeRate, 0.0f, 0.5f, 1.0f);
         shelfEq(1024, surroundLpA1, surroundLpB0, surroundLpB1, 7000, safeRate, 1.0f, 0.75f, 0.0f);
         surroundHpB0 = (surroundHpB0 * depth) >> 5;
@@ -537,6 +724,11 @@ void OpenMptDspEffects::applySurround(
         surroundLpB1 *= 2;
     }
 
+    if (params.floatEngine) {
+        applySurroundFloat(buffer, frames, channels, sampleRate, delayMs);
+        return;
+    }
+
     for (int frame = 0; frame < frames; ++frame) {
         const int idx = frame * channels;
         const int32_t inL = static_cast<int32_t>(std::lrint(std::clamp(buffer[idx], -1.0f, 1.0f) * kMixScale));
@@ -594,6 +786,27 @@ void OpenMptDspEffects::applyReverb(
         reverbOutGain1L = static_cast<int16_t>((masterGain + 0xff) >> 4);
         reverbOutGain1R = static_cast<int16_t>((masterGain + 0x7f) >> 3);
         reverbConfiguredDepth = depth;
+
+        reverbFloat.reflectionsGain = static_cast<float>(reverbReflectionsGain >> 3) / 4096.0f;
+        reverbFloat.outGains = {
+                static_cast<float>(reverbOutGain0L) / 4096.0f,
+                static_cast<float>(reverbOutGain0R) / 4096.0f,
+                static_cast<float>(reverbOutGain1L) / 4096.0f,
+                static_cast<float>(reverbOutGain1R) / 4096.0f,
+        };
+    }
+
+    int32_t maxRvbGain = (reverbRefMasterGain > reverbLateMasterGain) ? reverbRefMasterGain : reverbLateMasterGain;
+    if (maxRvbGain > 32768) maxRvbGain = 32768;
+    int32_t dryVol = (36 - depth) >> 1;
+    if (dryVol < 8) dryVol = 8;
+    if (dryVol > 16) dryVol = 16;
+    dryVol = 16 - (((16 - dryVol) * maxRvbGain) >> 15);
+
+    if (params.floatEngine) {
+        reverbFloat.dryGain = static_cast<float>(dryVol) / 16.0f;
+        applyReverbFloat(buffer, frames, channels);
+        return;
     }
 
     reverbWetWork.resize(static_cast<size_t>(frames) * 2);
@@ -609,12 +822,6 @@ void OpenMptDspEffects::applyReverb(
         reverbDryWork[static_cast<size_t>(frame) * 2 + 1] = 0;
     }
 
-    int32_t maxRvbGain = (reverbRefMasterGain > reverbLateMasterGain) ? reverbRefMasterGain : reverbLateMasterGain;
-    if (maxRvbGain > 32768) maxRvbGain = 32768;
-    int32_t dryVol = (36 - depth) >> 1;
-    if (dryVol < 8) dryVol = 8;
-    if (dryVol > 16) dryVol = 16;
-    dryVol = 16 - (((16 - dryVol) * maxRvbGain) >> 15);
     applyReverbDryMix(reverbDryWork.data(), reverbWetWork.data(), dryVol, frames);
 
     for (int i = 0; i < frames; ++i) {
@@ -684,6 +891,21 @@ void OpenMptDspEffects::configureReverb(int sampleRate, int preset) {
     reverbDecayLpL = clamp16(dampingLp);
     reverbDecayLpR = clamp16(dampingLp);
 
+    reverbFloat.roomLp = static_cast<float>(reverbRoomLpCoeffL) / 32768.0f;
+    reverbFloat.preDif = static_cast<float>(reverbPreDifCoeffL) / 65536.0f;
+    reverbFloat.dif = static_cast<float>(reverbDifCoeffL) / 65536.0f;
+    reverbFloat.decayDc = static_cast<float>(reverbDecayDcL) / 32768.0f;
+    reverbFloat.decayLp = static_cast<float>(reverbDecayLpL) / 32768.0f;
+    for (int i = 0; i < kReflectionsCount; ++i) {
+        const auto& refl = reverbReflections[static_cast<size_t>(i)];
+        reverbFloat.reflectionGains[static_cast<size_t>(i)] = {
+                static_cast<float>(refl.gainLL) / 32768.0f,
+                static_cast<float>(refl.gainLR) / 32768.0f,
+                static_cast<float>(refl.gainRL) / 32768.0f,
+                static_cast<float>(refl.gainRR) / 32768.0f,
+        };
+    }
+
     reverbConfiguredPreset = clampedPreset;
     reverbConfiguredDepth = -1;
 }
@@ -886,6 +1108,223 @@ void OpenMptDspEffects::applyReverbDryMix(int32_t* dry, const int32_t* wet, int3
     }
 }
 
+void OpenMptDspEffects::applySurroundFloat(float* buffer, int frames, int channels, int sampleRate, int delayMs) {
+    const float hpB0 = static_cast<float>(surroundHpB0) / 1024.0f;
+    const float hpB1 = static_cast<float>(surroundHpB1) / 1024.0f;
+    const float hpA1 = static_cast<float>(surroundHpA1) / 1024.0f;
+    // The integer port keeps its low-pass state at 1/256 of the output; the
+    // float state is the output itself.
+    const float lpB0 = static_cast<float>(surroundLpB0) / 4.0f;
+    const float lpB1 = static_cast<float>(surroundLpB1) / 4.0f;
+    const float lpA1 = static_cast<float>(surroundLpA1) / 1024.0f;
+    const int wrapPos = std::clamp((sampleRate * delayMs) / 1000, 1, static_cast<int>(surroundDelayFloat.size()) - 1);
+    const Pair side = pairSet(1.0f, -1.0f);
+
+    float hpX1 = surroundFloatHpX1;
+    float hpY1 = surroundFloatHpY1;
+    float lpY1 = surroundFloatLpY1;
+    int writePos = surroundWritePos;
+    for (int frame = 0; frame < frames; ++frame) {
+        float* sample = buffer + static_cast<size_t>(frame) * channels;
+        const Pair in = pclamp(pairSet(sample[0], sample[1]));
+
+        const float secho = surroundDelayFloat[static_cast<size_t>(writePos)];
+        surroundDelayFloat[static_cast<size_t>(writePos)] = (left(in) + right(in)) * (1.0f / 512.0f);
+        const float v0 = hpB0 * secho + hpB1 * hpX1 + hpA1 * hpY1;
+        const float v = lpB0 * v0 + lpB1 * hpY1 + lpA1 * lpY1;
+        hpX1 = secho;
+        hpY1 = v0;
+        lpY1 = v;
+
+        const Pair out = pclamp(padd(in, pmul(side, pairSplat(v))));
+        sample[0] = left(out);
+        sample[1] = right(out);
+
+        if (++writePos >= wrapPos) {
+            writePos = 0;
+        }
+    }
+    surroundFloatHpX1 = hpX1;
+    surroundFloatHpY1 = hpY1;
+    surroundFloatLpY1 = lpY1;
+    surroundWritePos = writePos;
+}
+
+void OpenMptDspEffects::applyReverbFloat(float* buffer, int frames, int channels) {
+    auto& rf = reverbFloat;
+    rf.wet.resize(static_cast<size_t>(frames) * 2);
+    rf.dry.resize(static_cast<size_t>(frames) * 2);
+
+    const Pair dryGain = pairSplat(rf.dryGain * kGlobalReverbSendGain);
+    const Pair sendGain = pairSplat(kGlobalReverbSendGain);
+    const Pair roomLp = pairSplat(rf.roomLp);
+    Pair inputY1 = pairLoad(rf.inputY1.data());
+    for (int frame = 0; frame < frames; ++frame) {
+        const float* sample = buffer + static_cast<size_t>(frame) * channels;
+        const Pair in = pclamp(pairSet(sample[0], sample[1]));
+        pairStore(framePtr(rf.dry, frame), pmul(in, dryGain));
+        const Pair x = pmul(in, sendGain);
+        inputY1 = padd(x, pmul(psub(x, inputY1), roomLp));
+        pairStore(framePtr(rf.wet, frame), inputY1);
+    }
+    pairStore(rf.inputY1.data(), inputY1);
+
+    processReverbFloatPreDelay(rf.wet.data(), frames);
+    processReverbFloatReflections(rf.wet.data(), frames);
+    processReverbFloatLate(rf.wet.data(), frames);
+    processReverbFloatPost(rf.wet.data(), rf.dry.data(), frames);
+
+    for (int frame = 0; frame < frames; ++frame) {
+        const Pair out = pclamp(pairLoad(framePtr(rf.dry, frame)));
+        float* sample = buffer + static_cast<size_t>(frame) * channels;
+        sample[0] = left(out);
+        sample[1] = right(out);
+    }
+}
+
+void OpenMptDspEffects::processReverbFloatPreDelay(const float* in, int frames) {
+    auto& rf = reverbFloat;
+    const Pair roomLp = pairSplat(rf.roomLp);
+    const Pair preDif = pairSplat(rf.preDif);
+    uint32_t preDifPos = reverbPreDifPos;
+    uint32_t delayPos = reverbDelayPos - 1;
+    Pair history = pairLoad(rf.roomHistory.data());
+
+    for (int i = 0; i < frames; ++i) {
+        const Pair x = pairLoad(in + static_cast<size_t>(i) * 2);
+        history = padd(x, pmul(psub(history, x), roomLp));
+
+        const Pair preDifIn = pairLoad(framePtr(rf.preDifBuffer, static_cast<int>(preDifPos)));
+        preDifPos = (preDifPos + 1) & kSndmixPrediffusionDelayMask;
+        delayPos = (delayPos + 1) & kSndmixReflectionsDelayMask;
+
+        const Pair preDif2 = psub(history, pmul(preDifIn, preDif));
+        pairStore(framePtr(rf.preDifBuffer, static_cast<int>(preDifPos)), preDif2);
+        pairStore(framePtr(rf.refDelay, static_cast<int>(delayPos)), padd(pmul(preDif, preDif2), preDifIn));
+    }
+
+    reverbPreDifPos = preDifPos;
+    pairStore(rf.roomHistory.data(), history);
+}
+
+void OpenMptDspEffects::processReverbFloatReflections(float* out, int frames) {
+    auto& rf = reverbFloat;
+    constexpr int kTaps = 7;
+    int pos[kTaps];
+    Pair gainsFromL[kTaps];
+    Pair gainsFromR[kTaps];
+    for (int i = 0; i < kTaps; ++i) {
+        pos[i] = static_cast<int>(reverbDelayPos) - static_cast<int>(reverbReflections[static_cast<size_t>(i)].delay) - 1;
+        gainsFromL[i] = pairLoad(rf.reflectionGains[static_cast<size_t>(i)].data());
+        gainsFromR[i] = pairLoad(rf.reflectionGains[static_cast<size_t>(i)].data() + 2);
+    }
+    const Pair refGain = pairSplat(rf.reflectionsGain);
+    const uint32_t refOutStart = reverbRefOutPos;
+
+    for (int frame = 0; frame < frames; ++frame) {
+        Pair refMix = pairSplat(0.0f);
+        for (int i = 0; i < kTaps; ++i) {
+            pos[i] = (pos[i] + 1) & kSndmixReflectionsDelayMask;
+            const Pair ref = pairLoad(framePtr(rf.refDelay, pos[i]));
+            refMix = padd(refMix, padd(pmul(dupLeft(ref), gainsFromL[i]), pmul(dupRight(ref), gainsFromR[i])));
+        }
+        const int refOutPos = static_cast<int>((refOutStart + static_cast<uint32_t>(frame)) & kSndmixReverbDelayMask);
+        pairStore(framePtr(rf.refOut, refOutPos), refMix);
+        pairStore(out + static_cast<size_t>(frame) * 2, pmul(refMix, refGain));
+    }
+
+    reverbRefOutPos = (reverbRefOutPos + static_cast<uint32_t>(frames)) & kSndmixReverbDelayMask;
+    reverbDelayPos = (reverbDelayPos + static_cast<uint32_t>(frames)) & kSndmixReflectionsDelayMask;
+}
+
+void OpenMptDspEffects::processReverbFloatLate(float* out, int frames) {
+    auto& rf = reverbFloat;
+    const Pair dif = pairSplat(rf.dif);
+    const Pair decayDc = pairSplat(rf.decayDc);
+    const Pair refInGain = pairSplat(0.25f);
+    const Quad decayLp = qsplat(rf.decayLp);
+    const Quad dif2InGains = quadLoad(std::array<float, 4> {
+            static_cast<float>(reverbDif2InGain0L) / 32768.0f,
+            static_cast<float>(reverbDif2InGain0R) / 32768.0f,
+            static_cast<float>(reverbDif2InGain1L) / 32768.0f,
+            static_cast<float>(reverbDif2InGain1R) / 32768.0f,
+    }.data());
+    const Quad outGains = quadLoad(rf.outGains.data());
+    Quad lpHist = quadLoad(rf.lpHist.data());
+
+    int delayPos = static_cast<int>(reverbLateDelayPos) & kRvbDlyMask;
+    const uint32_t refStart = (reverbRefOutPos - static_cast<uint32_t>(frames)) & kSndmixReverbDelayMask;
+    const uint32_t refReadStart = (refStart - reverbLateDelay) & kSndmixReverbDelayMask;
+
+    for (int frame = 0; frame < frames; ++frame) {
+        const int refPos = static_cast<int>((refReadStart + static_cast<uint32_t>(frame)) & kSndmixReverbDelayMask);
+        const Pair refIn = pairLoad(framePtr(rf.refOut, refPos));
+
+        // Both delay2 taps as one quad: (LL, LR, RL, RR).
+        const Quad delay2 = quadJoin(
+                pairLoad(framePtr(rf.delay2, (delayPos - kRvbDly2LLen) & kRvbDlyMask)),
+                pairLoad(framePtr(rf.delay2, (delayPos - kRvbDly2RLen) & kRvbDlyMask)));
+        const Pair diff1 = pairSet(
+                framePtr(rf.diffusion1, (delayPos - kRvbDif1LLen) & kRvbDlyMask)[0],
+                framePtr(rf.diffusion1, (delayPos - kRvbDif1RLen) & kRvbDlyMask)[1]);
+        const Pair diff2 = pairSet(
+                framePtr(rf.diffusion2, (delayPos - kRvbDif2LLen) & kRvbDlyMask)[0],
+                framePtr(rf.diffusion2, (delayPos - kRvbDif2RLen) & kRvbDlyMask)[1]);
+
+        lpHist = qadd(delay2, qmul(qsub(lpHist, delay2), decayLp));
+        const Pair histDecay = pmul(pairLeftRight(quadLow(lpHist), quadHigh(lpHist)), decayDc);
+        const Pair histDecayIn = padd(histDecay, pmul(refIn, refInGain));
+        const Pair histDecayInDiff = psub(histDecayIn, pmul(diff1, dif));
+        pairStore(framePtr(rf.diffusion1, delayPos), histDecayInDiff);
+
+        const Pair delay1Out = padd(pmul(dif, histDecayInDiff), diff1);
+        pairStore(framePtr(rf.delay1, delayPos), delay1Out);
+        const Pair histDecayInDelay = padd(histDecayIn, delay1Out);
+
+        const Quad delay1 = quadJoin(
+                pairLoad(framePtr(rf.delay1, (delayPos - kRvbDly1LLen) & kRvbDlyMask)),
+                pairLoad(framePtr(rf.delay1, (delayPos - kRvbDly1RLen) & kRvbDlyMask)));
+        const Pair delay1Gains = quadPairSums(qmul(delay1, dif2InGains));
+        const Quad histDelay1 = qsub(
+                qadd(quadJoin(histDecayInDelay, histDecayInDelay), delay1),
+                quadJoin(delay1Gains, delay1Gains));
+        const Pair diff2Out = psub(delay1Gains, pmul(diff2, dif));
+        const Pair diff2OutCoeffs = pmul(dif, diff2Out);
+        pairStore(framePtr(rf.diffusion2, delayPos), diff2Out);
+
+        const Pair delay2Out = padd(diff2OutCoeffs, diff2);
+        pairStore(framePtr(rf.delay2, delayPos), delay2Out);
+        delayPos = (delayPos + 1) & kRvbDlyMask;
+
+        const Quad taps = qadd(histDelay1, quadJoin(delay2Out, diff2OutCoeffs));
+        float* outFrame = out + static_cast<size_t>(frame) * 2;
+        pairStore(outFrame, padd(pairLoad(outFrame), quadPairSums(qmul(taps, outGains))));
+    }
+    quadStore(rf.lpHist.data(), lpHist);
+    reverbLateDelayPos = static_cast<uint32_t>(delayPos);
+}
+
+void OpenMptDspEffects::processReverbFloatPost(const float* wet, float* dry, int frames) {
+    auto& rf = reverbFloat;
+    const Pair x1Gain = pairSplat(1.0f / static_cast<float>(1 << (kDcrAmount + 1)));
+    const Pair y1Gain = pairSplat(1.0f / static_cast<float>(1 << kDcrAmount));
+    Pair x1 = pairLoad(rf.dcrX1.data());
+    Pair y1 = pairLoad(rf.dcrY1.data());
+    for (int i = 0; i < frames; ++i) {
+        const Pair in = pairLoad(wet + static_cast<size_t>(i) * 2);
+        float* outFrame = dry + static_cast<size_t>(i) * 2;
+
+        x1 = psub(x1, in);
+        x1 = psub(pmul(x1, x1Gain), x1);
+        y1 = padd(y1, x1);
+        pairStore(outFrame, padd(pairLoad(outFrame), y1));
+        y1 = psub(y1, pmul(y1, y1Gain));
+        x1 = in;
+    }
+    pairStore(rf.dcrX1.data(), x1);
+    pairStore(rf.dcrY1.data(), y1);
+}
+
 void OpenMptDspEffects::applyBitCrush(float* buffer, int frames, int channels, const OpenMptDspParams& params) {
     const int bits = std::clamp(params.bitCrushBits, 1, 24);
     const int precisionBits = 24;
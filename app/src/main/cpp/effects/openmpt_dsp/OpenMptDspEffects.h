@@ -37,6 +37,14 @@ struct OpenMptDspParams {
 
     bool bitCrushEnabled = false;
     int bitCrushBits = 16; // 1..24
+
+    // Surround and reverb run on the float32 engine by default: it is 2-4x
+    // cheaper and drops the integer port's int16 delay lines and 2^24
+    // fixed-point round trip, which is all that separates the two outputs.
+    // siliconplayer_openmpt_dsp_bench keeps that difference bounded (exit 2
+    // past -30 dB residual or 0.02 peak on any preset). false selects the
+    // original integer port, kept as the null-test reference.
+    bool floatEngine = true;
 };
 
 class OpenMptDspEffects {
@@ -66,6 +74,13 @@ private:
     void processReverbLate(int32_t* out, int32_t frames);
     void processReverbPost(const int32_t* wet, int32_t* dry, int32_t frames);
     void applyReverbDryMix(int32_t* dry, const int32_t* wet, int32_t dryVol, int32_t frames);
+    void selectEngine(bool floatEngine);
+    void applySurroundFloat(float* buffer, int frames, int channels, int sampleRate, int delayMs);
+    void applyReverbFloat(float* buffer, int frames, int channels);
+    void processReverbFloatPreDelay(const float* in, int frames);
+    void processReverbFloatReflections(float* out, int frames);
+    void processReverbFloatLate(float* out, int frames);
+    void processReverbFloatPost(const float* wet, float* dry, int frames);
 
     int configuredSampleRate = 0;
     int32_t bassX1 = 0;
@@ -149,6 +164,44 @@ private:
     std::vector<int16_t> reverbDelay2;
     std::vector<int32_t> reverbWetWork;
     std::vector<int32_t> reverbDryWork;
+
+    // Float32 engine. Same topology and coefficients as the integer port,
+    // normalized so 1.0 is full scale; delay lines hold interleaved L/R
+    // pairs and share the positions and tap delays above.
+    struct FloatReverbState {
+        float roomLp = 0.0f;
+        float preDif = 0.0f;
+        float dif = 0.0f;
+        float decayDc = 0.0f;
+        float decayLp = 0.0f;
+        float reflectionsGain = 0.0f;
+        float dryGain = 1.0f;
+        std::array<float, 4> outGains {}; // 0L, 0R, 1L, 1R
+        // Per tap: {LL, LR} and {RL, RR}, so one tap is two pair multiplies.
+        std::array<std::array<float, 4>, 8> reflectionGains {};
+
+        std::array<float, 2> inputY1 {};
+        std::array<float, 2> roomHistory {};
+        std::array<float, 4> lpHist {}; // 0L, 0R, 1L, 1R
+        std::array<float, 2> dcrX1 {};
+        std::array<float, 2> dcrY1 {};
+
+        std::vector<float> refDelay;
+        std::vector<float> preDifBuffer;
+        std::vector<float> refOut;
+        std::vector<float> diffusion1;
+        std::vector<float> diffusion2;
+        std::vector<float> delay1;
+        std::vector<float> delay2;
+        std::vector<float> wet;
+        std::vector<float> dry;
+    };
+    FloatReverbState reverbFloat;
+    std::vector<float> surroundDelayFloat;
+    float surroundFloatHpX1 = 0.0f;
+    float surroundFloatHpY1 = 0.0f;
+    float surroundFloatLpY1 = 0.0f;
+    int configuredEngine = -1;
 };
 
 } // namespace siliconplayer::effects
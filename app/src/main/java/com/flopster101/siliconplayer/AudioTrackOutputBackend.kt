@@ -6,12 +6,14 @@ import android.media.AudioManager
 import android.media.AudioTrack
 import android.os.Build
 import android.util.Log
+import java.nio.ByteBuffer
 import kotlin.math.max
 
 internal object AudioTrackOutputBackend {
     private const val TAG = "AudioTrackBackend"
     private const val CHANNEL_COUNT = 2
-    private const val BYTES_PER_SAMPLE = 2
+    private const val BYTES_PER_SAMPLE_PCM16 = 2
+    private const val BYTES_PER_SAMPLE_FLOAT = 4
     private const val DEFAULT_SAMPLE_RATE = 48000
 
     private val lock = Any()
@@ -30,21 +32,30 @@ internal object AudioTrackOutputBackend {
         }
     }
 
-    fun create(sampleRate: Int, bufferFrames: Int, performanceMode: Int, bufferPreset: Int): Boolean {
+    // Returns the track's buffer size in frames, or 0 on failure.
+    fun create(
+        sampleRate: Int,
+        bufferFrames: Int,
+        performanceMode: Int,
+        bufferPreset: Int,
+        floatPcm: Boolean
+    ): Int {
         synchronized(lock) {
             releaseLocked()
 
             val targetSampleRate = if (sampleRate > 0) sampleRate else DEFAULT_SAMPLE_RATE
             val targetBufferFrames = if (bufferFrames > 0) bufferFrames else framesForPreset(bufferPreset)
-            val requestedBufferBytes = targetBufferFrames * CHANNEL_COUNT * BYTES_PER_SAMPLE
+            val encoding = if (floatPcm) AudioFormat.ENCODING_PCM_FLOAT else AudioFormat.ENCODING_PCM_16BIT
+            val frameBytes = CHANNEL_COUNT * if (floatPcm) BYTES_PER_SAMPLE_FLOAT else BYTES_PER_SAMPLE_PCM16
+            val requestedBufferBytes = targetBufferFrames * frameBytes
             val minBufferBytes = AudioTrack.getMinBufferSize(
                 targetSampleRate,
                 AudioFormat.CHANNEL_OUT_STEREO,
-                AudioFormat.ENCODING_PCM_16BIT
+                encoding
             )
             if (minBufferBytes <= 0) {
-                Log.e(TAG, "AudioTrack min buffer size query failed: sampleRate=$targetSampleRate")
-                return false
+                Log.e(TAG, "AudioTrack min buffer size query failed: sampleRate=$targetSampleRate float=$floatPcm")
+                return 0
             }
 
             val finalBufferBytes = max(minBufferBytes, requestedBufferBytes)
@@ -54,7 +65,7 @@ internal object AudioTrackOutputBackend {
                 .build()
             val format = AudioFormat.Builder()
                 .setSampleRate(targetSampleRate)
-                .setEncoding(AudioFormat.ENCODING_PCM_16BIT)
+                .setEncoding(encoding)
                 .setChannelMask(AudioFormat.CHANNEL_OUT_STEREO)
                 .build()
 
@@ -80,7 +91,7 @@ internal object AudioTrackOutputBackend {
                         AudioManager.STREAM_MUSIC,
                         targetSampleRate,
                         AudioFormat.CHANNEL_OUT_STEREO,
-                        AudioFormat.ENCODING_PCM_16BIT,
+                        encoding,
                         finalBufferBytes,
                         AudioTrack.MODE_STREAM
                     )
@@ -92,16 +103,21 @@ internal object AudioTrackOutputBackend {
 
             if (track == null || track.state != AudioTrack.STATE_INITIALIZED) {
                 track?.release()
-                Log.e(TAG, "AudioTrack failed to initialize")
-                return false
+                Log.e(TAG, "AudioTrack failed to initialize: float=$floatPcm")
+                return 0
             }
 
             audioTrack = track
+            val trackBufferFrames = if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.M) {
+                track.bufferSizeInFrames
+            } else {
+                finalBufferBytes / frameBytes
+            }
             Log.d(
                 TAG,
-                "AudioTrack ready: sampleRate=$targetSampleRate requestedFrames=$targetBufferFrames finalBufferBytes=$finalBufferBytes minBufferBytes=$minBufferBytes"
+                "AudioTrack ready: sampleRate=$targetSampleRate float=$floatPcm requestedFrames=$targetBufferFrames finalBufferBytes=$finalBufferBytes minBufferBytes=$minBufferBytes trackFrames=$trackBufferFrames"
             )
-            return true
+            return max(1, trackBufferFrames)
         }
     }
 
@@ -171,6 +187,43 @@ internal object AudioTrackOutputBackend {
         return written
     }
 
+    // data is the native render buffer wrapped as a direct buffer; it is
+    // handed to AudioTrack as is, without a copy into a Java array.
+    fun writeBlockingFloat(data: ByteBuffer, sampleCount: Int): Int {
+        if (sampleCount <= 0) return 0
+        val track = audioTrack ?: return AudioTrack.ERROR_INVALID_OPERATION
+        if (track.state != AudioTrack.STATE_INITIALIZED) return AudioTrack.ERROR_INVALID_OPERATION
+
+        val totalBytes = sampleCount * BYTES_PER_SAMPLE_FLOAT
+        if (totalBytes > data.capacity()) return AudioTrack.ERROR_BAD_VALUE
+        data.clear()
+        data.limit(totalBytes)
+        var stalls = 0
+        while (data.hasRemaining()) {
+            val result = try {
+                track.write(data, data.remaining(), AudioTrack.WRITE_BLOCKING)
+            } catch (t: Throwable) {
+                Log.e(TAG, "AudioTrack float write failed", t)
+                return if (data.position() > 0) data.position() / BYTES_PER_SAMPLE_FLOAT else AudioTrack.ERROR_INVALID_OPERATION
+            }
+
+            if (result > 0) {
+                stalls = 0
+                continue
+            }
+            if (result == 0) {
+                stalls++
+                if (stalls >= 4) {
+                    break
+                }
+                Thread.yield()
+                continue
+            }
+            return if (data.position() > 0) data.position() / BYTES_PER_SAMPLE_FLOAT else result
+        }
+        return data.position() / BYTES_PER_SAMPLE_FLOAT
+    }
+
     private fun releaseLocked() {
         val track = audioTrack
         audioTrack = null
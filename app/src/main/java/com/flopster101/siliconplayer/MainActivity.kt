@@ -408,6 +408,8 @@ class MainActivity : ComponentActivity() {
 
     override fun onStop() {
         NativeBridge.setBackgroundPlaybackMode(true)
+        // Backgrounded apps may be killed without notice; persist fresh lengths.
+        NativeBridge.flushDurationCache()
         super.onStop()
     }
 
@@ -1445,6 +1447,7 @@ private fun AppNavigation(
     var artworkResolvedTrackKey by remember { mutableStateOf<String?>(null) }
     var artworkReloadToken by remember { mutableIntStateOf(0) }
     var visiblePlayableFiles by remember { mutableStateOf<List<File>>(emptyList()) }
+    var gaplessNextFile by remember { mutableStateOf<File?>(null) }
     val browserNavigator = remember { BrowserNavigatorState() }
     var networkCurrentFolderId by remember { mutableStateOf<Long?>(null) }
     val storageDescriptors = remember(context) { detectStorageDescriptors(context) }
@@ -2442,6 +2445,49 @@ onStopEngine = { NativeBridge.releaseCurrentDecoder() }, onMetadataAlbumChanged
             deferredPlaybackSeek = null
         }
     }
+    LaunchedEffect(selectedFile?.absolutePath, visiblePlayableFiles) {
+        // Keep the decoder plugins of the next tracks loaded so skipping to
+        // them does not wait on dlopen.
+        val upcomingPaths = upcomingTrackPaths(
+            selectedFile = selectedFile,
+            visiblePlayableFiles = visiblePlayableFiles,
+            count = 2
+        )
+        withContext(Dispatchers.IO) {
+            NativeBridge.prewarmDecoderPlugins(upcomingPaths.toTypedArray())
+        }
+    }
+    LaunchedEffect(
+        selectedFile?.absolutePath,
+        settingsStates.currentPlaybackSourceId.value,
+        visiblePlayableFiles,
+        activeRepeatMode,
+        activePlaylist
+    ) {
+        // Announce the track that follows so the engine preloads it and
+        // switches at natural end without a reload. Active playlists and
+        // the repeat modes handled by the engine keep the reload path.
+        val followsInBrowserList = activePlaylist == null &&
+            (activeRepeatMode == RepeatMode.None || activeRepeatMode == RepeatMode.Playlist)
+        gaplessNextFile = withContext(Dispatchers.PlaybackIo) {
+            val nextFile = if (followsInBrowserList) {
+                gaplessNextTrackFile(
+                    selectedFile = selectedFile,
+                    currentPlaybackSourceId = settingsStates.currentPlaybackSourceId.value,
+                    visiblePlayableFiles = visiblePlayableFiles,
+                    wrap = activeRepeatMode == RepeatMode.Playlist
+                )
+            } else {
+                null
+            }
+            if (nextFile != null) {
+                NativeBridge.setNextAudio(nextFile.absolutePath)
+            } else {
+                NativeBridge.clearNextAudio()
+            }
+            nextFile
+        }
+    }
     val displayedArtworkBitmap = rememberDisplayedPlayerArtwork(
         trackKey = settingsStates.currentPlaybackSourceId.value ?: selectedFile?.absolutePath,
         artwork = artworkBitmap,
@@ -2964,6 +3010,14 @@ onStopEngine = { NativeBridge.releaseCurrentDecoder() }, onMetadataAlbumChanged
         onPlayAdjacentTrack = { offset, wrapOverride, notifyWrap ->
             playAdjacentActivePlaylistEntryAction(offset, wrapOverride, notifyWrap)
         },
+        onGaplessTrackAdvanced = {
+            val nextFile = gaplessNextFile
+            if (nextFile != null) {
+                gaplessNextFile = null
+                trackLoadDelegates.adoptGaplessTrack(nextFile)
+            }
+            nextFile != null
+        },
         onRestartCurrentTrack = {
             position = 0.0
             appScope.launch {
@@ -2,6 +2,8 @@ package com.flopster101.siliconplayer
 
 import android.content.Context
 import com.flopster101.siliconplayer.data.resolveArchiveMountedCompanionPath
+import java.io.File
+import java.nio.ByteBuffer
 
 object NativeBridge {
     const val CHANNEL_SCOPE_TEXT_STATE_STRIDE = 10
@@ -21,6 +23,7 @@ object NativeBridge {
         val runtimeBaseDir = UadeRuntimeSupport.ensureInstalled(appContext!!)
         val runtimeCorePath = UadeRuntimeSupport.resolveUadeCoreExecutablePath(appContext!!)
         setUadeRuntimePaths(runtimeBaseDir ?: "", runtimeCorePath ?: "")
+        setDurationCacheDirectory(File(appContext!!.cacheDir, "durations").absolutePath)
     }
 
     internal fun requireAppContext(): Context {
@@ -39,8 +42,9 @@ object NativeBridge {
     @JvmStatic
     fun openSmbAvioHandle(requestUri: String): Long = SmbAvioBridge.openHandle(requestUri)
 
+    // buffer is a direct view of native memory; see readSmbAvioHandleForNative.
     @JvmStatic
-    fun readSmbAvioHandle(handleId: Long, offset: Long, buffer: ByteArray, length: Int): Int {
+    fun readSmbAvioHandle(handleId: Long, offset: Long, buffer: ByteBuffer, length: Int): Int {
         return SmbAvioBridge.readHandle(
             handleId = handleId,
             offset = offset,
@@ -67,13 +71,15 @@ object NativeBridge {
         sampleRate: Int,
         bufferFrames: Int,
         performanceMode: Int,
-        bufferPreset: Int
-    ): Boolean {
+        bufferPreset: Int,
+        floatPcm: Boolean
+    ): Int {
         return AudioTrackOutputBackend.create(
             sampleRate = sampleRate,
             bufferFrames = bufferFrames,
             performanceMode = performanceMode,
-            bufferPreset = bufferPreset
+            bufferPreset = bufferPreset,
+            floatPcm = floatPcm
         )
     }
 
@@ -96,6 +102,12 @@ object NativeBridge {
         return AudioTrackOutputBackend.writeBlocking(pcmData, clampedSampleCount)
     }
 
+    @JvmStatic
+    fun writeAudioTrackOutputFloat(pcmData: ByteBuffer, sampleCount: Int): Int {
+        val clampedSampleCount = sampleCount.coerceIn(0, pcmData.capacity() / 4)
+        return AudioTrackOutputBackend.writeBlockingFloat(pcmData, clampedSampleCount)
+    }
+
     external fun startEngine()
     external fun startEngineWithPauseResumeFade()
     external fun stopEngine()
@@ -109,6 +121,32 @@ object NativeBridge {
         loadAudio(path)
     }
 
+    // Gapless playback: preload the track that should follow the current one.
+    // A matching loadAudio() reuses it; at natural end (repeat off) the engine
+    // switches by itself and reports it via consumeGaplessTransitionEvent().
+    external fun setNextAudio(path: String?)
+    external fun clearNextAudio()
+    external fun consumeGaplessTransitionEvent(): Boolean
+    // [state, createMs, openMs, primeMs, primedMs]; state 0=idle 1=loading 2=ready 3=failed 4=skipped.
+    external fun getNextAudioPreloadStats(): DoubleArray
+    // Render pipeline profile, all Long:
+    // [version, stageCount, bucketCount, decoderCount, fillCount, uptimeMs, underruns, underrunFrames],
+    // then per stage [count, sumNs, maxNs, buckets...], per decoder [chunks, frames, decodeNs]
+    // in the order of the "decode" lines of getRenderQueueTuning(),
+    // then fillCount [timeMs, queueFrames, underrun] oldest first. Stage order and bucket
+    // bounds are in RenderProfiler.h; empty when the engine is not running.
+    external fun getRenderProfileSnapshot(): LongArray
+    external fun resetRenderProfile()
+    // Output callback queue counters (callbacks, average/max time in queue
+    // ops, underruns, missing frames; cleared by resetRenderProfile), one
+    // "decode <name>" line per decoder with its ns per frame, then the
+    // render queue chunk/target with the measurements behind them, then one
+    // line per recent adaptation; empty when the engine is not running.
+    external fun getRenderQueueTuning(): String
+    // Adaptive render queue sizing within [minLatencyMs, maxLatencyMs]; 0 derives
+    // a bound from the buffer preset. Disabled pins the queue to the preset.
+    external fun setRenderQueueAdaptation(enabled: Boolean, minLatencyMs: Int, maxLatencyMs: Int)
+
     external fun setFastTrackSwitchStartupHint(enabled: Boolean)
     external fun getSupportedExtensions(): Array<String>
     external fun getDuration(): Double
@@ -291,6 +329,11 @@ object NativeBridge {
     external fun getUadeModuleBytes(): Long
     external fun getUadeSongBytes(): Long
     external fun getUadeSubsongBytes(): Long
+    // Track info dialog fields in one call: [version, staticPairCount, key, value, ...].
+    // version is staticVersion << 32 | liveVersion. Static pairs are omitted (count 0)
+    // while knownVersion has the same static half; only [version] comes back while
+    // it equals knownVersion. Published by the render worker, never waits on decoding.
+    external fun getTrackInfoSnapshot(knownVersion: Long): Array<String>
     external fun getTrackBitrate(): Long
     external fun isTrackVBR(): Boolean
     external fun getAudioBackendLabel(): String
@@ -370,5 +413,16 @@ object NativeBridge {
     external fun getDecoderSupportedExtensions(decoderName: String): Array<String>
     external fun getDecoderEnabledExtensions(decoderName: String): Array<String>
     external fun setDecoderEnabledExtensions(decoderName: String, extensions: Array<String>)
+    // Loads the decoder plugins of upcoming tracks in the background; each call
+    // replaces the previous set.
+    external fun prewarmDecoderPlugins(paths: Array<String>)
+    // ComponentCallbacks2 trim level; drops idle and pre-warmed plugins under pressure.
+    external fun trimDecoderPlugins(level: Int)
+    external fun getDecoderPluginStats(): String
     external fun setUadeRuntimePaths(baseDir: String, uadeCorePath: String)
+    external fun setDurationCacheDirectory(directory: String)
+    external fun flushDurationCache()
+    external fun getDurationCacheStats(): String
+    // Headless metadata probe; see TrackProbe.kt for the packed layout.
+    external fun probeTrack(path: String): Array<String>
 }
@@ -289,6 +289,11 @@ class PlaybackService : Service() {
         mediaSession?.release()
     }
 
+    override fun onTrimMemory(level: Int) {
+        super.onTrimMemory(level)
+        NativeBridge.trimDecoderPlugins(level)
+    }
+
     override fun onBind(intent: Intent?): IBinder? = null
 
     override fun onStartCommand(intent: Intent?, flags: Int, startId: Int): Int {
@@ -2,6 +2,7 @@ package com.flopster101.siliconplayer
 
 import android.content.Context
 import android.widget.Toast
+import com.flopster101.siliconplayer.data.parseArchiveSourceId
 import java.io.File
 
 internal data class NativeTrackSnapshot(
@@ -200,6 +201,44 @@ internal fun adjacentTrackForOffset(
     return visiblePlayableFiles[targetIndex]
 }
 
+internal fun upcomingTrackPaths(
+    selectedFile: File?,
+    visiblePlayableFiles: List<File>,
+    count: Int
+): List<String> {
+    return (1..count).mapNotNull { offset ->
+        adjacentTrackForOffset(
+            selectedFile = selectedFile,
+            visiblePlayableFiles = visiblePlayableFiles,
+            offset = offset
+        )?.absolutePath
+    }
+}
+
+// The local file the engine may switch to by itself at natural end, or null
+// when the next track has to go through a full reload (archive or remote
+// source, end of a non-wrapping list). Touches the filesystem.
+internal fun gaplessNextTrackFile(
+    selectedFile: File?,
+    currentPlaybackSourceId: String?,
+    visiblePlayableFiles: List<File>,
+    wrap: Boolean
+): File? {
+    if (selectedFile == null) return null
+    if (currentPlaybackSourceId != null && !samePath(currentPlaybackSourceId, selectedFile.absolutePath)) {
+        return null
+    }
+    val index = currentTrackIndexForList(selectedFile, visiblePlayableFiles)
+    if (index < 0) return null
+    val next = when {
+        index + 1 in visiblePlayableFiles.indices -> visiblePlayableFiles[index + 1]
+        wrap && visiblePlayableFiles.size > 1 -> visiblePlayableFiles.first()
+        else -> return null
+    }
+    if (parseArchiveSourceId(next.absolutePath) != null || !next.isFile) return null
+    return next
+}
+
 internal fun shouldRestartCurrentTrackOnPrevious(
     previousRestartsAfterThreshold: Boolean,
     hasTrackLoaded: Boolean,
@@ -4,6 +4,7 @@ import android.content.Context
 import android.os.SystemClock
 import java.io.File
 import java.io.RandomAccessFile
+import java.nio.ByteBuffer
 import kotlinx.coroutines.CancellationException
 import kotlinx.coroutines.CoroutineScope
 import kotlinx.coroutines.Dispatchers
@@ -208,6 +209,55 @@ internal class ProgressiveRandomAccessCache(
         return outputOffset
     }
 
+    // Fills buffer from index 0 without moving its position or limit. Reads go through
+    // the data file's channel, so a direct buffer is filled without a Java heap copy.
+    fun readAt(offset: Long, buffer: ByteBuffer, length: Int): Int {
+        require(offset >= 0L) { "Progressive cache offset must be non-negative" }
+        val clampedLength = length.coerceIn(0, buffer.capacity())
+        if (clampedLength <= 0) return 0
+        if (offset >= transport.sizeBytes) return 0
+
+        val target = buffer.duplicate()
+        var remaining = min(clampedLength.toLong(), transport.sizeBytes - offset).toInt()
+        var outputOffset = 0
+        var currentOffset = offset
+
+        while (remaining > 0) {
+            val chunkIndex = (currentOffset / chunkSizeBytes).toInt()
+            if (chunkIndex !in 0 until chunkCount) break
+            ensureChunkCached(chunkIndex, transport)
+
+            val chunkStartOffset = chunkIndex.toLong() * chunkSizeBytes.toLong()
+            val offsetInsideChunk = (currentOffset - chunkStartOffset).toInt()
+            val bytesFromChunk = min(
+                remaining,
+                currentChunkSizeBytes(chunkIndex) - offsetInsideChunk
+            )
+            if (bytesFromChunk <= 0) {
+                break
+            }
+
+            synchronized(lock) {
+                check(!closed) { "Progressive cache is closed" }
+                target.limit(outputOffset + bytesFromChunk)
+                target.position(outputOffset)
+                val channel = dataFileRaf.channel
+                var filePosition = currentOffset
+                while (target.hasRemaining()) {
+                    val read = channel.read(target, filePosition)
+                    check(read > 0) { "Progressive cache data file ended early" }
+                    filePosition += read
+                }
+            }
+
+            outputOffset += bytesFromChunk
+            currentOffset += bytesFromChunk
+            remaining -= bytesFromChunk
+        }
+
+        return outputOffset
+    }
+
     fun close() {
         var activePrefetchTransport: ProgressiveRandomAccessTransport? = null
         var activePrefetchJob: Job? = null
@@ -1,12 +1,13 @@
 package com.flopster101.siliconplayer
 
+import java.nio.ByteBuffer
 import java.util.concurrent.ConcurrentHashMap
 import java.util.concurrent.atomic.AtomicLong
 
 private class SmbAvioHandle(
     private val cache: ProgressiveRandomAccessCache
 ) {
-    fun read(offset: Long, buffer: ByteArray, length: Int): Int {
+    fun read(offset: Long, buffer: ByteBuffer, length: Int): Int {
         return cache.readAt(offset, buffer, length)
     }
 
@@ -55,7 +56,7 @@ internal object SmbAvioBridge {
         return handleId
     }
 
-    fun readHandle(handleId: Long, offset: Long, buffer: ByteArray, length: Int): Int {
+    fun readHandle(handleId: Long, offset: Long, buffer: ByteBuffer, length: Int): Int {
         val handle = activeHandles[handleId]
             ?: throw IllegalStateException("SMB AVIO handle is not open")
         return try {
@@ -0,0 +1,73 @@
+package com.flopster101.siliconplayer
+
+const val TRACK_PROBE_OK = 0
+const val TRACK_PROBE_UNSUPPORTED = 1
+const val TRACK_PROBE_OPEN_FAILED = 2
+const val TRACK_PROBE_SKIPPED = 3
+
+data class TrackProbeSubtune(
+    val title: String,
+    val durationMs: Long
+)
+
+data class TrackProbeResult(
+    val path: String,
+    val status: Int,
+    val decoderName: String,
+    val title: String,
+    val artist: String,
+    val composer: String,
+    val album: String,
+    val genre: String,
+    val year: String,
+    val durationMs: Long,
+    val durationReliable: Boolean,
+    val sampleRateHz: Int,
+    val channelCount: Int,
+    val subtunes: List<TrackProbeSubtune>
+)
+
+private const val TRACK_PROBE_FIXED_FIELDS = 14
+
+// Native probes arrive flattened: the fixed fields of TrackProbeResult in
+// declaration order, the subtune count, then one (title, durationMs) pair per
+// subtune.
+fun parseTrackProbeResults(packed: Array<String>): List<TrackProbeResult> {
+    val results = ArrayList<TrackProbeResult>()
+    var index = 0
+    while (index + TRACK_PROBE_FIXED_FIELDS <= packed.size) {
+        val subtuneCount = packed[index + 13].toIntOrNull() ?: 0
+        val subtunes = ArrayList<TrackProbeSubtune>(subtuneCount)
+        var subtuneIndex = index + TRACK_PROBE_FIXED_FIELDS
+        repeat(subtuneCount) {
+            if (subtuneIndex + 1 < packed.size) {
+                subtunes += TrackProbeSubtune(
+                    title = packed[subtuneIndex],
+                    durationMs = packed[subtuneIndex + 1].toLongOrNull() ?: 0L
+                )
+            }
+            subtuneIndex += 2
+        }
+        results += TrackProbeResult(
+            path = packed[index],
+            status = packed[index + 1].toIntOrNull() ?: TRACK_PROBE_OPEN_FAILED,
+            decoderName = packed[index + 2],
+            title = packed[index + 3],
+            artist = packed[index + 4],
+            composer = packed[index + 5],
+            album = packed[index + 6],
+            genre = packed[index + 7],
+            year = packed[index + 8],
+            durationMs = packed[index + 9].toLongOrNull() ?: 0L,
+            durationReliable = packed[index + 10] == "1",
+            sampleRateHz = packed[index + 11].toIntOrNull() ?: 0,
+            channelCount = packed[index + 12].toIntOrNull() ?: 0,
+            subtunes = subtunes
+        )
+        index = subtuneIndex
+    }
+    return results
+}
+
+fun probeTrack(path: String): TrackProbeResult? =
+    parseTrackProbeResults(NativeBridge.probeTrack(path)).firstOrNull()
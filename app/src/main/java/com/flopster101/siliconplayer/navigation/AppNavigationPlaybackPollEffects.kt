@@ -16,6 +16,7 @@ private data class PlaybackPollSnapshot(
     val durationSeconds: Double,
     val positionSeconds: Double,
     val naturalEnd: Boolean,
+    val gaplessTransition: Boolean,
     val trackSnapshot: NativeTrackSnapshot?
 )
 
@@ -28,6 +29,7 @@ private suspend fun readPlaybackPollSnapshot(
     val nextSeekInProgress = NativeBridge.isSeekInProgress()
     val nextIsPlaying = NativeBridge.isEnginePlaying()
     val endedNaturally = NativeBridge.consumeNaturalEndEvent()
+    val advancedGaplessly = NativeBridge.consumeGaplessTransitionEvent()
     // Skip the expensive snapshot during active seek. The seek worker holds
     // decoderMutex for the entire seek duration, and readNativeTrackSnapshot
     // would block on that mutex, stalling the PlaybackIo thread and freezing
@@ -65,6 +67,7 @@ private suspend fun readPlaybackPollSnapshot(
         durationSeconds = nextDuration,
         positionSeconds = nextPosition,
         naturalEnd = endedNaturally,
+        gaplessTransition = advancedGaplessly,
         trackSnapshot = trackSnapshot
     )
 }
@@ -113,6 +116,7 @@ internal fun AppNavigationPlaybackPollEffects(
     onSubtuneCursorChanged: (File?) -> Unit,
     onAddRecentPlayedTrack: (path: String, locationId: String?, title: String?, artist: String?) -> Unit,
     onPlayAdjacentTrack: (offset: Int, wrapOverride: Boolean?, notifyWrap: Boolean) -> Boolean,
+    onGaplessTrackAdvanced: () -> Boolean,
     onRestartCurrentTrack: () -> Unit,
     onStopPlaybackAndUnload: () -> Unit,
     isLocalPlayableFile: (File?) -> Boolean
@@ -215,6 +219,22 @@ internal fun AppNavigationPlaybackPollEffects(
                 onIsPlayingChanged(nextIsPlaying)
                 localIsPlaying = nextIsPlaying
             }
+            // The engine already moved on to the announced next track. Checked
+            // before the seek/animation gate since the event is consumed once.
+            if (snapshot.gaplessTransition) {
+                val adopted = onGaplessTrackAdvanced()
+                if (!adopted) {
+                    // The announcement went stale; reload through the queue.
+                    val moved = when (activeRepeatModeProvider()) {
+                        RepeatMode.Playlist -> onPlayAdjacentTrack(1, true, false)
+                        else -> onPlayAdjacentTrack(1, false, false)
+                    }
+                    if (!moved) {
+                        onStopPlaybackAndUnload()
+                    }
+                }
+                continue
+            }
 
             if (!nextSeekInProgress && !isAnimating) {
                 val suppressTrackEndEvents = nowMs < suppressTrackEndEventsUntilMs
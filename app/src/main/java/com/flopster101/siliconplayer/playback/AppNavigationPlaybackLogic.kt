@@ -332,6 +332,19 @@ internal fun loadTrackSnapshotForSelection(
     )
 }
 
+// For a track the engine already switched to gaplessly: nothing is loaded,
+// only the snapshot and the core's DSP settings are picked up.
+internal fun readGaplessTrackSnapshotForSelection(): NativeTrackSnapshot {
+    val snapshot = readNativeTrackSnapshot()
+    val decoderName = snapshot.decoderName?.trim()?.takeIf { it.isNotEmpty() } ?: readCurrentDecoderName()
+    if (decoderName != null) {
+        val context = NativeBridge.requireAppContext()
+        val prefs = context.getSharedPreferences(AppPreferenceKeys.PREFS_NAME, Context.MODE_PRIVATE)
+        applyEffectiveDspSettingsForCoreAction(prefs, decoderName)
+    }
+    return snapshot
+}
+
 internal fun selectSubtuneAndReadState(
     index: Int,
     selectedFile: File?,
@@ -8,6 +8,7 @@ import com.flopster101.siliconplayer.ResumeTarget
 import com.flopster101.siliconplayer.NativeTrackSnapshot
 import com.flopster101.siliconplayer.currentTrackIndexForList
 import com.flopster101.siliconplayer.loadTrackSnapshotForSelection
+import com.flopster101.siliconplayer.readGaplessTrackSnapshotForSelection
 import com.flopster101.siliconplayer.runWithNativeAudioSession
 import com.flopster101.siliconplayer.resolvePreviousTrackAction
 import com.flopster101.siliconplayer.resolveResumeTarget
@@ -103,6 +104,45 @@ internal suspend fun applyTrackSelectionAction(
     syncPlaybackService()
 }
 
+// The engine switched to the announced next track at the end of the current
+// one; bring the selection up to date without stopping or reloading it.
+internal suspend fun adoptGaplessTrackAction(
+    file: File,
+    locationIdOverride: String?,
+    onSelectedFileChanged: (File) -> Unit,
+    onCurrentPlaybackSourceIdChanged: (String) -> Unit,
+    loadSongVolumeForFile: (String) -> Unit,
+    onResolvedDecoderState: (String?) -> Unit,
+    applyNativeTrackSnapshot: (NativeTrackSnapshot) -> Unit,
+    refreshSubtuneState: () -> Unit,
+    onPositionChanged: (Double) -> Unit,
+    onArtworkBitmapCleared: () -> Unit,
+    refreshRepeatModeForTrack: () -> Unit,
+    onAddRecentPlayedTrack: (path: String, locationId: String?, title: String?, artist: String?) -> Unit,
+    metadataTitleProvider: () -> String,
+    metadataArtistProvider: () -> String,
+    scheduleRecentTrackMetadataRefresh: (String, String?) -> Unit,
+    syncPlaybackService: () -> Unit
+) {
+    val sourceId = file.absolutePath
+    onSelectedFileChanged(file)
+    onCurrentPlaybackSourceIdChanged(sourceId)
+    loadSongVolumeForFile(sourceId)
+    val nativeSnapshot = runWithNativeAudioSession {
+        readGaplessTrackSnapshotForSelection()
+    }
+    coroutineContext.ensureActive()
+    onResolvedDecoderState(nativeSnapshot.decoderName)
+    applyNativeTrackSnapshot(nativeSnapshot)
+    refreshSubtuneState()
+    onPositionChanged(0.0)
+    onArtworkBitmapCleared()
+    refreshRepeatModeForTrack()
+    onAddRecentPlayedTrack(sourceId, locationIdOverride, metadataTitleProvider(), metadataArtistProvider())
+    scheduleRecentTrackMetadataRefresh(sourceId, locationIdOverride)
+    syncPlaybackService()
+}
+
 internal fun resumeLastStoppedTrackAction(
     lastStoppedFile: File?,
     lastStoppedSourceId: String?,
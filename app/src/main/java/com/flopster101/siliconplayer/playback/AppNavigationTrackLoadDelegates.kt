@@ -3,6 +3,7 @@ package com.flopster101.siliconplayer
 import android.content.Context
 import android.content.SharedPreferences
 import com.flopster101.siliconplayer.restorePlayerStateFromSessionAndNativeAction
+import com.flopster101.siliconplayer.playback.adoptGaplessTrackAction
 import com.flopster101.siliconplayer.playback.applyTrackSelectionAction
 import com.flopster101.siliconplayer.data.FileRepository
 import java.io.File
@@ -111,6 +112,33 @@ internal class AppNavigationTrackLoadDelegates(
         }
     }
 
+    fun adoptGaplessTrack(file: File) {
+        ManualRemoteOpenCoordinator.cancelPendingOpenWork()
+        trackSelectionRequestId += 1L
+        onDeferredPlaybackSeekChanged(null)
+        currentTrackSelectionJob?.cancel()
+        currentTrackSelectionJob = appScope.launch {
+            adoptGaplessTrackAction(
+                file = file,
+                locationIdOverride = lastBrowserLocationIdProvider(),
+                onSelectedFileChanged = onSelectedFileChanged,
+                onCurrentPlaybackSourceIdChanged = onCurrentPlaybackSourceIdChanged,
+                loadSongVolumeForFile = loadSongVolumeForFile,
+                onResolvedDecoderState = onResolvedDecoderState,
+                applyNativeTrackSnapshot = { snapshot -> applyNativeTrackSnapshot(snapshot) },
+                refreshSubtuneState = refreshSubtuneState,
+                onPositionChanged = onPositionChanged,
+                onArtworkBitmapCleared = onArtworkBitmapCleared,
+                refreshRepeatModeForTrack = refreshRepeatModeForTrack,
+                onAddRecentPlayedTrack = onAddRecentPlayedTrack,
+                metadataTitleProvider = metadataTitleProvider,
+                metadataArtistProvider = metadataArtistProvider,
+                scheduleRecentTrackMetadataRefresh = scheduleRecentTrackMetadataRefresh,
+                syncPlaybackService = syncPlaybackService
+            )
+        }
+    }
+
     fun cancelPendingTrackSelection() {
         trackSelectionRequestId += 1L
         currentTrackSelectionJob?.cancel()
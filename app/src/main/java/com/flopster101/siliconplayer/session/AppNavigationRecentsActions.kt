@@ -4,6 +4,7 @@ import android.content.Context
 import android.media.MediaMetadataRetriever
 import android.net.Uri
 import com.flopster101.siliconplayer.RecentPathEntry
+import com.flopster101.siliconplayer.TRACK_PROBE_OK
 import com.flopster101.siliconplayer.samePath
 import com.flopster101.siliconplayer.NativeBridge
 import com.flopster101.siliconplayer.buildUpdatedRecentFolders
@@ -12,6 +13,7 @@ import com.flopster101.siliconplayer.ensureRecentArtworkThumbnailCached
 import com.flopster101.siliconplayer.mergeRecentPlayedTrackMetadata
 import com.flopster101.siliconplayer.mergeRecentPlayedTrackArtworkCacheKey
 import com.flopster101.siliconplayer.normalizeSourceIdentity
+import com.flopster101.siliconplayer.probeTrack
 import com.flopster101.siliconplayer.sourceLeafNameForDisplay
 import java.util.Locale
 import java.io.File
@@ -209,6 +211,16 @@ private fun readLocalTrackMetadata(sourceId: String): Pair<String, String>? {
     val file = File(localPath)
     if (!file.exists() || !file.isFile) return null
 
+    // The engine's decoders read the chip and tracker formats the platform
+    // retriever does not know; it stays as the fallback for the rest.
+    probeTrack(file.absolutePath)
+        ?.takeIf { it.status == TRACK_PROBE_OK }
+        ?.let { probe ->
+            val title = probe.title.trim()
+            val artist = probe.artist.trim()
+            if (title.isNotBlank() || artist.isNotBlank()) return Pair(title, artist)
+        }
+
     val retriever = MediaMetadataRetriever()
     return try {
         retriever.setDataSource(file.absolutePath)
@@ -92,7 +92,8 @@ private fun recommendedAudioBufferPresetForCurrentDevice(): AudioBufferPreset {
 
 enum class AudioResamplerPreference(val storageValue: String, val label: String, val nativeValue: Int) {
     BuiltIn("builtin", "Built-in", 1),
-    Sox("sox", "SoX (Experimental)", 2);
+    Sox("sox", "SoX (Experimental)", 2),
+    PolyphaseSinc("sinc", "Polyphase sinc", 3);
 
     companion object {
         fun fromStorage(value: String?): AudioResamplerPreference {
@@ -219,7 +219,7 @@ internal fun AudioBufferPresetSelectorCard(
 internal fun AudioResamplerSelectorCard(
     selectedPreference: AudioResamplerPreference,
     onSelectedPreferenceChanged: (AudioResamplerPreference) -> Unit,
-    description: String = "Choose the output resampler. SoX is experimental and falls back to built-in for discontinuous timeline cores."
+    description: String = "Choose the output resampler. Polyphase sinc is a higher quality built-in filter. SoX is experimental and falls back to built-in for discontinuous timeline cores."
 ) {
     SettingsEnumSelectorCard(
         title = "Output resampler",
@@ -227,6 +227,7 @@ internal fun AudioResamplerSelectorCard(
         selectedValue = selectedPreference,
         options = listOf(
             EnumChoice(AudioResamplerPreference.BuiltIn, AudioResamplerPreference.BuiltIn.label),
+            EnumChoice(AudioResamplerPreference.PolyphaseSinc, AudioResamplerPreference.PolyphaseSinc.label),
             EnumChoice(AudioResamplerPreference.Sox, AudioResamplerPreference.Sox.label)
         ),
         onSelected = onSelectedPreferenceChanged
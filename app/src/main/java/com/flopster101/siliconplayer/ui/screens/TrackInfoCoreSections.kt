@@ -69,6 +69,7 @@ internal fun TrackInfoCoreSections(
             if (metadata.ffmpeg.sampleFormatName.isNotBlank()) TrackInfoDetailsRow("Sample format", metadata.ffmpeg.sampleFormatName)
             if (metadata.ffmpeg.channelLayoutName.isNotBlank()) TrackInfoDetailsRow("Channel layout", metadata.ffmpeg.channelLayoutName)
             if (metadata.ffmpeg.encoderName.isNotBlank()) TrackInfoDetailsRow("Encoder", metadata.ffmpeg.encoderName)
+            formatReadAheadStats(metadata.ffmpeg)?.let { TrackInfoDetailsRow("SMB read-ahead", it) }
         }
 
         decoderName.equals(DecoderNames.GAME_MUSIC_EMU, ignoreCase = true) -> {
@@ -272,6 +273,7 @@ internal fun appendCoreTrackInfoCopyRows(
             if (metadata.ffmpeg.sampleFormatName.isNotBlank()) row("Sample format", metadata.ffmpeg.sampleFormatName)
             if (metadata.ffmpeg.channelLayoutName.isNotBlank()) row("Channel layout", metadata.ffmpeg.channelLayoutName)
             if (metadata.ffmpeg.encoderName.isNotBlank()) row("Encoder", metadata.ffmpeg.encoderName)
+            formatReadAheadStats(metadata.ffmpeg)?.let { row("SMB read-ahead", it) }
         }
 
         decoderName.equals(DecoderNames.GAME_MUSIC_EMU, ignoreCase = true) -> {
@@ -429,6 +431,19 @@ internal fun appendCoreTrackInfoCopyRows(
     }
 }
 
+private fun formatReadAheadStats(ffmpeg: FfmpegMetadata): String? {
+    if (ffmpeg.readAheadHits < 0L) return null
+    return String.format(
+        Locale.US,
+        "%d hits, %d misses, %d stalls (%.1f ms), %s fetched",
+        ffmpeg.readAheadHits,
+        ffmpeg.readAheadMisses,
+        ffmpeg.readAheadStalls,
+        ffmpeg.readAheadStallNs / 1_000_000.0,
+        formatFileSize(ffmpeg.readAheadFetchedBytes)
+    )
+}
+
 @Composable
 private fun TrackInfoSectionHeader(title: String) {
     Spacer(modifier = Modifier.height(6.dp))
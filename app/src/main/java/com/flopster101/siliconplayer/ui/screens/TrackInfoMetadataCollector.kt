@@ -43,7 +43,13 @@ internal data class FfmpegMetadata(
     val containerName: String = "",
     val sampleFormatName: String = "",
     val channelLayoutName: String = "",
-    val encoderName: String = ""
+    val encoderName: String = "",
+    // SMB read-ahead cache counters; -1 when the track is not read over SMB.
+    val readAheadHits: Long = -1L,
+    val readAheadMisses: Long = -1L,
+    val readAheadStalls: Long = -1L,
+    val readAheadStallNs: Long = -1L,
+    val readAheadFetchedBytes: Long = -1L
 )
 
 internal data class GmeMetadata(
@@ -226,9 +232,10 @@ internal fun rememberTrackInfoLiveMetadata(
 
     LaunchedEffect(filePath, decoderName, isDialogVisible) {
         if (!isDialogVisible) return@LaunchedEffect
+        val snapshot = TrackInfoSnapshot()
         while (isDialogVisible) {
             metadata = withContext(Dispatchers.PlaybackIo) {
-                queryTrackInfoLiveMetadata(decoderName)
+                buildTrackInfoLiveMetadata(decoderName, snapshot.refresh())
             }
             delay(500)
         }
@@ -237,221 +244,276 @@ internal fun rememberTrackInfoLiveMetadata(
     return metadata
 }
 
-private fun queryTrackInfoLiveMetadata(decoderName: String?): TrackInfoLiveMetadata {
+// Keeps the static half of the native track info snapshot between polls;
+// only the live fields cross JNI again until the engine bumps the static
+// version, and nothing but the version while neither half changed.
+private class TrackInfoSnapshot {
+    private var version = -1L
+    private var staticFields: Map<String, String> = emptyMap()
+    private var fields: Map<String, String> = emptyMap()
+
+    fun refresh(): Map<String, String> {
+        val packed = NativeBridge.getTrackInfoSnapshot(version)
+        if (packed.isEmpty()) return emptyMap()
+        val packedVersion = packed[0].toLongOrNull() ?: -1L
+        if (packed.size < 2) {
+            return if (packedVersion == version) fields else emptyMap()
+        }
+        var index = 2
+        if ((packedVersion ushr 32) != (version ushr 32)) {
+            val staticPairs = packed[1].toIntOrNull() ?: 0
+            staticFields = readPairs(packed, index, staticPairs)
+            index += staticPairs * 2
+        }
+        version = packedVersion
+        fields = staticFields + readPairs(packed, index, (packed.size - index) / 2)
+        return fields
+    }
+
+    private fun readPairs(packed: Array<String>, start: Int, count: Int): Map<String, String> {
+        val result = HashMap<String, String>(count * 2)
+        for (pair in 0 until count) {
+            val keyIndex = start + pair * 2
+            if (keyIndex + 1 >= packed.size) break
+            result[packed[keyIndex]] = packed[keyIndex + 1]
+        }
+        return result
+    }
+}
+
+private fun Map<String, String>.string(key: String): String = this[key].orEmpty()
+
+private fun Map<String, String>.int(key: String, fallback: Int = 0): Int = this[key]?.toIntOrNull() ?: fallback
+
+private fun Map<String, String>.long(key: String, fallback: Long = 0L): Long = this[key]?.toLongOrNull() ?: fallback
+
+private fun Map<String, String>.bool(key: String): Boolean = int(key) != 0
+
+private fun Map<String, String>.float(key: String): Float = this[key]?.toFloatOrNull() ?: 0.0f
+
+private fun buildTrackInfoLiveMetadata(
+    decoderName: String?,
+    fields: Map<String, String>
+): TrackInfoLiveMetadata {
     val common = TrackInfoLiveMetadata(
-        bitrate = NativeBridge.getTrackBitrate(),
-        isVbr = NativeBridge.isTrackVBR(),
-        audioBackendLabel = NativeBridge.getAudioBackendLabel(),
-        renderRateHz = NativeBridge.getDecoderRenderSampleRateHz(),
-        outputRateHz = NativeBridge.getOutputStreamSampleRateHz(),
-        composer = NativeBridge.getTrackComposer(),
-        genre = NativeBridge.getTrackGenre(),
-        album = NativeBridge.getTrackAlbum(),
-        year = NativeBridge.getTrackYear(),
-        date = NativeBridge.getTrackDate(),
-        copyrightText = NativeBridge.getTrackCopyright(),
-        comment = NativeBridge.getTrackComment()
+        bitrate = fields.long("bitrate"),
+        isVbr = fields.bool("isVbr"),
+        audioBackendLabel = fields["audioBackend"] ?: "(inactive)",
+        renderRateHz = fields.int("renderRateHz"),
+        outputRateHz = fields.int("outputRateHz"),
+        composer = fields.string("composer"),
+        genre = fields.string("genre"),
+        album = fields.string("album"),
+        year = fields.string("year"),
+        date = fields.string("date"),
+        copyrightText = fields.string("copyright"),
+        comment = fields.string("comment")
     )
 
     return when {
         decoderName.equals(DecoderNames.LIB_OPEN_MPT, ignoreCase = true) -> common.copy(
             openMpt = OpenMptMetadata(
-                typeLong = NativeBridge.getOpenMptModuleTypeLong(),
-                tracker = NativeBridge.getOpenMptTracker(),
-                songMessage = NativeBridge.getOpenMptSongMessage(),
-                orderCount = NativeBridge.getOpenMptOrderCount(),
-                patternCount = NativeBridge.getOpenMptPatternCount(),
-                instrumentCount = NativeBridge.getOpenMptInstrumentCount(),
-                sampleCount = NativeBridge.getOpenMptSampleCount(),
-                instrumentNames = NativeBridge.getOpenMptInstrumentNames(),
-                sampleNames = NativeBridge.getOpenMptSampleNames()
+                typeLong = fields.string("core.moduleTypeLong"),
+                tracker = fields.string("core.tracker"),
+                songMessage = fields.string("core.songMessage"),
+                orderCount = fields.int("core.orderCount"),
+                patternCount = fields.int("core.patternCount"),
+                instrumentCount = fields.int("core.instrumentCount"),
+                sampleCount = fields.int("core.sampleCount"),
+                instrumentNames = fields.string("core.instrumentNames"),
+                sampleNames = fields.string("core.sampleNames")
             )
         )
 
         decoderName.equals(DecoderNames.VGM_PLAY, ignoreCase = true) -> common.copy(
             vgmPlay = VgmPlayMetadata(
-                gameName = NativeBridge.getVgmGameName(),
-                systemName = NativeBridge.getVgmSystemName(),
-                releaseDate = NativeBridge.getVgmReleaseDate(),
-                encodedBy = NativeBridge.getVgmEncodedBy(),
-                notes = NativeBridge.getVgmNotes(),
-                fileVersion = NativeBridge.getVgmFileVersion(),
-                deviceCount = NativeBridge.getVgmDeviceCount(),
-                usedChipList = NativeBridge.getVgmUsedChipList(),
-                hasLoopPoint = NativeBridge.getVgmHasLoopPoint()
+                gameName = fields.string("core.gameName"),
+                systemName = fields.string("core.systemName"),
+                releaseDate = fields.string("core.releaseDate"),
+                encodedBy = fields.string("core.encodedBy"),
+                notes = fields.string("core.notes"),
+                fileVersion = fields.string("core.fileVersion"),
+                deviceCount = fields.int("core.deviceCount"),
+                usedChipList = fields.string("core.usedChipList"),
+                hasLoopPoint = fields.bool("core.hasLoopPoint")
             )
         )
 
         decoderName.equals(DecoderNames.FFMPEG, ignoreCase = true) -> common.copy(
             ffmpeg = FfmpegMetadata(
-                codecName = NativeBridge.getFfmpegCodecName(),
-                containerName = NativeBridge.getFfmpegContainerName(),
-                sampleFormatName = NativeBridge.getFfmpegSampleFormatName(),
-                channelLayoutName = NativeBridge.getFfmpegChannelLayoutName(),
-                encoderName = NativeBridge.getFfmpegEncoderName()
+                codecName = fields.string("core.codecName"),
+                containerName = fields.string("core.containerName"),
+                sampleFormatName = fields.string("core.sampleFormatName"),
+                channelLayoutName = fields.string("core.channelLayoutName"),
+                encoderName = fields.string("core.encoderName"),
+                readAheadHits = fields.long("core.readAheadHits", -1L),
+                readAheadMisses = fields.long("core.readAheadMisses", -1L),
+                readAheadStalls = fields.long("core.readAheadStalls", -1L),
+                readAheadStallNs = fields.long("core.readAheadStallNs", -1L),
+                readAheadFetchedBytes = fields.long("core.readAheadFetchedBytes", -1L)
             )
         )
 
         decoderName.equals(DecoderNames.GAME_MUSIC_EMU, ignoreCase = true) -> common.copy(
             gme = GmeMetadata(
-                systemName = NativeBridge.getGmeSystemName(),
-                gameName = NativeBridge.getGmeGameName(),
-                copyright = NativeBridge.getGmeCopyright(),
-                comment = NativeBridge.getGmeComment(),
-                dumper = NativeBridge.getGmeDumper(),
-                trackCount = NativeBridge.getGmeTrackCount(),
-                voiceCount = NativeBridge.getGmeVoiceCount(),
-                hasLoopPoint = NativeBridge.getGmeHasLoopPoint(),
-                loopStartMs = NativeBridge.getGmeLoopStartMs(),
-                loopLengthMs = NativeBridge.getGmeLoopLengthMs()
+                systemName = fields.string("core.systemName"),
+                gameName = fields.string("core.gameName"),
+                copyright = fields.string("core.copyright"),
+                comment = fields.string("core.comment"),
+                dumper = fields.string("core.dumper"),
+                trackCount = fields.int("core.trackCount"),
+                voiceCount = fields.int("core.voiceCount"),
+                hasLoopPoint = fields.bool("core.hasLoopPoint"),
+                loopStartMs = fields.int("core.loopStartMs", -1),
+                loopLengthMs = fields.int("core.loopLengthMs", -1)
             )
         )
 
         decoderName.equals(DecoderNames.LAZY_USF2, ignoreCase = true) -> common.copy(
             lazyUsf2 = LazyUsf2Metadata(
-                gameName = NativeBridge.getLazyUsf2GameName(),
-                copyright = NativeBridge.getLazyUsf2Copyright(),
-                year = NativeBridge.getLazyUsf2Year(),
-                usfBy = NativeBridge.getLazyUsf2UsfBy(),
-                lengthTag = NativeBridge.getLazyUsf2LengthTag(),
-                fadeTag = NativeBridge.getLazyUsf2FadeTag(),
-                enableCompare = NativeBridge.getLazyUsf2EnableCompare(),
-                enableFifoFull = NativeBridge.getLazyUsf2EnableFifoFull()
+                gameName = fields.string("core.gameName"),
+                copyright = fields.string("core.copyright"),
+                year = fields.string("core.year"),
+                usfBy = fields.string("core.usfBy"),
+                lengthTag = fields.string("core.lengthTag"),
+                fadeTag = fields.string("core.fadeTag"),
+                enableCompare = fields.bool("core.enableCompare"),
+                enableFifoFull = fields.bool("core.enableFifoFull")
             )
         )
 
         decoderName.equals(DecoderNames.VIO2_SF, ignoreCase = true) -> common.copy(
             vio2sf = Vio2sfMetadata(
-                gameName = NativeBridge.getVio2sfGameName(),
-                copyright = NativeBridge.getVio2sfCopyright(),
-                year = NativeBridge.getVio2sfYear(),
-                comment = NativeBridge.getVio2sfComment(),
-                lengthTag = NativeBridge.getVio2sfLengthTag(),
-                fadeTag = NativeBridge.getVio2sfFadeTag()
+                gameName = fields.string("core.gameName"),
+                copyright = fields.string("core.copyright"),
+                year = fields.string("core.year"),
+                comment = fields.string("core.comment"),
+                lengthTag = fields.string("core.lengthTag"),
+                fadeTag = fields.string("core.fadeTag")
             )
         )
 
         decoderName.equals(DecoderNames.C_RSID, ignoreCase = true) ||
             decoderName.equals(DecoderNames.LIB_SID_PLAY_FP, ignoreCase = true) -> common.copy(
             sid = SidMetadata(
-                formatName = NativeBridge.getSidFormatName(),
-                clockName = NativeBridge.getSidClockName(),
-                speedName = NativeBridge.getSidSpeedName(),
-                compatibilityName = NativeBridge.getSidCompatibilityName(),
-                backendName = NativeBridge.getSidBackendName(),
-                chipCount = NativeBridge.getSidChipCount(),
-                modelSummary = NativeBridge.getSidModelSummary(),
-                currentModelSummary = NativeBridge.getSidCurrentModelSummary(),
-                baseAddressSummary = NativeBridge.getSidBaseAddressSummary(),
-                commentSummary = NativeBridge.getSidCommentSummary()
+                formatName = fields.string("core.sidFormatName"),
+                clockName = fields.string("core.sidClockName"),
+                speedName = fields.string("core.sidSpeedName"),
+                compatibilityName = fields.string("core.sidCompatibilityName"),
+                backendName = fields.string("core.sidBackendName"),
+                chipCount = fields.int("core.sidChipCount"),
+                modelSummary = fields.string("core.sidModelSummary"),
+                currentModelSummary = fields.string("core.sidCurrentModelSummary"),
+                baseAddressSummary = fields.string("core.sidBaseAddressSummary"),
+                commentSummary = fields.string("core.sidCommentSummary")
             )
         )
 
         decoderName.equals(DecoderNames.SC68, ignoreCase = true) -> common.copy(
             sc68 = Sc68Metadata(
-                formatName = NativeBridge.getSc68FormatName(),
-                hardwareName = NativeBridge.getSc68HardwareName(),
-                platformName = NativeBridge.getSc68PlatformName(),
-                replayName = NativeBridge.getSc68ReplayName(),
-                replayRateHz = NativeBridge.getSc68ReplayRateHz(),
-                trackCount = NativeBridge.getSc68TrackCount(),
-                albumName = NativeBridge.getSc68AlbumName(),
-                year = NativeBridge.getSc68Year(),
-                ripper = NativeBridge.getSc68Ripper(),
-                converter = NativeBridge.getSc68Converter(),
-                timer = NativeBridge.getSc68Timer(),
-                canAsid = NativeBridge.getSc68CanAsid(),
-                usesYm = NativeBridge.getSc68UsesYm(),
-                usesSte = NativeBridge.getSc68UsesSte(),
-                usesAmiga = NativeBridge.getSc68UsesAmiga()
+                formatName = fields.string("core.formatName"),
+                hardwareName = fields.string("core.hardwareName"),
+                platformName = fields.string("core.platformName"),
+                replayName = fields.string("core.replayName"),
+                replayRateHz = fields.int("core.replayRateHz"),
+                trackCount = fields.int("core.trackCount"),
+                albumName = fields.string("core.albumName"),
+                year = fields.string("core.year"),
+                ripper = fields.string("core.ripper"),
+                converter = fields.string("core.converter"),
+                timer = fields.string("core.timer"),
+                canAsid = fields.bool("core.canAsid"),
+                usesYm = fields.bool("core.usesYm"),
+                usesSte = fields.bool("core.usesSte"),
+                usesAmiga = fields.bool("core.usesAmiga")
             )
         )
 
         decoderName.equals(DecoderNames.AD_PLUG, ignoreCase = true) -> common.copy(
             adplug = AdplugMetadata(
-                description = NativeBridge.getAdplugDescription(),
-                patternCount = NativeBridge.getAdplugPatternCount(),
-                currentPattern = NativeBridge.getAdplugCurrentPattern(),
-                orderCount = NativeBridge.getAdplugOrderCount(),
-                currentOrder = NativeBridge.getAdplugCurrentOrder(),
-                currentRow = NativeBridge.getAdplugCurrentRow(),
-                currentSpeed = NativeBridge.getAdplugCurrentSpeed(),
-                instrumentCount = NativeBridge.getAdplugInstrumentCount(),
-                instrumentNames = NativeBridge.getAdplugInstrumentNames()
+                description = fields.string("core.description"),
+                patternCount = fields.int("core.patternCount"),
+                currentPattern = fields.int("core.currentPattern"),
+                orderCount = fields.int("core.orderCount"),
+                currentOrder = fields.int("core.currentOrder"),
+                currentRow = fields.int("core.currentRow"),
+                currentSpeed = fields.int("core.currentSpeed"),
+                instrumentCount = fields.int("core.instrumentCount"),
+                instrumentNames = fields.string("core.instrumentNames")
             )
         )
 
         decoderName.equals(DecoderNames.HIVELY_TRACKER, ignoreCase = true) -> common.copy(
             hivelyTracker = HivelyTrackerMetadata(
-                formatName = NativeBridge.getHivelyFormatName(),
-                formatVersion = NativeBridge.getHivelyFormatVersion(),
-                positionCount = NativeBridge.getHivelyPositionCount(),
-                restartPosition = NativeBridge.getHivelyRestartPosition(),
-                trackLengthRows = NativeBridge.getHivelyTrackLengthRows(),
-                trackCount = NativeBridge.getHivelyTrackCount(),
-                instrumentCount = NativeBridge.getHivelyInstrumentCount(),
-                speedMultiplier = NativeBridge.getHivelySpeedMultiplier(),
-                currentPosition = NativeBridge.getHivelyCurrentPosition(),
-                currentRow = NativeBridge.getHivelyCurrentRow(),
-                currentTempo = NativeBridge.getHivelyCurrentTempo(),
-                mixGainPercent = NativeBridge.getHivelyMixGainPercent(),
-                instrumentNames = NativeBridge.getHivelyInstrumentNames()
+                formatName = fields.string("core.formatName"),
+                formatVersion = fields.int("core.formatVersion"),
+                positionCount = fields.int("core.positionCount"),
+                restartPosition = fields.int("core.restartPosition", -1),
+                trackLengthRows = fields.int("core.trackLengthRows"),
+                trackCount = fields.int("core.trackCount"),
+                instrumentCount = fields.int("core.instrumentCount"),
+                speedMultiplier = fields.int("core.speedMultiplier"),
+                currentPosition = fields.int("core.currentPosition", -1),
+                currentRow = fields.int("core.currentRow", -1),
+                currentTempo = fields.int("core.currentTempo"),
+                mixGainPercent = fields.int("core.mixGainPercent"),
+                instrumentNames = fields.string("core.instrumentNames")
             )
         )
 
         decoderName.matchesDecoderName(DecoderNames.KLYSTRACK) -> common.copy(
             klystrack = KlystrackMetadata(
-                formatName = NativeBridge.getKlystrackFormatName(),
-                trackCount = NativeBridge.getKlystrackTrackCount(),
-                instrumentCount = NativeBridge.getKlystrackInstrumentCount(),
-                songLengthRows = NativeBridge.getKlystrackSongLengthRows(),
-                currentRow = NativeBridge.getKlystrackCurrentRow(),
-                instrumentNames = NativeBridge.getKlystrackInstrumentNames()
+                formatName = fields.string("core.formatName"),
+                trackCount = fields.int("core.trackCount"),
+                instrumentCount = fields.int("core.instrumentCount"),
+                songLengthRows = fields.int("core.songLengthRows"),
+                currentRow = fields.int("core.currentRow", -1),
+                instrumentNames = fields.string("core.instrumentNames")
             )
         )
 
         decoderName.equals(DecoderNames.FURNACE, ignoreCase = true) -> common.copy(
             furnace = FurnaceMetadata(
-                formatName = NativeBridge.getFurnaceFormatName(),
-                songVersion = NativeBridge.getFurnaceSongVersion(),
-                systemName = NativeBridge.getFurnaceSystemName(),
-                systemNames = NativeBridge.getFurnaceSystemNames(),
-                systemCount = NativeBridge.getFurnaceSystemCount(),
-                songChannelCount = NativeBridge.getFurnaceSongChannelCount(),
-                instrumentCount = NativeBridge.getFurnaceInstrumentCount(),
-                wavetableCount = NativeBridge.getFurnaceWavetableCount(),
-                sampleCount = NativeBridge.getFurnaceSampleCount(),
-                orderCount = NativeBridge.getFurnaceOrderCount(),
-                rowsPerPattern = NativeBridge.getFurnaceRowsPerPattern(),
-                currentOrder = NativeBridge.getFurnaceCurrentOrder(),
-                currentRow = NativeBridge.getFurnaceCurrentRow(),
-                currentTick = NativeBridge.getFurnaceCurrentTick(),
-                currentSpeed = NativeBridge.getFurnaceCurrentSpeed(),
-                grooveLength = NativeBridge.getFurnaceGrooveLength(),
-                currentHz = NativeBridge.getFurnaceCurrentHz()
+                formatName = fields.string("core.formatName"),
+                songVersion = fields.int("core.songVersion"),
+                systemName = fields.string("core.systemName"),
+                systemNames = fields.string("core.systemNames"),
+                systemCount = fields.int("core.systemCount"),
+                songChannelCount = fields.int("core.songChannelCount"),
+                instrumentCount = fields.int("core.instrumentCount"),
+                wavetableCount = fields.int("core.wavetableCount"),
+                sampleCount = fields.int("core.sampleCount"),
+                orderCount = fields.int("core.orderCount"),
+                rowsPerPattern = fields.int("core.rowsPerPattern"),
+                currentOrder = fields.int("core.currentOrder", -1),
+                currentRow = fields.int("core.currentRow", -1),
+                currentTick = fields.int("core.currentTick", -1),
+                currentSpeed = fields.int("core.currentSpeed"),
+                grooveLength = fields.int("core.grooveLength"),
+                currentHz = fields.float("core.currentHz")
             )
         )
 
         decoderName.equals(DecoderNames.UADE, ignoreCase = true) -> common.copy(
             uade = UadeMetadata(
-                formatName = NativeBridge.getUadeFormatName(),
-                moduleName = NativeBridge.getUadeModuleName(),
-                playerName = NativeBridge.getUadePlayerName(),
-                moduleFileName = NativeBridge.getUadeModuleFileName(),
-                playerFileName = NativeBridge.getUadePlayerFileName(),
-                moduleMd5 = NativeBridge.getUadeModuleMd5(),
-                detectionExtension = NativeBridge.getUadeDetectionExtension(),
-                detectedFormatName = NativeBridge.getUadeDetectedFormatName(),
-                detectedFormatVersion = NativeBridge.getUadeDetectedFormatVersion(),
-                detectionByContent = NativeBridge.getUadeDetectionByContent(),
-                detectionIsCustom = NativeBridge.getUadeDetectionIsCustom(),
-                subsongMin = NativeBridge.getUadeSubsongMin(),
-                subsongMax = NativeBridge.getUadeSubsongMax(),
-                subsongDefault = NativeBridge.getUadeSubsongDefault(),
-                currentSubsong = NativeBridge.getUadeCurrentSubsong(),
-                moduleBytes = NativeBridge.getUadeModuleBytes(),
-                songBytes = NativeBridge.getUadeSongBytes(),
-                subsongBytes = NativeBridge.getUadeSubsongBytes()
+                formatName = fields.string("core.formatName"),
+                moduleName = fields.string("core.moduleName"),
+                playerName = fields.string("core.playerName"),
+                moduleFileName = fields.string("core.moduleFileName"),
+                playerFileName = fields.string("core.playerFileName"),
+                moduleMd5 = fields.string("core.moduleMd5"),
+                detectionExtension = fields.string("core.detectionExtension"),
+                detectedFormatName = fields.string("core.detectedFormatName"),
+                detectedFormatVersion = fields.string("core.detectedFormatVersion"),
+                detectionByContent = fields.bool("core.detectionByContent"),
+                detectionIsCustom = fields.bool("core.detectionIsCustom"),
+                subsongMin = fields.int("core.subsongMin"),
+                subsongMax = fields.int("core.subsongMax"),
+                subsongDefault = fields.int("core.subsongDefault"),
+                currentSubsong = fields.int("core.currentSubsong"),
+                moduleBytes = fields.long("core.moduleBytes"),
+                songBytes = fields.long("core.songBytes"),
+                subsongBytes = fields.long("core.subsongBytes")
             )
         )
 
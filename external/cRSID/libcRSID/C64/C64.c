@@ -2,6 +2,8 @@
 //C64 emulation (SID-playback related)
 
 
+#include <string.h>
+
 #include "../libcRSID.h"
 
 #include "MEM.c"
@@ -12,83 +14,95 @@
 
 #include "C64_SIDrouting.c"
 
-static INLINE void cRSID_setPSIDplayBank () {
- if (cRSID.PlayAddress == 0) return;
+static INLINE void cRSID_setPSIDplayBank (FASTVAR cRSID_C64instance *const C64) {
+ if (C64->Interface->PlayAddress == 0) return;
 
- if (cRSID.PlayAddress >= 0xE000) cRSID_C64.RAMbank[1] = 0x35;
- else if (cRSID.PlayAddress >= 0xD000) cRSID_C64.RAMbank[1] = 0x34;
- else if (cRSID.PlayAddress >= 0xA000) cRSID_C64.RAMbank[1] = 0x36;
- else cRSID_C64.RAMbank[1] = 0x37;
+ if (C64->Interface->PlayAddress >= 0xE000) C64->RAMbank[1] = 0x35;
+ else if (C64->Interface->PlayAddress >= 0xD000) C64->RAMbank[1] = 0x34;
+ else if (C64->Interface->PlayAddress >= 0xA000) C64->RAMbank[1] = 0x36;
+ else C64->RAMbank[1] = 0x37;
 }
 
 
 
-cRSID_C64instance* cRSID_createC64 (unsigned short samplerate) { //init a basic PAL C64 instance
+cRSID_C64instance* cRSID_createC64 (cRSID_C64instance* C64, unsigned short samplerate) { //init a basic PAL C64 instance
  //static cRSID_C64instance* C64 = &cRSID_C64;
 
  //enum C64clocks { C64_PAL_CPUCLK=985248, DEFAULT_SAMPLERATE=44100 };
  static enum { VOLUME_MAX=0xF, CHANNELS=3+1, SID_FULLVOLUME = (CHANNELS*VOLUME_MAX) /*64*/ } SIDspecs; //digi-channel is counted too in attenuation
 
- if(samplerate) cRSID_C64.SampleRate = samplerate;
- else cRSID_C64.SampleRate = samplerate = CRSID_DEFAULT_SAMPLERATE;
- cRSID_C64.SampleClockRatio = (CRSID_PAL_CPUCLK << CRSID_CLOCK_FRACTIONAL_BITS) / samplerate; //shifting (multiplication) enhances SampleClockRatio precision
- cRSID_C64.OversampleClockRatio = (samplerate << CRSID_RESAMPLER_FRACTIONAL_BITS) / CRSID_PAL_AUDIO_CLOCK; //round( SID_AUDIO_CLOCK / C64->SampleRate );
- cRSID_C64.OversampleClockRatioReciproc = CRSID_PAL_AUDIO_CLOCK / cRSID_C64.SampleRate; //round?
-
- cRSID_C64.SIDchipCount=cRSID_C64.AudioThread_SIDchipCount=1; //init audio-thread's version as well
- cRSID_C64.Attenuation = ((SID_FULLVOLUME+26) * CRSID_PRESAT_ATT_NOM) / (CRSID_PRESAT_ATT_DENOM * CRSID_WAVGEN_PREDIV);
+ if(samplerate) C64->SampleRate = samplerate;
+ else C64->SampleRate = samplerate = CRSID_DEFAULT_SAMPLERATE;
+ C64->SampleClockRatio = (CRSID_PAL_CPUCLK << CRSID_CLOCK_FRACTIONAL_BITS) / samplerate; //shifting (multiplication) enhances SampleClockRatio precision
+ C64->OversampleClockRatio = (samplerate << CRSID_RESAMPLER_FRACTIONAL_BITS) / CRSID_PAL_AUDIO_CLOCK; //round( SID_AUDIO_CLOCK / C64->SampleRate );
+ C64->OversampleClockRatioReciproc = CRSID_PAL_AUDIO_CLOCK / C64->SampleRate; //round?
+
+ C64->SIDchipCount=C64->AudioThread_SIDchipCount=1; //init audio-thread's version as well
+ C64->Attenuation = ((SID_FULLVOLUME+26) * CRSID_PRESAT_ATT_NOM) / (CRSID_PRESAT_ATT_DENOM * CRSID_WAVGEN_PREDIV);
+ //states kept between samples by the SID-routing/output stages, reset so every (re)created instance renders the same:
+ C64->VUmeterUpdateCounter = 0; C64->MixedOutput.L = C64->MixedOutput.R = 0;
+ memset( C64->OversamplerNonFilt, 0, sizeof(C64->OversamplerNonFilt) ); memset( C64->OversamplerPrevNonFilt, 0, sizeof(C64->OversamplerPrevNonFilt) );
+ memset( C64->OversamplerFilt, 0, sizeof(C64->OversamplerFilt) ); memset( C64->OversamplerPrevFilt, 0, sizeof(C64->OversamplerPrevFilt) );
+ C64->ResampleBufPos = 0; C64->NextResampleBufPos = (1 << CRSID_RESAMPLER_FRACTIONAL_BITS);
+ memset( C64->ResampleBufferL, 0, sizeof(C64->ResampleBufferL) ); memset( C64->ResampleBufferR, 0, sizeof(C64->ResampleBufferR) );
+ C64->PSIDdigiPlaybackEnabled = C64->PSIDdigiNybbleCounter = C64->PSIDdigiRepeatCounter = 0;
+ C64->PSIDdigiSampleAddress = 0; C64->PSIDdigiOutput = C64->PSIDdigiPeriodCounter = 0;
+ C64->DitherLFSR = 0x0055A5AA;
+ C64->Active6581FilterPreset = 0xFF; //(tables get built by cRSID_configure6581FilterPreset())
+ C64->ActiveCutoffMul6581_44100Hz = cRSID_CutoffMul6581_44100Hz_Stock;
+ C64->ActiveCutoffMul6581_OverSampleRate = cRSID_CutoffMul6581_OverSampleRate_Stock;
  //cRSID_C64.CPU.C64 = C64;
- cRSID_createSIDchip ( &cRSID_C64.SID[1], 8580, CRSID_CHANNEL_BOTH, 0xD400 ); //default C64 setup with only 1 SID and 2 CIAs and 1 VIC
- cRSID_createCIAchip ( &cRSID_C64.CIA[1], 0xDC00 );
- cRSID_createCIAchip ( &cRSID_C64.CIA[2], 0xDD00 );
- cRSID_createVICchip ( 0xD000 );
- cRSID_generateMemoryBankPointers();
+ cRSID_createSIDchip ( C64, &C64->SID[1], 8580, CRSID_CHANNEL_BOTH, 0xD400 ); //default C64 setup with only 1 SID and 2 CIAs and 1 VIC
+ cRSID_createCIAchip ( C64, &C64->CIA[1], 0xDC00 );
+ cRSID_createCIAchip ( C64, &C64->CIA[2], 0xDD00 );
+ cRSID_createVICchip ( C64, 0xD000 );
+ cRSID_generateMemoryBankPointers(C64);
  //if(cRSID.RealSIDmode) {
-  cRSID_setROMcontent();
+  cRSID_setROMcontent(C64);
  //}
- cRSID_initC64();
- return &cRSID_C64;
+ cRSID_resetC64(C64);
+ return C64;
 }
 
 
 
-void cRSID_setSIDmodels () { //based on SIDheader-data
+void cRSID_setSIDmodelsC64 (cRSID_C64instance* C64) { //based on SIDheader-data
  short SIDmodel;
 
- SIDmodel = (cRSID.SIDheader->ModelFormatStandard&0x30) >= 0x20 ? 8580:6581;
- cRSID_C64.SID[1].ChipModel = cRSID.SelectedSIDmodel? cRSID.SelectedSIDmodel : SIDmodel;
+ SIDmodel = (C64->Interface->SIDheader->ModelFormatStandard&0x30) >= 0x20 ? 8580:6581;
+ C64->SID[1].ChipModel = C64->Interface->SelectedSIDmodel? C64->Interface->SelectedSIDmodel : SIDmodel;
 
- if (cRSID.SIDheader->Version != CRSID_FILEVERSION_WEBSID) {
-  SIDmodel = cRSID.SIDheader->ModelFormatStandard & 0xC0;
-  if (SIDmodel) SIDmodel = (SIDmodel >= 0x80) ? 8580:6581; else SIDmodel = cRSID_C64.SID[1].ChipModel;
-  if (cRSID.SelectedSIDmodel) SIDmodel = cRSID.SelectedSIDmodel;
-  cRSID_C64.SID[2].ChipModel = SIDmodel;
+ if (C64->Interface->SIDheader->Version != CRSID_FILEVERSION_WEBSID) {
+  SIDmodel = C64->Interface->SIDheader->ModelFormatStandard & 0xC0;
+  if (SIDmodel) SIDmodel = (SIDmodel >= 0x80) ? 8580:6581; else SIDmodel = C64->SID[1].ChipModel;
+  if (C64->Interface->SelectedSIDmodel) SIDmodel = C64->Interface->SelectedSIDmodel;
+  C64->SID[2].ChipModel = SIDmodel;
 
-  SIDmodel = cRSID.SIDheader->ModelFormatStandardH & 0x03;
-  if (SIDmodel) SIDmodel = (SIDmodel >= 0x02) ? 8580:6581; else SIDmodel = cRSID_C64.SID[1].ChipModel;
-  if (cRSID.SelectedSIDmodel) SIDmodel = cRSID.SelectedSIDmodel;
-  cRSID_C64.SID[3].ChipModel = SIDmodel;
+  SIDmodel = C64->Interface->SIDheader->ModelFormatStandardH & 0x03;
+  if (SIDmodel) SIDmodel = (SIDmodel >= 0x02) ? 8580:6581; else SIDmodel = C64->SID[1].ChipModel;
+  if (C64->Interface->SelectedSIDmodel) SIDmodel = C64->Interface->SelectedSIDmodel;
+  C64->SID[3].ChipModel = SIDmodel;
  }
  else {
-  SIDmodel = cRSID.SIDheader->SID2flagsL & 0x30;
-  if (SIDmodel) SIDmodel = (SIDmodel >= 0x20) ? 8580:6581; else SIDmodel = cRSID_C64.SID[1].ChipModel;
-  if (cRSID.SelectedSIDmodel) SIDmodel = cRSID.SelectedSIDmodel;
-  cRSID_C64.SID[2].ChipModel = SIDmodel;
-
-  SIDmodel = cRSID.SIDheader->SID3flagsL & 0x30;
-  if (SIDmodel) SIDmodel = (SIDmodel >= 0x20) ? 8580:6581; else SIDmodel = cRSID_C64.SID[1].ChipModel;
-  if (cRSID.SelectedSIDmodel) SIDmodel = cRSID.SelectedSIDmodel;
-  cRSID_C64.SID[3].ChipModel = SIDmodel;
-
-  SIDmodel = cRSID.SIDheader->SID4flagsL & 0x30;
-  if (SIDmodel) SIDmodel = (SIDmodel >= 0x20) ? 8580:6581; else SIDmodel = cRSID_C64.SID[1].ChipModel;
-  if (cRSID.SelectedSIDmodel) SIDmodel = cRSID.SelectedSIDmodel;
-  cRSID_C64.SID[4].ChipModel = SIDmodel;
+  SIDmodel = C64->Interface->SIDheader->SID2flagsL & 0x30;
+  if (SIDmodel) SIDmodel = (SIDmodel >= 0x20) ? 8580:6581; else SIDmodel = C64->SID[1].ChipModel;
+  if (C64->Interface->SelectedSIDmodel) SIDmodel = C64->Interface->SelectedSIDmodel;
+  C64->SID[2].ChipModel = SIDmodel;
+
+  SIDmodel = C64->Interface->SIDheader->SID3flagsL & 0x30;
+  if (SIDmodel) SIDmodel = (SIDmodel >= 0x20) ? 8580:6581; else SIDmodel = C64->SID[1].ChipModel;
+  if (C64->Interface->SelectedSIDmodel) SIDmodel = C64->Interface->SelectedSIDmodel;
+  C64->SID[3].ChipModel = SIDmodel;
+
+  SIDmodel = C64->Interface->SIDheader->SID4flagsL & 0x30;
+  if (SIDmodel) SIDmodel = (SIDmodel >= 0x20) ? 8580:6581; else SIDmodel = C64->SID[1].ChipModel;
+  if (C64->Interface->SelectedSIDmodel) SIDmodel = C64->Interface->SelectedSIDmodel;
+  C64->SID[4].ChipModel = SIDmodel;
  }
 }
 
 
-void cRSID_setC64 () {   //set hardware-parameters (Models, SIDs) for playback of loaded SID-tune
+void cRSID_setC64 (cRSID_C64instance* C64) {   //set hardware-parameters (Models, SIDs) for playback of loaded SID-tune
  //static cRSID_C64instance* C64 = &cRSID_C64;
 
  //enum C64clocks { C64_PAL_CPUCLK=985248, C64_NTSC_CPUCLK=1022727 };
@@ -110,91 +124,91 @@ void cRSID_setC64 () {   //set hardware-parameters (Models, SIDs) for playback o
  };
  /*short SIDmodel;*/ char SIDchannel;
 
- if (cRSID.ForcedVideoStandard == CRSID_VIDEOSTANDARD_PAL) {
-  cRSID.VideoStandard = 1;
+ if (C64->Interface->ForcedVideoStandard == CRSID_VIDEOSTANDARD_PAL) {
+  C64->Interface->VideoStandard = 1;
  }
- else if (cRSID.ForcedVideoStandard == CRSID_VIDEOSTANDARD_NTSC) {
-  cRSID.VideoStandard = 0;
+ else if (C64->Interface->ForcedVideoStandard == CRSID_VIDEOSTANDARD_NTSC) {
+  C64->Interface->VideoStandard = 0;
  }
  else {
-  cRSID.VideoStandard = ( (cRSID.SIDheader->ModelFormatStandard & 0x0C) >> 2 ) != 2;
+  C64->Interface->VideoStandard = ( (C64->Interface->SIDheader->ModelFormatStandard & 0x0C) >> 2 ) != 2;
  }
- if (cRSID_C64.SampleRate==0) cRSID_C64.SampleRate = 44100;
- cRSID_C64.CPUfrequency = CPUspeeds[ cRSID.VideoStandard ];
- cRSID_C64.SampleClockRatio = (cRSID_C64.CPUfrequency << CRSID_CLOCK_FRACTIONAL_BITS) / cRSID_C64.SampleRate; //shifting (multiplication) enhances SampleClockRatio precision
- cRSID_C64.OversampleClockRatio = (cRSID_C64.SampleRate << CRSID_RESAMPLER_FRACTIONAL_BITS) / CRSID_PAL_AUDIO_CLOCK; //round( SID_AUDIO_CLOCK / C64->SampleRate );
- cRSID_C64.OversampleClockRatioReciproc = CRSID_PAL_AUDIO_CLOCK / cRSID_C64.SampleRate; //round?
+ if (C64->SampleRate==0) C64->SampleRate = 44100;
+ C64->CPUfrequency = CPUspeeds[ C64->Interface->VideoStandard ];
+ C64->SampleClockRatio = (C64->CPUfrequency << CRSID_CLOCK_FRACTIONAL_BITS) / C64->SampleRate; //shifting (multiplication) enhances SampleClockRatio precision
+ C64->OversampleClockRatio = (C64->SampleRate << CRSID_RESAMPLER_FRACTIONAL_BITS) / CRSID_PAL_AUDIO_CLOCK; //round( SID_AUDIO_CLOCK / C64->SampleRate );
+ C64->OversampleClockRatioReciproc = CRSID_PAL_AUDIO_CLOCK / C64->SampleRate; //round?
 
- cRSID_C64.VIC.RasterLines = ScanLines[ cRSID.VideoStandard ];
- cRSID_C64.VIC.RasterRowCycles = ScanLineCycles[ cRSID.VideoStandard ];
- cRSID.FrameCycles = cRSID_C64.VIC.RasterLines * cRSID_C64.VIC.RasterRowCycles; ///cRSID_C64.SampleRate / PAL_FRAMERATE; //1x speed tune with VIC Vertical-blank timing
+ C64->VIC.RasterLines = ScanLines[ C64->Interface->VideoStandard ];
+ C64->VIC.RasterRowCycles = ScanLineCycles[ C64->Interface->VideoStandard ];
+ C64->Interface->FrameCycles = C64->VIC.RasterLines * C64->VIC.RasterRowCycles; ///cRSID_C64.SampleRate / PAL_FRAMERATE; //1x speed tune with VIC Vertical-blank timing
 
- cRSID_C64.PrevRasterLine=-1; //so if $d012 is set once only don't disturb FrameCycleCnt
+ C64->PrevRasterLine=-1; //so if $d012 is set once only don't disturb FrameCycleCnt
 
- cRSID_configure6581FilterPreset( cRSID.Filter6581Preset );
- cRSID_setSIDmodels();
+ cRSID_configure6581FilterPreset( C64, C64->Interface->Filter6581Preset );
+ cRSID_setSIDmodelsC64(C64);
 
- if (cRSID.SIDheader->Version != CRSID_FILEVERSION_WEBSID) {
-  cRSID_C64.SID[1].Channel = CRSID_CHANNEL_LEFT;
+ if (C64->Interface->SIDheader->Version != CRSID_FILEVERSION_WEBSID) {
+  C64->SID[1].Channel = CRSID_CHANNEL_LEFT;
 
-  cRSID_createSIDchip( &cRSID_C64.SID[2], cRSID_C64.SID[2].ChipModel, CRSID_CHANNEL_RIGHT, 0xD000 + cRSID.SIDheader->SID2baseAddress*16 );
+  cRSID_createSIDchip( C64, &C64->SID[2], C64->SID[2].ChipModel, CRSID_CHANNEL_RIGHT, 0xD000 + C64->Interface->SIDheader->SID2baseAddress*16 );
 
-  cRSID_createSIDchip( &cRSID_C64.SID[3], cRSID_C64.SID[3].ChipModel, CRSID_CHANNEL_BOTH, 0xD000 + cRSID.SIDheader->SID3baseAddress*16 );
+  cRSID_createSIDchip( C64, &C64->SID[3], C64->SID[3].ChipModel, CRSID_CHANNEL_BOTH, 0xD000 + C64->Interface->SIDheader->SID3baseAddress*16 );
 
  //ensure disabling SID4 in non-WebSID format:  //(NULL-ing not preferred as it can overwrite stuff and cause Segfault in sample-thread)
-  cRSID_C64.SID[4].BaseAddress=0x0000;
-  cRSID_C64.SID[4].BasePtr = cRSID_C64.SID[4].BasePtrRD = &cRSID_C64.IObankWR[CRSID_SID_SAFE_ADDRESS]; //NULL;
+  C64->SID[4].BaseAddress=0x0000;
+  C64->SID[4].BasePtr = C64->SID[4].BasePtrRD = &C64->IObankWR[CRSID_SID_SAFE_ADDRESS]; //NULL;
 
  }
  else {
-  cRSID_C64.SID[1].Channel = (cRSID.SIDheader->ModelFormatStandardH & 0x40)? CRSID_CHANNEL_RIGHT:CRSID_CHANNEL_LEFT;
-  if (cRSID.SIDheader->ModelFormatStandardH & 0x80) cRSID_C64.SID[1].Channel = CRSID_CHANNEL_BOTH; //my own proposal for 'middle' channel
+  C64->SID[1].Channel = (C64->Interface->SIDheader->ModelFormatStandardH & 0x40)? CRSID_CHANNEL_RIGHT:CRSID_CHANNEL_LEFT;
+  if (C64->Interface->SIDheader->ModelFormatStandardH & 0x80) C64->SID[1].Channel = CRSID_CHANNEL_BOTH; //my own proposal for 'middle' channel
 
-  SIDchannel = (cRSID.SIDheader->SID2flagsL & 0x40) ? CRSID_CHANNEL_RIGHT:CRSID_CHANNEL_LEFT;
-  if (cRSID.SIDheader->SID2flagsL & 0x80) SIDchannel = CRSID_CHANNEL_BOTH;
-  cRSID_createSIDchip ( &cRSID_C64.SID[2], cRSID_C64.SID[2].ChipModel, SIDchannel, 0xD000 + cRSID.SIDheader->SID2baseAddress*16 );
+  SIDchannel = (C64->Interface->SIDheader->SID2flagsL & 0x40) ? CRSID_CHANNEL_RIGHT:CRSID_CHANNEL_LEFT;
+  if (C64->Interface->SIDheader->SID2flagsL & 0x80) SIDchannel = CRSID_CHANNEL_BOTH;
+  cRSID_createSIDchip ( C64, &C64->SID[2], C64->SID[2].ChipModel, SIDchannel, 0xD000 + C64->Interface->SIDheader->SID2baseAddress*16 );
 
-  SIDchannel = (cRSID.SIDheader->SID3flagsL & 0x40) ? CRSID_CHANNEL_RIGHT:CRSID_CHANNEL_LEFT;
-  if (cRSID.SIDheader->SID3flagsL & 0x80) SIDchannel = CRSID_CHANNEL_BOTH;
-  cRSID_createSIDchip ( &cRSID_C64.SID[3], cRSID_C64.SID[3].ChipModel, SIDchannel, 0xD000 + cRSID.SIDheader->SID3flagsH*16 );
+  SIDchannel = (C64->Interface->SIDheader->SID3flagsL & 0x40) ? CRSID_CHANNEL_RIGHT:CRSID_CHANNEL_LEFT;
+  if (C64->Interface->SIDheader->SID3flagsL & 0x80) SIDchannel = CRSID_CHANNEL_BOTH;
+  cRSID_createSIDchip ( C64, &C64->SID[3], C64->SID[3].ChipModel, SIDchannel, 0xD000 + C64->Interface->SIDheader->SID3flagsH*16 );
 
-  SIDchannel = (cRSID.SIDheader->SID4flagsL & 0x40) ? CRSID_CHANNEL_RIGHT:CRSID_CHANNEL_LEFT;
-  if (cRSID.SIDheader->SID4flagsL & 0x80) SIDchannel = CRSID_CHANNEL_BOTH;
-  cRSID_createSIDchip ( &cRSID_C64.SID[4], cRSID_C64.SID[4].ChipModel, SIDchannel, 0xD000 + cRSID.SIDheader->SID4baseAddress*16 );
+  SIDchannel = (C64->Interface->SIDheader->SID4flagsL & 0x40) ? CRSID_CHANNEL_RIGHT:CRSID_CHANNEL_LEFT;
+  if (C64->Interface->SIDheader->SID4flagsL & 0x80) SIDchannel = CRSID_CHANNEL_BOTH;
+  cRSID_createSIDchip ( C64, &C64->SID[4], C64->SID[4].ChipModel, SIDchannel, 0xD000 + C64->Interface->SIDheader->SID4baseAddress*16 );
  }
 
- cRSID_C64.SIDchipCount = 1 + (cRSID_C64.SID[2].BaseAddress > 0) + (cRSID_C64.SID[3].BaseAddress > 0) + (cRSID_C64.SID[4].BaseAddress > 0);
- if (cRSID_C64.SIDchipCount == 1) cRSID_C64.SID[1].Channel = CRSID_CHANNEL_BOTH;
- cRSID_C64.Attenuation = Attenuations[cRSID_C64.SIDchipCount];
+ C64->SIDchipCount = 1 + (C64->SID[2].BaseAddress > 0) + (C64->SID[3].BaseAddress > 0) + (C64->SID[4].BaseAddress > 0);
+ if (C64->SIDchipCount == 1) C64->SID[1].Channel = CRSID_CHANNEL_BOTH;
+ C64->Attenuation = Attenuations[C64->SIDchipCount];
 }
 
 
 
-void cRSID_initC64 () { //C64 Reset
+void cRSID_resetC64 (cRSID_C64instance* C64) { //C64 Reset
  enum { C64_RESET_VECTOR = 0xFFFC };
  //static cRSID_C64instance* C64 = &cRSID_C64;
 
- cRSID_initSIDchip( &cRSID_C64.SID[1] );
- cRSID_initCIAchip( &cRSID_C64.CIA[1] ); cRSID_initCIAchip( &cRSID_C64.CIA[2] );
- /*cRSID_setROMcontent();*/ cRSID_initMem();
- cRSID_initCPU( (cRSID_readMem(C64_RESET_VECTOR+1)<<8) + cRSID_readMem(C64_RESET_VECTOR) ); //cRSID_initCPU( &cRSID_C64.CPU, (cRSID_readMemC64(C64,0xFFFD)<<8) + cRSID_readMemC64(C64,0xFFFC) );
- cRSID_C64.IRQ = cRSID_C64.NMI = 0;
- if (cRSID.HighQualitySID) {
-  cRSID_C64.SID[1].NonFiltedSample = cRSID_C64.SID[1].FilterInputSample = 0;
-  cRSID_C64.SID[2].NonFiltedSample = cRSID_C64.SID[2].FilterInputSample = 0;
-  cRSID_C64.SID[3].NonFiltedSample = cRSID_C64.SID[3].FilterInputSample = 0;
-  cRSID_C64.SID[4].NonFiltedSample = cRSID_C64.SID[4].FilterInputSample = 0;
-  cRSID_C64.SID[1].PrevNonFiltedSample = cRSID_C64.SID[1].PrevFilterInputSample = 0;
-  cRSID_C64.SID[2].PrevNonFiltedSample = cRSID_C64.SID[2].PrevFilterInputSample = 0;
-  cRSID_C64.SID[3].PrevNonFiltedSample = cRSID_C64.SID[3].PrevFilterInputSample = 0;
-  cRSID_C64.SID[4].PrevNonFiltedSample = cRSID_C64.SID[4].PrevFilterInputSample = 0;
+ cRSID_initSIDchip( &C64->SID[1] );
+ cRSID_initCIAchip( &C64->CIA[1] ); cRSID_initCIAchip( &C64->CIA[2] );
+ /*cRSID_setROMcontent();*/ cRSID_initMem(C64);
+ cRSID_initCPU( C64, (cRSID_readMem(C64, C64_RESET_VECTOR+1)<<8) + cRSID_readMem(C64, C64_RESET_VECTOR) ); //cRSID_initCPU( &cRSID_C64.CPU, (cRSID_readMemC64(C64,0xFFFD)<<8) + cRSID_readMemC64(C64,0xFFFC) );
+ C64->IRQ = C64->NMI = 0;
+ if (C64->Interface->HighQualitySID) {
+  C64->SID[1].NonFiltedSample = C64->SID[1].FilterInputSample = 0;
+  C64->SID[2].NonFiltedSample = C64->SID[2].FilterInputSample = 0;
+  C64->SID[3].NonFiltedSample = C64->SID[3].FilterInputSample = 0;
+  C64->SID[4].NonFiltedSample = C64->SID[4].FilterInputSample = 0;
+  C64->SID[1].PrevNonFiltedSample = C64->SID[1].PrevFilterInputSample = 0;
+  C64->SID[2].PrevNonFiltedSample = C64->SID[2].PrevFilterInputSample = 0;
+  C64->SID[3].PrevNonFiltedSample = C64->SID[3].PrevFilterInputSample = 0;
+  C64->SID[4].PrevNonFiltedSample = C64->SID[4].PrevFilterInputSample = 0;
  }
- cRSID_C64.SampleCycleCnt = cRSID_C64.OverSampleCycleCnt = 0;
+ C64->SampleCycleCnt = C64->OverSampleCycleCnt = 0;
 }
 
 
 
-cRSID_Output* cRSID_emulateC64 () {
+cRSID_Output* cRSID_emulateC64 (cRSID_C64instance* C64) {
  //static cRSID_C64instance* C64 = &cRSID_C64;
 
  //static enum { VOLUME_MAX=0xF, CHANNELS=3+1 } SIDspecs; //digi-channel is counted too in attenuation
@@ -203,99 +217,98 @@ cRSID_Output* cRSID_emulateC64 () {
  static enum { VUMETER_LOWPASS_DIV = 16, VUMETER_DIVSHIFTS = (4 - CRSID_WAVGEN_PRESHIFT) } VUmeterParameters;
 
  FASTVAR unsigned char InstructionCycles;
- static unsigned char VUmeterUpdateCounter;
- static cRSID_Output* Output;
+ cRSID_Output* Output;
 
 
  //Cycle-based/-paced part of emulations:
 
 
- while (cRSID_C64.SampleCycleCnt <= cRSID_C64.SampleClockRatio) {
+ while (C64->SampleCycleCnt <= C64->SampleClockRatio) {
 
-  if ( CALMLY (!cRSID_C64.RealSIDmode) ) {
-   if ( RARELY (cRSID_C64.FrameCycleCnt >= cRSID.FrameCycles) ) {
-    cRSID_C64.FrameCycleCnt -= cRSID.FrameCycles;
-    if ( RARELY (cRSID_C64.Finished) ) { //some tunes (e.g. Barbarian, A-Maze-Ing) don't always finish in 1 frame
-     cRSID_setPSIDplayBank(); // PSID calls are expected to start with a sane bank for the play routine region.
-     cRSID_initCPU( cRSID.PlayAddress ); //(PSID docs say bank-register should always be set for each call's region)
-     cRSID_C64.Finished=0; //cRSID_C64.SampleCycleCnt=0; //PSID workaround for some tunes (e.g. Galdrumway):
-     if ( LIKELY (cRSID.TimerSource==0) ) cRSID_C64.IObankRD[0xD019] = 0x81; //always simulate to player-calls that VIC-IRQ happened
-     else cRSID_C64.IObankRD[0xDC0D] = 0x83; //always simulate to player-calls that CIA TIMERA/TIMERB-IRQ happened
+  if ( CALMLY (!C64->RealSIDmode) ) {
+   if ( RARELY (C64->FrameCycleCnt >= C64->Interface->FrameCycles) ) {
+    C64->FrameCycleCnt -= C64->Interface->FrameCycles;
+    if ( RARELY (C64->Finished) ) { //some tunes (e.g. Barbarian, A-Maze-Ing) don't always finish in 1 frame
+     cRSID_setPSIDplayBank(C64); // PSID calls are expected to start with a sane bank for the play routine region.
+     cRSID_initCPU( C64, C64->Interface->PlayAddress ); //(PSID docs say bank-register should always be set for each call's region)
+     C64->Finished=0; //cRSID_C64.SampleCycleCnt=0; //PSID workaround for some tunes (e.g. Galdrumway):
+     if ( LIKELY (C64->Interface->TimerSource==0) ) C64->IObankRD[0xD019] = 0x81; //always simulate to player-calls that VIC-IRQ happened
+     else C64->IObankRD[0xDC0D] = 0x83; //always simulate to player-calls that CIA TIMERA/TIMERB-IRQ happened
    }}
-   if ( TIGHTLY (cRSID_C64.Finished==0) ) {
-    if ( RARELY ((InstructionCycles = cRSID_emulateCPU()) >= 0xFE) ) { InstructionCycles=6; cRSID_C64.Finished=1; }
+   if ( TIGHTLY (C64->Finished==0) ) {
+    if ( RARELY ((InstructionCycles = cRSID_emulateCPU(C64)) >= 0xFE) ) { InstructionCycles=6; C64->Finished=1; }
    }
    else InstructionCycles=7; //idle between player-calls
-   cRSID_C64.FrameCycleCnt += InstructionCycles;
-   cRSID_C64.IObankRD[0xDC04] += InstructionCycles; //very simple CIA1 TimerA simulation for PSID (e.g. Delta-Mix_E-Load_loader)
+   C64->FrameCycleCnt += InstructionCycles;
+   C64->IObankRD[0xDC04] += InstructionCycles; //very simple CIA1 TimerA simulation for PSID (e.g. Delta-Mix_E-Load_loader)
   }
 
   else { //RealSID emulations:
-   if ( RARELY (cRSID_handleCPUinterrupts()) ) { cRSID_C64.Finished=0; InstructionCycles=7; }
-   else if ( MOSTLY (cRSID_C64.Finished==0) ) {
-    if ( RARELY ((InstructionCycles = cRSID_emulateCPU()) >= 0xFE) ) {
-     /*if (InstructionCycles!=0xFE && !(cRSID_C64.CPU.ST&I))*/ cRSID_C64.Finished=1;
+   if ( RARELY (cRSID_handleCPUinterrupts(C64)) ) { C64->Finished=0; InstructionCycles=7; }
+   else if ( MOSTLY (C64->Finished==0) ) {
+    if ( RARELY ((InstructionCycles = cRSID_emulateCPU(C64)) >= 0xFE) ) {
+     /*if (InstructionCycles!=0xFE && !(cRSID_C64.CPU.ST&I))*/ C64->Finished=1;
      InstructionCycles=6;
     }
    }
    else InstructionCycles=7; //idle between IRQ-calls
-   cRSID_C64.IRQ = cRSID_C64.NMI = 0; //prepare for collecting IRQ sources
-   cRSID_C64.IRQ |= cRSID_emulateCIA( &cRSID_C64.CIA[1], InstructionCycles );
-   cRSID_C64.NMI |= cRSID_emulateCIA( &cRSID_C64.CIA[2], InstructionCycles );
-   cRSID_C64.IRQ |= cRSID_emulateVIC( InstructionCycles );
+   C64->IRQ = C64->NMI = 0; //prepare for collecting IRQ sources
+   C64->IRQ |= cRSID_emulateCIA( &C64->CIA[1], InstructionCycles );
+   C64->NMI |= cRSID_emulateCIA( &C64->CIA[2], InstructionCycles );
+   C64->IRQ |= cRSID_emulateVIC( C64, InstructionCycles );
   }
 
-  cRSID_C64.SampleCycleCnt += (InstructionCycles << CRSID_CLOCK_FRACTIONAL_BITS);
+  C64->SampleCycleCnt += (InstructionCycles << CRSID_CLOCK_FRACTIONAL_BITS);
 
-  cRSID_emulateADSRs( &cRSID_C64.SID[1], InstructionCycles );
-  if (cRSID_C64.SID[2].BaseAddress != 0) cRSID_emulateADSRs( &cRSID_C64.SID[2], InstructionCycles );
-  if (cRSID_C64.SID[3].BaseAddress != 0) cRSID_emulateADSRs( &cRSID_C64.SID[3], InstructionCycles );
-  if (cRSID_C64.SID[4].BaseAddress != 0) cRSID_emulateADSRs( &cRSID_C64.SID[4], InstructionCycles );
+  cRSID_emulateADSRs( &C64->SID[1], InstructionCycles );
+  if (C64->SID[2].BaseAddress != 0) cRSID_emulateADSRs( &C64->SID[2], InstructionCycles );
+  if (C64->SID[3].BaseAddress != 0) cRSID_emulateADSRs( &C64->SID[3], InstructionCycles );
+  if (C64->SID[4].BaseAddress != 0) cRSID_emulateADSRs( &C64->SID[4], InstructionCycles );
 
  } //end of 1MHz cycle-based emulations (CPU, VIC, CIA, ADSR)
- cRSID_C64.SampleCycleCnt -= cRSID_C64.SampleClockRatio;
+ C64->SampleCycleCnt -= C64->SampleClockRatio;
 
 
- if ( TIGHTLY (cRSID_C64.HighQualitySID) ) { //oversampled waveform-generation (although delayed ~22 cycles (~5 instructions) compared to CPU, shouldn't cause many issues (apart from cycle-exact SID-routines reading OSC3))
-  if ( TIGHTLY (cRSID_C64.HighQualityResampler) ) cRSID_emulateHQresampledSIDs(); //high-quality but more CPU-hungry Sinc-based resampler (decimator)
-  else cRSID_emulateOversampledSIDwaves(); //fast simple (but lower-quality) averager (box-filter) resampler
+ if ( TIGHTLY (C64->HighQualitySID) ) { //oversampled waveform-generation (although delayed ~22 cycles (~5 instructions) compared to CPU, shouldn't cause many issues (apart from cycle-exact SID-routines reading OSC3))
+  if ( TIGHTLY (C64->HighQualityResampler) ) cRSID_emulateHQresampledSIDs(C64); //high-quality but more CPU-hungry Sinc-based resampler (decimator)
+  else cRSID_emulateOversampledSIDwaves(C64); //fast simple (but lower-quality) averager (box-filter) resampler
  }
 
 
  //Samplerate-based/-paced part of emulations:
 
 
- if ( CALMLY (!cRSID_C64.RealSIDmode) ) { //some PSID tunes use CIA TOD-clock (e.g. Kawasaki Synthesizer Demo)
-  --cRSID_C64.TenthSecondCnt;
-  if ( RARELY (cRSID_C64.TenthSecondCnt <= 0) ) {
-   cRSID_C64.TenthSecondCnt = cRSID_C64.SampleRate / 10;
-   ++( cRSID_C64.IObankRD[0xDC08] );
-   if ( RARELY (cRSID_C64.IObankRD[0xDC08] >= 10) ) {
-    cRSID_C64.IObankRD[0xDC08] = 0; ++( cRSID_C64.IObankRD[0xDC09] );
+ if ( CALMLY (!C64->RealSIDmode) ) { //some PSID tunes use CIA TOD-clock (e.g. Kawasaki Synthesizer Demo)
+  --C64->TenthSecondCnt;
+  if ( RARELY (C64->TenthSecondCnt <= 0) ) {
+   C64->TenthSecondCnt = C64->SampleRate / 10;
+   ++( C64->IObankRD[0xDC08] );
+   if ( RARELY (C64->IObankRD[0xDC08] >= 10) ) {
+    C64->IObankRD[0xDC08] = 0; ++( C64->IObankRD[0xDC09] );
     //if(cRSID_C64.IObankRD[0xDC09]%
  }}}
- if ( MOSTLY (cRSID_C64.SecondCnt < cRSID_C64.SampleRate) ) ++cRSID_C64.SecondCnt;
- else { cRSID_C64.SecondCnt = 0; if ( MOSTLY (cRSID.PlayTime<3600) ) ++cRSID.PlayTime; }
+ if ( MOSTLY (C64->SecondCnt < C64->SampleRate) ) ++C64->SecondCnt;
+ else { C64->SecondCnt = 0; if ( MOSTLY (C64->Interface->PlayTime<3600) ) ++C64->Interface->PlayTime; }
 
 
- if ( TIGHTLY (cRSID_C64.HighQualitySID) ) { //SID output-stages and mono/stereo handling for High-Quality SID-emulation
-  Output = TIGHTLY (cRSID_C64.HighQualityResampler) ? cRSID_emulateHQresampledSIDoutputs() : cRSID_emulateOversampledSIDoutputs();
+ if ( TIGHTLY (C64->HighQualitySID) ) { //SID output-stages and mono/stereo handling for High-Quality SID-emulation
+  Output = TIGHTLY (C64->HighQualityResampler) ? cRSID_emulateHQresampledSIDoutputs(C64) : cRSID_emulateOversampledSIDoutputs(C64);
  }
- else Output = cRSID_emulateLightSIDs(); //with special lightweight waveform-antialiasing code
+ else Output = cRSID_emulateLightSIDs(C64); //with special lightweight waveform-antialiasing code
 
  //Output.L /= cRSID_C64.Attenuation //( (CHANNELS*VOLUME_MAX) + cRSID_C64.Attenuation ); //* cRSID_C64.AudioThread_SIDchipCount;
  //Output.R /= cRSID_C64.Attenuation //( (CHANNELS*VOLUME_MAX) + cRSID_C64.Attenuation ); //* cRSID_C64.AudioThread_SIDchipCount;
 
 
- if ( RARELY (!cRSID.CLImode && !++VUmeterUpdateCounter) ) {
+ if ( RARELY (!C64->Interface->CLImode && !++C64->VUmeterUpdateCounter) ) {
   //average level (for VU-meter)
-  cRSID_C64.SID[1].Level += ( (abs(cRSID_C64.SID[1].Output)>>VUMETER_DIVSHIFTS) - cRSID_C64.SID[1].Level ) / VUMETER_LOWPASS_DIV; //16; //4; //1024;
-  if ( TIGHTLY (cRSID_C64.SID[2].BaseAddress != 0) )
-   cRSID_C64.SID[2].Level += ( (abs(cRSID_C64.SID[2].Output)>>VUMETER_DIVSHIFTS) - cRSID_C64.SID[2].Level ) / VUMETER_LOWPASS_DIV; //16; //1024;
-  if ( TIGHTLY (cRSID_C64.SID[3].BaseAddress != 0) )
-   cRSID_C64.SID[3].Level += ( (abs(cRSID_C64.SID[3].Output)>>VUMETER_DIVSHIFTS) - cRSID_C64.SID[3].Level ) / VUMETER_LOWPASS_DIV; //16; //1024;
-  if ( TIGHTLY (cRSID_C64.SID[4].BaseAddress != 0) )
-   cRSID_C64.SID[4].Level += ( (abs(cRSID_C64.SID[4].Output)>>VUMETER_DIVSHIFTS) - cRSID_C64.SID[4].Level ) / VUMETER_LOWPASS_DIV; //16; //1024;
+  C64->SID[1].Level += ( (abs(C64->SID[1].Output)>>VUMETER_DIVSHIFTS) - C64->SID[1].Level ) / VUMETER_LOWPASS_DIV; //16; //4; //1024;
+  if ( TIGHTLY (C64->SID[2].BaseAddress != 0) )
+   C64->SID[2].Level += ( (abs(C64->SID[2].Output)>>VUMETER_DIVSHIFTS) - C64->SID[2].Level ) / VUMETER_LOWPASS_DIV; //16; //1024;
+  if ( TIGHTLY (C64->SID[3].BaseAddress != 0) )
+   C64->SID[3].Level += ( (abs(C64->SID[3].Output)>>VUMETER_DIVSHIFTS) - C64->SID[3].Level ) / VUMETER_LOWPASS_DIV; //16; //1024;
+  if ( TIGHTLY (C64->SID[4].BaseAddress != 0) )
+   C64->SID[4].Level += ( (abs(C64->SID[4].Output)>>VUMETER_DIVSHIFTS) - C64->SID[4].Level ) / VUMETER_LOWPASS_DIV; //16; //1024;
  }
 
  return Output;
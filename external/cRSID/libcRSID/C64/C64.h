@@ -8,6 +8,8 @@
 #include "../libcRSID.h"
 #include "../host/host.h"
 
+#include "SIMD.h"
+
 
 #define CRSID_BYTE_LOG2(x) ((x)<2? 0: ((x)<4? 1: ((x)<8? 2: ((x)<16? 3: ((x)<32? 4: ((x)<64? 5: ((x)<128? 6: ((x)<256? 7: 8))))))))
 
@@ -19,7 +21,11 @@ enum cRSID_Specifications__C64 {
  CRSID_OVERSAMPLING_CYCLES = ((CRSID_PAL_CPUCLK/CRSID_DEFAULT_SAMPLERATE)/CRSID_OVERSAMPLING_RATIO),
  CRSID_PAL_AUDIO_CLOCK = (CRSID_PAL_CPUCLK / CRSID_OVERSAMPLING_CYCLES),
  CRSID_NTSC_AUDIO_CLOCK = (CRSID_NTSC_CPUCLK / CRSID_OVERSAMPLING_CYCLES),
- CRSID_SIDCOUNT_MAX=4, CRSID_CIACOUNT=2
+ CRSID_SIDCOUNT_MAX=4, CRSID_CIACOUNT=2,
+ CRSID_SID_FILTER_LANE = 3, //the SID's own filter in the filter-lanes, [0..2] are the voice-filters (for scopes)
+ CRSID_RESAMPLEBUFFER_SIZE = 16, //entries of the Sinc-resampler's accumulator ring-buffer
+ CRSID_RESAMPLEBUFFER_OVERHANG = 8, //extra entries after the ring for the SIMD Sinc-resampler's unwrapped 8-tap writes (folded back per sample)
+ CRSID_6581_FILTER_TABLE_ENTRY_COUNT = 0x800 //cutoff-register range of the 6581 filter-preset tables
 };
 enum cRSID_Channels { CRSID_CHANNEL_LEFT=1, CRSID_CHANNEL_RIGHT=2, CRSID_CHANNEL_BOTH=3,  CRSID_CHANNELPANNING_DIVSHIFTS = 2 };
 enum cRSID_AudioLevels {
@@ -90,8 +96,8 @@ typedef struct cRSID_SIDinstance {
  unsigned char      PrevWavData[15];
  //Filter-related:
  unsigned char      VoiceMuteMask;
- int                PrevLowPass;
- int                PrevBandPass;
+ int                PrevLowPass[4];  //filter-integrators in SIMD-lane order: [0..2] voices (scopes), [CRSID_SID_FILTER_LANE] the SID's filter
+ int                PrevBandPass[4];
  unsigned char      Volume; //pre-calculated once, used by oversampled/HQ output-emulation many times
  int                Digi; //pre-calculated once, used by oversampled/HQ output-emulation many times
  int                Resonance, Cutoff; //pre-calculated once, used by oversampled/HQ-filter many times
@@ -101,10 +107,9 @@ typedef struct cRSID_SIDinstance {
  int                FilterInputSample;
  int                PrevNonFiltedSample;
  int                PrevFilterInputSample;
- int                ScopeVoicePrevLowPass[3];
- int                ScopeVoicePrevBandPass[3];
- int                ScopeVoiceNonFiltered[3];
- int                ScopeVoiceFilterInput[3];
+ int                ScopeVoiceNonFiltered[4]; //[3] only pads the arrays to SIMD-lane width
+ int                ScopeVoiceFilterInput[4];
+ int                ScopeVoiceFilterOutput[4]; //HQ-filter output of the last oversampled step (ScopeVoiceOutput is calculated once per sample from it)
  int                ScopeVoiceOutput[4];
  signed int         PrevVolume; //lowpass-filtered version of Volume-band register
  int                Output;     //not attenuated (range:0..0xFFFFF depending on SID's main-volume)
@@ -120,7 +125,8 @@ typedef struct cRSID_SIDwavOutput {
 } cRSID_SIDwavOutput;
 
 
-typedef struct cRSID_C64instance {
+struct cRSID_C64instance { //(typedef-ed in libcRSID.h)
+ cRSID_Interface*  Interface; //public API variables of this instance (points to the global 'cRSID' for the global 'cRSID_C64')
  //platform-related:
  unsigned short    SampleRate;
  unsigned int      SampleBufferSize; //calculated (by audio-init) amount of bytes in the buffer
@@ -160,6 +166,22 @@ typedef struct cRSID_C64instance {
  void              (*callBack__autoAdvance) (char subtunestepping, void* data);
  void*               callBackData__autoAdvance;
  char              FadeLevel;
+ //emulation-states kept between samples (reset by cRSID_createC64()):
+ unsigned char     VUmeterUpdateCounter;
+ cRSID_Output      MixedOutput; //output of the light/oversampled/HQ SID-routing stages
+ int               OversamplerNonFilt [CRSID_SIDCOUNT_MAX+1], OversamplerPrevNonFilt [CRSID_SIDCOUNT_MAX+1]; //antialiasing-filter histories of the fast (averaging) resampler
+ int               OversamplerFilt [CRSID_SIDCOUNT_MAX+1], OversamplerPrevFilt [CRSID_SIDCOUNT_MAX+1];
+ int               ResampleBufPos, NextResampleBufPos; //Sinc-resampler position (fixed-point)
+ signed int        ResampleBufferL [CRSID_RESAMPLEBUFFER_SIZE+CRSID_RESAMPLEBUFFER_OVERHANG], ResampleBufferR [CRSID_RESAMPLEBUFFER_SIZE+CRSID_RESAMPLEBUFFER_OVERHANG];
+ unsigned char     PSIDdigiPlaybackEnabled, PSIDdigiNybbleCounter, PSIDdigiRepeatCounter;
+ unsigned short    PSIDdigiSampleAddress;
+ int               PSIDdigiOutput, PSIDdigiPeriodCounter; //(output keeps its level between calls)
+ int               DitherLFSR; //dithering-noise generator of cRSID_generateSample()
+ unsigned char     Active6581FilterPreset; //preset the tables below were built for (0xFF: none yet)
+ const unsigned short* ActiveCutoffMul6581_44100Hz; //either the stock tables or the custom ones below
+ const unsigned short* ActiveCutoffMul6581_OverSampleRate;
+ unsigned short    CutoffMul6581_44100Hz_Custom [CRSID_6581_FILTER_TABLE_ENTRY_COUNT + 1];
+ unsigned short    CutoffMul6581_OverSampleRate_Custom [CRSID_6581_FILTER_TABLE_ENTRY_COUNT + 1];
  //Hardware-elements:
  cRSID_CPUinstance CPU;
  cRSID_SIDinstance SID[CRSID_SIDCOUNT_MAX+1];
@@ -173,52 +195,53 @@ typedef struct cRSID_C64instance {
  unsigned char IObankWR [CRSID_MEMBANK_SIZE]; //$D000..$DFFF IO-RAM (registers) to write (VIC/SID/CIA/ColorRAM/IOexpansion)
  unsigned char IObankRD [CRSID_MEMBANK_SIZE]; //$D000..$DFFF IO-RAM (registers) to read from (VIC/SID/CIA/ColorRAM/IOexpansion)
  unsigned char ROMbanks [CRSID_MEMBANK_SIZE]; //$1000..$1FFF/$9000..$9FFF (CHARGEN), $A000..$BFFF (BASIC), $E000..$FFFF (KERNAL)
-} cRSID_C64instance;
+};
 
 
 //cRSID_C64instance cRSID_C64; //the only global object (for faster & simpler access than with struct-pointers, in some places)
 
 
 // C64/C64.c
-cRSID_C64instance*  cRSID_createC64     (unsigned short samplerate);
-void                cRSID_setC64        (); //configure hardware (SIDs) for SID-tune
-void                cRSID_initC64       (); //hard-reset
-cRSID_Output*       cRSID_emulateC64    ();
+cRSID_C64instance*  cRSID_createC64     (cRSID_C64instance* C64, unsigned short samplerate);
+void                cRSID_setC64        (cRSID_C64instance* C64); //configure hardware (SIDs) for SID-tune
+void                cRSID_resetC64       (cRSID_C64instance* C64); //hard-reset
+cRSID_Output*       cRSID_emulateC64    (cRSID_C64instance* C64);
 // C64/C64_SIDrouting.c
-static INLINE short cRSID_playPSIDdigi  ();
+static INLINE short cRSID_playPSIDdigi  (FASTVAR cRSID_C64instance *const C64);
 
 // C64/MEM.c
-static INLINE unsigned char* cRSID_getMemReadPtr     (FASTVAR unsigned short address); //for global cSID_C64 fast-access
+static INLINE unsigned char* cRSID_getMemReadPtr     (FASTVAR cRSID_C64instance *const C64, FASTVAR unsigned short address); //for global cSID_C64 fast-access
 //static INLINE unsigned char* cRSID_getMemReadPtrC64  (cRSID_C64instance* C64, FASTVAR unsigned short address); //maybe slower
-static INLINE unsigned char* cRSID_getMemWritePtr    (FASTVAR unsigned short address); //for global cSID_C64 fast-access
+static INLINE unsigned char* cRSID_getMemWritePtr    (FASTVAR cRSID_C64instance *const C64, FASTVAR unsigned short address); //for global cSID_C64 fast-access
 //static INLINE unsigned char* cRSID_getMemWritePtrC64 (cRSID_C64instance* C64, FASTVAR unsigned short address); //maybe slower
-static INLINE unsigned char  cRSID_readMem     (FASTVAR unsigned short address); //for global cSID_C64 fast-access
+static INLINE unsigned char  cRSID_readMem     (FASTVAR cRSID_C64instance *const C64, FASTVAR unsigned short address); //for global cSID_C64 fast-access
 //static INLINE unsigned char  cRSID_readMemC64  (cRSID_C64instance* C64, FASTVAR unsigned short address); //maybe slower
-static INLINE void           cRSID_writeMem    (FASTVAR unsigned short address, FASTVAR unsigned char data); //for global cSID_C64 fast-access
+static INLINE void           cRSID_writeMem    (FASTVAR cRSID_C64instance *const C64, FASTVAR unsigned short address, FASTVAR unsigned char data); //for global cSID_C64 fast-access
 //static INLINE void           cRSID_writeMemC64 (cRSID_C64instance* C64, FASTVAR unsigned short address, FASTVAR unsigned char data); //maybe slower
-void                         cRSID_setROMcontent (); //KERNAL, BASIC
-void                         cRSID_initMem       ();
+void                         cRSID_setROMcontent (cRSID_C64instance* C64); //KERNAL, BASIC
+void                         cRSID_initMem       (cRSID_C64instance* C64);
 // C64/CPU.c
-void               cRSID_initCPU       (unsigned short mempos);
-unsigned char      cRSID_emulateCPU    (void); //direct instances inside for hopefully faster operation
-static INLINE char cRSID_handleCPUinterrupts ();
+void               cRSID_initCPU       (cRSID_C64instance* C64, unsigned short mempos);
+unsigned char      cRSID_emulateCPU    (cRSID_C64instance* C64); //direct instances inside for hopefully faster operation
+static INLINE char cRSID_handleCPUinterrupts (FASTVAR cRSID_C64instance *const C64);
 // C64/SID.c
-void               cRSID_createSIDchip (cRSID_SIDinstance* SID, unsigned short model, char channel, unsigned short baseaddress);
+void               cRSID_createSIDchip (cRSID_C64instance* C64, cRSID_SIDinstance* SID, unsigned short model, char channel, unsigned short baseaddress);
 void               cRSID_initSIDchip   (cRSID_SIDinstance* SID);
-static INLINE int  cRSID_emulateHQresampledSID (FASTVAR cRSID_SIDinstance *const FASTPTR SID, FASTVAR char cycles);
+static INLINE int  cRSID_emulateHQresampledSID (FASTVAR cRSID_C64instance *const C64, FASTVAR cRSID_SIDinstance *const FASTPTR SID, FASTVAR char cycles);
 // C64/SID_ADSR.c
 void               cRSID_emulateADSRs  (FASTVAR cRSID_SIDinstance *const FASTPTR SID, FASTVAR char cycles);
 // C64/SID_OscWaves.c
-int             cRSID_emulateSID_light (FASTVAR cRSID_SIDinstance *const FASTPTR SID); //calls output-stage too
-cRSID_SIDwavOutput cRSID_emulateHQwaves(FASTVAR cRSID_SIDinstance *const FASTPTR SID, FASTVAR char cycles); //, FASTVAR char filter);
+int             cRSID_emulateSID_light (FASTVAR cRSID_C64instance *const C64, FASTVAR cRSID_SIDinstance *const FASTPTR SID); //calls output-stage too
+cRSID_SIDwavOutput cRSID_emulateHQwaves(FASTVAR cRSID_C64instance *const C64, FASTVAR cRSID_SIDinstance *const FASTPTR SID, FASTVAR char cycles); //, FASTVAR char filter);
 // C64/SID_Outputs.c
-void                cRSID_configure6581FilterPreset (unsigned char preset);
-static INLINE int  cRSID_emulateSIDoutputStage (FASTVAR cRSID_SIDinstance *const FASTPTR SID); //, FASTVAR char nofilter);
-static INLINE void cRSID_precalculateHQoutputParameters (FASTVAR cRSID_SIDinstance *const FASTPTR SID); //for faster oversampled filter & attenuation
+void                cRSID_configure6581FilterPreset (cRSID_C64instance* C64, unsigned char preset);
+static INLINE int  cRSID_emulateSIDoutputStage (FASTVAR cRSID_C64instance *const C64, FASTVAR cRSID_SIDinstance *const FASTPTR SID); //, FASTVAR char nofilter);
+static INLINE void cRSID_precalculateHQoutputParameters (FASTVAR cRSID_C64instance *const C64, FASTVAR cRSID_SIDinstance *const FASTPTR SID); //for faster oversampled filter & attenuation
 static INLINE int  cRSID_emulateHQresampledSIDoutputStage (FASTVAR cRSID_SIDinstance *const FASTPTR SID, FASTVAR cRSID_SIDwavOutput waves);
-static INLINE void cRSID_emulateHQresampledSIDdigi (FASTVAR cRSID_SIDinstance *const FASTPTR SID, FASTVAR cRSID_Output *const FASTPTR signal);
+static INLINE void cRSID_emulateHQscopeVoiceOutputs (FASTVAR cRSID_C64instance *const C64, FASTVAR cRSID_SIDinstance *const FASTPTR SID); //once per sample
+static INLINE void cRSID_emulateHQresampledSIDdigi (FASTVAR cRSID_C64instance *const C64, FASTVAR cRSID_SIDinstance *const FASTPTR SID, FASTVAR cRSID_Output *const FASTPTR signal);
 // C64/CIA.c
-void               cRSID_createCIAchip (cRSID_CIAinstance* CIA, unsigned short baseaddress);
+void               cRSID_createCIAchip (cRSID_C64instance* C64, cRSID_CIAinstance* CIA, unsigned short baseaddress);
 void               cRSID_initCIAchip   (cRSID_CIAinstance* CIA);
 static INLINE char cRSID_emulateCIA    (FASTVAR cRSID_CIAinstance *const FASTPTR CIA, FASTVAR char cycles);
 static INLINE void cRSID_writeCIAlatchAhi  (FASTVAR cRSID_CIAinstance *const FASTPTR CIA, FASTVAR unsigned char value);
@@ -226,10 +249,10 @@ static INLINE void cRSID_writeCIAlatchBhi  (FASTVAR cRSID_CIAinstance *const FAS
 static INLINE void cRSID_writeCIAIRQmask   (FASTVAR cRSID_CIAinstance *const FASTPTR CIA, FASTVAR unsigned char value);
 static INLINE void cRSID_acknowledgeCIAIRQ (FASTVAR cRSID_CIAinstance *const FASTPTR CIA);
 // C64/VIC.c
-void               cRSID_createVICchip (unsigned short baseaddress);
-void               cRSID_initVICchip   ();
-static INLINE char cRSID_emulateVIC    (FASTVAR char cycles);
-static INLINE void cRSID_acknowledgeVICrasterIRQ ();
+void               cRSID_createVICchip (cRSID_C64instance* C64, unsigned short baseaddress);
+void               cRSID_initVICchip   (cRSID_C64instance* C64);
+static INLINE char cRSID_emulateVIC    (FASTVAR cRSID_C64instance *const C64, FASTVAR char cycles);
+static INLINE void cRSID_acknowledgeVICrasterIRQ (FASTVAR cRSID_C64instance *const C64);
 
 
 #endif //LIBCRSID_HEADER__C64
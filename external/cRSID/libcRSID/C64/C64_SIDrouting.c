@@ -1,87 +1,87 @@
 
 
 
-static INLINE cRSID_Output* cRSID_emulateLightSIDs () { //lightweight (all at samplerate-pace) SID-emulations: oscillators, waveforms, filter and complete output stages
+static INLINE cRSID_Output* cRSID_emulateLightSIDs (FASTVAR cRSID_C64instance *const C64) { //lightweight (all at samplerate-pace) SID-emulations: oscillators, waveforms, filter and complete output stages
  //static enum { VOLUME_MAX=0xF, CHANNELS=3+1 } SIDspecs; //digi-channel is counted too in attenuation
 
  FASTVAR signed int Tmp, Tmp2;
- static cRSID_Output Output;
+ cRSID_Output* const Output = &C64->MixedOutput;
 
- switch (cRSID_C64.Stereo) {
+ switch (C64->Stereo) {
   case CRSID_CHANNELMODE_MONO: { //if ( MOSTLY (cRSID_C64.Stereo==CRSID_CHANNELMODE_MONO /*|| cRSID_C64.AudioThread_SIDchipCount==1*/) ) { //mono
-   Output.L /*= Output.R*/ = cRSID_emulateSID_light( &cRSID_C64.SID[1] );
-   if ( TIGHTLY (cRSID_C64.SID[2].BaseAddress != 0) ) Output.L += cRSID_emulateSID_light( &cRSID_C64.SID[2] );
-   if ( TIGHTLY (cRSID_C64.SID[3].BaseAddress != 0) ) Output.L += cRSID_emulateSID_light( &cRSID_C64.SID[3] );
-   if ( TIGHTLY (cRSID_C64.SID[4].BaseAddress != 0) ) Output.L += cRSID_emulateSID_light( &cRSID_C64.SID[4] );
-   Output.R = Output.L /= cRSID_C64.Attenuation; //( (CHANNELS*VOLUME_MAX) + cRSID_C64.Attenuation );  // * cRSID_C64.AudioThread_SIDchipCount; //better being multiplied in a single place than for all SIDs
+   Output->L /*= Output->R*/ = cRSID_emulateSID_light( C64, &C64->SID[1] );
+   if ( TIGHTLY (C64->SID[2].BaseAddress != 0) ) Output->L += cRSID_emulateSID_light( C64, &C64->SID[2] );
+   if ( TIGHTLY (C64->SID[3].BaseAddress != 0) ) Output->L += cRSID_emulateSID_light( C64, &C64->SID[3] );
+   if ( TIGHTLY (C64->SID[4].BaseAddress != 0) ) Output->L += cRSID_emulateSID_light( C64, &C64->SID[4] );
+   Output->R = Output->L /= C64->Attenuation; //( (CHANNELS*VOLUME_MAX) + cRSID_C64.Attenuation );  // * cRSID_C64.AudioThread_SIDchipCount; //better being multiplied in a single place than for all SIDs
   } break;
   case CRSID_CHANNELMODE_STEREO: { //else { //stereo
-   Tmp = cRSID_emulateSID_light( &cRSID_C64.SID[1] );
-   if ( RARELY (cRSID_C64.SID[1].Channel == CRSID_CHANNEL_LEFT) )  { Output.L = Tmp * 2; Output.R=0; }
-   else if ( RARELY (cRSID_C64.SID[1].Channel == CRSID_CHANNEL_RIGHT) ) { Output.R = Tmp * 2; Output.L=0; }
-   else Output.L = Output.R = Tmp;
-   if ( TIGHTLY (cRSID_C64.SID[2].BaseAddress != 0) ) {
-    Tmp = cRSID_emulateSID_light( &cRSID_C64.SID[2] );
-    if (cRSID_C64.SID[2].Channel == CRSID_CHANNEL_LEFT)  Output.L += Tmp * 2;
-    else if (cRSID_C64.SID[2].Channel == CRSID_CHANNEL_RIGHT) Output.R += Tmp * 2;
-    else { Output.L += Tmp; Output.R += Tmp; }
+   Tmp = cRSID_emulateSID_light( C64, &C64->SID[1] );
+   if ( RARELY (C64->SID[1].Channel == CRSID_CHANNEL_LEFT) )  { Output->L = Tmp * 2; Output->R=0; }
+   else if ( RARELY (C64->SID[1].Channel == CRSID_CHANNEL_RIGHT) ) { Output->R = Tmp * 2; Output->L=0; }
+   else Output->L = Output->R = Tmp;
+   if ( TIGHTLY (C64->SID[2].BaseAddress != 0) ) {
+    Tmp = cRSID_emulateSID_light( C64, &C64->SID[2] );
+    if (C64->SID[2].Channel == CRSID_CHANNEL_LEFT)  Output->L += Tmp * 2;
+    else if (C64->SID[2].Channel == CRSID_CHANNEL_RIGHT) Output->R += Tmp * 2;
+    else { Output->L += Tmp; Output->R += Tmp; }
    }
-   if ( TIGHTLY (cRSID_C64.SID[3].BaseAddress != 0) ) {
-    Tmp = cRSID_emulateSID_light( &cRSID_C64.SID[3] );
-    if ( UNLIKELY (cRSID_C64.SID[3].Channel == CRSID_CHANNEL_LEFT) )  Output.L += Tmp * 2;
-    else if ( UNLIKELY (cRSID_C64.SID[3].Channel == CRSID_CHANNEL_RIGHT) ) Output.R += Tmp * 2;
-    else { Output.L += Tmp; Output.R += Tmp; }
+   if ( TIGHTLY (C64->SID[3].BaseAddress != 0) ) {
+    Tmp = cRSID_emulateSID_light( C64, &C64->SID[3] );
+    if ( UNLIKELY (C64->SID[3].Channel == CRSID_CHANNEL_LEFT) )  Output->L += Tmp * 2;
+    else if ( UNLIKELY (C64->SID[3].Channel == CRSID_CHANNEL_RIGHT) ) Output->R += Tmp * 2;
+    else { Output->L += Tmp; Output->R += Tmp; }
    }
-   if ( TIGHTLY (cRSID_C64.SID[4].BaseAddress != 0) ) {
-    Tmp = cRSID_emulateSID_light( &cRSID_C64.SID[4] );
-    if (cRSID_C64.SID[4].Channel == CRSID_CHANNEL_LEFT)  Output.L += Tmp * 2;
-    else if (cRSID_C64.SID[4].Channel == CRSID_CHANNEL_RIGHT) Output.R += Tmp * 2;
-    else { Output.L += Tmp; Output.R += Tmp; }
+   if ( TIGHTLY (C64->SID[4].BaseAddress != 0) ) {
+    Tmp = cRSID_emulateSID_light( C64, &C64->SID[4] );
+    if (C64->SID[4].Channel == CRSID_CHANNEL_LEFT)  Output->L += Tmp * 2;
+    else if (C64->SID[4].Channel == CRSID_CHANNEL_RIGHT) Output->R += Tmp * 2;
+    else { Output->L += Tmp; Output->R += Tmp; }
    }
-   Output.L /= cRSID_C64.Attenuation; //( (CHANNELS*VOLUME_MAX) + cRSID_C64.Attenuation );  // * cRSID_C64.AudioThread_SIDchipCount;
-   Output.R /= cRSID_C64.Attenuation; //( (CHANNELS*VOLUME_MAX) + cRSID_C64.Attenuation );  // * cRSID_C64.AudioThread_SIDchipCount;
+   Output->L /= C64->Attenuation; //( (CHANNELS*VOLUME_MAX) + cRSID_C64.Attenuation );  // * cRSID_C64.AudioThread_SIDchipCount;
+   Output->R /= C64->Attenuation; //( (CHANNELS*VOLUME_MAX) + cRSID_C64.Attenuation );  // * cRSID_C64.AudioThread_SIDchipCount;
   } break;
   case CRSID_CHANNELMODE_NARROW: {
-   Tmp = cRSID_emulateSID_light( &cRSID_C64.SID[1] );
-   if ( RARELY (cRSID_C64.SID[1].Channel == CRSID_CHANNEL_LEFT) )  //Output.L = Tmp * 2;
-   { Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output.L = Tmp + Tmp2; Output.R = Tmp - Tmp2; }
-   else if ( RARELY (cRSID_C64.SID[1].Channel == CRSID_CHANNEL_RIGHT) )  //Output.R = Tmp * 2;
-   { Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output.R = Tmp + Tmp2; Output.L = Tmp - Tmp2; }
-   else Output.L = Output.R = Tmp;
-   if ( TIGHTLY (cRSID_C64.SID[2].BaseAddress != 0) ) {
-    Tmp = cRSID_emulateSID_light( &cRSID_C64.SID[2] );
-    if (cRSID_C64.SID[2].Channel == CRSID_CHANNEL_LEFT)  //Output.L += Tmp * 2;
-    { Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output.L += Tmp + Tmp2; Output.R += Tmp - Tmp2; }
-    else if (cRSID_C64.SID[2].Channel == CRSID_CHANNEL_RIGHT)  //Output.R += Tmp * 2;
-    { Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output.R += Tmp + Tmp2; Output.L += Tmp - Tmp2; }
-    else { Output.L += Tmp; Output.R += Tmp; }
+   Tmp = cRSID_emulateSID_light( C64, &C64->SID[1] );
+   if ( RARELY (C64->SID[1].Channel == CRSID_CHANNEL_LEFT) )  //Output->L = Tmp * 2;
+   { Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output->L = Tmp + Tmp2; Output->R = Tmp - Tmp2; }
+   else if ( RARELY (C64->SID[1].Channel == CRSID_CHANNEL_RIGHT) )  //Output->R = Tmp * 2;
+   { Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output->R = Tmp + Tmp2; Output->L = Tmp - Tmp2; }
+   else Output->L = Output->R = Tmp;
+   if ( TIGHTLY (C64->SID[2].BaseAddress != 0) ) {
+    Tmp = cRSID_emulateSID_light( C64, &C64->SID[2] );
+    if (C64->SID[2].Channel == CRSID_CHANNEL_LEFT)  //Output->L += Tmp * 2;
+    { Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output->L += Tmp + Tmp2; Output->R += Tmp - Tmp2; }
+    else if (C64->SID[2].Channel == CRSID_CHANNEL_RIGHT)  //Output->R += Tmp * 2;
+    { Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output->R += Tmp + Tmp2; Output->L += Tmp - Tmp2; }
+    else { Output->L += Tmp; Output->R += Tmp; }
    }
-   if ( TIGHTLY (cRSID_C64.SID[3].BaseAddress != 0) ) {
-    Tmp = cRSID_emulateSID_light( &cRSID_C64.SID[3] );
-    if ( UNLIKELY (cRSID_C64.SID[3].Channel == CRSID_CHANNEL_LEFT) )  //Output.L += Tmp * 2;
-    { Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output.L += Tmp + Tmp2; Output.R += Tmp - Tmp2; }
-    else if ( UNLIKELY (cRSID_C64.SID[3].Channel == CRSID_CHANNEL_RIGHT) )  //Output.R += Tmp * 2;
-    { Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output.R += Tmp + Tmp2; Output.L += Tmp - Tmp2; }
-    else { Output.L += Tmp; Output.R += Tmp; }
+   if ( TIGHTLY (C64->SID[3].BaseAddress != 0) ) {
+    Tmp = cRSID_emulateSID_light( C64, &C64->SID[3] );
+    if ( UNLIKELY (C64->SID[3].Channel == CRSID_CHANNEL_LEFT) )  //Output->L += Tmp * 2;
+    { Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output->L += Tmp + Tmp2; Output->R += Tmp - Tmp2; }
+    else if ( UNLIKELY (C64->SID[3].Channel == CRSID_CHANNEL_RIGHT) )  //Output->R += Tmp * 2;
+    { Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output->R += Tmp + Tmp2; Output->L += Tmp - Tmp2; }
+    else { Output->L += Tmp; Output->R += Tmp; }
    }
-   if ( TIGHTLY (cRSID_C64.SID[4].BaseAddress != 0) ) {
-    Tmp = cRSID_emulateSID_light( &cRSID_C64.SID[4] );
-    if (cRSID_C64.SID[4].Channel == CRSID_CHANNEL_LEFT)  //Output.L += Tmp * 2;
-    { Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output.L += Tmp + Tmp2; Output.R += Tmp - Tmp2; }
-    else if (cRSID_C64.SID[4].Channel == CRSID_CHANNEL_RIGHT)  //Output.R += Tmp * 2;
-    { Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output.R += Tmp + Tmp2; Output.L += Tmp - Tmp2; }
-    else { Output.L += Tmp; Output.R += Tmp; }
+   if ( TIGHTLY (C64->SID[4].BaseAddress != 0) ) {
+    Tmp = cRSID_emulateSID_light( C64, &C64->SID[4] );
+    if (C64->SID[4].Channel == CRSID_CHANNEL_LEFT)  //Output->L += Tmp * 2;
+    { Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output->L += Tmp + Tmp2; Output->R += Tmp - Tmp2; }
+    else if (C64->SID[4].Channel == CRSID_CHANNEL_RIGHT)  //Output->R += Tmp * 2;
+    { Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output->R += Tmp + Tmp2; Output->L += Tmp - Tmp2; }
+    else { Output->L += Tmp; Output->R += Tmp; }
    }
-   Output.L /= cRSID_C64.Attenuation; //( (CHANNELS*VOLUME_MAX) + cRSID_C64.Attenuation );  // * cRSID_C64.AudioThread_SIDchipCount;
-   Output.R /= cRSID_C64.Attenuation; //( (CHANNELS*VOLUME_MAX) + cRSID_C64.Attenuation );  // * cRSID_C64.AudioThread_SIDchipCount;
+   Output->L /= C64->Attenuation; //( (CHANNELS*VOLUME_MAX) + cRSID_C64.Attenuation );  // * cRSID_C64.AudioThread_SIDchipCount;
+   Output->R /= C64->Attenuation; //( (CHANNELS*VOLUME_MAX) + cRSID_C64.Attenuation );  // * cRSID_C64.AudioThread_SIDchipCount;
   } break;
  }
- return &Output;
+ return Output;
 }
 
 
 
-static INLINE void cRSID_emulateOversampledSIDwaves () { //averaging oversampler, only oscillators & waveforms (called at samplerate-pace)
+static INLINE void cRSID_emulateOversampledSIDwaves (FASTVAR cRSID_C64instance *const C64) { //averaging oversampler, only oscillators & waveforms (called at samplerate-pace)
  FASTVAR unsigned char HQsampleCount = 0;  FASTVAR int Temp;
  //2-pole Chebyshev filter: coefficients for 0.075f (cutoff is 18.4734kHz at 5.5x oversampling):
  //a0=3.869430E-02, a1=7.738860E-02, a2=3.869430E-02,  //fixedpoint (1.0=16384): a0 = 634, a1 = 1268,  a2 = 634
@@ -104,167 +104,183 @@ static INLINE void cRSID_emulateOversampledSIDwaves () { //averaging oversampler
   //fixedpoint (1.0=16384): 46,  184,    273,   184,    46   -> sum = 733 -> 1024
  //    0,        2.764031E+00, -3.122854E+00, 1.664554E+00, -3.502232E-01
   //fixedpoint (1.0=16384): 0,  45286, -51165, 27272, -5738  -> 0, 49152, -53278, 24576, -6144   for example
- static int NonFiltSample1=0, FiltSample1=0, PrevNonFiltSample1=0, PrevFiltSample1=0;
- static int NonFiltSample2=0, FiltSample2=0, PrevNonFiltSample2=0, PrevFiltSample2=0;
- static int NonFiltSample3=0, FiltSample3=0, PrevNonFiltSample3=0, PrevFiltSample3=0;
- static int NonFiltSample4=0, FiltSample4=0, PrevNonFiltSample4=0, PrevFiltSample4=0;
- static cRSID_SIDwavOutput SIDwavOutput;
+ cRSID_SIDwavOutput SIDwavOutput;
 
  HQsampleCount=0;
- cRSID_C64.SID[1].NonFiltedSample = cRSID_C64.SID[1].FilterInputSample = 0;
- cRSID_C64.SID[2].NonFiltedSample = cRSID_C64.SID[2].FilterInputSample = 0;
- cRSID_C64.SID[3].NonFiltedSample = cRSID_C64.SID[3].FilterInputSample = 0;
- cRSID_C64.SID[4].NonFiltedSample = cRSID_C64.SID[4].FilterInputSample = 0;
+ C64->SID[1].NonFiltedSample = C64->SID[1].FilterInputSample = 0;
+ C64->SID[2].NonFiltedSample = C64->SID[2].FilterInputSample = 0;
+ C64->SID[3].NonFiltedSample = C64->SID[3].FilterInputSample = 0;
+ C64->SID[4].NonFiltedSample = C64->SID[4].FilterInputSample = 0;
 
- while (cRSID_C64.OverSampleCycleCnt <= cRSID_C64.SampleClockRatio) {
+ while (C64->OverSampleCycleCnt <= C64->SampleClockRatio) {
 
-  SIDwavOutput = cRSID_emulateHQwaves( &cRSID_C64.SID[1], CRSID_OVERSAMPLING_CYCLES );
-  Temp = PrevNonFiltSample1; PrevNonFiltSample1 = NonFiltSample1;
-  NonFiltSample1 += ( SIDwavOutput.NonFilted + NonFiltSample1 * 3 - (Temp << 2) ) >> 3; //( SIDwavOutput.NonFilted + NonFiltSample1 - (Temp << 1) ) >> 2; //(SIDwavOutput.NonFilted - NonFiltSample1) >> 2;
-  Temp = PrevFiltSample1; PrevFiltSample1 = FiltSample1;
-  FiltSample1 += ( SIDwavOutput.FilterInput + FiltSample1 * 3 - (Temp << 2) ) >> 3; //( SIDwavOutput.FilterInput + FiltSample1 - (Temp << 1) ) >> 2; //(SIDwavOutput.FilterInput - FiltSample1) >> 2;
-  cRSID_C64.SID[1].NonFiltedSample += NonFiltSample1; cRSID_C64.SID[1].FilterInputSample += FiltSample1;
+  SIDwavOutput = cRSID_emulateHQwaves( C64, &C64->SID[1], CRSID_OVERSAMPLING_CYCLES );
+  Temp = C64->OversamplerPrevNonFilt[1]; C64->OversamplerPrevNonFilt[1] = C64->OversamplerNonFilt[1];
+  C64->OversamplerNonFilt[1] += ( SIDwavOutput.NonFilted + C64->OversamplerNonFilt[1] * 3 - (Temp << 2) ) >> 3; //( SIDwavOutput.NonFilted + cRSID_C64.OversamplerNonFilt[1] - (Temp << 1) ) >> 2; //(SIDwavOutput.NonFilted - cRSID_C64.OversamplerNonFilt[1]) >> 2;
+  Temp = C64->OversamplerPrevFilt[1]; C64->OversamplerPrevFilt[1] = C64->OversamplerFilt[1];
+  C64->OversamplerFilt[1] += ( SIDwavOutput.FilterInput + C64->OversamplerFilt[1] * 3 - (Temp << 2) ) >> 3; //( SIDwavOutput.FilterInput + cRSID_C64.OversamplerFilt[1] - (Temp << 1) ) >> 2; //(SIDwavOutput.FilterInput - cRSID_C64.OversamplerFilt[1]) >> 2;
+  C64->SID[1].NonFiltedSample += C64->OversamplerNonFilt[1]; C64->SID[1].FilterInputSample += C64->OversamplerFilt[1];
 
   //2-pole Chebyshev-based fast integer-only fixed-point ~18kHz Nyquist/antialiasing-filters for all SIDs
-  if ( TIGHTLY (cRSID_C64.SID[2].BaseAddress != 0) ) {
-   SIDwavOutput = cRSID_emulateHQwaves( &cRSID_C64.SID[2], CRSID_OVERSAMPLING_CYCLES );
-   Temp = PrevNonFiltSample2; PrevNonFiltSample2 = NonFiltSample2;
-   NonFiltSample2 += ( SIDwavOutput.NonFilted + NonFiltSample2 * 3 - (Temp << 2) ) >> 3;
-   Temp = PrevFiltSample2; PrevFiltSample2 = FiltSample2;
-   FiltSample2 += ( SIDwavOutput.FilterInput + FiltSample2 * 3 - (Temp << 2) ) >> 3;
-   cRSID_C64.SID[2].NonFiltedSample += NonFiltSample2; cRSID_C64.SID[2].FilterInputSample += FiltSample2; //SIDwavOutput.FilterInput;
+  if ( TIGHTLY (C64->SID[2].BaseAddress != 0) ) {
+   SIDwavOutput = cRSID_emulateHQwaves( C64, &C64->SID[2], CRSID_OVERSAMPLING_CYCLES );
+   Temp = C64->OversamplerPrevNonFilt[2]; C64->OversamplerPrevNonFilt[2] = C64->OversamplerNonFilt[2];
+   C64->OversamplerNonFilt[2] += ( SIDwavOutput.NonFilted + C64->OversamplerNonFilt[2] * 3 - (Temp << 2) ) >> 3;
+   Temp = C64->OversamplerPrevFilt[2]; C64->OversamplerPrevFilt[2] = C64->OversamplerFilt[2];
+   C64->OversamplerFilt[2] += ( SIDwavOutput.FilterInput + C64->OversamplerFilt[2] * 3 - (Temp << 2) ) >> 3;
+   C64->SID[2].NonFiltedSample += C64->OversamplerNonFilt[2]; C64->SID[2].FilterInputSample += C64->OversamplerFilt[2]; //SIDwavOutput.FilterInput;
   }
-  if ( TIGHTLY (cRSID_C64.SID[3].BaseAddress != 0) ) {
-   SIDwavOutput = cRSID_emulateHQwaves( &cRSID_C64.SID[3], CRSID_OVERSAMPLING_CYCLES );
-   Temp = PrevNonFiltSample3; PrevNonFiltSample3 = NonFiltSample3;
-   NonFiltSample3 += ( SIDwavOutput.NonFilted + NonFiltSample3 * 3 - (Temp << 2) ) >> 3;
-   Temp = PrevFiltSample3; PrevFiltSample3 = FiltSample3;
-   FiltSample3 += ( SIDwavOutput.FilterInput + FiltSample3 * 3 - (Temp << 2) ) >> 3;
-   cRSID_C64.SID[3].NonFiltedSample += NonFiltSample3; cRSID_C64.SID[3].FilterInputSample += FiltSample3; //SIDwavOutput.FilterInput;
+  if ( TIGHTLY (C64->SID[3].BaseAddress != 0) ) {
+   SIDwavOutput = cRSID_emulateHQwaves( C64, &C64->SID[3], CRSID_OVERSAMPLING_CYCLES );
+   Temp = C64->OversamplerPrevNonFilt[3]; C64->OversamplerPrevNonFilt[3] = C64->OversamplerNonFilt[3];
+   C64->OversamplerNonFilt[3] += ( SIDwavOutput.NonFilted + C64->OversamplerNonFilt[3] * 3 - (Temp << 2) ) >> 3;
+   Temp = C64->OversamplerPrevFilt[3]; C64->OversamplerPrevFilt[3] = C64->OversamplerFilt[3];
+   C64->OversamplerFilt[3] += ( SIDwavOutput.FilterInput + C64->OversamplerFilt[3] * 3 - (Temp << 2) ) >> 3;
+   C64->SID[3].NonFiltedSample += C64->OversamplerNonFilt[3]; C64->SID[3].FilterInputSample += C64->OversamplerFilt[3]; //SIDwavOutput.FilterInput;
   }
-  if ( TIGHTLY (cRSID_C64.SID[4].BaseAddress != 0) ) {
-   SIDwavOutput = cRSID_emulateHQwaves( &cRSID_C64.SID[4], CRSID_OVERSAMPLING_CYCLES );
-   Temp = PrevNonFiltSample4; PrevNonFiltSample4 = NonFiltSample4;
-   NonFiltSample4 += ( SIDwavOutput.NonFilted + NonFiltSample4 * 3 - (Temp << 2) ) >> 3;
-   Temp = PrevFiltSample4; PrevFiltSample4 = FiltSample4;
-   FiltSample4 += ( SIDwavOutput.FilterInput + FiltSample4 * 3 - (Temp << 2) ) >> 3;
-   cRSID_C64.SID[4].NonFiltedSample += NonFiltSample4; cRSID_C64.SID[4].FilterInputSample += FiltSample3; //SIDwavOutput.FilterInput;
+  if ( TIGHTLY (C64->SID[4].BaseAddress != 0) ) {
+   SIDwavOutput = cRSID_emulateHQwaves( C64, &C64->SID[4], CRSID_OVERSAMPLING_CYCLES );
+   Temp = C64->OversamplerPrevNonFilt[4]; C64->OversamplerPrevNonFilt[4] = C64->OversamplerNonFilt[4];
+   C64->OversamplerNonFilt[4] += ( SIDwavOutput.NonFilted + C64->OversamplerNonFilt[4] * 3 - (Temp << 2) ) >> 3;
+   Temp = C64->OversamplerPrevFilt[4]; C64->OversamplerPrevFilt[4] = C64->OversamplerFilt[4];
+   C64->OversamplerFilt[4] += ( SIDwavOutput.FilterInput + C64->OversamplerFilt[4] * 3 - (Temp << 2) ) >> 3;
+   C64->SID[4].NonFiltedSample += C64->OversamplerNonFilt[4]; C64->SID[4].FilterInputSample += C64->OversamplerFilt[3]; //SIDwavOutput.FilterInput;
   }
   ++HQsampleCount;
-  cRSID_C64.OverSampleCycleCnt += (CRSID_OVERSAMPLING_CYCLES << CRSID_CLOCK_FRACTIONAL_BITS);
+  C64->OverSampleCycleCnt += (CRSID_OVERSAMPLING_CYCLES << CRSID_CLOCK_FRACTIONAL_BITS);
  }
- cRSID_C64.OverSampleCycleCnt -= cRSID_C64.SampleClockRatio;
+ C64->OverSampleCycleCnt -= C64->SampleClockRatio;
 
  //fast resampler - averaging of accumulated samples, decreases sound-aliasing further:
- cRSID_C64.SID[1].NonFiltedSample /= HQsampleCount; cRSID_C64.SID[1].FilterInputSample /= HQsampleCount;
- if ( TIGHTLY (cRSID_C64.SID[2].BaseAddress != 0) ) {
-  cRSID_C64.SID[2].NonFiltedSample /= HQsampleCount; cRSID_C64.SID[2].FilterInputSample /= HQsampleCount;
+ C64->SID[1].NonFiltedSample /= HQsampleCount; C64->SID[1].FilterInputSample /= HQsampleCount;
+ if ( TIGHTLY (C64->SID[2].BaseAddress != 0) ) {
+  C64->SID[2].NonFiltedSample /= HQsampleCount; C64->SID[2].FilterInputSample /= HQsampleCount;
  }
- if ( TIGHTLY (cRSID_C64.SID[3].BaseAddress != 0) ) {
-  cRSID_C64.SID[3].NonFiltedSample /= HQsampleCount; cRSID_C64.SID[3].FilterInputSample /= HQsampleCount;
+ if ( TIGHTLY (C64->SID[3].BaseAddress != 0) ) {
+  C64->SID[3].NonFiltedSample /= HQsampleCount; C64->SID[3].FilterInputSample /= HQsampleCount;
  }
- if ( TIGHTLY (cRSID_C64.SID[4].BaseAddress != 0) ) {
-  cRSID_C64.SID[4].NonFiltedSample /= HQsampleCount; cRSID_C64.SID[4].FilterInputSample /= HQsampleCount;
+ if ( TIGHTLY (C64->SID[4].BaseAddress != 0) ) {
+  C64->SID[4].NonFiltedSample /= HQsampleCount; C64->SID[4].FilterInputSample /= HQsampleCount;
  }
 }
 
 
 
-static INLINE cRSID_Output* cRSID_emulateOversampledSIDoutputs () { //called at samplerate-pace, filters and complete output stages
+static INLINE cRSID_Output* cRSID_emulateOversampledSIDoutputs (FASTVAR cRSID_C64instance *const C64) { //called at samplerate-pace, filters and complete output stages
  static enum { VOLUME_MAX=0xF, CHANNELS=3+1 } SIDspecs; //digi-channel is counted too in attenuation
 
  FASTVAR signed int Tmp, Tmp2;
- static cRSID_Output Output;
+ cRSID_Output* const Output = &C64->MixedOutput;
 
- switch (cRSID_C64.Stereo) {  //if ( MOSTLY (cRSID_C64.Stereo==CRSID_CHANNELMODE_MONO /*|| cRSID_C64.AudioThread_SIDchipCount==1*/) ) { //mono
+ switch (C64->Stereo) {  //if ( MOSTLY (cRSID_C64.Stereo==CRSID_CHANNELMODE_MONO /*|| cRSID_C64.AudioThread_SIDchipCount==1*/) ) { //mono
   case CRSID_CHANNELMODE_MONO: {
-   Output.L /*= Output.R*/ = cRSID_emulateSIDoutputStage( &cRSID_C64.SID[1] ); //, cRSID_C64.HighQualityResampler );
-   if ( TIGHTLY (cRSID_C64.SID[2].BaseAddress != 0) ) Output.L += cRSID_emulateSIDoutputStage( &cRSID_C64.SID[2] ); //, cRSID_C64.HighQualityResampler );
-   if ( TIGHTLY (cRSID_C64.SID[3].BaseAddress != 0) ) Output.L += cRSID_emulateSIDoutputStage( &cRSID_C64.SID[3] ); //, cRSID_C64.HighQualityResampler );
-   if ( TIGHTLY (cRSID_C64.SID[4].BaseAddress != 0) ) Output.L += cRSID_emulateSIDoutputStage( &cRSID_C64.SID[4] ); //, cRSID_C64.HighQualityResampler );
-   Output.R = Output.L /= cRSID_C64.Attenuation; //( (CHANNELS*VOLUME_MAX) + cRSID_C64.Attenuation );  // * cRSID_C64.AudioThread_SIDchipCount; //better being multiplied in a single place than for all SIDs
+   Output->L /*= Output->R*/ = cRSID_emulateSIDoutputStage( C64, &C64->SID[1] ); //, cRSID_C64.HighQualityResampler );
+   if ( TIGHTLY (C64->SID[2].BaseAddress != 0) ) Output->L += cRSID_emulateSIDoutputStage( C64, &C64->SID[2] ); //, cRSID_C64.HighQualityResampler );
+   if ( TIGHTLY (C64->SID[3].BaseAddress != 0) ) Output->L += cRSID_emulateSIDoutputStage( C64, &C64->SID[3] ); //, cRSID_C64.HighQualityResampler );
+   if ( TIGHTLY (C64->SID[4].BaseAddress != 0) ) Output->L += cRSID_emulateSIDoutputStage( C64, &C64->SID[4] ); //, cRSID_C64.HighQualityResampler );
+   Output->R = Output->L /= C64->Attenuation; //( (CHANNELS*VOLUME_MAX) + cRSID_C64.Attenuation );  // * cRSID_C64.AudioThread_SIDchipCount; //better being multiplied in a single place than for all SIDs
   } break;
   case CRSID_CHANNELMODE_STEREO: {  //else { //stereo
-   Tmp = cRSID_emulateSIDoutputStage( &cRSID_C64.SID[1] ); //, cRSID_C64.HighQualityResampler );
-   if ( RARELY (cRSID_C64.SID[1].Channel == CRSID_CHANNEL_LEFT) ) { Output.L = Tmp * 2; Output.R=0; }
-   else if ( RARELY (cRSID_C64.SID[1].Channel == CRSID_CHANNEL_RIGHT) ) { Output.R = Tmp * 2; Output.L=0; }
-   else Output.L = Output.R = Tmp;
-   if ( TIGHTLY (cRSID_C64.SID[2].BaseAddress != 0) ) {
-    Tmp = cRSID_emulateSIDoutputStage( &cRSID_C64.SID[2] ); //, cRSID_C64.HighQualityResampler );
-    if (cRSID_C64.SID[2].Channel == CRSID_CHANNEL_LEFT)  Output.L += Tmp * 2;
-    else if (cRSID_C64.SID[2].Channel == CRSID_CHANNEL_RIGHT) Output.R += Tmp * 2;
-    else { Output.L += Tmp; Output.R += Tmp; }
+   Tmp = cRSID_emulateSIDoutputStage( C64, &C64->SID[1] ); //, cRSID_C64.HighQualityResampler );
+   if ( RARELY (C64->SID[1].Channel == CRSID_CHANNEL_LEFT) ) { Output->L = Tmp * 2; Output->R=0; }
+   else if ( RARELY (C64->SID[1].Channel == CRSID_CHANNEL_RIGHT) ) { Output->R = Tmp * 2; Output->L=0; }
+   else Output->L = Output->R = Tmp;
+   if ( TIGHTLY (C64->SID[2].BaseAddress != 0) ) {
+    Tmp = cRSID_emulateSIDoutputStage( C64, &C64->SID[2] ); //, cRSID_C64.HighQualityResampler );
+    if (C64->SID[2].Channel == CRSID_CHANNEL_LEFT)  Output->L += Tmp * 2;
+    else if (C64->SID[2].Channel == CRSID_CHANNEL_RIGHT) Output->R += Tmp * 2;
+    else { Output->L += Tmp; Output->R += Tmp; }
    }
-   if ( TIGHTLY (cRSID_C64.SID[3].BaseAddress != 0) ) {
-    Tmp = cRSID_emulateSIDoutputStage( &cRSID_C64.SID[3] ); //, cRSID_C64.HighQualityResampler );
-    if ( UNLIKELY (cRSID_C64.SID[3].Channel == CRSID_CHANNEL_LEFT) ) Output.L += Tmp * 2;
-    else if ( UNLIKELY (cRSID_C64.SID[3].Channel == CRSID_CHANNEL_RIGHT) ) Output.R += Tmp * 2;
-    else { Output.L += Tmp; Output.R += Tmp; }
+   if ( TIGHTLY (C64->SID[3].BaseAddress != 0) ) {
+    Tmp = cRSID_emulateSIDoutputStage( C64, &C64->SID[3] ); //, cRSID_C64.HighQualityResampler );
+    if ( UNLIKELY (C64->SID[3].Channel == CRSID_CHANNEL_LEFT) ) Output->L += Tmp * 2;
+    else if ( UNLIKELY (C64->SID[3].Channel == CRSID_CHANNEL_RIGHT) ) Output->R += Tmp * 2;
+    else { Output->L += Tmp; Output->R += Tmp; }
    }
-   if ( TIGHTLY (cRSID_C64.SID[4].BaseAddress != 0) ) {
-    Tmp = cRSID_emulateSIDoutputStage( &cRSID_C64.SID[4] ); //, cRSID_C64.HighQualityResampler );
-    if (cRSID_C64.SID[4].Channel == CRSID_CHANNEL_LEFT)  Output.L += Tmp * 2;
-    else if (cRSID_C64.SID[4].Channel == CRSID_CHANNEL_RIGHT) Output.R += Tmp * 2;
-    else { Output.L += Tmp; Output.R += Tmp; }
+   if ( TIGHTLY (C64->SID[4].BaseAddress != 0) ) {
+    Tmp = cRSID_emulateSIDoutputStage( C64, &C64->SID[4] ); //, cRSID_C64.HighQualityResampler );
+    if (C64->SID[4].Channel == CRSID_CHANNEL_LEFT)  Output->L += Tmp * 2;
+    else if (C64->SID[4].Channel == CRSID_CHANNEL_RIGHT) Output->R += Tmp * 2;
+    else { Output->L += Tmp; Output->R += Tmp; }
    }
-   Output.L /= cRSID_C64.Attenuation; //( (CHANNELS*VOLUME_MAX) + cRSID_C64.Attenuation );  // * cRSID_C64.AudioThread_SIDchipCount;
-   Output.R /= cRSID_C64.Attenuation; //( (CHANNELS*VOLUME_MAX) + cRSID_C64.Attenuation );  // * cRSID_C64.AudioThread_SIDchipCount;
+   Output->L /= C64->Attenuation; //( (CHANNELS*VOLUME_MAX) + cRSID_C64.Attenuation );  // * cRSID_C64.AudioThread_SIDchipCount;
+   Output->R /= C64->Attenuation; //( (CHANNELS*VOLUME_MAX) + cRSID_C64.Attenuation );  // * cRSID_C64.AudioThread_SIDchipCount;
   } break;
   case CRSID_CHANNELMODE_NARROW: {  //narrowed stereo (channels are closer to each other and the center)
-   Tmp = cRSID_emulateSIDoutputStage( &cRSID_C64.SID[1] ); //, cRSID_C64.HighQualityResampler );
-   if ( RARELY (cRSID_C64.SID[1].Channel == CRSID_CHANNEL_LEFT) ) {
-    Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output.L = Tmp + Tmp2; Output.R = Tmp - Tmp2;
+   Tmp = cRSID_emulateSIDoutputStage( C64, &C64->SID[1] ); //, cRSID_C64.HighQualityResampler );
+   if ( RARELY (C64->SID[1].Channel == CRSID_CHANNEL_LEFT) ) {
+    Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output->L = Tmp + Tmp2; Output->R = Tmp - Tmp2;
    }
-   else if ( RARELY (cRSID_C64.SID[1].Channel == CRSID_CHANNEL_RIGHT) ) {
-    Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output.R = Tmp + Tmp2; Output.L = Tmp - Tmp2;
+   else if ( RARELY (C64->SID[1].Channel == CRSID_CHANNEL_RIGHT) ) {
+    Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output->R = Tmp + Tmp2; Output->L = Tmp - Tmp2;
    }
-   else Output.L = Output.R = Tmp;
-   if ( TIGHTLY (cRSID_C64.SID[2].BaseAddress != 0) ) {
-    Tmp = cRSID_emulateSIDoutputStage( &cRSID_C64.SID[2] ); //, cRSID_C64.HighQualityResampler );
-    if (cRSID_C64.SID[2].Channel == CRSID_CHANNEL_LEFT) {
-     Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output.L += Tmp + Tmp2; Output.R += Tmp - Tmp2;
+   else Output->L = Output->R = Tmp;
+   if ( TIGHTLY (C64->SID[2].BaseAddress != 0) ) {
+    Tmp = cRSID_emulateSIDoutputStage( C64, &C64->SID[2] ); //, cRSID_C64.HighQualityResampler );
+    if (C64->SID[2].Channel == CRSID_CHANNEL_LEFT) {
+     Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output->L += Tmp + Tmp2; Output->R += Tmp - Tmp2;
     }
-    else if (cRSID_C64.SID[2].Channel == CRSID_CHANNEL_RIGHT) {
-     Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output.R += Tmp + Tmp2; Output.L += Tmp - Tmp2;
+    else if (C64->SID[2].Channel == CRSID_CHANNEL_RIGHT) {
+     Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output->R += Tmp + Tmp2; Output->L += Tmp - Tmp2;
     }
-    else { Output.L += Tmp; Output.R += Tmp; }
+    else { Output->L += Tmp; Output->R += Tmp; }
    }
-   if ( TIGHTLY (cRSID_C64.SID[3].BaseAddress != 0) ) {
-    Tmp = cRSID_emulateSIDoutputStage( &cRSID_C64.SID[3] ); //, cRSID_C64.HighQualityResampler );
-    if ( UNLIKELY (cRSID_C64.SID[3].Channel == CRSID_CHANNEL_LEFT) ) {
-     Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output.L += Tmp + Tmp2; Output.R += Tmp - Tmp2;
+   if ( TIGHTLY (C64->SID[3].BaseAddress != 0) ) {
+    Tmp = cRSID_emulateSIDoutputStage( C64, &C64->SID[3] ); //, cRSID_C64.HighQualityResampler );
+    if ( UNLIKELY (C64->SID[3].Channel == CRSID_CHANNEL_LEFT) ) {
+     Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output->L += Tmp + Tmp2; Output->R += Tmp - Tmp2;
     }
-    else if ( UNLIKELY (cRSID_C64.SID[3].Channel == CRSID_CHANNEL_RIGHT) ) {
-     Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output.R += Tmp + Tmp2; Output.L += Tmp - Tmp2;
+    else if ( UNLIKELY (C64->SID[3].Channel == CRSID_CHANNEL_RIGHT) ) {
+     Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output->R += Tmp + Tmp2; Output->L += Tmp - Tmp2;
     }
-    else { Output.L += Tmp; Output.R += Tmp; }
+    else { Output->L += Tmp; Output->R += Tmp; }
    }
-   if ( TIGHTLY (cRSID_C64.SID[4].BaseAddress != 0) ) {
-    Tmp = cRSID_emulateSIDoutputStage( &cRSID_C64.SID[4] ); //, cRSID_C64.HighQualityResampler );
-    if (cRSID_C64.SID[4].Channel == CRSID_CHANNEL_LEFT) {
-     Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output.L += Tmp + Tmp2; Output.R += Tmp - Tmp2;
+   if ( TIGHTLY (C64->SID[4].BaseAddress != 0) ) {
+    Tmp = cRSID_emulateSIDoutputStage( C64, &C64->SID[4] ); //, cRSID_C64.HighQualityResampler );
+    if (C64->SID[4].Channel == CRSID_CHANNEL_LEFT) {
+     Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output->L += Tmp + Tmp2; Output->R += Tmp - Tmp2;
     }
-    else if (cRSID_C64.SID[4].Channel == CRSID_CHANNEL_RIGHT) {
-     Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output.R += Tmp + Tmp2; Output.L += Tmp - Tmp2;
+    else if (C64->SID[4].Channel == CRSID_CHANNEL_RIGHT) {
+     Tmp2 = Tmp >> CRSID_CHANNELPANNING_DIVSHIFTS;  Output->R += Tmp + Tmp2; Output->L += Tmp - Tmp2;
     }
-    else { Output.L += Tmp; Output.R += Tmp; }
+    else { Output->L += Tmp; Output->R += Tmp; }
    }
-   Output.L /= cRSID_C64.Attenuation; //( (CHANNELS*VOLUME_MAX) + cRSID_C64.Attenuation );  // * cRSID_C64.AudioThread_SIDchipCount;
-   Output.R /= cRSID_C64.Attenuation; //( (CHANNELS*VOLUME_MAX) + cRSID_C64.Attenuation );  // * cRSID_C64.AudioThread_SIDchipCount;
+   Output->L /= C64->Attenuation; //( (CHANNELS*VOLUME_MAX) + cRSID_C64.Attenuation );  // * cRSID_C64.AudioThread_SIDchipCount;
+   Output->R /= C64->Attenuation; //( (CHANNELS*VOLUME_MAX) + cRSID_C64.Attenuation );  // * cRSID_C64.AudioThread_SIDchipCount;
   } break;
  }
- return &Output;
+ return Output;
 }
 
 
 
-static INLINE void cRSID_emulateHQresampledSIDs () { //oscillators, waveforms, filter and attenuation (main-volume) (called at samplerate-pace, but core at oversampled rate)
+#if (CRSID_SIMD != 0 && CRSID_RESAMPLER_SINCWINDOW_PERIODS == 6 && CRSID_RESAMPLER_SINCPERIOD_SAMPLES == 256 && CRSID_RESAMPLER_SINCWINDOW_MAGNITUDE == 2048)
+ #define CRSID_SINCPHASES_SIMD 1 //(SincWindowPhases.h is generated for this window-shape)
+ #include "SincWindowPhases.h"
+
+static INLINE void cRSID_scatterSincPhaseLanes (FASTVAR signed int *const FASTPTR buffer, FASTVAR signed int sample, FASTVAR const signed short *const FASTPTR phase) {
+ //all 8 taps of a Sinc-window phase are added at once, the ones past the ring's end go to the overhang (folded back at the end of the sample)
+ FASTVAR cRSID_Lanes Sample = cRSID_setLanes( sample );
+ cRSID_storeLanes( buffer, cRSID_addLanes( cRSID_loadLanes(buffer), cRSID_divLanesPow2( cRSID_mulLanes( Sample, cRSID_loadShortLanes(phase) ), 11 ) ) );
+ cRSID_storeLanes( buffer+4, cRSID_addLanes( cRSID_loadLanes(buffer+4), cRSID_divLanesPow2( cRSID_mulLanes( Sample, cRSID_loadShortLanes(phase+4) ), 11 ) ) );
+}
+
+static INLINE signed char cRSID_nextSincPhaseWritePos (FASTVAR signed char writepos, FASTVAR int sincwindowpos) { //as the scalar loop leaves it: advanced by the phase's real tap-count
+ writepos += (sincwindowpos < CRSID_RESAMPLER_SINCPERIOD_SAMPLES) ? CRSID_RESAMPLER_SINCWINDOW_PERIODS : CRSID_RESAMPLER_SINCWINDOW_PERIODS-1;
+ return writepos & (CRSID_RESAMPLEBUFFER_SIZE-1);
+}
+#else
+ #define CRSID_SINCPHASES_SIMD 0
+#endif
+
+
+static INLINE void cRSID_emulateHQresampledSIDs (FASTVAR cRSID_C64instance *const C64) { //oscillators, waveforms, filter and attenuation (main-volume) (called at samplerate-pace, but core at oversampled rate)
  static enum {
   //RESAMPLER_FRACTIONAL_BITS = 12,
   FRACTIONAL_MUL = (1 << CRSID_RESAMPLER_FRACTIONAL_BITS), //4096 $1000
   FRACTIONAL_AND = (FRACTIONAL_MUL-1), //4095 $0FFF
   INTEGER_AND = (-FRACTIONAL_MUL), //$F000
-  RESAMPLEBUFFER_SIZE = 16, //entries
+  RESAMPLEBUFFER_SIZE = (CRSID_RESAMPLEBUFFER_SIZE), //16, //entries
    RESAMPLEBUFFER_SIZE_MUL = (RESAMPLEBUFFER_SIZE << CRSID_RESAMPLER_FRACTIONAL_BITS),
   SINCWINDOW_PERIODS = (CRSID_RESAMPLER_SINCWINDOW_PERIODS), //12, //half-sines
    SINCWINDOW_HALF1_LAST_PERIOD = (SINCWINDOW_PERIODS/2-1),
@@ -279,16 +295,15 @@ static INLINE void cRSID_emulateHQresampledSIDs () { //oscillators, waveforms, f
  FASTVAR signed int Tmp, Left, Right;
  FASTVAR signed char Mono, ResampleBufWritePos = 0;
  FASTVAR int SincWindowPos;
- static int ResampleBufPos=0, NextResampleBufPos=FRACTIONAL_MUL;
- static signed int ResampleBufferL [RESAMPLEBUFFER_SIZE] = {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
- static signed int ResampleBufferR [RESAMPLEBUFFER_SIZE] = {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
+ FASTVAR int ResampleBufPos = C64->ResampleBufPos, NextResampleBufPos = C64->NextResampleBufPos; //per-instance state, written back at the end
+ signed int *const FASTPTR ResampleBufferL = C64->ResampleBufferL, *const FASTPTR ResampleBufferR = C64->ResampleBufferR;
  #include "SincWindow.h"
 
- cRSID_precalculateHQoutputParameters( &cRSID_C64.SID[1] );
- if ( TIGHTLY (cRSID_C64.SID[2].BaseAddress != 0) ) cRSID_precalculateHQoutputParameters( &cRSID_C64.SID[2] );
- if ( TIGHTLY (cRSID_C64.SID[3].BaseAddress != 0) ) cRSID_precalculateHQoutputParameters( &cRSID_C64.SID[3] );
- if ( TIGHTLY (cRSID_C64.SID[4].BaseAddress != 0) ) cRSID_precalculateHQoutputParameters( &cRSID_C64.SID[4] );
- Mono = cRSID_C64.Stereo==CRSID_CHANNELMODE_MONO /*|| cRSID_C64.AudioThread_SIDchipCount==1*/;
+ cRSID_precalculateHQoutputParameters( C64, &C64->SID[1] );
+ if ( TIGHTLY (C64->SID[2].BaseAddress != 0) ) cRSID_precalculateHQoutputParameters( C64, &C64->SID[2] );
+ if ( TIGHTLY (C64->SID[3].BaseAddress != 0) ) cRSID_precalculateHQoutputParameters( C64, &C64->SID[3] );
+ if ( TIGHTLY (C64->SID[4].BaseAddress != 0) ) cRSID_precalculateHQoutputParameters( C64, &C64->SID[4] );
+ Mono = C64->Stereo==CRSID_CHANNELMODE_MONO /*|| cRSID_C64.AudioThread_SIDchipCount==1*/;
 
  while (ResampleBufPos < NextResampleBufPos) {
   ResampleBufWritePos = (ResampleBufPos >> CRSID_RESAMPLER_FRACTIONAL_BITS) - SINCWINDOW_HALF1_LAST_PERIOD;
@@ -296,85 +311,109 @@ static INLINE void cRSID_emulateHQresampledSIDs () { //oscillators, waveforms, f
   SincWindowPos = SINCPERIOD_SAMPLES - ( (ResampleBufPos & FRACTIONAL_AND) >> SINCPERIOD_BITS_REVERSE );
 
   if ( MOSTLY (Mono) ) { //mono
-   Left /*= Right*/ = cRSID_emulateHQresampledSID( &cRSID_C64.SID[1], CRSID_OVERSAMPLING_CYCLES ); //.Mix;
-   if ( TIGHTLY (cRSID_C64.SID[2].BaseAddress != 0) ) Left += cRSID_emulateHQresampledSID( &cRSID_C64.SID[2], CRSID_OVERSAMPLING_CYCLES ); //.Mix;
-   if ( TIGHTLY (cRSID_C64.SID[3].BaseAddress != 0) ) Left += cRSID_emulateHQresampledSID( &cRSID_C64.SID[3], CRSID_OVERSAMPLING_CYCLES ); //.Mix;
-   if ( TIGHTLY (cRSID_C64.SID[4].BaseAddress != 0) ) Left += cRSID_emulateHQresampledSID( &cRSID_C64.SID[4], CRSID_OVERSAMPLING_CYCLES ); //.Mix;
+   Left /*= Right*/ = cRSID_emulateHQresampledSID( C64, &C64->SID[1], CRSID_OVERSAMPLING_CYCLES ); //.Mix;
+   if ( TIGHTLY (C64->SID[2].BaseAddress != 0) ) Left += cRSID_emulateHQresampledSID( C64, &C64->SID[2], CRSID_OVERSAMPLING_CYCLES ); //.Mix;
+   if ( TIGHTLY (C64->SID[3].BaseAddress != 0) ) Left += cRSID_emulateHQresampledSID( C64, &C64->SID[3], CRSID_OVERSAMPLING_CYCLES ); //.Mix;
+   if ( TIGHTLY (C64->SID[4].BaseAddress != 0) ) Left += cRSID_emulateHQresampledSID( C64, &C64->SID[4], CRSID_OVERSAMPLING_CYCLES ); //.Mix;
    //Right = Left;
+#if (CRSID_SINCPHASES_SIMD != 0)
+   cRSID_scatterSincPhaseLanes( ResampleBufferL + ResampleBufWritePos, Left, cRSID_SincWindowPhases[SincWindowPos] );
+   ResampleBufWritePos = cRSID_nextSincPhaseWritePos( ResampleBufWritePos, SincWindowPos );
+#else
    while (SincWindowPos < SINCWINDOW_SIZE) { //Resampling subsequent stereo samples to output-sample-buffer
     ResampleBufferL[ResampleBufWritePos] += (Left * SincWindow[SincWindowPos]) / SINCWINDOW_MAGNITUDE; // >> SINCWINDOW_RESOLUTION;
     ++ResampleBufWritePos; if (ResampleBufWritePos >= RESAMPLEBUFFER_SIZE) ResampleBufWritePos=0;
     SincWindowPos += SINCPERIOD_SAMPLES;
    }
+#endif
   }
   else { //stereo
-   Tmp = cRSID_emulateHQresampledSID( &cRSID_C64.SID[1], CRSID_OVERSAMPLING_CYCLES ); //.Mix;
-   if ( RARELY (cRSID_C64.SID[1].Channel == CRSID_CHANNEL_LEFT) ) { Left = Tmp * 2; Right=0; }
-   else if ( RARELY (cRSID_C64.SID[1].Channel == CRSID_CHANNEL_RIGHT) ) { Right = Tmp * 2; Left=0; }
+   Tmp = cRSID_emulateHQresampledSID( C64, &C64->SID[1], CRSID_OVERSAMPLING_CYCLES ); //.Mix;
+   if ( RARELY (C64->SID[1].Channel == CRSID_CHANNEL_LEFT) ) { Left = Tmp * 2; Right=0; }
+   else if ( RARELY (C64->SID[1].Channel == CRSID_CHANNEL_RIGHT) ) { Right = Tmp * 2; Left=0; }
    else Left = Right = Tmp;
-   if ( TIGHTLY (cRSID_C64.SID[2].BaseAddress != 0) ) {
-    Tmp = cRSID_emulateHQresampledSID( &cRSID_C64.SID[2], CRSID_OVERSAMPLING_CYCLES ); //.Mix;
-    if (cRSID_C64.SID[2].Channel == CRSID_CHANNEL_LEFT)  Left += Tmp * 2;
-    else if (cRSID_C64.SID[2].Channel == CRSID_CHANNEL_RIGHT) Right += Tmp * 2;
+   if ( TIGHTLY (C64->SID[2].BaseAddress != 0) ) {
+    Tmp = cRSID_emulateHQresampledSID( C64, &C64->SID[2], CRSID_OVERSAMPLING_CYCLES ); //.Mix;
+    if (C64->SID[2].Channel == CRSID_CHANNEL_LEFT)  Left += Tmp * 2;
+    else if (C64->SID[2].Channel == CRSID_CHANNEL_RIGHT) Right += Tmp * 2;
     else { Left += Tmp; Right += Tmp; }
    }
-   if ( TIGHTLY (cRSID_C64.SID[3].BaseAddress != 0) ) {
-    Tmp = cRSID_emulateHQresampledSID( &cRSID_C64.SID[3], CRSID_OVERSAMPLING_CYCLES ); //.Mix;
-    if ( UNLIKELY (cRSID_C64.SID[3].Channel == CRSID_CHANNEL_LEFT) ) Left += Tmp * 2;
-    else if ( UNLIKELY (cRSID_C64.SID[3].Channel == CRSID_CHANNEL_RIGHT) ) Right += Tmp * 2;
+   if ( TIGHTLY (C64->SID[3].BaseAddress != 0) ) {
+    Tmp = cRSID_emulateHQresampledSID( C64, &C64->SID[3], CRSID_OVERSAMPLING_CYCLES ); //.Mix;
+    if ( UNLIKELY (C64->SID[3].Channel == CRSID_CHANNEL_LEFT) ) Left += Tmp * 2;
+    else if ( UNLIKELY (C64->SID[3].Channel == CRSID_CHANNEL_RIGHT) ) Right += Tmp * 2;
     else { Left += Tmp; Right += Tmp; }
    }
-   if ( TIGHTLY (cRSID_C64.SID[4].BaseAddress != 0) ) {
-    Tmp = cRSID_emulateHQresampledSID( &cRSID_C64.SID[4], CRSID_OVERSAMPLING_CYCLES ); //.Mix;
-    if (cRSID_C64.SID[4].Channel == CRSID_CHANNEL_LEFT)  Left += Tmp * 2;
-    else if (cRSID_C64.SID[4].Channel == CRSID_CHANNEL_RIGHT) Right += Tmp * 2;
+   if ( TIGHTLY (C64->SID[4].BaseAddress != 0) ) {
+    Tmp = cRSID_emulateHQresampledSID( C64, &C64->SID[4], CRSID_OVERSAMPLING_CYCLES ); //.Mix;
+    if (C64->SID[4].Channel == CRSID_CHANNEL_LEFT)  Left += Tmp * 2;
+    else if (C64->SID[4].Channel == CRSID_CHANNEL_RIGHT) Right += Tmp * 2;
     else { Left += Tmp; Right += Tmp; }
    }
+#if (CRSID_SINCPHASES_SIMD != 0)
+   cRSID_scatterSincPhaseLanes( ResampleBufferL + ResampleBufWritePos, Left, cRSID_SincWindowPhases[SincWindowPos] );
+   cRSID_scatterSincPhaseLanes( ResampleBufferR + ResampleBufWritePos, Right, cRSID_SincWindowPhases[SincWindowPos] );
+   ResampleBufWritePos = cRSID_nextSincPhaseWritePos( ResampleBufWritePos, SincWindowPos );
+#else
    while (SincWindowPos < SINCWINDOW_SIZE) { //Resampling subsequent stereo samples to output-sample-buffer
     ResampleBufferL[ResampleBufWritePos] += (Left * SincWindow[SincWindowPos]) / SINCWINDOW_MAGNITUDE; // >> SINCWINDOW_RESOLUTION;
     ResampleBufferR[ResampleBufWritePos] += (Right * SincWindow[SincWindowPos]) / SINCWINDOW_MAGNITUDE; // >> SINCWINDOW_RESOLUTION;
     ++ResampleBufWritePos; if (ResampleBufWritePos >= RESAMPLEBUFFER_SIZE) ResampleBufWritePos=0;
     SincWindowPos += SINCPERIOD_SAMPLES;
    }
+#endif
   }
 
-  ResampleBufPos += cRSID_C64.OversampleClockRatio;
+  ResampleBufPos += C64->OversampleClockRatio;
  }
 
+ cRSID_emulateHQscopeVoiceOutputs( C64, &C64->SID[1] );
+ if ( TIGHTLY (C64->SID[2].BaseAddress != 0) ) cRSID_emulateHQscopeVoiceOutputs( C64, &C64->SID[2] );
+ if ( TIGHTLY (C64->SID[3].BaseAddress != 0) ) cRSID_emulateHQscopeVoiceOutputs( C64, &C64->SID[3] );
+ if ( TIGHTLY (C64->SID[4].BaseAddress != 0) ) cRSID_emulateHQscopeVoiceOutputs( C64, &C64->SID[4] );
+
+#if (CRSID_SINCPHASES_SIMD != 0)
+ for (Tmp = 0; Tmp < CRSID_RESAMPLEBUFFER_OVERHANG; ++Tmp) { //fold the unwrapped writes past the ring's end back to its start
+  ResampleBufferL[Tmp] += ResampleBufferL[RESAMPLEBUFFER_SIZE + Tmp]; ResampleBufferL[RESAMPLEBUFFER_SIZE + Tmp] = 0;
+  ResampleBufferR[Tmp] += ResampleBufferR[RESAMPLEBUFFER_SIZE + Tmp]; ResampleBufferR[RESAMPLEBUFFER_SIZE + Tmp] = 0;
+ }
+#endif
+
  if (ResampleBufPos >= RESAMPLEBUFFER_SIZE_MUL) ResampleBufPos -= RESAMPLEBUFFER_SIZE_MUL;
   NextResampleBufPos = (ResampleBufPos & INTEGER_AND) + FRACTIONAL_MUL;
- cRSID_C64.ResampledOutput.L = ResampleBufferL[ResampleBufWritePos] / cRSID_C64.OversampleClockRatioReciproc;
+ C64->ResampledOutput.L = ResampleBufferL[ResampleBufWritePos] / C64->OversampleClockRatioReciproc;
   ResampleBufferL[ResampleBufWritePos] = 0;
  if ( RARELY (!Mono) ) { //stereo
-  cRSID_C64.ResampledOutput.R = ResampleBufferR[ResampleBufWritePos] / cRSID_C64.OversampleClockRatioReciproc;
+  C64->ResampledOutput.R = ResampleBufferR[ResampleBufWritePos] / C64->OversampleClockRatioReciproc;
    ResampleBufferR[ResampleBufWritePos] = 0;
  }
+ C64->ResampleBufPos = ResampleBufPos; C64->NextResampleBufPos = NextResampleBufPos;
 }
 
 
 
-static INLINE cRSID_Output* cRSID_emulateHQresampledSIDoutputs () { //called at samplerate-pace, only adding digi and final attenuation
+static INLINE cRSID_Output* cRSID_emulateHQresampledSIDoutputs (FASTVAR cRSID_C64instance *const C64) { //called at samplerate-pace, only adding digi and final attenuation
  static enum { VOLUME_MAX=0xF, CHANNELS=3+1 } SIDspecs; //digi-channel is counted too in attenuation
 
  FASTVAR signed int Tmp;
- static cRSID_Output Output;
+ cRSID_Output* const Output = &C64->MixedOutput;
 
- cRSID_emulateHQresampledSIDdigi( &cRSID_C64.SID[1], &cRSID_C64.ResampledOutput );
- if ( TIGHTLY (cRSID_C64.SID[2].BaseAddress != 0) ) cRSID_emulateHQresampledSIDdigi( &cRSID_C64.SID[2], &cRSID_C64.ResampledOutput );
- if ( TIGHTLY (cRSID_C64.SID[3].BaseAddress != 0) ) cRSID_emulateHQresampledSIDdigi( &cRSID_C64.SID[3], &cRSID_C64.ResampledOutput );
- if ( TIGHTLY (cRSID_C64.SID[4].BaseAddress != 0) ) cRSID_emulateHQresampledSIDdigi( &cRSID_C64.SID[4], &cRSID_C64.ResampledOutput );
+ cRSID_emulateHQresampledSIDdigi( C64, &C64->SID[1], &C64->ResampledOutput );
+ if ( TIGHTLY (C64->SID[2].BaseAddress != 0) ) cRSID_emulateHQresampledSIDdigi( C64, &C64->SID[2], &C64->ResampledOutput );
+ if ( TIGHTLY (C64->SID[3].BaseAddress != 0) ) cRSID_emulateHQresampledSIDdigi( C64, &C64->SID[3], &C64->ResampledOutput );
+ if ( TIGHTLY (C64->SID[4].BaseAddress != 0) ) cRSID_emulateHQresampledSIDdigi( C64, &C64->SID[4], &C64->ResampledOutput );
 
- Output.L = cRSID_C64.ResampledOutput.L / cRSID_C64.Attenuation; //( ( (CHANNELS*VOLUME_MAX) + cRSID_C64.Attenuation ) );  // * cRSID_C64.AudioThread_SIDchipCount ); //better being multiplied in a single place than for all SIDs
- Output.R = TIGHTLY (cRSID_C64.Stereo >= CRSID_CHANNELMODE_STEREO /*&& cRSID_C64.AudioThread_SIDchipCount>1*/) ?
-             cRSID_C64.ResampledOutput.R / cRSID_C64.Attenuation //( ( (CHANNELS*VOLUME_MAX) + cRSID_C64.Attenuation ) ) // * cRSID_C64.AudioThread_SIDchipCount )
-             : Output.L;
+ Output->L = C64->ResampledOutput.L / C64->Attenuation; //( ( (CHANNELS*VOLUME_MAX) + cRSID_C64.Attenuation ) );  // * cRSID_C64.AudioThread_SIDchipCount ); //better being multiplied in a single place than for all SIDs
+ Output->R = TIGHTLY (C64->Stereo >= CRSID_CHANNELMODE_STEREO /*&& cRSID_C64.AudioThread_SIDchipCount>1*/) ?
+             C64->ResampledOutput.R / C64->Attenuation //( ( (CHANNELS*VOLUME_MAX) + cRSID_C64.Attenuation ) ) // * cRSID_C64.AudioThread_SIDchipCount )
+             : Output->L;
 
- return &Output; //&cRSID_C64.ResampledOutput; //&Output;
+ return Output; //&cRSID_C64.ResampledOutput; //&Output;
 }
 
 
 
-static INLINE short cRSID_playPSIDdigi () {
+static INLINE short cRSID_playPSIDdigi (FASTVAR cRSID_C64instance *const C64) {
  //static cRSID_C64instance* C64 = &cRSID_C64;
 
  enum PSIDdigiSpecs {
@@ -385,43 +424,39 @@ static INLINE short cRSID_playPSIDdigi () {
  };
 
  FASTVAR unsigned char Shifts;
- static unsigned char PlaybackEnabled=0, NybbleCounter=0, RepeatCounter=0;
  FASTVAR unsigned short RatePeriod;
- static unsigned short SampleAddress = 0;
- static int Output=0; //need to be static to keep level between calls
- static int PeriodCounter = 0;
-
- if ( cRSID_C64.IObankWR[0xD41D] ) {
-  PlaybackEnabled = (cRSID_C64.IObankWR[0xD41D] >= 0xFE);
-  PeriodCounter = 0; NybbleCounter = 0;
-  SampleAddress = cRSID_C64.IObankWR[0xD41E] + (cRSID_C64.IObankWR[0xD41F]<<8);
-  RepeatCounter = cRSID_C64.IObankWR[0xD43F];
+
+ if ( C64->IObankWR[0xD41D] ) {
+  C64->PSIDdigiPlaybackEnabled = (C64->IObankWR[0xD41D] >= 0xFE);
+  C64->PSIDdigiPeriodCounter = 0; C64->PSIDdigiNybbleCounter = 0;
+  C64->PSIDdigiSampleAddress = C64->IObankWR[0xD41E] + (C64->IObankWR[0xD41F]<<8);
+  C64->PSIDdigiRepeatCounter = C64->IObankWR[0xD43F];
  }
- cRSID_C64.IObankWR[0xD41D] = 0;
-
- if (PlaybackEnabled) {
-  RatePeriod = cRSID_C64.IObankWR[0xD45D] + (cRSID_C64.IObankWR[0xD45E]<<8);
-  if (RatePeriod) PeriodCounter += cRSID_C64.CPUfrequency / RatePeriod;
-  if ( PeriodCounter >= cRSID_C64.SampleRate ) {
-   PeriodCounter -= cRSID_C64.SampleRate;
-
-   if ( SampleAddress < cRSID_C64.IObankWR[0xD43D] + (cRSID_C64.IObankWR[0xD43E]<<8) ) {
-    if (NybbleCounter) {
-     Shifts = cRSID_C64.IObankWR[0xD47D] ? 4:0;
-     ++SampleAddress;
+ C64->IObankWR[0xD41D] = 0;
+
+ if (C64->PSIDdigiPlaybackEnabled) {
+  RatePeriod = C64->IObankWR[0xD45D] + (C64->IObankWR[0xD45E]<<8);
+  if (RatePeriod) C64->PSIDdigiPeriodCounter += C64->CPUfrequency / RatePeriod;
+  if ( C64->PSIDdigiPeriodCounter >= C64->SampleRate ) {
+   C64->PSIDdigiPeriodCounter -= C64->SampleRate;
+
+   if ( C64->PSIDdigiSampleAddress < C64->IObankWR[0xD43D] + (C64->IObankWR[0xD43E]<<8) ) {
+    if (C64->PSIDdigiNybbleCounter) {
+     Shifts = C64->IObankWR[0xD47D] ? 4:0;
+     ++C64->PSIDdigiSampleAddress;
     }
-    else Shifts = cRSID_C64.IObankWR[0xD47D] ? 0:4;
-    Output = ( ( (cRSID_C64.RAMbank[SampleAddress]>>Shifts) & DIGI_MASK) - DIGI_MID ) * DIGI_MUL; //* DIGI_VOLUME; //* (cRSID_C64.IObankWR[0xD418]&0xF);
-    NybbleCounter^=1;
+    else Shifts = C64->IObankWR[0xD47D] ? 0:4;
+    C64->PSIDdigiOutput = ( ( (C64->RAMbank[C64->PSIDdigiSampleAddress]>>Shifts) & DIGI_MASK) - DIGI_MID ) * DIGI_MUL; //* DIGI_VOLUME; //* (cRSID_C64.IObankWR[0xD418]&0xF);
+    C64->PSIDdigiNybbleCounter^=1;
    }
-   else if (RepeatCounter) {
-    SampleAddress = cRSID_C64.IObankWR[0xD47F] + (cRSID_C64.IObankWR[0xD47E]<<8);
-    RepeatCounter--;
+   else if (C64->PSIDdigiRepeatCounter) {
+    C64->PSIDdigiSampleAddress = C64->IObankWR[0xD47F] + (C64->IObankWR[0xD47E]<<8);
+    C64->PSIDdigiRepeatCounter--;
    }
 
   }
  }
 
- return (Output / cRSID_C64.Attenuation);
+ return (C64->PSIDdigiOutput / C64->Attenuation);
 }
 
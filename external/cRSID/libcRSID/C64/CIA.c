@@ -3,13 +3,13 @@
 #include "C64.h"
 
 
-void cRSID_createCIAchip (cRSID_CIAinstance* CIA, unsigned short baseaddress) {
+void cRSID_createCIAchip (cRSID_C64instance* C64, cRSID_CIAinstance* CIA, unsigned short baseaddress) {
  //static cRSID_C64instance* C64 = &cRSID_C64;
 
  //CIA->C64 = C64;
  CIA->ChipModel = 0;
  CIA->BaseAddress = baseaddress;
- CIA->BasePtrWR = &cRSID_C64.IObankWR[baseaddress]; CIA->BasePtrRD = &cRSID_C64.IObankRD[baseaddress];
+ CIA->BasePtrWR = &C64->IObankWR[baseaddress]; CIA->BasePtrRD = &C64->IObankRD[baseaddress];
  cRSID_initCIAchip(CIA);
 }
 
@@ -6,47 +6,47 @@
 #include "SID_Outputs.c"
 
 
-unsigned short cRSID_getSIDbase (int sid_number) {
- return cRSID_C64.SID[ sid_number ].BaseAddress;
+unsigned short cRSID_getSIDbaseC64 (cRSID_C64instance* C64, int sid_number) {
+ return C64->SID[ sid_number ].BaseAddress;
 }
 
-unsigned short cRSID_getSIDmodel (int sid_number) {
- return cRSID_C64.SID[ sid_number ].ChipModel;
+unsigned short cRSID_getSIDmodelC64 (cRSID_C64instance* C64, int sid_number) {
+ return C64->SID[ sid_number ].ChipModel;
 }
-unsigned short cRSID_setSIDmodel (int sid_number, unsigned short value) {
- return ( cRSID_C64.SID[ sid_number ].ChipModel = value );
+unsigned short cRSID_setSIDmodelC64 (cRSID_C64instance* C64, int sid_number, unsigned short value) {
+ return ( C64->SID[ sid_number ].ChipModel = value );
 }
 
-unsigned char cRSID_set6581FilterPreset (unsigned char preset) {
+unsigned char cRSID_set6581FilterPresetC64 (cRSID_C64instance* C64, unsigned char preset) {
  if (preset > CRSID_FILTER6581_PRESET_R2) preset = CRSID_FILTER6581_PRESET_STOCK;
- cRSID.Filter6581Preset = preset;
- cRSID_configure6581FilterPreset(preset);
- return cRSID.Filter6581Preset;
+ C64->Interface->Filter6581Preset = preset;
+ cRSID_configure6581FilterPreset(C64, preset);
+ return C64->Interface->Filter6581Preset;
 }
 
-unsigned char cRSID_getSIDchannel (int sid_number) { //channel in stereo field (left/right/middle)
- return cRSID_C64.SID[ sid_number ].Channel;
+unsigned char cRSID_getSIDchannelC64 (cRSID_C64instance* C64, int sid_number) { //channel in stereo field (left/right/middle)
+ return C64->SID[ sid_number ].Channel;
 }
 
-int cRSID_getSIDlevel (int sid_number) {
- return cRSID_C64.SID[ sid_number ].Level;
+int cRSID_getSIDlevelC64 (cRSID_C64instance* C64, int sid_number) {
+ return C64->SID[ sid_number ].Level;
 }
 
-int cRSID_getDigiLevel (int sid_number) {
- return cRSID_C64.SID[ sid_number ].ScopeVoiceOutput[3];
+int cRSID_getDigiLevelC64 (cRSID_C64instance* C64, int sid_number) {
+ return C64->SID[ sid_number ].ScopeVoiceOutput[3];
 }
 
-unsigned char cRSID_getVoiceMuteMask (int sid_number) {
- return cRSID_C64.SID[ sid_number ].VoiceMuteMask;
+unsigned char cRSID_getVoiceMuteMaskC64 (cRSID_C64instance* C64, int sid_number) {
+ return C64->SID[ sid_number ].VoiceMuteMask;
 }
 
-unsigned char cRSID_setVoiceMuteMask (int sid_number, unsigned char mute_mask) {
- return ( cRSID_C64.SID[ sid_number ].VoiceMuteMask = (mute_mask & 0x0F) );
+unsigned char cRSID_setVoiceMuteMaskC64 (cRSID_C64instance* C64, int sid_number, unsigned char mute_mask) {
+ return ( C64->SID[ sid_number ].VoiceMuteMask = (mute_mask & 0x0F) );
 }
 
-void cRSID_getVoiceLevels (int sid_number, signed int* out_voice_levels) {
+void cRSID_getVoiceLevelsC64 (cRSID_C64instance* C64, int sid_number, signed int* out_voice_levels) {
  enum { CRSID_VOICE_COUNT = 3 };
- cRSID_SIDinstance* SID = &cRSID_C64.SID[ sid_number ];
+ cRSID_SIDinstance* SID = &C64->SID[ sid_number ];
  int v;
  if (out_voice_levels == NULL) return;
  for (v = 0; v < CRSID_VOICE_COUNT; ++v) {
@@ -55,22 +55,22 @@ void cRSID_getVoiceLevels (int sid_number, signed int* out_voice_levels) {
 }
 
 
-void cRSID_createSIDchip (cRSID_SIDinstance* SID, unsigned short model, char channel, unsigned short baseaddress) {
+void cRSID_createSIDchip (cRSID_C64instance* C64, cRSID_SIDinstance* SID, unsigned short model, char channel, unsigned short baseaddress) {
  //static cRSID_C64instance* C64 = &cRSID_C64;
 
  //SID->C64 = C64;
  SID->ChipModel = model; SID->Channel=channel;
  if( baseaddress>=0xD400 && (baseaddress<0xD800 || (0xDE00<=baseaddress && baseaddress<=0xDFE0)) ) { //check valid address, avoid Color-RAM
-  SID->BaseAddress = baseaddress; SID->BasePtr = &cRSID_C64.IObankWR[baseaddress]; SID->BasePtrRD = &cRSID_C64.IObankRD[baseaddress];
+  SID->BaseAddress = baseaddress; SID->BasePtr = &C64->IObankWR[baseaddress]; SID->BasePtrRD = &C64->IObankRD[baseaddress];
  }
  else { SID->BaseAddress=0x0000;
- SID->BasePtr = SID->BasePtrRD = &cRSID_C64.IObankWR[CRSID_SID_SAFE_ADDRESS]; } //NULL; } //NULL-ing not preferred as it can cause Segfault in sample-thread
+ SID->BasePtr = SID->BasePtrRD = &C64->IObankWR[CRSID_SID_SAFE_ADDRESS]; } //NULL; } //NULL-ing not preferred as it can cause Segfault in sample-thread
  cRSID_initSIDchip(SID);           //(and guarding against NULL BasePtr would take some precious cycles in SID-emulation functions)
 }
 
 
 void cRSID_initSIDchip (cRSID_SIDinstance* SID) {
- static unsigned char Channel;
+ unsigned char Channel;
  for (Channel = 0; Channel < 21; Channel+=7) {
   SID->ADSRstate[Channel] = 0; SID->RateCounter[Channel] = 0;
   SID->EnvelopeCounter[Channel] = 0; SID->ExponentCounter[Channel] = 0;
@@ -81,18 +81,16 @@ void cRSID_initSIDchip (cRSID_SIDinstance* SID) {
  }
  SID->SyncSourceMSBrise = 0; SID->RingSourceMSB = 0;
  SID->VoiceMuteMask = 0;
- SID->ScopeVoicePrevLowPass[0] = SID->ScopeVoicePrevLowPass[1] = SID->ScopeVoicePrevLowPass[2] = 0;
- SID->ScopeVoicePrevBandPass[0] = SID->ScopeVoicePrevBandPass[1] = SID->ScopeVoicePrevBandPass[2] = 0;
- SID->ScopeVoiceNonFiltered[0] = SID->ScopeVoiceNonFiltered[1] = SID->ScopeVoiceNonFiltered[2] = 0;
- SID->ScopeVoiceFilterInput[0] = SID->ScopeVoiceFilterInput[1] = SID->ScopeVoiceFilterInput[2] = 0;
- SID->ScopeVoiceOutput[0] = SID->ScopeVoiceOutput[1] = SID->ScopeVoiceOutput[2] = SID->ScopeVoiceOutput[3] = 0;
- SID->PrevLowPass = SID->PrevBandPass = SID->PrevVolume = 0;
+ memset( SID->PrevLowPass, 0, sizeof(SID->PrevLowPass) ); memset( SID->PrevBandPass, 0, sizeof(SID->PrevBandPass) );
+ memset( SID->ScopeVoiceNonFiltered, 0, sizeof(SID->ScopeVoiceNonFiltered) ); memset( SID->ScopeVoiceFilterInput, 0, sizeof(SID->ScopeVoiceFilterInput) );
+ memset( SID->ScopeVoiceFilterOutput, 0, sizeof(SID->ScopeVoiceFilterOutput) ); memset( SID->ScopeVoiceOutput, 0, sizeof(SID->ScopeVoiceOutput) );
+ SID->PrevVolume = 0;
 }
 
 
-static INLINE int cRSID_emulateHQresampledSID (FASTVAR cRSID_SIDinstance *const FASTPTR SID, FASTVAR char cycles) {
+static INLINE int cRSID_emulateHQresampledSID (FASTVAR cRSID_C64instance *const C64, FASTVAR cRSID_SIDinstance *const FASTPTR SID, FASTVAR char cycles) {
  //cause immediate stopping in audio-buffer thread, so SID-baseaddress changes during tune-switching won't give segfaults
  //if ( RARELY (cRSID.Paused || SID->BasePtr == NULL) ) return 0; //avoid some segfaults when NULL-ing SID4
- SID->Output = cRSID_emulateHQresampledSIDoutputStage( SID, cRSID_emulateHQwaves( SID, cycles ) );  // * SID->Volume;
+ SID->Output = cRSID_emulateHQresampledSIDoutputStage( SID, cRSID_emulateHQwaves( C64, SID, cycles ) );  // * SID->Volume;
  return SID->Output;
 }
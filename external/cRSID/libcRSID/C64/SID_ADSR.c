@@ -42,7 +42,7 @@ INLINE void cRSID_emulateADSRs (FASTVAR cRSID_SIDinstance *const FASTPTR SID, FA
  };
 
  FASTVAR unsigned char Channel;
- static unsigned char PrevGate, AD, SR;
+ unsigned char PrevGate, AD, SR;
  FASTVAR unsigned short PrescalePeriod;
  FASTVAR unsigned char * FASTPTR ChannelPtr, * FASTPTR ADSRstatePtr, * FASTPTR EnvelopeCounterPtr, * FASTPTR ExponentCounterPtr;
  FASTVAR unsigned short * FASTPTR RateCounterPtr;
@@ -31,7 +31,7 @@ static INLINE unsigned short combinedWF (FASTVAR cRSID_SIDinstance *const FASTPT
 
 
 
-INLINE int cRSID_emulateSID_light (FASTVAR cRSID_SIDinstance *const FASTPTR SID) {
+INLINE int cRSID_emulateSID_light (FASTVAR cRSID_C64instance *const C64, FASTVAR cRSID_SIDinstance *const FASTPTR SID) {
  static enum { NOISE_BITVAL=0x80, PULSE_BITVAL=0x40, SAW_BITVAL=0x20, TRI_BITVAL=0x10,
                PULSAWTRI_VAL=0x70, PULSAW_VAL=0x60, PULTRI_VAL=0x50, SAWTRI_VAL=0x30 } WaveFormBits;
  static enum { TEST_BITVAL=0x08, RING_BITVAL=0x04, SYNC_BITVAL=0x02, GATE_BITVAL=0x01 } ControlBits;
@@ -64,11 +64,11 @@ INLINE int cRSID_emulateSID_light (FASTVAR cRSID_SIDinstance *const FASTPTR SID)
  FASTVAR unsigned char * FASTPTR ChannelPtr;
  //static char MainVolume;
  FASTVAR unsigned char WF, FilterSwitchReso, VolumeBand;
- static unsigned char TestBit, Envelope;
+ unsigned char TestBit, Envelope;
  FASTVAR unsigned int Utmp, WavGenOut, PW;
- static unsigned int PhaseAccuStep, MSB;
+ unsigned int PhaseAccuStep, MSB;
  FASTVAR int Tmp, Feedback, VoiceSample;
- static int Steepness, PulsePeak;
+ int Steepness, PulsePeak;
  //static int FilterInput, Cutoff, Resonance, FilterOutput, NonFilted, Output;
  FASTVAR int * FASTPTR PhaseAccuPtr;
 
@@ -88,7 +88,7 @@ INLINE int cRSID_emulateSID_light (FASTVAR cRSID_SIDinstance *const FASTPTR SID)
   WF = ChannelPtr[4]; TestBit = RARELY ( (WF & TEST_BITVAL) != 0 );
   PhaseAccuPtr = &(SID->PhaseAccu[Channel]);
 
-  PhaseAccuStep = ( (ChannelPtr[1]<<8) | ChannelPtr[0] ) * cRSID_C64.SampleClockRatio; //SID->cRSID_C64.SampleClockRatio;
+  PhaseAccuStep = ( (ChannelPtr[1]<<8) | ChannelPtr[0] ) * C64->SampleClockRatio; //SID->cRSID_C64.SampleClockRatio;
   if ( RARELY (TestBit || ((WF & SYNC_BITVAL) && SID->SyncSourceMSBrise)) ) *PhaseAccuPtr = 0;
   else { //stepping phase-accumulator (oscillator)
    *PhaseAccuPtr += PhaseAccuStep;
@@ -159,7 +159,7 @@ INLINE int cRSID_emulateSID_light (FASTVAR cRSID_SIDinstance *const FASTPTR SID)
        WavGenOut = CRSID_WAVE_MAX - ( ((WavGenOut-CRSID_WAVE_RANGE)<<STEEPNESS_FRACTION_SHIFTS) / Steepness ); //2nd half (falling edge, reciprocal steepness
    } break;
    case TRI_BITVAL: { //else if (WF & TRI_BITVAL) { //triangle (this waveform has no harsh edges, so it doesn't suffer from strong aliasing at high pitches)
-    if ( MOSTLY (!cRSID_C64.RealSIDmode || SID->PrevSounDemonDigiWF[Channel] <= 0) ) { // != SOUNDEMON_DIGI_SEEK_WAVEFORM) ) {
+    if ( MOSTLY (!C64->RealSIDmode || SID->PrevSounDemonDigiWF[Channel] <= 0) ) { // != SOUNDEMON_DIGI_SEEK_WAVEFORM) ) {
      Tmp = *PhaseAccuPtr ^ ( RARELY(WF&RING_BITVAL) ? SID->RingSourceMSB : 0 );
      WavGenOut = ( Tmp ^ (Tmp&PHASEACCU_MSB_BITVAL? PHASEACCU_MAX:0) ) >> (CRSID_WAVE_SHIFTS-1); //11;
     }  //SounDemon digi hack: if previous waveform was 01, don't modify output in this round:
@@ -168,7 +168,7 @@ INLINE int cRSID_emulateSID_light (FASTVAR cRSID_SIDinstance *const FASTPTR SID)
 
    case 0x00: //emulate waveform 00 floating wave-DAC (utilized by SounDemon digis) (on real SID waveform00 decays after about 5 seconds, here we just simply keep the value to avoid clicks)
     //(Our jittery 'seeking' waveform=$01 part of SounDemon-digi is substituted directly by frequency-high register's value (as in SwinSID))
-    if (cRSID_C64.RealSIDmode && WF == SOUNDEMON_DIGI_SEEK_WAVEFORM) {   //WavGenOut = ( !cRSID_C64.RealSIDmode || WF != SOUNDEMON_DIGI_SEEK_WAVEFORM /*|| ChannelPtr[1]==0*/ ) ? SID->PrevWavGenOut[Channel] : (unsigned int)(ChannelPtr[1] << SOUNDEMON_DIGI_SHIFTS);
+    if (C64->RealSIDmode && WF == SOUNDEMON_DIGI_SEEK_WAVEFORM) {   //WavGenOut = ( !cRSID_C64.RealSIDmode || WF != SOUNDEMON_DIGI_SEEK_WAVEFORM /*|| ChannelPtr[1]==0*/ ) ? SID->PrevWavGenOut[Channel] : (unsigned int)(ChannelPtr[1] << SOUNDEMON_DIGI_SHIFTS);
      WavGenOut = ChannelPtr[1] << SOUNDEMON_DIGI_SHIFTS;
      SID->PrevSounDemonDigiWF[Channel] = SOUNDEMON_CARRIER_ELIMINATION_SAMPLECOUNT;
     }
@@ -204,7 +204,7 @@ INLINE int cRSID_emulateSID_light (FASTVAR cRSID_SIDinstance *const FASTPTR SID)
  SID->BasePtrRD[0x1C] /*cRSID_C64.IObankRD[SID->BaseAddress+0x1C]*/ = SID->EnvelopeCounter[CHANNEL2_INDEX]; //14]; //Envelope
  //cRSID_C64.IObankRD[SID->BaseAddress+0x1F] = (cRSID.SelectedSIDmodel==8580); //this doesn't exist in real SID but SID-Wizard code removes comment-marks and uses it as identification workaround
 
- return cRSID_emulateSIDoutputStage( SID );
+ return cRSID_emulateSIDoutputStage( C64, SID );
 }
 
 
@@ -225,7 +225,7 @@ static INLINE unsigned short HQcombinedWF (FASTVAR cRSID_SIDinstance *const FAST
 }
 
 
-INLINE cRSID_SIDwavOutput cRSID_emulateHQwaves (FASTVAR cRSID_SIDinstance *const FASTPTR SID, FASTVAR char cycles) { //, FASTVAR char filter) {
+INLINE cRSID_SIDwavOutput cRSID_emulateHQwaves (FASTVAR cRSID_C64instance *const C64, FASTVAR cRSID_SIDinstance *const FASTPTR SID, FASTVAR char cycles) { //, FASTVAR char filter) {
  static enum { NOISE_BITVAL=0x80, PULSE_BITVAL=0x40, SAW_BITVAL=0x20, TRI_BITVAL=0x10,
                PULSAWTRI_VAL=0x70, PULSAW_VAL=0x60, PULTRI_VAL=0x50, SAWTRI_VAL=0x30 } WaveFormBits;
  static enum { TEST_BITVAL=0x08, RING_BITVAL=0x04, SYNC_BITVAL=0x02, GATE_BITVAL=0x01 } ControlBits;
@@ -253,13 +253,13 @@ INLINE cRSID_SIDwavOutput cRSID_emulateHQwaves (FASTVAR cRSID_SIDinstance *const
  FASTVAR unsigned char * FASTPTR ChannelPtr;
  //static char MainVolume;
  FASTVAR unsigned char WF, FilterSwitchReso, VolumeBand;
- static unsigned char TestBit, Envelope;
+ unsigned char TestBit, Envelope;
  FASTVAR unsigned int Utmp, WavGenOut, PW;
- static unsigned int PhaseAccuStep, MSB;
+ unsigned int PhaseAccuStep, MSB;
  FASTVAR int Tmp, Feedback, VoiceSample;
  //static int FilterInput, Cutoff, Resonance; //, FilterOutput, NonFilted, Output;
  FASTVAR int * FASTPTR PhaseAccuPtr;
- static cRSID_SIDwavOutput SIDwavOutput;
+ cRSID_SIDwavOutput SIDwavOutput;
 
  //'Paused' causes immediate stopping in audio-buffer thread, so SID-baseaddress changes during tune-switching won't give segfaults
  //if ( RARELY (cRSID.Paused || SID->BasePtr == NULL) ) return (cRSID_SIDwavOutput) {0,0}; //{{0},0}; //avoid some segfaults when NULL-ing SID4
@@ -322,7 +322,7 @@ INLINE cRSID_SIDwavOutput cRSID_emulateHQwaves (FASTVAR cRSID_SIDinstance *const
     SID->PrevWavGenOut[Channel] = *PhaseAccuPtr >> CRSID_WAVE_SHIFTS; //8;  //if (WF & TRI_BITVAL) WavGenOut = HQcombinedWF( SID, cRSID_SawTriangle, WavGenOut ); //saw+triangle
    } break;
    case TRI_BITVAL: {  //else if (WF & TRI_BITVAL) { //triangle (this waveform has no harsh edges, so it doesn't suffer from strong aliasing at high pitches)
-    if ( MOSTLY (!cRSID_C64.RealSIDmode || SID->PrevSounDemonDigiWF[Channel] <= 0) ) { // != SOUNDEMON_DIGI_SEEK_WAVEFORM) ) {
+    if ( MOSTLY (!C64->RealSIDmode || SID->PrevSounDemonDigiWF[Channel] <= 0) ) { // != SOUNDEMON_DIGI_SEEK_WAVEFORM) ) {
      Tmp = *PhaseAccuPtr ^ ( RARELY(WF&RING_BITVAL) ? SID->RingSourceMSB : 0 );
      SID->PrevWavGenOut[Channel] = ( ( Tmp ^ (Tmp&PHASEACCU_MSB_BITVAL? PHASEACCU_MAX:0) ) >> (CRSID_WAVE_SHIFTS-1) ) & CRSID_WAVE_MASK; //0xFFFF;
     }  //SounDemon digi hack: if previous waveform was 01, don't modify output in these rounds:
@@ -331,7 +331,7 @@ INLINE cRSID_SIDwavOutput cRSID_emulateHQwaves (FASTVAR cRSID_SIDinstance *const
 
    case 0x00: //emulate waveform 00 floating wave-DAC (utilized by SounDemon digis) (on real SID waveform00 decays, we just simply keep the value to avoid clicks)
     //(Our jittery 'seeking' waveform=$01 part of SounDemon-digi is substituted directly by frequency-high register's value (as in SwinSID))
-    if ( TIGHTLY ( cRSID_C64.RealSIDmode && WF == SOUNDEMON_DIGI_SEEK_WAVEFORM) ) {
+    if ( TIGHTLY ( C64->RealSIDmode && WF == SOUNDEMON_DIGI_SEEK_WAVEFORM) ) {
      SID->PrevWavGenOut[Channel] = (ChannelPtr[1] << SOUNDEMON_DIGI_SHIFTS);
      SID->PrevSounDemonDigiWF[Channel] = SOUNDEMON_CARRIER_ELIMINATION_CYCLECOUNT;
     }
@@ -18,16 +18,6 @@ static const cRSID_Filter6581PresetConfig cRSID_Filter6581PresetConfigs[] = {
  { 0.02387, 0.92,  360.0,    957.0,  325.0 }  // R2
 };
 
-static enum {
- CRSID_6581_FILTER_TABLE_ENTRY_COUNT = 0x800
-} cRSID_6581FilterTableSpecs;
-
-static unsigned short cRSID_CutoffMul6581_44100Hz_Custom [CRSID_6581_FILTER_TABLE_ENTRY_COUNT + 1];
-static unsigned short cRSID_CutoffMul6581_OverSampleRate_Custom [CRSID_6581_FILTER_TABLE_ENTRY_COUNT + 1];
-static const unsigned short* cRSID_ActiveCutoffMul6581_44100Hz = cRSID_CutoffMul6581_44100Hz_Stock;
-static const unsigned short* cRSID_ActiveCutoffMul6581_OverSampleRate = cRSID_CutoffMul6581_OverSampleRate_Stock;
-static unsigned char cRSID_Active6581FilterPreset = 0xFF;
-
 
 static double cRSID_calculate6581PresetKink (int cutoffLevel) {
  int i, divisor;
@@ -77,7 +67,7 @@ static unsigned short cRSID_quantize6581PresetAlpha (double alpha, int magnitude
 }
 
 
-void cRSID_configure6581FilterPreset (unsigned char preset) {
+void cRSID_configure6581FilterPreset (cRSID_C64instance* C64, unsigned char preset) {
  int i;
  int magnitude;
  int oversamplingMagnitude;
@@ -85,12 +75,12 @@ void cRSID_configure6581FilterPreset (unsigned char preset) {
  unsigned char normalizedPreset = preset;
 
  if (normalizedPreset > CRSID_FILTER6581_PRESET_R2) normalizedPreset = CRSID_FILTER6581_PRESET_STOCK;
- if (cRSID_Active6581FilterPreset == normalizedPreset) return;
+ if (C64->Active6581FilterPreset == normalizedPreset) return;
 
  if (normalizedPreset == CRSID_FILTER6581_PRESET_STOCK) {
-  cRSID_ActiveCutoffMul6581_44100Hz = cRSID_CutoffMul6581_44100Hz_Stock;
-  cRSID_ActiveCutoffMul6581_OverSampleRate = cRSID_CutoffMul6581_OverSampleRate_Stock;
-  cRSID_Active6581FilterPreset = normalizedPreset;
+  C64->ActiveCutoffMul6581_44100Hz = cRSID_CutoffMul6581_44100Hz_Stock;
+  C64->ActiveCutoffMul6581_OverSampleRate = cRSID_CutoffMul6581_OverSampleRate_Stock;
+  C64->Active6581FilterPreset = normalizedPreset;
   return;
  }
 
@@ -100,21 +90,44 @@ void cRSID_configure6581FilterPreset (unsigned char preset) {
 
  for (i=0; i<CRSID_6581_FILTER_TABLE_ENTRY_COUNT; ++i) {
   double alpha = cRSID_calculate6581PresetAlpha(i, config);
-  cRSID_CutoffMul6581_44100Hz_Custom[i] = cRSID_quantize6581PresetAlpha(alpha, magnitude);
-  cRSID_CutoffMul6581_OverSampleRate_Custom[i] =
+  C64->CutoffMul6581_44100Hz_Custom[i] = cRSID_quantize6581PresetAlpha(alpha, magnitude);
+  C64->CutoffMul6581_OverSampleRate_Custom[i] =
    cRSID_quantize6581PresetAlpha(cRSID_convert6581PresetAlphaToOversampled(alpha), oversamplingMagnitude);
  }
 
- cRSID_CutoffMul6581_44100Hz_Custom[CRSID_6581_FILTER_TABLE_ENTRY_COUNT] = 0;
- cRSID_CutoffMul6581_OverSampleRate_Custom[CRSID_6581_FILTER_TABLE_ENTRY_COUNT] = 0;
- cRSID_ActiveCutoffMul6581_44100Hz = cRSID_CutoffMul6581_44100Hz_Custom;
- cRSID_ActiveCutoffMul6581_OverSampleRate = cRSID_CutoffMul6581_OverSampleRate_Custom;
- cRSID_Active6581FilterPreset = normalizedPreset;
+ C64->CutoffMul6581_44100Hz_Custom[CRSID_6581_FILTER_TABLE_ENTRY_COUNT] = 0;
+ C64->CutoffMul6581_OverSampleRate_Custom[CRSID_6581_FILTER_TABLE_ENTRY_COUNT] = 0;
+ C64->ActiveCutoffMul6581_44100Hz = C64->CutoffMul6581_44100Hz_Custom;
+ C64->ActiveCutoffMul6581_OverSampleRate = C64->CutoffMul6581_OverSampleRate_Custom;
+ C64->Active6581FilterPreset = normalizedPreset;
 }
 
 
 
-static INLINE int cRSID_emulateSIDoutputStage (FASTVAR cRSID_SIDinstance *const FASTPTR SID) { //, FASTVAR char nofilter) {
+#if (CRSID_SIMD != 0)
+//one step of the SID's filter (lane CRSID_SID_FILTER_LANE) and the 3 voice-filters of the scopes (lanes 0..2) together,
+//same arithmetic as the scalar code in the output-stages (that's kept for CRSID_SIMD=0 as the reference)
+static INLINE cRSID_Lanes cRSID_emulateFilterLanes (FASTVAR cRSID_SIDinstance *const FASTPTR SID, FASTVAR cRSID_Lanes input,
+                                                     FASTVAR int resonance, FASTVAR int cutoff, FASTVAR int cutoffshifts,
+                                                     FASTVAR unsigned char highpass, FASTVAR unsigned char bandpass, FASTVAR unsigned char lowpass) {
+ FASTVAR cRSID_Lanes Tmp, BandPass, LowPass, Cutoff, FilterOutput;
+
+ BandPass = cRSID_loadLanes( SID->PrevBandPass ); LowPass = cRSID_loadLanes( SID->PrevLowPass );
+ Cutoff = cRSID_setLanes( cutoff );
+ Tmp = cRSID_addLanes( cRSID_addLanes( input, cRSID_divLanesPow2( cRSID_mulLanes( BandPass, cRSID_setLanes(resonance) ), CRSID_FILTERTABLE_RESOLUTION ) ), LowPass );
+ FilterOutput = cRSID_andLanes( cRSID_subLanes( cRSID_setLanes(0), Tmp ), cRSID_setLanes( -(highpass != 0) ) );
+ BandPass = cRSID_subLanes( BandPass, cRSID_divLanesPow2( cRSID_mulLanes( Tmp, Cutoff ), cutoffshifts ) );
+ FilterOutput = cRSID_subLanes( FilterOutput, cRSID_andLanes( BandPass, cRSID_setLanes( -(bandpass != 0) ) ) );
+ LowPass = cRSID_addLanes( LowPass, cRSID_divLanesPow2( cRSID_mulLanes( BandPass, Cutoff ), cutoffshifts ) );
+ FilterOutput = cRSID_addLanes( FilterOutput, cRSID_andLanes( LowPass, cRSID_setLanes( -(lowpass != 0) ) ) );
+ cRSID_storeLanes( SID->PrevBandPass, BandPass ); cRSID_storeLanes( SID->PrevLowPass, LowPass );
+
+ return FilterOutput;
+}
+#endif
+
+
+static INLINE int cRSID_emulateSIDoutputStage (FASTVAR cRSID_C64instance *const C64, FASTVAR cRSID_SIDinstance *const FASTPTR SID) { //, FASTVAR char nofilter) {
  static enum { FRACTIONAL_BITS = 12, FRACTIONAL_SHIFTS = (FRACTIONAL_BITS) } Specs;
  static enum { /*CRSID_FILTERTABLE_RESOLUTION = 12,*/ CRSID_FILTERTABLE_SHIFTS = (CRSID_FILTERTABLE_RESOLUTION),
                CRSID_FILTERTABLE_MAGNITUDE = (1 << CRSID_FILTERTABLE_RESOLUTION) } FilterSpecs;
@@ -127,7 +140,13 @@ static INLINE int cRSID_emulateSIDoutputStage (FASTVAR cRSID_SIDinstance *const
  FASTVAR char MainVolume;
  FASTVAR unsigned char FilterSwitchReso, VolumeBand;
  FASTVAR int Tmp, NonFilted, FilterInput, Cutoff, Resonance, FilterOutput, Output;
- FASTVAR int VoiceIndex, VoiceFilterOutput;
+ FASTVAR int VoiceIndex;
+#if (CRSID_SIMD != 0)
+ FASTVAR cRSID_Lanes FilterOutputs;
+ int ScopeVoiceMix[4];
+#else
+ FASTVAR int VoiceFilterOutput;
+#endif
 
  //cause immediate stopping in audio-buffer thread, so SID-baseaddress changes during tune-switching won't give segfaults
  //if ( RARELY (cRSID.Paused || SID->BasePtr == NULL) ) return 0; //avoid some segfaults when NULL-ing SID4
@@ -148,18 +167,25 @@ static INLINE int cRSID_emulateSIDoutputStage (FASTVAR cRSID_SIDinstance *const
   else { //6581
    Cutoff += (FilterInput*105)>>16; //MOSFET-VCR control-voltage calculation (resistance-modulation aka 6581 filter distortion) emulation
     if ( RARELY (Cutoff > SID_CUTOFF_MAX) ) Cutoff=SID_CUTOFF_MAX; else if ( RARELY(Cutoff<0) ) Cutoff=0;  //can really go below 0 when FilterInput is negative
-   Cutoff = cRSID_ActiveCutoffMul6581_44100Hz[Cutoff];
+   Cutoff = C64->ActiveCutoffMul6581_44100Hz[Cutoff];
    Resonance = cRSID_Resonances6581[Resonance];
   }
+#if (CRSID_SIMD != 0)
+  FilterOutputs = cRSID_emulateFilterLanes( SID, cRSID_setLane3( cRSID_loadLanes(SID->ScopeVoiceFilterInput), FilterInput ),
+                                            Resonance, Cutoff, CRSID_FILTERTABLE_SHIFTS,
+                                            VolumeBand & HIGHPASS_BITVAL, VolumeBand & BANDPASS_BITVAL, VolumeBand & LOWPASS_BITVAL );
+  FilterOutput = cRSID_getLane3( FilterOutputs );
+#else
   //shifting negative integers in C is implementation-dependent, so using normal division by power of 2, that might luckily be optimized as arithmetic-shift by the compiler
-  Tmp = FilterInput + ( (SID->PrevBandPass * Resonance) / CRSID_FILTERTABLE_MAGNITUDE ) + SID->PrevLowPass; // >> CRSID_FILTERTABLE_SHIFTS ) + SID->PrevLowPass;
+  Tmp = FilterInput + ( (SID->PrevBandPass[CRSID_SID_FILTER_LANE] * Resonance) / CRSID_FILTERTABLE_MAGNITUDE ) + SID->PrevLowPass[CRSID_SID_FILTER_LANE]; // >> CRSID_FILTERTABLE_SHIFTS ) + SID->PrevLowPass;
   if (VolumeBand & HIGHPASS_BITVAL) FilterOutput -= Tmp;
-  Tmp = SID->PrevBandPass - ( (Tmp * Cutoff) / CRSID_FILTERTABLE_MAGNITUDE ); // >> CRSID_FILTERTABLE_SHIFTS ); //12 );
-  SID->PrevBandPass = Tmp;
+  Tmp = SID->PrevBandPass[CRSID_SID_FILTER_LANE] - ( (Tmp * Cutoff) / CRSID_FILTERTABLE_MAGNITUDE ); // >> CRSID_FILTERTABLE_SHIFTS ); //12 );
+  SID->PrevBandPass[CRSID_SID_FILTER_LANE] = Tmp;
   if (VolumeBand & BANDPASS_BITVAL) FilterOutput -= Tmp;
-  Tmp = SID->PrevLowPass + ( (Tmp * Cutoff) / CRSID_FILTERTABLE_MAGNITUDE ); // >> CRSID_FILTERTABLE_SHIFTS ); // 12 );
-  SID->PrevLowPass = Tmp;
+  Tmp = SID->PrevLowPass[CRSID_SID_FILTER_LANE] + ( (Tmp * Cutoff) / CRSID_FILTERTABLE_MAGNITUDE ); // >> CRSID_FILTERTABLE_SHIFTS ); // 12 );
+  SID->PrevLowPass[CRSID_SID_FILTER_LANE] = Tmp;
   if (VolumeBand & LOWPASS_BITVAL) FilterOutput += Tmp;
+#endif
  //}
 
  //Output-mixing (main-volume / attenuator) stage
@@ -168,7 +194,7 @@ static INLINE int cRSID_emulateSIDoutputStage (FASTVAR cRSID_SIDinstance *const
  //sending AC (highpass) value to a 4th 'digi' channel mixed to the master output, and set ONLY the DC (lowpass) value to the volume-control.
  //This solved 2 issues: Thanks to the lowpass filtering of the volume-control, SID tunes where digi is played together with normal SID channels,
  //won't sound distorted anymore, and the volume-clicks disappear when setting SID-volume. (This is useful for fade-in/out tunes like Hades Nebula, where clicking ruins the intro.)
- if ( TIGHTLY (cRSID_C64.RealSIDmode) ) {
+ if ( TIGHTLY (C64->RealSIDmode) ) {
   Tmp = (signed int) ( (VolumeBand&0xF) << FRACTIONAL_SHIFTS ); //12 );
   SID->Digi = (Tmp - SID->PrevVolume) * D418_DIGI_MUL; //highpass is digi, adding it to output must be before digifilter-code
   if (SID->VoiceMuteMask & 0x08) SID->Digi = 0;
@@ -177,24 +203,29 @@ static INLINE int cRSID_emulateSIDoutputStage (FASTVAR cRSID_SIDinstance *const
  }
  else MainVolume = VolumeBand & 0xF;
 
+ #if (CRSID_SIMD != 0)
+ cRSID_storeLanes( ScopeVoiceMix, cRSID_mulLanes( cRSID_addLanes( cRSID_loadLanes(SID->ScopeVoiceNonFiltered), FilterOutputs ), cRSID_setLanes(MainVolume) ) );
+ for (VoiceIndex = 0; VoiceIndex < 3; ++VoiceIndex) SID->ScopeVoiceOutput[VoiceIndex] = ScopeVoiceMix[VoiceIndex] / C64->Attenuation;
+ #else
  for (VoiceIndex = 0; VoiceIndex < 3; ++VoiceIndex) {
   VoiceFilterOutput = 0;
   Tmp = SID->ScopeVoiceFilterInput[VoiceIndex]
-          + ( (SID->ScopeVoicePrevBandPass[VoiceIndex] * Resonance) / CRSID_FILTERTABLE_MAGNITUDE )
-          + SID->ScopeVoicePrevLowPass[VoiceIndex];
+          + ( (SID->PrevBandPass[VoiceIndex] * Resonance) / CRSID_FILTERTABLE_MAGNITUDE )
+          + SID->PrevLowPass[VoiceIndex];
   if (VolumeBand & HIGHPASS_BITVAL) VoiceFilterOutput -= Tmp;
-  SID->ScopeVoicePrevBandPass[VoiceIndex] =
-          Tmp = SID->ScopeVoicePrevBandPass[VoiceIndex]
+  SID->PrevBandPass[VoiceIndex] =
+          Tmp = SID->PrevBandPass[VoiceIndex]
                   - ( (Tmp * Cutoff) / CRSID_FILTERTABLE_MAGNITUDE );
   if (VolumeBand & BANDPASS_BITVAL) VoiceFilterOutput -= Tmp;
-  SID->ScopeVoicePrevLowPass[VoiceIndex] =
-          Tmp = SID->ScopeVoicePrevLowPass[VoiceIndex]
+  SID->PrevLowPass[VoiceIndex] =
+          Tmp = SID->PrevLowPass[VoiceIndex]
                   + ( (Tmp * Cutoff) / CRSID_FILTERTABLE_MAGNITUDE );
   if (VolumeBand & LOWPASS_BITVAL) VoiceFilterOutput += Tmp;
   SID->ScopeVoiceOutput[VoiceIndex] =
-          ((SID->ScopeVoiceNonFiltered[VoiceIndex] + VoiceFilterOutput) * MainVolume) / cRSID_C64.Attenuation;
+          ((SID->ScopeVoiceNonFiltered[VoiceIndex] + VoiceFilterOutput) * MainVolume) / C64->Attenuation;
  }
- SID->ScopeVoiceOutput[3] = SID->Digi / cRSID_C64.Attenuation;
+ #endif
+ SID->ScopeVoiceOutput[3] = SID->Digi / C64->Attenuation;
 
  SID->Output = (NonFilted+FilterOutput) * MainVolume + SID->Digi;
 
@@ -215,8 +246,13 @@ static INLINE int cRSID_emulateHQresampledSIDoutputStage (FASTVAR cRSID_SIDinsta
  //cause immediate stopping in audio-buffer thread, so SID-baseaddress changes during tune-switching won't give segfaults
  //if ( RARELY (cRSID.Paused || SID->BasePtr == NULL) ) return 0; //avoid some segfaults when NULL-ing SID4
 
+ FASTVAR int Cutoff;
+#if (CRSID_SIMD != 0)
+ FASTVAR cRSID_Lanes FilterOutputs;
+#else
  FASTVAR int Tmp; //, FilterInput;
- FASTVAR int FilterOutput, Cutoff, VoiceIndex, VoiceFilterOutput;
+ FASTVAR int FilterOutput, VoiceIndex, VoiceFilterOutput;
+#endif
 
  //FilterInput = waves->FilterInput;
 
@@ -226,39 +262,56 @@ static INLINE int cRSID_emulateHQresampledSIDoutputStage (FASTVAR cRSID_SIDinsta
   /*if ( RARELY (Cutoff > HQ_6581_CUTOFF_MAX) ) Cutoff=HQ_6581_CUTOFF_MAX; else*/ if ( RARELY(Cutoff<0) ) Cutoff=0;  //can really go below 0 when FilterInput is negative
  }
 
+#if (CRSID_SIMD != 0)
+ FilterOutputs = cRSID_emulateFilterLanes( SID, cRSID_setLane3( cRSID_loadLanes(SID->ScopeVoiceFilterInput), waves.FilterInput ),
+                                           SID->Resonance, Cutoff, CRSID_OVERSAMPLING_FILTERTABLE_SHIFTS,
+                                           SID->HighPassBit, SID->BandPassBit, SID->LowPassBit );
+ cRSID_storeLanes( SID->ScopeVoiceFilterOutput, FilterOutputs );
+
+ return (waves.NonFilted + cRSID_getLane3(FilterOutputs)) * SID->Volume;
+#else
  FilterOutput = 0; //shifting negative integers in C is implementation-dependent, so using normal division by power of 2, that might luckily be optimized as arithmetic-shift by the compiler
- Tmp = waves.FilterInput + ( (SID->PrevBandPass * SID->Resonance) / CRSID_FILTERTABLE_MAGNITUDE ) + SID->PrevLowPass; // >> CRSID_FILTERTABLE_SHIFTS ) + SID->PrevLowPass;
+ Tmp = waves.FilterInput + ( (SID->PrevBandPass[CRSID_SID_FILTER_LANE] * SID->Resonance) / CRSID_FILTERTABLE_MAGNITUDE ) + SID->PrevLowPass[CRSID_SID_FILTER_LANE]; // >> CRSID_FILTERTABLE_SHIFTS ) + SID->PrevLowPass;
  if (SID->HighPassBit) FilterOutput -= Tmp;
- Tmp = SID->PrevBandPass - ( (Tmp * Cutoff) / CRSID_OVERSAMPLING_FILTERTABLE_MAGNITUDE ); // >> CRSID_OVERSAMPLING_FILTERTABLE_SHIFTS );
- SID->PrevBandPass = Tmp;
+ Tmp = SID->PrevBandPass[CRSID_SID_FILTER_LANE] - ( (Tmp * Cutoff) / CRSID_OVERSAMPLING_FILTERTABLE_MAGNITUDE ); // >> CRSID_OVERSAMPLING_FILTERTABLE_SHIFTS );
+ SID->PrevBandPass[CRSID_SID_FILTER_LANE] = Tmp;
  if (SID->BandPassBit) FilterOutput -= Tmp;
- Tmp = SID->PrevLowPass + ( (Tmp * Cutoff) / CRSID_OVERSAMPLING_FILTERTABLE_MAGNITUDE ); // >> CRSID_OVERSAMPLING_FILTERTABLE_SHIFTS );
- SID->PrevLowPass = Tmp;
+ Tmp = SID->PrevLowPass[CRSID_SID_FILTER_LANE] + ( (Tmp * Cutoff) / CRSID_OVERSAMPLING_FILTERTABLE_MAGNITUDE ); // >> CRSID_OVERSAMPLING_FILTERTABLE_SHIFTS );
+ SID->PrevLowPass[CRSID_SID_FILTER_LANE] = Tmp;
  if (SID->LowPassBit) FilterOutput += Tmp;
 
  for (VoiceIndex = 0; VoiceIndex < 3; ++VoiceIndex) {
   VoiceFilterOutput = 0;
   Tmp = SID->ScopeVoiceFilterInput[VoiceIndex]
-          + ( (SID->ScopeVoicePrevBandPass[VoiceIndex] * SID->Resonance) / CRSID_FILTERTABLE_MAGNITUDE )
-          + SID->ScopeVoicePrevLowPass[VoiceIndex];
+          + ( (SID->PrevBandPass[VoiceIndex] * SID->Resonance) / CRSID_FILTERTABLE_MAGNITUDE )
+          + SID->PrevLowPass[VoiceIndex];
   if (SID->HighPassBit) VoiceFilterOutput -= Tmp;
-  SID->ScopeVoicePrevBandPass[VoiceIndex] =
-          Tmp = SID->ScopeVoicePrevBandPass[VoiceIndex]
+  SID->PrevBandPass[VoiceIndex] =
+          Tmp = SID->PrevBandPass[VoiceIndex]
                   - ( (Tmp * Cutoff) / CRSID_OVERSAMPLING_FILTERTABLE_MAGNITUDE );
   if (SID->BandPassBit) VoiceFilterOutput -= Tmp;
-  SID->ScopeVoicePrevLowPass[VoiceIndex] =
-          Tmp = SID->ScopeVoicePrevLowPass[VoiceIndex]
+  SID->PrevLowPass[VoiceIndex] =
+          Tmp = SID->PrevLowPass[VoiceIndex]
                   + ( (Tmp * Cutoff) / CRSID_OVERSAMPLING_FILTERTABLE_MAGNITUDE );
   if (SID->LowPassBit) VoiceFilterOutput += Tmp;
-  SID->ScopeVoiceOutput[VoiceIndex] =
-          ((SID->ScopeVoiceNonFiltered[VoiceIndex] + VoiceFilterOutput) * SID->Volume) / cRSID_C64.Attenuation;
+  SID->ScopeVoiceFilterOutput[VoiceIndex] = VoiceFilterOutput;
  }
- SID->ScopeVoiceOutput[3] = SID->Digi / cRSID_C64.Attenuation;
 
  return (waves.NonFilted + FilterOutput) * SID->Volume;
+#endif
+}
+
+static INLINE void cRSID_emulateHQscopeVoiceOutputs (FASTVAR cRSID_C64instance *const C64, FASTVAR cRSID_SIDinstance *const FASTPTR SID) { //called by resampler at samplerate-pace
+ FASTVAR int VoiceIndex; //only the filter-state of the last oversampled step is visible to the scopes, so it's enough to mix the voices here
+
+ for (VoiceIndex = 0; VoiceIndex < 3; ++VoiceIndex) {
+  SID->ScopeVoiceOutput[VoiceIndex] =
+          ((SID->ScopeVoiceNonFiltered[VoiceIndex] + SID->ScopeVoiceFilterOutput[VoiceIndex]) * SID->Volume) / C64->Attenuation;
+ }
+ SID->ScopeVoiceOutput[3] = SID->Digi / C64->Attenuation;
 }
 
-static INLINE void cRSID_emulateHQresampledSIDdigi (FASTVAR cRSID_SIDinstance *const FASTPTR SID, FASTVAR cRSID_Output *const FASTPTR signal) { //called by resampler at samplerate-pace, only digis
+static INLINE void cRSID_emulateHQresampledSIDdigi (FASTVAR cRSID_C64instance *const C64, FASTVAR cRSID_SIDinstance *const FASTPTR SID, FASTVAR cRSID_Output *const FASTPTR signal) { //called by resampler at samplerate-pace, only digis
  //FASTVAR unsigned char VolumeBand;
  //FASTVAR int Tmp, Digi; //, Output;
 
@@ -273,7 +326,7 @@ static INLINE void cRSID_emulateHQresampledSIDdigi (FASTVAR cRSID_SIDinstance *c
  //sending AC (highpass) value to a 4th 'digi' channel mixed to the master output, and set ONLY the DC (lowpass) value to the volume-control.
  //This solved 2 issues: Thanks to the lowpass filtering of the volume-control, SID tunes where digi is played together with normal SID channels,
  //won't sound distorted anymore, and the volume-clicks disappear when setting SID-volume. (This is useful for fade-in/out tunes like Hades Nebula, where clicking ruins the intro.)
- if ( TIGHTLY (cRSID_C64.RealSIDmode) ) { //only processing digi here
+ if ( TIGHTLY (C64->RealSIDmode) ) { //only processing digi here
   /*Tmp = (signed int) ( (VolumeBand&0xF) << FRACTIONAL_SHIFTS ); //12 );
   Digi = (Tmp - SID->PrevVolume) * D418_DIGI_VOLUME * (SID->PrevVolume >> FRACTIONAL_SHIFTS); //S12); //highpass is digi, adding it to output must be before digifilter-code
   SID->PrevVolume += (Tmp - SID->PrevVolume) >> 10; //arithmetic shift amount determines digi lowpass-frequency*/
@@ -287,7 +340,7 @@ static INLINE void cRSID_emulateHQresampledSIDdigi (FASTVAR cRSID_SIDinstance *c
 
 
 
-static INLINE void cRSID_precalculateHQoutputParameters (FASTVAR cRSID_SIDinstance *const FASTPTR SID) { //called by resampler at samplerate-pace
+static INLINE void cRSID_precalculateHQoutputParameters (FASTVAR cRSID_C64instance *const C64, FASTVAR cRSID_SIDinstance *const FASTPTR SID) { //called by resampler at samplerate-pace
  static enum { FRACTIONAL_BITS = 12, FRACTIONAL_SHIFTS = (FRACTIONAL_BITS) } OutputStageSpecs;
  static enum { OFF3_BITVAL=0x80, HIGHPASS_BITVAL=0x40, BANDPASS_BITVAL=0x20, LOWPASS_BITVAL=0x10 } FilterBits;
  static enum { D418_DIGI_VOL=1 *16, D418_DIGI_MUL = (D418_DIGI_VOL / CRSID_WAVGEN_PREDIV), VOLUME_DIGI_SEPARATION_CUTOFF_DIV = (1 << 10) } SIDspecs;
@@ -307,7 +360,7 @@ static INLINE void cRSID_precalculateHQoutputParameters (FASTVAR cRSID_SIDinstan
   SID->Resonance = cRSID_Resonances8580[ SID->BasePtr[0x17] >> 4 ];
  }
  else { //6581
-  SID->Cutoff = cRSID_ActiveCutoffMul6581_OverSampleRate[ Cutoff ];
+  SID->Cutoff = C64->ActiveCutoffMul6581_OverSampleRate[ Cutoff ];
   SID->Resonance = cRSID_Resonances6581[ SID->BasePtr[0x17] >> 4 ];
  }
 
@@ -319,7 +372,7 @@ static INLINE void cRSID_precalculateHQoutputParameters (FASTVAR cRSID_SIDinstan
  //sending AC (highpass) value to a 4th 'digi' channel mixed to the master output, and set ONLY the DC (lowpass) value to the volume-control.
  //This solved 2 issues: Thanks to the lowpass filtering of the volume-control, SID tunes where digi is played together with normal SID channels,
  //won't sound distorted anymore, and the volume-clicks disappear when setting SID-volume. (This is useful for fade-in/out tunes like Hades Nebula, where clicking ruins the intro.)
- if ( TIGHTLY (cRSID_C64.RealSIDmode) ) {
+ if ( TIGHTLY (C64->RealSIDmode) ) {
   Tmp = (signed int) ( (VolumeBand & 0xF) << FRACTIONAL_SHIFTS ); //12 );
   SID->Digi = (Tmp - SID->PrevVolume) * D418_DIGI_MUL; //highpass is digi, adding it to output must be before digifilter-code
   if (SID->VoiceMuteMask & 0x08) SID->Digi = 0;
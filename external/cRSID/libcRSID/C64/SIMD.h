@@ -0,0 +1,71 @@
+//4 x 32bit integer SIMD-lanes for the filter and Sinc-resampler code (enabled by CRSID_SIMD in Config.h)
+//The operations give the same results as the plain C code they replace (wrapping 32bit multiplication, C-style truncating division),
+//so the output stays bit-identical to the CRSID_SIMD=0 build.
+
+#ifndef LIBCRSID_HEADER__SIMD
+#define LIBCRSID_HEADER__SIMD //used  to prevent double inclusion of this header-file
+
+
+#if (CRSID_SIMD != 0)
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+ #include <arm_neon.h>
+ #define CRSID_SIMD_NEON 1
+ typedef int32x4_t cRSID_Lanes;
+#elif defined(__SSE4_1__)
+ #include <smmintrin.h>
+ #define CRSID_SIMD_SSE 1
+ typedef __m128i cRSID_Lanes;
+#else
+ #error "CRSID_SIMD needs NEON or SSE4.1, set CRSID_SIMD to 0 for other targets"
+#endif
+
+
+#ifdef CRSID_SIMD_NEON
+
+static INLINE cRSID_Lanes cRSID_loadLanes (const int* values) { return vld1q_s32(values); }
+static INLINE void cRSID_storeLanes (int* values, cRSID_Lanes lanes) { vst1q_s32(values, lanes); }
+static INLINE cRSID_Lanes cRSID_loadShortLanes (const signed short* values) { return vmovl_s16( vld1_s16(values) ); } //sign-extended
+static INLINE cRSID_Lanes cRSID_setLanes (int value) { return vdupq_n_s32(value); }
+static INLINE cRSID_Lanes cRSID_addLanes (cRSID_Lanes a, cRSID_Lanes b) { return vaddq_s32(a, b); }
+static INLINE cRSID_Lanes cRSID_subLanes (cRSID_Lanes a, cRSID_Lanes b) { return vsubq_s32(a, b); }
+static INLINE cRSID_Lanes cRSID_mulLanes (cRSID_Lanes a, cRSID_Lanes b) { return vmulq_s32(a, b); }
+static INLINE cRSID_Lanes cRSID_andLanes (cRSID_Lanes a, cRSID_Lanes mask) { return vandq_s32(a, mask); }
+static INLINE cRSID_Lanes cRSID_shiftLanesRight (cRSID_Lanes a, int shifts) { return vshlq_s32( a, vdupq_n_s32(-shifts) ); } //arithmetic
+static INLINE int cRSID_getLane3 (cRSID_Lanes lanes) { return vgetq_lane_s32(lanes, 3); }
+static INLINE cRSID_Lanes cRSID_setLane3 (cRSID_Lanes lanes, int value) { return vsetq_lane_s32(value, lanes, 3); }
+static INLINE int cRSID_sumLanes012 (cRSID_Lanes lanes) { //sum of the 3 voice-lanes
+ int32x2_t Pair = vadd_s32( vget_low_s32(lanes), vget_high_s32(lanes) ); //(0+2, 1+3)
+ return vget_lane_s32(Pair, 0) + vgetq_lane_s32(lanes, 1);
+}
+
+#else //CRSID_SIMD_SSE
+
+static INLINE cRSID_Lanes cRSID_loadLanes (const int* values) { return _mm_loadu_si128( (const __m128i*) values ); }
+static INLINE void cRSID_storeLanes (int* values, cRSID_Lanes lanes) { _mm_storeu_si128( (__m128i*) values, lanes ); }
+static INLINE cRSID_Lanes cRSID_loadShortLanes (const signed short* values) { return _mm_cvtepi16_epi32( _mm_loadl_epi64( (const __m128i*) values ) ); }
+static INLINE cRSID_Lanes cRSID_setLanes (int value) { return _mm_set1_epi32(value); }
+static INLINE cRSID_Lanes cRSID_addLanes (cRSID_Lanes a, cRSID_Lanes b) { return _mm_add_epi32(a, b); }
+static INLINE cRSID_Lanes cRSID_subLanes (cRSID_Lanes a, cRSID_Lanes b) { return _mm_sub_epi32(a, b); }
+static INLINE cRSID_Lanes cRSID_mulLanes (cRSID_Lanes a, cRSID_Lanes b) { return _mm_mullo_epi32(a, b); }
+static INLINE cRSID_Lanes cRSID_andLanes (cRSID_Lanes a, cRSID_Lanes mask) { return _mm_and_si128(a, mask); }
+static INLINE cRSID_Lanes cRSID_shiftLanesRight (cRSID_Lanes a, int shifts) { return _mm_sra_epi32( a, _mm_cvtsi32_si128(shifts) ); }
+static INLINE int cRSID_getLane3 (cRSID_Lanes lanes) { return _mm_extract_epi32(lanes, 3); }
+static INLINE cRSID_Lanes cRSID_setLane3 (cRSID_Lanes lanes, int value) { return _mm_insert_epi32(lanes, value, 3); }
+static INLINE int cRSID_sumLanes012 (cRSID_Lanes lanes) { //sum of the 3 voice-lanes
+ __m128i Sum = _mm_add_epi32( lanes, _mm_unpackhi_epi64(lanes, lanes) ); //(0+2, 1+3, ..)
+ return _mm_cvtsi128_si32(Sum) + _mm_extract_epi32(lanes, 1);
+}
+
+#endif
+
+
+static INLINE cRSID_Lanes cRSID_divLanesPow2 (cRSID_Lanes a, int shifts) { //same as C's '/ (1<<shifts)' (rounding towards 0)
+ cRSID_Lanes Bias = cRSID_andLanes( cRSID_shiftLanesRight(a, 31), cRSID_setLanes( (1 << shifts) - 1 ) );
+ return cRSID_shiftLanesRight( cRSID_addLanes(a, Bias), shifts );
+}
+
+
+#endif //CRSID_SIMD
+
+#endif //LIBCRSID_HEADER__SIMD
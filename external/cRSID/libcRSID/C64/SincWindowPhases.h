@@ -0,0 +1,264 @@
+//SincWindow.h rearranged for the SIMD Sinc-resampler: row 'n' holds the taps SincWindow[n], [n+256] .. [n+1280]
+//that an oversampled input-sample at window-position 'n' adds to the following output-samples (row 256 has 5 taps),
+//zero-padded to 8 lanes. Row 0 is unused. (Rearranged from SincWindow.h, keep the two in sync.)
+
+
+static const signed short cRSID_SincWindowPhases [257] [8] = {  //Phases:256+1, Taps:6 (padded to 8), Magnitude:2048
+ {0,0,0,0,0,0,0,0},
+ {0,-1,6,2048,-6,1,0,0},
+ {0,-2,12,2048,-12,2,0,0},
+ {0,-3,18,2047,-18,3,0,0},
+ {0,-4,25,2047,-23,4,0,0},
+ {0,-5,31,2047,-29,5,0,0},
+ {0,-6,37,2046,-35,6,0,0},
+ {0,-7,44,2045,-40,7,0,0},
+ {0,-9,50,2044,-46,7,0,0},
+ {0,-10,57,2043,-51,8,0,0},
+ {0,-11,64,2042,-56,9,0,0},
+ {0,-12,71,2041,-61,10,0,0},
+ {0,-13,77,2039,-67,11,0,0},
+ {0,-15,84,2038,-72,11,0,0},
+ {0,-16,91,2036,-77,12,0,0},
+ {0,-17,98,2035,-81,13,0,0},
+ {0,-18,106,2033,-86,14,0,0},
+ {0,-20,113,2031,-91,14,0,0},
+ {0,-21,120,2029,-96,15,0,0},
+ {0,-22,127,2026,-100,16,0,0},
+ {0,-24,135,2024,-105,16,0,0},
+ {0,-25,142,2022,-109,17,0,0},
+ {0,-26,150,2019,-114,18,0,0},
+ {0,-28,158,2016,-118,18,0,0},
+ {0,-29,165,2014,-122,19,0,0},
+ {0,-31,173,2011,-126,19,0,0},
+ {0,-32,181,2008,-130,20,0,0},
+ {0,-33,189,2005,-134,21,0,0},
+ {0,-35,197,2001,-138,21,0,0},
+ {0,-36,205,1998,-142,22,0,0},
+ {0,-38,213,1995,-146,22,0,0},
+ {0,-40,221,1991,-150,23,0,0},
+ {0,-41,229,1987,-153,23,0,0},
+ {0,-43,238,1983,-157,23,0,0},
+ {0,-44,246,1979,-160,24,0,0},
+ {0,-46,254,1975,-164,24,0,0},
+ {1,-47,263,1971,-167,25,0,0},
+ {1,-49,272,1967,-170,25,0,0},
+ {1,-51,280,1963,-174,25,0,0},
+ {1,-52,289,1958,-177,26,0,0},
+ {1,-54,298,1954,-180,26,0,0},
+ {1,-56,306,1949,-183,26,0,0},
+ {1,-57,315,1944,-186,27,0,0},
+ {1,-59,324,1939,-188,27,0,0},
+ {1,-61,333,1934,-191,27,0,0},
+ {1,-63,342,1929,-194,28,0,0},
+ {1,-64,351,1924,-196,28,0,0},
+ {1,-66,361,1918,-199,28,0,0},
+ {1,-68,370,1913,-202,28,0,0},
+ {1,-70,379,1908,-204,28,0,0},
+ {1,-71,388,1902,-206,29,0,0},
+ {1,-73,398,1896,-209,29,0,0},
+ {2,-75,407,1890,-211,29,0,0},
+ {2,-77,417,1884,-213,29,0,0},
+ {2,-79,426,1878,-215,29,0,0},
+ {2,-81,436,1872,-217,29,0,0},
+ {2,-82,446,1866,-219,29,0,0},
+ {2,-84,455,1860,-221,30,0,0},
+ {2,-86,465,1853,-223,30,0,0},
+ {2,-88,475,1847,-224,30,0,0},
+ {2,-90,485,1840,-226,30,0,0},
+ {2,-92,495,1833,-228,30,0,0},
+ {3,-94,505,1826,-229,30,0,0},
+ {3,-96,515,1819,-231,30,0,0},
+ {3,-98,525,1812,-232,30,0,0},
+ {3,-100,535,1805,-233,30,0,0},
+ {3,-102,545,1798,-235,30,0,0},
+ {3,-103,555,1791,-236,30,0,0},
+ {3,-105,565,1783,-237,30,0,0},
+ {4,-107,575,1776,-238,30,0,0},
+ {4,-109,586,1768,-239,30,0,0},
+ {4,-111,596,1761,-240,30,0,0},
+ {4,-113,606,1753,-241,30,0,0},
+ {4,-115,617,1745,-242,30,0,0},
+ {4,-117,627,1737,-243,30,0,0},
+ {4,-119,638,1730,-244,30,0,0},
+ {5,-121,648,1721,-244,30,0,0},
+ {5,-123,659,1713,-245,29,0,0},
+ {5,-125,669,1705,-246,29,0,0},
+ {5,-127,680,1697,-246,29,0,0},
+ {5,-129,691,1688,-247,29,0,0},
+ {6,-131,701,1680,-247,29,0,0},
+ {6,-133,712,1672,-248,29,0,0},
+ {6,-135,723,1663,-248,29,0,0},
+ {6,-137,733,1654,-248,29,0,0},
+ {6,-139,744,1646,-248,28,0,0},
+ {7,-141,755,1637,-249,28,0,0},
+ {7,-143,766,1628,-249,28,0,0},
+ {7,-145,777,1619,-249,28,0,0},
+ {7,-147,788,1610,-249,28,0,0},
+ {7,-149,798,1601,-249,27,0,0},
+ {8,-151,809,1592,-249,27,0,0},
+ {8,-153,820,1582,-249,27,0,0},
+ {8,-155,831,1573,-248,27,0,0},
+ {8,-157,842,1564,-248,27,0,0},
+ {8,-159,853,1554,-248,26,0,0},
+ {9,-161,864,1545,-248,26,0,0},
+ {9,-163,875,1535,-247,26,0,0},
+ {9,-165,886,1526,-247,26,0,0},
+ {9,-167,897,1516,-246,26,0,0},
+ {10,-169,908,1506,-246,25,0,0},
+ {10,-171,919,1497,-245,25,0,0},
+ {10,-173,930,1487,-245,25,0,0},
+ {10,-175,941,1477,-244,25,0,0},
+ {11,-177,952,1467,-244,24,0,0},
+ {11,-178,963,1457,-243,24,0,0},
+ {11,-180,974,1447,-242,24,0,0},
+ {12,-182,986,1437,-241,23,0,0},
+ {12,-184,997,1427,-241,23,0,0},
+ {12,-186,1008,1417,-240,23,0,0},
+ {12,-188,1019,1407,-239,23,0,0},
+ {13,-189,1030,1396,-238,22,0,0},
+ {13,-191,1041,1386,-237,22,0,0},
+ {13,-193,1052,1376,-236,22,0,0},
+ {13,-195,1063,1365,-235,22,0,0},
+ {14,-196,1074,1355,-234,21,0,0},
+ {14,-198,1085,1344,-233,21,0,0},
+ {14,-200,1096,1334,-232,21,0,0},
+ {15,-202,1107,1323,-230,20,0,0},
+ {15,-203,1118,1313,-229,20,0,0},
+ {15,-205,1129,1302,-228,20,0,0},
+ {15,-207,1140,1292,-227,20,0,0},
+ {16,-208,1151,1281,-226,19,0,0},
+ {16,-210,1162,1270,-224,19,0,0},
+ {16,-211,1173,1260,-223,19,0,0},
+ {17,-213,1184,1249,-222,18,0,0},
+ {17,-214,1195,1238,-220,18,0,0},
+ {17,-216,1206,1227,-219,18,0,0},
+ {17,-217,1216,1216,-217,17,0,0},
+ {18,-219,1227,1206,-216,17,0,0},
+ {18,-220,1238,1195,-214,17,0,0},
+ {18,-222,1249,1184,-213,17,0,0},
+ {19,-223,1260,1173,-211,16,0,0},
+ {19,-224,1270,1162,-210,16,0,0},
+ {19,-226,1281,1151,-208,16,0,0},
+ {20,-227,1292,1140,-207,15,0,0},
+ {20,-228,1302,1129,-205,15,0,0},
+ {20,-229,1313,1118,-203,15,0,0},
+ {20,-230,1323,1107,-202,15,0,0},
+ {21,-232,1334,1096,-200,14,0,0},
+ {21,-233,1344,1085,-198,14,0,0},
+ {21,-234,1355,1074,-196,14,0,0},
+ {22,-235,1365,1063,-195,13,0,0},
+ {22,-236,1376,1052,-193,13,0,0},
+ {22,-237,1386,1041,-191,13,0,0},
+ {22,-238,1396,1030,-189,13,0,0},
+ {23,-239,1407,1019,-188,12,0,0},
+ {23,-240,1417,1008,-186,12,0,0},
+ {23,-241,1427,997,-184,12,0,0},
+ {23,-241,1437,986,-182,12,0,0},
+ {24,-242,1447,974,-180,11,0,0},
+ {24,-243,1457,963,-178,11,0,0},
+ {24,-244,1467,952,-177,11,0,0},
+ {25,-244,1477,941,-175,10,0,0},
+ {25,-245,1487,930,-173,10,0,0},
+ {25,-245,1497,919,-171,10,0,0},
+ {25,-246,1506,908,-169,10,0,0},
+ {26,-246,1516,897,-167,9,0,0},
+ {26,-247,1526,886,-165,9,0,0},
+ {26,-247,1535,875,-163,9,0,0},
+ {26,-248,1545,864,-161,9,0,0},
+ {26,-248,1554,853,-159,8,0,0},
+ {27,-248,1564,842,-157,8,0,0},
+ {27,-248,1573,831,-155,8,0,0},
+ {27,-249,1582,820,-153,8,0,0},
+ {27,-249,1592,809,-151,8,0,0},
+ {27,-249,1601,798,-149,7,0,0},
+ {28,-249,1610,788,-147,7,0,0},
+ {28,-249,1619,777,-145,7,0,0},
+ {28,-249,1628,766,-143,7,0,0},
+ {28,-249,1637,755,-141,7,0,0},
+ {28,-248,1646,744,-139,6,0,0},
+ {29,-248,1654,733,-137,6,0,0},
+ {29,-248,1663,723,-135,6,0,0},
+ {29,-248,1672,712,-133,6,0,0},
+ {29,-247,1680,701,-131,6,0,0},
+ {29,-247,1688,691,-129,5,0,0},
+ {29,-246,1697,680,-127,5,0,0},
+ {29,-246,1705,669,-125,5,0,0},
+ {29,-245,1713,659,-123,5,0,0},
+ {30,-244,1721,648,-121,5,0,0},
+ {30,-244,1730,638,-119,4,0,0},
+ {30,-243,1737,627,-117,4,0,0},
+ {30,-242,1745,617,-115,4,0,0},
+ {30,-241,1753,606,-113,4,0,0},
+ {30,-240,1761,596,-111,4,0,0},
+ {30,-239,1768,586,-109,4,0,0},
+ {30,-238,1776,575,-107,4,0,0},
+ {30,-237,1783,565,-105,3,0,0},
+ {30,-236,1791,555,-103,3,0,0},
+ {30,-235,1798,545,-102,3,0,0},
+ {30,-233,1805,535,-100,3,0,0},
+ {30,-232,1812,525,-98,3,0,0},
+ {30,-231,1819,515,-96,3,0,0},
+ {30,-229,1826,505,-94,3,0,0},
+ {30,-228,1833,495,-92,2,0,0},
+ {30,-226,1840,485,-90,2,0,0},
+ {30,-224,1847,475,-88,2,0,0},
+ {30,-223,1853,465,-86,2,0,0},
+ {30,-221,1860,455,-84,2,0,0},
+ {29,-219,1866,446,-82,2,0,0},
+ {29,-217,1872,436,-81,2,0,0},
+ {29,-215,1878,426,-79,2,0,0},
+ {29,-213,1884,417,-77,2,0,0},
+ {29,-211,1890,407,-75,2,0,0},
+ {29,-209,1896,398,-73,1,0,0},
+ {29,-206,1902,388,-71,1,0,0},
+ {28,-204,1908,379,-70,1,0,0},
+ {28,-202,1913,370,-68,1,0,0},
+ {28,-199,1918,361,-66,1,0,0},
+ {28,-196,1924,351,-64,1,0,0},
+ {28,-194,1929,342,-63,1,0,0},
+ {27,-191,1934,333,-61,1,0,0},
+ {27,-188,1939,324,-59,1,0,0},
+ {27,-186,1944,315,-57,1,0,0},
+ {26,-183,1949,306,-56,1,0,0},
+ {26,-180,1954,298,-54,1,0,0},
+ {26,-177,1958,289,-52,1,0,0},
+ {25,-174,1963,280,-51,1,0,0},
+ {25,-170,1967,272,-49,1,0,0},
+ {25,-167,1971,263,-47,1,0,0},
+ {24,-164,1975,254,-46,0,0,0},
+ {24,-160,1979,246,-44,0,0,0},
+ {23,-157,1983,238,-43,0,0,0},
+ {23,-153,1987,229,-41,0,0,0},
+ {23,-150,1991,221,-40,0,0,0},
+ {22,-146,1995,213,-38,0,0,0},
+ {22,-142,1998,205,-36,0,0,0},
+ {21,-138,2001,197,-35,0,0,0},
+ {21,-134,2005,189,-33,0,0,0},
+ {20,-130,2008,181,-32,0,0,0},
+ {19,-126,2011,173,-31,0,0,0},
+ {19,-122,2014,165,-29,0,0,0},
+ {18,-118,2016,158,-28,0,0,0},
+ {18,-114,2019,150,-26,0,0,0},
+ {17,-109,2022,142,-25,0,0,0},
+ {16,-105,2024,135,-24,0,0,0},
+ {16,-100,2026,127,-22,0,0,0},
+ {15,-96,2029,120,-21,0,0,0},
+ {14,-91,2031,113,-20,0,0,0},
+ {14,-86,2033,106,-18,0,0,0},
+ {13,-81,2035,98,-17,0,0,0},
+ {12,-77,2036,91,-16,0,0,0},
+ {11,-72,2038,84,-15,0,0,0},
+ {11,-67,2039,77,-13,0,0,0},
+ {10,-61,2041,71,-12,0,0,0},
+ {9,-56,2042,64,-11,0,0,0},
+ {8,-51,2043,57,-10,0,0,0},
+ {7,-46,2044,50,-9,0,0,0},
+ {7,-40,2045,44,-7,0,0,0},
+ {6,-35,2046,37,-6,0,0,0},
+ {5,-29,2047,31,-5,0,0,0},
+ {4,-23,2047,25,-4,0,0,0},
+ {3,-18,2047,18,-3,0,0,0},
+ {2,-12,2048,12,-2,0,0,0},
+ {1,-6,2048,6,-1,0,0,0},
+ {0,0,2048,0,0,0,0,0},
+};
@@ -34,4 +34,13 @@
 #endif
 
 
+#ifndef CRSID_SIMD //4-lane (128-bit) filter and Sinc-resampler code, 0 selects the plain C reference (both give the same output)
+ #if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(__SSE4_1__) //(SSE4.1 is part of the Android x86_64 ABI)
+  #define CRSID_SIMD 1
+ #else
+  #define CRSID_SIMD 0
+ #endif
+#endif
+
+
 #endif //LIBCRSID_HEADER__CONFIG
\ No newline at end of file
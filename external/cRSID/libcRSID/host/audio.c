@@ -245,21 +245,21 @@ void cRSID_stopSound (void) {
 #endif //CRSID_PLATFORM_PC
 
 
-void cRSID_generateSound (FASTVAR unsigned char *buf, FASTVAR unsigned short len) {
+void cRSID_generateSoundC64 (FASTVAR cRSID_C64instance *const C64, FASTVAR unsigned char *buf, FASTVAR unsigned short len) {
  //enum { FADE_SCALING = 16, MIX_SCALING = (256*FADE_SCALING) };
  FASTVAR unsigned short i; FASTVAR unsigned char j;
- static cRSID_Output Output;
+ cRSID_Output Output = {0,0};
  //FASTVAR signed short OutputL, OutputR;
  //FASTVAR signed int VolumeMul;
 
  //Refresh shadow registers that remain untouched during the audio-generation, to avoid discrepancies if main thread changes their originators
- cRSID_C64.RealSIDmode = cRSID.RealSIDmode; //this one gets updated at SID-data rocessing too when the audio doesn't run, to let CPU routines use the up-to-date shadowed versions
- cRSID_C64.AudioThread_SIDchipCount = cRSID_C64.SIDchipCount;
- cRSID_C64.Stereo = cRSID_C64.AudioThread_SIDchipCount > 1 ? cRSID.Stereo : CRSID_CHANNELMODE_MONO; //this might be changed regularly during playback by the user, and maybe these too:
- cRSID_C64.HighQualitySID = cRSID.HighQualitySID; cRSID_C64.HighQualityResampler = cRSID.HighQualityResampler;
+ C64->RealSIDmode = C64->Interface->RealSIDmode; //this one gets updated at SID-data rocessing too when the audio doesn't run, to let CPU routines use the up-to-date shadowed versions
+ C64->AudioThread_SIDchipCount = C64->SIDchipCount;
+ C64->Stereo = C64->AudioThread_SIDchipCount > 1 ? C64->Interface->Stereo : CRSID_CHANNELMODE_MONO; //this might be changed regularly during playback by the user, and maybe these too:
+ C64->HighQualitySID = C64->Interface->HighQualitySID; C64->HighQualityResampler = C64->Interface->HighQualityResampler;
 
  for (i=0; i<len; i+=4) {
-  for(j=0; j<cRSID.PlaybackSpeed; ++j) Output = cRSID_generateSample();
+  for(j=0; j<C64->Interface->PlaybackSpeed; ++j) Output = cRSID_generateSampleC64(C64);
   //VolumeMul = cRSID.MainVolume * cRSID_C64.FadeLevel;
   // /* *(signed short*) &buf[i]*/ Output.L = Output.L * VolumeMul / MIX_SCALING;   //can we expect little-endianness?
   // /* *(signed short*) &buf[i+2]*/ Output.R = Output.R * VolumeMul / MIX_SCALING; //can we expect little-endianness?
@@ -269,25 +269,25 @@ void cRSID_generateSound (FASTVAR unsigned char *buf, FASTVAR unsigned short len
 }
 
 
-INLINE cRSID_Output cRSID_generateSample () { //call this from custom buffer-filler
+INLINE cRSID_Output cRSID_generateSampleC64 (FASTVAR cRSID_C64instance *const C64) { //call this from custom buffer-filler
  enum { FADE_SCALING = 16, MIX_SCALING = (256*FADE_SCALING),
   SCRAMBLER_BITS = 8, DITHERNOISE_DIVSHIFTS = 6 /*5*/, DITHERNOISE_MID = ( ( 1 << (SCRAMBLER_BITS - DITHERNOISE_DIVSHIFTS) ) / 2 )
  };
 
  FASTVAR signed short VolumeMul; FASTVAR signed short Insert;
- static cRSID_Output Output;
- static int LFSR = 0x0055A5AA; FASTVAR int fb;
+ cRSID_Output Output;
+ FASTVAR int LFSR = C64->DitherLFSR, fb;
 
- if ( RARELY (cRSID.Paused) ) { Output.L = Output.R = 0; return Output; }
+ if ( RARELY (C64->Interface->Paused) ) { Output.L = Output.R = 0; return Output; }
 
  //If calling cRSID_generateSample() directly, don't forget to keep the audio-thread shadow-variables updated, as seen above in cRSID_generateSound()
  //cRSID_C64.RealSIDmode = cRSID.RealSIDmode; //this one gets updated at SID-data rocessing too when the audio doesn't run, to let CPU routines use the up-to-date shadowed versions
 
- Output = *cRSID_emulateC64();
+ Output = *cRSID_emulateC64(C64);
 
- if ( RARELY (cRSID.PSIDdigiMode) ) { Insert = cRSID_playPSIDdigi(); Output.L += Insert; Output.R += Insert; }
+ if ( RARELY (C64->Interface->PSIDdigiMode) ) { Insert = cRSID_playPSIDdigi(C64); Output.L += Insert; Output.R += Insert; }
 
- VolumeMul = cRSID.MainVolume * cRSID_C64.FadeLevel;
+ VolumeMul = C64->Interface->MainVolume * C64->FadeLevel;
  Output.L = (Output.L * VolumeMul) / MIX_SCALING; //Having the attenuator before saturation allows avoiding filter/many-SIDs overdrive-distortion
  Output.R = (Output.R * VolumeMul) / MIX_SCALING; //(By simply adjusting the main volume knob to a lower level. Real SID distorts as well in those cases btw.)
 
@@ -299,10 +299,36 @@ INLINE cRSID_Output cRSID_generateSample () { //call this from custom buffer-fil
  //We use AND-masks to combine into output (instead of free bit-to-bit mapping)
  //(this method has ENT-correlation=0.000002, PI-error=0.02%, a nice evenly distributed spectrum that fits between -45.4..-45.8dB)
  Insert = (signed char) ( (unsigned char) ( ( ( (LFSR >> 16) & 0x99 ) + ( (LFSR >> 8) & 0x72 ) + (LFSR & 0xB4) + 0x7C ) & 0xFF ) >> DITHERNOISE_DIVSHIFTS ) - DITHERNOISE_MID;
- Output.L += Insert; Output.R += Insert;
+ Output.L += Insert; Output.R += Insert; C64->DitherLFSR = LFSR;
 
  if ( RARELY(Output.L>=32767) ) Output.L=32767; else if ( RARELY (Output.L<=-32768) ) Output.L=-32768; //saturation arithmetic on overflow
  if ( RARELY(Output.R>=32767) ) Output.R=32767; else if ( RARELY (Output.R<=-32768) ) Output.R=-32768; //saturation arithmetic on overflow
  return Output;
 }
 
+
+int cRSID_generateSamplesC64 (cRSID_C64instance* C64, signed short* out_stereo, int frames, signed int* out_voice_planes, int plane_stride) {
+ //Block version of cRSID_generateSample() for custom buffer-fillers: keeps the CPU/CIA/SID emulation loop on this side of the call
+ //and the output in a flat buffer the caller can convert in one pass. (Shadow-registers are refreshed once per block, like cRSID_generateSound() does per buffer.)
+ enum { VOICE_PLANES = 4 };
+ FASTVAR int i, Plane, SIDnum, SIDcount; cRSID_Output Output; signed int* FASTPTR PlanePtr; const cRSID_SIDinstance* SID;
+
+ if (out_stereo == NULL || frames <= 0) return 0;
+ C64->RealSIDmode = C64->Interface->RealSIDmode;
+ C64->AudioThread_SIDchipCount = C64->SIDchipCount;
+ C64->Stereo = C64->AudioThread_SIDchipCount > 1 ? C64->Interface->Stereo : CRSID_CHANNELMODE_MONO;
+ C64->HighQualitySID = C64->Interface->HighQualitySID; C64->HighQualityResampler = C64->Interface->HighQualityResampler;
+ SIDcount = C64->AudioThread_SIDchipCount; if (SIDcount > CRSID_SIDCOUNT_MAX) SIDcount = CRSID_SIDCOUNT_MAX;
+
+ for (i=0; i<frames; ++i) {
+  Output = cRSID_generateSampleC64(C64); //already saturated to 16 bits
+  out_stereo[i*2+0] = (signed short) Output.L; out_stereo[i*2+1] = (signed short) Output.R;
+  if (out_voice_planes != NULL) {
+   for (SIDnum=1; SIDnum<=SIDcount; ++SIDnum) {
+    SID = &C64->SID[SIDnum]; PlanePtr = out_voice_planes + (SIDnum-1)*VOICE_PLANES*plane_stride + i;
+    for (Plane=0; Plane<VOICE_PLANES; ++Plane) PlanePtr[Plane*plane_stride] = SID->ScopeVoiceOutput[Plane];
+   }
+  }
+ }
+ return frames;
+}
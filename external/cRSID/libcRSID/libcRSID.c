@@ -24,43 +24,41 @@
 #include "host/audio.c"
 
 
-cRSID_Interface cRSID; //the only public global object (for faster & simpler access than with struct-pointers, in some places)
-cRSID_C64instance cRSID_C64; //the only private global object (for faster & simpler access than with struct-pointers, in some places)
+cRSID_Interface cRSID; //the public global object (API variables of the global instance used by the single-instance calls)
+cRSID_C64instance cRSID_C64 = { .Interface = &cRSID }; //the private global instance (more can be created by cRSID_newC64())
 
 
 
 static void cRSID_autoAdvance_Dummy_callBack (char arg, void* data) { return; }
 
 
-void* cRSID_init (unsigned short samplerate, unsigned short buflen) {
- static cRSID_C64instance* C64 = &cRSID_C64;
-
- cRSID.RealSIDmode = 1;
- cRSID.Stereo = CRSID_CHANNELMODE_MONO;
- cRSID.HighQualitySID = 1;
- cRSID.HighQualityResampler = 0; //1;  //was problematic (noisy) with lowpass-filtered triangles on all SID-channels
- cRSID_C64.RealSIDmode = cRSID.RealSIDmode; cRSID_C64.Stereo = cRSID.Stereo; //init shadow-variables to defaults for audio-thread as well
- cRSID_C64.HighQualitySID = cRSID.HighQualitySID; cRSID_C64.HighQualityResampler = cRSID.HighQualityResampler;
- cRSID.ForcedVideoStandard = CRSID_VIDEOSTANDARD_AUTO;
- cRSID.SelectedSIDmodel = 0; //default model and mode selections
- cRSID.Filter6581Preset = CRSID_FILTER6581_PRESET_STOCK;
- cRSID.PlaybackSpeed = 1;
- cRSID.MainVolume = 255; //230; //255; //230; //204; //255;
- cRSID.CLImode = 0; cRSID.AutoExit = cRSID.BuiltInMusic = cRSID.BuiltInMusicSize = 0; cRSID.BuiltInMusicData = NULL;
- cRSID.OpenedMusic = 0;
- cRSID.AutoAdvance = cRSID.FadeOut = 1;
+void* cRSID_initC64 (cRSID_C64instance* C64, unsigned short samplerate, unsigned short buflen) {
+ C64->Interface->RealSIDmode = 1;
+ C64->Interface->Stereo = CRSID_CHANNELMODE_MONO;
+ C64->Interface->HighQualitySID = 1;
+ C64->Interface->HighQualityResampler = 0; //1;  //was problematic (noisy) with lowpass-filtered triangles on all SID-channels
+ C64->RealSIDmode = C64->Interface->RealSIDmode; C64->Stereo = C64->Interface->Stereo; //init shadow-variables to defaults for audio-thread as well
+ C64->HighQualitySID = C64->Interface->HighQualitySID; C64->HighQualityResampler = C64->Interface->HighQualityResampler;
+ C64->Interface->ForcedVideoStandard = CRSID_VIDEOSTANDARD_AUTO;
+ C64->Interface->SelectedSIDmodel = 0; //default model and mode selections
+ C64->Interface->Filter6581Preset = CRSID_FILTER6581_PRESET_STOCK;
+ C64->Interface->PlaybackSpeed = 1;
+ C64->Interface->MainVolume = 255; //230; //255; //230; //204; //255;
+ C64->Interface->CLImode = 0; C64->Interface->AutoExit = C64->Interface->BuiltInMusic = C64->Interface->BuiltInMusicSize = 0; C64->Interface->BuiltInMusicData = NULL;
+ C64->Interface->OpenedMusic = 0;
+ C64->Interface->AutoAdvance = C64->Interface->FadeOut = 1;
  C64->FadeLevel=0xF;
- cRSID.PlayListSize = 0; cRSID.PlayListNumber = 1;
- cRSID.PlayListPlayPosition = cRSID.PlayListAdvance = 0;
- cRSID.SongLengths = NULL;  cRSID.KERNALfileData = NULL; cRSID.BASICfileData = NULL;
+ C64->Interface->PlayListSize = 0; C64->Interface->PlayListNumber = 1;
+ C64->Interface->PlayListPlayPosition = C64->Interface->PlayListAdvance = 0;
+ C64->Interface->SongLengths = NULL;  C64->Interface->KERNALfileData = NULL; C64->Interface->BASICfileData = NULL;
 //#ifdef CRSID_PLATFORM_PC
- cRSID_setCallBack__autoAdvance( cRSID_autoAdvance_Dummy_callBack, NULL ); //to prevent segfault if not assigned by user
+ cRSID_setCallBack__autoAdvanceC64( C64, cRSID_autoAdvance_Dummy_callBack, NULL ); //to prevent segfault if not assigned by user
 //#endif
 
- cRSID_configure6581FilterPreset( cRSID.Filter6581Preset );
- C64 = cRSID_createC64( samplerate );
+ C64 = cRSID_createC64( C64, samplerate );
+ cRSID_configure6581FilterPreset( C64, C64->Interface->Filter6581Preset );
 #ifdef CRSID_PLATFORM_PC
- cRSID.ChangingDirectory=0;
+ C64->Interface->ChangingDirectory=0;
  if ( cRSID_initSound(samplerate,buflen) == NULL ) return NULL;
 #else
  if (buflen) return C64; //this is here just to eliminate unused 'buflen' variable warning
@@ -71,57 +69,56 @@ void* cRSID_init (unsigned short samplerate, unsigned short buflen) {
 
 
 
-void cRSID_initSIDtune (cRSID_SIDheader* SIDheader, char subtune) { //subtune: 1..255
- static cRSID_C64instance* C64 = &cRSID_C64;
+void cRSID_initSIDtuneC64 (cRSID_C64instance* C64, cRSID_SIDheader* SIDheader, char subtune) { //subtune: 1..255
  static const unsigned char PowersOf2[] = {0x01,0x02,0x04,0x08,0x10,0x20,0x40,0x80};
  unsigned int InitTimeout=10000000; //allowed instructions, value should be selected to allow for long-running memory-copiers in init-routines (e.g. Synth Sample)
 
- cRSID.PlaytimeExpired=0; C64->FadeLevel=0xF; cRSID.Paused = 1;
+ C64->Interface->PlaytimeExpired=0; C64->FadeLevel=0xF; C64->Interface->Paused = 1;
 
  if (subtune==0) subtune = 1;
  else if (subtune > SIDheader->SubtuneAmount) subtune = SIDheader->SubtuneAmount;    //printf( "Subtune: %d\n", subtune );
- cRSID.SubTune = subtune; C64->SecondCnt = cRSID.PlayTime = 0; cRSID.PlaybackSpeed=1; //cRSID.Paused = 0; //don't unpause this early, before init!
+ C64->Interface->SubTune = subtune; C64->SecondCnt = C64->Interface->PlayTime = 0; C64->Interface->PlaybackSpeed=1; //cRSID.Paused = 0; //don't unpause this early, before init!
 
- cRSID_setC64(); cRSID_initC64(); //cRSID_writeMemC64(C64,0xD418,0xF); //set C64 hardware and init (reset) it
+ cRSID_setC64(C64); cRSID_resetC64(C64); //cRSID_writeMemC64(C64,0xD418,0xF); //set C64 hardware and init (reset) it
  //cRSID.Paused = 0;
 
  //determine init-address:
- cRSID.InitAddress = ((SIDheader->InitAddressH)<<8) + (SIDheader->InitAddressL); //get info from BASIC-startupcode for some tunes
+ C64->Interface->InitAddress = ((SIDheader->InitAddressH)<<8) + (SIDheader->InitAddressL); //get info from BASIC-startupcode for some tunes
  if (C64->RAMbank[1] == 0x37) { //are there SIDs with routine under IO area? some PSIDs don't set bank-registers themselves
-  if ( (0xA000 <= cRSID.InitAddress && cRSID.InitAddress < 0xC000)
-       || (cRSID.LoadAddress < 0xC000 && cRSID.EndAddress >= 0xA000) ) C64->RAMbank[1] = 0x36;
-  else if (cRSID.InitAddress >= 0xE000 || cRSID.EndAddress >=0xE000) C64->RAMbank[1] = 0x35;
+  if ( (0xA000 <= C64->Interface->InitAddress && C64->Interface->InitAddress < 0xC000)
+       || (C64->Interface->LoadAddress < 0xC000 && C64->Interface->EndAddress >= 0xA000) ) C64->RAMbank[1] = 0x36;
+  else if (C64->Interface->InitAddress >= 0xE000 || C64->Interface->EndAddress >=0xE000) C64->RAMbank[1] = 0x35;
  }
- cRSID_initCPU( cRSID.InitAddress ); //prepare init-routine call
+ cRSID_initCPU( C64, C64->Interface->InitAddress ); //prepare init-routine call
  C64->CPU.A = subtune - 1;
 
- if (!cRSID.RealSIDmode) {
+ if (!C64->Interface->RealSIDmode) {
   //call init-routine:
-  for (InitTimeout=10000000; InitTimeout>0; InitTimeout--) { if ( cRSID_emulateCPU()>=0xFE ) break; } //give error when timed out?
+  for (InitTimeout=10000000; InitTimeout>0; InitTimeout--) { if ( cRSID_emulateCPU(C64)>=0xFE ) break; } //give error when timed out?
  }
 
  //determine timing-source, if CIA, replace FrameCycles previouisly set to VIC-timing
- if (subtune>32) cRSID.TimerSource = cRSID.SIDheader->SubtuneTimeSources[0] & 0x80; //subtunes above 32 should use subtune32's timing
- else cRSID.TimerSource = cRSID.SIDheader->SubtuneTimeSources[(32-subtune)>>3] & PowersOf2[(subtune-1)&7];
- if (cRSID.TimerSource || C64->IObankWR[0xDC05]!=0x40 || C64->IObankWR[0xDC04]!=0x24) { //CIA1-timing (probably multispeed tune)
-  cRSID.FrameCycles = ( ( C64->IObankWR[0xDC04] + (C64->IObankWR[0xDC05]<<8) ) ); //<< 4) / C64->ClockRatio;
-  cRSID.TimerSource = 1; //if init-routine changed DC04 or DC05, assume CIA-timing
+ if (subtune>32) C64->Interface->TimerSource = C64->Interface->SIDheader->SubtuneTimeSources[0] & 0x80; //subtunes above 32 should use subtune32's timing
+ else C64->Interface->TimerSource = C64->Interface->SIDheader->SubtuneTimeSources[(32-subtune)>>3] & PowersOf2[(subtune-1)&7];
+ if (C64->Interface->TimerSource || C64->IObankWR[0xDC05]!=0x40 || C64->IObankWR[0xDC04]!=0x24) { //CIA1-timing (probably multispeed tune)
+  C64->Interface->FrameCycles = ( ( C64->IObankWR[0xDC04] + (C64->IObankWR[0xDC05]<<8) ) ); //<< 4) / C64->ClockRatio;
+  C64->Interface->TimerSource = 1; //if init-routine changed DC04 or DC05, assume CIA-timing
  }
 
  //determine playaddress:
- cRSID.PlayAddress = (SIDheader->PlayAddressH<<8) + SIDheader->PlayAddressL;
- if (cRSID.PlayAddress) cRSID_setPSIDplayBank(); //normal play-address called with JSR
+ C64->Interface->PlayAddress = (SIDheader->PlayAddressH<<8) + SIDheader->PlayAddressL;
+ if (C64->Interface->PlayAddress) cRSID_setPSIDplayBank(C64); //normal play-address called with JSR
  else { //IRQ-playaddress for multispeed-tunes set by init-routine (some tunes turn off KERNAL ROM but doesn't set IRQ-vector!)
-  cRSID.PlayAddress = (C64->RAMbank[1] & 3) < 2 ? cRSID_readMem(0xFFFE) + (cRSID_readMem(0xFFFF)<<8) //cRSID_readMemC64(C64,0xFFFE) + (cRSID_readMemC64(C64,0xFFFF)<<8) //for PSID
-                                                 : cRSID_readMem(0x314) + (cRSID_readMem(0x315)<<8); //: cRSID_readMemC64(C64,0x314) + (cRSID_readMemC64(C64,0x315)<<8);
-  if (cRSID.PlayAddress==0) { //if 0, still try with RSID-mode fallback
-   cRSID_initCPU( cRSID.PlayAddress ); //point CPU to play-routine
-   C64->Finished=1; C64->Returned=1; cRSID.Paused = 0; return;
+  C64->Interface->PlayAddress = (C64->RAMbank[1] & 3) < 2 ? cRSID_readMem(C64, 0xFFFE) + (cRSID_readMem(C64, 0xFFFF)<<8) //cRSID_readMemC64(C64,0xFFFE) + (cRSID_readMemC64(C64,0xFFFF)<<8) //for PSID
+                                                 : cRSID_readMem(C64, 0x314) + (cRSID_readMem(C64, 0x315)<<8); //: cRSID_readMemC64(C64,0x314) + (cRSID_readMemC64(C64,0x315)<<8);
+  if (C64->Interface->PlayAddress==0) { //if 0, still try with RSID-mode fallback
+   cRSID_initCPU( C64, C64->Interface->PlayAddress ); //point CPU to play-routine
+   C64->Finished=1; C64->Returned=1; C64->Interface->Paused = 0; return;
   }
  }
 
- if (!cRSID.RealSIDmode) {  //prepare (PSID) play-routine playback:
-  cRSID_initCPU( cRSID.PlayAddress ); //point CPU to play-routine
+ if (!C64->Interface->RealSIDmode) {  //prepare (PSID) play-routine playback:
+  cRSID_initCPU( C64, C64->Interface->PlayAddress ); //point CPU to play-routine
   C64->RAMbank[0x1FF] = (unsigned char) ((CRSID_PSID_RETURN_SENTINEL - 1u) >> 8);
   C64->RAMbank[0x1FE] = (unsigned char) ((CRSID_PSID_RETURN_SENTINEL - 1u) & 0xFF);
   C64->CPU.SP = 0xFD;
@@ -129,44 +126,113 @@ void cRSID_initSIDtune (cRSID_SIDheader* SIDheader, char subtune) { //subtune: 1
  }
  else { C64->Finished=0; C64->Returned=0; }
 
- cRSID.Paused = 0;
+ C64->Interface->Paused = 0;
+}
+
+
+typedef struct cRSID_StateHeader {
+ unsigned int      Magic;
+ unsigned int      Size;
+ unsigned short    SampleRate;
+ unsigned char     SubTune;
+ char              PlaytimeExpired;
+ short             PlayTime;
+ char              TimerSource;
+ unsigned char     VideoStandard;
+ int               FrameCycles;
+ unsigned short    InitAddress;
+ unsigned short    PlayAddress;
+} cRSID_StateHeader;
+
+enum cRSID_StateSpecs { CRSID_STATE_MAGIC = 0x53525363 }; //'cSRS'
+
+size_t cRSID_getStateSize (void) { return sizeof(cRSID_StateHeader) + sizeof(cRSID_C64instance); }
+
+size_t cRSID_saveStateC64 (cRSID_C64instance* C64, void* destination, size_t capacity) {
+ cRSID_StateHeader Header;
+ if (destination==NULL || capacity < cRSID_getStateSize()) return 0;
+ Header.Magic = CRSID_STATE_MAGIC; Header.Size = (unsigned int) cRSID_getStateSize();
+ Header.SampleRate = C64->SampleRate; Header.SubTune = C64->Interface->SubTune;
+ Header.PlaytimeExpired = C64->Interface->PlaytimeExpired; Header.PlayTime = C64->Interface->PlayTime;
+ Header.TimerSource = C64->Interface->TimerSource; Header.VideoStandard = C64->Interface->VideoStandard; Header.FrameCycles = C64->Interface->FrameCycles;
+ Header.InitAddress = C64->Interface->InitAddress; Header.PlayAddress = C64->Interface->PlayAddress;
+ memcpy( destination, &Header, sizeof(Header) );
+ memcpy( (unsigned char*)destination + sizeof(Header), C64, sizeof(cRSID_C64instance) );
+ return cRSID_getStateSize();
+}
+
+char cRSID_loadStateC64 (cRSID_C64instance* C64, const void* source, size_t size) {
+ cRSID_StateHeader Header;
+ //host/platform-side fields are kept, only the emulated machine is rewound:
+ cRSID_Interface* Interface; unsigned char* SampleBuffer; void* SoundDevice; unsigned char SoundStarted;
+ void (*callBack) (char subtunestepping, void* data); void* callBackData;
+ char RealSIDmode; unsigned char Stereo, HighQualitySID, HighQualityResampler;
+ unsigned char MuteMasks [CRSID_SIDCOUNT_MAX+1], FilterPreset; int i;
+
+ if (source==NULL || size != cRSID_getStateSize()) return 0;
+ memcpy( &Header, source, sizeof(Header) );
+ if (Header.Magic != CRSID_STATE_MAGIC || Header.Size != size
+     || Header.SampleRate != C64->SampleRate || Header.SubTune != C64->Interface->SubTune) return 0;
+
+ Interface = C64->Interface; SampleBuffer = C64->SampleBuffer; SoundDevice = C64->SoundDevice; SoundStarted = C64->SoundStarted;
+ callBack = C64->callBack__autoAdvance; callBackData = C64->callBackData__autoAdvance;
+ RealSIDmode = C64->RealSIDmode; Stereo = C64->Stereo;
+ HighQualitySID = C64->HighQualitySID; HighQualityResampler = C64->HighQualityResampler;
+ for (i=0; i<=CRSID_SIDCOUNT_MAX; ++i) MuteMasks[i] = C64->SID[i].VoiceMuteMask;
+ FilterPreset = C64->Active6581FilterPreset;
+
+ memcpy( C64, (const unsigned char*)source + sizeof(Header), sizeof(cRSID_C64instance) );
+
+ C64->Interface = Interface; C64->SampleBuffer = SampleBuffer; C64->SoundDevice = SoundDevice; C64->SoundStarted = SoundStarted;
+ C64->callBack__autoAdvance = callBack; C64->callBackData__autoAdvance = callBackData;
+ C64->RealSIDmode = RealSIDmode; C64->Stereo = Stereo;
+ C64->HighQualitySID = HighQualitySID; C64->HighQualityResampler = HighQualityResampler;
+ for (i=0; i<=CRSID_SIDCOUNT_MAX; ++i) C64->SID[i].VoiceMuteMask = MuteMasks[i];
+ if (C64->Active6581FilterPreset != FilterPreset) { //keep the filter-preset selected since the snapshot
+  C64->Active6581FilterPreset = 0xFF; cRSID_configure6581FilterPreset( C64, FilterPreset );
+ }
+
+ C64->Interface->PlaytimeExpired = Header.PlaytimeExpired; C64->Interface->PlayTime = Header.PlayTime;
+ C64->Interface->TimerSource = Header.TimerSource; C64->Interface->VideoStandard = Header.VideoStandard; C64->Interface->FrameCycles = Header.FrameCycles;
+ C64->Interface->InitAddress = Header.InitAddress; C64->Interface->PlayAddress = Header.PlayAddress;
+ return 1;
 }
 
 
-char* cRSID_setSongLengthData (char* filedata) {
- if (filedata != NULL) { cRSID.SongLengths = filedata; return cRSID.SongLengths; }
+char* cRSID_setSongLengthDataC64 (cRSID_C64instance* C64, char* filedata) {
+ if (filedata != NULL) { C64->Interface->SongLengths = filedata; return C64->Interface->SongLengths; }
  return filedata;
 }
 
-unsigned char* cRSID_setKERNALdata (unsigned char* filedata) {
- if (filedata != NULL) { cRSID.KERNALfileData = filedata; cRSID_setROMcontent(); return cRSID.KERNALfileData; }
+unsigned char* cRSID_setKERNALdataC64 (cRSID_C64instance* C64, unsigned char* filedata) {
+ if (filedata != NULL) { C64->Interface->KERNALfileData = filedata; cRSID_setROMcontent(C64); return C64->Interface->KERNALfileData; }
  return filedata;
 }
 
-unsigned char* cRSID_setBASICdata (unsigned char* filedata) {
- if (filedata != NULL) { cRSID.BASICfileData = filedata; cRSID_setROMcontent(); return cRSID.BASICfileData; }
+unsigned char* cRSID_setBASICdataC64 (cRSID_C64instance* C64, unsigned char* filedata) {
+ if (filedata != NULL) { C64->Interface->BASICfileData = filedata; cRSID_setROMcontent(C64); return C64->Interface->BASICfileData; }
  return filedata;
 }
 
 
-void cRSID_close (void) {
- cRSID.Paused = 1;
+void cRSID_closeC64 (cRSID_C64instance* C64) {
+ C64->Interface->Paused = 1;
  #ifdef CRSID_PLATFORM_PC
   cRSID_closeSound();
  #endif
 }
 
 
-void cRSID_playSIDtune (void) {
+void cRSID_playSIDtuneC64 (cRSID_C64instance* C64) {
  #ifdef CRSID_PLATFORM_PC
   cRSID_startSound();
  #endif
- cRSID.Paused = 0;
+ C64->Interface->Paused = 0;
 }
 
 
-void cRSID_pauseSIDtune (void) {
- cRSID.Paused = 1; //cause immediate stopping in audio-buffer thread, so SID-baseaddress changes during tune-switching won't give segfaults
+void cRSID_pauseSIDtuneC64 (cRSID_C64instance* C64) {
+ C64->Interface->Paused = 1; //cause immediate stopping in audio-buffer thread, so SID-baseaddress changes during tune-switching won't give segfaults
  #ifdef CRSID_PLATFORM_PC
   cRSID_stopSound();
  #endif
@@ -176,65 +242,116 @@ void cRSID_pauseSIDtune (void) {
 }
 
 
-void cRSID_startSubtune (unsigned char subtune) {
+void cRSID_startSubtuneC64 (cRSID_C64instance* C64, unsigned char subtune) {
  int i;
- cRSID_pauseSIDtune();
- cRSID_processSIDfileData( (unsigned char*) cRSID.SIDfileData, cRSID.SIDfileSize );
- cRSID_initSIDtune( cRSID.SIDheader, subtune ); //cRSID.PlaybackSpeed=1; /*cRSID.Paused=0;*/
- cRSID_playSIDtune();
+ cRSID_pauseSIDtuneC64(C64);
+ cRSID_processSIDfileDataC64( C64, (unsigned char*) C64->Interface->SIDfileData, C64->Interface->SIDfileSize );
+ cRSID_initSIDtuneC64( C64, C64->Interface->SIDheader, subtune ); //cRSID.PlaybackSpeed=1; /*cRSID.Paused=0;*/
+ cRSID_playSIDtuneC64(C64);
 }
 
-void cRSID_nextSubtune() { if (cRSID.SubTune<CRSID_SUBTUNE_AMOUNT_MAX-1) cRSID_startSubtune(++cRSID.SubTune); }
+void cRSID_nextSubtuneC64(cRSID_C64instance* C64) { if (C64->Interface->SubTune<CRSID_SUBTUNE_AMOUNT_MAX-1) cRSID_startSubtuneC64(C64, ++C64->Interface->SubTune); }
 
-void cRSID_prevSubtune() { if (cRSID.SubTune>0) cRSID_startSubtune(--cRSID.SubTune); }
+void cRSID_prevSubtuneC64(cRSID_C64instance* C64) { if (C64->Interface->SubTune>0) cRSID_startSubtuneC64(C64, --C64->Interface->SubTune); }
 
 
 
-void cRSID_setCallBack__autoAdvance ( void (*callback) (char subtunestepping, void* data), void* data ) {
- cRSID_C64.callBack__autoAdvance = callback; cRSID_C64.callBackData__autoAdvance = data;
+void cRSID_setCallBack__autoAdvanceC64 (cRSID_C64instance* C64, void (*callback) (char subtunestepping, void* data), void* data ) {
+ C64->callBack__autoAdvance = callback; C64->callBackData__autoAdvance = data;
 }
 
-static void cRSID_callBack_autoAdvance (char subtunestepping) {
- cRSID_C64.callBack__autoAdvance( subtunestepping, cRSID_C64.callBackData__autoAdvance );
+static void cRSID_callBack_autoAdvance (cRSID_C64instance* C64, char subtunestepping) {
+ C64->callBack__autoAdvance( subtunestepping, C64->callBackData__autoAdvance );
 }
-void cRSID_autoAdvance () {
- if ( cRSID.SubtuneDurations[cRSID.SubTune] != 0 && cRSID.AutoAdvance
-      && (cRSID.SIDheader->SubtuneAmount>1 || cRSID.AutoExit || cRSID.PlayListSize>1) ) {
-  if (cRSID.PlayTime == cRSID.SubtuneDurations[cRSID.SubTune]) {
-   if (cRSID.SubTune < cRSID.SIDheader->SubtuneAmount) {
-    if (cRSID.CLImode) {
-     cRSID_nextSubtune();
+void cRSID_autoAdvanceC64 (cRSID_C64instance* C64) {
+ if ( C64->Interface->SubtuneDurations[C64->Interface->SubTune] != 0 && C64->Interface->AutoAdvance
+      && (C64->Interface->SIDheader->SubtuneAmount>1 || C64->Interface->AutoExit || C64->Interface->PlayListSize>1) ) {
+  if (C64->Interface->PlayTime == C64->Interface->SubtuneDurations[C64->Interface->SubTune]) {
+   if (C64->Interface->SubTune < C64->Interface->SIDheader->SubtuneAmount) {
+    if (C64->Interface->CLImode) {
+     cRSID_nextSubtuneC64(C64);
      //#ifndef CRSID_LIBRARY
-      cRSID_callBack_autoAdvance(1);
+      cRSID_callBack_autoAdvance(C64, 1);
      //#endif
     }
-    else cRSID.PlaytimeExpired=1;
+    else C64->Interface->PlaytimeExpired=1;
    }
    #ifdef CRSID_PLATFORM_PC
-   else if (!cRSID.ChangingDirectory) {
-    if (cRSID.PlayListSize<=1 && cRSID.AutoExit) { printf("\n"); cRSID_close(); exit(0); }
-    else if (cRSID.OpenedMusic==0) {
-     if (cRSID.CLImode) {
+   else if (!C64->Interface->ChangingDirectory) {
+    if (C64->Interface->PlayListSize<=1 && C64->Interface->AutoExit) { printf("\n"); cRSID_closeC64(C64); exit(0); }
+    else if (C64->Interface->OpenedMusic==0) {
+     if (C64->Interface->CLImode) {
       cRSID_nextTune();
       //#ifndef CRSID_LIBRARY
-       cRSID_callBack_autoAdvance(0);
+       cRSID_callBack_autoAdvance(C64, 0);
       //#endif
      }
-     else cRSID.PlayListAdvance=1;
+     else C64->Interface->PlayListAdvance=1;
    }}
    #endif
   }
-  else if ( cRSID.FadeOut && cRSID.PlayTime+1 == cRSID.SubtuneDurations[cRSID.SubTune]
-            && cRSID.SubtuneDurations[cRSID.SubTune]>4 ) {
-   cRSID_C64.FadeLevel = 0xF - 0xF * cRSID_C64.SecondCnt / cRSID_C64.SampleRate;
+  else if ( C64->Interface->FadeOut && C64->Interface->PlayTime+1 == C64->Interface->SubtuneDurations[C64->Interface->SubTune]
+            && C64->Interface->SubtuneDurations[C64->Interface->SubTune]>4 ) {
+   C64->FadeLevel = 0xF - 0xF * C64->SecondCnt / C64->SampleRate;
   }
-  else cRSID_C64.FadeLevel=0xF;
+  else C64->FadeLevel=0xF;
  }
- else cRSID_C64.FadeLevel=0xF;
+ else C64->FadeLevel=0xF;
 }
 
 
 
+typedef struct cRSID_C64allocation { //an instance allocated together with its own interface
+ cRSID_C64instance C64; //(first, so the allocation can be freed by its pointer)
+ cRSID_Interface   Interface;
+} cRSID_C64allocation;
+
+cRSID_C64instance* cRSID_newC64 (void) {
+ cRSID_C64allocation* Allocation = (cRSID_C64allocation*) calloc( 1, sizeof(cRSID_C64allocation) );
+ if (Allocation == NULL) return NULL;
+ Allocation->C64.Interface = &Allocation->Interface;
+ return &Allocation->C64;
+}
+
+void cRSID_deleteC64 (cRSID_C64instance* C64) { if (C64 != &cRSID_C64) free( C64 ); }
+
+cRSID_Interface* cRSID_getInterfaceC64 (cRSID_C64instance* C64) { return C64->Interface; }
+
+
+//single-instance API, working on the global instance:
+void* cRSID_init (unsigned short samplerate, unsigned short buflen) { return cRSID_initC64( &cRSID_C64, samplerate, buflen ); }
+cRSID_SIDheader* cRSID_processSIDfileData (unsigned char* filedata, int filesize) { return cRSID_processSIDfileDataC64( &cRSID_C64, filedata, filesize ); }
+void cRSID_initSIDtune (cRSID_SIDheader* SIDheader, char subtune) { cRSID_initSIDtuneC64( &cRSID_C64, SIDheader, subtune ); }
+void cRSID_generateSound (FASTVAR unsigned char *buf, FASTVAR unsigned short len) { cRSID_generateSoundC64( &cRSID_C64, buf, len ); }
+cRSID_Output cRSID_generateSample (void) { return cRSID_generateSampleC64( &cRSID_C64 ); }
+int cRSID_generateSamples (signed short* out_stereo, int frames, signed int* out_voice_planes, int plane_stride) { return cRSID_generateSamplesC64( &cRSID_C64, out_stereo, frames, out_voice_planes, plane_stride ); }
+void cRSID_close (void) { cRSID_closeC64( &cRSID_C64 ); }
+char* cRSID_setSongLengthData (char* filedata) { return cRSID_setSongLengthDataC64( &cRSID_C64, filedata ); }
+unsigned char* cRSID_setKERNALdata (unsigned char* filedata) { return cRSID_setKERNALdataC64( &cRSID_C64, filedata ); }
+unsigned char* cRSID_setBASICdata (unsigned char* filedata) { return cRSID_setBASICdataC64( &cRSID_C64, filedata ); }
+void cRSID_playSIDtune (void) { cRSID_playSIDtuneC64( &cRSID_C64 ); }
+void cRSID_pauseSIDtune (void) { cRSID_pauseSIDtuneC64( &cRSID_C64 ); }
+void cRSID_startSubtune (unsigned char subtune) { cRSID_startSubtuneC64( &cRSID_C64, subtune ); }
+void cRSID_nextSubtune (void) { cRSID_nextSubtuneC64( &cRSID_C64 ); }
+void cRSID_prevSubtune (void) { cRSID_prevSubtuneC64( &cRSID_C64 ); }
+void cRSID_autoAdvance (void) { cRSID_autoAdvanceC64( &cRSID_C64 ); }
+void cRSID_setCallBack__autoAdvance (void (*callback) (char subtunestepping, void* data), void* data) { cRSID_setCallBack__autoAdvanceC64( &cRSID_C64, callback, data ); }
+unsigned short cRSID_getSIDbase (int sid_number) { return cRSID_getSIDbaseC64( &cRSID_C64, sid_number ); }
+unsigned short cRSID_getSIDmodel (int sid_number) { return cRSID_getSIDmodelC64( &cRSID_C64, sid_number ); }
+unsigned short cRSID_setSIDmodel (int sid_number, unsigned short value) { return cRSID_setSIDmodelC64( &cRSID_C64, sid_number, value ); }
+void cRSID_setSIDmodels (void) { cRSID_setSIDmodelsC64( &cRSID_C64 ); }
+unsigned char cRSID_set6581FilterPreset (unsigned char preset) { return cRSID_set6581FilterPresetC64( &cRSID_C64, preset ); }
+unsigned char cRSID_getSIDchannel (int sid_number) { return cRSID_getSIDchannelC64( &cRSID_C64, sid_number ); }
+int cRSID_getSIDlevel (int sid_number) { return cRSID_getSIDlevelC64( &cRSID_C64, sid_number ); }
+int cRSID_getDigiLevel (int sid_number) { return cRSID_getDigiLevelC64( &cRSID_C64, sid_number ); }
+unsigned char cRSID_getVoiceMuteMask (int sid_number) { return cRSID_getVoiceMuteMaskC64( &cRSID_C64, sid_number ); }
+unsigned char cRSID_setVoiceMuteMask (int sid_number, unsigned char mute_mask) { return cRSID_setVoiceMuteMaskC64( &cRSID_C64, sid_number, mute_mask ); }
+void cRSID_getVoiceLevels (int sid_number, signed int* out_voice_levels) { cRSID_getVoiceLevelsC64( &cRSID_C64, sid_number, out_voice_levels ); }
+size_t cRSID_saveState (void* destination, size_t capacity) { return cRSID_saveStateC64( &cRSID_C64, destination, capacity ); }
+char cRSID_loadState (const void* source, size_t size) { return cRSID_loadStateC64( &cRSID_C64, source, size ); }
+
+
+
 #ifdef CRSID_PLATFORM_PC
 
 
@@ -141,6 +141,9 @@ typedef struct cRSID_Output {
 } cRSID_Output;
 
 
+typedef struct cRSID_C64instance cRSID_C64instance; //an emulated C64 with all its playback-state (contents are private, see C64/C64.h)
+
+
 // Main public API functions (mainly in libcRSID.c)
 void*              cRSID_init           (unsigned short samplerate, unsigned short buflen); //init emulation objects and sound
 cRSID_SIDheader* cRSID_processSIDfileData (unsigned char* filedata, int filesize); //in host/file.c, copy SID-data to C64 memory
@@ -148,6 +151,8 @@ void               cRSID_initSIDtune    (cRSID_SIDheader* SIDheader, char subtun
 void               cRSID_generateSound  (FASTVAR unsigned char *buf, FASTVAR unsigned short len);
 void               cRSID_syncGenSamples (int frametime); //if ALSA is initialized, call this periodically, and it emulates and sends samples or waits for the given 'frametime'
 cRSID_Output       cRSID_generateSample (); //in host/audio.c, calculate a single sample
+int                cRSID_generateSamples (signed short* out_stereo, int frames, signed int* out_voice_planes, int plane_stride); //in host/audio.c, calculate a block of interleaved L/R samples,
+                   //optionally with per-voice levels: 4 planes per SID (voices 1..3, digi), plane of SID n voice v starts at ((n-1)*4+v)*plane_stride
 void               cRSID_close          (void); //close sound etc.
 
 char*           cRSID_setSongLengthData (char* filedata);
@@ -175,6 +180,49 @@ unsigned char      cRSID_getVoiceMuteMask (int sid_number); //bit0..3 = muted vo
 unsigned char      cRSID_setVoiceMuteMask (int sid_number, unsigned char mute_mask); //bit0..3 = muted voices 1..3 plus digi for the given SID
 void               cRSID_getVoiceLevels (int sid_number, signed int* out_voice_levels); //per-voice waveform*envelope (3 values written to out_voice_levels)
 
+//Emulation-state snapshots (for keyframe-seeking): the state covers the C64 machine (including resampler/dither histories) and the
+//playback-related interface fields, it is only valid for the same instance, loaded tune, subtune and samplerate.
+size_t             cRSID_getStateSize   (void);
+size_t             cRSID_saveState      (void* destination, size_t capacity); //returns written size or 0 if capacity is too small
+char               cRSID_loadState      (const void* source, size_t size); //returns 1 on success, 0 on size/samplerate/subtune mismatch
+
+//Multi-instance (reentrant) API: the calls above work on the global instance (whose public variables are 'cRSID'),
+//the ...C64() variants below work on the given instance, each having its own cRSID_Interface. Different instances can be
+//emulated from different threads at the same time. (The PC sound-device/playlist/file-loading calls use the global instance.)
+cRSID_C64instance* cRSID_newC64 (void); //allocates an instance, call cRSID_initC64() on it before use (NULL if out of memory)
+void               cRSID_deleteC64 (cRSID_C64instance* C64); //frees an instance got from cRSID_newC64()
+cRSID_Interface*   cRSID_getInterfaceC64 (cRSID_C64instance* C64); //public API variables of the instance (what 'cRSID' is for the global one)
+void*              cRSID_initC64 (cRSID_C64instance* C64, unsigned short samplerate, unsigned short buflen);
+cRSID_SIDheader*   cRSID_processSIDfileDataC64 (cRSID_C64instance* C64, unsigned char* filedata, int filesize);
+void               cRSID_initSIDtuneC64 (cRSID_C64instance* C64, cRSID_SIDheader* SIDheader, char subtune);
+void               cRSID_generateSoundC64 (cRSID_C64instance* C64, FASTVAR unsigned char *buf, FASTVAR unsigned short len);
+cRSID_Output       cRSID_generateSampleC64 (cRSID_C64instance* C64);
+int                cRSID_generateSamplesC64 (cRSID_C64instance* C64, signed short* out_stereo, int frames, signed int* out_voice_planes, int plane_stride);
+void               cRSID_closeC64 (cRSID_C64instance* C64);
+char*              cRSID_setSongLengthDataC64 (cRSID_C64instance* C64, char* filedata);
+unsigned char*     cRSID_setKERNALdataC64 (cRSID_C64instance* C64, unsigned char* filedata);
+unsigned char*     cRSID_setBASICdataC64 (cRSID_C64instance* C64, unsigned char* filedata);
+void               cRSID_playSIDtuneC64 (cRSID_C64instance* C64);
+void               cRSID_pauseSIDtuneC64 (cRSID_C64instance* C64);
+void               cRSID_startSubtuneC64 (cRSID_C64instance* C64, unsigned char subtune);
+void               cRSID_nextSubtuneC64 (cRSID_C64instance* C64);
+void               cRSID_prevSubtuneC64 (cRSID_C64instance* C64);
+void               cRSID_autoAdvanceC64 (cRSID_C64instance* C64);
+void               cRSID_setCallBack__autoAdvanceC64 (cRSID_C64instance* C64, void (*callback) (char subtunestepping, void* data), void* data);
+unsigned short     cRSID_getSIDbaseC64 (cRSID_C64instance* C64, int sid_number);
+unsigned short     cRSID_getSIDmodelC64 (cRSID_C64instance* C64, int sid_number);
+unsigned short     cRSID_setSIDmodelC64 (cRSID_C64instance* C64, int sid_number, unsigned short value);
+void               cRSID_setSIDmodelsC64 (cRSID_C64instance* C64);
+unsigned char      cRSID_set6581FilterPresetC64 (cRSID_C64instance* C64, unsigned char preset);
+unsigned char      cRSID_getSIDchannelC64 (cRSID_C64instance* C64, int sid_number);
+int                cRSID_getSIDlevelC64 (cRSID_C64instance* C64, int sid_number);
+int                cRSID_getDigiLevelC64 (cRSID_C64instance* C64, int sid_number);
+unsigned char      cRSID_getVoiceMuteMaskC64 (cRSID_C64instance* C64, int sid_number);
+unsigned char      cRSID_setVoiceMuteMaskC64 (cRSID_C64instance* C64, int sid_number, unsigned char mute_mask);
+void               cRSID_getVoiceLevelsC64 (cRSID_C64instance* C64, int sid_number, signed int* out_voice_levels);
+size_t             cRSID_saveStateC64 (cRSID_C64instance* C64, void* destination, size_t capacity);
+char               cRSID_loadStateC64 (cRSID_C64instance* C64, const void* source, size_t size);
+
 #ifdef CRSID_PLATFORM_PC
 cRSID_SIDheader*   cRSID_playSIDfile    (char* filename, char subtune); //simple single-call SID playback
 cRSID_SIDheader*   cRSID_loadSIDtune    (char* filename); //load and process SID-filedata to C64 memory
@@ -42,6 +42,7 @@
 
 #include "emu68/assert68.h"
 #include <sc68/file68_msg.h>
+#include <string.h>
 
 #ifndef DEBUG_MW_O
 # define DEBUG_MW_O 0
@@ -407,6 +408,7 @@ int mw_setup(mw_t * const mw,
   /* setup memory access */
   mw->mem     = setup->mem;
   mw->log2mem = setup->log2mem;
+  mw->tap     = 0;
   mw->ct_fix  = ( sizeof(mwct_t) << 3 ) - mw->log2mem;
 
   TRACE68(mw_cat, MWHD "%d-bit memory, %d-bit precision\n",
@@ -520,6 +522,7 @@ static void mix_ste(mw_t * const mw, s32 *b, int n)
   const int68_t ym_mult = (mw->db_conv == Db_alone) ? 0 : MW_YM_MULT;
   const int      ct_fix = mw->ct_fix;
   const s8 *        spl = (const s8 *)mw->mem;
+  s16 *             tap = mw->tap;
 
   /* Get internal register for sample base and sample end
    * $$$ ??? what if base > end2 ???
@@ -562,6 +565,8 @@ static void mix_ste(mw_t * const mw, s32 *b, int n)
           +
           (((v*vr + ym)>>MW_MIX_FIX)<<16)
           );
+      if (tap)
+        *tap++ = (v*(vl+vr)) >> (MW_MIX_FIX+1);
 
       ct += stp;
       if (ct >= end) {
@@ -596,6 +601,8 @@ static void mix_ste(mw_t * const mw, s32 *b, int n)
           +
           (((r*vr + ym)>>MW_MIX_FIX)<<16)
           );
+      if (tap)
+        *tap++ = (l*vl + r*vr) >> (MW_MIX_FIX+1);
 
       ct += stp;
       if (ct >= end) {
@@ -640,6 +647,10 @@ void mw_mix(mw_t * const mw, s32 * b, int n)
   if ( n <= 0 ) {
     return;
   }
+  if ( b && mw->tap ) {
+    /* Silent unless mix_ste() has DMA samples for it. */
+    memset(mw->tap, 0, n * sizeof(*mw->tap));
+  }
   if ( !b ) {
     if ( mw->map[MW_ACTI] & 1 ) {
       /* no buffer and active : advance counters only */
@@ -188,6 +188,7 @@ typedef struct {
   int ct_fix;         /**< fixed point for automatic memory modulo. */
   const u8 * mem;     /**< 68000 memory buffer.                     */
   int log2mem;        /**< Size of 68K memory (2^log2mem).          */
+  s16 * tap;          /**< DMA sound output plane (0:off).          */
 
 } mw_t;
 
@@ -305,7 +306,8 @@ IO68_EXTERN
  *   emulator to honnor the LMC mixer mode.iven LMC mode. This
  *   porocess include the mono to stereo expansion. The mem68 starting
  *   pointer locates the 68K memory buffer where samples are stored to
- *   allow DMA fetch emulation.
+ *   allow DMA fetch emulation. If mw_t::tap is set the DMA sound alone
+ *   (mono, before the YM-2149 blend) is also written there.
  *
  * @param  mw     microwire instance
  * @param  out    pointer to YM-2149 source sample directly used for
@@ -34,6 +34,15 @@
 #include <sc68/file68_msg.h>
 #include <sc68/file68_opt.h>
 #include <sc68/file68_str.h>
+#include <string.h>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+# include <arm_neon.h>
+# define PAULA_NEON 1
+#elif defined(__SSE2__)
+# include <emmintrin.h>
+# define PAULA_SSE 1
+#endif
 
 #ifndef DEBUG_PL_O
 # define DEBUG_PL_O 0
@@ -48,6 +57,7 @@ static paula_parms_t default_parms;
 
 static int msw_first = 0;	    /* big/little endian compliance */
 static int pl_chans  = 15;	    /* active channels */
+static int pl_block  = 1;	    /* 0: per-sample reference mixer */
 
 static int onchange_filter(const option68_t * opt, value68_t * val)
 {
@@ -67,6 +77,12 @@ static int onchange_chans(const option68_t * opt, value68_t * val)
   return 0;
 }
 
+static int onchange_block(const option68_t * opt, value68_t * val)
+{
+  pl_block = !!val->num;
+  return 0;
+}
+
 static const char * f_clock[] = { "pal","ntsc" };
 
 /* Command line options */
@@ -84,6 +100,9 @@ static option68_t opts[] = {
   OPT68_IRNG(prefix,"amiga-chans",engcat,
 	     "set active paula channels {bit#0-3 = chan#A-C}",
 	     0,15,0,onchange_chans),
+  OPT68_BOOL(prefix,"amiga-block",engcat,
+	     "vector block mixer (0: per-sample reference)",
+	     0,onchange_block),
 };
 #undef prefix
 
@@ -117,6 +136,7 @@ int paula_init(int * argc, char ** argv)
   option68_iset(opts+1, 0x50, opt68_NOTSET, opt68_CFG);
   option68_iset(opts+2, default_parms.clock!=PAULA_CLOCK_PAL,
 		opt68_NOTSET,opt68_CFG);
+  option68_iset(opts+4, pl_block, opt68_NOTSET, opt68_CFG);
 
   /* Parse options */
   *argc = option68_parse(*argc,argv);
@@ -315,6 +335,7 @@ int paula_setup(paula_t * const paula,
   }
 
   paula->chansptr = &pl_chans;
+  paula->tap[0]	  = paula->tap[1] = paula->tap[2] = paula->tap[3] = 0;
   paula->mem	  = setup->mem;
   paula->log2mem  = setup->log2mem;
   paula->ct_fix	  = ( sizeof(plct_t) << 3 ) - paula->log2mem;
@@ -359,6 +380,48 @@ static void poll_irq(paula_t * const paula, unsigned int N)
 }
 #endif
 
+/* Voice registers as read at the start of a mix. */
+typedef struct {
+  plct_t stp;		  /**< sample counter step.           */
+  plct_t readr;		  /**< loop start (<<paula_t::ct_fix). */
+  plct_t reend;		  /**< loop end (<<paula_t::ct_fix).   */
+  int	 vol;		  /**< volume [0..128].               */
+} plregs_t;
+
+/* Returns 0 if the registers do not describe a playable loop. */
+static int voice_regs(const paula_t * const paula, const u8 * const p,
+		      plregs_t * const r)
+{
+  const int ct_fix = paula->ct_fix;
+  plct_t per;
+
+  /* $$$ FIXME
+   * Dunno exactly what if volume is not in proper range [0..64]
+   */
+  r->vol = p[9];
+  if (r->vol >= 64)
+    r->vol = 64;
+  r->vol <<= 1;
+
+  per = ( p[6] << 8 ) + p[7];
+  if (!per) per = 1;			/* or is it +1 for all ?? */
+  r->stp = paula->clkperspl / per;
+
+  /* Audio irq disable for this voice :
+   * Internal will be reload at end of block
+   */
+  r->readr   = ( p[1] << 16 ) | ( p[2] << 8 ) | ( p[3] & 0xFE );
+  r->readr <<= ct_fix;
+  r->reend   = ((p[4] << 8) | p[5]);
+  r->reend  |= (!r->reend) << 16;     /* 0 is 0x10000 */
+  r->reend <<= (1 + ct_fix);	      /* +1 as unit is 16-bit word */
+  r->reend  += r->readr;
+  assert( r->reend > r->readr );
+  /* $$$ ??? dunno why I did this !!! May be could happen on a
+   * modulo. */
+  return r->reend > r->readr;
+}
+
 /* Mix with laudio channel data (1 char instead of 2) */
 
 static void mix_one(paula_t * const paula,
@@ -369,8 +432,10 @@ static void mix_one(paula_t * const paula,
   paulav_t * const w   = paula->voice+N;
   u8	   * const p   = paula->map+PAULA_VOICE(N);
   s16	   *	   b2  = (s16 *)b + shift;
+  s16	   *	   tap = paula->tap[N];
   const int	ct_fix = paula->ct_fix;
-  plct_t adr, stp, readr, reend, end, vol, per;
+  plct_t adr, stp, readr, reend, end, vol;
+  plregs_t regs;
   u8 last, hasloop;
 
   /* Mask to get the fractionnal part of the sample counter. Therefore
@@ -385,33 +450,12 @@ static void mix_one(paula_t * const paula,
 
   hasloop = 0;
 
-  /* $$$ FIXME
-   * Dunno exactly what if volume is not in proper range [0..64]
-   */
-  vol = p[9];
-  if (vol >= 64)
-    vol = 64;
-  vol <<= 1;
-
-  per = ( p[6] << 8 ) + p[7];
-  if (!per) per = 1;			/* or is it +1 for all ?? */
-  stp = paula->clkperspl / per;
-
-  /* Audio irq disable for this voice :
-   * Internal will be reload at end of block
-   */
-  readr	  = ( p[1] << 16 ) | ( p[2] << 8 ) | ( p[3] & 0xFE );
-  readr <<= ct_fix;
-  reend	  = ((p[4] << 8) | p[5]);
-  reend	 |= (!reend) << 16;	      /* 0 is 0x10000 */
-  reend <<= (1 + ct_fix);	      /* +1 as unit is 16-bit word */
-  reend	 += readr;
-  assert( reend > readr );
-  if (reend <= readr) {
-    /* $$$ ??? dunno why I did this !!! May be could happen on a
-     * modulo. */
+  if (!voice_regs(paula, p, &regs))
     return;
-  }
+  vol	= regs.vol;
+  stp	= regs.stp;
+  readr = regs.readr;
+  reend = regs.reend;
 
   adr = w->adr;
   end = w->end;
@@ -444,6 +488,8 @@ static void mix_one(paula_t * const paula,
     /* Store and advance output buffer */
     *b2 += v0;
     b2	+= 2;
+    if (tap)
+      *tap++ = v0;
 
     /* Advance */
     adr += stp;
@@ -467,6 +513,140 @@ static void mix_one(paula_t * const paula,
   }
 }
 
+/* ,-----------------------------------------------------------------.
+ * |                        Block mixer                              |
+ * `-----------------------------------------------------------------'
+ *
+ * Same output as mix_one() in two passes: each voice is first
+ * stepped through its sample into its own 16-bit plane (the voice tap
+ * when there is one), then mix_planes() sums the planes into the
+ * stereo buffer 8 frames per vector op.
+ */
+
+#define PL_BLOCK 256			/* frames per pass */
+
+/* Advance the sample counter, wrapping into the loop as mix_one(). */
+#define PL_STEP() do {						\
+    adr += r.stp;						\
+    if (adr >= end) {						\
+      hasloop = 1;						\
+      adr = r.readr + adr - end;				\
+      end = r.reend;						\
+      while (adr >= end) {					\
+	adr -= r.reend - r.readr;				\
+      }								\
+    }								\
+  } while (0)
+
+static void fetch_one(paula_t * const paula, int N, s16 * out, int n)
+{
+  const u8 * const mem = paula->mem;
+  paulav_t * const w   = paula->voice+N;
+  u8	   * const p   = paula->map+PAULA_VOICE(N);
+  const int	ct_fix = paula->ct_fix;
+  plct_t adr, end;
+  plregs_t r;
+  u8 last, hasloop;
+
+  adr = w->adr;
+  end = w->end;
+  if (!voice_regs(paula, p, &r) || end <= adr) {
+    memset(out, 0, n * sizeof(*out));
+    return;
+  }
+  hasloop = 0;
+
+  if (paula->engine == PAULA_ENGINE_LINEAR) {
+    const plct_t imask = ( (plct_t) 1 << ct_fix ) - 1;
+    do {
+      int idx = adr >> ct_fix;
+      const signed_plct_t v0 = (s8) (last = mem[idx++]);
+      signed_plct_t v1;
+      if ( ( (plct_t) idx << ct_fix ) >= end )
+	idx = r.readr >> ct_fix;
+      v1 = (s8) mem[idx];
+      /* mix_one() interpolation, with v0*one taken out of the shift */
+      *out++ = ( v0 + ( ( (v1 - v0) * (signed_plct_t) (adr & imask) )
+			>> ct_fix ) ) * r.vol;
+      PL_STEP();
+    } while (--n);
+  } else {
+    do {
+      last = mem[adr >> ct_fix];
+      *out++ = (s8) last * r.vol;
+      PL_STEP();
+    } while (--n);
+  }
+
+  p[0xA] = last;
+  w->adr = adr;
+  if (hasloop) {
+    w->start = r.readr;
+    w->end   = end;
+  }
+}
+
+#undef PL_STEP
+
+/* Stereo frame i gets lo[0][i]+lo[1][i] in its first 16-bit half and
+ * hi[0][i]+hi[1][i] in the second. Two voices never exceed 16 bits. */
+static void mix_planes(s32 * b, const s16 * const * lo,
+		       const s16 * const * hi, const int n)
+{
+  s16 * const d = (s16 *) b;
+  int i = 0;
+#if defined(PAULA_NEON)
+  for (; i + 8 <= n; i += 8) {
+    int16x8x2_t v;
+    v.val[0] = vaddq_s16(vld1q_s16(lo[0] + i), vld1q_s16(lo[1] + i));
+    v.val[1] = vaddq_s16(vld1q_s16(hi[0] + i), vld1q_s16(hi[1] + i));
+    vst2q_s16(d + 2*i, v);
+  }
+#elif defined(PAULA_SSE)
+  for (; i + 8 <= n; i += 8) {
+    const __m128i l =
+      _mm_add_epi16(_mm_loadu_si128((const __m128i *) (lo[0] + i)),
+		    _mm_loadu_si128((const __m128i *) (lo[1] + i)));
+    const __m128i h =
+      _mm_add_epi16(_mm_loadu_si128((const __m128i *) (hi[0] + i)),
+		    _mm_loadu_si128((const __m128i *) (hi[1] + i)));
+    _mm_storeu_si128((__m128i *) (d + 2*i), _mm_unpacklo_epi16(l, h));
+    _mm_storeu_si128((__m128i *) (d + 2*i + 8), _mm_unpackhi_epi16(l, h));
+  }
+#endif
+  for (; i < n; ++i) {
+    d[2*i+0] = lo[0][i] + lo[1][i];
+    d[2*i+1] = hi[0][i] + hi[1][i];
+  }
+}
+
+static void mix_block(paula_t * const paula, s32 * b, int n,
+		      const int pl_mask)
+{
+  static const s16 silence[PL_BLOCK];
+  s16 planes[4][PL_BLOCK];
+  int off;
+
+  for (off = 0; off < n; off += PL_BLOCK) {
+    const int m = n - off < PL_BLOCK ? n - off : PL_BLOCK;
+    const s16 * half[2][2];
+    int i, k[2] = { 0, 0 };
+
+    for (i=0; i<4; i++) {
+      const int right = (i^(i>>1)^msw_first)&1;
+      s16 * const tap = paula->tap[i] ? paula->tap[i] + off : 0;
+      const s16 * plane = tap ? tap : silence; /* taps are cleared */
+      if ((paula->dmacon >> 9) & ( (pl_mask & paula->dmacon) >> i) & 1) {
+	s16 * const dst = tap ? tap : planes[i];
+	fetch_one(paula, i, dst, m);
+	plane = dst;
+      }
+      half[right][k[right]++] = plane;
+    }
+    mix_planes(b + off, half[0], half[1], m);
+  }
+}
+
 /* ,-----------------------------------------------------------------.
  * |                        Paula process                            |
  * `-----------------------------------------------------------------'
@@ -522,16 +702,25 @@ void paula_mix(paula_t * const paula, s32 * splbuf, int n)
 #if DEBUG_PL_O == 1
     paulav_dbg_t d[4];
 #endif
-    clear_buffer(splbuf, n);
     for (i=0; i<4; i++) {
-      /* $$$ VERIFY: channel mapping ABCD => LRRL ? */
-      const int right = (i^(i>>1)^msw_first)&1;
+      /* Voices skipped below (or stopping early) leave a silent tap. */
+      if (paula->tap[i])
+	memset(paula->tap[i], 0, n * sizeof(*paula->tap[i]));
 #if DEBUG_PL_O == 1
       paula_dbg(d+i, paula, i);
 #endif
-      if ((paula->dmacon >> 9) & ( (pl_mask & paula->dmacon) >> i) & 1) {
-	mix_one(paula, i, right, splbuf, n);
-	b += 1 << i;
+    }
+    if (pl_block) {
+      mix_block(paula, splbuf, n, pl_mask);
+    } else {
+      clear_buffer(splbuf, n);
+      for (i=0; i<4; i++) {
+	/* $$$ VERIFY: channel mapping ABCD => LRRL ? */
+	const int right = (i^(i>>1)^msw_first)&1;
+	if ((paula->dmacon >> 9) & ( (pl_mask & paula->dmacon) >> i) & 1) {
+	  mix_one(paula, i, right, splbuf, n);
+	  b += 1 << i;
+	}
       }
     }
 
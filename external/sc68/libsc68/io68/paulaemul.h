@@ -226,6 +226,7 @@ typedef struct {
   int	   intreq;     /**< Shadow INTREQ. */
   int	   adkcon;     /**< Shadow ADKCON. */
   int	   vhpos;      /**< Shadow VHPOSR. */
+  s16	 * tap[4];     /**< Per-voice output planes (0:off).     */
 } paula_t;
 
 /**
@@ -393,7 +394,8 @@ IO68_EXTERN
  *   is a pointer to the 68K memory buffer. The Paula emulator assume
  *   that this buffer is at least the size of the Amiga "chip"
  *   RAM. This implies at leat 512Kb and PCM data must be in the first
- *   512Kb.
+ *   512Kb. Voices with a paula_t::tap plane set are also written
+ *   there alone (n samples, silent when the voice is off).
  *
  * @param  paula   Paula emulator instance
  * @param  splbuf  Destination 32-bit sample buffer
@@ -156,14 +156,19 @@ static void ym2149_new_output_level(ym_t * const ym)
 
   u16 dacstate = 0;
   for (i = 0; i < 3; i ++) {
+    u16 mask;
     if ((active_mask & (1u << i)) == 0u) {
+      blep->voice_level[i] = (ym->ymout5[0] + 1) >> 1;
       continue;
     }
-    u16 mask = blep->tonegen[i].tonemix | blep->tonegen[i].flip_flop;
+    mask = blep->tonegen[i].tonemix | blep->tonegen[i].flip_flop;
     mask &= blep->tonegen[i].noisemix | blep->noise_output;
-    dacstate |= mask &
+    mask &=
       ((blep->env_output & blep->tonegen[i].envmask)
        | blep->tonegen[i].volmask);
+    dacstate |= mask;
+    /* Voice masks do not overlap: this voice alone is its own index. */
+    blep->voice_level[i] = (ym->ymout5[mask] + 1) >> 1;
   }
 
   assert( (dacstate & 0x7fff) == dacstate );
@@ -298,6 +303,7 @@ static int mix_to_buffer(ym_t * const ym, cycle68_t cycles, s32 *output)
   ym_blep_t *blep = &ym->emu.blep;
 
   u32 len = 0;
+  int i;
   while (cycles) {
     cycle68_t iter = cycles;
     u8 makesample = 0;
@@ -315,6 +321,12 @@ static int mix_to_buffer(ym_t * const ym, cycle68_t cycles, s32 *output)
      * To improve accuracy, we interpolate the sinc table. */
     if (makesample) {
       assert(blep->cycles_to_next_sample <= 0xff);
+      if (ym->voice_tap[0] || ym->voice_tap[1] || ym->voice_tap[2]) {
+        const int idx = output + len - ym->outbuf;
+        for (i = 0; i < 3; ++i)
+          if (ym->voice_tap[i])
+            ym->voice_tap[i][idx] = blep->voice_level[i];
+      }
       output[len++] =
         highpass(ym, ym2149_output(ym, blep->cycles_to_next_sample));
       assert(len < MAX_MIXBUF);
@@ -332,6 +344,9 @@ static int run(ym_t * const ym, s32 * output, const cycle68_t ymcycles)
   u32 len = 0, voice;
   s32 newevent;
 
+  /* Voice taps are indexed from the start of this run. */
+  ym->outbuf = output;
+
   /*
    * Channel mute can change between two runs without any YM register write.
    * Recompute baseline level so mute/unmute takes effect immediately.
@@ -79,6 +79,7 @@ typedef struct {
 
   /* blep stuff */
   s16 global_output_level;              /**< @nodoc */
+  s16 voice_level[3];         /**< Per-voice level for ym_t::voice_tap. */
   u32 blep_idx;                         /**< @nodoc */
   u16 time;                             /**< @nodoc */
   s32 hp;                               /**< @nodoc */
@@ -102,6 +102,7 @@ static const char * f_names[] = {
 };
 static const int n_filters = sizeof(filters)/sizeof(*filters);
 static int default_filter = 0;
+static int run_length = 1;      /* 0: per-tick reference generator */
 
 #define PULS ym->emu.puls
 
@@ -154,6 +155,13 @@ static int reset(ym_t * const ym, const cycle68_t ymcycle)
  */
 
 
+/* Output level of the current generator state. */
+#define LEVEL()                                                         \
+  ( (PULS.levels | smsk)                          /* Apply tone.   */   \
+    & (nbit | nmsk)                               /* Apply noise.  */   \
+    & ((waveform[PULS.envel_idx]&emsk) | vols)    /* Apply volume. */   \
+    & ym->voice_mute )                            /* Apply mute.   */
+
 static int generator(ym_t  * const ym, int ymcycles)
 {
   const u16 * waveform = ym_envelops[15 & ym->reg.name.env_shape];
@@ -213,6 +221,32 @@ static int generator(ym_t  * const ym, int ymcycles)
   do {
     int sq;
 
+    if (run_length) {
+      /* No counter expires during the next run-1 ticks, they all
+       * output the level of the current state: fill them at once. */
+      int run = PULS.noise_ct;
+      if (run > PULS.envel_ct)  run = PULS.envel_ct;
+      if (run > PULS.voice_ctA) run = PULS.voice_ctA;
+      if (run > PULS.voice_ctB) run = PULS.voice_ctB;
+      if (run > PULS.voice_ctC) run = PULS.voice_ctC;
+      if (--run > 0) {
+        if (run > ymcycles)
+          run = ymcycles;
+        sq = LEVEL();
+        PULS.noise_ct  -= run;
+        PULS.envel_ct  -= run;
+        PULS.voice_ctA -= run;
+        PULS.voice_ctB -= run;
+        PULS.voice_ctC -= run;
+        ymcycles       -= run;
+        do {
+          *ym->outptr++ = sq;
+        } while (--run);
+        if (!ymcycles)
+          break;
+      }
+    }
+
     if (--PULS.noise_ct <= 0) {
       PULS.noise_ct = perN;
       /*
@@ -250,10 +284,7 @@ static int generator(ym_t  * const ym, int ymcycles)
       PULS.voice_ctC = perC;
     }
 
-    sq  = PULS.levels | smsk;                     /* Apply tone. */
-    sq &= nbit | nmsk;                            /* Apply noise. */
-    sq &= (waveform[PULS.envel_idx]&emsk) | vols; /* Apply volume. */
-    sq &= ym->voice_mute;                         /* Apply mute. */
+    sq = LEVEL();
     *ym->outptr++ = sq;
 
   } while (--ymcycles);
@@ -262,6 +293,8 @@ finish:
   return rem_cycles;
 }
 
+#undef LEVEL
+
 
 static void simulation(ym_t * const ym, cycle68_t ymcycle)
 {
@@ -692,18 +725,61 @@ static void filter_2pole(ym_t * const ym)
   }
 }
 
+/* Pick each voice alone out of the raw 250kHz levels (filters work in
+ * place, so this runs before them) at the rate the filter resamples to.
+ * Returns the number of samples written per plane. */
+static int voice_taps(ym_t * const ym)
+{
+  static const int msk[3] = { YM_OUT_MSK_A, YM_OUT_MSK_B, YM_OUT_MSK_C };
+  const s32 * const src = ym->outbuf;
+  const int n = ym->outptr - ym->outbuf;
+  const int68_t stp =
+    (filters[PULS.ifilter].filter == filter_dacout)
+    ? (1 << 14)
+    : (int68_t) ((ym->clock >> 3) << 14) / ym->hz;
+  int i, m = 0;
+
+  if (n <= 0 || stp <= 0)
+    return 0;
+
+  for (i = 0; i < 3; ++i) {
+    s16 * const tap = ym->voice_tap[i];
+    int68_t idx;
+    if (!tap)
+      continue;
+    for (m = 0, idx = 0; m < n && (int)(idx >> 14) < n; ++m, idx += stp)
+      tap[m] = REVOL(YMOUT(src[(int)(idx >> 14)] & msk[i]));
+  }
+  return m;
+}
+
 static
 int run(ym_t * const ym, s32 * output, const cycle68_t ymcycles)
 {
+  int taps = 0, n, i;
+
   /* set pointers */
   ym->outbuf = ym->outptr = output;
 
   /* run the simulation */
   simulation(ym,ymcycles);
 
+  if (ym->voice_tap[0] || ym->voice_tap[1] || ym->voice_tap[2])
+    taps = voice_taps(ym);
+
   /* post processing (filters, resample ...) */
   filters[ym->emu.puls.ifilter].filter(ym);
 
+  /* Filters may round the output length differently: pad the taps. */
+  n = ym->outptr - ym->outbuf;
+  for (i = 0; taps > 0 && i < 3; ++i) {
+    s16 * const tap = ym->voice_tap[i];
+    int j;
+    if (tap)
+      for (j = taps; j < n; ++j)
+        tap[j] = tap[taps-1];
+  }
+
   /* reset event list. */
   ym->event_ptr = ym->event_buf;
 
@@ -749,6 +825,12 @@ static int onchange_filter(const option68_t * opt, value68_t * val)
   return -1;
 }
 
+static int onchange_block(const option68_t * opt, value68_t * val)
+{
+  run_length = !!val->num;
+  return 0;
+}
+
 /* command line options option */
 /* static const char prefix[] = "sc68-"; */
 #define prefix 0
@@ -756,7 +838,10 @@ static const char engcat[] = "ym-puls";
 static option68_t opts[] = {
   OPT68_ENUM(prefix,"ym-filter",engcat,
              "set ym-2149 filter (pulse only)",
-             f_names,sizeof(f_names)/sizeof(*f_names),1,onchange_filter)
+             f_names,sizeof(f_names)/sizeof(*f_names),1,onchange_filter),
+  OPT68_BOOL(prefix,"ym-block",engcat,
+             "fill steady generator runs at once (0: per-tick reference)",
+             0,onchange_block)
 };
 
 #undef prefix
@@ -770,4 +855,5 @@ void ym_puls_add_options(void)
 
   /* Default option values */
   option68_iset(opts+0, default_filter, opt68_NOTSET, opt68_CFG);
+  option68_iset(opts+1, run_length, opt68_NOTSET, opt68_CFG);
 }
@@ -244,8 +244,32 @@ void ym_shutdown(void)
  * |                         Run emulation                           |
  * `-----------------------------------------------------------------'
  */
+
+/* Engines write raw DAC levels to the voice taps; remove the DC they
+ * carry the same way the blep engine does for the mixed output. */
+static void voice_taps_dcblock(ym_t * const ym, const int n)
+{
+  int i, j;
+
+  for (i = 0; i < 3; ++i) {
+    s16 * const tap = ym->voice_tap[i];
+    s32 hp = ym->voice_tap_hp[i];
+    if (!tap)
+      continue;
+    for (j = 0; j < n; ++j) {
+      s32 v = tap[j];
+      hp = (hp * 511 + (v << 6) + (1 << 8)) >> 9;
+      v -= (hp + (1 << 5)) >> 6;
+      tap[j] = v < -32768 ? -32768 : ( v > 32767 ? 32767 : v );
+    }
+    ym->voice_tap_hp[i] = hp;
+  }
+}
+
 int ym_run(ym_t * const ym, s32 * output, const cycle68_t ymcycles)
 {
+  int n;
+
   if (!ymcycles) {
     return 0;
   }
@@ -259,7 +283,19 @@ int ym_run(ym_t * const ym, s32 * output, const cycle68_t ymcycles)
     return -1;
   }
 
-  return ym->cb_run(ym,output,ymcycles);
+  n = ym->cb_run(ym,output,ymcycles);
+
+  if (n > 0 && (ym->voice_tap[0] || ym->voice_tap[1] || ym->voice_tap[2])) {
+    if (ym->engine == YM_ENGINE_DUMP) {
+      int i;
+      for (i = 0; i < 3; ++i)
+        if (ym->voice_tap[i])
+          memset(ym->voice_tap[i], 0, n * sizeof(*ym->voice_tap[i]));
+    } else {
+      voice_taps_dcblock(ym, n);
+    }
+  }
+  return n;
 }
 
 
@@ -552,6 +588,8 @@ int ym_setup(ym_t * const ym, ym_parms_t * const parms)
     ym->ymout5      = ymout5;
     ym->clock       = p->clock;
     ym->voice_mute  = ym_smsk_table[7 & ym_default_chans];
+    memset(ym->voice_tap, 0, sizeof(ym->voice_tap));
+    memset(ym->voice_tap_hp, 0, sizeof(ym->voice_tap_hp));
     /* clearing sampling rate callback ensure requested rate to be in
        valid range. */
     ym->cb_sampling_rate = 0;
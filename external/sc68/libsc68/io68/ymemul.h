@@ -214,6 +214,21 @@ struct ym_s {
    * @}
    */
 
+  /**
+   * @name  Per-voice taps
+   *
+   *  When set, ym_run() also writes each voice alone (after muting,
+   *  before the DAC mix) at the output rate, one sample per output
+   *  sample. Planes must hold as many samples as the output buffer.
+   *
+   * @{
+   */
+  s16 * voice_tap[3];       /**< Voice A/B/C output planes (0:off).      */
+  s32   voice_tap_hp[3];    /**< Per-voice DC blocker state.             */
+  /**
+   * @}
+   */
+
   int engine;               /**< @ref ym_engine_e "engine type". */
   int volmodel;             /**< @ref ym_vol_e "volume model".   */
 
@@ -286,6 +286,22 @@ typedef struct {
   sc68_scope_channel_t channels[SC68_SCOPE_MAX_CHANNELS];
 } sc68_scope_snapshot_t;
 
+/**
+ * SC68 per-voice output taps.
+ *
+ *  Installed with SC68_SET_VOICE_TAPS, it makes sc68_process() also
+ *  write every voice alone (mono 16-bit, pre-mix, same frames as the
+ *  returned PCM) from the running emulation. Voices follow the
+ *  sc68_get_scope_snapshot() channel order: YM A/B/C then STE DMA, or
+ *  Paula 0-3 for Amiga tunes. Muted voices are silent.
+ */
+typedef struct {
+  int16_t * planes[SC68_SCOPE_MAX_CHANNELS]; /**< In: voice planes (0:skip). */
+  int       capacity;      /**< In: size of each plane in samples.        */
+  int       channels;      /**< Out: voices of the last sc68_process().   */
+  int       frames;        /**< Out: samples written per plane by it.     */
+} sc68_voice_taps_t;
+
 /**
  * Flags returned eturn codeby the sc68_process() functions.
  */
@@ -379,6 +395,7 @@ enum sc68_cntl_e {
   SC68_SET_OPT_STR,  /**< Set options (string).     */
   SC68_SET_OPT_INT,  /**< Set options (integer).    */
   SC68_DIAL,         /**< Run a dialog.             */
+  SC68_SET_VOICE_TAPS, /**< Set sc68_voice_taps_t (0:off). */
 
   /* Always last */
   SC68_CNTL_LAST     /**< Last command #.           */
@@ -107,6 +107,8 @@ enum {
   CFG_LOOP_OFF = 0,
   /* Option "force-loop" infinite */
   CFG_LOOP_INF = -1,
+  /* Voice tap planes (YM A/B/C + STE, or Paula 0-3) */
+  TAPS_MAX = 4,
 };
 
 /* Hardware table */
@@ -236,6 +238,15 @@ struct _sc68_s {
 
   } mix;
 
+/** Per-voice output taps (see sc68_voice_taps_t). */
+  struct
+  {
+    sc68_voice_taps_t * dest;	 /**< Caller planes (0:off).             */
+    s16		 * buffer;	 /**< TAPS_MAX planes, mix buffer sized. */
+    int		   bufmax;	 /**< Allocated samples per plane.       */
+    int		   channels;	 /**< Voices tapped in the mix buffer.   */
+  } taps;
+
   sc68_minfo_t	   info;	 /**< Disk and track info struct.        */
 
 /* Error message */
@@ -460,6 +471,8 @@ static unsigned int calc_track_len(const disk68_t * d, int track, int loop);
 static unsigned int calc_pos(sc68_t * const sc68);
 static void music_info(sc68_t * sc68, sc68_music_info_t * f,
 		       const disk68_t * d, int track, int loops);
+static int taps_alloc(sc68_t * sc68);
+static void taps_connect(sc68_t * sc68);
 
 /***********************************************************************
  * Check functions
@@ -1413,6 +1426,7 @@ void sc68_destroy(sc68_t * sc68)
 {
   if (is_sc68(sc68)) {
     free(sc68->mix.buffer);
+    free(sc68->taps.buffer);
     sc68_close(sc68);
     safe_destroy(sc68);
     sc68_debug(sc68,"libsc68: sc68<%s> destroyed\n", sc68->name);
@@ -2033,6 +2047,8 @@ static int change_track(sc68_t * sc68, int track)
       }
       sc68->mix.bufmax = sc68->mix.bufreq;
     }
+    if (taps_alloc(sc68))
+      return SC68_ERROR;
   }
   TRACE68(sc68_cat," -> buffer length -- %u pcm\n", sc68->mix.bufreq);
 
@@ -2098,6 +2114,108 @@ static int apply_change_track(sc68_t * const sc68)
   return SC68_CHANGE;
 }
 
+/* Number of voices tapped for the current track, in
+ * sc68_get_scope_snapshot() order. */
+static int taps_channels(const sc68_t * sc68)
+{
+  int n = 0;
+  if (!sc68->mus)
+    return 0;
+  if (sc68->mus->hwflags & SC68_AGA)
+    return sc68->paula ? 4 : 0;
+  if ((sc68->mus->hwflags & SC68_PSG) && sc68->ym)
+    n += 3;
+  if ((sc68->mus->hwflags & (SC68_DMA|SC68_LMC)) && sc68->mw)
+    n += 1;
+  return n;
+}
+
+/* Grow tap planes along with the mix buffer (only while enabled). */
+static int taps_alloc(sc68_t * sc68)
+{
+  if (sc68->taps.dest && sc68->taps.bufmax < sc68->mix.bufmax) {
+    free(sc68->taps.buffer);
+    sc68->taps.bufmax = 0;
+    sc68->taps.buffer =
+      calloc((size_t)sc68->mix.bufmax * TAPS_MAX, sizeof(s16));
+    if (!sc68->taps.buffer) {
+      error_add(sc68,"libsc68: %s\n", strerror(errno));
+      return SC68_ERROR;
+    }
+    sc68->taps.bufmax = sc68->mix.bufmax;
+  }
+  return 0;
+}
+
+/* Point the chip emulators at the tap planes for the next pass, or
+ * detach them when taps are off. */
+static void taps_connect(sc68_t * sc68)
+{
+  s16 * plane[TAPS_MAX] = { 0, 0, 0, 0 };
+  const int on = sc68->taps.dest && sc68->taps.buffer && sc68->mus;
+  const int aga = on && (sc68->mus->hwflags & SC68_AGA);
+  int i, n = 0;
+
+  if (on)
+    for (i = 0; i < TAPS_MAX; ++i)
+      plane[i] = sc68->taps.buffer + i * sc68->taps.bufmax;
+
+  if (sc68->paula)
+    for (i = 0; i < 4; ++i)
+      sc68->paula->tap[i] = aga ? plane[i] : 0;
+  if (sc68->ym) {
+    const int psg = on && !aga && (sc68->mus->hwflags & SC68_PSG);
+    for (i = 0; i < 3; ++i)
+      sc68->ym->voice_tap[i] = psg ? plane[i] : 0;
+    n += psg ? 3 : 0;
+  }
+  if (sc68->mw)
+    sc68->mw->tap = (on && !aga) ? plane[n] : 0;
+
+  sc68->taps.channels = on ? taps_channels(sc68) : 0;
+}
+
+/* Copy len tapped samples at the current mix position. */
+static void taps_copy(sc68_t * sc68, const int len)
+{
+  sc68_voice_taps_t * const dest = sc68->taps.dest;
+  const int room = dest->capacity - dest->frames;
+  const int cnt = len < room ? len : room;
+  int i;
+
+  if (cnt <= 0)
+    return;
+  dest->channels = sc68->taps.channels;
+  for (i = 0; i < sc68->taps.channels; ++i) {
+    if (dest->planes[i])
+      memcpy(dest->planes[i] + dest->frames,
+	     sc68->taps.buffer + i * sc68->taps.bufmax + sc68->mix.bufpos,
+	     cnt * sizeof(s16));
+  }
+  dest->frames += cnt;
+}
+
+static int set_voice_taps(sc68_t * sc68, sc68_voice_taps_t * taps)
+{
+  sc68->taps.dest = taps;
+  if (!taps) {
+    taps_connect(sc68);
+    free(sc68->taps.buffer);
+    sc68->taps.buffer = 0;
+    sc68->taps.bufmax = 0;
+    return 0;
+  }
+  if (taps_alloc(sc68))
+    return SC68_ERROR;
+  /* PCM already in the mix buffer was rendered without taps: it reads
+   * back as silence until the next pass. */
+  if (sc68->taps.buffer)
+    memset(sc68->taps.buffer, 0,
+	   (size_t)sc68->taps.bufmax * TAPS_MAX * sizeof(s16));
+  sc68->taps.channels = taps_channels(sc68);
+  return 0;
+}
+
 int sc68_process(sc68_t * sc68, void * buf16st, int * _n)
 {
   int ret;
@@ -2113,6 +2231,11 @@ int sc68_process(sc68_t * sc68, void * buf16st, int * _n)
     int n = *_n;
     ret = (n < 0) ? SC68_ERROR : SC68_IDLE;
 
+    if (sc68->taps.dest) {
+      sc68->taps.dest->channels = sc68->taps.channels;
+      sc68->taps.dest->frames = 0;
+    }
+
     while (n > 0) {
       int len;
 
@@ -2170,6 +2293,7 @@ int sc68_process(sc68_t * sc68, void * buf16st, int * _n)
 	/* Reset pcm pointer. */
 	sc68->mix.bufpos = 0;
 	sc68->mix.buflen = sc68->mix.bufreq;
+	taps_connect(sc68);
 
 	/* Fill pcm buufer depending on architecture */
 	if (sc68->mus->hwflags & SC68_AGA) {
@@ -2220,6 +2344,8 @@ int sc68_process(sc68_t * sc68, void * buf16st, int * _n)
       /* Copy to destination buffer. */
       len = sc68->mix.buflen <= n ? sc68->mix.buflen : n;
       mixer68_copy((u32 *)buf16st,sc68->mix.buffer+sc68->mix.bufpos,len);
+      if (sc68->taps.dest)
+	taps_copy(sc68, len);
       buf16st = (u32 *)buf16st + len;
       sc68->mix.bufpos += len;
       sc68->mix.buflen -= len;
@@ -3021,6 +3147,10 @@ int sc68_cntl(sc68_t * sc68, int fct, ...)
     case SC68_SET_POS:
       res = set_pos(sc68, va_arg(list, int));
       break;
+
+    case SC68_SET_VOICE_TAPS:
+      res = set_voice_taps(sc68, va_arg(list, sc68_voice_taps_t *));
+      break;
     default:
       res = error_addx(sc68,
 		       "libsc68: %s (%d)\n",